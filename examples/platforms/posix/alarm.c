@@ -28,15 +28,112 @@
 
 #include "platform-posix.h"
 
+#include <errno.h>
 #include <stdbool.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <string.h>
 
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+#include <sys/timerfd.h>
+#endif
+
 #include <openthread/platform/alarm.h>
 #include <openthread/platform/diag.h>
 
 static bool s_is_running = false;
 static uint32_t s_alarm = 0;
+
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+static struct timespec s_start;
+static int s_timer_fd = -1;
+static bool s_timer_fired = false;
+
+void platformAlarmInit(void)
+{
+    clock_gettime(CLOCK_MONOTONIC, &s_start);
+
+    s_timer_fd = timerfd_create(CLOCK_MONOTONIC, TFD_NONBLOCK | TFD_CLOEXEC);
+
+    if (s_timer_fd < 0)
+    {
+        perror("timerfd_create");
+        exit(EXIT_FAILURE);
+    }
+
+    platformEventRegister(s_timer_fd, EPOLLIN, &s_timer_fired);
+}
+
+uint32_t otPlatAlarmGetNow(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+
+    return (uint32_t)(((uint64_t)(now.tv_sec - s_start.tv_sec) * 1000) + (now.tv_nsec / 1000000) -
+                      (s_start.tv_nsec / 1000000));
+}
+
+static void alarmUpdateTimer(void)
+{
+    struct itimerspec timer;
+    int32_t remaining;
+
+    memset(&timer, 0, sizeof(timer));
+
+    if (s_is_running)
+    {
+        remaining = (int32_t)(s_alarm - otPlatAlarmGetNow());
+
+        if (remaining > 0)
+        {
+            timer.it_value.tv_sec = remaining / 1000;
+            timer.it_value.tv_nsec = (remaining % 1000) * 1000000;
+        }
+        else
+        {
+            // A zero `it_value` would disarm the timer, expire it right away instead.
+            timer.it_value.tv_nsec = 1;
+        }
+    }
+
+    if (timerfd_settime(s_timer_fd, 0, &timer, NULL) != 0)
+    {
+        perror("timerfd_settime");
+        exit(EXIT_FAILURE);
+    }
+}
+#elif OPENTHREAD_POSIX_VIRTUAL_TIME
+static uint64_t s_now = 0;  // in microseconds, advanced by the simulation coordinator
+
+void platformAlarmInit(void)
+{
+}
+
+uint32_t otPlatAlarmGetNow(void)
+{
+    return (uint32_t)(s_now / 1000);
+}
+
+void platformAlarmAdvanceNow(uint64_t aDelta)
+{
+    s_now += aDelta;
+}
+
+uint64_t platformAlarmGetNext(void)
+{
+    uint64_t rval = UINT64_MAX;
+    int32_t remaining;
+
+    if (s_is_running)
+    {
+        remaining = (int32_t)(s_alarm - otPlatAlarmGetNow());
+        rval = (remaining > 0) ? ((uint64_t)remaining * 1000 - (s_now % 1000)) : 0;
+    }
+
+    return rval;
+}
+#else
 static struct timeval s_start;
 
 void platformAlarmInit(void)
@@ -53,18 +150,27 @@ uint32_t otPlatAlarmGetNow(void)
 
     return (uint32_t)((tv.tv_sec * 1000) + (tv.tv_usec / 1000));
 }
+#endif // OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
 
 void otPlatAlarmStartAt(otInstance *aInstance, uint32_t t0, uint32_t dt)
 {
     (void)aInstance;
     s_alarm = t0 + dt;
     s_is_running = true;
+
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+    alarmUpdateTimer();
+#endif
 }
 
 void otPlatAlarmStop(otInstance *aInstance)
 {
     (void)aInstance;
     s_is_running = false;
+
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+    alarmUpdateTimer();
+#endif
 }
 
 void platformAlarmUpdateTimeout(struct timeval *aTimeout)
@@ -102,6 +208,24 @@ void platformAlarmProcess(otInstance *aInstance)
 {
     int32_t remaining;
 
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+
+    if (s_timer_fired)
+    {
+        uint64_t expirations;
+
+        // Consume the expiration, the alarm itself is checked against the clock below.
+        if (read(s_timer_fd, &expirations, sizeof(expirations)) < 0 && errno != EAGAIN)
+        {
+            perror("read");
+            exit(EXIT_FAILURE);
+        }
+
+        s_timer_fired = false;
+    }
+
+#endif
+
     if (s_is_running)
     {
         remaining = (int32_t)(s_alarm - otPlatAlarmGetNow());
@@ -32,6 +32,7 @@
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
+#include <sys/mman.h>
 #include <sys/stat.h>
 #include <unistd.h>
 
@@ -40,7 +41,8 @@
 #include "utils/code_utils.h"
 #include "utils/flash.h"
 
-static int sFlashFd;
+static int sFlashFd = -1;
+static uint8_t *sFlashBuffer = NULL;  // The flash file, mapped shared so that writes reach the file.
 uint32_t sEraseAddress;
 
 enum
@@ -50,6 +52,21 @@ enum
     FLASH_PAGE_NUM = 128,
 };
 
+static uint32_t sEraseCount[FLASH_PAGE_NUM];
+static uint32_t sWriteCount;
+
+static void flashSync(uint32_t aAddress, uint32_t aSize)
+{
+    // msync() requires an address aligned to the system page size.
+    uint32_t start = aAddress & ~((uint32_t)sysconf(_SC_PAGESIZE) - 1);
+
+    if (msync(sFlashBuffer + start, aAddress + aSize - start, MS_ASYNC) != 0)
+    {
+        perror("msync");
+        exit(EXIT_FAILURE);
+    }
+}
+
 otError utilsFlashInit(void)
 {
     otError error = OT_ERROR_NONE;
@@ -57,6 +74,7 @@ otError utilsFlashInit(void)
     struct stat st;
     bool create = false;
     struct timeval tv;
+    void *buffer;
 
     gettimeofday(&tv, NULL);
 
@@ -74,20 +92,36 @@ otError utilsFlashInit(void)
         create = true;
     }
 
-    sFlashFd = open(fileName, O_RDWR | O_CREAT, 0666);
-    lseek(sFlashFd, 0, SEEK_SET);
+    if (sFlashBuffer != NULL)
+    {
+        munmap(sFlashBuffer, FLASH_SIZE);
+        sFlashBuffer = NULL;
+    }
 
+    if (sFlashFd >= 0)
+    {
+        close(sFlashFd);
+    }
+
+    sFlashFd = open(fileName, O_RDWR | O_CREAT, 0666);
     otEXPECT_ACTION(sFlashFd >= 0, error = OT_ERROR_FAILED);
 
+    otEXPECT_ACTION(ftruncate(sFlashFd, FLASH_SIZE) == 0, error = OT_ERROR_FAILED);
+
+    buffer = mmap(NULL, FLASH_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, sFlashFd, 0);
+    otEXPECT_ACTION(buffer != MAP_FAILED, error = OT_ERROR_FAILED);
+    sFlashBuffer = (uint8_t *)buffer;
+
     if (create)
     {
-        for (uint16_t index = 0; index < FLASH_PAGE_NUM; index++)
-        {
-            error = utilsFlashErasePage(index * FLASH_PAGE_SIZE);
-            otEXPECT(error == OT_ERROR_NONE);
-        }
+        // A new flash leaves the factory erased, this does not count as wear.
+        memset(sFlashBuffer, 0xff, FLASH_SIZE);
+        flashSync(0, FLASH_SIZE);
     }
 
+    memset(sEraseCount, 0, sizeof(sEraseCount));
+    sWriteCount = 0;
+
 exit:
     return error;
 }
@@ -101,22 +135,18 @@ otError utilsFlashErasePage(uint32_t aAddress)
 {
     otError error = OT_ERROR_NONE;
     uint32_t address;
-    uint8_t dummyPage[ FLASH_SIZE ];
 
-    otEXPECT_ACTION(sFlashFd >= 0, error = OT_ERROR_FAILED);
+    otEXPECT_ACTION(sFlashBuffer != NULL, error = OT_ERROR_FAILED);
     otEXPECT_ACTION(aAddress < FLASH_SIZE, error = OT_ERROR_INVALID_ARGS);
 
     // Get start address of the flash page that includes aAddress
     address = aAddress & (~(uint32_t)(FLASH_PAGE_SIZE - 1));
 
     // set the page to the erased state.
-    memset((void *)(&dummyPage[0]), 0xff, FLASH_PAGE_SIZE);
-
-    // Write the page
-    ssize_t r;
-    r =  pwrite(sFlashFd, &(dummyPage[0]), FLASH_PAGE_SIZE, (off_t)address);
-    otEXPECT_ACTION(((int)r) == ((int)(FLASH_PAGE_SIZE)), error = OT_ERROR_FAILED);
+    memset(sFlashBuffer + address, 0xff, FLASH_PAGE_SIZE);
+    flashSync(address, FLASH_PAGE_SIZE);
 
+    sEraseCount[address / FLASH_PAGE_SIZE]++;
 
 exit:
     return error;
@@ -130,20 +160,41 @@ otError utilsFlashStatusWait(uint32_t aTimeout)
 
 uint32_t utilsFlashWrite(uint32_t aAddress, uint8_t *aData, uint32_t aSize)
 {
-    uint32_t ret = 0;
     uint32_t index = 0;
-    uint8_t byte;
+    uint8_t *flash;
 
-    otEXPECT(sFlashFd >= 0 && aAddress < FLASH_SIZE);
+    otEXPECT(sFlashBuffer != NULL && aAddress < FLASH_SIZE);
 
-    for (index = 0; index < aSize; index++)
+    if (aSize > FLASH_SIZE - aAddress)
     {
-        otEXPECT((ret = utilsFlashRead(aAddress + index, &byte, 1)) == 1);
-        // Use bitwise AND to emulate the behavior of flash memory
-        byte &= aData[index];
-        otEXPECT((ret = (uint32_t)pwrite(sFlashFd, &byte, 1, (off_t)(aAddress + index))) == 1);
+        aSize = FLASH_SIZE - aAddress;
     }
 
+    flash = sFlashBuffer + aAddress;
+
+    // Use bitwise AND to emulate the behavior of flash memory, a word at a time where the flash address is aligned.
+    for (; index < aSize && ((aAddress + index) % sizeof(uint32_t)) != 0; index++)
+    {
+        flash[index] &= aData[index];
+    }
+
+    for (; index + sizeof(uint32_t) <= aSize; index += sizeof(uint32_t))
+    {
+        uint32_t word;
+
+        memcpy(&word, &aData[index], sizeof(word));
+        *(uint32_t *)&flash[index] &= word;
+    }
+
+    for (; index < aSize; index++)
+    {
+        flash[index] &= aData[index];
+    }
+
+    flashSync(aAddress, aSize);
+
+    sWriteCount += aSize;
+
 exit:
     return index;
 }
@@ -152,9 +203,21 @@ uint32_t utilsFlashRead(uint32_t aAddress, uint8_t *aData, uint32_t aSize)
 {
     uint32_t ret = 0;
 
-    otEXPECT(sFlashFd >= 0 && aAddress < FLASH_SIZE);
-    ret = (uint32_t)pread(sFlashFd, aData, aSize, (off_t)aAddress);
+    otEXPECT(sFlashBuffer != NULL && aAddress < FLASH_SIZE);
+
+    ret = (aSize < FLASH_SIZE - aAddress) ? aSize : FLASH_SIZE - aAddress;
+    memcpy(aData, sFlashBuffer + aAddress, ret);
 
 exit:
     return ret;
 }
+
+uint32_t platformFlashGetEraseCount(uint32_t aAddress)
+{
+    return (aAddress < FLASH_SIZE) ? sEraseCount[aAddress / FLASH_PAGE_SIZE] : 0;
+}
+
+uint32_t platformFlashGetWriteCount(void)
+{
+    return sWriteCount;
+}
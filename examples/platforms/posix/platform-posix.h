@@ -79,9 +79,21 @@ __forceinline void timersub(struct timeval *a, struct timeval *b, struct timeval
 #include <sys/time.h>
 #include <unistd.h>
 #define POLL poll
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+#include <stdbool.h>
+#include <sys/epoll.h>
+#endif
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+#include <stdbool.h>
+#endif
 #endif
 
 #include <openthread/openthread.h>
+#include <openthread/platform/radio.h>
+
+#ifdef __cplusplus
+extern "C" {
+#endif
 
 /**
  * Unique node ID.
@@ -163,4 +175,141 @@ void platformUartUpdateFdSet(fd_set *aReadFdSet, fd_set *aWriteFdSet, fd_set *aE
  */
 void platformUartProcess(void);
 
+/**
+ * This function returns the number of times the flash page including an address was erased.
+ *
+ * @param[in]  aAddress  An address within the flash page.
+ *
+ * @returns The number of erases of the flash page since `utilsFlashInit()`.
+ *
+ */
+uint32_t platformFlashGetEraseCount(uint32_t aAddress);
+
+/**
+ * This function returns the number of octets written to the flash.
+ *
+ * @returns The number of octets written since `utilsFlashInit()`.
+ *
+ */
+uint32_t platformFlashGetWriteCount(void);
+
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+
+/**
+ * This function registers a file descriptor with the epoll-based driver loop.
+ *
+ * The file descriptor is registered edge-triggered, so it should be non-blocking. The driver loop sets `*aReady`
+ * whenever the file descriptor becomes ready for one of @p aEvents, and the driver clears it when an operation on the
+ * file descriptor would block. File descriptors which epoll does not support (e.g. regular files) are always ready.
+ *
+ * @param[in]  aFd      The file descriptor.
+ * @param[in]  aEvents  The epoll events to wait for (e.g. `EPOLLIN`).
+ * @param[in]  aReady   A pointer to the driver's ready flag for @p aFd.
+ *
+ */
+void platformEventRegister(int aFd, uint32_t aEvents, bool *aReady);
+
+/**
+ * This function unregisters a file descriptor from the epoll-based driver loop.
+ *
+ * @param[in]  aFd      The file descriptor.
+ *
+ */
+void platformEventUnregister(int aFd);
+
+#endif // OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL || OPENTHREAD_POSIX_VIRTUAL_TIME
+
+/**
+ * This function indicates whether the radio driver has work to do without waiting for a new event.
+ *
+ * @retval TRUE   The radio driver has pending work.
+ * @retval FALSE  The radio driver is waiting for an event.
+ *
+ */
+bool platformRadioIsPending(void);
+
+/**
+ * This function indicates whether the UART driver has work to do without waiting for a new event.
+ *
+ * @retval TRUE   The UART driver has pending work.
+ * @retval FALSE  The UART driver is waiting for an event.
+ *
+ */
+bool platformUartIsPending(void);
+
+#endif // OPENTHREAD_POSIX_EVENT_LOOP_EPOLL || OPENTHREAD_POSIX_VIRTUAL_TIME
+
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+
+/**
+ * Simulation event types exchanged with the virtual-time coordinator.
+ *
+ */
+enum
+{
+    SIM_EVENT_ALARM_FIRED    = 0,  ///< To the coordinator: node sleeps for `mDelay`. From it: time advanced.
+    SIM_EVENT_RADIO_RECEIVED = 1,  ///< To the coordinator: frame transmitted. From it: frame received.
+    SIM_EVENT_UART_WRITE     = 2,  ///< From the coordinator: UART input for the node.
+};
+
+enum
+{
+    SIM_EVENT_DATA_MAX_SIZE  = 1 + OT_RADIO_FRAME_MAX_SIZE,  ///< Channel + PSDU of a radio frame.
+};
+
+/**
+ * This structure represents a simulation event, in host byte order.
+ *
+ */
+OT_TOOL_PACKED_BEGIN
+struct Event
+{
+    uint64_t mDelay;       ///< Virtual time in microseconds (see the event types).
+    uint8_t  mEvent;       ///< The event type.
+    uint16_t mDataLength;  ///< The length of @p mData in bytes.
+    uint8_t  mData[SIM_EVENT_DATA_MAX_SIZE];
+} OT_TOOL_PACKED_END;
+
+/**
+ * This function sends a simulation event to the virtual-time coordinator.
+ *
+ * @param[in]  aEvent  A pointer to the event, only the first `mDataLength` bytes of `mData` are sent.
+ *
+ */
+void platformSimSendEvent(const struct Event *aEvent);
+
+/**
+ * This function advances the virtual time of the alarm driver.
+ *
+ * @param[in]  aDelta  The time elapsed, in microseconds.
+ *
+ */
+void platformAlarmAdvanceNow(uint64_t aDelta);
+
+/**
+ * This function retrieves the virtual time remaining until the alarm fires.
+ *
+ * @returns The time remaining in microseconds, or `UINT64_MAX` when the alarm is not running.
+ *
+ */
+uint64_t platformAlarmGetNext(void);
+
+/**
+ * This function delivers a radio frame received from the virtual-time coordinator to the radio driver.
+ *
+ * @param[in]  aInstance    The OpenThread instance structure.
+ * @param[in]  aBuf         A pointer to the channel byte followed by the PSDU.
+ * @param[in]  aBufLength   The length of @p aBuf in bytes.
+ *
+ */
+void platformRadioReceive(otInstance *aInstance, const uint8_t *aBuf, uint16_t aBufLength);
+
+#endif // OPENTHREAD_POSIX_VIRTUAL_TIME
+
+#ifdef __cplusplus
+}  // extern "C"
+#endif
+
 #endif  // PLATFORM_POSIX_H_
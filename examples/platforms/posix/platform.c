@@ -40,6 +40,7 @@
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
+#include <string.h>
 
 #ifndef _WIN32
 #include <libgen.h>
@@ -49,10 +50,135 @@
 #include <openthread/openthread.h>
 #include <openthread/tasklet.h>
 #include <openthread/platform/alarm.h>
+#include <openthread/platform/uart.h>
 
 uint32_t NODE_ID = 1;
 uint32_t WELLKNOWN_NODE_ID = 34;
 
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+enum
+{
+    kMaxEvents = 8,
+};
+
+static int sEpollFd = -1;
+
+void platformEventRegister(int aFd, uint32_t aEvents, bool *aReady)
+{
+    struct epoll_event event;
+
+    memset(&event, 0, sizeof(event));
+    event.events = aEvents | EPOLLET;
+    event.data.ptr = aReady;
+
+    // Edge-triggered: start out ready, the driver finds out otherwise on its first attempt.
+    *aReady = true;
+
+    if (epoll_ctl(sEpollFd, EPOLL_CTL_ADD, aFd, &event) != 0 && errno != EPERM)
+    {
+        perror("epoll_ctl");
+        exit(EXIT_FAILURE);
+    }
+}
+
+void platformEventUnregister(int aFd)
+{
+    epoll_ctl(sEpollFd, EPOLL_CTL_DEL, aFd, NULL);
+}
+#endif // OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+static int sSockFd = -1;
+static uint16_t sPortOffset = 0;
+
+static void simInit(void)
+{
+    struct sockaddr_in sockaddr;
+    char *offset;
+
+    offset = getenv("PORT_OFFSET");
+
+    if (offset)
+    {
+        char *endptr;
+
+        sPortOffset = (uint16_t)strtol(offset, &endptr, 0);
+
+        if (*endptr != '\0')
+        {
+            fprintf(stderr, "Invalid PORT_OFFSET: %s\n", offset);
+            exit(EXIT_FAILURE);
+        }
+
+        sPortOffset *= WELLKNOWN_NODE_ID;
+    }
+
+    memset(&sockaddr, 0, sizeof(sockaddr));
+    sockaddr.sin_family = AF_INET;
+    sockaddr.sin_port = htons(9000 + sPortOffset + NODE_ID);
+    inet_pton(AF_INET, "127.0.0.1", &sockaddr.sin_addr);
+
+    sSockFd = (int)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
+
+    if (sSockFd < 0 || bind(sSockFd, (struct sockaddr *)&sockaddr, sizeof(sockaddr)) != 0)
+    {
+        perror("bind");
+        exit(EXIT_FAILURE);
+    }
+}
+
+void platformSimSendEvent(const struct Event *aEvent)
+{
+    struct sockaddr_in sockaddr;
+
+    // The coordinator listens on the port below node 1.
+    memset(&sockaddr, 0, sizeof(sockaddr));
+    sockaddr.sin_family = AF_INET;
+    sockaddr.sin_port = htons(9000 + sPortOffset);
+    inet_pton(AF_INET, "127.0.0.1", &sockaddr.sin_addr);
+
+    if (sendto(sSockFd, (const char *)aEvent, offsetof(struct Event, mData) + aEvent->mDataLength, 0,
+               (struct sockaddr *)&sockaddr, sizeof(sockaddr)) < 0)
+    {
+        perror("sendto");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void simReceiveEvent(otInstance *aInstance)
+{
+    struct Event event;
+    ssize_t rval = recvfrom(sSockFd, (char *)&event, sizeof(event), 0, NULL, NULL);
+
+    if (rval < 0 || (size_t)rval < offsetof(struct Event, mData) ||
+        (size_t)rval != offsetof(struct Event, mData) + event.mDataLength)
+    {
+        perror("recvfrom");
+        exit(EXIT_FAILURE);
+    }
+
+    platformAlarmAdvanceNow(event.mDelay);
+
+    switch (event.mEvent)
+    {
+    case SIM_EVENT_ALARM_FIRED:
+        break;
+
+    case SIM_EVENT_RADIO_RECEIVED:
+        platformRadioReceive(aInstance, event.mData, event.mDataLength);
+        break;
+
+    case SIM_EVENT_UART_WRITE:
+        otPlatUartReceived(event.mData, event.mDataLength);
+        break;
+
+    default:
+        fprintf(stderr, "Unknown simulation event: %d\n", event.mEvent);
+        exit(EXIT_FAILURE);
+    }
+}
+#endif // OPENTHREAD_POSIX_VIRTUAL_TIME
+
 void PlatformInit(int argc, char *argv[])
 {
     char *endptr;
@@ -75,11 +201,78 @@ void PlatformInit(int argc, char *argv[])
         exit(EXIT_FAILURE);
     }
 
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+    sEpollFd = epoll_create1(EPOLL_CLOEXEC);
+
+    if (sEpollFd < 0)
+    {
+        perror("epoll_create1");
+        exit(EXIT_FAILURE);
+    }
+
+#endif
+
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+    simInit();
+#endif
+
     platformAlarmInit();
     platformRadioInit();
     platformRandomInit();
 }
 
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+void PlatformProcessDrivers(otInstance *aInstance)
+{
+    struct epoll_event events[kMaxEvents];
+    int timeout = -1;
+    int rval;
+    int i;
+
+    // Only block when no driver has work left from earlier edges, the alarm wakes the loop through its timerfd.
+    if (otTaskletsArePending(aInstance) || platformUartIsPending() || platformRadioIsPending())
+    {
+        timeout = 0;
+    }
+
+    rval = epoll_wait(sEpollFd, events, kMaxEvents, timeout);
+
+    if ((rval < 0) && (errno != EINTR))
+    {
+        perror("epoll_wait");
+        exit(EXIT_FAILURE);
+    }
+
+    for (i = 0; i < rval; i++)
+    {
+        *(bool *)events[i].data.ptr = true;
+    }
+
+    platformUartProcess();
+    platformRadioProcess(aInstance);
+    platformAlarmProcess(aInstance);
+}
+#elif OPENTHREAD_POSIX_VIRTUAL_TIME
+void PlatformProcessDrivers(otInstance *aInstance)
+{
+    struct Event event;
+
+    // The coordinator only advances time while every node sleeps, and wakes a node with exactly one event per sleep.
+    if (!otTaskletsArePending(aInstance) && !platformUartIsPending() && !platformRadioIsPending())
+    {
+        event.mDelay = platformAlarmGetNext();
+        event.mEvent = SIM_EVENT_ALARM_FIRED;
+        event.mDataLength = 0;
+
+        platformSimSendEvent(&event);
+        simReceiveEvent(aInstance);
+    }
+
+    platformUartProcess();
+    platformRadioProcess(aInstance);
+    platformAlarmProcess(aInstance);
+}
+#else
 void PlatformProcessDrivers(otInstance *aInstance)
 {
     fd_set read_fds;
@@ -112,3 +305,4 @@ void PlatformProcessDrivers(otInstance *aInstance)
     platformRadioProcess(aInstance);
     platformAlarmProcess(aInstance);
 }
+#endif // OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
@@ -28,6 +28,8 @@
 
 #include "platform-posix.h"
 
+#include <errno.h>
+
 #include <openthread/platform/diag.h>
 #include <openthread/platform/radio.h>
 
@@ -78,8 +80,11 @@ enum
 enum
 {
     POSIX_RECEIVE_SENSITIVITY = -100,  // dBm
+    POSIX_RECEIVE_POWER       = -20,   // dBm, used for links without a configured RSSI
 };
 
+#define POSIX_RADIO_MULTICAST_GROUP "224.0.0.116"
+
 OT_TOOL_PACKED_BEGIN
 struct RadioMessage
 {
@@ -87,15 +92,37 @@ struct RadioMessage
     uint8_t mPsdu[OT_RADIO_FRAME_MAX_SIZE];
 } OT_TOOL_PACKED_END;
 
-static void radioTransmit(struct RadioMessage *msg, const struct otRadioFrame *pkt);
+/**
+ * A radio message as sent on the multicast medium, prefixed with the sender's node ID (in network byte order) since
+ * all nodes share one group address and port.
+ *
+ */
+OT_TOOL_PACKED_BEGIN
+struct RadioPacket
+{
+    uint32_t            mNodeId;
+    struct RadioMessage mMessage;
+} OT_TOOL_PACKED_END;
+
+/**
+ * The simulated link from another node to this node.
+ *
+ */
+struct RadioLink
+{
+    uint8_t mLossRate;  // percent
+    int8_t  mRssi;      // dBm
+};
+
+static void radioTransmit(struct RadioPacket *aPacket, const struct otRadioFrame *pkt);
 static void radioSendMessage(otInstance *aInstance);
 static void radioSendAck(void);
 static void radioProcessFrame(otInstance *aInstance);
 
 static otRadioState sState = OT_RADIO_STATE_DISABLED;
-static struct RadioMessage sReceiveMessage;
-static struct RadioMessage sTransmitMessage;
-static struct RadioMessage sAckMessage;
+static struct RadioPacket sReceivePacket;
+static struct RadioPacket sTransmitPacket;
+static struct RadioPacket sAckPacket;
 static otRadioFrame sReceiveFrame;
 static otRadioFrame sTransmitFrame;
 static otRadioFrame sAckFrame;
@@ -107,6 +134,23 @@ static int sSockFd;
 static bool sPromiscuous = false;
 static bool sAckWait = false;
 static uint16_t sPortOffset = 0;
+static int8_t sReceivePower = POSIX_RECEIVE_POWER;
+
+static bool sMulticast = false;
+static struct sockaddr_in sMulticastSockaddr;
+#if !OPENTHREAD_POSIX_VIRTUAL_TIME
+static struct RadioLink *sLinks = NULL;  // Indexed by the sender's node ID.
+static uint32_t sLinkCount = 0;
+static uint32_t sLossSeed;
+#endif
+
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+static bool sEnergyScanPending = false;
+#endif
+
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+static bool sSockReadable = false;
+#endif
 
 static inline bool isFrameTypeAck(const uint8_t *frame)
 {
@@ -341,10 +385,121 @@ void otPlatRadioSetPromiscuous(otInstance *aInstance, bool aEnable)
     sPromiscuous = aEnable;
 }
 
-void platformRadioInit(void)
+#if !OPENTHREAD_POSIX_VIRTUAL_TIME
+static void radioLoadLinks(const char *aPath)
+{
+    FILE *file = fopen(aPath, "r");
+    char line[128];
+    unsigned long src;
+    unsigned long dst;
+    int lossRate;
+    int rssi;
+    char extra;
+
+    if (file == NULL)
+    {
+        perror(aPath);
+        exit(EXIT_FAILURE);
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        const char *cur = line;
+
+        while (*cur == ' ' || *cur == '\t')
+        {
+            cur++;
+        }
+
+        if (*cur == '#' || *cur == '\n' || *cur == '\r' || *cur == '\0')
+        {
+            continue;
+        }
+
+        if (sscanf(cur, "%lu %lu %d %d %c", &src, &dst, &lossRate, &rssi, &extra) != 4 ||
+            lossRate < 0 || lossRate > 100 || rssi < -128 || rssi > 127)
+        {
+            fprintf(stderr, "Invalid link in %s: %s", aPath, line);
+            exit(EXIT_FAILURE);
+        }
+
+        // Losses are applied by the receiver, so only the links towards this node are kept.
+        if (dst != NODE_ID)
+        {
+            continue;
+        }
+
+        if (src >= sLinkCount)
+        {
+            uint32_t count = (uint32_t)src + 1;
+            struct RadioLink *links = (struct RadioLink *)realloc(sLinks, count * sizeof(struct RadioLink));
+
+            if (links == NULL)
+            {
+                perror("realloc");
+                exit(EXIT_FAILURE);
+            }
+
+            for (; sLinkCount < count; sLinkCount++)
+            {
+                links[sLinkCount].mLossRate = 0;
+                links[sLinkCount].mRssi = POSIX_RECEIVE_POWER;
+            }
+
+            sLinks = links;
+        }
+
+        sLinks[src].mLossRate = (uint8_t)lossRate;
+        sLinks[src].mRssi = (int8_t)rssi;
+    }
+
+    fclose(file);
+}
+
+static void radioInitMulticast(struct sockaddr_in *aSockaddr)
+{
+    struct ip_mreq mreq;
+    struct in_addr loopback;
+    int one = 1;
+    int ttl = 0;
+
+    // All nodes (of one PORT_OFFSET) share a single port on a host-local multicast group, so any number of nodes
+    // receive a frame from a single `sendto()`.
+    memset(&sMulticastSockaddr, 0, sizeof(sMulticastSockaddr));
+    sMulticastSockaddr.sin_family = AF_INET;
+    sMulticastSockaddr.sin_port = htons(9000 + sPortOffset);
+    inet_pton(AF_INET, POSIX_RADIO_MULTICAST_GROUP, &sMulticastSockaddr.sin_addr);
+    inet_pton(AF_INET, "127.0.0.1", &loopback);
+
+    aSockaddr->sin_port = sMulticastSockaddr.sin_port;
+#if _WIN32
+    aSockaddr->sin_addr.s_addr = INADDR_ANY;
+#else
+    // Binding the group address keeps unicast traffic to the same port (e.g. another PORT_OFFSET) out.
+    aSockaddr->sin_addr = sMulticastSockaddr.sin_addr;
+#endif
+
+    mreq.imr_multiaddr = sMulticastSockaddr.sin_addr;
+    mreq.imr_interface = loopback;
+
+    if (setsockopt(sSockFd, SOL_SOCKET, SO_REUSEADDR, (const char *)&one, sizeof(one)) != 0 ||
+        bind(sSockFd, (struct sockaddr *)aSockaddr, sizeof(*aSockaddr)) != 0 ||
+        setsockopt(sSockFd, IPPROTO_IP, IP_ADD_MEMBERSHIP, (const char *)&mreq, sizeof(mreq)) != 0 ||
+        setsockopt(sSockFd, IPPROTO_IP, IP_MULTICAST_IF, (const char *)&loopback, sizeof(loopback)) != 0 ||
+        setsockopt(sSockFd, IPPROTO_IP, IP_MULTICAST_LOOP, (const char *)&one, sizeof(one)) != 0 ||
+        setsockopt(sSockFd, IPPROTO_IP, IP_MULTICAST_TTL, (const char *)&ttl, sizeof(ttl)) != 0)
+    {
+        perror("multicast radio");
+        exit(EXIT_FAILURE);
+    }
+}
+
+static void radioInitSocket(void)
 {
     struct sockaddr_in sockaddr;
     char *offset;
+    char *medium;
+    char *links;
     memset(&sockaddr, 0, sizeof(sockaddr));
     sockaddr.sin_family = AF_INET;
 
@@ -365,23 +520,75 @@ void platformRadioInit(void)
         sPortOffset *= WELLKNOWN_NODE_ID;
     }
 
-    if (sPromiscuous)
+    medium = getenv("RADIO_MEDIUM");
+
+    if (medium != NULL && strcmp(medium, "multicast") == 0)
     {
-        sockaddr.sin_port = htons(9000 + sPortOffset + WELLKNOWN_NODE_ID);
+        sMulticast = true;
     }
-    else
+    else if (medium != NULL && strcmp(medium, "unicast") != 0)
+    {
+        fprintf(stderr, "Invalid RADIO_MEDIUM: %s\n", medium);
+        exit(EXIT_FAILURE);
+    }
+
+    links = getenv("RADIO_LINKS");
+
+    if (links != NULL)
     {
-        sockaddr.sin_port = htons(9000 + sPortOffset + NODE_ID);
+        if (!sMulticast)
+        {
+            fprintf(stderr, "RADIO_LINKS requires RADIO_MEDIUM=multicast\n");
+            exit(EXIT_FAILURE);
+        }
+
+        radioLoadLinks(links);
     }
 
-    sockaddr.sin_addr.s_addr = INADDR_ANY;
+    sLossSeed = NODE_ID * 2654435761u + 1;
 
     sSockFd = (int)socket(AF_INET, SOCK_DGRAM, IPPROTO_UDP);
-    bind(sSockFd, (struct sockaddr *)&sockaddr, sizeof(sockaddr));
 
-    sReceiveFrame.mPsdu = sReceiveMessage.mPsdu;
-    sTransmitFrame.mPsdu = sTransmitMessage.mPsdu;
-    sAckFrame.mPsdu = sAckMessage.mPsdu;
+    if (sMulticast)
+    {
+        radioInitMulticast(&sockaddr);
+    }
+    else
+    {
+        if (sPromiscuous)
+        {
+            sockaddr.sin_port = htons(9000 + sPortOffset + WELLKNOWN_NODE_ID);
+        }
+        else
+        {
+            sockaddr.sin_port = htons(9000 + sPortOffset + NODE_ID);
+        }
+
+        sockaddr.sin_addr.s_addr = INADDR_ANY;
+
+        bind(sSockFd, (struct sockaddr *)&sockaddr, sizeof(sockaddr));
+    }
+
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+    // The socket stays blocking for `sendto()`, receives use `MSG_DONTWAIT`.
+    platformEventRegister(sSockFd, EPOLLIN, &sSockReadable);
+#endif
+}
+#endif // !OPENTHREAD_POSIX_VIRTUAL_TIME
+
+void platformRadioInit(void)
+{
+#if !OPENTHREAD_POSIX_VIRTUAL_TIME
+    // With virtual time, frames are exchanged through the simulation coordinator instead.
+    radioInitSocket();
+#endif
+
+    sTransmitPacket.mNodeId = htonl(NODE_ID);
+    sAckPacket.mNodeId = htonl(NODE_ID);
+
+    sReceiveFrame.mPsdu = sReceivePacket.mMessage.mPsdu;
+    sTransmitFrame.mPsdu = sTransmitPacket.mMessage.mPsdu;
+    sAckFrame.mPsdu = sAckPacket.mMessage.mPsdu;
 }
 
 bool otPlatRadioIsEnabled(otInstance *aInstance)
@@ -470,7 +677,12 @@ int8_t otPlatRadioGetRssi(otInstance *aInstance)
 otRadioCaps otPlatRadioGetCaps(otInstance *aInstance)
 {
     (void)aInstance;
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+    // Sampling the RSSI in a tasklet loop never lets the node sleep, so the scan is done by the driver instead.
+    return OT_RADIO_CAPS_ENERGY_SCAN;
+#else
     return OT_RADIO_CAPS_NONE;
+#endif
 }
 
 bool otPlatRadioGetPromiscuous(otInstance *aInstance)
@@ -479,9 +691,50 @@ bool otPlatRadioGetPromiscuous(otInstance *aInstance)
     return sPromiscuous;
 }
 
+static void radioProcessMessage(otInstance *aInstance, uint8_t aPsduLength);
+
+#if !OPENTHREAD_POSIX_VIRTUAL_TIME
+static bool radioIsLinkUp(uint32_t aNodeId)
+{
+    bool rval = true;
+
+    sReceivePower = POSIX_RECEIVE_POWER;
+
+    otEXPECT(aNodeId < sLinkCount);
+
+    sReceivePower = sLinks[aNodeId].mRssi;
+    otEXPECT_ACTION(sReceivePower >= POSIX_RECEIVE_SENSITIVITY, rval = false);
+
+    if (sLinks[aNodeId].mLossRate != 0)
+    {
+        // xorshift32, kept apart from `otPlatRandomGet()` so configuring losses does not perturb the stack.
+        sLossSeed ^= sLossSeed << 13;
+        sLossSeed ^= sLossSeed >> 17;
+        sLossSeed ^= sLossSeed << 5;
+        rval = (sLossSeed % 100) >= sLinks[aNodeId].mLossRate;
+    }
+
+exit:
+    return rval;
+}
+
 void radioReceive(otInstance *aInstance)
 {
-    ssize_t rval = recvfrom(sSockFd, (char *)&sReceiveMessage, sizeof(sReceiveMessage), 0, NULL, NULL);
+    char *buf = sMulticast ? (char *)&sReceivePacket : (char *)&sReceivePacket.mMessage;
+    size_t size = sMulticast ? sizeof(sReceivePacket) : sizeof(sReceivePacket.mMessage);
+
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+    ssize_t rval = recvfrom(sSockFd, buf, size, MSG_DONTWAIT, NULL, NULL);
+
+    if (rval < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+    {
+        sSockReadable = false;
+        return;
+    }
+
+#else
+    ssize_t rval = recvfrom(sSockFd, buf, size, 0, NULL, NULL);
+#endif
 
     if (rval < 0)
     {
@@ -489,10 +742,40 @@ void radioReceive(otInstance *aInstance)
         exit(EXIT_FAILURE);
     }
 
-    sReceiveFrame.mLength = (uint8_t)(rval - 1);
+    if (sMulticast)
+    {
+        uint32_t nodeId = ntohl(sReceivePacket.mNodeId);
+
+        rval -= (ssize_t)sizeof(sReceivePacket.mNodeId);
+
+        // The group loops our own frames back.
+        if (rval < 1 || nodeId == NODE_ID || !radioIsLinkUp(nodeId))
+        {
+            return;
+        }
+    }
+
+    radioProcessMessage(aInstance, (uint8_t)(rval - 1));
+}
+#else
+void platformRadioReceive(otInstance *aInstance, const uint8_t *aBuf, uint16_t aBufLength)
+{
+    otEXPECT(aBufLength >= 1 && aBufLength <= sizeof(sReceivePacket.mMessage));
+
+    memcpy(&sReceivePacket.mMessage, aBuf, aBufLength);
+    radioProcessMessage(aInstance, (uint8_t)(aBufLength - 1));
+
+exit:
+    return;
+}
+#endif // !OPENTHREAD_POSIX_VIRTUAL_TIME
+
+static void radioProcessMessage(otInstance *aInstance, uint8_t aPsduLength)
+{
+    sReceiveFrame.mLength = aPsduLength;
 
     if (sAckWait &&
-        sTransmitFrame.mChannel == sReceiveMessage.mChannel &&
+        sTransmitFrame.mChannel == sReceivePacket.mMessage.mChannel &&
         isFrameTypeAck(sReceiveFrame.mPsdu) &&
         getDsn(sReceiveFrame.mPsdu) == getDsn(sTransmitFrame.mPsdu))
     {
@@ -512,7 +795,7 @@ void radioReceive(otInstance *aInstance)
         }
     }
     else if ((sState == OT_RADIO_STATE_RECEIVE || sState == OT_RADIO_STATE_TRANSMIT) &&
-             (sReceiveFrame.mChannel == sReceiveMessage.mChannel))
+             (sReceiveFrame.mChannel == sReceivePacket.mMessage.mChannel))
     {
         radioProcessFrame(aInstance);
     }
@@ -520,9 +803,9 @@ void radioReceive(otInstance *aInstance)
 
 void radioSendMessage(otInstance *aInstance)
 {
-    sTransmitMessage.mChannel = sTransmitFrame.mChannel;
+    sTransmitPacket.mMessage.mChannel = sTransmitFrame.mChannel;
 
-    radioTransmit(&sTransmitMessage, &sTransmitFrame);
+    radioTransmit(&sTransmitPacket, &sTransmitFrame);
 
     sAckWait = isAckRequested(sTransmitFrame.mPsdu);
 
@@ -567,8 +850,38 @@ void platformRadioUpdateFdSet(fd_set *aReadFdSet, fd_set *aWriteFdSet, int *aMax
     }
 }
 
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+bool platformRadioIsPending(void)
+{
+    return sSockReadable || (sState == OT_RADIO_STATE_TRANSMIT && !sAckWait);
+}
+#elif OPENTHREAD_POSIX_VIRTUAL_TIME
+bool platformRadioIsPending(void)
+{
+    return sEnergyScanPending || (sState == OT_RADIO_STATE_TRANSMIT && !sAckWait);
+}
+#endif
+
 void platformRadioProcess(otInstance *aInstance)
 {
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+
+    // Receive one frame per loop iteration, as with `select()`, until the socket is drained.
+    if (sSockReadable)
+    {
+        radioReceive(aInstance);
+    }
+
+#elif OPENTHREAD_POSIX_VIRTUAL_TIME
+
+    // Received frames are delivered by the simulation coordinator, see platformRadioReceive().
+    if (sEnergyScanPending)
+    {
+        sEnergyScanPending = false;
+        otPlatRadioEnergyScanDone(aInstance, otPlatRadioGetRssi(aInstance));
+    }
+
+#else
     const int flags = POLLIN | POLLRDNORM | POLLERR | POLLNVAL | POLLHUP;
     struct pollfd pollfd = { sSockFd, flags, 0 };
 
@@ -577,16 +890,22 @@ void platformRadioProcess(otInstance *aInstance)
         radioReceive(aInstance);
     }
 
+#endif
+
     if (sState == OT_RADIO_STATE_TRANSMIT && !sAckWait)
     {
         radioSendMessage(aInstance);
     }
 }
 
-void radioTransmit(struct RadioMessage *msg, const struct otRadioFrame *pkt)
+void radioTransmit(struct RadioPacket *aPacket, const struct otRadioFrame *pkt)
 {
+    struct RadioMessage *msg = &aPacket->mMessage;
     uint32_t i;
     struct sockaddr_in sockaddr;
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+    struct Event event;
+#endif
 
     uint16_t crc = 0;
     uint16_t crc_offset = pkt->mLength - sizeof(uint16_t);
@@ -599,6 +918,29 @@ void radioTransmit(struct RadioMessage *msg, const struct otRadioFrame *pkt)
     msg->mPsdu[crc_offset] = crc & 0xff;
     msg->mPsdu[crc_offset + 1] = crc >> 8;
 
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+    // The coordinator delivers the frame to all other nodes after its air time.
+    event.mDelay = 0;
+    event.mEvent = SIM_EVENT_RADIO_RECEIVED;
+    event.mDataLength = 1 + pkt->mLength;
+    memcpy(event.mData, msg, event.mDataLength);
+
+    platformSimSendEvent(&event);
+    return;
+#endif
+
+    if (sMulticast)
+    {
+        if (sendto(sSockFd, (const char *)aPacket, sizeof(aPacket->mNodeId) + 1 + pkt->mLength, 0,
+                   (struct sockaddr *)&sMulticastSockaddr, sizeof(sMulticastSockaddr)) < 0)
+        {
+            perror("sendto");
+            exit(EXIT_FAILURE);
+        }
+
+        return;
+    }
+
     memset(&sockaddr, 0, sizeof(sockaddr));
     sockaddr.sin_family = AF_INET;
     inet_pton(AF_INET, "127.0.0.1", &sockaddr.sin_addr);
@@ -627,19 +969,19 @@ void radioTransmit(struct RadioMessage *msg, const struct otRadioFrame *pkt)
 void radioSendAck(void)
 {
     sAckFrame.mLength = IEEE802154_ACK_LENGTH;
-    sAckMessage.mPsdu[0] = IEEE802154_FRAME_TYPE_ACK;
+    sAckPacket.mMessage.mPsdu[0] = IEEE802154_FRAME_TYPE_ACK;
 
     if (isDataRequest(sReceiveFrame.mPsdu))
     {
-        sAckMessage.mPsdu[0] |= IEEE802154_FRAME_PENDING;
+        sAckPacket.mMessage.mPsdu[0] |= IEEE802154_FRAME_PENDING;
     }
 
-    sAckMessage.mPsdu[1] = 0;
-    sAckMessage.mPsdu[2] = getDsn(sReceiveFrame.mPsdu);
+    sAckPacket.mMessage.mPsdu[1] = 0;
+    sAckPacket.mMessage.mPsdu[2] = getDsn(sReceiveFrame.mPsdu);
 
-    sAckMessage.mChannel = sReceiveFrame.mChannel;
+    sAckPacket.mMessage.mChannel = sReceiveFrame.mChannel;
 
-    radioTransmit(&sAckMessage, &sAckFrame);
+    radioTransmit(&sAckPacket, &sAckFrame);
 }
 
 void radioProcessFrame(otInstance *aInstance)
@@ -677,7 +1019,7 @@ void radioProcessFrame(otInstance *aInstance)
         goto exit;
     }
 
-    sReceiveFrame.mPower = -20;
+    sReceiveFrame.mPower = sReceivePower;
     sReceiveFrame.mLqi = OT_RADIO_LQI_NONE;
 
     // generate acknowledgment
@@ -750,7 +1092,13 @@ otError otPlatRadioEnergyScan(otInstance *aInstance, uint8_t aScanChannel, uint1
     (void)aInstance;
     (void)aScanChannel;
     (void)aScanDuration;
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+    // The medium carries no energy besides frames, the scan completes without taking virtual time.
+    sEnergyScanPending = true;
+    return OT_ERROR_NONE;
+#else
     return OT_ERROR_NOT_IMPLEMENTED;
+#endif
 }
 
 void otPlatRadioSetDefaultTxPower(otInstance *aInstance, int8_t aPower)
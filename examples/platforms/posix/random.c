@@ -46,7 +46,15 @@ static uint32_t sState = 1;
 
 void platformRandomInit(void)
 {
-#if __SANITIZE_ADDRESS__ == 0
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+
+    // Simulations are reproducible from RANDOM_SEED, each node still gets its own sequence.
+    const char *seed = getenv("RANDOM_SEED");
+
+    sState = (seed != NULL) ? (uint32_t)strtoul(seed, NULL, 0) : 0;
+    sState = ((sState ^ (NODE_ID * 2654435761u)) % 0x7ffffffe) + 1;
+
+#elif __SANITIZE_ADDRESS__ == 0
 
     otError error;
 
@@ -87,7 +95,7 @@ otError otPlatRandomGetTrue(uint8_t *aOutput, uint16_t aOutputLength)
 {
     otError error = OT_ERROR_NONE;
 
-#if __SANITIZE_ADDRESS__ == 0
+#if __SANITIZE_ADDRESS__ == 0 && !OPENTHREAD_POSIX_VIRTUAL_TIME
 
     FILE *file = NULL;
     size_t readLength;
@@ -107,7 +115,7 @@ exit:
         fclose(file);
     }
 
-#else  // __SANITIZE_ADDRESS__
+#else  // __SANITIZE_ADDRESS__ || OPENTHREAD_POSIX_VIRTUAL_TIME
 
     /*
      * THE IMPLEMENTATION BELOW IS NOT COMPLIANT WITH THE THREAD SPECIFICATION.
@@ -115,7 +123,8 @@ exit:
      * Address Sanitizer triggers test failures when reading random
      * values from /dev/urandom.  The pseudo-random number generator
      * implementation below is only used to enable continuous
-     * integration checks with Address Sanitizer enabled.
+     * integration checks with Address Sanitizer enabled, and to keep
+     * virtual-time simulations reproducible.
      */
     otEXPECT_ACTION(aOutput && aOutputLength, error = OT_ERROR_INVALID_ARGS);
 
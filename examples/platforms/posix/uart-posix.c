@@ -56,6 +56,14 @@ static uint16_t s_write_length;
 static int s_in_fd;
 static int s_out_fd;
 
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+static bool s_in_readable = false;
+static bool s_out_writable = false;
+static bool s_fd_flags_saved = false;
+static int s_in_fd_flags;
+static int s_out_fd_flags;
+#endif
+
 static struct termios original_stdin_termios;
 static struct termios original_stdout_termios;
 
@@ -69,6 +77,20 @@ static void restore_stdout_termios(void)
     tcsetattr(s_out_fd, TCSAFLUSH, &original_stdout_termios);
 }
 
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+// The descriptors are dup'd from stdin and stdout and share their file status flags
+// with the parent process, so O_NONBLOCK must not outlive this process.
+static void restore_fd_flags(void)
+{
+    if (s_fd_flags_saved)
+    {
+        fcntl(s_in_fd, F_SETFL, s_in_fd_flags);
+        fcntl(s_out_fd, F_SETFL, s_out_fd_flags);
+        s_fd_flags_saved = false;
+    }
+}
+#endif
+
 otError otPlatUartEnable(void)
 {
     otError error = OT_ERROR_NONE;
@@ -147,9 +169,29 @@ otError otPlatUartEnable(void)
         otEXPECT_ACTION(tcsetattr(s_out_fd, TCSANOW, &termios) == 0, perror("tcsetattr"); error = OT_ERROR_GENERIC);
     }
 
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+    // Edge-triggered events require non-blocking reads and writes.
+    s_in_fd_flags = fcntl(s_in_fd, F_GETFL);
+    s_out_fd_flags = fcntl(s_out_fd, F_GETFL);
+    otEXPECT_ACTION(s_in_fd_flags != -1 && s_out_fd_flags != -1, perror("fcntl"); error = OT_ERROR_GENERIC);
+    s_fd_flags_saved = true;
+    atexit(&restore_fd_flags);
+
+    otEXPECT_ACTION(fcntl(s_in_fd, F_SETFL, s_in_fd_flags | O_NONBLOCK) == 0,
+                    perror("fcntl"); error = OT_ERROR_GENERIC);
+    otEXPECT_ACTION(fcntl(s_out_fd, F_SETFL, s_out_fd_flags | O_NONBLOCK) == 0,
+                    perror("fcntl"); error = OT_ERROR_GENERIC);
+
+    platformEventRegister(s_in_fd, EPOLLIN, &s_in_readable);
+    platformEventRegister(s_out_fd, EPOLLOUT, &s_out_writable);
+#endif
+
     return error;
 
 exit:
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+    restore_fd_flags();
+#endif
     close(s_in_fd);
     close(s_out_fd);
     return error;
@@ -159,6 +201,12 @@ otError otPlatUartDisable(void)
 {
     otError error = OT_ERROR_NONE;
 
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+    platformEventUnregister(s_in_fd);
+    platformEventUnregister(s_out_fd);
+    restore_fd_flags();
+#endif
+
     close(s_in_fd);
     close(s_out_fd);
 
@@ -211,6 +259,68 @@ void platformUartUpdateFdSet(fd_set *aReadFdSet, fd_set *aWriteFdSet, fd_set *aE
     }
 }
 
+#if OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
+bool platformUartIsPending(void)
+{
+    return s_in_readable || (s_write_length > 0 && s_out_writable);
+}
+
+void platformUartProcess(void)
+{
+    ssize_t rval;
+
+    if (s_in_readable)
+    {
+        rval = read(s_in_fd, s_receive_buffer, sizeof(s_receive_buffer));
+
+        if (rval < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            s_in_readable = false;
+        }
+        else if (rval <= 0)
+        {
+            perror("read");
+            exit(EXIT_FAILURE);
+        }
+        else
+        {
+            otPlatUartReceived(s_receive_buffer, (uint16_t)rval);
+        }
+    }
+
+    if ((s_write_length > 0) && s_out_writable)
+    {
+        rval = write(s_out_fd, s_write_buffer, s_write_length);
+
+        if (rval < 0 && (errno == EAGAIN || errno == EWOULDBLOCK))
+        {
+            s_out_writable = false;
+        }
+        else if (rval <= 0)
+        {
+            perror("write");
+            exit(EXIT_FAILURE);
+        }
+        else
+        {
+            s_write_buffer += (uint16_t)rval;
+            s_write_length -= (uint16_t)rval;
+
+            if (s_write_length == 0)
+            {
+                otPlatUartSendDone();
+            }
+        }
+    }
+}
+#else
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+bool platformUartIsPending(void)
+{
+    return s_write_length > 0;
+}
+#endif
+
 void platformUartProcess(void)
 {
     ssize_t rval;
@@ -221,6 +331,11 @@ void platformUartProcess(void)
         { s_out_fd, POLLOUT | error_flags, 0 },
     };
 
+#if OPENTHREAD_POSIX_VIRTUAL_TIME
+    // UART input arrives as simulation events, poll() skips negative file descriptors.
+    pollfd[0].fd = -1;
+#endif
+
     errno = 0;
 
     rval = poll(pollfd, sizeof(pollfd) / sizeof(*pollfd), 0);
@@ -278,3 +393,4 @@ void platformUartProcess(void)
         }
     }
 }
+#endif // OPENTHREAD_POSIX_EVENT_LOOP_EPOLL
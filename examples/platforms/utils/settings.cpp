@@ -30,6 +30,10 @@
  * @file
  *   This file implements the OpenThread platform abstraction for non-volatile storage of settings.
  *
+ *   Settings are appended to a log in flash and located through an index in RAM, which is sorted by key and keeps
+ *   the records of each key in the order they were added. Once the log fills up, the live records are copied to the
+ *   other half of the settings area a few at a time, as part of later settings operations.
+ *
  */
 
 #include <stdlib.h>
@@ -68,6 +72,17 @@ enum
     kSettingsNotUse = 0xbe5cc5ec,
 };
 
+enum
+{
+    kEntryUncommitted = 0x1,  ///< Added by the current change set, the record is not complete yet.
+    kEntryDeleted = 0x2,      ///< Deleted by the current change set, the record is not deleted yet.
+};
+
+enum
+{
+    kCompactRecordsPerStep = 4,  ///< Number of records copied by each settings operation while compacting.
+};
+
 OT_TOOL_PACKED_BEGIN
 struct settingsBlock
 {
@@ -77,6 +92,18 @@ struct settingsBlock
     uint16_t reserved;
 } OT_TOOL_PACKED_END;
 
+/**
+ * This structure represents a live record in the RAM index.
+ *
+ */
+struct settingsIndexEntry
+{
+    uint16_t key;
+    uint16_t length;
+    uint16_t offset;      ///< Offset of the record from the settings base address.
+    uint16_t copyOffset;  ///< Offset of the record's copy while compacting, zero until it is copied.
+    uint8_t flags;        ///< Change set state, see `kEntryUncommitted` and `kEntryDeleted`.
+};
 
 /**
  * @def SETTINGS_CONFIG_BASE_ADDRESS
@@ -108,14 +135,51 @@ struct settingsBlock
 #define SETTINGS_CONFIG_PAGE_NUM                     2
 #endif  // SETTINGS_CONFIG_PAGE_NUM
 
+#if SETTINGS_CONFIG_PAGE_SIZE * SETTINGS_CONFIG_PAGE_NUM > 0x20000
+#error "Settings offsets do not fit in the RAM index, reduce SETTINGS_CONFIG_PAGE_SIZE or SETTINGS_CONFIG_PAGE_NUM"
+#endif
+
+enum
+{
+    kSettingsSize = (SETTINGS_CONFIG_PAGE_NUM > 1) ? SETTINGS_CONFIG_PAGE_SIZE * SETTINGS_CONFIG_PAGE_NUM / 2 :
+                    SETTINGS_CONFIG_PAGE_SIZE,
+
+    /**
+     * Every index entry refers to a distinct record in the settings area in use, including the records a change set
+     * adds or replaces, so the index holds as many entries as the smallest records fitting in the settings area.
+     *
+     */
+    kSettingsIndexSize = (kSettingsSize - kSettingsFlagSize) / sizeof(struct settingsBlock),
+};
+
 static uint32_t sSettingsBaseAddress;
 static uint32_t sSettingsUsedSize;
+static uint32_t sSettingsLiveSize;
+
+static struct settingsIndexEntry sIndex[kSettingsIndexSize];
+static uint16_t sIndexLength;
+
+static bool sInChange;
+
+static bool sCompacting;
+static uint32_t sCompactBaseAddress;
+static uint32_t sCompactUsedSize;
 
 static uint16_t getAlignLength(uint16_t length)
 {
     return (length + 3) & 0xfffc;
 }
 
+static uint32_t getSettingsSize(void)
+{
+    return kSettingsSize;
+}
+
+static uint32_t getRecordSize(uint16_t aLength)
+{
+    return sizeof(struct settingsBlock) + getAlignLength(aLength);
+}
+
 static void setSettingsFlag(uint32_t aBase, uint32_t aFlag)
 {
     utilsFlashWrite(aBase, reinterpret_cast<uint8_t *>(&aFlag), sizeof(aFlag));
@@ -124,9 +188,7 @@ static void setSettingsFlag(uint32_t aBase, uint32_t aFlag)
 static void initSettings(uint32_t aBase, uint32_t aFlag)
 {
     uint32_t address = aBase;
-    uint32_t settingsSize = SETTINGS_CONFIG_PAGE_NUM > 1 ?
-                            SETTINGS_CONFIG_PAGE_SIZE * SETTINGS_CONFIG_PAGE_NUM / 2 :
-                            SETTINGS_CONFIG_PAGE_SIZE;
+    uint32_t settingsSize = getSettingsSize();
 
     while (address < (aBase + settingsSize))
     {
@@ -138,147 +200,370 @@ static void initSettings(uint32_t aBase, uint32_t aFlag)
     setSettingsFlag(aBase, aFlag);
 }
 
-static uint32_t swapSettingsBlock(otInstance *aInstance)
+/**
+ * This function clears flag bits of the record header at @p aAddress.
+ *
+ * Flash writes only clear bits, so the other header fields are written as all ones and keep their value.
+ *
+ */
+static void clearRecordFlag(uint32_t aAddress, uint16_t aFlag)
+{
+    struct settingsBlock block;
+
+    memset(&block, 0xff, sizeof(block));
+    block.flag = static_cast<uint16_t>(~aFlag);
+    utilsFlashWrite(aAddress, reinterpret_cast<uint8_t *>(&block), sizeof(block));
+}
+
+static void clearEntryFlag(const struct settingsIndexEntry &aEntry, uint16_t aFlag)
 {
-    uint32_t oldBase = sSettingsBaseAddress;
-    uint32_t swapAddress = oldBase;
-    uint32_t usedSize = sSettingsUsedSize;
-    uint8_t pageNum = SETTINGS_CONFIG_PAGE_NUM;
-    uint32_t settingsSize = pageNum > 1 ? SETTINGS_CONFIG_PAGE_SIZE * pageNum / 2 :
-                            SETTINGS_CONFIG_PAGE_SIZE;
+    clearRecordFlag(sSettingsBaseAddress + aEntry.offset, aFlag);
 
-    (void)aInstance;
+    if (aEntry.copyOffset != 0)
+    {
+        clearRecordFlag(sCompactBaseAddress + aEntry.copyOffset, aFlag);
+    }
+}
+
+/**
+ * This function appends a record to the log at @p aBase, marking it complete unless @p aComplete is false.
+ *
+ * @returns The offset of the record from @p aBase.
+ *
+ */
+static uint16_t appendRecord(uint32_t aBase, uint32_t &aUsedSize, uint16_t aKey, uint16_t aFlag,
+                             const uint8_t *aValue, uint16_t aValueLength, bool aComplete)
+{
+    OT_TOOL_PACKED_BEGIN
+    struct addSettingsBlock
+    {
+        struct settingsBlock block;
+        uint8_t data[kSettingsBlockDataSize];
+    } OT_TOOL_PACKED_END addBlock;
+    uint16_t offset = static_cast<uint16_t>(aUsedSize);
 
-    otEXPECT(pageNum > 1);
+    addBlock.block.key = aKey;
+    addBlock.block.flag = aFlag & (~kBlockAddBeginFlag);
+    addBlock.block.length = aValueLength;
+    addBlock.block.reserved = 0xffff;
 
-    sSettingsBaseAddress = (swapAddress == SETTINGS_CONFIG_BASE_ADDRESS) ?
-                           (swapAddress + settingsSize) :
-                           SETTINGS_CONFIG_BASE_ADDRESS;
+    utilsFlashWrite(aBase + offset, reinterpret_cast<uint8_t *>(&addBlock.block), sizeof(struct settingsBlock));
 
-    initSettings(sSettingsBaseAddress, static_cast<uint32_t>(kSettingsInSwap));
-    sSettingsUsedSize = kSettingsFlagSize;
-    swapAddress += kSettingsFlagSize;
+    memset(addBlock.data, 0xff, kSettingsBlockDataSize);
+    memcpy(addBlock.data, aValue, aValueLength);
+
+    utilsFlashWrite(aBase + offset + sizeof(struct settingsBlock), addBlock.data, getAlignLength(aValueLength));
 
-    while (swapAddress < (oldBase + usedSize))
+    if (aComplete)
     {
-        OT_TOOL_PACKED_BEGIN
-        struct addSettingsBlock
+        clearRecordFlag(aBase + offset, kBlockAddCompleteFlag);
+    }
+
+    aUsedSize += getRecordSize(aValueLength);
+
+    return offset;
+}
+
+/**
+ * This function returns the position of the first index entry with a key not less than @p aKey.
+ *
+ */
+static uint16_t findKey(uint16_t aKey)
+{
+    uint16_t low = 0;
+    uint16_t high = sIndexLength;
+
+    while (low < high)
+    {
+        uint16_t mid = static_cast<uint16_t>((low + high) / 2);
+
+        if (sIndex[mid].key < aKey)
+        {
+            low = static_cast<uint16_t>(mid + 1);
+        }
+        else
         {
-            struct settingsBlock block;
-            uint8_t data[kSettingsBlockDataSize];
-        } OT_TOOL_PACKED_END addBlock;
-        bool valid = true;
+            high = mid;
+        }
+    }
 
-        utilsFlashRead(swapAddress, reinterpret_cast<uint8_t *>(&addBlock.block), sizeof(struct settingsBlock));
-        swapAddress += sizeof(struct settingsBlock);
+    return low;
+}
+
+/**
+ * This function returns the position of the @p aIndex-th record of @p aKey, or `sIndexLength` if there is none.
+ *
+ */
+static uint16_t findEntry(uint16_t aKey, int aIndex)
+{
+    uint16_t pos;
 
-        if (!(addBlock.block.flag & kBlockAddCompleteFlag) && (addBlock.block.flag & kBlockDeleteFlag))
+    for (pos = findKey(aKey); pos < sIndexLength && sIndex[pos].key == aKey; pos++)
+    {
+        if (!(sIndex[pos].flags & kEntryDeleted) && aIndex-- == 0)
         {
-            uint32_t address = swapAddress + getAlignLength(addBlock.block.length);
+            break;
+        }
+    }
 
-            while (address < (oldBase + usedSize))
-            {
-                struct settingsBlock block;
+    if (pos < sIndexLength && sIndex[pos].key != aKey)
+    {
+        pos = sIndexLength;
+    }
 
-                utilsFlashRead(address, reinterpret_cast<uint8_t *>(&block), sizeof(block));
+    return pos;
+}
 
-                if (!(block.flag & kBlockAddCompleteFlag) && (block.flag & kBlockDeleteFlag) &&
-                    !(block.flag & kBlockIndex0Flag) && (block.key == addBlock.block.key))
-                {
-                    valid = false;
-                    break;
-                }
+static void removeEntry(uint16_t aPos)
+{
+    sSettingsLiveSize -= getRecordSize(sIndex[aPos].length);
+    sIndexLength--;
+    memmove(&sIndex[aPos], &sIndex[aPos + 1], (sIndexLength - aPos) * sizeof(sIndex[0]));
+}
 
-                address += (getAlignLength(block.length) + sizeof(struct settingsBlock));
-            }
+/**
+ * This function deletes the record at index position @p aPos, or only marks it while a change set is open.
+ *
+ * @returns The position of the entry following the deleted one.
+ *
+ */
+static uint16_t deleteEntry(uint16_t aPos)
+{
+    if (sInChange && !(sIndex[aPos].flags & kEntryUncommitted))
+    {
+        sIndex[aPos].flags |= kEntryDeleted;
+        aPos++;
+    }
+    else
+    {
+        clearEntryFlag(sIndex[aPos], kBlockDeleteFlag);
+        removeEntry(aPos);
+    }
 
-            if (valid)
-            {
-                utilsFlashRead(swapAddress, addBlock.data, getAlignLength(addBlock.block.length));
-                utilsFlashWrite(sSettingsBaseAddress + sSettingsUsedSize,
-                                reinterpret_cast<uint8_t *>(&addBlock),
-                                getAlignLength(addBlock.block.length) + sizeof(struct settingsBlock));
-                sSettingsUsedSize += (sizeof(struct settingsBlock) + getAlignLength(addBlock.block.length));
-            }
+    return aPos;
+}
+
+/**
+ * This function adds an entry to the index after the other entries of the same key.
+ *
+ */
+static void insertEntry(uint16_t aKey, uint16_t aLength, uint16_t aOffset, uint8_t aFlags)
+{
+    uint16_t pos = findKey(static_cast<uint16_t>(aKey + 1));
+
+    if (aKey == 0xffff)
+    {
+        pos = sIndexLength;
+    }
+
+    // The index is sized for a settings area full of the smallest records, see `kSettingsIndexSize`.
+    assert(sIndexLength < kSettingsIndexSize);
+
+    memmove(&sIndex[pos + 1], &sIndex[pos], (sIndexLength - pos) * sizeof(sIndex[0]));
+    sIndexLength++;
+
+    sIndex[pos].key = aKey;
+    sIndex[pos].length = aLength;
+    sIndex[pos].offset = aOffset;
+    sIndex[pos].copyOffset = 0;
+    sIndex[pos].flags = aFlags;
+
+    sSettingsLiveSize += getRecordSize(aLength);
+}
+
+static void startCompaction(void)
+{
+    sCompactBaseAddress = (sSettingsBaseAddress == SETTINGS_CONFIG_BASE_ADDRESS) ?
+                          (SETTINGS_CONFIG_BASE_ADDRESS + getSettingsSize()) : SETTINGS_CONFIG_BASE_ADDRESS;
+
+    initSettings(sCompactBaseAddress, static_cast<uint32_t>(kSettingsInSwap));
+    sCompactUsedSize = kSettingsFlagSize;
+
+    for (uint16_t pos = 0; pos < sIndexLength; pos++)
+    {
+        sIndex[pos].copyOffset = 0;
+    }
+
+    sCompacting = true;
+}
+
+static void finishCompaction(void)
+{
+    setSettingsFlag(sCompactBaseAddress, static_cast<uint32_t>(kSettingsInUse));
+    setSettingsFlag(sSettingsBaseAddress, static_cast<uint32_t>(kSettingsNotUse));
+
+    for (uint16_t pos = 0; pos < sIndexLength; pos++)
+    {
+        sIndex[pos].offset = sIndex[pos].copyOffset;
+        sIndex[pos].copyOffset = 0;
+    }
+
+    sSettingsBaseAddress = sCompactBaseAddress;
+    sSettingsUsedSize = sCompactUsedSize;
+    sCompacting = false;
+}
+
+/**
+ * This function copies up to @p aCount live records to the block being compacted into, and switches to that block
+ * once all records are copied.
+ *
+ */
+static void stepCompaction(uint16_t aCount)
+{
+    uint16_t pos;
+
+    for (pos = 0; pos < sIndexLength; pos++)
+    {
+        struct settingsIndexEntry &entry = sIndex[pos];
+        uint8_t data[kSettingsBlockDataSize];
+        struct settingsBlock block;
+
+        if (entry.copyOffset != 0)
+        {
+            continue;
         }
-        else if (addBlock.block.flag == 0xff)
+
+        if (aCount-- == 0)
         {
             break;
         }
 
-        swapAddress += getAlignLength(addBlock.block.length);
-    }
+        // The copy keeps the record's flags, including those of a change set that is still open.
+        utilsFlashRead(sSettingsBaseAddress + entry.offset, reinterpret_cast<uint8_t *>(&block), sizeof(block));
+        utilsFlashRead(sSettingsBaseAddress + entry.offset + sizeof(block), data, entry.length);
 
-    setSettingsFlag(sSettingsBaseAddress, static_cast<uint32_t>(kSettingsInUse));
-    setSettingsFlag(oldBase, static_cast<uint32_t>(kSettingsNotUse));
+        entry.copyOffset = appendRecord(sCompactBaseAddress, sCompactUsedSize, block.key,
+                                        block.flag | kBlockAddCompleteFlag, data, entry.length,
+                                        !(block.flag & kBlockAddCompleteFlag));
+    }
 
-exit:
-    return settingsSize - sSettingsUsedSize;
+    if (pos == sIndexLength)
+    {
+        finishCompaction();
+    }
 }
 
-static otError addSetting(otInstance *aInstance, uint16_t aKey, bool aIndex0, const uint8_t *aValue,
-                          uint16_t aValueLength)
+/**
+ * This function makes room for a record of @p aValueLength octets, compacting synchronously if needed.
+ *
+ */
+static otError reserveRecord(uint16_t aValueLength)
 {
     otError error = OT_ERROR_NONE;
-    OT_TOOL_PACKED_BEGIN
-    struct addSettingsBlock
+    uint32_t recordSize = getRecordSize(aValueLength);
+
+    if (sSettingsUsedSize + recordSize >= getSettingsSize() && SETTINGS_CONFIG_PAGE_NUM > 1)
     {
-        struct settingsBlock block;
-        uint8_t data[kSettingsBlockDataSize];
-    } OT_TOOL_PACKED_END addBlock;
-    uint32_t settingsSize = SETTINGS_CONFIG_PAGE_NUM > 1 ?
-                            SETTINGS_CONFIG_PAGE_SIZE * SETTINGS_CONFIG_PAGE_NUM / 2 :
-                            SETTINGS_CONFIG_PAGE_SIZE;
+        if (!sCompacting)
+        {
+            startCompaction();
+        }
 
-    addBlock.block.flag = 0xff;
-    addBlock.block.key = aKey;
+        stepCompaction(kSettingsIndexSize);
+    }
 
-    if (aIndex0)
+    otEXPECT_ACTION(sSettingsUsedSize + recordSize < getSettingsSize(), error = OT_ERROR_NO_BUFS);
+
+exit:
+    return error;
+}
+
+/**
+ * This function advances the compaction, starting one once an eighth of the settings area is left and at least a
+ * quarter of it is taken by deleted records.
+ *
+ */
+static void processCompaction(void)
+{
+    uint32_t settingsSize = getSettingsSize();
+
+    if (!sCompacting && SETTINGS_CONFIG_PAGE_NUM > 1 &&
+        settingsSize - sSettingsUsedSize < settingsSize / 8 &&
+        sSettingsUsedSize - kSettingsFlagSize - sSettingsLiveSize >= settingsSize / 4)
     {
-        addBlock.block.flag &= (~kBlockIndex0Flag);
+        startCompaction();
     }
 
-    addBlock.block.flag &= (~kBlockAddBeginFlag);
-    addBlock.block.length = aValueLength;
-
-    if ((sSettingsUsedSize + getAlignLength(addBlock.block.length) + sizeof(struct settingsBlock)) >=
-        settingsSize)
+    if (sCompacting)
     {
-        otEXPECT_ACTION(swapSettingsBlock(aInstance) >= (getAlignLength(addBlock.block.length) + sizeof(struct settingsBlock)),
-                        error = OT_ERROR_NO_BUFS);
+        stepCompaction(kCompactRecordsPerStep);
     }
+}
 
-    utilsFlashWrite(sSettingsBaseAddress + sSettingsUsedSize,
-                    reinterpret_cast<uint8_t *>(&addBlock.block),
-                    sizeof(struct settingsBlock));
+/**
+ * This function writes a record to the log, the caller adds it to the index.
+ *
+ */
+static otError writeSetting(uint16_t aKey, bool aIndex0, const uint8_t *aValue, uint16_t aValueLength,
+                            uint16_t &aOffset)
+{
+    otError error = OT_ERROR_NONE;
+    uint16_t flag = 0xff;
 
-    memset(addBlock.data, 0xff, kSettingsBlockDataSize);
-    memcpy(addBlock.data, aValue, addBlock.block.length);
+    otEXPECT_ACTION(aValueLength <= kSettingsBlockDataSize, error = OT_ERROR_NO_BUFS);
+    otEXPECT((error = reserveRecord(aValueLength)) == OT_ERROR_NONE);
 
-    utilsFlashWrite(sSettingsBaseAddress + sSettingsUsedSize + sizeof(struct settingsBlock),
-                    reinterpret_cast<uint8_t *>(addBlock.data), getAlignLength(addBlock.block.length));
+    if (aIndex0)
+    {
+        flag &= (~kBlockIndex0Flag);
+    }
 
-    addBlock.block.flag &= (~kBlockAddCompleteFlag);
-    utilsFlashWrite(sSettingsBaseAddress + sSettingsUsedSize,
-                    reinterpret_cast<uint8_t *>(&addBlock.block),
-                    sizeof(struct settingsBlock));
-    sSettingsUsedSize += (sizeof(struct settingsBlock) + getAlignLength(addBlock.block.length));
+    // While compacting, the record is added to the current block and copied after the records it follows.
+    aOffset = appendRecord(sSettingsBaseAddress, sSettingsUsedSize, aKey, flag, aValue, aValueLength, !sInChange);
 
 exit:
     return error;
 }
 
+static void loadSettings(void)
+{
+    uint32_t settingsSize = getSettingsSize();
+
+    sIndexLength = 0;
+    sSettingsLiveSize = 0;
+    sSettingsUsedSize = kSettingsFlagSize;
+
+    while (sSettingsUsedSize < settingsSize)
+    {
+        struct settingsBlock block;
+
+        utilsFlashRead(sSettingsBaseAddress + sSettingsUsedSize,
+                       reinterpret_cast<uint8_t *>(&block), sizeof(block));
+
+        if (block.flag & kBlockAddBeginFlag)
+        {
+            break;
+        }
+
+        if (!(block.flag & kBlockAddCompleteFlag) && (block.flag & kBlockDeleteFlag))
+        {
+            if (!(block.flag & kBlockIndex0Flag))
+            {
+                // A record written by `otPlatSettingsSet()` replaces the earlier records of its key.
+                for (uint16_t pos = findKey(block.key); pos < sIndexLength && sIndex[pos].key == block.key;)
+                {
+                    removeEntry(pos);
+                }
+            }
+
+            insertEntry(block.key, block.length, static_cast<uint16_t>(sSettingsUsedSize), 0);
+        }
+
+        sSettingsUsedSize += getRecordSize(block.length);
+    }
+}
+
 // settings API
 void otPlatSettingsInit(otInstance *aInstance)
 {
     uint8_t index;
-    uint32_t settingsSize = SETTINGS_CONFIG_PAGE_NUM > 1 ?
-                            SETTINGS_CONFIG_PAGE_SIZE * SETTINGS_CONFIG_PAGE_NUM / 2 :
-                            SETTINGS_CONFIG_PAGE_SIZE;
+    uint32_t settingsSize = getSettingsSize();
 
     (void)aInstance;
 
     sSettingsBaseAddress = SETTINGS_CONFIG_BASE_ADDRESS;
+    sInChange = false;
+    sCompacting = false;
 
     utilsFlashInit();
 
@@ -300,95 +585,109 @@ void otPlatSettingsInit(otInstance *aInstance)
         initSettings(sSettingsBaseAddress, static_cast<uint32_t>(kSettingsInUse));
     }
 
-    sSettingsUsedSize = kSettingsFlagSize;
-
-    while (sSettingsUsedSize < settingsSize)
-    {
-        struct settingsBlock block;
-
-        utilsFlashRead(sSettingsBaseAddress + sSettingsUsedSize,
-                       reinterpret_cast<uint8_t *>(&block), sizeof(block));
-
-        if (!(block.flag & kBlockAddBeginFlag))
-        {
-            sSettingsUsedSize += (getAlignLength(block.length) + sizeof(struct settingsBlock));
-        }
-        else
-        {
-            break;
-        }
-    }
+    loadSettings();
 }
 
 otError otPlatSettingsBeginChange(otInstance *aInstance)
 {
+    otError error = OT_ERROR_NONE;
+
     (void)aInstance;
-    return OT_ERROR_NONE;
+
+    otEXPECT_ACTION(!sInChange, error = OT_ERROR_ALREADY);
+    sInChange = true;
+
+exit:
+    return error;
 }
 
 otError otPlatSettingsCommitChange(otInstance *aInstance)
 {
+    otError error = OT_ERROR_NONE;
+    uint16_t pos;
+
     (void)aInstance;
-    return OT_ERROR_NONE;
+
+    otEXPECT_ACTION(sInChange, error = OT_ERROR_INVALID_STATE);
+    sInChange = false;
+
+    // Complete the added records before deleting the replaced ones, so that no setting is ever missing.
+    for (pos = 0; pos < sIndexLength; pos++)
+    {
+        if (sIndex[pos].flags & kEntryUncommitted)
+        {
+            clearEntryFlag(sIndex[pos], kBlockAddCompleteFlag);
+            sIndex[pos].flags = 0;
+        }
+    }
+
+    for (pos = 0; pos < sIndexLength;)
+    {
+        pos = (sIndex[pos].flags & kEntryDeleted) ? deleteEntry(pos) : pos + 1;
+    }
+
+    processCompaction();
+
+exit:
+    return error;
 }
 
 otError otPlatSettingsAbandonChange(otInstance *aInstance)
 {
+    otError error = OT_ERROR_NONE;
+    uint16_t pos;
+
     (void)aInstance;
-    return OT_ERROR_NONE;
+
+    otEXPECT_ACTION(sInChange, error = OT_ERROR_INVALID_STATE);
+    sInChange = false;
+
+    for (pos = 0; pos < sIndexLength;)
+    {
+        if (sIndex[pos].flags & kEntryUncommitted)
+        {
+            pos = deleteEntry(pos);
+        }
+        else
+        {
+            sIndex[pos++].flags = 0;
+        }
+    }
+
+exit:
+    return error;
 }
 
 otError otPlatSettingsGet(otInstance *aInstance, uint16_t aKey, int aIndex, uint8_t *aValue, uint16_t *aValueLength)
 {
     otError error = OT_ERROR_NOT_FOUND;
-    uint32_t address = sSettingsBaseAddress + kSettingsFlagSize;
     uint16_t valueLength = 0;
-    int index = 0;
+    uint16_t pos;
 
     (void)aInstance;
 
-    while (address < (sSettingsBaseAddress + sSettingsUsedSize))
-    {
-        struct settingsBlock block;
-
-        utilsFlashRead(address, reinterpret_cast<uint8_t *>(&block), sizeof(block));
+    pos = findEntry(aKey, aIndex);
+    otEXPECT(pos < sIndexLength);
 
-        if (block.key == aKey)
-        {
-            if (!(block.flag & kBlockIndex0Flag))
-            {
-                index = 0;
-            }
+    valueLength = sIndex[pos].length;
+    error = OT_ERROR_NONE;
 
-            if (!(block.flag & kBlockAddCompleteFlag) && (block.flag & kBlockDeleteFlag))
-            {
-                if (index == aIndex)
-                {
-                    uint16_t readLength = block.length;
-
-                    // only perform read if an input buffer was passed in
-                    if (aValue != NULL && aValueLength != NULL)
-                    {
-                        // adjust read length if input buffer length is smaller
-                        if (readLength > *aValueLength)
-                        {
-                            readLength = *aValueLength;
-                        }
-
-                        utilsFlashRead(address + sizeof(struct settingsBlock), aValue, readLength);
-                    }
-
-                    valueLength = block.length;
-                    error = OT_ERROR_NONE;
-                }
+    // only perform read if an input buffer was passed in
+    if (aValue != NULL && aValueLength != NULL)
+    {
+        uint16_t readLength = valueLength;
 
-                index++;
-            }
+        // adjust read length if input buffer length is smaller
+        if (readLength > *aValueLength)
+        {
+            readLength = *aValueLength;
         }
 
-        address += (getAlignLength(block.length) + sizeof(struct settingsBlock));
+        utilsFlashRead(sSettingsBaseAddress + sIndex[pos].offset + sizeof(struct settingsBlock), aValue, readLength);
     }
 
+exit:
+
     if (aValueLength != NULL)
     {
         *aValueLength = valueLength;
@@ -399,60 +698,87 @@ otError otPlatSettingsGet(otInstance *aInstance, uint16_t aKey, int aIndex, uint
 
 otError otPlatSettingsSet(otInstance *aInstance, uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
 {
-    return addSetting(aInstance, aKey, true, aValue, aValueLength);
+    otError error;
+    uint16_t offset;
+    uint16_t pos;
+
+    (void)aInstance;
+
+    otEXPECT((error = writeSetting(aKey, true, aValue, aValueLength, offset)) == OT_ERROR_NONE);
+
+    pos = findEntry(aKey, 0);
+
+    if (!sInChange && pos < sIndexLength)
+    {
+        // The new record takes over the index entry of the first record it replaces.
+        clearEntryFlag(sIndex[pos], kBlockDeleteFlag);
+        sSettingsLiveSize = sSettingsLiveSize - getRecordSize(sIndex[pos].length) + getRecordSize(aValueLength);
+        sIndex[pos].length = aValueLength;
+        sIndex[pos].offset = offset;
+        sIndex[pos].copyOffset = 0;
+    }
+    else
+    {
+        insertEntry(aKey, aValueLength, offset, sInChange ? static_cast<uint8_t>(kEntryUncommitted) : 0);
+    }
+
+    // Delete the other records of the key once the new record is written.
+    for (pos = findKey(aKey); pos < sIndexLength && sIndex[pos].key == aKey;)
+    {
+        pos = (sIndex[pos].offset == offset || (sIndex[pos].flags & kEntryDeleted)) ? pos + 1 : deleteEntry(pos);
+    }
+
+    processCompaction();
+
+exit:
+    return error;
 }
 
 otError otPlatSettingsAdd(otInstance *aInstance, uint16_t aKey, const uint8_t *aValue, uint16_t aValueLength)
 {
-    uint16_t length;
-    bool index0;
+    otError error;
+    uint16_t offset;
 
-    index0 = (otPlatSettingsGet(aInstance, aKey, 0, NULL, &length) == OT_ERROR_NOT_FOUND ? true : false);
-    return addSetting(aInstance, aKey, index0, aValue, aValueLength);
+    (void)aInstance;
+
+    otEXPECT((error = writeSetting(aKey, findEntry(aKey, 0) == sIndexLength, aValue, aValueLength, offset)) ==
+             OT_ERROR_NONE);
+    insertEntry(aKey, aValueLength, offset, sInChange ? static_cast<uint8_t>(kEntryUncommitted) : 0);
+    processCompaction();
+
+exit:
+    return error;
 }
 
 otError otPlatSettingsDelete(otInstance *aInstance, uint16_t aKey, int aIndex)
 {
     otError error = OT_ERROR_NOT_FOUND;
-    uint32_t address = sSettingsBaseAddress + kSettingsFlagSize;
-    int index = 0;
+    uint16_t pos;
 
     (void)aInstance;
 
-    while (address < (sSettingsBaseAddress + sSettingsUsedSize))
+    if (aIndex == -1)
     {
-        struct settingsBlock block;
-
-        utilsFlashRead(address, reinterpret_cast<uint8_t *>(&block), sizeof(block));
-
-        if (block.key == aKey)
+        for (pos = findKey(aKey); pos < sIndexLength && sIndex[pos].key == aKey;)
         {
-            if (!(block.flag & kBlockIndex0Flag))
+            if (sIndex[pos].flags & kEntryDeleted)
             {
-                index = 0;
+                pos++;
             }
-
-            if (!(block.flag & kBlockAddCompleteFlag) && (block.flag & kBlockDeleteFlag))
+            else
             {
-                if (aIndex == index || aIndex == -1)
-                {
-                    error = OT_ERROR_NONE;
-                    block.flag &= (~kBlockDeleteFlag);
-                    utilsFlashWrite(address, reinterpret_cast<uint8_t *>(&block), sizeof(block));
-                }
-
-                if (index == 1 && aIndex == 0)
-                {
-                    block.flag &= (~kBlockIndex0Flag);
-                    utilsFlashWrite(address, reinterpret_cast<uint8_t *>(&block), sizeof(block));
-                }
-
-                index++;
+                pos = deleteEntry(pos);
+                error = OT_ERROR_NONE;
             }
         }
-
-        address += (getAlignLength(block.length) + sizeof(struct settingsBlock));
     }
+    else if ((pos = findEntry(aKey, aIndex)) < sIndexLength)
+    {
+        deleteEntry(pos);
+        error = OT_ERROR_NONE;
+    }
+
+    processCompaction();
 
     return error;
 }
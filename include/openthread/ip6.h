@@ -149,6 +149,15 @@ otError otIp6UnsubscribeMulticastAddress(otInstance *aInstance, const otIp6Addre
  */
 const otNetifMulticastAddress *otIp6GetMulticastAddresses(otInstance *aInstance);
 
+/**
+ * Get the multicast subscription counters of the Thread interface.
+ *
+ * @param[in]  aInstance A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the multicast subscription counters.
+ */
+const otNetifMulticastCounters *otIp6GetMulticastCounters(otInstance *aInstance);
+
 /**
  * Check if multicast promiscuous mode is enabled on the Thread interface.
  *
@@ -93,6 +93,23 @@ typedef enum otRadioCaps
     OT_RADIO_CAPS_CSMA_BACKOFF      = 8,  ///< Radio supports CSMA backoff for frame transmission (but no retry).
 } otRadioCaps;
 
+/**
+ * This structure represents the layout of an IEEE 802.15.4 MAC header, as parsed once by the MAC layer.
+ *
+ * All offsets are relative to the start of the PSDU.  An offset of zero indicates the field is not present.
+ * Radio drivers should ignore this structure.
+ */
+typedef struct otRadioFrameInfo
+{
+    uint8_t  mDstPanIdOffset;   ///< Offset of the Destination PAN ID.
+    uint8_t  mDstAddrOffset;    ///< Offset of the Destination Address.
+    uint8_t  mSrcPanIdOffset;   ///< Offset of the Source PAN ID.
+    uint8_t  mSrcAddrOffset;    ///< Offset of the Source Address.
+    uint8_t  mSecurityOffset;   ///< Offset of the Auxiliary Security Header.
+    uint8_t  mHeaderLength;     ///< Length of the MAC header, zero if the header has not been parsed.
+    uint8_t  mFooterLength;     ///< Length of the MAC footer (MIC and FCS).
+} otRadioFrameInfo;
+
 /**
  * This structure represents an IEEE 802.15.4 radio frame.
  */
@@ -107,6 +124,7 @@ typedef struct otRadioFrame
     bool     mSecurityValid: 1; ///< Security Enabled flag is set and frame passes security checks.
     bool     mDidTX: 1;         ///< Set to true if this frame sent from the radio. Ignored by radio driver.
     bool     mIsARetx: 1;       ///< Set to true if this frame is a retransmission. Should be ignored by radio driver.
+    otRadioFrameInfo mInfo;     ///< MAC header layout of the PSDU. Ignored by radio driver.
 } otRadioFrame;
 
 /**
@@ -396,6 +396,33 @@ OTAPI otError OTCALL otThreadGetRouterInfo(otInstance *aInstance, uint16_t aRout
  */
 OTAPI otError OTCALL otThreadGetEidCacheEntry(otInstance *aInstance, uint8_t aIndex, otEidCacheEntry *aEntry);
 
+/**
+ * This function gets the next EID cache entry. It is used to go through the cached and the pending entries of the
+ * EID cache.
+ *
+ * @param[in]     aInstance  A pointer to an OpenThread instance.
+ * @param[inout]  aIterator  A pointer to the iterator context. To get the first EID cache entry
+ *                           it should be set to OT_EID_CACHE_ITERATOR_INIT.
+ * @param[out]    aEntry     A pointer to where the EID information is placed.
+ *
+ * @retval OT_ERROR_NONE          Successfully found the next EID cache entry.
+ * @retval OT_ERROR_NOT_FOUND     No subsequent EID cache entry exists.
+ * @retval OT_ERROR_INVALID_ARGS  @p aIterator or @p aEntry was NULL.
+ *
+ */
+OTAPI otError OTCALL otThreadGetNextEidCacheEntry(otInstance *aInstance, otEidCacheIterator *aIterator,
+                                                  otEidCacheEntry *aEntry);
+
+/**
+ * This function gets the EID cache counters.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the EID cache counters.
+ *
+ */
+OTAPI const otEidCacheCounters *OTCALL otThreadGetEidCacheCounters(otInstance *aInstance);
+
 /**
  * Get the thrPSKc.
  *
@@ -865,6 +865,23 @@ typedef struct otEidCacheEntry
     bool            mValid : 1;       ///< Indicates whether or not the cache entry is valid
 } otEidCacheEntry;
 
+#define OT_EID_CACHE_ITERATOR_INIT  0  ///< Initializer for otEidCacheIterator.
+
+typedef uint16_t otEidCacheIterator;   ///< Used to iterate through the EID cache.
+
+/**
+ * This structure represents the EID cache counters.
+ *
+ */
+typedef struct otEidCacheCounters
+{
+    uint32_t mHits;           ///< The number of EID lookups resolved from the cache.
+    uint32_t mMisses;         ///< The number of EID lookups not resolved from the cache.
+    uint32_t mEvictions;      ///< The number of cached entries evicted to make room for another EID.
+    uint32_t mQueries;        ///< The number of Address Query messages sent.
+    uint32_t mQueryTimeouts;  ///< The number of Address Queries that timed out without a response.
+} otEidCacheCounters;
+
 /**
  * This structure represents the Thread Leader Data.
  *
@@ -914,6 +931,10 @@ typedef struct otMacCounters
     uint32_t mRxErrSec;               ///< The number of received packets with security error.
     uint32_t mRxErrFcs;               ///< The number of received packets with FCS error.
     uint32_t mRxErrOther;             ///< The number of received packets with other error.
+    uint32_t mRxReassemblyCompleted;  ///< The number of datagrams reassembled from fragments.
+    uint32_t mRxReassemblyTimeout;    ///< The number of datagrams dropped due to the reassembly timeout.
+    uint32_t mRxFragmentDuplicated;   ///< The number of received fragments that were already received.
+    uint32_t mRxFragmentOutOfOrder;   ///< The number of fragments received out of order.
 } otMacCounters;
 
 /**
@@ -967,6 +988,18 @@ typedef struct otNetifMulticastAddress
     struct otNetifMulticastAddress *mNext;      ///< A pointer to the next network interface multicast address.
 } otNetifMulticastAddress;
 
+/**
+ * This structure represents the network interface multicast subscription counters.
+ *
+ */
+typedef struct otNetifMulticastCounters
+{
+    uint32_t mSubscriptions;  ///< The number of multicast addresses currently subscribed.
+    uint32_t mLookups;        ///< The number of multicast subscription lookups.
+    uint32_t mMatches;        ///< The number of multicast subscription lookups that found a subscribed address.
+    uint32_t mComparisons;    ///< The number of address comparisons performed by multicast subscription lookups.
+} otNetifMulticastCounters;
+
 /**
  * This enumeration represents the list of allowable values for an InterfaceId.
  */
@@ -70,8 +70,19 @@ typedef struct otUdpSocket
     void                *mContext;   ///< A pointer to application-specific context.
     void                *mTransport; ///< A pointer to the transport object (internal use only).
     struct otUdpSocket  *mNext;      ///< A pointer to the next UDP socket (internal use only).
+    uint32_t             mReceiveSequence; ///< The last datagram handed to the socket (internal use only).
 } otUdpSocket;
 
+/**
+ * This structure represents the UDP socket lookup counters.
+ *
+ */
+typedef struct otUdpCounters
+{
+    uint32_t mLookups;  ///< The number of received UDP datagrams looked up in the socket table.
+    uint32_t mMisses;   ///< The number of received UDP datagrams that did not match any socket.
+} otUdpCounters;
+
 /**
  * Allocate a new message buffer for sending a UDP message.
  *
@@ -172,6 +183,16 @@ otError otUdpConnect(otUdpSocket *aSocket, otSockAddr *aSockName);
  */
 otError otUdpSend(otUdpSocket *aSocket, otMessage *aMessage, const otMessageInfo *aMessageInfo);
 
+/**
+ * Get the UDP socket lookup counters.
+ *
+ * @param[in]  aInstance  A pointer to an OpenThread instance.
+ *
+ * @returns A pointer to the UDP socket lookup counters.
+ *
+ */
+const otUdpCounters *otUdpGetCounters(otInstance *aInstance);
+
 /**
  * @}
  *
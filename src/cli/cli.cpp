@@ -726,6 +726,10 @@ void Interpreter::ProcessCounters(int argc, char *argv[])
             mServer->OutputFormat("    RxErrSec: %d\r\n", counters->mRxErrSec);
             mServer->OutputFormat("    RxErrFcs: %d\r\n", counters->mRxErrFcs);
             mServer->OutputFormat("    RxErrOther: %d\r\n", counters->mRxErrOther);
+            mServer->OutputFormat("    RxReassemblyCompleted: %d\r\n", counters->mRxReassemblyCompleted);
+            mServer->OutputFormat("    RxReassemblyTimeout: %d\r\n", counters->mRxReassemblyTimeout);
+            mServer->OutputFormat("    RxFragmentDuplicated: %d\r\n", counters->mRxFragmentDuplicated);
+            mServer->OutputFormat("    RxFragmentOutOfOrder: %d\r\n", counters->mRxFragmentOutOfOrder);
         }
     }
 }
@@ -878,12 +882,11 @@ void Interpreter::HandleDnsResponse(const char *aHostname, Ip6::Address &aAddres
 #if OPENTHREAD_FTD
 void Interpreter::ProcessEidCache(int argc, char *argv[])
 {
+    otEidCacheIterator iterator = OT_EID_CACHE_ITERATOR_INIT;
     otEidCacheEntry entry;
 
-    for (uint8_t i = 0; ; i++)
+    while (otThreadGetNextEidCacheEntry(mInstance, &iterator, &entry) == OT_ERROR_NONE)
     {
-        SuccessOrExit(otThreadGetEidCacheEntry(mInstance, i, &entry));
-
         if (entry.mValid == false)
         {
             continue;
@@ -901,7 +904,6 @@ void Interpreter::ProcessEidCache(int argc, char *argv[])
                               entry.mRloc16);
     }
 
-exit:
     (void)argc;
     (void)argv;
     AppendResult(OT_ERROR_NONE);
@@ -94,6 +94,11 @@ const otNetifMulticastAddress *otIp6GetMulticastAddresses(otInstance *aInstance)
     return aInstance->mThreadNetif.GetMulticastAddresses();
 }
 
+const otNetifMulticastCounters *otIp6GetMulticastCounters(otInstance *aInstance)
+{
+    return &aInstance->mThreadNetif.GetMulticastCounters();
+}
+
 otError otIp6SubscribeMulticastAddress(otInstance *aInstance, const otIp6Address *aAddress)
 {
     return aInstance->mThreadNetif.SubscribeExternalMulticast(*static_cast<const Ip6::Address *>(aAddress));
@@ -242,6 +242,22 @@ exit:
     return error;
 }
 
+otError otThreadGetNextEidCacheEntry(otInstance *aInstance, otEidCacheIterator *aIterator, otEidCacheEntry *aEntry)
+{
+    otError error;
+
+    VerifyOrExit(aIterator != NULL && aEntry != NULL, error = OT_ERROR_INVALID_ARGS);
+    error = aInstance->mThreadNetif.GetAddressResolver().GetNextEntry(*aIterator, *aEntry);
+
+exit:
+    return error;
+}
+
+const otEidCacheCounters *otThreadGetEidCacheCounters(otInstance *aInstance)
+{
+    return &aInstance->mThreadNetif.GetAddressResolver().GetCounters();
+}
+
 otError otThreadSetSteeringData(otInstance *aInstance, otExtAddress *aExtAddress)
 {
     otError error;
@@ -99,3 +99,8 @@ otError otUdpSend(otUdpSocket *aSocket, otMessage *aMessage, const otMessageInfo
     return socket->SendTo(*static_cast<Message *>(aMessage),
                           *static_cast<const Ip6::MessageInfo *>(aMessageInfo));
 }
+
+const otUdpCounters *otUdpGetCounters(otInstance *aInstance)
+{
+    return &aInstance->mIp6.mUdp.GetCounters();
+}
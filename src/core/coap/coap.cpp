@@ -905,7 +905,9 @@ void ResponsesQueue::HandleTimer(void)
     {
         enqueuedResponseHeader.ReadFrom(*message);
 
-        if (enqueuedResponseHeader.IsEarlier(Timer::GetNow()))
+        // Responses are dropped once their lifetime is reached, restarting the timer for zero milliseconds would
+        // only fire it again at the same time.
+        if (enqueuedResponseHeader.GetRemainingTime() == 0)
         {
             DequeueResponse(*message);
         }
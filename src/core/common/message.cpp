@@ -43,6 +43,7 @@
 
 #include "common/code_utils.hpp"
 #include "common/debug.hpp"
+#include "common/encoding.hpp"
 #include "common/logging.hpp"
 #include "net/ip6.hpp"
 
@@ -484,151 +485,32 @@ otError Message::RemoveHeader(uint16_t aLength)
 
 uint16_t Message::Read(uint16_t aOffset, uint16_t aLength, void *aBuf) const
 {
-    Buffer *curBuffer;
-    uint16_t bytesCopied = 0;
-    uint16_t bytesToCopy;
-
-    if (aOffset >= GetLength())
-    {
-        ExitNow();
-    }
-
-    if (aOffset + aLength >= GetLength())
-    {
-        aLength = GetLength() - aOffset;
-    }
-
-    aOffset += GetReserved();
-
-    // special case first buffer
-    if (aOffset < kHeadBufferDataSize)
-    {
-        bytesToCopy = kHeadBufferDataSize - aOffset;
-
-        if (bytesToCopy > aLength)
-        {
-            bytesToCopy = aLength;
-        }
-
-        memcpy(aBuf, GetFirstData() + aOffset, bytesToCopy);
-
-        aLength -= bytesToCopy;
-        bytesCopied += bytesToCopy;
-        aBuf = static_cast<uint8_t *>(aBuf) + bytesToCopy;
-
-        aOffset = 0;
-    }
-    else
-    {
-        aOffset -= kHeadBufferDataSize;
-    }
-
-    // advance to offset
-    curBuffer = GetNextBuffer();
-
-    while (aOffset >= kBufferDataSize)
-    {
-        assert(curBuffer != NULL);
-
-        curBuffer = curBuffer->GetNextBuffer();
-        aOffset -= kBufferDataSize;
-    }
+    Cursor cursor(*this, aOffset);
 
-    // begin copy
-    while (aLength > 0)
-    {
-        assert(curBuffer != NULL);
-
-        bytesToCopy = kBufferDataSize - aOffset;
-
-        if (bytesToCopy > aLength)
-        {
-            bytesToCopy = aLength;
-        }
-
-        memcpy(aBuf, curBuffer->GetData() + aOffset, bytesToCopy);
-
-        aLength -= bytesToCopy;
-        bytesCopied += bytesToCopy;
-        aBuf = static_cast<uint8_t *>(aBuf) + bytesToCopy;
-
-        curBuffer = curBuffer->GetNextBuffer();
-        aOffset = 0;
-    }
-
-exit:
-    return bytesCopied;
+    return cursor.Read(aBuf, aLength);
 }
 
 int Message::Write(uint16_t aOffset, uint16_t aLength, const void *aBuf)
 {
-    Buffer *curBuffer;
+    Cursor cursor(*this, aOffset);
     uint16_t bytesCopied = 0;
     uint16_t bytesToCopy;
+    const uint8_t *data;
 
     assert(aOffset + aLength <= GetLength());
 
-    if (aOffset + aLength >= GetLength())
+    while (bytesCopied < aLength && (data = cursor.GetData(bytesToCopy)) != NULL)
     {
-        aLength = GetLength() - aOffset;
-    }
-
-    aOffset += GetReserved();
-
-    // special case first buffer
-    if (aOffset < kHeadBufferDataSize)
-    {
-        bytesToCopy = kHeadBufferDataSize - aOffset;
-
-        if (bytesToCopy > aLength)
+        if (bytesToCopy > aLength - bytesCopied)
         {
-            bytesToCopy = aLength;
+            bytesToCopy = aLength - bytesCopied;
         }
 
-        memcpy(GetFirstData() + aOffset, aBuf, bytesToCopy);
+        // The cursor hands out read-only spans, this message is writable.
+        memcpy(const_cast<uint8_t *>(data), static_cast<const uint8_t *>(aBuf) + bytesCopied, bytesToCopy);
 
-        aLength -= bytesToCopy;
+        cursor.Skip(bytesToCopy);
         bytesCopied += bytesToCopy;
-        aBuf = static_cast<const uint8_t *>(aBuf) + bytesToCopy;
-
-        aOffset = 0;
-    }
-    else
-    {
-        aOffset -= kHeadBufferDataSize;
-    }
-
-    // advance to offset
-    curBuffer = GetNextBuffer();
-
-    while (aOffset >= kBufferDataSize)
-    {
-        assert(curBuffer != NULL);
-
-        curBuffer = curBuffer->GetNextBuffer();
-        aOffset -= kBufferDataSize;
-    }
-
-    // begin copy
-    while (aLength > 0)
-    {
-        assert(curBuffer != NULL);
-
-        bytesToCopy = kBufferDataSize - aOffset;
-
-        if (bytesToCopy > aLength)
-        {
-            bytesToCopy = aLength;
-        }
-
-        memcpy(curBuffer->GetData() + aOffset, aBuf, bytesToCopy);
-
-        aLength -= bytesToCopy;
-        bytesCopied += bytesToCopy;
-        aBuf = static_cast<const uint8_t *>(aBuf) + bytesToCopy;
-
-        curBuffer = curBuffer->GetNextBuffer();
-        aOffset = 0;
     }
 
     return bytesCopied;
@@ -636,20 +518,33 @@ int Message::Write(uint16_t aOffset, uint16_t aLength, const void *aBuf)
 
 int Message::CopyTo(uint16_t aSourceOffset, uint16_t aDestinationOffset, uint16_t aLength, Message &aMessage) const
 {
+    Cursor source(*this, aSourceOffset);
+    Cursor destination(aMessage, aDestinationOffset);
     uint16_t bytesCopied = 0;
     uint16_t bytesToCopy;
-    uint8_t buf[16];
+    uint16_t destinationLength;
+    const uint8_t *sourceData;
+    const uint8_t *destinationData;
 
-    while (aLength > 0)
+    while (bytesCopied < aLength &&
+           (sourceData = source.GetData(bytesToCopy)) != NULL &&
+           (destinationData = destination.GetData(destinationLength)) != NULL)
     {
-        bytesToCopy = (aLength < sizeof(buf)) ? aLength : sizeof(buf);
+        if (bytesToCopy > destinationLength)
+        {
+            bytesToCopy = destinationLength;
+        }
 
-        Read(aSourceOffset, bytesToCopy, buf);
-        aMessage.Write(aDestinationOffset, bytesToCopy, buf);
+        if (bytesToCopy > aLength - bytesCopied)
+        {
+            bytesToCopy = aLength - bytesCopied;
+        }
 
-        aSourceOffset += bytesToCopy;
-        aDestinationOffset += bytesToCopy;
-        aLength -= bytesToCopy;
+        // Source and destination may be the same message, e.g. when removing a header in place.
+        memmove(const_cast<uint8_t *>(destinationData), sourceData, bytesToCopy);
+
+        source.Skip(bytesToCopy);
+        destination.Skip(bytesToCopy);
         bytesCopied += bytesToCopy;
     }
 
@@ -683,105 +578,155 @@ exit:
     return messageCopy;
 }
 
-bool Message::GetChildMask(uint8_t aChildIndex) const
+uint16_t Message::UpdateChecksum(uint16_t aChecksum, uint16_t aOffset, uint16_t aLength) const
 {
-    assert(aChildIndex < sizeof(mBuffer.mHead.mInfo.mChildMask) * 8);
-    return (mBuffer.mHead.mInfo.mChildMask[aChildIndex / 8] & (0x80 >> (aChildIndex % 8))) != 0;
-}
+    Cursor cursor(*this, aOffset);
+    uint16_t bytesCovered = 0;
+    uint16_t bytesToCover;
+    const uint8_t *data;
 
-void Message::ClearChildMask(uint8_t aChildIndex)
-{
-    assert(aChildIndex < sizeof(mBuffer.mHead.mInfo.mChildMask) * 8);
-    mBuffer.mHead.mInfo.mChildMask[aChildIndex / 8] &= ~(0x80 >> (aChildIndex % 8));
-}
+    assert(aOffset + aLength <= GetLength());
 
-void Message::SetChildMask(uint8_t aChildIndex)
-{
-    assert(aChildIndex < sizeof(mBuffer.mHead.mInfo.mChildMask) * 8);
-    mBuffer.mHead.mInfo.mChildMask[aChildIndex / 8] |= 0x80 >> (aChildIndex % 8);
+    while (bytesCovered < aLength && (data = cursor.GetData(bytesToCover)) != NULL)
+    {
+        if (bytesToCover > aLength - bytesCovered)
+        {
+            bytesToCover = aLength - bytesCovered;
+        }
+
+        aChecksum = UpdateChecksum(aChecksum, data, bytesToCover, (bytesCovered & 1) != 0);
+
+        cursor.Skip(bytesToCover);
+        bytesCovered += bytesToCover;
+    }
+
+    return aChecksum;
 }
 
-bool Message::IsChildPending(void) const
+uint16_t Message::UpdateChecksum(uint16_t aChecksum, const uint8_t *aData, uint16_t aLength, bool aOddPosition)
 {
-    bool rval = false;
+    uint16_t checksum = Ip6::Ip6::UpdateChecksum(0, aData, aLength);
 
-    for (size_t i = 0; i < sizeof(mBuffer.mHead.mInfo.mChildMask); i++)
+    // A segment that starts on an odd byte position contributes its checksum with the two bytes swapped.
+    if (aOddPosition)
     {
-        if (mBuffer.mHead.mInfo.mChildMask[i] != 0)
-        {
-            ExitNow(rval = true);
-        }
+        checksum = Encoding::Swap16(checksum);
     }
 
-exit:
-    return rval;
+    return Ip6::Ip6::UpdateChecksum(aChecksum, checksum);
 }
 
-uint16_t Message::UpdateChecksum(uint16_t aChecksum, uint16_t aOffset, uint16_t aLength) const
+Message::Cursor::Cursor(const Message &aMessage, uint16_t aOffset):
+    mMessage(&aMessage),
+    mCurBuffer(NULL),
+    mData(NULL),
+    mSegmentLength(0),
+    mOffset(0),
+    mLength(aMessage.GetLength())
 {
-    Buffer *curBuffer;
-    uint16_t bytesCovered = 0;
-    uint16_t bytesToCover;
+    Rewind();
+    Skip(aOffset);
+}
 
-    assert(aOffset + aLength <= GetLength());
+void Message::Cursor::Rewind(void)
+{
+    mCurBuffer = mMessage;
+    mData = mMessage->GetFirstData();
+    mSegmentLength = kHeadBufferDataSize;
+    mOffset = 0;
 
-    aOffset += GetReserved();
+    Advance(mMessage->GetReserved());
+}
 
-    // special case first buffer
-    if (aOffset < kHeadBufferDataSize)
+void Message::Cursor::Advance(uint16_t aLength)
+{
+    // Move to the next buffer as soon as the current one is consumed, so that `GetData()` never returns an empty
+    // span while bytes remain.
+    while (aLength > 0 && aLength >= mSegmentLength)
     {
-        bytesToCover = kHeadBufferDataSize - aOffset;
+        aLength -= mSegmentLength;
+        mCurBuffer = mCurBuffer->GetNextBuffer();
 
-        if (bytesToCover > aLength)
+        if (mCurBuffer == NULL)
         {
-            bytesToCover = aLength;
+            mData = NULL;
+            mSegmentLength = 0;
+            ExitNow();
         }
 
-        aChecksum = Ip6::Ip6::UpdateChecksum(aChecksum, GetFirstData() + aOffset, bytesToCover);
+        mData = mCurBuffer->GetData();
+        mSegmentLength = kBufferDataSize;
+    }
 
-        aLength -= bytesToCover;
-        bytesCovered += bytesToCover;
+    mData += aLength;
+    mSegmentLength -= aLength;
 
-        aOffset = 0;
-    }
-    else
+exit:
+    return;
+}
+
+void Message::Cursor::Seek(uint16_t aOffset)
+{
+    if (aOffset < mOffset)
     {
-        aOffset -= kHeadBufferDataSize;
+        Rewind();
     }
 
-    // advance to offset
-    curBuffer = GetNextBuffer();
+    Skip(aOffset - mOffset);
+}
 
-    while (aOffset >= kBufferDataSize)
+uint16_t Message::Cursor::Skip(uint16_t aLength)
+{
+    if (aLength > GetRemainingLength())
     {
-        assert(curBuffer != NULL);
-
-        curBuffer = curBuffer->GetNextBuffer();
-        aOffset -= kBufferDataSize;
+        aLength = GetRemainingLength();
     }
 
-    // begin copy
-    while (aLength > 0)
-    {
-        assert(curBuffer != NULL);
+    Advance(aLength);
+    mOffset += aLength;
+
+    return aLength;
+}
+
+uint16_t Message::Cursor::Peek(void *aBuf, uint16_t aLength) const
+{
+    Cursor cursor(*this);
+
+    return cursor.Read(aBuf, aLength);
+}
 
-        bytesToCover = kBufferDataSize - aOffset;
+uint16_t Message::Cursor::Read(void *aBuf, uint16_t aLength)
+{
+    uint16_t bytesCopied = 0;
+    uint16_t bytesToCopy;
+    const uint8_t *data;
 
-        if (bytesToCover > aLength)
+    while (bytesCopied < aLength && (data = GetData(bytesToCopy)) != NULL)
+    {
+        if (bytesToCopy > aLength - bytesCopied)
         {
-            bytesToCover = aLength;
+            bytesToCopy = aLength - bytesCopied;
         }
 
-        aChecksum = Ip6::Ip6::UpdateChecksum(aChecksum, curBuffer->GetData() + aOffset, bytesToCover);
+        memcpy(static_cast<uint8_t *>(aBuf) + bytesCopied, data, bytesToCopy);
 
-        aLength -= bytesToCover;
-        bytesCovered += bytesToCover;
+        Skip(bytesToCopy);
+        bytesCopied += bytesToCopy;
+    }
 
-        curBuffer = curBuffer->GetNextBuffer();
-        aOffset = 0;
+    return bytesCopied;
+}
+
+const uint8_t *Message::Cursor::GetData(uint16_t &aLength) const
+{
+    aLength = GetRemainingLength();
+
+    if (aLength > mSegmentLength)
+    {
+        aLength = mSegmentLength;
     }
 
-    return aChecksum;
+    return (aLength > 0) ? mData : NULL;
 }
 
 void Message::SetMessageQueue(MessageQueue *aMessageQueue)
@@ -1056,4 +1001,136 @@ void PriorityQueue::GetInfo(uint16_t &aMessageCount, uint16_t &aBufferCount) con
     }
 }
 
+IndirectMessageRefPool::IndirectMessageRefPool(IndirectMessageRef *aRefs, uint16_t aNumRefs):
+    mFreeList(NULL),
+    mNumFree(0)
+{
+    for (uint16_t i = 0; i < aNumRefs; i++)
+    {
+        Free(aRefs[i]);
+    }
+}
+
+IndirectMessageRef *IndirectMessageRefPool::Allocate(void)
+{
+    IndirectMessageRef *ref = mFreeList;
+
+    VerifyOrExit(ref != NULL);
+
+    mFreeList = ref->mNext;
+    mNumFree--;
+    ref->mNext = NULL;
+
+exit:
+    return ref;
+}
+
+void IndirectMessageRefPool::Free(IndirectMessageRef &aRef)
+{
+    aRef.mMessage = NULL;
+    aRef.mNext = mFreeList;
+    mFreeList = &aRef;
+    mNumFree++;
+}
+
+bool IndirectMessageQueue::Contains(const Message &aMessage) const
+{
+    bool rval = false;
+
+    for (const IndirectMessageRef *ref = mHead; ref != NULL; ref = ref->mNext)
+    {
+        if (ref->mMessage == &aMessage)
+        {
+            ExitNow(rval = true);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+otError IndirectMessageQueue::Enqueue(Message &aMessage, IndirectMessageRefPool &aPool)
+{
+    otError error = OT_ERROR_NONE;
+    IndirectMessageRef *ref;
+    IndirectMessageRef *prev = NULL;
+
+    VerifyOrExit((ref = aPool.Allocate()) != NULL, error = OT_ERROR_NO_BUFS);
+    ref->mMessage = &aMessage;
+
+    // Messages are nearly always appended at the tail; only a message with a higher priority than the tail walks
+    // the queue to find its place after the last message of the same or higher priority.
+
+    if (mTail != NULL && mTail->mMessage->GetPriority() > aMessage.GetPriority())
+    {
+        for (IndirectMessageRef *cur = mHead; cur->mMessage->GetPriority() <= aMessage.GetPriority(); cur = cur->mNext)
+        {
+            prev = cur;
+        }
+    }
+    else
+    {
+        prev = mTail;
+    }
+
+    if (prev == NULL)
+    {
+        ref->mNext = mHead;
+        mHead = ref;
+    }
+    else
+    {
+        ref->mNext = prev->mNext;
+        prev->mNext = ref;
+    }
+
+    if (ref->mNext == NULL)
+    {
+        mTail = ref;
+    }
+
+    aMessage.IncrementChildCount();
+
+exit:
+    return error;
+}
+
+otError IndirectMessageQueue::Dequeue(Message &aMessage, IndirectMessageRefPool &aPool)
+{
+    otError error = OT_ERROR_NONE;
+    IndirectMessageRef *prev = NULL;
+    IndirectMessageRef *ref;
+
+    for (ref = mHead; ref != NULL; prev = ref, ref = ref->mNext)
+    {
+        if (ref->mMessage == &aMessage)
+        {
+            break;
+        }
+    }
+
+    VerifyOrExit(ref != NULL, error = OT_ERROR_NOT_FOUND);
+
+    if (prev == NULL)
+    {
+        mHead = ref->mNext;
+    }
+    else
+    {
+        prev->mNext = ref->mNext;
+    }
+
+    if (mTail == ref)
+    {
+        mTail = prev;
+    }
+
+    assert(aMessage.IsChildPending());
+    aMessage.DecrementChildCount();
+    aPool.Free(*ref);
+
+exit:
+    return error;
+}
+
 }  // namespace ot
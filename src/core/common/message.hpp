@@ -68,6 +68,7 @@ enum
     kBufferSize = OPENTHREAD_CONFIG_MESSAGE_BUFFER_SIZE,
 };
 
+class IndirectMessageQueue;
 class Message;
 class MessagePool;
 class MessageQueue;
@@ -100,7 +101,7 @@ struct MessageInfo
     uint16_t         mOffset;            ///< A byte offset within the message.
     uint16_t         mDatagramTag;       ///< The datagram tag used for 6LoWPAN fragmentation.
 
-    uint8_t          mChildMask[8];      ///< A bit-vector to indicate which sleepy children need to receive this.
+    uint8_t          mChildCount;        ///< Number of sleepy child indirect queues referencing this message.
     uint8_t          mTimeout;           ///< Seconds remaining before dropping the message.
     int8_t           mInterfaceId;       ///< The interface ID.
     union
@@ -196,6 +197,7 @@ private:
  */
 class Message: public Buffer
 {
+    friend class IndirectMessageQueue;
     friend class MessagePool;
     friend class MessageQueue;
     friend class PriorityQueue;
@@ -459,56 +461,134 @@ public:
     Message *Clone(void) const { return Clone(GetLength()); };
 
     /**
-     * This method returns the datagram tag used for 6LoWPAN fragmentation.
+     * This class implements a cursor for sequential access to the bytes of a message.
      *
-     * @returns The 6LoWPAN datagram tag.
+     * A cursor remembers the buffer and position it currently refers to, so that a sequence of reads, skips and
+     * forward seeks costs time proportional to the bytes visited rather than re-walking the buffer chain from the
+     * head on every access. A cursor must not be used after the message it refers to is resized or freed.
      *
      */
-    uint16_t GetDatagramTag(void) const { return mBuffer.mHead.mInfo.mDatagramTag; }
+    class Cursor
+    {
+    public:
+        /**
+         * This constructor initializes the cursor to refer to a given offset within a message.
+         *
+         * @param[in]  aMessage  A reference to the message.
+         * @param[in]  aOffset   Byte offset within the message.
+         *
+         */
+        Cursor(const Message &aMessage, uint16_t aOffset);
 
-    /**
-     * This method sets the datagram tag used for 6LoWPAN fragmentation.
-     *
-     * @param[in]  aTag  The 6LoWPAN datagram tag.
-     *
-     */
-    void SetDatagramTag(uint16_t aTag) { mBuffer.mHead.mInfo.mDatagramTag = aTag; }
+        /**
+         * This method returns the byte offset within the message that the cursor refers to.
+         *
+         * @returns The byte offset within the message.
+         *
+         */
+        uint16_t GetOffset(void) const { return mOffset; }
 
-    /**
-     * This method returns whether or not the message forwarding is scheduled for the child.
-     *
-     * @param[in]  aChildIndex  The index into the child table.
-     *
-     * @retval TRUE   If the message is scheduled to be forwarded to the child.
-     * @retval FALSE  If the message is not scheduled to be forwarded to the child.
-     *
-     */
-    bool GetChildMask(uint8_t aChildIndex) const;
+        /**
+         * This method returns the number of bytes between the cursor and the end of the message.
+         *
+         * @returns The number of remaining bytes.
+         *
+         */
+        uint16_t GetRemainingLength(void) const { return mLength - mOffset; }
+
+        /**
+         * This method moves the cursor to a given offset within the message.
+         *
+         * Seeking forward continues from the current buffer, seeking backward restarts from the head of the message.
+         * The offset is limited to the message length.
+         *
+         * @param[in]  aOffset  Byte offset within the message.
+         *
+         */
+        void Seek(uint16_t aOffset);
+
+        /**
+         * This method advances the cursor.
+         *
+         * @param[in]  aLength  Number of bytes to skip.
+         *
+         * @returns The number of bytes skipped.
+         *
+         */
+        uint16_t Skip(uint16_t aLength);
+
+        /**
+         * This method reads bytes at the cursor without advancing it.
+         *
+         * @param[out]  aBuf     A pointer to a data buffer.
+         * @param[in]   aLength  Number of bytes to read.
+         *
+         * @returns The number of bytes read.
+         *
+         */
+        uint16_t Peek(void *aBuf, uint16_t aLength) const;
+
+        /**
+         * This method reads bytes at the cursor and advances it past them.
+         *
+         * @param[out]  aBuf     A pointer to a data buffer.
+         * @param[in]   aLength  Number of bytes to read.
+         *
+         * @returns The number of bytes read.
+         *
+         */
+        uint16_t Read(void *aBuf, uint16_t aLength);
+
+        /**
+         * This method returns the contiguous bytes at the cursor without copying them.
+         *
+         * The span ends at the end of the current buffer or of the message, whichever comes first.
+         *
+         * @param[out]  aLength  The number of contiguous bytes available at the returned pointer.
+         *
+         * @returns A pointer to the byte at the cursor, or NULL if the cursor is at the end of the message.
+         *
+         */
+        const uint8_t *GetData(uint16_t &aLength) const;
+
+    private:
+        void Rewind(void);
+        void Advance(uint16_t aLength);
+
+        const Message *mMessage;
+        const Buffer  *mCurBuffer;
+        const uint8_t *mData;
+        uint16_t       mSegmentLength;
+        uint16_t       mOffset;
+        uint16_t       mLength;
+    };
 
     /**
-     * This method unschedules forwarding of the message to the child.
+     * This method returns the datagram tag used for 6LoWPAN fragmentation.
      *
-     * @param[in]  aChildIndex  The index into the child table.
+     * @returns The 6LoWPAN datagram tag.
      *
      */
-    void ClearChildMask(uint8_t aChildIndex);
+    uint16_t GetDatagramTag(void) const { return mBuffer.mHead.mInfo.mDatagramTag; }
 
     /**
-     * This method schedules forwarding of the message to the child.
+     * This method sets the datagram tag used for 6LoWPAN fragmentation.
      *
-     * @param[in]  aChildIndex  The index into the child table.
+     * @param[in]  aTag  The 6LoWPAN datagram tag.
      *
      */
-    void SetChildMask(uint8_t aChildIndex);
+    void SetDatagramTag(uint16_t aTag) { mBuffer.mHead.mInfo.mDatagramTag = aTag; }
 
     /**
      * This method returns whether or not the message forwarding is scheduled for at least one child.
      *
+     * A message is scheduled for a child while it is referenced from that child's `IndirectMessageQueue`.
+     *
      * @retval TRUE   If message forwarding is scheduled for at least one child.
      * @retval FALSE  If message forwarding is not scheduled for any child.
      *
      */
-    bool IsChildPending(void) const;
+    bool IsChildPending(void) const { return mBuffer.mHead.mInfo.mChildCount != 0; }
 
     /**
      * This method returns the IEEE 802.15.4 Destination PAN ID.
@@ -694,6 +774,31 @@ private:
      */
     void SetPriorityQueue(PriorityQueue *aPriorityQueue);
 
+    /**
+     * This method increments the number of child indirect queues referencing the message.
+     *
+     */
+    void IncrementChildCount(void) { mBuffer.mHead.mInfo.mChildCount++; }
+
+    /**
+     * This method decrements the number of child indirect queues referencing the message.
+     *
+     */
+    void DecrementChildCount(void) { mBuffer.mHead.mInfo.mChildCount--; }
+
+    /**
+     * This static method updates a checksum value with a contiguous segment of the message.
+     *
+     * @param[in]  aChecksum     Initial checksum value.
+     * @param[in]  aData         A pointer to the segment.
+     * @param[in]  aLength       Number of bytes in the segment.
+     * @param[in]  aOddPosition  TRUE if the segment starts at an odd byte position within the checksummed range.
+     *
+     * @retval The updated checksum value.
+     *
+     */
+    static uint16_t UpdateChecksum(uint16_t aChecksum, const uint8_t *aData, uint16_t aLength, bool aOddPosition);
+
     /**
      * This method returns a reference to the `mNext` pointer for a given list.
      *
@@ -967,6 +1072,144 @@ private:
     Message *mTails[Message::kNumPriorities];   ///< Tail pointers associated with different priority levels.
 };
 
+/**
+ * This class represents a reference to a message from an `IndirectMessageQueue`.
+ *
+ */
+class IndirectMessageRef
+{
+    friend class IndirectMessageQueue;
+    friend class IndirectMessageRefPool;
+
+public:
+    /**
+     * This method returns the referenced message.
+     *
+     * @returns A reference to the message.
+     *
+     */
+    Message &GetMessage(void) const { return *mMessage; }
+
+    /**
+     * This method returns the next reference in the queue.
+     *
+     * @returns A pointer to the next reference or NULL if this is the last one.
+     *
+     */
+    const IndirectMessageRef *GetNext(void) const { return mNext; }
+
+private:
+    Message            *mMessage;
+    IndirectMessageRef *mNext;
+};
+
+/**
+ * This class implements a pool of `IndirectMessageRef` entries backed by a caller-provided array.
+ *
+ */
+class IndirectMessageRefPool
+{
+    friend class IndirectMessageQueue;
+
+public:
+    /**
+     * This constructor initializes the pool.
+     *
+     * @param[in]  aRefs     A pointer to an array of references.
+     * @param[in]  aNumRefs  The number of entries in @p aRefs.
+     *
+     */
+    IndirectMessageRefPool(IndirectMessageRef *aRefs, uint16_t aNumRefs);
+
+    /**
+     * This method returns the number of free references.
+     *
+     * @returns The number of free references.
+     *
+     */
+    uint16_t GetFreeCount(void) const { return mNumFree; }
+
+private:
+    IndirectMessageRef *Allocate(void);
+    void Free(IndirectMessageRef &aRef);
+
+    IndirectMessageRef *mFreeList;
+    uint16_t            mNumFree;
+};
+
+/**
+ * This class implements a per-child queue of messages pending indirect transmission.
+ *
+ * The queue holds references rather than the messages themselves, so a message (e.g. a multicast sent to all sleepy
+ * children) stays queued once in the send queue while being referenced from any number of child queues.  Each
+ * reference is counted in the message (see `Message::IsChildPending()`).
+ *
+ * Messages are kept in priority order (FIFO within a priority level) as determined when they are enqueued.
+ *
+ * A zero-initialized instance is an empty queue.
+ *
+ */
+class IndirectMessageQueue
+{
+public:
+    /**
+     * This method returns the first reference in the queue.
+     *
+     * @returns A pointer to the first reference or NULL if the queue is empty.
+     *
+     */
+    const IndirectMessageRef *GetHead(void) const { return mHead; }
+
+    /**
+     * This method returns the message at the head of the queue.
+     *
+     * @returns A pointer to the first message or NULL if the queue is empty.
+     *
+     */
+    Message *GetHeadMessage(void) const { return (mHead != NULL) ? mHead->mMessage : NULL; }
+
+    /**
+     * This method indicates whether or not a message is referenced from the queue.
+     *
+     * @param[in]  aMessage  The message.
+     *
+     * @retval TRUE   If @p aMessage is in the queue.
+     * @retval FALSE  If @p aMessage is not in the queue.
+     *
+     */
+    bool Contains(const Message &aMessage) const;
+
+    /**
+     * This method adds a reference to a message to the queue.
+     *
+     * @param[in]  aMessage  The message to add.
+     * @param[in]  aPool     The pool to allocate the reference from.
+     *
+     * @retval OT_ERROR_NONE     Successfully added the message to the queue.
+     * @retval OT_ERROR_NO_BUFS  No free references in @p aPool.
+     *
+     */
+    otError Enqueue(Message &aMessage, IndirectMessageRefPool &aPool);
+
+    /**
+     * This method removes a message from the queue.
+     *
+     * Removing the message at the head of the queue takes constant time.
+     *
+     * @param[in]  aMessage  The message to remove.
+     * @param[in]  aPool     The pool to return the reference to.
+     *
+     * @retval OT_ERROR_NONE       Successfully removed the message from the queue.
+     * @retval OT_ERROR_NOT_FOUND  The message is not in the queue.
+     *
+     */
+    otError Dequeue(Message &aMessage, IndirectMessageRefPool &aPool);
+
+private:
+    IndirectMessageRef *mHead;
+    IndirectMessageRef *mTail;
+};
+
 /**
  * This class represents a message pool
  *
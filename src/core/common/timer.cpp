@@ -41,6 +41,8 @@
 
 #include "timer.hpp"
 
+#include "utils/wrap_string.h"
+
 #include <openthread/platform/alarm.h>
 
 #include "openthread-instance.h"
@@ -52,99 +54,317 @@
 namespace ot {
 
 TimerScheduler::TimerScheduler(void):
-    mHead(NULL)
+    mExpired(NULL),
+    mNow(0),
+    mAlarmTime(0),
+    mAlarmSet(false),
+    mFiring(false)
 {
+    memset(mSlots, 0, sizeof(mSlots));
+    memset(mOccupied, 0, sizeof(mOccupied));
 }
 
 void TimerScheduler::Add(Timer &aTimer)
 {
-    Remove(aTimer);
+    uint32_t now = otPlatAlarmGetNow();
+    bool updateAlarm = !mAlarmSet;
+
+    if (aTimer.IsRunning())
+    {
+        updateAlarm |= (aTimer.mSlot != kExpiredSlot && aTimer.mFireTime == mAlarmTime);
+        Unlink(aTimer);
+    }
 
-    if (mHead == NULL)
+    if (IsWheelEmpty())
+    {
+        mNow = now;
+    }
+
+    Schedule(aTimer, now);
+
+    updateAlarm |= (aTimer.mFireTime - mNow < mAlarmTime - mNow);
+
+    if (updateAlarm && !mFiring)
     {
-        mHead = &aTimer;
-        aTimer.mNext = NULL;
         SetAlarm();
     }
+}
+
+void TimerScheduler::Remove(Timer &aTimer)
+{
+    bool updateAlarm;
+
+    VerifyOrExit(aTimer.IsRunning());
+
+    updateAlarm = (aTimer.mSlot != kExpiredSlot && aTimer.mFireTime == mAlarmTime);
+    Unlink(aTimer);
+
+    if (updateAlarm && !mFiring)
+    {
+        SetAlarm();
+    }
+
+exit:
+    return;
+}
+
+void TimerScheduler::Schedule(Timer &aTimer, uint32_t aNow)
+{
+    uint32_t elapsed = aNow - aTimer.mT0;
+    uint32_t remaining = (aTimer.mDt > elapsed) ? aTimer.mDt - elapsed : 0;
+    uint32_t lag = aNow - mNow;
+    uint32_t interval = kMaxInterval;
+
+    // Intervals that do not fit in the wheel are clamped; `CollectExpired()` re-schedules the timer once the clamped
+    // interval elapses.
+    if (lag < kMaxInterval && remaining < kMaxInterval - lag)
+    {
+        interval = lag + remaining;
+    }
+
+    Insert(aTimer, mNow + interval);
+}
+
+void TimerScheduler::Insert(Timer &aTimer, uint32_t aFireTime)
+{
+    uint8_t level = GetLevel(aFireTime, mNow);
+
+    aTimer.mFireTime = aFireTime;
+    Append(aTimer, static_cast<uint16_t>((level * kSlotsPerLevel) + ((aFireTime >> (level * kSlotBits)) & kSlotMask)));
+}
+
+void TimerScheduler::Append(Timer &aTimer, uint16_t aSlot)
+{
+    Timer *&head = GetList(aSlot);
+
+    aTimer.mSlot = aSlot;
+    aTimer.mNext = NULL;
+
+    // The head's `mPrev` points to the tail of the list.
+    if (head == NULL)
+    {
+        aTimer.mPrev = &aTimer;
+        head = &aTimer;
+    }
     else
     {
-        Timer *prev = NULL;
-        Timer *cur;
+        aTimer.mPrev = head->mPrev;
+        head->mPrev->mNext = &aTimer;
+        head->mPrev = &aTimer;
+    }
+
+    if (aSlot != kExpiredSlot)
+    {
+        mOccupied[aSlot / kSlotsPerLevel] |= (1UL << (aSlot % kSlotsPerLevel));
+    }
+}
+
+void TimerScheduler::Unlink(Timer &aTimer)
+{
+    Timer *&head = GetList(aTimer.mSlot);
+
+    if (head == &aTimer)
+    {
+        head = aTimer.mNext;
+
+        if (head != NULL)
+        {
+            head->mPrev = aTimer.mPrev;
+        }
+    }
+    else
+    {
+        aTimer.mPrev->mNext = aTimer.mNext;
+
+        if (aTimer.mNext != NULL)
+        {
+            aTimer.mNext->mPrev = aTimer.mPrev;
+        }
+        else
+        {
+            head->mPrev = aTimer.mPrev;
+        }
+    }
+
+    if (head == NULL && aTimer.mSlot != kExpiredSlot)
+    {
+        mOccupied[aTimer.mSlot / kSlotsPerLevel] &= ~(1UL << (aTimer.mSlot % kSlotsPerLevel));
+    }
+
+    aTimer.mNext = &aTimer;
+    aTimer.mPrev = &aTimer;
+}
+
+void TimerScheduler::Cascade(uint16_t aSlot)
+{
+    Timer *timer;
+
+    while ((timer = mSlots[aSlot]) != NULL)
+    {
+        Unlink(*timer);
+        Insert(*timer, timer->mFireTime);
+    }
+}
+
+void TimerScheduler::CollectExpired(uint32_t aNow)
+{
+    uint16_t slot;
+    Timer *timer;
+
+    while (FindNextSlot(slot))
+    {
+        uint32_t slotTime = GetSlotTime(slot);
+
+        if (slotTime - mNow > aNow - mNow)
+        {
+            break;
+        }
 
-        for (cur = mHead; cur; cur = cur->mNext)
+        mNow = slotTime;
+
+        if (slot >= kSlotsPerLevel)
+        {
+            // The wheel time entered a slot on a higher level, move its timers closer to level zero.
+            Cascade(slot);
+            continue;
+        }
+
+        while ((timer = mSlots[slot]) != NULL)
         {
-            if (TimerCompare(aTimer, *cur))
+            Unlink(*timer);
+
+            if (aNow - timer->mT0 >= timer->mDt)
             {
-                if (prev)
-                {
-                    aTimer.mNext = cur;
-                    prev->mNext = &aTimer;
-                }
-                else
-                {
-                    aTimer.mNext = mHead;
-                    mHead = &aTimer;
-                    SetAlarm();
-                }
-
-                break;
+                Append(*timer, kExpiredSlot);
             }
+            else
+            {
+                Schedule(*timer, aNow);
+            }
+        }
+    }
+
+    mNow = aNow;
+}
 
-            prev = cur;
+bool TimerScheduler::IsWheelEmpty(void) const
+{
+    bool rval = true;
+
+    for (uint8_t level = 0; level < kNumLevels; level++)
+    {
+        if (mOccupied[level] != 0)
+        {
+            rval = false;
+            break;
         }
+    }
 
-        if (cur == NULL)
+    return rval;
+}
+
+bool TimerScheduler::FindNextSlot(uint16_t &aSlot) const
+{
+    bool rval = false;
+
+    for (uint8_t level = 0; level < kNumLevels; level++)
+    {
+        uint8_t current = (mNow >> (level * kSlotBits)) & kSlotMask;
+        uint32_t bits = mOccupied[level];
+        uint32_t pending;
+
+        if (bits == 0)
+        {
+            continue;
+        }
+
+        if (level == 0)
+        {
+            // Level zero slots hold timers that fire at exactly the slot time, including the current one.
+            pending = bits & ~((1UL << current) - 1);
+        }
+        else
+        {
+            pending = bits & ~((2UL << current) - 1);
+
+            if (pending == 0 && level == kNumLevels - 1)
+            {
+                // The top level wraps around to the beginning of the next 32-bit time lap.
+                pending = bits & ((1UL << current) - 1);
+            }
+        }
+
+        if (pending != 0)
         {
-            prev->mNext = &aTimer;
-            aTimer.mNext = NULL;
+            aSlot = static_cast<uint16_t>((level * kSlotsPerLevel) + FindFirstSet(pending));
+            rval = true;
+            break;
         }
     }
+
+    return rval;
 }
 
-void TimerScheduler::Remove(Timer &aTimer)
+uint32_t TimerScheduler::GetSlotTime(uint16_t aSlot) const
 {
-    VerifyOrExit(aTimer.mNext != &aTimer);
+    uint8_t level = static_cast<uint8_t>(aSlot / kSlotsPerLevel);
+    uint8_t shift = static_cast<uint8_t>(level * kSlotBits);
+    uint32_t time = static_cast<uint32_t>(aSlot % kSlotsPerLevel) << shift;
 
-    if (mHead == &aTimer)
+    if (level < kNumLevels - 1)
     {
-        mHead = aTimer.mNext;
-        SetAlarm();
+        time |= mNow & ~((1UL << (shift + kSlotBits)) - 1);
     }
-    else
+
+    return time;
+}
+
+uint32_t TimerScheduler::GetNextFireTime(uint16_t aSlot) const
+{
+    uint32_t fireTime = GetSlotTime(aSlot);
+
+    if (aSlot >= kSlotsPerLevel)
     {
-        for (Timer *cur = mHead; cur; cur = cur->mNext)
+        // Timers on higher levels are not sorted within their slot.
+        fireTime = mSlots[aSlot]->mFireTime;
+
+        for (const Timer *timer = mSlots[aSlot]->mNext; timer; timer = timer->mNext)
         {
-            if (cur->mNext == &aTimer)
+            if (timer->mFireTime - mNow < fireTime - mNow)
             {
-                cur->mNext = aTimer.mNext;
-                break;
+                fireTime = timer->mFireTime;
             }
         }
     }
 
-    aTimer.mNext = &aTimer;
-
-exit:
-    return;
+    return fireTime;
 }
 
 void TimerScheduler::SetAlarm(void)
 {
     uint32_t now = otPlatAlarmGetNow();
-    uint32_t elapsed;
-    uint32_t remaining;
+    uint16_t slot;
 
-    if (mHead == NULL)
+    if (mExpired != NULL)
     {
-        otPlatAlarmStop(GetIp6()->GetInstance());
+        mAlarmSet = true;
+        mAlarmTime = now;
+        otPlatAlarmStartAt(GetIp6()->GetInstance(), now, 0);
     }
-    else
+    else if (FindNextSlot(slot))
     {
-        elapsed = now - mHead->mT0;
-        remaining = (mHead->mDt > elapsed) ? mHead->mDt - elapsed : 0;
+        uint32_t fireTime = GetNextFireTime(slot);
+        uint32_t remaining = (fireTime - mNow > now - mNow) ? fireTime - now : 0;
 
+        mAlarmSet = true;
+        mAlarmTime = fireTime;
         otPlatAlarmStartAt(GetIp6()->GetInstance(), now, remaining);
     }
+    else
+    {
+        mAlarmSet = false;
+        otPlatAlarmStop(GetIp6()->GetInstance());
+    }
 }
 
 extern "C" void otPlatAlarmFired(otInstance *aInstance)
@@ -156,28 +376,21 @@ extern "C" void otPlatAlarmFired(otInstance *aInstance)
 
 void TimerScheduler::FireTimers(void)
 {
-    uint32_t now = otPlatAlarmGetNow();
-    uint32_t elapsed;
-    Timer *timer = mHead;
+    Timer *timer;
 
-    if (timer)
-    {
-        elapsed = now - timer->mT0;
+    mFiring = true;
 
-        if (elapsed >= timer->mDt)
-        {
-            Remove(*timer);
-            timer->Fired();
-        }
-        else
-        {
-            SetAlarm();
-        }
-    }
-    else
+    CollectExpired(otPlatAlarmGetNow());
+
+    while ((timer = mExpired) != NULL)
     {
-        SetAlarm();
+        Unlink(*timer);
+        timer->Fired();
     }
+
+    mFiring = false;
+
+    SetAlarm();
 }
 
 Ip6::Ip6 *TimerScheduler::GetIp6(void)
@@ -185,39 +398,29 @@ Ip6::Ip6 *TimerScheduler::GetIp6(void)
     return Ip6::Ip6FromTimerScheduler(this);
 }
 
-bool TimerScheduler::TimerCompare(const Timer &aTimerA, const Timer &aTimerB)
+uint8_t TimerScheduler::GetLevel(uint32_t aTimeA, uint32_t aTimeB)
 {
-    uint32_t now = otPlatAlarmGetNow();
-    uint32_t elapsedA = now - aTimerA.mT0;
-    uint32_t elapsedB = now - aTimerB.mT0;
-    bool retval = false;
+    uint8_t level = 0;
 
-    if (aTimerA.mDt >= elapsedA && aTimerB.mDt >= elapsedB)
-    {
-        uint32_t remainingA = aTimerA.mDt - elapsedA;
-        uint32_t remainingB = aTimerB.mDt - elapsedB;
-
-        if (remainingA < remainingB)
-        {
-            retval = true;
-        }
-    }
-    else if (aTimerA.mDt < elapsedA && aTimerB.mDt >= elapsedB)
+    for (uint32_t diff = (aTimeA ^ aTimeB) >> kSlotBits; diff != 0; diff >>= kSlotBits)
     {
-        retval = true;
+        level++;
     }
-    else if (aTimerA.mDt < elapsedA && aTimerB.mDt < elapsedB)
-    {
-        uint32_t expiredByA = elapsedA - aTimerA.mDt;
-        uint32_t expiredByB = elapsedB - aTimerB.mDt;
 
-        if (expiredByB < expiredByA)
-        {
-            retval = true;
-        }
+    return level;
+}
+
+uint8_t TimerScheduler::FindFirstSet(uint32_t aBits)
+{
+    uint8_t index = 0;
+
+    while ((aBits & 1) == 0)
+    {
+        aBits >>= 1;
+        index++;
     }
 
-    return retval;
+    return index;
 }
 
 }  // namespace ot
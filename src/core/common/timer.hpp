@@ -34,14 +34,25 @@
 #ifndef TIMER_HPP_
 #define TIMER_HPP_
 
+#ifdef OPENTHREAD_CONFIG_FILE
+#include OPENTHREAD_CONFIG_FILE
+#else
+#include <openthread-config.h>
+#endif
+
 #include <stddef.h>
 #include "utils/wrap_stdint.h"
 
 #include <openthread/types.h>
 #include <openthread/platform/alarm.h>
 
+#include "openthread-core-config.h"
 #include "common/tasklet.hpp"
 
+#if (OPENTHREAD_CONFIG_TIMER_WHEEL_SLOT_BITS < 1) || (OPENTHREAD_CONFIG_TIMER_WHEEL_SLOT_BITS > 5)
+#error "OPENTHREAD_CONFIG_TIMER_WHEEL_SLOT_BITS must be between 1 and 5."
+#endif
+
 namespace ot {
 
 namespace Ip6 { class Ip6; }
@@ -61,6 +72,11 @@ class Timer;
 /**
  * This class implements the timer scheduler.
  *
+ * Running timers are kept in a hierarchical timing wheel.  Each level of the wheel covers
+ * `OPENTHREAD_CONFIG_TIMER_WHEEL_SLOT_BITS` bits of the 32-bit millisecond fire time, and a timer is placed on the
+ * lowest level where its fire time still shares all upper bits with the current wheel time.  Starting and stopping a
+ * timer is therefore O(1), and timers only cascade towards level zero as the wheel time approaches their fire time.
+ *
  */
 class TimerScheduler
 {
@@ -90,9 +106,9 @@ public:
     void Remove(Timer &aTimer);
 
     /**
-     * This method processes all running timers.
+     * This method fires all timers that have expired.
      *
-     * @param[in]  aContext  A pointer to arbitrary context information.
+     * Timers started from within a timer handler are not fired in the same pass, even if they have already expired.
      *
      */
     void FireTimers(void);
@@ -106,21 +122,48 @@ public:
     Ip6::Ip6 *GetIp6(void);
 
 private:
-    void SetAlarm(void);
+    enum
+    {
+        kSlotBits       = OPENTHREAD_CONFIG_TIMER_WHEEL_SLOT_BITS,
+        kSlotsPerLevel  = 1 << kSlotBits,
+        kSlotMask       = kSlotsPerLevel - 1,
+        kNumLevels      = (32 + kSlotBits - 1) / kSlotBits,
+        kTopLevelShift  = (kNumLevels - 1) * kSlotBits,
+        kNumSlots       = kNumLevels * kSlotsPerLevel,
+        kExpiredSlot    = kNumSlots,  ///< Slot index used for timers that expired and are about to fire.
+    };
 
     /**
-     * This method compares two timers and returns a value to indicate
-     * which timer will fire earlier.
+     * The longest interval a timer is placed into the wheel for.  Timers with a longer interval are re-inserted
+     * when this interval elapses.
      *
-     * @param[in] aTimerA   The first timer for comparison.
-     * @param[in] aTimerB   The second timer for comparison.
-     *
-     * @returns true if aTimerA will fire before aTimerB.
-     * @returns false if aTimerA will fire at the same time or after aTimerB.
      */
-    static bool TimerCompare(const Timer &aTimerA, const Timer &aTimerB);
+    static const uint32_t kMaxInterval = 0xffffffffUL - (0xffffffffUL >> (32 - kTopLevelShift));
+
+    void Schedule(Timer &aTimer, uint32_t aNow);
+    void Insert(Timer &aTimer, uint32_t aFireTime);
+    void Append(Timer &aTimer, uint16_t aSlot);
+    void Unlink(Timer &aTimer);
+    void Cascade(uint16_t aSlot);
+    void CollectExpired(uint32_t aNow);
+    bool IsWheelEmpty(void) const;
+    bool FindNextSlot(uint16_t &aSlot) const;
+    uint32_t GetSlotTime(uint16_t aSlot) const;
+    uint32_t GetNextFireTime(uint16_t aSlot) const;
+    void SetAlarm(void);
+
+    Timer *&GetList(uint16_t aSlot) { return (aSlot == kExpiredSlot) ? mExpired : mSlots[aSlot]; }
+
+    static uint8_t GetLevel(uint32_t aTimeA, uint32_t aTimeB);
+    static uint8_t FindFirstSet(uint32_t aBits);
 
-    Timer *mHead;
+    Timer   *mSlots[kNumSlots];
+    Timer   *mExpired;
+    uint32_t mOccupied[kNumLevels];
+    uint32_t mNow;
+    uint32_t mAlarmTime;
+    bool     mAlarmSet;
+    bool     mFiring;
 };
 
 /**
@@ -153,7 +196,10 @@ public:
         mContext(aContext),
         mT0(0),
         mDt(0),
-        mNext(this) {
+        mFireTime(0),
+        mNext(this),
+        mPrev(this),
+        mSlot(0) {
     }
 
     /**
@@ -249,7 +295,10 @@ private:
     void           *mContext;
     uint32_t        mT0;
     uint32_t        mDt;
+    uint32_t        mFireTime;
     Timer          *mNext;
+    Timer          *mPrev;
+    uint16_t        mSlot;
 };
 
 /**
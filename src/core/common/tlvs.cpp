@@ -50,14 +50,19 @@ otError Tlv::Get(const Message &aMessage, uint8_t aType, uint16_t aMaxLength, Tl
     uint16_t offset;
 
     SuccessOrExit(error = GetOffset(aMessage, aType, offset));
-    aMessage.Read(offset, sizeof(Tlv), &aTlv);
 
-    if (aMaxLength > sizeof(aTlv) + aTlv.GetLength())
     {
-        aMaxLength = sizeof(aTlv) + aTlv.GetLength();
-    }
+        Message::Cursor cursor(aMessage, offset);
+
+        cursor.Peek(&aTlv, sizeof(Tlv));
+
+        if (aMaxLength > sizeof(aTlv) + aTlv.GetLength())
+        {
+            aMaxLength = sizeof(aTlv) + aTlv.GetLength();
+        }
 
-    aMessage.Read(offset, aMaxLength, &aTlv);
+        cursor.Read(&aTlv, aMaxLength);
+    }
 
 exit:
     return error;
@@ -68,11 +73,13 @@ otError Tlv::GetOffset(const Message &aMessage, uint8_t aType, uint16_t &aOffset
     otError error = OT_ERROR_NOT_FOUND;
     uint16_t offset = aMessage.GetOffset();
     uint16_t end = aMessage.GetLength();
+    Message::Cursor cursor(aMessage, offset);
     Tlv tlv;
 
     while (offset < end)
     {
-        aMessage.Read(offset, sizeof(Tlv), &tlv);
+        cursor.Seek(offset);
+        cursor.Read(&tlv, sizeof(Tlv));
 
         // skip extended TLV
         if (tlv.GetLength() == kExtendedLength)
@@ -80,7 +87,7 @@ otError Tlv::GetOffset(const Message &aMessage, uint8_t aType, uint16_t &aOffset
             uint16_t length = 0;
 
             offset += sizeof(tlv);
-            aMessage.Read(offset, sizeof(length), &length);
+            cursor.Read(&length, sizeof(length));
             offset += sizeof(length) + HostSwap16(length);
         }
         else if (tlv.GetType() == aType && (offset + sizeof(tlv) + tlv.GetLength()) <= end)
@@ -103,20 +110,22 @@ otError Tlv::GetValueOffset(const Message &aMessage, uint8_t aType, uint16_t &aO
     otError error = OT_ERROR_NOT_FOUND;
     uint16_t offset = aMessage.GetOffset();
     uint16_t end = aMessage.GetLength();
+    Message::Cursor cursor(aMessage, offset);
 
     while (offset < end)
     {
         Tlv tlv;
         uint16_t length;
 
-        aMessage.Read(offset, sizeof(tlv), &tlv);
+        cursor.Seek(offset);
+        cursor.Read(&tlv, sizeof(tlv));
         offset += sizeof(tlv);
 
         length = tlv.GetLength();
 
         if (length == kExtendedLength)
         {
-            aMessage.Read(offset, sizeof(length), &length);
+            cursor.Read(&length, sizeof(length));
             offset += sizeof(length);
             length = HostSwap16(length);
         }
@@ -39,16 +39,33 @@
 
 #include "aes_ccm.hpp"
 
+#include "utils/wrap_string.h"
+
 #include "common/code_utils.hpp"
 #include "common/debug.hpp"
+#include "common/message.hpp"
 
 namespace ot {
 namespace Crypto {
 
+AesCcm::AesCcm(void):
+    mKeyLength(0)
+{
+}
+
 otError AesCcm::SetKey(const uint8_t *aKey, uint16_t aKeyLength)
 {
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(aKeyLength <= sizeof(mKey), error = OT_ERROR_INVALID_ARGS);
+    VerifyOrExit(aKeyLength != mKeyLength || memcmp(mKey, aKey, aKeyLength) != 0);
+
     mEcb.SetKey(aKey, 8 * aKeyLength);
-    return OT_ERROR_NONE;
+    memcpy(mKey, aKey, aKeyLength);
+    mKeyLength = aKeyLength;
+
+exit:
+    return error;
 }
 
 void AesCcm::Init(uint32_t aHeaderLength, uint32_t aPlainTextLength, uint8_t aTagLength,
@@ -197,26 +214,71 @@ void AesCcm::Header(const void *aHeader, uint32_t aHeaderLength)
     }
 }
 
+void AesCcm::IncrementCounter(void)
+{
+    for (int i = sizeof(mCtr) - 1; i > mNonceLength; i--)
+    {
+        if (++mCtr[i])
+        {
+            break;
+        }
+    }
+}
+
+void AesCcm::ProcessBlock(uint8_t *aPlainText, uint8_t *aCipherText, bool aEncrypt)
+{
+    uint8_t byte;
+
+    // A whole block takes one keystream block and one CBC-MAC block.
+    if (mBlockLength == sizeof(mBlock))
+    {
+        mEcb.Encrypt(mBlock, mBlock);
+    }
+
+    IncrementCounter();
+    mEcb.Encrypt(mCtr, mCtrPad);
+
+    for (unsigned i = 0; i < sizeof(mBlock); i++)
+    {
+        if (aEncrypt)
+        {
+            byte = aPlainText[i];
+            aCipherText[i] = byte ^ mCtrPad[i];
+        }
+        else
+        {
+            byte = aCipherText[i] ^ mCtrPad[i];
+            aPlainText[i] = byte;
+        }
+
+        mBlock[i] ^= byte;
+    }
+
+    mBlockLength = sizeof(mBlock);
+    mCtrLength = sizeof(mCtrPad);
+}
+
 void AesCcm::Payload(void *plaintext, void *ciphertext, uint32_t len, bool aEncrypt)
 {
     uint8_t *plaintextBytes = reinterpret_cast<uint8_t *>(plaintext);
     uint8_t *ciphertextBytes = reinterpret_cast<uint8_t *>(ciphertext);
     uint8_t byte;
+    uint32_t i = 0;
 
     assert(mPlainTextCur + len <= mPlainTextLength);
 
-    for (unsigned i = 0; i < len; i++)
+    while (i < len)
     {
-        if (mCtrLength == 16)
+        if (mCtrLength == sizeof(mCtrPad) && (mBlockLength % sizeof(mBlock)) == 0 && len - i >= sizeof(mBlock))
         {
-            for (int j = sizeof(mCtr) - 1; j > mNonceLength; j--)
-            {
-                if (++mCtr[j])
-                {
-                    break;
-                }
-            }
+            ProcessBlock(plaintextBytes + i, ciphertextBytes + i, aEncrypt);
+            i += sizeof(mBlock);
+            continue;
+        }
 
+        if (mCtrLength == sizeof(mCtrPad))
+        {
+            IncrementCounter();
             mEcb.Encrypt(mCtr, mCtrPad);
             mCtrLength = 0;
         }
@@ -239,6 +301,7 @@ void AesCcm::Payload(void *plaintext, void *ciphertext, uint32_t len, bool aEncr
         }
 
         mBlock[mBlockLength++] ^= byte;
+        i++;
     }
 
     mPlainTextCur += len;
@@ -251,13 +314,35 @@ void AesCcm::Payload(void *plaintext, void *ciphertext, uint32_t len, bool aEncr
         }
 
         // reset counter
-        for (uint8_t i = mNonceLength + 1; i < sizeof(mCtr); i++)
+        for (uint8_t j = mNonceLength + 1; j < sizeof(mCtr); j++)
         {
-            mCtr[i] = 0;
+            mCtr[j] = 0;
         }
     }
 }
 
+void AesCcm::Payload(Message &aMessage, uint16_t aOffset, uint16_t aLength, bool aEncrypt)
+{
+    Message::Cursor cursor(aMessage, aOffset);
+    const uint8_t *data;
+    uint16_t length;
+
+    while (aLength > 0 && (data = cursor.GetData(length)) != NULL)
+    {
+        // The cursor hands out read-only spans, the message is writable and processed in place.
+        uint8_t *bytes = const_cast<uint8_t *>(data);
+
+        if (length > aLength)
+        {
+            length = aLength;
+        }
+
+        Payload(bytes, bytes, length, aEncrypt);
+        cursor.Skip(length);
+        aLength -= length;
+    }
+}
+
 void AesCcm::Finalize(void *tag, uint8_t *aTagLength)
 {
     uint8_t *tagBytes = reinterpret_cast<uint8_t *>(tag);
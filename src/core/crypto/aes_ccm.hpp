@@ -41,6 +41,9 @@
 #include "crypto/aes_ecb.hpp"
 
 namespace ot {
+
+class Message;
+
 namespace Crypto {
 
 /**
@@ -57,12 +60,29 @@ namespace Crypto {
 class AesCcm
 {
 public:
+    enum
+    {
+        kMaxKeyLength = 32,  ///< Maximum key length (bytes).
+    };
+
+    /**
+     * This constructor initializes the object.
+     *
+     */
+    AesCcm(void);
+
     /**
      * This method sets the key.
      *
+     * The expanded key schedule is kept with the object, so setting the key that is already in use again is cheap.
+     * Long-lived objects (e.g. one per security layer) only expand a key when it changes.
+     *
      * @param[in]  aKey        A pointer to the key.
      * @param[in]  aKeyLength  Length of the key in bytes.
      *
+     * @retval OT_ERROR_NONE          Successfully set the key.
+     * @retval OT_ERROR_INVALID_ARGS  @p aKeyLength is larger than `kMaxKeyLength`.
+     *
      */
     otError SetKey(const uint8_t *aKey, uint16_t aKeyLength);
 
@@ -99,6 +119,19 @@ public:
      */
     void Payload(void *aPlainText, void *aCipherText, uint32_t aLength, bool aEncrypt);
 
+    /**
+     * This method processes payload held in a message, encrypting or decrypting it in place.
+     *
+     * The message may span any number of buffers.
+     *
+     * @param[inout]  aMessage   The message.
+     * @param[in]     aOffset    Byte offset of the payload within @p aMessage.
+     * @param[in]     aLength    Payload length in bytes.
+     * @param[in]     aEncrypt   TRUE on encrypt and FALSE on decrypt.
+     *
+     */
+    void Payload(Message &aMessage, uint16_t aOffset, uint16_t aLength, bool aEncrypt);
+
     /**
      * This method generates the tag.
      *
@@ -109,7 +142,12 @@ public:
     void Finalize(void *aTag, uint8_t *aTagLength);
 
 private:
+    void IncrementCounter(void);
+    void ProcessBlock(uint8_t *aPlainText, uint8_t *aCipherText, bool aEncrypt);
+
     AesEcb mEcb;
+    uint8_t mKey[kMaxKeyLength];
+    uint16_t mKeyLength;
     uint8_t mBlock[AesEcb::kBlockSize];
     uint8_t mCtr[AesEcb::kBlockSize];
     uint8_t mCtrPad[AesEcb::kBlockSize];
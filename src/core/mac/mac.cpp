@@ -699,7 +699,6 @@ void Mac::ProcessTransmitSecurity(Frame &aFrame)
     uint8_t keyIdMode;
     uint8_t nonce[kNonceSize];
     uint8_t tagLength;
-    Crypto::AesCcm aesCcm;
     const uint8_t *key = NULL;
     const ExtAddress *extAddress = NULL;
 
@@ -765,14 +764,14 @@ void Mac::ProcessTransmitSecurity(Frame &aFrame)
 
     GenerateNonce(*extAddress, frameCounter, securityLevel, nonce);
 
-    aesCcm.SetKey(key, 16);
+    mAesCcm.SetKey(key, 16);
     tagLength = aFrame.GetFooterLength() - Frame::kFcsSize;
 
-    aesCcm.Init(aFrame.GetHeaderLength(), aFrame.GetPayloadLength(), tagLength, nonce, sizeof(nonce));
+    mAesCcm.Init(aFrame.GetHeaderLength(), aFrame.GetPayloadLength(), tagLength, nonce, sizeof(nonce));
 
-    aesCcm.Header(aFrame.GetHeader(), aFrame.GetHeaderLength());
-    aesCcm.Payload(aFrame.GetPayload(), aFrame.GetPayload(), aFrame.GetPayloadLength(), true);
-    aesCcm.Finalize(aFrame.GetFooter(), &tagLength);
+    mAesCcm.Header(aFrame.GetHeader(), aFrame.GetHeaderLength());
+    mAesCcm.Payload(aFrame.GetPayload(), aFrame.GetPayload(), aFrame.GetPayloadLength(), true);
+    mAesCcm.Finalize(aFrame.GetFooter(), &tagLength);
 
 exit:
     return;
@@ -1265,7 +1264,6 @@ otError Mac::ProcessReceiveSecurity(Frame &aFrame, const Address &aSrcAddr, Neig
     uint32_t keySequence = 0;
     const uint8_t *macKey;
     const ExtAddress *extAddress;
-    Crypto::AesCcm aesCcm;
 
     aFrame.SetSecurityValid(false);
 
@@ -1358,11 +1356,11 @@ otError Mac::ProcessReceiveSecurity(Frame &aFrame, const Address &aSrcAddr, Neig
     GenerateNonce(*extAddress, frameCounter, securityLevel, nonce);
     tagLength = aFrame.GetFooterLength() - Frame::kFcsSize;
 
-    aesCcm.SetKey(macKey, 16);
-    aesCcm.Init(aFrame.GetHeaderLength(), aFrame.GetPayloadLength(), tagLength, nonce, sizeof(nonce));
-    aesCcm.Header(aFrame.GetHeader(), aFrame.GetHeaderLength());
-    aesCcm.Payload(aFrame.GetPayload(), aFrame.GetPayload(), aFrame.GetPayloadLength(), false);
-    aesCcm.Finalize(tag, &tagLength);
+    mAesCcm.SetKey(macKey, 16);
+    mAesCcm.Init(aFrame.GetHeaderLength(), aFrame.GetPayloadLength(), tagLength, nonce, sizeof(nonce));
+    mAesCcm.Header(aFrame.GetHeader(), aFrame.GetHeaderLength());
+    mAesCcm.Payload(aFrame.GetPayload(), aFrame.GetPayload(), aFrame.GetPayloadLength(), false);
+    mAesCcm.Finalize(tag, &tagLength);
 
     VerifyOrExit(memcmp(tag, aFrame.GetFooter(), tagLength) == 0, error = OT_ERROR_SECURITY);
 
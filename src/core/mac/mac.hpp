@@ -39,6 +39,7 @@
 #include "openthread-core-config.h"
 #include "common/tasklet.hpp"
 #include "common/timer.hpp"
+#include "crypto/aes_ccm.hpp"
 #include "mac/mac_blacklist.hpp"
 #include "mac/mac_frame.hpp"
 #include "mac/mac_whitelist.hpp"
@@ -737,6 +738,7 @@ private:
     Blacklist mBlacklist;
 
     Frame *mTxFrame;
+    Crypto::AesCcm mAesCcm;
 
     otMacCounters mCounters;
     uint32_t mKeyIdMode2FrameCounter;
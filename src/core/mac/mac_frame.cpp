@@ -79,113 +79,40 @@ const char *Address::ToString(char *aBuf, uint16_t aSize) const
 
 otError Frame::InitMacHeader(uint16_t aFcf, uint8_t aSecurityControl)
 {
+    otError error;
     uint8_t *bytes = GetPsdu();
-    uint8_t length = 0;
 
     // Frame Control Field
     bytes[0] = aFcf & 0xff;
     bytes[1] = aFcf >> 8;
-    length += kFcfSize;
 
-    // Sequence Number
-    length += kDsnSize;
-
-    // Destinatinon PAN + Address
-    switch (aFcf & Frame::kFcfDstAddrMask)
-    {
-    case Frame::kFcfDstAddrNone:
-        break;
-
-    case Frame::kFcfDstAddrShort:
-        length += sizeof(PanId) + sizeof(ShortAddress);
-        break;
-
-    case Frame::kFcfDstAddrExt:
-        length += sizeof(PanId) + sizeof(ExtAddress);
-        break;
-
-    default:
-        assert(false);
-    }
-
-    // Source PAN + Address
-    switch (aFcf & Frame::kFcfSrcAddrMask)
-    {
-    case Frame::kFcfSrcAddrNone:
-        break;
-
-    case Frame::kFcfSrcAddrShort:
-        if ((aFcf & Frame::kFcfPanidCompression) == 0)
-        {
-            length += sizeof(PanId);
-        }
-
-        length += sizeof(ShortAddress);
-        break;
-
-    case Frame::kFcfSrcAddrExt:
-        if ((aFcf & Frame::kFcfPanidCompression) == 0)
-        {
-            length += sizeof(PanId);
-        }
-
-        length += sizeof(ExtAddress);
-        break;
-
-    default:
-        assert(false);
-    }
+    // The addressing fields only depend on the Frame Control Field.
+    SuccessOrExit(error = ParseHeader());
 
     // Security Header
     if (aFcf & Frame::kFcfSecurityEnabled)
     {
-        bytes[length] = aSecurityControl;
-
-        if (aSecurityControl & kSecLevelMask)
-        {
-            length += kSecurityControlSize + kFrameCounterSize;
-        }
-
-        switch (aSecurityControl & kKeyIdModeMask)
-        {
-        case kKeyIdMode0:
-            length += kKeySourceSizeMode0;
-            break;
-
-        case kKeyIdMode1:
-            length += kKeySourceSizeMode1 + kKeyIndexSize;
-            break;
-
-        case kKeyIdMode2:
-            length += kKeySourceSizeMode2 + kKeyIndexSize;
-            break;
-
-        case kKeyIdMode3:
-            length += kKeySourceSizeMode3 + kKeyIndexSize;
-            break;
-        }
+        bytes[mInfo.mSecurityOffset] = aSecurityControl;
+        SuccessOrExit(error = ParseHeader());
     }
 
-    // Command ID
-    if ((aFcf & kFcfFrameTypeMask) == kFcfFrameMacCmd)
-    {
-        length += kCommandIdSize;
-    }
+    SetPsduLength(mInfo.mHeaderLength + mInfo.mFooterLength);
 
-    SetPsduLength(length + GetFooterLength());
-
-    return OT_ERROR_NONE;
+exit:
+    assert(error == OT_ERROR_NONE);
+    return error;
 }
 
-otError Frame::ValidatePsdu(void)
+otError Frame::ParseHeader(void)
 {
-    otError error = OT_ERROR_PARSE;
-    uint8_t offset = 0;
-    uint16_t fcf;
-    uint8_t footerLength = kFcsSize;
+    otError error = OT_ERROR_NONE;
+    const uint8_t *psdu = GetPsdu();
+    uint16_t fcf = static_cast<uint16_t>((psdu[1] << 8) | psdu[0]);
+    uint8_t offset = kFcfSize + kDsnSize;
+    otRadioFrameInfo info;
 
-    VerifyOrExit((offset += kFcfSize + kDsnSize) <= GetPsduLength());
-    fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
+    memset(&info, 0, sizeof(info));
+    info.mFooterLength = kFcsSize;
 
     // Destinatinon PAN + Address
     switch (fcf & Frame::kFcfDstAddrMask)
@@ -194,18 +121,28 @@ otError Frame::ValidatePsdu(void)
         break;
 
     case Frame::kFcfDstAddrShort:
+        info.mDstPanIdOffset = offset;
+        info.mDstAddrOffset = offset + sizeof(PanId);
         offset += sizeof(PanId) + sizeof(ShortAddress);
         break;
 
     case Frame::kFcfDstAddrExt:
+        info.mDstPanIdOffset = offset;
+        info.mDstAddrOffset = offset + sizeof(PanId);
         offset += sizeof(PanId) + sizeof(ExtAddress);
         break;
 
     default:
-        goto exit;
+        ExitNow(error = OT_ERROR_PARSE);
     }
 
     // Source PAN + Address
+    if ((fcf & Frame::kFcfDstAddrMask) != Frame::kFcfDstAddrNone ||
+        (fcf & Frame::kFcfSrcAddrMask) != Frame::kFcfSrcAddrNone)
+    {
+        info.mSrcPanIdOffset = (fcf & Frame::kFcfPanidCompression) ? kFcfSize + kDsnSize : offset;
+    }
+
     switch (fcf & Frame::kFcfSrcAddrMask)
     {
     case Frame::kFcfSrcAddrNone:
@@ -217,6 +154,7 @@ otError Frame::ValidatePsdu(void)
             offset += sizeof(PanId);
         }
 
+        info.mSrcAddrOffset = offset;
         offset += sizeof(ShortAddress);
         break;
 
@@ -226,59 +164,47 @@ otError Frame::ValidatePsdu(void)
             offset += sizeof(PanId);
         }
 
+        info.mSrcAddrOffset = offset;
         offset += sizeof(ExtAddress);
         break;
 
     default:
-        goto exit;
+        ExitNow(error = OT_ERROR_PARSE);
     }
 
     // Security Header
     if (fcf & Frame::kFcfSecurityEnabled)
     {
-        uint8_t secControl = GetPsdu()[offset];
+        uint8_t secControl = psdu[offset];
 
-        offset += kSecurityControlSize + kFrameCounterSize;
+        info.mSecurityOffset = offset;
+        offset += kSecurityControlSize + kFrameCounterSize + GetKeySourceLength(secControl & kKeyIdModeMask);
 
-        switch (secControl & kKeyIdModeMask)
+        if ((secControl & kKeyIdModeMask) != kKeyIdMode0)
         {
-        case kKeyIdMode0:
-            offset += kKeySourceSizeMode0;
-            break;
-
-        case kKeyIdMode1:
-            offset += kKeySourceSizeMode1 + kKeyIndexSize;
-            break;
-
-        case kKeyIdMode2:
-            offset += kKeySourceSizeMode2 + kKeyIndexSize;
-            break;
-
-        case kKeyIdMode3:
-            offset += kKeySourceSizeMode3 + kKeyIndexSize;
-            break;
+            offset += kKeyIndexSize;
         }
 
         switch (secControl & kSecLevelMask)
         {
         case kSecNone:
         case kSecEnc:
-            footerLength += kMic0Size;
+            info.mFooterLength += kMic0Size;
             break;
 
         case kSecMic32:
         case kSecEncMic32:
-            footerLength += kMic32Size;
+            info.mFooterLength += kMic32Size;
             break;
 
         case kSecMic64:
         case kSecEncMic64:
-            footerLength += kMic64Size;
+            info.mFooterLength += kMic64Size;
             break;
 
         case kSecMic128:
         case kSecEncMic128:
-            footerLength += kMic128Size;
+            info.mFooterLength += kMic128Size;
             break;
         }
     }
@@ -289,9 +215,20 @@ otError Frame::ValidatePsdu(void)
         offset += kCommandIdSize;
     }
 
-    VerifyOrExit((offset + footerLength) <= GetPsduLength());
+    info.mHeaderLength = offset;
+
+exit:
+    mInfo = info;
+    return error;
+}
+
+otError Frame::ValidatePsdu(void)
+{
+    otError error = OT_ERROR_PARSE;
 
-    error = OT_ERROR_NONE;
+    VerifyOrExit(kFcfSize + kDsnSize <= GetPsduLength());
+    SuccessOrExit(error = ParseHeader());
+    VerifyOrExit((mInfo.mHeaderLength + mInfo.mFooterLength) <= GetPsduLength(), error = OT_ERROR_PARSE);
 
 exit:
     return error;
@@ -365,18 +302,9 @@ void Frame::SetSequence(uint8_t aSequence)
 
 uint8_t *Frame::FindDstPanId(void)
 {
-    uint8_t *cur = GetPsdu();
-    uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
+    uint8_t offset = GetInfo().mDstPanIdOffset;
 
-    VerifyOrExit((fcf & Frame::kFcfDstAddrMask) != Frame::kFcfDstAddrNone, cur = NULL);
-
-    // Frame Control Field
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-
-exit:
-    return cur;
+    return (offset != 0) ? GetPsdu() + offset : NULL;
 }
 
 otError Frame::GetDstPanId(PanId &aPanId)
@@ -407,26 +335,16 @@ otError Frame::SetDstPanId(PanId aPanId)
 
 uint8_t *Frame::FindDstAddr(void)
 {
-    uint8_t *cur = GetPsdu();
-
-    // Frame Control Field
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-    // Destination PAN
-    cur += sizeof(PanId);
+    uint8_t offset = GetInfo().mDstAddrOffset;
 
-    return cur;
+    return (offset != 0) ? GetPsdu() + offset : NULL;
 }
 
 otError Frame::GetDstAddr(Address &aAddress)
 {
-    otError error = OT_ERROR_NONE;
-    uint8_t *buf;
+    uint8_t *buf = FindDstAddr();
     uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
 
-    VerifyOrExit(buf = FindDstAddr(), error = OT_ERROR_PARSE);
-
     switch (fcf & Frame::kFcfDstAddrMask)
     {
     case Frame::kFcfDstAddrShort:
@@ -449,8 +367,7 @@ otError Frame::GetDstAddr(Address &aAddress)
         break;
     }
 
-exit:
-    return error;
+    return OT_ERROR_NONE;
 }
 
 otError Frame::SetDstAddr(ShortAddress aShortAddress)
@@ -489,34 +406,9 @@ otError Frame::SetDstAddr(const ExtAddress &aExtAddress)
 
 uint8_t *Frame::FindSrcPanId(void)
 {
-    uint8_t *cur = GetPsdu();
-    uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
-
-    VerifyOrExit((fcf & Frame::kFcfDstAddrMask) != Frame::kFcfDstAddrNone ||
-                 (fcf & Frame::kFcfSrcAddrMask) != Frame::kFcfSrcAddrNone, cur = NULL);
-
-    // Frame Control Field
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-
-    if ((fcf & Frame::kFcfPanidCompression) == 0)
-    {
-        // Destination PAN + Address
-        switch (fcf & Frame::kFcfDstAddrMask)
-        {
-        case Frame::kFcfDstAddrShort:
-            cur += sizeof(PanId) + sizeof(ShortAddress);
-            break;
-
-        case Frame::kFcfDstAddrExt:
-            cur += sizeof(PanId) + sizeof(ExtAddress);
-            break;
-        }
-    }
+    uint8_t offset = GetInfo().mSrcPanIdOffset;
 
-exit:
-    return cur;
+    return (offset != 0) ? GetPsdu() + offset : NULL;
 }
 
 otError Frame::GetSrcPanId(PanId &aPanId)
@@ -548,67 +440,39 @@ exit:
 
 uint8_t *Frame::FindSrcAddr(void)
 {
-    uint8_t *cur = GetPsdu();
-    uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
-
-    // Frame Control Field
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-
-    // Destination PAN + Address
-    switch (fcf & Frame::kFcfDstAddrMask)
-    {
-    case Frame::kFcfDstAddrShort:
-        cur += sizeof(PanId) + sizeof(ShortAddress);
-        break;
-
-    case Frame::kFcfDstAddrExt:
-        cur += sizeof(PanId) + sizeof(ExtAddress);
-        break;
-    }
-
-    // Source PAN
-    if ((fcf & Frame::kFcfPanidCompression) == 0)
-    {
-        cur += sizeof(PanId);
-    }
+    uint8_t offset = GetInfo().mSrcAddrOffset;
 
-    return cur;
+    return (offset != 0) ? GetPsdu() + offset : NULL;
 }
 
-otError Frame::GetSrcAddr(Address &address)
+otError Frame::GetSrcAddr(Address &aAddress)
 {
-    otError error = OT_ERROR_NONE;
-    uint8_t *buf;
+    uint8_t *buf = FindSrcAddr();
     uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
 
-    VerifyOrExit((buf = FindSrcAddr()) != NULL, error = OT_ERROR_PARSE);
-
     switch (fcf & Frame::kFcfSrcAddrMask)
     {
     case Frame::kFcfSrcAddrShort:
-        address.mLength = sizeof(ShortAddress);
-        address.mShortAddress = static_cast<uint16_t>((buf[1] << 8) | buf[0]);
+        aAddress.mLength = sizeof(ShortAddress);
+        aAddress.mShortAddress = static_cast<uint16_t>((buf[1] << 8) | buf[0]);
         break;
 
     case Frame::kFcfSrcAddrExt:
-        address.mLength = sizeof(ExtAddress);
+        aAddress.mLength = sizeof(ExtAddress);
 
         for (unsigned int i = 0; i < sizeof(ExtAddress); i++)
         {
-            address.mExtAddress.m8[i] = buf[sizeof(ExtAddress) - 1 - i];
+            aAddress.mExtAddress.m8[i] = buf[sizeof(ExtAddress) - 1 - i];
         }
 
         break;
 
     default:
-        address.mLength = 0;
+        aAddress.mLength = 0;
         break;
     }
 
-exit:
-    return error;
+    return OT_ERROR_NONE;
 }
 
 otError Frame::SetSrcAddr(ShortAddress aShortAddress)
@@ -647,52 +511,9 @@ otError Frame::SetSrcAddr(const ExtAddress &aExtAddress)
 
 uint8_t *Frame::FindSecurityHeader(void)
 {
-    uint8_t *cur = GetPsdu();
-    uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
+    uint8_t offset = GetInfo().mSecurityOffset;
 
-    VerifyOrExit((fcf & Frame::kFcfSecurityEnabled) != 0, cur = NULL);
-
-    // Frame Control Field
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-
-    // Destination PAN + Address
-    switch (fcf & Frame::kFcfDstAddrMask)
-    {
-    case Frame::kFcfDstAddrShort:
-        cur += sizeof(PanId) + sizeof(ShortAddress);
-        break;
-
-    case Frame::kFcfDstAddrExt:
-        cur += sizeof(PanId) + sizeof(ExtAddress);
-        break;
-    }
-
-    // Source PAN + Address
-    switch (fcf & Frame::kFcfSrcAddrMask)
-    {
-    case Frame::kFcfSrcAddrShort:
-        if ((fcf & Frame::kFcfPanidCompression) == 0)
-        {
-            cur += sizeof(PanId);
-        }
-
-        cur += sizeof(ShortAddress);
-        break;
-
-    case Frame::kFcfSrcAddrExt:
-        if ((fcf & Frame::kFcfPanidCompression) == 0)
-        {
-            cur += sizeof(PanId);
-        }
-
-        cur += sizeof(ExtAddress);
-        break;
-    }
-
-exit:
-    return cur;
+    return (offset != 0) ? GetPsdu() + offset : NULL;
 }
 
 otError Frame::GetSecurityLevel(uint8_t &aSecurityLevel)
@@ -873,44 +694,12 @@ exit:
 
 uint8_t Frame::GetHeaderLength(void)
 {
-    return static_cast<uint8_t>(GetPayload() - GetPsdu());
+    return GetInfo().mHeaderLength;
 }
 
 uint8_t Frame::GetFooterLength(void)
 {
-    uint8_t footerLength = 0;
-    uint8_t *cur;
-
-    VerifyOrExit((cur = FindSecurityHeader()) != NULL);
-
-    switch (cur[0] & kSecLevelMask)
-    {
-    case kSecNone:
-    case kSecEnc:
-        footerLength += kMic0Size;
-        break;
-
-    case kSecMic32:
-    case kSecEncMic32:
-        footerLength += kMic32Size;
-        break;
-
-    case kSecMic64:
-    case kSecEncMic64:
-        footerLength += kMic64Size;
-        break;
-
-    case kSecMic128:
-    case kSecEncMic128:
-        footerLength += kMic128Size;
-        break;
-    }
-
-exit:
-    // Frame Check Sequence
-    footerLength += kFcsSize;
-
-    return footerLength;
+    return GetInfo().mFooterLength;
 }
 
 uint8_t Frame::GetMaxPayloadLength(void)
@@ -936,96 +725,9 @@ uint8_t *Frame::GetHeader(void)
 
 uint8_t *Frame::GetPayload(void)
 {
-    uint8_t *cur = GetPsdu();
-    uint16_t fcf = static_cast<uint16_t>((GetPsdu()[1] << 8) | GetPsdu()[0]);
-    uint8_t securityControl;
-
-    // Frame Control
-    cur += kFcfSize;
-    // Sequence Number
-    cur += kDsnSize;
-
-    // Destination PAN + Address
-    switch (fcf & Frame::kFcfDstAddrMask)
-    {
-    case Frame::kFcfDstAddrNone:
-        break;
-
-    case Frame::kFcfDstAddrShort:
-        cur += sizeof(PanId) + sizeof(ShortAddress);
-        break;
-
-    case Frame::kFcfDstAddrExt:
-        cur += sizeof(PanId) + sizeof(ExtAddress);
-        break;
-
-    default:
-        ExitNow(cur = NULL);
-    }
-
-    // Source PAN + Address
-    switch (fcf & Frame::kFcfSrcAddrMask)
-    {
-    case Frame::kFcfSrcAddrNone:
-        break;
-
-    case Frame::kFcfSrcAddrShort:
-        if ((fcf & Frame::kFcfPanidCompression) == 0)
-        {
-            cur += sizeof(PanId);
-        }
-
-        cur += sizeof(ShortAddress);
-        break;
+    uint8_t headerLength = GetInfo().mHeaderLength;
 
-    case Frame::kFcfSrcAddrExt:
-        if ((fcf & Frame::kFcfPanidCompression) == 0)
-        {
-            cur += sizeof(PanId);
-        }
-
-        cur += sizeof(ExtAddress);
-        break;
-
-    default:
-        ExitNow(cur = NULL);
-    }
-
-    // Security Control + Frame Counter + Key Identifier
-    if ((fcf & Frame::kFcfSecurityEnabled) != 0)
-    {
-        securityControl = *cur;
-
-        cur += kSecurityControlSize + kFrameCounterSize;
-
-        switch (securityControl & kKeyIdModeMask)
-        {
-        case kKeyIdMode0:
-            cur += kKeySourceSizeMode0;
-            break;
-
-        case kKeyIdMode1:
-            cur += kKeySourceSizeMode1 + kKeyIndexSize;
-            break;
-
-        case kKeyIdMode2:
-            cur += kKeySourceSizeMode2 + kKeyIndexSize;
-            break;
-
-        case kKeyIdMode3:
-            cur += kKeySourceSizeMode3 + kKeyIndexSize;
-            break;
-        }
-    }
-
-    // Command ID
-    if ((fcf & kFcfFrameTypeMask) == kFcfFrameMacCmd)
-    {
-        cur += kCommandIdSize;
-    }
-
-exit:
-    return cur;
+    return (headerLength != 0) ? GetPsdu() + headerLength : NULL;
 }
 
 uint8_t *Frame::GetFooter(void)
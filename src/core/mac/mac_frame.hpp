@@ -272,6 +272,8 @@ public:
     /**
      * This method validates the frame.
      *
+     * On success, the MAC header layout is recorded so that subsequent accessors do not re-parse the header.
+     *
      * @retval OT_ERROR_NONE    Successfully parsed the MAC header.
      * @retval OT_ERROR_PARSE   Failed to parse through the MAC header.
      *
@@ -760,6 +762,17 @@ public:
     const char *ToInfoString(char *aBuf, uint16_t aSize);
 
 private:
+    otError ParseHeader(void);
+    const otRadioFrameInfo &GetInfo(void)
+    {
+        if (mInfo.mHeaderLength == 0)
+        {
+            ParseHeader();
+        }
+
+        return mInfo;
+    }
+
     uint8_t *FindSequence(void);
     uint8_t *FindDstPanId(void);
     uint8_t *FindDstAddr(void);
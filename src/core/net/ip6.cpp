@@ -69,6 +69,7 @@ Ip6::Ip6(void):
     mIsReceiveIp6FilterEnabled(false),
     mNetifListHead(NULL)
 {
+    InvalidateSourceAddressCache();
 }
 
 Message *Ip6::NewMessage(uint16_t aReserved)
@@ -85,13 +86,48 @@ uint16_t Ip6::UpdateChecksum(uint16_t aChecksum, uint16_t aValue)
 uint16_t Ip6::UpdateChecksum(uint16_t aChecksum, const void *aBuf, uint16_t aLength)
 {
     const uint8_t *bytes = reinterpret_cast<const uint8_t *>(aBuf);
+    uint64_t sumA = 0;
+    uint64_t sumB = 0;
+    uint32_t words[4];
+    uint16_t half;
+    uint16_t result;
+
+    // The one's complement sum does not depend on the byte order of the 16-bit words, so native words are summed
+    // with deferred carries and the folded result is converted to network byte order once at the end.  The loop
+    // body is kept free of dependencies so that the compiler can vectorize it where the target supports it.
+    while (aLength >= sizeof(words))
+    {
+        memcpy(words, bytes, sizeof(words));
+        sumA += static_cast<uint64_t>(words[0]) + words[1];
+        sumB += static_cast<uint64_t>(words[2]) + words[3];
+        bytes += sizeof(words);
+        aLength -= sizeof(words);
+    }
+
+    sumA += sumB;
+
+    while (aLength >= sizeof(half))
+    {
+        memcpy(&half, bytes, sizeof(half));
+        sumA += half;
+        bytes += sizeof(half);
+        aLength -= sizeof(half);
+    }
+
+    sumA = (sumA & 0xffffffff) + (sumA >> 32);
+    sumA = (sumA & 0xffff) + ((sumA >> 16) & 0xffff) + (sumA >> 32);
+    sumA = (sumA & 0xffff) + (sumA >> 16);
+    sumA = (sumA & 0xffff) + (sumA >> 16);
 
-    for (int i = 0; i < aLength; i++)
+    result = HostSwap16(static_cast<uint16_t>(sumA));
+
+    if (aLength > 0)
     {
-        aChecksum = Ip6::UpdateChecksum(aChecksum, (i & 1) ? bytes[i] : static_cast<uint16_t>(bytes[i] << 8));
+        // A trailing odd byte is the high-order byte of the last 16-bit word.
+        result = UpdateChecksum(result, static_cast<uint16_t>(bytes[0] << 8));
     }
 
-    return aChecksum;
+    return UpdateChecksum(aChecksum, result);
 }
 
 uint16_t Ip6::UpdateChecksum(uint16_t aChecksum, const Address &aAddress)
@@ -880,6 +916,7 @@ otError Ip6::AddNetif(Netif &aNetif)
     }
 
     aNetif.mNext = NULL;
+    InvalidateSourceAddressCache();
 
 exit:
     return error;
@@ -911,6 +948,7 @@ otError Ip6::RemoveNetif(Netif &aNetif)
     }
 
     aNetif.mNext = NULL;
+    InvalidateSourceAddressCache();
 
 exit:
     return error;
@@ -950,7 +988,51 @@ exit:
     return rval;
 }
 
+void Ip6::InvalidateSourceAddressCache(void)
+{
+    for (uint8_t i = 0; i < kSourceAddressCacheEntries; i++)
+    {
+        mSourceAddressCache[i].mSource = NULL;
+    }
+
+    mSourceAddressCacheNext = 0;
+}
+
 const NetifUnicastAddress *Ip6::SelectSourceAddress(MessageInfo &aMessageInfo)
+{
+    const NetifUnicastAddress *rval = NULL;
+    int8_t interfaceId = aMessageInfo.mInterfaceId;
+    SourceAddressCacheEntry *entry;
+
+    for (uint8_t i = 0; i < kSourceAddressCacheEntries; i++)
+    {
+        entry = &mSourceAddressCache[i];
+
+        if (entry->mSource != NULL && entry->mInterfaceId == interfaceId &&
+            entry->mDestination == aMessageInfo.GetPeerAddr())
+        {
+            aMessageInfo.mInterfaceId = entry->mSourceInterfaceId;
+            ExitNow(rval = entry->mSource);
+        }
+    }
+
+    // The selection depends on the whole destination address (rule 1 and longest prefix matching),
+    // so the full address is used as the key. Entries are replaced in round-robin order.
+    rval = EvaluateSourceAddress(aMessageInfo);
+    VerifyOrExit(rval != NULL);
+
+    entry = &mSourceAddressCache[mSourceAddressCacheNext];
+    entry->mDestination = aMessageInfo.GetPeerAddr();
+    entry->mInterfaceId = interfaceId;
+    entry->mSource = rval;
+    entry->mSourceInterfaceId = aMessageInfo.mInterfaceId;
+    mSourceAddressCacheNext = static_cast<uint8_t>((mSourceAddressCacheNext + 1) % kSourceAddressCacheEntries);
+
+exit:
+    return rval;
+}
+
+const NetifUnicastAddress *Ip6::EvaluateSourceAddress(MessageInfo &aMessageInfo)
 {
     Address *destination = &aMessageInfo.GetPeerAddr();
     int interfaceId = aMessageInfo.mInterfaceId;
@@ -50,6 +50,10 @@
 #include "net/socket.hpp"
 #include "net/udp6.hpp"
 
+#if OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES < 1 || OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES > 0xff
+#error "OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES must be between 1 and 255"
+#endif
+
 using ot::Encoding::BigEndian::HostSwap16;
 using ot::Encoding::BigEndian::HostSwap32;
 
@@ -321,6 +325,14 @@ public:
      */
     const NetifUnicastAddress *SelectSourceAddress(MessageInfo &aMessageInfo);
 
+    /**
+     * This method clears the cached results of source address selection.
+     *
+     * It must be called whenever the unicast addresses assigned to a network interface change.
+     *
+     */
+    void InvalidateSourceAddressCache(void);
+
     /**
      * This method determines which network interface @p aAddress is on-link, if any.
      *
@@ -380,9 +392,26 @@ private:
     otError HandleOptions(Message &aMessage, Header &aHeader, bool &aForward);
     otError HandlePayload(Message &aMessage, MessageInfo &aMessageInfo, uint8_t aIpProto);
     int8_t FindForwardInterfaceId(const MessageInfo &aMessageInfo);
+    const NetifUnicastAddress *EvaluateSourceAddress(MessageInfo &aMessageInfo);
+
+    enum
+    {
+        kSourceAddressCacheEntries = OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES,
+    };
+
+    struct SourceAddressCacheEntry
+    {
+        Address mDestination;
+        const NetifUnicastAddress *mSource;  // NULL if the entry is unused.
+        int8_t mInterfaceId;                  // The interface requested by the sender.
+        int8_t mSourceInterfaceId;            // The interface of the selected source address.
+    };
 
     bool mForwardingEnabled;
 
+    SourceAddressCacheEntry mSourceAddressCache[kSourceAddressCacheEntries];
+    uint8_t mSourceAddressCacheNext;
+
     PriorityQueue mSendQueue;
     Tasklet mSendQueueTask;
 
@@ -42,6 +42,7 @@
 #include <openthread/platform/random.h>
 
 #include "common/code_utils.hpp"
+#include "common/debug.hpp"
 #include "common/message.hpp"
 #include "net/ip6.hpp"
 
@@ -65,9 +66,18 @@ Mpl::Mpl(Ip6 &aIp6):
     mTimerExpirations(0),
     mSequence(0),
     mSeedId(0),
-    mMatchingAddress(NULL)
+    mMatchingAddress(NULL),
+    mSeedSetFree(0),
+    mNumBufferedMessages(0)
 {
     memset(mSeedSet, 0, sizeof(mSeedSet));
+
+    for (uint8_t i = 0; i < kNumSeedEntries; i++)
+    {
+        mSeedSet[i].SetNext(static_cast<uint8_t>((i + 1 < kNumSeedEntries) ? i + 1 : kInvalidIndex));
+    }
+
+    memset(mSeedSetBuckets, kInvalidIndex, sizeof(mSeedSetBuckets));
 }
 
 void Mpl::InitOption(OptionMpl &aOption, const Address &aAddress)
@@ -90,37 +100,109 @@ void Mpl::InitOption(OptionMpl &aOption, const Address &aAddress)
     }
 }
 
+uint8_t Mpl::GetSeedBucket(uint16_t aSeedId) const
+{
+    // Seed Ids are usually RLOC16s which differ in a few high or low bits; mix them over the buckets.
+    uint32_t hash = static_cast<uint32_t>(aSeedId) * 2654435761u;
+
+    return static_cast<uint8_t>((hash >> 16) % kNumSeedBuckets);
+}
+
+MplSeedEntry *Mpl::FindSeedEntry(uint16_t aSeedId)
+{
+    MplSeedEntry *entry = NULL;
+
+    for (uint8_t index = mSeedSetBuckets[GetSeedBucket(aSeedId)]; index != kInvalidIndex;
+         index = mSeedSet[index].GetNext())
+    {
+        if (mSeedSet[index].GetSeedId() == aSeedId)
+        {
+            ExitNow(entry = &mSeedSet[index]);
+        }
+    }
+
+exit:
+    return entry;
+}
+
+MplSeedEntry *Mpl::AllocateSeedEntry(uint16_t aSeedId)
+{
+    MplSeedEntry *entry = NULL;
+    uint8_t bucket = GetSeedBucket(aSeedId);
+
+    VerifyOrExit(mSeedSetFree != kInvalidIndex);
+
+    entry = &mSeedSet[mSeedSetFree];
+    mSeedSetFree = entry->GetNext();
+
+    entry->SetSeedId(aSeedId);
+    entry->SetNext(mSeedSetBuckets[bucket]);
+    mSeedSetBuckets[bucket] = static_cast<uint8_t>(entry - mSeedSet);
+
+exit:
+    return entry;
+}
+
+void Mpl::FreeSeedEntry(MplSeedEntry &aEntry)
+{
+    uint8_t index = static_cast<uint8_t>(&aEntry - mSeedSet);
+    uint8_t bucket = GetSeedBucket(aEntry.GetSeedId());
+    uint8_t prev = kInvalidIndex;
+
+    for (uint8_t cur = mSeedSetBuckets[bucket]; cur != index; cur = mSeedSet[cur].GetNext())
+    {
+        prev = cur;
+    }
+
+    if (prev == kInvalidIndex)
+    {
+        mSeedSetBuckets[bucket] = aEntry.GetNext();
+    }
+    else
+    {
+        mSeedSet[prev].SetNext(aEntry.GetNext());
+    }
+
+    aEntry.SetLifetime(0);
+    aEntry.SetNext(mSeedSetFree);
+    mSeedSetFree = index;
+}
+
 otError Mpl::UpdateSeedSet(uint16_t aSeedId, uint8_t aSequence)
 {
     otError error = OT_ERROR_NONE;
-    MplSeedEntry *entry = NULL;
+    MplSeedEntry *entry = FindSeedEntry(aSeedId);
     int8_t diff;
 
-    for (uint32_t i = 0; i < kNumSeedEntries; i++)
+    if (entry == NULL)
+    {
+        VerifyOrExit((entry = AllocateSeedEntry(aSeedId)) != NULL, error = OT_ERROR_DROP);
+        entry->SetSequence(aSequence);
+        entry->SetWindow(1);
+    }
+    else
     {
-        if (mSeedSet[i].GetLifetime() == 0)
+        diff = static_cast<int8_t>(aSequence - entry->GetSequence());
+
+        if (diff > 0)
         {
-            // Start allocating from the first possible entry to speed up process of searching.
-            if (entry == NULL)
-            {
-                entry = &mSeedSet[i];
-            }
+            // Slide the window forward, the new sequence becomes the highest one.
+            entry->SetWindow((diff < kSeedWindowSize) ? ((entry->GetWindow() << diff) | 1) : 1);
+            entry->SetSequence(aSequence);
         }
-        else if (mSeedSet[i].GetSeedId() == aSeedId)
+        else
         {
-            entry = &mSeedSet[i];
-            diff = static_cast<int8_t>(aSequence - entry->GetSequence());
+            // Accept a reordered message once, as long as it is still within the window.
+            uint32_t bit = 0;
 
-            VerifyOrExit(diff > 0, error = OT_ERROR_DROP);
+            VerifyOrExit(-diff < kSeedWindowSize, error = OT_ERROR_DROP);
 
-            break;
+            bit = static_cast<uint32_t>(1) << -diff;
+            VerifyOrExit((entry->GetWindow() & bit) == 0, error = OT_ERROR_DROP);
+            entry->SetWindow(entry->GetWindow() | bit);
         }
     }
 
-    VerifyOrExit(entry != NULL, error = OT_ERROR_DROP);
-
-    entry->SetSeedId(aSeedId);
-    entry->SetSequence(aSequence);
     entry->SetLifetime(kSeedEntryLifetime);
     mSeedSetTimer.Start(kSeedEntryLifetimeDt);
 
@@ -128,37 +210,60 @@ exit:
     return error;
 }
 
+void Mpl::InsertBufferedMessage(const MplBufferedMessageMetadata &aMetadata)
+{
+    uint8_t index = mNumBufferedMessages;
+
+    assert(mNumBufferedMessages < kNumBufferedMessages);
+
+    // Keep the Buffered Message Set ordered by transmission time, earliest first.
+    while (index > 0 && aMetadata.IsEarlier(mBufferedMessages[index - 1].GetTransmissionTime()))
+    {
+        mBufferedMessages[index] = mBufferedMessages[index - 1];
+        index--;
+    }
+
+    mBufferedMessages[index] = aMetadata;
+    mNumBufferedMessages++;
+}
+
+void Mpl::RemoveBufferedMessage(uint8_t aIndex)
+{
+    mNumBufferedMessages--;
+
+    for (uint8_t i = aIndex; i < mNumBufferedMessages; i++)
+    {
+        mBufferedMessages[i] = mBufferedMessages[i + 1];
+    }
+}
+
 void Mpl::UpdateBufferedSet(uint16_t aSeedId, uint8_t aSequence)
 {
+    uint8_t index = 0;
     int8_t diff;
-    MplBufferedMessageMetadata messageMetadata;
-
-    Message *message = mBufferedMessageSet.GetHead();
-    Message *nextMessage = NULL;
 
     // Check if multicast forwarding is enabled.
     VerifyOrExit(GetTimerExpirations() > 0);
 
-    while (message != NULL)
+    while (index < mNumBufferedMessages)
     {
-        nextMessage = message->GetNext();
-        messageMetadata.ReadFrom(*message);
+        MplBufferedMessageMetadata &metadata = mBufferedMessages[index];
 
-        if (messageMetadata.GetSeedId() == aSeedId)
-        {
-            diff = static_cast<int8_t>(aSequence - messageMetadata.GetSequence());
+        diff = static_cast<int8_t>(aSequence - metadata.GetSequence());
 
-            if (diff > 0)
-            {
-                // Stop retransmitting MPL Data Message that is consider to be old.
-                mBufferedMessageSet.Dequeue(*message);
-                message->Free();
-            }
+        if (metadata.GetSeedId() == aSeedId && diff > 0)
+        {
+            // Stop retransmitting MPL Data Message that is consider to be old.
+            Message *message = metadata.GetMessage();
 
-            break;
+            RemoveBufferedMessage(index);
+            mBufferedMessageSet.Dequeue(*message);
+            message->Free();
+        }
+        else
+        {
+            index++;
         }
-
-        message = nextMessage;
     }
 
 exit:
@@ -171,10 +276,10 @@ void Mpl::AddBufferedMessage(Message &aMessage, uint16_t aSeedId, uint8_t aSeque
     otError error = OT_ERROR_NONE;
     Message *messageCopy = NULL;
     MplBufferedMessageMetadata messageMetadata;
-    uint32_t nextTransmissionTime;
     uint8_t hopLimit = 0;
 
     VerifyOrExit(GetTimerExpirations() > 0);
+    VerifyOrExit(mNumBufferedMessages < kNumBufferedMessages, error = OT_ERROR_NO_BUFS);
     VerifyOrExit((messageCopy = aMessage.Clone()) != NULL, error = OT_ERROR_NO_BUFS);
 
     if (!aIsOutbound)
@@ -184,29 +289,19 @@ void Mpl::AddBufferedMessage(Message &aMessage, uint16_t aSeedId, uint8_t aSeque
         messageCopy->Write(Header::GetHopLimitOffset(), Header::GetHopLimitSize(), &hopLimit);
     }
 
+    messageMetadata.SetMessage(messageCopy);
     messageMetadata.SetSeedId(aSeedId);
     messageMetadata.SetSequence(aSequence);
     messageMetadata.SetTransmissionCount(aIsOutbound ? 1 : 0);
     messageMetadata.GenerateNextTransmissionTime(now, kDataMessageInterval);
 
-    // Append the message with MplBufferedMessageMetadata and add it to the queue.
-    SuccessOrExit(error = messageMetadata.AppendTo(*messageCopy));
+    InsertBufferedMessage(messageMetadata);
     mBufferedMessageSet.Enqueue(*messageCopy);
 
-    if (mRetransmissionTimer.IsRunning())
-    {
-        // If timer is already running, check if it should be restarted with earlier fire time.
-        nextTransmissionTime = mRetransmissionTimer.Gett0() + mRetransmissionTimer.Getdt();
-
-        if (messageMetadata.IsEarlier(nextTransmissionTime))
-        {
-            mRetransmissionTimer.Start(messageMetadata.GetTransmissionTime() - now);
-        }
-    }
-    else
+    // Restart the timer if the new message is now the earliest one to be sent.
+    if (!mRetransmissionTimer.IsRunning() || mBufferedMessages[0].GetMessage() == messageCopy)
     {
-        // Otherwise just set the timer.
-        mRetransmissionTimer.Start(messageMetadata.GetTransmissionTime() - now);
+        mRetransmissionTimer.Start(mBufferedMessages[0].GetTransmissionTime() - now);
     }
 
 exit:
@@ -262,82 +357,59 @@ void Mpl::HandleRetransmissionTimer(void *aContext)
 void Mpl::HandleRetransmissionTimer()
 {
     uint32_t now = Timer::GetNow();
-    uint32_t nextDelta = 0xffffffff;
-    MplBufferedMessageMetadata messageMetadata;
-
-    Message *message = mBufferedMessageSet.GetHead();
-    Message *nextMessage = NULL;
 
-    while (message != NULL)
+    // The Buffered Message Set is ordered by transmission time, so only the due messages at its head are visited.
+    while (mNumBufferedMessages > 0 && !mBufferedMessages[0].IsLater(now))
     {
-        nextMessage = message->GetNext();
-        messageMetadata.ReadFrom(*message);
+        MplBufferedMessageMetadata messageMetadata = mBufferedMessages[0];
+        Message *message = messageMetadata.GetMessage();
+
+        RemoveBufferedMessage(0);
+
+        // Update the number of transmission timer expirations.
+        messageMetadata.SetTransmissionCount(messageMetadata.GetTransmissionCount() + 1);
 
-        if (messageMetadata.IsLater(now))
+        if (messageMetadata.GetTransmissionCount() < GetTimerExpirations())
         {
-            // Calculate the next retransmission time and choose the lowest.
-            if (messageMetadata.GetTransmissionTime() - now < nextDelta)
+            Message *messageCopy = message->Clone();
+
+            if (messageCopy != NULL)
             {
-                nextDelta = messageMetadata.GetTransmissionTime() - now;
+                if (messageMetadata.GetTransmissionCount() > 1)
+                {
+                    messageCopy->SetSubType(Message::kSubTypeMplRetransmission);
+                }
+
+                mIp6.EnqueueDatagram(*messageCopy);
             }
+
+            messageMetadata.GenerateNextTransmissionTime(now, kDataMessageInterval);
+            InsertBufferedMessage(messageMetadata);
         }
         else
         {
-            // Update the number of transmission timer expirations.
-            messageMetadata.SetTransmissionCount(messageMetadata.GetTransmissionCount() + 1);
+            mBufferedMessageSet.Dequeue(*message);
 
-            if (messageMetadata.GetTransmissionCount() < GetTimerExpirations())
+            if (messageMetadata.GetTransmissionCount() == GetTimerExpirations())
             {
-                Message *messageCopy = message->Clone(message->GetLength() - sizeof(MplBufferedMessageMetadata));
-
-                if (messageCopy != NULL)
+                if (messageMetadata.GetTransmissionCount() > 1)
                 {
-                    if (messageMetadata.GetTransmissionCount() > 1)
-                    {
-                        messageCopy->SetSubType(Message::kSubTypeMplRetransmission);
-                    }
-
-                    mIp6.EnqueueDatagram(*messageCopy);
+                    message->SetSubType(Message::kSubTypeMplRetransmission);
                 }
 
-                messageMetadata.GenerateNextTransmissionTime(now, kDataMessageInterval);
-                messageMetadata.UpdateIn(*message);
-
-                // Check if retransmission time is lower than the current lowest one.
-                if (messageMetadata.GetTransmissionTime() - now < nextDelta)
-                {
-                    nextDelta = messageMetadata.GetTransmissionTime() - now;
-                }
+                mIp6.EnqueueDatagram(*message);
             }
             else
             {
-                mBufferedMessageSet.Dequeue(*message);
-
-                if (messageMetadata.GetTransmissionCount() == GetTimerExpirations())
-                {
-                    if (messageMetadata.GetTransmissionCount() > 1)
-                    {
-                        message->SetSubType(Message::kSubTypeMplRetransmission);
-                    }
-
-                    // Remove the extra metadata from the MPL Data Message.
-                    messageMetadata.RemoveFrom(*message);
-                    mIp6.EnqueueDatagram(*message);
-                }
-                else
-                {
-                    // Stop retransmitting if the number of timer expirations is already exceeded.
-                    message->Free();
-                }
+                // Stop retransmitting if the number of timer expirations is already exceeded.
+                message->Free();
             }
         }
-
-        message = nextMessage;
     }
 
-    if (nextDelta != 0xffffffff)
+    if (mNumBufferedMessages > 0)
     {
-        mRetransmissionTimer.Start(nextDelta);
+        mRetransmissionTimer.Start(mBufferedMessages[0].GetTransmissionTime() - now);
     }
 }
 
@@ -355,7 +427,15 @@ void Mpl::HandleSeedSetTimer()
         if (mSeedSet[i].GetLifetime() > 0)
         {
             mSeedSet[i].SetLifetime(mSeedSet[i].GetLifetime() - 1);
-            startTimer = true;
+
+            if (mSeedSet[i].GetLifetime() == 0)
+            {
+                FreeSeedEntry(mSeedSet[i]);
+            }
+            else
+            {
+                startTimer = true;
+            }
         }
     }
 
@@ -40,6 +40,10 @@
 #include "common/timer.hpp"
 #include "net/ip6_headers.hpp"
 
+#if OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRIES >= 0xff || OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_ENTRIES >= 0xff
+#error "OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRIES and OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_ENTRIES must be below 255"
+#endif
+
 namespace ot {
 namespace Ip6 {
 
@@ -232,17 +236,52 @@ public:
      */
     void SetLifetime(uint8_t aLifetime) { mLifetime = aLifetime; }
 
+    /**
+     * This method returns the bitmap of recently received MPL Sequence values.
+     *
+     * Bit N is set if the MPL Sequence value `GetSequence() - N` has been received.
+     *
+     * @returns The bitmap of recently received MPL Sequence values.
+     *
+     */
+    uint32_t GetWindow(void) const { return mWindow; }
+
+    /**
+     * This method sets the bitmap of recently received MPL Sequence values.
+     *
+     * @param[in]  aWindow  The bitmap of recently received MPL Sequence values.
+     *
+     */
+    void SetWindow(uint32_t aWindow) { mWindow = aWindow; }
+
+    /**
+     * This method returns the index of the next entry in the same hash bucket, or of the next free entry.
+     *
+     * @returns The index of the next entry.
+     *
+     */
+    uint8_t GetNext(void) const { return mNext; }
+
+    /**
+     * This method sets the index of the next entry in the same hash bucket, or of the next free entry.
+     *
+     * @param[in]  aNext  The index of the next entry.
+     *
+     */
+    void SetNext(uint8_t aNext) { mNext = aNext; }
+
 private:
+    uint32_t mWindow;
     uint16_t mSeedId;
     uint8_t  mSequence;
     uint8_t  mLifetime;
+    uint8_t  mNext;
 };
 
 /**
  * This class represents metadata required for MPL retransmissions.
  *
  */
-OT_TOOL_PACKED_BEGIN
 class MplBufferedMessageMetadata
 {
 public:
@@ -251,61 +290,29 @@ public:
      *
      */
     MplBufferedMessageMetadata(void):
+        mMessage(NULL),
+        mTransmissionTime(0),
         mSeedId(0),
         mSequence(0),
         mTransmissionCount(0),
-        mTransmissionTime(0),
         mIntervalOffset(0) {
     };
 
     /**
-     * This method appends MPL Buffered Message metadata to the message.
+     * This method returns the buffered MPL Data Message.
      *
-     * @param[in]  aMessage  A reference to the message.
-     *
-     * @retval OT_ERROR_NONE     Successfully appended the bytes.
-     * @retval OT_ERROR_NO_BUFS  Insufficient available buffers to grow the message.
+     * @returns A pointer to the buffered MPL Data Message.
      *
      */
-    otError AppendTo(Message &aMessage) const {
-        return aMessage.Append(this, sizeof(*this));
-    };
+    Message *GetMessage(void) const { return mMessage; }
 
     /**
-     * This method reads request data from the message.
+     * This method sets the buffered MPL Data Message.
      *
-     * @param[in]  aMessage  A reference to the message.
-     *
-     * @returns The number of bytes that have been read.
+     * @param[in]  aMessage  A pointer to the buffered MPL Data Message.
      *
      */
-    uint16_t ReadFrom(const Message &aMessage) {
-        return aMessage.Read(aMessage.GetLength() - sizeof(*this), sizeof(*this), this);
-    };
-
-    /**
-     * This method removes MPL Buffered Messsage metadata from the message.
-     *
-     * @param[in]  aMessage  A reference to the message.
-     *
-     * @retval OT_ERROR_NONE  Successfully removed the header.
-     *
-     */
-    otError RemoveFrom(Message &aMessage) {
-        return aMessage.SetLength(aMessage.GetLength() - sizeof(*this));
-    };
-
-    /**
-     * This method updates MPL Buffered Messsage metadata in the message.
-     *
-     * @param[in]  aMessage  A reference to the message.
-     *
-     * @returns The number of bytes that have been updated.
-     *
-     */
-    int UpdateIn(Message &aMessage) const {
-        return aMessage.Write(aMessage.GetLength() - sizeof(*this), sizeof(*this), this);
-    }
+    void SetMessage(Message *aMessage) { mMessage = aMessage; }
 
     /**
      * This method checks if the message shall be sent before the given time.
@@ -416,16 +423,21 @@ public:
     void GenerateNextTransmissionTime(uint32_t aCurrentTime, uint8_t aInterval);
 
 private:
+    Message *mMessage;
+    uint32_t mTransmissionTime;
     uint16_t mSeedId;
     uint8_t  mSequence;
     uint8_t  mTransmissionCount;
-    uint32_t mTransmissionTime;
     uint8_t  mIntervalOffset;
-} OT_TOOL_PACKED_END;
+};
 
 /**
  * This class implements MPL message processing.
  *
+ * The Seed Set keeps a sliding window of recently received sequence values per seed, so reordered MPL Data Messages
+ * are accepted once and duplicates are dropped.  Seeds are located through a chained hash index.  The metadata of the
+ * Buffered Message Set is kept in RAM, ordered by next transmission time.
+ *
  */
 class Mpl
 {
@@ -519,10 +531,21 @@ private:
         kNumSeedEntries = OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRIES,
         kSeedEntryLifetime = OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRY_LIFETIME,
         kSeedEntryLifetimeDt = 1000,
-        kDataMessageInterval = 64
+        kDataMessageInterval = 64,
+        kNumSeedBuckets = OPENTHREAD_CONFIG_MPL_SEED_SET_BUCKETS,
+        kSeedWindowSize = 32,          ///< Number of sequence values tracked per seed (bits of the window).
+        kNumBufferedMessages = OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_ENTRIES,
+        kInvalidIndex = 0xff,          ///< Marks the end of a list or an empty hash bucket.
     };
 
+    uint8_t GetSeedBucket(uint16_t aSeedId) const;
+    MplSeedEntry *FindSeedEntry(uint16_t aSeedId);
+    MplSeedEntry *AllocateSeedEntry(uint16_t aSeedId);
+    void FreeSeedEntry(MplSeedEntry &aEntry);
     otError UpdateSeedSet(uint16_t aSeedId, uint8_t aSequence);
+
+    void InsertBufferedMessage(const MplBufferedMessageMetadata &aMetadata);
+    void RemoveBufferedMessage(uint8_t aIndex);
     void UpdateBufferedSet(uint16_t aSeedId, uint8_t aSequence);
     void AddBufferedMessage(Message &aMessage, uint16_t aSeedId, uint8_t aSequence, bool aIsOutbound);
 
@@ -543,6 +566,11 @@ private:
     const Address *mMatchingAddress;
 
     MplSeedEntry mSeedSet[kNumSeedEntries];
+    uint8_t mSeedSetBuckets[kNumSeedBuckets];
+    uint8_t mSeedSetFree;
+
+    MplBufferedMessageMetadata mBufferedMessages[kNumBufferedMessages];
+    uint8_t mNumBufferedMessages;
     MessageQueue mBufferedMessageSet;
 };
 
@@ -69,6 +69,9 @@ Netif::Netif(Ip6 &aIp6, int8_t aInterfaceId):
         // To mark the address as unused/available, set the `mNext` to point back to itself.
         mExtMulticastAddresses[i].mNext = &mExtMulticastAddresses[i];
     }
+
+    memset(mMulticastBuckets, 0, sizeof(mMulticastBuckets));
+    memset(&mMulticastCounters, 0, sizeof(mMulticastCounters));
 }
 
 otError Netif::RegisterCallback(NetifCallback &aCallback)
@@ -119,7 +122,62 @@ otError Netif::RemoveCallback(NetifCallback &aCallback)
     return error;
 }
 
+uint8_t Netif::GetMulticastBucket(const Address &aAddress)
+{
+    uint32_t hash = 0;
+
+    for (uint8_t i = 0; i < sizeof(aAddress.mFields.m16) / sizeof(aAddress.mFields.m16[0]); i++)
+    {
+        hash = ((hash << 5) | (hash >> 27)) ^ aAddress.mFields.m16[i];
+    }
+
+    // Multiplicative mixing so that groups differing only in the low-order bits spread over the buckets.
+    hash *= 2654435761u;
+
+    return static_cast<uint8_t>((hash >> 16) % kMulticastBuckets);
+}
+
+void Netif::AddMulticastHash(NetifMulticastAddress &aAddress)
+{
+    uint8_t bucket = GetMulticastBucket(aAddress.GetAddress());
+
+    aAddress.mHashNext = mMulticastBuckets[bucket];
+    mMulticastBuckets[bucket] = &aAddress;
+    mMulticastCounters.mSubscriptions++;
+}
+
+void Netif::RemoveMulticastHash(const NetifMulticastAddress &aAddress)
+{
+    NetifMulticastAddress **link = &mMulticastBuckets[GetMulticastBucket(aAddress.GetAddress())];
+
+    for (; *link != NULL; link = &(*link)->mHashNext)
+    {
+        if (*link == &aAddress)
+        {
+            *link = aAddress.mHashNext;
+            mMulticastCounters.mSubscriptions--;
+            break;
+        }
+    }
+}
+
 bool Netif::IsMulticastSubscribed(const Address &aAddress) const
+{
+    uint32_t comparisons = 0;
+    bool rval = FindMulticastAddress(aAddress, comparisons);
+
+    mMulticastCounters.mLookups++;
+    mMulticastCounters.mComparisons += comparisons;
+
+    if (rval)
+    {
+        mMulticastCounters.mMatches++;
+    }
+
+    return rval;
+}
+
+bool Netif::FindMulticastAddress(const Address &aAddress, uint32_t &aComparisons) const
 {
     bool rval = false;
 
@@ -133,9 +191,13 @@ bool Netif::IsMulticastSubscribed(const Address &aAddress) const
         ExitNow(rval = mAllRoutersSubscribed);
     }
 
-    for (NetifMulticastAddress *cur = mMulticastAddresses; cur; cur = cur->GetNext())
+    // Only the addresses hashed into the same bucket need to be compared.
+    for (const NetifMulticastAddress *cur = mMulticastBuckets[GetMulticastBucket(aAddress)]; cur;
+         cur = cur->mHashNext)
     {
-        if (memcmp(&cur->mAddress, &aAddress, sizeof(cur->mAddress)) == 0)
+        aComparisons++;
+
+        if (cur->GetAddress() == aAddress)
         {
             ExitNow(rval = true);
         }
@@ -159,6 +221,7 @@ otError Netif::SubscribeMulticast(NetifMulticastAddress &aAddress)
 
     aAddress.mNext = mMulticastAddresses;
     mMulticastAddresses = &aAddress;
+    AddMulticastHash(aAddress);
 
 exit:
     return error;
@@ -188,6 +251,12 @@ otError Netif::UnsubscribeMulticast(const NetifMulticastAddress &aAddress)
     ExitNow(error = OT_ERROR_NOT_FOUND);
 
 exit:
+
+    if (error == OT_ERROR_NONE)
+    {
+        RemoveMulticastHash(aAddress);
+    }
+
     return error;
 }
 
@@ -196,8 +265,10 @@ otError Netif::SubscribeExternalMulticast(const Address &aAddress)
     otError error = OT_ERROR_NONE;
     NetifMulticastAddress *entry;
     size_t num = sizeof(mExtMulticastAddresses) / sizeof(mExtMulticastAddresses[0]);
+    uint32_t comparisons = 0;
 
-    if (IsMulticastSubscribed(aAddress))
+    // The duplicate check is not a datagram lookup, so it is kept out of the counters.
+    if (FindMulticastAddress(aAddress, comparisons))
     {
         ExitNow(error = OT_ERROR_ALREADY);
     }
@@ -218,6 +289,7 @@ otError Netif::SubscribeExternalMulticast(const Address &aAddress)
     entry->mAddress = aAddress;
     entry->mNext = mMulticastAddresses;
     mMulticastAddresses = entry;
+    AddMulticastHash(*entry);
 
 exit:
     return error;
@@ -254,6 +326,8 @@ otError Netif::UnsubscribeExternalMulticast(const Address &aAddress)
 
     VerifyOrExit(entry != NULL, error = OT_ERROR_NOT_FOUND);
 
+    RemoveMulticastHash(*entry);
+
     // To mark the address entry as unused/available, set the `mNext` pointer back to the entry itself.
     entry->mNext = entry;
 
@@ -345,6 +419,7 @@ otError Netif::AddExternalUnicastAddress(const NetifUnicastAddress &aAddress)
             entry->mPrefixLength = aAddress.mPrefixLength;
             entry->mPreferred = aAddress.mPreferred;
             entry->mValid = aAddress.mValid;
+            mIp6.InvalidateSourceAddressCache();
             ExitNow();
         }
     }
@@ -444,6 +519,13 @@ exit:
 
 void Netif::SetStateChangedFlags(uint32_t aFlags)
 {
+    // Cached source addresses may refer to an address that is no longer assigned, or miss a better one.
+    if (aFlags & (OT_IP6_ADDRESS_ADDED | OT_IP6_ADDRESS_REMOVED | OT_IP6_RLOC_ADDED | OT_IP6_RLOC_REMOVED |
+                  OT_IP6_LL_ADDR_CHANGED | OT_IP6_ML_ADDR_CHANGED))
+    {
+        mIp6.InvalidateSourceAddressCache();
+    }
+
     mStateChangedFlags |= aFlags;
     mStateChangedTask.Post();
 }
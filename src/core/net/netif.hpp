@@ -40,6 +40,10 @@
 #include "net/ip6_address.hpp"
 #include "net/socket.hpp"
 
+#if OPENTHREAD_CONFIG_MULTICAST_ADDRESS_BUCKETS < 1 || OPENTHREAD_CONFIG_MULTICAST_ADDRESS_BUCKETS > 0xff
+#error "OPENTHREAD_CONFIG_MULTICAST_ADDRESS_BUCKETS must be between 1 and 255"
+#endif
+
 namespace ot {
 namespace Ip6 {
 
@@ -167,6 +171,9 @@ public:
      *
      */
     NetifMulticastAddress *GetNext(void) { return static_cast<NetifMulticastAddress *>(mNext); }
+
+private:
+    NetifMulticastAddress *mHashNext;
 };
 
 /**
@@ -455,6 +462,14 @@ public:
      */
     void SetMulticastPromiscuous(bool aEnabled) { mMulticastPromiscuous = aEnabled; }
 
+    /**
+     * This method returns the multicast subscription counters.
+     *
+     * @returns A reference to the multicast subscription counters.
+     *
+     */
+    const otNetifMulticastCounters &GetMulticastCounters(void) const { return mMulticastCounters; }
+
     /**
      * This method registers a network interface callback.
      *
@@ -531,12 +546,24 @@ protected:
     Ip6 &mIp6;
 
 private:
+    enum
+    {
+        kMulticastBuckets = OPENTHREAD_CONFIG_MULTICAST_ADDRESS_BUCKETS,
+    };
+
     static void HandleStateChangedTask(void *aContext);
     void HandleStateChangedTask(void);
 
+    static uint8_t GetMulticastBucket(const Address &aAddress);
+    void AddMulticastHash(NetifMulticastAddress &aAddress);
+    void RemoveMulticastHash(const NetifMulticastAddress &aAddress);
+    bool FindMulticastAddress(const Address &aAddress, uint32_t &aComparisons) const;
+
     NetifCallback *mCallbacks;
     NetifUnicastAddress *mUnicastAddresses;
     NetifMulticastAddress *mMulticastAddresses;
+    NetifMulticastAddress *mMulticastBuckets[kMulticastBuckets];
+    mutable otNetifMulticastCounters mMulticastCounters;
     int8_t mInterfaceId;
     bool mAllRoutersSubscribed;
     bool mMulticastPromiscuous;
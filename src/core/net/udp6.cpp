@@ -62,21 +62,32 @@ Message *UdpSocket::NewMessage(uint16_t aReserved)
 
 otError UdpSocket::Open(otUdpReceive aHandler, void *aContext)
 {
+    // Unlink an already open socket using its current name, before that name is cleared.
+    GetUdp().UnlinkSocket(*this);
+
     memset(&mSockName, 0, sizeof(mSockName));
     memset(&mPeerName, 0, sizeof(mPeerName));
     mHandler = aHandler;
     mContext = aContext;
+    mReceiveSequence = 0;
 
     return static_cast<Udp *>(mTransport)->AddSocket(*this);
 }
 
 otError UdpSocket::Bind(const SockAddr &aSockAddr)
 {
+    bool isOpen = (mTransport != NULL) && GetUdp().UnlinkSocket(*this);
+
     mSockName = aSockAddr;
 
     if (GetSockName().mPort == 0)
     {
-        mSockName.mPort = static_cast<Udp *>(mTransport)->GetEphemeralPort();
+        mSockName.mPort = GetUdp().GetEphemeralPort();
+    }
+
+    if (isOpen)
+    {
+        GetUdp().LinkSocket(*this);
     }
 
     return OT_ERROR_NONE;
@@ -84,7 +95,15 @@ otError UdpSocket::Bind(const SockAddr &aSockAddr)
 
 otError UdpSocket::Connect(const SockAddr &aSockAddr)
 {
+    bool isOpen = (mTransport != NULL) && GetUdp().UnlinkSocket(*this);
+
     mPeerName = aSockAddr;
+
+    if (isOpen)
+    {
+        GetUdp().LinkSocket(*this);
+    }
+
     return OT_ERROR_NONE;
 }
 
@@ -115,7 +134,14 @@ otError UdpSocket::SendTo(Message &aMessage, const MessageInfo &aMessageInfo)
 
     if (GetSockName().mPort == 0)
     {
-        GetSockName().mPort = static_cast<Udp *>(mTransport)->GetEphemeralPort();
+        bool isOpen = GetUdp().UnlinkSocket(*this);
+
+        GetSockName().mPort = GetUdp().GetEphemeralPort();
+
+        if (isOpen)
+        {
+            GetUdp().LinkSocket(*this);
+        }
     }
 
     udpHeader.SetSourcePort(GetSockName().mPort);
@@ -131,66 +157,145 @@ exit:
     return error;
 }
 
+bool UdpSocket::Matches(const MessageInfo &aMessageInfo)
+{
+    bool rval = false;
+
+    VerifyOrExit(GetSockName().mPort == aMessageInfo.mSockPort);
+
+    VerifyOrExit(GetSockName().mScopeId == 0 || GetSockName().mScopeId == aMessageInfo.mInterfaceId);
+
+    VerifyOrExit(aMessageInfo.GetSockAddr().IsMulticast() ||
+                 GetSockName().GetAddress().IsUnspecified() ||
+                 GetSockName().GetAddress() == aMessageInfo.GetSockAddr());
+
+    // verify source if connected socket
+    if (IsConnected())
+    {
+        VerifyOrExit(GetPeerName().mPort == aMessageInfo.mPeerPort);
+
+        VerifyOrExit(GetPeerName().GetAddress().IsUnspecified() ||
+                     GetPeerName().GetAddress() == aMessageInfo.GetPeerAddr());
+    }
+
+    rval = true;
+
+exit:
+    return rval;
+}
+
 Udp::Udp(Ip6 &aIp6):
     mEphemeralPort(kDynamicPortMin),
-    mSockets(NULL),
+    mReceiveSequence(0),
+    mSocketListChanges(0),
+    mConnectedSockets(NULL),
     mIp6(aIp6)
 {
+    memset(mSocketBuckets, 0, sizeof(mSocketBuckets));
+    memset(&mCounters, 0, sizeof(mCounters));
 }
 
 otError Udp::AddSocket(UdpSocket &aSocket)
 {
-    for (UdpSocket *cur = mSockets; cur; cur = cur->GetNext())
-    {
-        if (cur == &aSocket)
-        {
-            ExitNow();
-        }
-    }
+    LinkSocket(aSocket);
 
-    aSocket.SetNext(mSockets);
-    mSockets = &aSocket;
-
-exit:
     return OT_ERROR_NONE;
 }
 
 otError Udp::RemoveSocket(UdpSocket &aSocket)
 {
-    if (mSockets == &aSocket)
+    UnlinkSocket(aSocket);
+
+    return OT_ERROR_NONE;
+}
+
+UdpSocket *&Udp::GetSocketList(UdpSocket &aSocket)
+{
+    return aSocket.IsConnected() ? mConnectedSockets : mSocketBuckets[aSocket.GetSockName().mPort % kNumSocketBuckets];
+}
+
+void Udp::LinkSocket(UdpSocket &aSocket)
+{
+    UdpSocket *&head = GetSocketList(aSocket);
+
+    aSocket.SetNext(head);
+    head = &aSocket;
+    mSocketListChanges++;
+}
+
+bool Udp::UnlinkSocket(UdpSocket &aSocket)
+{
+    UdpSocket *&head = GetSocketList(aSocket);
+    bool rval = false;
+
+    if (head == &aSocket)
     {
-        mSockets = mSockets->GetNext();
+        head = aSocket.GetNext();
+        rval = true;
     }
     else
     {
-        for (UdpSocket *socket = mSockets; socket; socket = socket->GetNext())
+        for (UdpSocket *socket = head; socket; socket = socket->GetNext())
         {
             if (socket->GetNext() == &aSocket)
             {
                 socket->SetNext(aSocket.GetNext());
+                rval = true;
                 break;
             }
         }
     }
 
     aSocket.SetNext(NULL);
+    mSocketListChanges++;
 
-    return OT_ERROR_NONE;
+    return rval;
 }
 
-uint16_t Udp::GetEphemeralPort(void)
+bool Udp::IsPortInUse(uint16_t aPort)
 {
-    uint16_t rval = mEphemeralPort;
+    bool rval = false;
 
-    if (mEphemeralPort < kDynamicPortMax)
+    for (UdpSocket *socket = mSocketBuckets[aPort % kNumSocketBuckets]; socket; socket = socket->GetNext())
     {
-        mEphemeralPort++;
+        if (socket->GetSockName().mPort == aPort)
+        {
+            ExitNow(rval = true);
+        }
     }
-    else
+
+    for (UdpSocket *socket = mConnectedSockets; socket; socket = socket->GetNext())
     {
-        mEphemeralPort = kDynamicPortMin;
+        if (socket->GetSockName().mPort == aPort)
+        {
+            ExitNow(rval = true);
+        }
     }
 
+exit:
+    return rval;
+}
+
+uint16_t Udp::GetEphemeralPort(void)
+{
+    uint16_t rval;
+
+    // Skip ports that are already bound, there are far fewer sockets than dynamic ports.
+    do
+    {
+        rval = mEphemeralPort;
+
+        if (mEphemeralPort < kDynamicPortMax)
+        {
+            mEphemeralPort++;
+        }
+        else
+        {
+            mEphemeralPort = kDynamicPortMin;
+        }
+    }
+    while (IsPortInUse(rval));
+
     return rval;
 }
 
@@ -210,6 +315,7 @@ otError Udp::HandleMessage(Message &aMessage, MessageInfo &aMessageInfo)
     UdpHeader udpHeader;
     uint16_t payloadLength;
     uint16_t checksum;
+    bool matched = false;
 
     payloadLength = aMessage.GetLength() - aMessage.GetOffset();
 
@@ -228,47 +334,53 @@ otError Udp::HandleMessage(Message &aMessage, MessageInfo &aMessageInfo)
     aMessageInfo.mPeerPort = udpHeader.GetSourcePort();
     aMessageInfo.mSockPort = udpHeader.GetDestinationPort();
 
+    mCounters.mLookups++;
+
+    // Sequence number 0 is never used, it marks sockets that have not received anything since they were opened.
+    if (++mReceiveSequence == 0)
+    {
+        mReceiveSequence++;
+    }
+
     // find socket
-    for (UdpSocket *socket = mSockets; socket; socket = socket->GetNext())
+    matched = HandleSocketList(mSocketBuckets[aMessageInfo.mSockPort % kNumSocketBuckets], aMessage, aMessageInfo);
+    matched = HandleSocketList(mConnectedSockets, aMessage, aMessageInfo) || matched;
+
+    if (!matched)
     {
-        if (socket->GetSockName().mPort != udpHeader.GetDestinationPort())
-        {
-            continue;
-        }
+        mCounters.mMisses++;
+    }
 
-        if (socket->GetSockName().mScopeId != 0 &&
-            socket->GetSockName().mScopeId != aMessageInfo.mInterfaceId)
-        {
-            continue;
-        }
+exit:
+    return error;
+}
 
-        if (!aMessageInfo.GetSockAddr().IsMulticast() &&
-            !socket->GetSockName().GetAddress().IsUnspecified() &&
-            socket->GetSockName().GetAddress() != aMessageInfo.GetSockAddr())
-        {
-            continue;
-        }
+bool Udp::HandleSocketList(UdpSocket *const &aList, Message &aMessage, MessageInfo &aMessageInfo)
+{
+    UdpSocket *socket = aList;
+    bool matched = false;
+    uint32_t listChanges;
 
-        // verify source if connected socket
-        if (socket->GetPeerName().mPort != 0)
+    while (socket != NULL)
+    {
+        if (socket->mReceiveSequence == mReceiveSequence || !socket->Matches(aMessageInfo))
         {
-            if (socket->GetPeerName().mPort != udpHeader.GetSourcePort())
-            {
-                continue;
-            }
-
-            if (!socket->GetPeerName().GetAddress().IsUnspecified() &&
-                socket->GetPeerName().GetAddress() != aMessageInfo.GetPeerAddr())
-            {
-                continue;
-            }
+            socket = socket->GetNext();
+            continue;
         }
 
+        socket->mReceiveSequence = mReceiveSequence;
+        matched = true;
+        listChanges = mSocketListChanges;
         socket->HandleUdpReceive(aMessage, aMessageInfo);
+
+        // The handler may connect, rebind, open or close sockets, which relinks them (e.g. CoapSecure connects its
+        // socket to the first DTLS peer). Only then restart from the head of the list, sockets that already
+        // received this datagram are skipped.
+        socket = (mSocketListChanges == listChanges) ? socket->GetNext() : aList;
     }
 
-exit:
-    return error;
+    return matched;
 }
 
 otError Udp::UpdateChecksum(Message &aMessage, uint16_t aChecksum)
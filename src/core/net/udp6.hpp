@@ -34,8 +34,15 @@
 #ifndef UDP6_HPP_
 #define UDP6_HPP_
 
+#ifdef OPENTHREAD_CONFIG_FILE
+#include OPENTHREAD_CONFIG_FILE
+#else
+#include <openthread-config.h>
+#endif
+
 #include <openthread/udp.h>
 
+#include "openthread-core-config.h"
 #include "net/ip6_headers.hpp"
 
 namespace ot {
@@ -151,6 +158,10 @@ private:
     UdpSocket *GetNext(void) { return static_cast<UdpSocket *>(mNext); }
     void SetNext(UdpSocket *socket) { mNext = static_cast<otUdpSocket *>(socket); }
 
+    Udp &GetUdp(void) { return *static_cast<Udp *>(mTransport); }
+    bool IsConnected(void) { return GetPeerName().mPort != 0; }
+    bool Matches(const MessageInfo &aMessageInfo);
+
     void HandleUdpReceive(Message &aMessage, const MessageInfo &aMessageInfo) {
         mHandler(mContext, &aMessage, &aMessageInfo);
     }
@@ -227,6 +238,10 @@ public:
     /**
      * This method handles a received UDP message.
      *
+     * The message is delivered to every matching socket. Unconnected sockets bound to the destination port are
+     * handled before connected sockets, and within each group the most recently opened, bound or connected socket
+     * comes first.
+     *
      * @param[in]  aMessage      A reference to the UDP message to process.
      * @param[in]  aMessageInfo  A reference to the message info associated with @p aMessage.
      *
@@ -248,14 +263,36 @@ public:
      */
     otError UpdateChecksum(Message &aMessage, uint16_t aPseudoHeaderChecksum);
 
+    /**
+     * This method returns the socket lookup counters.
+     *
+     * @returns A reference to the socket lookup counters.
+     *
+     */
+    const otUdpCounters &GetCounters(void) const { return mCounters; }
+
 private:
     enum
     {
         kDynamicPortMin = 49152,  ///< Service Name and Transport Protocol Port Number Registry
         kDynamicPortMax = 65535,  ///< Service Name and Transport Protocol Port Number Registry
+        kNumSocketBuckets = OPENTHREAD_CONFIG_UDP_SOCKET_HASH_BUCKETS,
     };
+
+    UdpSocket *&GetSocketList(UdpSocket &aSocket);
+    void LinkSocket(UdpSocket &aSocket);
+    bool UnlinkSocket(UdpSocket &aSocket);
+    bool IsPortInUse(uint16_t aPort);
+    bool HandleSocketList(UdpSocket *const &aList, Message &aMessage, MessageInfo &aMessageInfo);
+
     uint16_t mEphemeralPort;
-    UdpSocket *mSockets;
+    uint32_t mReceiveSequence;
+    uint32_t mSocketListChanges;
+
+    // Unconnected sockets are hashed by local port, connected sockets are kept in a separate list.
+    UdpSocket *mSocketBuckets[kNumSocketBuckets];
+    UdpSocket *mConnectedSockets;
+    otUdpCounters mCounters;
 
     Ip6 &mIp6;
 };
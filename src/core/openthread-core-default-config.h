@@ -169,6 +169,26 @@
 #define OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES                 10
 #endif  // OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES
 
+/**
+ * @def OPENTHREAD_CONFIG_ADDRESS_CACHE_BUCKETS
+ *
+ * The number of hash buckets used to look up EID-to-RLOC cache entries.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_ADDRESS_CACHE_BUCKETS
+#define OPENTHREAD_CONFIG_ADDRESS_CACHE_BUCKETS                 OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES
+#endif  // OPENTHREAD_CONFIG_ADDRESS_CACHE_BUCKETS
+
+/**
+ * @def OPENTHREAD_CONFIG_ADDRESS_QUERY_ENTRIES
+ *
+ * The number of EIDs with an outstanding Address Query, tracked separately from the EID-to-RLOC cache.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_ADDRESS_QUERY_ENTRIES
+#define OPENTHREAD_CONFIG_ADDRESS_QUERY_ENTRIES                 10
+#endif  // OPENTHREAD_CONFIG_ADDRESS_QUERY_ENTRIES
+
 /**
  * @def OPENTHREAD_CONFIG_MAX_CHILDREN
  *
@@ -179,6 +199,19 @@
 #define OPENTHREAD_CONFIG_MAX_CHILDREN                          10
 #endif  // OPENTHREAD_CONFIG_MAX_CHILDREN
 
+/**
+ * @def OPENTHREAD_CONFIG_NUM_INDIRECT_MESSAGE_REFS
+ *
+ * The number of message references shared by the per-child indirect transmission queues.
+ *
+ * A message queued for N sleepy children (e.g. a multicast) uses N references.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NUM_INDIRECT_MESSAGE_REFS
+#define OPENTHREAD_CONFIG_NUM_INDIRECT_MESSAGE_REFS             (OPENTHREAD_CONFIG_NUM_MESSAGE_BUFFERS + \
+                                                                 4 * OPENTHREAD_CONFIG_MAX_CHILDREN)
+#endif  // OPENTHREAD_CONFIG_NUM_INDIRECT_MESSAGE_REFS
+
 /**
  * @def OPENTHREAD_CONFIG_DEFAULT_CHILD_TIMEOUT
  *
@@ -219,6 +252,26 @@
 #define OPENTHREAD_CONFIG_MAX_EXT_MULTICAST_IP_ADDRS            2
 #endif  // OPENTHREAD_CONFIG_MAX_EXT_MULTICAST_IP_ADDRS
 
+/**
+ * @def OPENTHREAD_CONFIG_MULTICAST_ADDRESS_BUCKETS
+ *
+ * The number of hash buckets used to look up the multicast addresses subscribed to a network interface.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MULTICAST_ADDRESS_BUCKETS
+#define OPENTHREAD_CONFIG_MULTICAST_ADDRESS_BUCKETS             8
+#endif  // OPENTHREAD_CONFIG_MULTICAST_ADDRESS_BUCKETS
+
+/**
+ * @def OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES
+ *
+ * The number of destinations for which the selected IPv6 source address is cached.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES
+#define OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES          4
+#endif  // OPENTHREAD_CONFIG_SOURCE_ADDRESS_CACHE_ENTRIES
+
 /**
  * @def OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT
  *
@@ -229,6 +282,27 @@
 #define OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT            5
 #endif  // OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT
 
+/**
+ * @def OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_ENTRIES
+ *
+ * The maximum number of datagrams that are reassembled from 6LoWPAN fragments at the same time.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_ENTRIES
+#define OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_ENTRIES            8
+#endif  // OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_ENTRIES
+
+/**
+ * @def OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_HEADERLESS_ENTRIES
+ *
+ * The maximum number of reassembly entries (and datagram buffers) that may be held for datagrams whose first
+ * fragment has not been received yet.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_HEADERLESS_ENTRIES
+#define OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_HEADERLESS_ENTRIES 2
+#endif  // OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_HEADERLESS_ENTRIES
+
 /**
  * @def OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRIES
  *
@@ -249,6 +323,26 @@
 #define OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRY_LIFETIME           5
 #endif  // OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRY_LIFETIME
 
+/**
+ * @def OPENTHREAD_CONFIG_MPL_SEED_SET_BUCKETS
+ *
+ * The number of hash buckets used to look up MPL Seed Set entries.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MPL_SEED_SET_BUCKETS
+#define OPENTHREAD_CONFIG_MPL_SEED_SET_BUCKETS                  OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRIES
+#endif  // OPENTHREAD_CONFIG_MPL_SEED_SET_BUCKETS
+
+/**
+ * @def OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_ENTRIES
+ *
+ * The maximum number of MPL Data Messages buffered for retransmission at a time.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_ENTRIES
+#define OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_ENTRIES          OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRIES
+#endif  // OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_ENTRIES
+
 /**
  * @def OPENTHREAD_CONFIG_JOINER_UDP_PORT
  *
@@ -259,6 +353,16 @@
 #define OPENTHREAD_CONFIG_JOINER_UDP_PORT                       1000
 #endif  // OPENTHREAD_CONFIG_JOINER_UDP_PORT
 
+/**
+ * @def OPENTHREAD_CONFIG_UDP_SOCKET_HASH_BUCKETS
+ *
+ * The number of hash buckets used to look up unconnected UDP sockets by local port.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_UDP_SOCKET_HASH_BUCKETS
+#define OPENTHREAD_CONFIG_UDP_SOCKET_HASH_BUCKETS               8
+#endif  // OPENTHREAD_CONFIG_UDP_SOCKET_HASH_BUCKETS
+
 /**
  * @def OPENTHREAD_CONFIG_MAX_ENERGY_RESULTS
  *
@@ -289,6 +393,19 @@
 #define OPENTHREAD_CONFIG_MAX_STATECHANGE_HANDLERS              1
 #endif  // OPENTHREAD_CONFIG_MAX_STATECHANGE_HANDLERS
 
+/**
+ * @def OPENTHREAD_CONFIG_TIMER_WHEEL_SLOT_BITS
+ *
+ * The number of fire time bits covered by each level of the timer scheduler's timing wheel (between 1 and 5).
+ *
+ * The wheel uses `32 / bits` levels of `2^bits` slots each (one pointer per slot), so larger values trade RAM for
+ * fewer cascading steps.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_TIMER_WHEEL_SLOT_BITS
+#define OPENTHREAD_CONFIG_TIMER_WHEEL_SLOT_BITS                 4
+#endif  // OPENTHREAD_CONFIG_TIMER_WHEEL_SLOT_BITS
+
 /**
  * @def OPENTHREAD_CONFIG_COAP_ACK_TIMEOUT
  *
@@ -649,6 +766,16 @@
 #define OPENTHREAD_CONFIG_NCP_UART_RX_BUFFER_SIZE               1300
 #endif  // OPENTHREAD_CONFIG_NCP_UART_RX_BUFFER_SIZE
 
+/**
+ * @def OPENTHREAD_CONFIG_NCP_HDLC_FCS_SLICE_BY_8
+ *
+ *  Define to 1 to compute the NCP HDLC FCS eight bytes at a time, using 4 KB of lookup tables instead of 512 bytes.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NCP_HDLC_FCS_SLICE_BY_8
+#define OPENTHREAD_CONFIG_NCP_HDLC_FCS_SLICE_BY_8               1
+#endif  // OPENTHREAD_CONFIG_NCP_HDLC_FCS_SLICE_BY_8
+
 /**
  * @def OPENTHREAD_CONFIG_NCP_SPI_BUFFER_SIZE
  *
@@ -659,6 +786,18 @@
 #define OPENTHREAD_CONFIG_NCP_SPI_BUFFER_SIZE                   1300
 #endif  // OPENTHREAD_CONFIG_NCP_SPI_BUFFER_SIZE
 
+/**
+ * @def OPENTHREAD_CONFIG_NCP_UNSOL_UPDATE_COALESCING_WINDOW
+ *
+ *  The time (in milliseconds) the NCP waits after a state change before sending batched unsolicited property
+ *  updates, so that changes happening close together are reported in a single frame. Only used once the host
+ *  enables `SPINEL_PROP_UNSOL_UPDATE_BATCHING`. Zero sends the updates from the next tasklet run.
+ *
+ */
+#ifndef OPENTHREAD_CONFIG_NCP_UNSOL_UPDATE_COALESCING_WINDOW
+#define OPENTHREAD_CONFIG_NCP_UNSOL_UPDATE_COALESCING_WINDOW    10
+#endif  // OPENTHREAD_CONFIG_NCP_UNSOL_UPDATE_COALESCING_WINDOW
+
 /**
  * @def OPENTHREAD_CONFIG_PLATFORM_ASSERT_MANAGEMENT
  *
@@ -61,14 +61,184 @@ using ot::Encoding::BigEndian::HostSwap16;
 
 namespace ot {
 
+EidCache::EidCache(Entry *aEntries, uint16_t aNumEntries, uint16_t *aBuckets, uint16_t aNumBuckets) :
+    mEntries(aEntries),
+    mBuckets(aBuckets),
+    mNumEntries(aNumEntries),
+    mNumBuckets(aNumBuckets)
+{
+    assert(aNumEntries < kInvalidIndex && aNumBuckets > 0);
+    Clear();
+}
+
+void EidCache::Clear(void)
+{
+    for (uint16_t i = 0; i < mNumBuckets; i++)
+    {
+        mBuckets[i] = kInvalidIndex;
+    }
+
+    for (uint16_t i = 0; i < mNumEntries; i++)
+    {
+        mEntries[i].mInUse = false;
+        mEntries[i].mLruNext = (i + 1 < mNumEntries) ? i + 1 : static_cast<uint16_t>(kInvalidIndex);
+    }
+
+    mCount = 0;
+    mLruHead = kInvalidIndex;
+    mLruTail = kInvalidIndex;
+    mFreeHead = (mNumEntries > 0) ? 0 : static_cast<uint16_t>(kInvalidIndex);
+}
+
+uint16_t EidCache::GetBucket(const Ip6::Address &aEid) const
+{
+    uint32_t hash = 0;
+
+    for (uint8_t i = 0; i < sizeof(aEid.mFields.m16) / sizeof(aEid.mFields.m16[0]); i++)
+    {
+        hash = ((hash << 5) | (hash >> 27)) ^ aEid.mFields.m16[i];
+    }
+
+    // Multiplicative mixing so that EIDs differing only in a few bits spread over power-of-two bucket counts.
+    hash *= 2654435761u;
+
+    return static_cast<uint16_t>((hash >> 16) % mNumBuckets);
+}
+
+EidCache::Entry *EidCache::Find(const Ip6::Address &aEid)
+{
+    Entry *rval = NULL;
+
+    for (uint16_t index = mBuckets[GetBucket(aEid)]; index != kInvalidIndex; index = mEntries[index].mHashNext)
+    {
+        if (mEntries[index].mTarget == aEid)
+        {
+            ExitNow(rval = &mEntries[index]);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+EidCache::Entry &EidCache::Add(const Ip6::Address &aEid, bool &aEvicted)
+{
+    uint16_t bucket = GetBucket(aEid);
+    uint16_t index;
+    Entry *entry;
+
+    aEvicted = (mFreeHead == kInvalidIndex);
+
+    if (aEvicted)
+    {
+        Remove(mEntries[mLruTail]);
+    }
+
+    index = mFreeHead;
+    entry = &mEntries[index];
+    mFreeHead = entry->mLruNext;
+
+    entry->mTarget = aEid;
+    entry->mInUse = true;
+    entry->mHashNext = mBuckets[bucket];
+    mBuckets[bucket] = index;
+    LinkLru(index);
+    mCount++;
+
+    return *entry;
+}
+
+void EidCache::MarkAsUsed(Entry &aEntry)
+{
+    uint16_t index = GetIndex(aEntry);
+
+    if (index != mLruHead)
+    {
+        UnlinkLru(index);
+        LinkLru(index);
+    }
+}
+
+void EidCache::Remove(Entry &aEntry)
+{
+    uint16_t index = GetIndex(aEntry);
+    uint16_t *link = &mBuckets[GetBucket(aEntry.mTarget)];
+
+    while (*link != index)
+    {
+        assert(*link != kInvalidIndex);
+        link = &mEntries[*link].mHashNext;
+    }
+
+    *link = aEntry.mHashNext;
+    UnlinkLru(index);
+
+    aEntry.mInUse = false;
+    aEntry.mLruNext = mFreeHead;
+    mFreeHead = index;
+    mCount--;
+}
+
+EidCache::Entry *EidCache::GetEntry(uint16_t aIndex)
+{
+    return (aIndex < mNumEntries && mEntries[aIndex].mInUse) ? &mEntries[aIndex] : NULL;
+}
+
+EidCache::Entry *EidCache::GetLeastRecentlyUsed(void)
+{
+    return (mLruTail != kInvalidIndex) ? &mEntries[mLruTail] : NULL;
+}
+
+void EidCache::LinkLru(uint16_t aIndex)
+{
+    mEntries[aIndex].mLruPrev = kInvalidIndex;
+    mEntries[aIndex].mLruNext = mLruHead;
+
+    if (mLruHead != kInvalidIndex)
+    {
+        mEntries[mLruHead].mLruPrev = aIndex;
+    }
+    else
+    {
+        mLruTail = aIndex;
+    }
+
+    mLruHead = aIndex;
+}
+
+void EidCache::UnlinkLru(uint16_t aIndex)
+{
+    Entry &entry = mEntries[aIndex];
+
+    if (entry.mLruPrev != kInvalidIndex)
+    {
+        mEntries[entry.mLruPrev].mLruNext = entry.mLruNext;
+    }
+    else
+    {
+        mLruHead = entry.mLruNext;
+    }
+
+    if (entry.mLruNext != kInvalidIndex)
+    {
+        mEntries[entry.mLruNext].mLruPrev = entry.mLruPrev;
+    }
+    else
+    {
+        mLruTail = entry.mLruPrev;
+    }
+}
+
 AddressResolver::AddressResolver(ThreadNetif &aThreadNetif) :
     mAddressError(OT_URI_PATH_ADDRESS_ERROR, &AddressResolver::HandleAddressError, this),
     mAddressQuery(OT_URI_PATH_ADDRESS_QUERY, &AddressResolver::HandleAddressQuery, this),
     mAddressNotification(OT_URI_PATH_ADDRESS_NOTIFY, &AddressResolver::HandleAddressNotification, this),
+    mCache(mCacheEntries, kCacheEntries, mCacheBuckets, kCacheBuckets),
     mIcmpHandler(&AddressResolver::HandleIcmpReceive, this),
     mTimer(aThreadNetif.GetIp6().mTimerScheduler, &AddressResolver::HandleTimer, this),
     mNetif(aThreadNetif)
 {
+    memset(&mCounters, 0, sizeof(mCounters));
     Clear();
 
     mNetif.GetCoap().AddResource(mAddressError);
@@ -85,150 +255,168 @@ otInstance *AddressResolver::GetInstance(void)
 
 void AddressResolver::Clear()
 {
-    memset(&mCache, 0, sizeof(mCache));
-
-    for (uint8_t i = 0; i < kCacheEntries; i++)
-    {
-        mCache[i].mAge = i;
-    }
+    mCache.Clear();
+    memset(mQueries, 0, sizeof(mQueries));
 }
 
-otError AddressResolver::GetEntry(uint8_t aIndex, otEidCacheEntry &aEntry) const
+otError AddressResolver::GetEntry(uint8_t aIndex, otEidCacheEntry &aEntry)
 {
     otError error = OT_ERROR_NONE;
+    const EidCache::Entry *entry;
 
     VerifyOrExit(aIndex < kCacheEntries, error = OT_ERROR_INVALID_ARGS);
-    memcpy(&aEntry.mTarget, &mCache[aIndex].mTarget, sizeof(aEntry.mTarget));
-    aEntry.mRloc16 = mCache[aIndex].mRloc16;
-    aEntry.mValid = mCache[aIndex].mState == Cache::kStateCached;
+
+    memset(&aEntry, 0, sizeof(aEntry));
+
+    if ((entry = mCache.GetEntry(aIndex)) != NULL)
+    {
+        memcpy(&aEntry.mTarget, &entry->mTarget, sizeof(aEntry.mTarget));
+        aEntry.mRloc16 = entry->mRloc16;
+        aEntry.mValid = true;
+    }
 
 exit:
     return error;
 }
 
-void AddressResolver::Remove(uint8_t routerId)
+otError AddressResolver::GetNextEntry(otEidCacheIterator &aIterator, otEidCacheEntry &aEntry)
 {
-    for (int i = 0; i < kCacheEntries; i++)
+    otError error = OT_ERROR_NONE;
+
+    memset(&aEntry, 0, sizeof(aEntry));
+
+    for (; aIterator < kCacheEntries; aIterator++)
     {
-        if (Mle::Mle::GetRouterId(mCache[i].mRloc16) == routerId)
+        const EidCache::Entry *entry = mCache.GetEntry(aIterator);
+
+        if (entry != NULL)
         {
-            InvalidateCacheEntry(mCache[i]);
+            memcpy(&aEntry.mTarget, &entry->mTarget, sizeof(aEntry.mTarget));
+            aEntry.mRloc16 = entry->mRloc16;
+            aEntry.mValid = true;
+            aIterator++;
+            ExitNow();
         }
     }
-}
 
-AddressResolver::Cache *AddressResolver::NewCacheEntry(void)
-{
-    Cache *rval = NULL;
-
-    for (int i = 0; i < kCacheEntries; i++)
+    for (; aIterator < kCacheEntries + kQueryEntries; aIterator++)
     {
-        if (mCache[i].mState == Cache::kStateQuery && mCache[i].mFailures == 0)
-        {
-            continue;
-        }
+        const Query &query = mQueries[aIterator - kCacheEntries];
 
-        if (rval == NULL || rval->mAge < mCache[i].mAge)
+        if (query.mInUse)
         {
-            rval = &mCache[i];
+            memcpy(&aEntry.mTarget, &query.mTarget, sizeof(aEntry.mTarget));
+            aEntry.mRloc16 = Mac::kShortAddrInvalid;
+            aEntry.mValid = false;
+            aIterator++;
+            ExitNow();
         }
     }
 
-    if (rval != NULL)
+    error = OT_ERROR_NOT_FOUND;
+
+exit:
+    return error;
+}
+
+void AddressResolver::Remove(uint8_t routerId)
+{
+    for (uint16_t i = 0; i < kCacheEntries; i++)
     {
-        InvalidateCacheEntry(*rval);
-    }
+        EidCache::Entry *entry = mCache.GetEntry(i);
 
-    return rval;
+        if (entry != NULL && Mle::Mle::GetRouterId(entry->mRloc16) == routerId)
+        {
+            InvalidateCacheEntry(*entry);
+        }
+    }
 }
 
-void AddressResolver::MarkCacheEntryAsUsed(Cache &aEntry)
+AddressResolver::Query *AddressResolver::FindQuery(const Ip6::Address &aEid)
 {
-    for (int i = 0; i < kCacheEntries; i++)
+    Query *rval = NULL;
+
+    for (int i = 0; i < kQueryEntries; i++)
     {
-        if (mCache[i].mAge < aEntry.mAge)
+        if (mQueries[i].mInUse && mQueries[i].mTarget == aEid)
         {
-            mCache[i].mAge++;
+            ExitNow(rval = &mQueries[i]);
         }
     }
 
-    aEntry.mAge = 0;
+exit:
+    return rval;
 }
 
-void AddressResolver::InvalidateCacheEntry(Cache &aEntry)
+AddressResolver::Query *AddressResolver::NewQuery(void)
 {
-    for (int i = 0; i < kCacheEntries; i++)
+    Query *rval = NULL;
+
+    for (int i = 0; i < kQueryEntries; i++)
     {
-        if (mCache[i].mAge > aEntry.mAge)
+        if (!mQueries[i].mInUse)
+        {
+            ExitNow(rval = &mQueries[i]);
+        }
+
+        // Never drop a first query still in progress; otherwise reuse the EID that failed most often.
+        if (mQueries[i].mFailures > 0 && (rval == NULL || rval->mFailures < mQueries[i].mFailures))
         {
-            mCache[i].mAge--;
+            rval = &mQueries[i];
         }
     }
 
-    aEntry.mAge = kCacheEntries - 1;
-    aEntry.mState = Cache::kStateInvalid;
+exit:
+    return rval;
+}
+
+void AddressResolver::InvalidateCacheEntry(EidCache::Entry &aEntry)
+{
+    mCache.Remove(aEntry);
     otLogInfoArp(GetInstance(), "cache entry removed!");
 }
 
 otError AddressResolver::Resolve(const Ip6::Address &aEid, uint16_t &aRloc16)
 {
     otError error = OT_ERROR_NONE;
-    Cache *entry = NULL;
+    EidCache::Entry *entry;
+    Query *query;
 
-    for (int i = 0; i < kCacheEntries; i++)
+    if ((entry = mCache.Find(aEid)) != NULL)
     {
-        if (mCache[i].mState != Cache::kStateInvalid)
-        {
-            if (memcmp(&mCache[i].mTarget, &aEid, sizeof(mCache[i].mTarget)) == 0)
-            {
-                entry = &mCache[i];
-                break;
-            }
-        }
+        aRloc16 = entry->mRloc16;
+        mCache.MarkAsUsed(*entry);
+        mCounters.mHits++;
+        ExitNow();
     }
 
-    if (entry == NULL)
-    {
-        entry = NewCacheEntry();
-    }
+    mCounters.mMisses++;
 
-    VerifyOrExit(entry != NULL, error = OT_ERROR_NO_BUFS);
+    if ((query = FindQuery(aEid)) == NULL)
+    {
+        VerifyOrExit((query = NewQuery()) != NULL, error = OT_ERROR_NO_BUFS);
 
-    switch (entry->mState)
+        query->mTarget = aEid;
+        query->mTimeout = kAddressQueryTimeout;
+        query->mFailures = 0;
+        query->mRetryTimeout = kAddressQueryInitialRetryDelay;
+        query->mInUse = true;
+        SendAddressQuery(aEid);
+        error = OT_ERROR_ADDRESS_QUERY;
+    }
+    else if (query->mTimeout > 0)
     {
-    case Cache::kStateInvalid:
-        entry->mTarget = aEid;
-        entry->mRloc16 = Mac::kShortAddrInvalid;
-        entry->mTimeout = kAddressQueryTimeout;
-        entry->mFailures = 0;
-        entry->mRetryTimeout = kAddressQueryInitialRetryDelay;
-        entry->mState = Cache::kStateQuery;
+        error = OT_ERROR_ADDRESS_QUERY;
+    }
+    else if (query->mRetryTimeout == 0)
+    {
+        query->mTimeout = kAddressQueryTimeout;
         SendAddressQuery(aEid);
         error = OT_ERROR_ADDRESS_QUERY;
-        break;
-
-    case Cache::kStateQuery:
-        if (entry->mTimeout > 0)
-        {
-            error = OT_ERROR_ADDRESS_QUERY;
-        }
-        else if (entry->mTimeout == 0 && entry->mRetryTimeout == 0)
-        {
-            entry->mTimeout = kAddressQueryTimeout;
-            SendAddressQuery(aEid);
-            error = OT_ERROR_ADDRESS_QUERY;
-        }
-        else
-        {
-            error = OT_ERROR_DROP;
-        }
-
-        break;
-
-    case Cache::kStateCached:
-        aRloc16 = entry->mRloc16;
-        MarkCacheEntryAsUsed(*entry);
-        break;
+    }
+    else
+    {
+        error = OT_ERROR_DROP;
     }
 
 exit:
@@ -261,6 +449,7 @@ otError AddressResolver::SendAddressQuery(const Ip6::Address &aEid)
 
     SuccessOrExit(error = mNetif.GetCoap().SendMessage(*message, messageInfo));
 
+    mCounters.mQueries++;
     otLogInfoArp(GetInstance(), "Sent address query");
 
 exit:
@@ -294,6 +483,9 @@ void AddressResolver::HandleAddressNotification(Coap::Header &aHeader, Message &
     ThreadRloc16Tlv rloc16Tlv;
     ThreadLastTransactionTimeTlv lastTransactionTimeTlv;
     uint32_t lastTransactionTime;
+    EidCache::Entry *entry;
+    Query *query;
+    bool evicted;
 
     VerifyOrExit(aHeader.GetType() == kCoapTypeConfirmable &&
                  aHeader.GetCode() == kCoapRequestPost);
@@ -319,52 +511,41 @@ void AddressResolver::HandleAddressNotification(Coap::Header &aHeader, Message &
         lastTransactionTime = lastTransactionTimeTlv.GetTime();
     }
 
-    for (int i = 0; i < kCacheEntries; i++)
+    if ((entry = mCache.Find(*targetTlv.GetTarget())) != NULL)
     {
-        if (mCache[i].mTarget != *targetTlv.GetTarget())
+        if (memcmp(entry->mMeshLocalIid, mlIidTlv.GetIid(), sizeof(entry->mMeshLocalIid)) != 0)
         {
-            continue;
+            SendAddressError(targetTlv, mlIidTlv, NULL);
+            ExitNow();
         }
 
-        switch (mCache[i].mState)
-        {
-        case Cache::kStateInvalid:
-            break;
-
-        case Cache::kStateCached:
-            if (memcmp(mCache[i].mMeshLocalIid, mlIidTlv.GetIid(), sizeof(mCache[i].mMeshLocalIid)) != 0)
-            {
-                SendAddressError(targetTlv, mlIidTlv, NULL);
-                ExitNow();
-            }
-
-            if (lastTransactionTime >= mCache[i].mLastTransactionTime)
-            {
-                ExitNow();
-            }
+        VerifyOrExit(lastTransactionTime < entry->mLastTransactionTime);
+        mCache.MarkAsUsed(*entry);
+    }
+    else
+    {
+        VerifyOrExit((query = FindQuery(*targetTlv.GetTarget())) != NULL);
+        query->mInUse = false;
 
-        // fall through
+        entry = &mCache.Add(*targetTlv.GetTarget(), evicted);
 
-        case Cache::kStateQuery:
-            memcpy(mCache[i].mMeshLocalIid, mlIidTlv.GetIid(), sizeof(mCache[i].mMeshLocalIid));
-            mCache[i].mRloc16 = rloc16Tlv.GetRloc16();
-            mCache[i].mRetryTimeout = 0;
-            mCache[i].mLastTransactionTime = lastTransactionTime;
-            mCache[i].mTimeout = 0;
-            mCache[i].mFailures = 0;
-            mCache[i].mState = Cache::kStateCached;
-            MarkCacheEntryAsUsed(mCache[i]);
+        if (evicted)
+        {
+            mCounters.mEvictions++;
+        }
+    }
 
-            if (mNetif.GetCoap().SendEmptyAck(aHeader, aMessageInfo) == OT_ERROR_NONE)
-            {
-                otLogInfoArp(GetInstance(), "Sent address notification acknowledgment");
-            }
+    memcpy(entry->mMeshLocalIid, mlIidTlv.GetIid(), sizeof(entry->mMeshLocalIid));
+    entry->mRloc16 = rloc16Tlv.GetRloc16();
+    entry->mLastTransactionTime = lastTransactionTime;
 
-            mNetif.GetMeshForwarder().HandleResolved(*targetTlv.GetTarget(), OT_ERROR_NONE);
-            break;
-        }
+    if (mNetif.GetCoap().SendEmptyAck(aHeader, aMessageInfo) == OT_ERROR_NONE)
+    {
+        otLogInfoArp(GetInstance(), "Sent address notification acknowledgment");
     }
 
+    mNetif.GetMeshForwarder().HandleResolved(*targetTlv.GetTarget(), OT_ERROR_NONE);
+
 exit:
     return;
 }
@@ -617,39 +798,45 @@ void AddressResolver::HandleTimer()
 {
     bool continueTimer = false;
 
-    for (int i = 0; i < kCacheEntries; i++)
+    for (int i = 0; i < kQueryEntries; i++)
     {
-        if (mCache[i].mState != Cache::kStateQuery)
+        Query &query = mQueries[i];
+
+        if (!query.mInUse)
         {
             continue;
         }
 
-        continueTimer = true;
-
-        if (mCache[i].mTimeout > 0)
+        if (query.mTimeout > 0)
         {
-            mCache[i].mTimeout--;
+            query.mTimeout--;
 
-            if (mCache[i].mTimeout == 0)
+            if (query.mTimeout == 0)
             {
-                mCache[i].mRetryTimeout =
-                    static_cast<uint16_t>(kAddressQueryInitialRetryDelay * (1 << mCache[i].mFailures));
+                query.mRetryTimeout = static_cast<uint16_t>(kAddressQueryInitialRetryDelay * (1 << query.mFailures));
 
-                if (mCache[i].mRetryTimeout < kAddressQueryMaxRetryDelay)
+                if (query.mRetryTimeout < kAddressQueryMaxRetryDelay)
                 {
-                    mCache[i].mFailures++;
+                    query.mFailures++;
                 }
                 else
                 {
-                    mCache[i].mRetryTimeout = kAddressQueryMaxRetryDelay;
+                    query.mRetryTimeout = kAddressQueryMaxRetryDelay;
                 }
 
-                mNetif.GetMeshForwarder().HandleResolved(mCache[i].mTarget, OT_ERROR_DROP);
+                mCounters.mQueryTimeouts++;
+                mNetif.GetMeshForwarder().HandleResolved(query.mTarget, OT_ERROR_DROP);
             }
         }
-        else if (mCache[i].mRetryTimeout > 0)
+        else if (query.mRetryTimeout > 0)
         {
-            mCache[i].mRetryTimeout--;
+            query.mRetryTimeout--;
+        }
+
+        // A query whose retry delay has elapsed is restarted by `Resolve()`, which also restarts the timer.
+        if (query.mTimeout > 0 || query.mRetryTimeout > 0)
+        {
+            continueTimer = true;
         }
     }
 
@@ -673,19 +860,20 @@ void AddressResolver::HandleIcmpReceive(Message &aMessage, const Ip6::MessageInf
                                         const Ip6::IcmpHeader &aIcmpHeader)
 {
     Ip6::Header ip6Header;
+    EidCache::Entry *entry;
+    Query *query;
 
     VerifyOrExit(aIcmpHeader.GetType() == Ip6::IcmpHeader::kTypeDstUnreach);
     VerifyOrExit(aIcmpHeader.GetCode() == Ip6::IcmpHeader::kCodeDstUnreachNoRoute);
     VerifyOrExit(aMessage.Read(aMessage.GetOffset(), sizeof(ip6Header), &ip6Header) == sizeof(ip6Header));
 
-    for (int i = 0; i < kCacheEntries; i++)
+    if ((entry = mCache.Find(ip6Header.GetDestination())) != NULL)
     {
-        if (mCache[i].mState != Cache::kStateInvalid &&
-            memcmp(&mCache[i].mTarget, &ip6Header.GetDestination(), sizeof(mCache[i].mTarget)) == 0)
-        {
-            InvalidateCacheEntry(mCache[i]);
-            break;
-        }
+        InvalidateCacheEntry(*entry);
+    }
+    else if ((query = FindQuery(ip6Header.GetDestination())) != NULL)
+    {
+        query->mInUse = false;
     }
 
 exit:
@@ -60,6 +60,144 @@ class ThreadTargetTlv;
  * @{
  */
 
+/**
+ * This class implements an EID-to-RLOC cache backed by caller-provided storage.
+ *
+ * Entries are located through a chained hash index keyed on the EID and kept on an intrusive least-recently-used
+ * list, so lookup, use, insertion, eviction and removal do not depend on the number of entries.
+ *
+ */
+class EidCache
+{
+public:
+    /**
+     * This structure represents an EID cache entry.
+     *
+     */
+    struct Entry
+    {
+        Ip6::Address      mTarget;
+        uint8_t           mMeshLocalIid[Ip6::Address::kInterfaceIdentifierSize];
+        uint32_t          mLastTransactionTime;
+        Mac::ShortAddress mRloc16;
+        uint16_t          mHashNext;   ///< Next entry in the same hash bucket (internal).
+        uint16_t          mLruPrev;    ///< More recently used entry (internal).
+        uint16_t          mLruNext;    ///< Less recently used entry, or next free entry (internal).
+        bool              mInUse;
+    };
+
+    enum
+    {
+        kInvalidIndex = 0xffff,  ///< Marks the end of a list or an empty hash bucket.
+    };
+
+    /**
+     * This constructor initializes the cache.
+     *
+     * @param[in]  aEntries     A pointer to an array of entries.
+     * @param[in]  aNumEntries  The number of entries in @p aEntries.
+     * @param[in]  aBuckets     A pointer to an array of hash buckets.
+     * @param[in]  aNumBuckets  The number of entries in @p aBuckets.
+     *
+     */
+    EidCache(Entry *aEntries, uint16_t aNumEntries, uint16_t *aBuckets, uint16_t aNumBuckets);
+
+    /**
+     * This method removes all entries from the cache.
+     *
+     */
+    void Clear(void);
+
+    /**
+     * This method finds the entry for a given EID.
+     *
+     * @param[in]  aEid  A reference to the EID.
+     *
+     * @returns A pointer to the entry or NULL if @p aEid is not cached.
+     *
+     */
+    Entry *Find(const Ip6::Address &aEid);
+
+    /**
+     * This method adds an entry for a given EID as the most recently used one.
+     *
+     * If the cache is full, the least recently used entry is evicted.  The caller must ensure that @p aEid is not
+     * already cached.  Only the target and the internal fields of the returned entry are initialized.
+     *
+     * @param[in]   aEid      A reference to the EID.
+     * @param[out]  aEvicted  Set to TRUE if an entry was evicted, FALSE otherwise.
+     *
+     * @returns A reference to the new entry.
+     *
+     */
+    Entry &Add(const Ip6::Address &aEid, bool &aEvicted);
+
+    /**
+     * This method moves an entry to the head of the least-recently-used list.
+     *
+     * @param[in]  aEntry  A reference to the entry.
+     *
+     */
+    void MarkAsUsed(Entry &aEntry);
+
+    /**
+     * This method removes an entry from the cache.
+     *
+     * @param[in]  aEntry  A reference to the entry.
+     *
+     */
+    void Remove(Entry &aEntry);
+
+    /**
+     * This method returns the entry stored at a given index of the backing array.
+     *
+     * @param[in]  aIndex  The index.
+     *
+     * @returns A pointer to the entry, or NULL if @p aIndex is out of bounds or the entry is not in use.
+     *
+     */
+    Entry *GetEntry(uint16_t aIndex);
+
+    /**
+     * This method returns the least recently used entry.
+     *
+     * @returns A pointer to the least recently used entry or NULL if the cache is empty.
+     *
+     */
+    Entry *GetLeastRecentlyUsed(void);
+
+    /**
+     * This method returns the number of entries of the backing array.
+     *
+     * @returns The number of entries of the backing array.
+     *
+     */
+    uint16_t GetNumEntries(void) const { return mNumEntries; }
+
+    /**
+     * This method returns the number of cached entries.
+     *
+     * @returns The number of cached entries.
+     *
+     */
+    uint16_t GetCount(void) const { return mCount; }
+
+private:
+    uint16_t GetBucket(const Ip6::Address &aEid) const;
+    uint16_t GetIndex(const Entry &aEntry) const { return static_cast<uint16_t>(&aEntry - mEntries); }
+    void LinkLru(uint16_t aIndex);
+    void UnlinkLru(uint16_t aIndex);
+
+    Entry    *mEntries;
+    uint16_t *mBuckets;
+    uint16_t  mNumEntries;
+    uint16_t  mNumBuckets;
+    uint16_t  mCount;
+    uint16_t  mLruHead;
+    uint16_t  mLruTail;
+    uint16_t  mFreeHead;
+};
+
 /**
  * This class implements the EID-to-RLOC mapping and caching.
  *
@@ -97,7 +235,28 @@ public:
      * @retval OT_ERROR_INVALID_ARGS  @p aIndex was out of bounds or @p aEntry was NULL.
      *
      */
-    otError GetEntry(uint8_t aIndex, otEidCacheEntry &aEntry) const;
+    otError GetEntry(uint8_t aIndex, otEidCacheEntry &aEntry);
+
+    /**
+     * This method gets the next EID cache entry, walking the cached entries followed by the EIDs with an outstanding
+     * Address Query.
+     *
+     * @param[inout]  aIterator  A reference to the iterator context.
+     * @param[out]    aEntry     A reference to where the EID information is placed.
+     *
+     * @retval OT_ERROR_NONE       Successfully found the next EID cache entry.
+     * @retval OT_ERROR_NOT_FOUND  No subsequent EID cache entry exists.
+     *
+     */
+    otError GetNextEntry(otEidCacheIterator &aIterator, otEidCacheEntry &aEntry);
+
+    /**
+     * This method returns the EID cache counters.
+     *
+     * @returns A reference to the EID cache counters.
+     *
+     */
+    const otEidCacheCounters &GetCounters(void) const { return mCounters; }
 
     /**
      * This method removes a Router ID from the EID-to-RLOC cache.
@@ -123,6 +282,8 @@ private:
     enum
     {
         kCacheEntries = OPENTHREAD_CONFIG_ADDRESS_CACHE_ENTRIES,
+        kCacheBuckets = OPENTHREAD_CONFIG_ADDRESS_CACHE_BUCKETS,
+        kQueryEntries = OPENTHREAD_CONFIG_ADDRESS_QUERY_ENTRIES,
         kStateUpdatePeriod = 1000u,           ///< State update period in milliseconds.
     };
 
@@ -137,29 +298,18 @@ private:
         kAddressQueryMaxRetryDelay = 28800,   ///< ADDRESS_QUERY_MAX_RETRY_DELAY (seconds)
     };
 
-    struct Cache
+    struct Query
     {
         Ip6::Address      mTarget;
-        uint8_t           mMeshLocalIid[Ip6::Address::kInterfaceIdentifierSize];
-        uint32_t          mLastTransactionTime;
-        Mac::ShortAddress mRloc16;
         uint16_t          mRetryTimeout;
         uint8_t           mTimeout;
         uint8_t           mFailures;
-        uint8_t           mAge;
-
-        enum State
-        {
-            kStateInvalid,
-            kStateQuery,
-            kStateCached,
-        };
-        State             mState;
+        bool              mInUse;
     };
 
-    Cache *NewCacheEntry(void);
-    void MarkCacheEntryAsUsed(Cache &aEntry);
-    void InvalidateCacheEntry(Cache &aEntry);
+    Query *FindQuery(const Ip6::Address &aEid);
+    Query *NewQuery(void);
+    void InvalidateCacheEntry(EidCache::Entry &aEntry);
 
     otError SendAddressQuery(const Ip6::Address &aEid);
     otError SendAddressError(const ThreadTargetTlv &aTarget, const ThreadMeshLocalEidTlv &aEid,
@@ -192,7 +342,11 @@ private:
     Coap::Resource mAddressError;
     Coap::Resource mAddressQuery;
     Coap::Resource mAddressNotification;
-    Cache mCache[kCacheEntries];
+    EidCache::Entry mCacheEntries[kCacheEntries];
+    uint16_t mCacheBuckets[kCacheBuckets];
+    EidCache mCache;
+    Query mQueries[kQueryEntries];
+    otEidCacheCounters mCounters;
     Ip6::IcmpHandler mIcmpHandler;
     Timer mTimer;
 
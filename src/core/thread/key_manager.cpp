@@ -67,6 +67,7 @@ KeyManager::KeyManager(ThreadNetif &aThreadNetif):
     mKekFrameCounter(0),
     mSecurityPolicyFlags(0xff)
 {
+    memset(mKeyCache, 0, sizeof(mKeyCache));
 }
 
 void KeyManager::Start(void)
@@ -108,7 +109,8 @@ otError KeyManager::SetMasterKey(const otMasterKey &aKey)
 
     mMasterKey = aKey;
     mKeySequence = 0;
-    ComputeKey(mKeySequence, mKey);
+    InvalidateKeyCache();
+    GetKey(mKeySequence);
 
     // reset parent frame counters
     routers = mNetif.GetMle().GetParent();
@@ -195,8 +197,9 @@ void KeyManager::SetCurrentKeySequence(uint32_t aKeySequence)
         }
     }
 
+    // The new current key is usually already cached as the former next key.
     mKeySequence = aKeySequence;
-    ComputeKey(mKeySequence, mKey);
+    GetKey(mKeySequence);
 
     mMacFrameCounter = 0;
     mMleFrameCounter = 0;
@@ -213,16 +216,47 @@ exit:
     return;
 }
 
+const uint8_t *KeyManager::GetKey(uint32_t aKeySequence)
+{
+    CachedKey &entry = mKeyCache[aKeySequence & (kNumCachedKeys - 1)];
+    const uint8_t *key;
+
+    // Only current-1, current and current+1 are cached (the unsigned difference also handles wrap-around).
+    if (aKeySequence - (mKeySequence - 1) > 2)
+    {
+        ComputeKey(aKeySequence, mTemporaryKey);
+        ExitNow(key = mTemporaryKey);
+    }
+
+    if (!entry.mValid || entry.mKeySequence != aKeySequence)
+    {
+        ComputeKey(aKeySequence, entry.mKey);
+        entry.mKeySequence = aKeySequence;
+        entry.mValid = true;
+    }
+
+    key = entry.mKey;
+
+exit:
+    return key;
+}
+
+void KeyManager::InvalidateKeyCache(void)
+{
+    for (int i = 0; i < kNumCachedKeys; i++)
+    {
+        mKeyCache[i].mValid = false;
+    }
+}
+
 const uint8_t *KeyManager::GetTemporaryMacKey(uint32_t aKeySequence)
 {
-    ComputeKey(aKeySequence, mTemporaryKey);
-    return mTemporaryKey + kMacKeyOffset;
+    return GetKey(aKeySequence) + kMacKeyOffset;
 }
 
 const uint8_t *KeyManager::GetTemporaryMleKey(uint32_t aKeySequence)
 {
-    ComputeKey(aKeySequence, mTemporaryKey);
-    return mTemporaryKey;
+    return GetKey(aKeySequence);
 }
 
 void KeyManager::IncrementMacFrameCounter(void)
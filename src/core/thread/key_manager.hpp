@@ -139,7 +139,7 @@ public:
      * @returns A pointer to the current MAC key.
      *
      */
-    const uint8_t *GetCurrentMacKey(void) const { return mKey + kMacKeyOffset; }
+    const uint8_t *GetCurrentMacKey(void) const { return GetCurrentKey() + kMacKeyOffset; }
 
     /**
      * This method returns a pointer to the current MLE key.
@@ -147,11 +147,14 @@ public:
      * @returns A pointer to the current MLE key.
      *
      */
-    const uint8_t *GetCurrentMleKey(void) const { return mKey; }
+    const uint8_t *GetCurrentMleKey(void) const { return GetCurrentKey(); }
 
     /**
      * This method returns a pointer to a temporary MAC key computed from the given key sequence.
      *
+     * Keys for the previous, current and next key sequence are cached and remain valid until the key sequence or
+     * master key changes.  Any other key is recomputed on each call and only valid until the next call.
+     *
      * @param[in]  aKeySequence  The key sequence value.
      *
      * @returns A pointer to the temporary MAC key.
@@ -162,6 +165,8 @@ public:
     /**
      * This method returns a pointer to a temporary MLE key computed from the given key sequence.
      *
+     * Keys for the previous, current and next key sequence are cached (see `GetTemporaryMacKey()`).
+     *
      * @param[in]  aKeySequence  The key sequence value.
      *
      * @returns A pointer to the temporary MLE key.
@@ -332,9 +337,20 @@ private:
         kDefaultKeyRotationTime = 672,
         kDefaultKeySwitchGuardTime = 624,
         kMacKeyOffset = 16,
+        kNumCachedKeys = 4,  ///< Covers current-1..current+1; a power of two so slots stay distinct on wrap.
+    };
+
+    struct CachedKey
+    {
+        uint32_t mKeySequence;
+        bool     mValid;
+        uint8_t  mKey[Crypto::HmacSha256::kHashSize];
     };
 
     otError ComputeKey(uint32_t aKeySequence, uint8_t *aKey);
+    const uint8_t *GetKey(uint32_t aKeySequence);
+    const uint8_t *GetCurrentKey(void) const { return mKeyCache[mKeySequence & (kNumCachedKeys - 1)].mKey; }
+    void InvalidateKeyCache(void);
 
     static void HandleKeyRotationTimer(void *aContext);
     void HandleKeyRotationTimer(void);
@@ -344,7 +360,7 @@ private:
     otMasterKey mMasterKey;
 
     uint32_t mKeySequence;
-    uint8_t mKey[Crypto::HmacSha256::kHashSize];
+    CachedKey mKeyCache[kNumCachedKeys];
 
     uint8_t mTemporaryKey[Crypto::HmacSha256::kHashSize];
 
@@ -249,8 +249,9 @@ int Lowpan::Compress(Message &aMessage, const Mac::Address &aMacSource, const Ma
     uint8_t nextHeader;
     uint8_t ecn = 0;
     uint8_t dscp = 0;
+    Message::Cursor cursor(aMessage, aMessage.GetOffset());
 
-    aMessage.Read(aMessage.GetOffset(), sizeof(ip6Header), &ip6Header);
+    cursor.Read(&ip6Header, sizeof(ip6Header));
 
     if (mNetworkData.GetContext(ip6Header.GetSource(), srcContext) != OT_ERROR_NONE ||
         srcContext.mCompressFlag == false)
@@ -437,8 +438,9 @@ int Lowpan::CompressExtensionHeader(Message &aMessage, uint8_t *aBuf, uint8_t &a
     uint8_t len;
     uint8_t padLength = 0;
     uint16_t offset;
+    Message::Cursor cursor(aMessage, aMessage.GetOffset());
 
-    aMessage.Read(aMessage.GetOffset(), sizeof(extHeader), &extHeader);
+    cursor.Read(&extHeader, sizeof(extHeader));
     aMessage.MoveOffset(sizeof(extHeader));
 
     cur[0] = kExtHdrDispatch | kExtHdrEidHbh;
@@ -470,7 +472,8 @@ int Lowpan::CompressExtensionHeader(Message &aMessage, uint8_t *aBuf, uint8_t &a
 
         while (offset < len + aMessage.GetOffset())
         {
-            aMessage.Read(offset, sizeof(optionHeader), &optionHeader);
+            cursor.Seek(offset);
+            cursor.Peek(&optionHeader, sizeof(optionHeader));
 
             if (optionHeader.GetType() == Ip6::OptionPad1::kType)
             {
@@ -500,7 +503,8 @@ int Lowpan::CompressExtensionHeader(Message &aMessage, uint8_t *aBuf, uint8_t &a
     cur[0] = len;
     cur++;
 
-    aMessage.Read(aMessage.GetOffset(), len, cur);
+    cursor.Seek(aMessage.GetOffset());
+    cursor.Read(cur, len);
     aMessage.MoveOffset(len + padLength);
     cur += len;
 
@@ -514,8 +518,9 @@ int Lowpan::CompressUdp(Message &aMessage, uint8_t *aBuf)
     uint8_t *udpCtl = cur;
     uint16_t source;
     uint16_t destination;
+    Message::Cursor cursor(aMessage, aMessage.GetOffset());
 
-    aMessage.Read(aMessage.GetOffset(), sizeof(udpHeader), &udpHeader);
+    cursor.Read(&udpHeader, sizeof(udpHeader));
     source = udpHeader.GetSourcePort();
     destination = udpHeader.GetDestinationPort();
 
@@ -1151,26 +1156,22 @@ exit:
 otError MeshHeader::Init(const Message &aMessage)
 {
     otError error = OT_ERROR_NONE;
-    uint16_t offset = 0;
-    uint16_t bytesRead;
+    Message::Cursor cursor(aMessage, 0);
 
-    bytesRead = aMessage.Read(offset, sizeof(mDispatchHopsLeft), &mDispatchHopsLeft);
-    VerifyOrExit(bytesRead == sizeof(mDispatchHopsLeft), error = OT_ERROR_FAILED);
-    offset += bytesRead;
+    VerifyOrExit(cursor.Read(&mDispatchHopsLeft, sizeof(mDispatchHopsLeft)) == sizeof(mDispatchHopsLeft),
+                 error = OT_ERROR_FAILED);
 
     if (IsDeepHopsLeftField())
     {
-        bytesRead = aMessage.Read(offset, sizeof(mDeepHopsLeft), &mDeepHopsLeft);
-        VerifyOrExit(bytesRead == sizeof(mDeepHopsLeft), error = OT_ERROR_FAILED);
-        offset += bytesRead;
+        VerifyOrExit(cursor.Read(&mDeepHopsLeft, sizeof(mDeepHopsLeft)) == sizeof(mDeepHopsLeft),
+                     error = OT_ERROR_FAILED);
     }
     else
     {
         mDeepHopsLeft = 0;
     }
 
-    bytesRead = aMessage.Read(offset, sizeof(mAddress), &mAddress);
-    VerifyOrExit(bytesRead == sizeof(mAddress), error = OT_ERROR_FAILED);
+    VerifyOrExit(cursor.Read(&mAddress, sizeof(mAddress)) == sizeof(mAddress), error = OT_ERROR_FAILED);
 
 exit:
     return error;
@@ -67,6 +67,7 @@ MeshForwarder::MeshForwarder(ThreadNetif &aThreadNetif):
     mMacSender(&MeshForwarder::HandleFrameRequest, &MeshForwarder::HandleSentFrame, this),
     mDiscoverTimer(aThreadNetif.GetIp6().mTimerScheduler, &MeshForwarder::HandleDiscoverTimer, this),
     mReassemblyTimer(aThreadNetif.GetIp6().mTimerScheduler, &MeshForwarder::HandleReassemblyTimer, this),
+    mIndirectMessageRefPool(mIndirectMessageRefs, kNumIndirectMessageRefs),
     mMessageNextOffset(0),
     mSendMessageFrameCounter(0),
     mSendMessage(NULL),
@@ -90,6 +91,8 @@ MeshForwarder::MeshForwarder(ThreadNetif &aThreadNetif):
     mSourceMatchController(*this)
 {
     mFragTag = static_cast<uint16_t>(otPlatRandomGet());
+    memset(mReassemblyEntries, 0, sizeof(mReassemblyEntries));
+    memset(mReassemblyBuckets, 0, sizeof(mReassemblyBuckets));
     mNetif.GetMac().RegisterReceiver(mMacReceiver);
     mMacSource.mLength = 0;
     mMacDest.mLength = 0;
@@ -117,6 +120,8 @@ otError MeshForwarder::Stop(void)
 {
     otError error = OT_ERROR_NONE;
     Message *message;
+    Child *children;
+    uint8_t numChildren;
 
     VerifyOrExit(mEnabled == true);
 
@@ -130,16 +135,25 @@ otError MeshForwarder::Stop(void)
         mNetif.GetMle().HandleDiscoverComplete();
     }
 
+    children = mNetif.GetMle().GetChildren(&numChildren);
+
+    for (uint8_t i = 0; i < numChildren; i++)
+    {
+        ClearChildIndirectMessages(children[i]);
+    }
+
     while ((message = mSendQueue.GetHead()) != NULL)
     {
         mSendQueue.Dequeue(*message);
         message->Free();
     }
 
-    while ((message = mReassemblyList.GetHead()) != NULL)
+    for (int i = 0; i < kNumReassemblyEntries; i++)
     {
-        mReassemblyList.Dequeue(*message);
-        message->Free();
+        if (mReassemblyEntries[i].mInUse && (message = FreeReassemblyEntry(mReassemblyEntries[i])) != NULL)
+        {
+            message->Free();
+        }
     }
 
     mEnabled = false;
@@ -191,15 +205,14 @@ void MeshForwarder::HandleResolved(const Ip6::Address &aEid, otError aError)
 
 void MeshForwarder::ClearChildIndirectMessages(Child &aChild)
 {
-    Message *nextMessage;
+    IndirectMessageQueue &queue = aChild.GetIndirectMessageQueue();
+    Message *message;
 
-    VerifyOrExit(aChild.GetIndirectMessageCount() > 0);
+    VerifyOrExit(queue.GetHead() != NULL);
 
-    for (Message *message = mSendQueue.GetHead(); message; message = nextMessage)
+    while ((message = queue.GetHeadMessage()) != NULL)
     {
-        nextMessage = message->GetNext();
-
-        message->ClearChildMask(mNetif.GetMle().GetChildIndex(aChild));
+        queue.Dequeue(*message, mIndirectMessageRefPool);
 
         if (!message->IsChildPending() && !message->GetDirectTransmission())
         {
@@ -213,6 +226,7 @@ void MeshForwarder::ClearChildIndirectMessages(Child &aChild)
         }
     }
 
+    aChild.SetIndirectMessage(NULL);
     mSourceMatchController.ResetMessageCount(aChild);
 
 exit:
@@ -366,9 +380,9 @@ otError MeshForwarder::SendMessage(Message &aMessage)
 
                 for (uint8_t i = 0; i < numChildren; i++, child++)
                 {
-                    if (child->IsStateValidOrRestoring() && !child->IsRxOnWhenIdle())
+                    if (child->IsStateValidOrRestoring() && !child->IsRxOnWhenIdle() &&
+                        child->GetIndirectMessageQueue().Enqueue(aMessage, mIndirectMessageRefPool) == OT_ERROR_NONE)
                     {
-                        aMessage.SetChildMask(i);
                         mSourceMatchController.IncrementMessageCount(*child);
                     }
                 }
@@ -380,7 +394,7 @@ otError MeshForwarder::SendMessage(Message &aMessage)
         {
             // destined for a sleepy child
             child = static_cast<Child *>(neighbor);
-            aMessage.SetChildMask(mNetif.GetMle().GetChildIndex(*child));
+            SuccessOrExit(error = child->GetIndirectMessageQueue().Enqueue(aMessage, mIndirectMessageRefPool));
             mSourceMatchController.IncrementMessageCount(*child);
         }
         else
@@ -403,7 +417,7 @@ otError MeshForwarder::SendMessage(Message &aMessage)
         {
             // destined for a sleepy child
             child = static_cast<Child *>(neighbor);
-            aMessage.SetChildMask(mNetif.GetMle().GetChildIndex(*child));
+            SuccessOrExit(error = child->GetIndirectMessageQueue().Enqueue(aMessage, mIndirectMessageRefPool));
             mSourceMatchController.IncrementMessageCount(*child);
         }
         else
@@ -424,7 +438,7 @@ otError MeshForwarder::SendMessage(Message &aMessage)
         VerifyOrExit(child != NULL, error = OT_ERROR_DROP);
         VerifyOrExit(!child->IsRxOnWhenIdle(), error = OT_ERROR_DROP);
 
-        aMessage.SetChildMask(mNetif.GetMle().GetChildIndex(*child));
+        SuccessOrExit(error = child->GetIndirectMessageQueue().Enqueue(aMessage, mIndirectMessageRefPool));
         mSourceMatchController.IncrementMessageCount(*child);
         break;
     }
@@ -517,8 +531,15 @@ Message *MeshForwarder::GetDirectTransmission(void)
 
         case OT_ERROR_DROP:
         case OT_ERROR_NO_BUFS:
-            mSendQueue.Dequeue(*curMessage);
-            curMessage->Free();
+            curMessage->ClearDirectTransmission();
+
+            // A message still referenced by sleepy children stays queued for their indirect transmission.
+            if (!curMessage->IsChildPending())
+            {
+                mSendQueue.Dequeue(*curMessage);
+                curMessage->Free();
+            }
+
             continue;
 
         default:
@@ -533,29 +554,23 @@ exit:
 
 Message *MeshForwarder::GetIndirectTransmission(Child &aChild)
 {
-    Message *message = NULL;
-    Message *next;
-    uint8_t childIndex = mNetif.GetMle().GetChildIndex(aChild);
+    IndirectMessageQueue &queue = aChild.GetIndirectMessageQueue();
+    Message *message;
 
-    for (message = mSendQueue.GetHead(); message; message = next)
+    while ((message = queue.GetHeadMessage()) != NULL)
     {
-        next = message->GetNext();
+        // Skip and remove the supervision message if there are other messages queued for the child.
 
-        if (message->GetChildMask(childIndex))
+        if ((message->GetType() == Message::kTypeSupervision) && (aChild.GetIndirectMessageCount() > 1))
         {
-            // Skip and remove the supervision message if there are other messages queued for the child.
-
-            if ((message->GetType() == Message::kTypeSupervision) && (aChild.GetIndirectMessageCount() > 1))
-            {
-                message->ClearChildMask(childIndex);
-                mSourceMatchController.DecrementMessageCount(aChild);
-                mSendQueue.Dequeue(*message);
-                message->Free();
-                continue;
-            }
-
-            break;
+            queue.Dequeue(*message, mIndirectMessageRefPool);
+            mSourceMatchController.DecrementMessageCount(aChild);
+            mSendQueue.Dequeue(*message);
+            message->Free();
+            continue;
         }
+
+        break;
     }
 
     aChild.SetIndirectMessage(message);
@@ -1427,7 +1442,6 @@ void MeshForwarder::HandleSentFrame(Mac::Frame &aFrame, otError aError)
     Mac::Address macDest;
     Child *child;
     Neighbor *neighbor;
-    uint8_t childIndex;
 
     mSendBusy = false;
 
@@ -1554,11 +1568,8 @@ void MeshForwarder::HandleSentFrame(Mac::Frame &aFrame, otError aError)
                 mSourceMatchController.SetSrcMatchAsShort(*child, true);
             }
 
-            childIndex = mNetif.GetMle().GetChildIndex(*child);
-
-            if (mSendMessage->GetChildMask(childIndex))
+            if (child->GetIndirectMessageQueue().Dequeue(*mSendMessage, mIndirectMessageRefPool) == OT_ERROR_NONE)
             {
-                mSendMessage->ClearChildMask(childIndex);
                 mSourceMatchController.DecrementMessageCount(*child);
             }
         }
@@ -1880,16 +1891,30 @@ void MeshForwarder::HandleFragment(uint8_t *aFrame, uint8_t aFrameLength,
                                    const ThreadMessageInfo &aMessageInfo)
 {
     otError error = OT_ERROR_NONE;
+    otMacCounters &counters = mNetif.GetMac().GetCounters();
     Lowpan::FragmentHeader *fragmentHeader = reinterpret_cast<Lowpan::FragmentHeader *>(aFrame);
     uint16_t datagramLength = fragmentHeader->GetDatagramSize();
     uint16_t datagramTag = fragmentHeader->GetDatagramTag();
+    uint16_t fragmentOffset = fragmentHeader->GetDatagramOffset();
+    uint16_t fragmentEnd;
+    ReassemblyEntry *entry;
     Message *message = NULL;
     int headerLength;
 
-    if (fragmentHeader->GetDatagramOffset() == 0)
+    aFrame += fragmentHeader->GetHeaderLength();
+    aFrameLength -= fragmentHeader->GetHeaderLength();
+
+    VerifyOrExit(datagramLength <= Ip6::Ip6::kMaxDatagramLength, error = OT_ERROR_PARSE);
+
+    entry = FindReassemblyEntry(aMacSource, datagramTag, datagramLength, aMessageInfo.mLinkSecurity);
+
+    if (fragmentOffset == 0)
     {
-        aFrame += fragmentHeader->GetHeaderLength();
-        aFrameLength -= fragmentHeader->GetHeaderLength();
+        if (entry != NULL && (entry->mHeaderReceived || entry->mMessage == NULL))
+        {
+            counters.mRxFragmentDuplicated++;
+            ExitNow();
+        }
 
         VerifyOrExit((message = mNetif.GetIp6().mMessagePool.New(Message::kTypeIp6, 0)) != NULL,
                      error = OT_ERROR_NO_BUFS);
@@ -1903,84 +1928,116 @@ void MeshForwarder::HandleFragment(uint8_t *aFrame, uint8_t aFrameLength,
         aFrameLength -= static_cast<uint8_t>(headerLength);
 
         VerifyOrExit(datagramLength >= message->GetOffset() + aFrameLength, error = OT_ERROR_PARSE);
+        fragmentEnd = message->GetOffset() + aFrameLength;
+        VerifyOrExit(fragmentEnd == datagramLength || (fragmentEnd % ReassemblyEntry::kUnitSize) == 0,
+                     error = OT_ERROR_PARSE);
 
         SuccessOrExit(error = message->SetLength(datagramLength));
 
         message->SetDatagramTag(datagramTag);
-        message->SetTimeout(kReassemblyTimeout);
 
         // copy Fragment
         message->Write(message->GetOffset(), aFrameLength, aFrame);
-        message->MoveOffset(aFrameLength);
 
         // Security Check
         VerifyOrExit(mNetif.GetIp6Filter().Accept(*message), error = OT_ERROR_DROP);
 
-        // Allow re-assembly of only one message at a time on a SED by clearing
-        // any remaining fragments in reassembly list upon receiving of a new
-        // (secure) first fragment.
-
-        if ((GetRxOnWhenIdle() == false) && message->IsLinkSecurityEnabled())
+        if (entry == NULL)
         {
-            ClearReassemblyList();
-        }
+            // Allow re-assembly of only one message at a time on a SED by clearing
+            // any remaining fragments in reassembly list upon receiving of a new
+            // (secure) first fragment.
 
-        mReassemblyList.Enqueue(*message);
+            if ((GetRxOnWhenIdle() == false) && message->IsLinkSecurityEnabled())
+            {
+                ClearReassemblyList();
+            }
 
-        if (!mReassemblyTimer.IsRunning())
+            VerifyOrExit((entry = GetFreeReassemblyEntry(true)) != NULL, error = OT_ERROR_NO_BUFS);
+            AddReassemblyEntry(*entry, *message, aMacSource, true);
+            message = NULL;
+        }
+        else
         {
-            mReassemblyTimer.Start(kStateUpdatePeriod);
+            // Later fragments were received first, place the decompressed headers in front of them.
+            message->CopyTo(0, 0, fragmentEnd, *entry->mMessage);
+            message->Free();
+            message = NULL;
+            entry->mHeaderReceived = true;
         }
     }
     else
     {
-        aFrame += fragmentHeader->GetHeaderLength();
-        aFrameLength -= fragmentHeader->GetHeaderLength();
+        fragmentEnd = fragmentOffset + aFrameLength;
+        VerifyOrExit(fragmentEnd <= datagramLength, error = OT_ERROR_PARSE);
+        VerifyOrExit(fragmentEnd == datagramLength || (fragmentEnd % ReassemblyEntry::kUnitSize) == 0,
+                     error = OT_ERROR_PARSE);
 
-        for (message = mReassemblyList.GetHead(); message; message = message->GetNext())
+        // For a sleepy-end-device, if we receive a new (secure) next fragment
+        // with a non-matching tag, it indicates that the parent has moved to a
+        // new message with a new tag. We can safely clear any remaining
+        // fragments stored in the reassembly list.
+
+        if (entry == NULL && GetRxOnWhenIdle() == false && aMessageInfo.mLinkSecurity)
         {
-            // Security Check: only consider reassembly buffers that had the same Security Enabled setting.
-            if (message->GetLength() == datagramLength &&
-                message->GetDatagramTag() == datagramTag &&
-                message->GetOffset() == fragmentHeader->GetDatagramOffset() &&
-                message->IsLinkSecurityEnabled() == aMessageInfo.mLinkSecurity)
-            {
-                break;
-            }
+            ClearReassemblyList();
         }
 
-        // For a sleepy-end-device, if we receive a new (secure) next fragment
-        // with a non-matching fragmentation offset or tag, it indicates that
-        // we have either missed a fragment, or the parent has moved to a new
-        // message with a new tag. In either case, we can safely clear any
-        // remaining fragments stored in the reassembly list.
-
-        if (GetRxOnWhenIdle() == false)
+        if (entry != NULL && entry->mMessage == NULL)
         {
-            if ((message == NULL) && (aMessageInfo.mLinkSecurity))
-            {
-                ClearReassemblyList();
-            }
+            counters.mRxFragmentDuplicated++;
+            ExitNow();
         }
 
-        VerifyOrExit(message != NULL, error = OT_ERROR_DROP);
+        if (entry == NULL)
+        {
+            // Look for an entry before allocating the datagram buffer, later fragments alone may not displace a
+            // datagram whose first fragment was received.
+            VerifyOrExit((entry = GetFreeReassemblyEntry(false)) != NULL, error = OT_ERROR_NO_BUFS);
+
+            VerifyOrExit((message = mNetif.GetIp6().mMessagePool.New(Message::kTypeIp6, 0)) != NULL,
+                         error = OT_ERROR_NO_BUFS);
+            message->SetLinkSecurityEnabled(aMessageInfo.mLinkSecurity);
+            message->SetPanId(aMessageInfo.mPanId);
+            SuccessOrExit(error = message->SetLength(datagramLength));
+            message->SetDatagramTag(datagramTag);
+
+            AddReassemblyEntry(*entry, *message, aMacSource, false);
+            message = NULL;
+        }
 
         // copy Fragment
-        message->Write(message->GetOffset(), aFrameLength, aFrame);
-        message->MoveOffset(aFrameLength);
+        entry->mMessage->Write(fragmentOffset, aFrameLength, aFrame);
     }
 
-exit:
+    if (!MarkFragmentReceived(*entry, fragmentOffset, fragmentEnd))
+    {
+        counters.mRxFragmentDuplicated++;
+        ExitNow();
+    }
 
-    if (error == OT_ERROR_NONE)
+    if (fragmentOffset != entry->mNextOffset)
     {
-        if (message->GetOffset() >= message->GetLength())
-        {
-            mReassemblyList.Dequeue(*message);
-            HandleDatagram(*message, aMessageInfo, aMacSource);
-        }
+        counters.mRxFragmentOutOfOrder++;
     }
-    else
+
+    entry->mNextOffset = fragmentEnd;
+
+    if (entry->mNumUnits == (datagramLength + ReassemblyEntry::kUnitSize - 1) / ReassemblyEntry::kUnitSize)
+    {
+        Message *datagram = entry->mMessage;
+
+        mReassemblyList.Dequeue(*datagram);
+        entry->mMessage = NULL;
+
+        counters.mRxReassemblyCompleted++;
+        datagram->SetOffset(datagramLength);
+        HandleDatagram(*datagram, aMessageInfo, aMacSource);
+    }
+
+exit:
+
+    if (error != OT_ERROR_NONE)
     {
         char srcStringBuffer[Mac::Address::kAddressStringSize];
         char dstStringBuffer[Mac::Address::kAddressStringSize];
@@ -1996,7 +2053,7 @@ exit:
             aMacSource.ToString(srcStringBuffer, sizeof(srcStringBuffer)),
             aMacDest.ToString(dstStringBuffer, sizeof(dstStringBuffer)),
             datagramTag,
-            fragmentHeader->GetDatagramOffset(),
+            fragmentOffset,
             datagramLength,
             aMessageInfo.mLinkSecurity ? "yes" : "no"
         );
@@ -2008,15 +2065,171 @@ exit:
     }
 }
 
-void MeshForwarder::ClearReassemblyList(void)
+ReassemblyEntry *MeshForwarder::FindReassemblyEntry(const Mac::Address &aMacSource, uint16_t aDatagramTag,
+                                                    uint16_t aDatagramLength, bool aLinkSecurity)
 {
-    Message *message;
-    Message *next;
+    ReassemblyEntry *entry;
 
-    for (message = mReassemblyList.GetHead(); message; message = next)
+    for (entry = mReassemblyBuckets[aDatagramTag % kNumReassemblyBuckets]; entry; entry = entry->mNext)
+    {
+        // Security Check: only consider reassembly buffers that had the same Security Enabled setting.
+        if (entry->mDatagramTag != aDatagramTag ||
+            entry->mDatagramLength != aDatagramLength ||
+            entry->mLinkSecurity != aLinkSecurity ||
+            entry->mMacSource.mLength != aMacSource.mLength)
+        {
+            continue;
+        }
+
+        if ((aMacSource.mLength == sizeof(aMacSource.mShortAddress)) ?
+            (entry->mMacSource.mShortAddress == aMacSource.mShortAddress) :
+            (memcmp(&entry->mMacSource.mExtAddress, &aMacSource.mExtAddress, sizeof(aMacSource.mExtAddress)) == 0))
+        {
+            break;
+        }
+    }
+
+    return entry;
+}
+
+ReassemblyEntry *MeshForwarder::GetFreeReassemblyEntry(bool aHeaderReceived)
+{
+    ReassemblyEntry *entry = NULL;
+    uint8_t numHeaderless = 0;
+
+    for (int i = 0; i < kNumReassemblyEntries; i++)
+    {
+        if (mReassemblyEntries[i].mInUse && mReassemblyEntries[i].mMessage != NULL &&
+            !mReassemblyEntries[i].mHeaderReceived)
+        {
+            numHeaderless++;
+        }
+    }
+
+    // Prefer an unused entry, then one whose datagram was already delivered, and finally give up on the datagram that
+    // is closest to timing out. Datagrams whose first fragment has not been received may only displace each other
+    // once they hold `kMaxHeaderlessReassemblyEntries` entries, and never a datagram whose first fragment was
+    // received, so that a burst of later fragments with unknown tags cannot flush reassemblies in progress.
+    for (int i = 0; i < kNumReassemblyEntries; i++)
+    {
+        ReassemblyEntry &candidate = mReassemblyEntries[i];
+        bool inProgress = candidate.mInUse && candidate.mMessage != NULL;
+
+        if (!aHeaderReceived &&
+            ((inProgress && candidate.mHeaderReceived) ||
+             (!inProgress && numHeaderless >= kMaxHeaderlessReassemblyEntries)))
+        {
+            continue;
+        }
+
+        if (!candidate.mInUse)
+        {
+            entry = &candidate;
+            break;
+        }
+
+        if (entry == NULL ||
+            (entry->mMessage != NULL && (candidate.mMessage == NULL || candidate.mTimeout < entry->mTimeout)))
+        {
+            entry = &candidate;
+        }
+    }
+
+    return entry;
+}
+
+void MeshForwarder::AddReassemblyEntry(ReassemblyEntry &aEntry, Message &aMessage, const Mac::Address &aMacSource,
+                                       bool aHeaderReceived)
+{
+    ReassemblyEntry **bucket;
+
+    if (aEntry.mInUse)
+    {
+        Message *message = FreeReassemblyEntry(aEntry);
+
+        if (message != NULL)
+        {
+            LogIp6Message(kMessageDrop, *message, NULL, OT_ERROR_NO_BUFS);
+            message->Free();
+        }
+    }
+
+    memset(&aEntry, 0, sizeof(aEntry));
+    aEntry.mMessage = &aMessage;
+    aEntry.mMacSource = aMacSource;
+    aEntry.mDatagramTag = aMessage.GetDatagramTag();
+    aEntry.mDatagramLength = aMessage.GetLength();
+    aEntry.mTimeout = kReassemblyTimeout;
+    aEntry.mInUse = true;
+    aEntry.mLinkSecurity = aMessage.IsLinkSecurityEnabled();
+    aEntry.mHeaderReceived = aHeaderReceived;
+
+    bucket = &mReassemblyBuckets[aEntry.mDatagramTag % kNumReassemblyBuckets];
+    aEntry.mNext = *bucket;
+    *bucket = &aEntry;
+
+    mReassemblyList.Enqueue(aMessage);
+
+    if (!mReassemblyTimer.IsRunning())
+    {
+        mReassemblyTimer.Start(kStateUpdatePeriod);
+    }
+}
+
+Message *MeshForwarder::FreeReassemblyEntry(ReassemblyEntry &aEntry)
+{
+    Message *message = aEntry.mMessage;
+    ReassemblyEntry **prev = &mReassemblyBuckets[aEntry.mDatagramTag % kNumReassemblyBuckets];
+
+    while (*prev != &aEntry)
+    {
+        prev = &(*prev)->mNext;
+    }
+
+    *prev = aEntry.mNext;
+    aEntry.mNext = NULL;
+    aEntry.mMessage = NULL;
+    aEntry.mInUse = false;
+
+    if (message != NULL)
     {
-        next = message->GetNext();
         mReassemblyList.Dequeue(*message);
+    }
+
+    return message;
+}
+
+bool MeshForwarder::MarkFragmentReceived(ReassemblyEntry &aEntry, uint16_t aOffset, uint16_t aEnd)
+{
+    bool rval = false;
+
+    // Only the last fragment of a datagram may end within a unit.
+    for (uint16_t unit = aOffset / ReassemblyEntry::kUnitSize;
+         unit < (aEnd + ReassemblyEntry::kUnitSize - 1) / ReassemblyEntry::kUnitSize; unit++)
+    {
+        uint8_t mask = static_cast<uint8_t>(0x80 >> (unit % 8));
+
+        if ((aEntry.mReceived[unit / 8] & mask) == 0)
+        {
+            aEntry.mReceived[unit / 8] |= mask;
+            aEntry.mNumUnits++;
+            rval = true;
+        }
+    }
+
+    return rval;
+}
+
+void MeshForwarder::ClearReassemblyList(void)
+{
+    for (int i = 0; i < kNumReassemblyEntries; i++)
+    {
+        Message *message;
+
+        if (!mReassemblyEntries[i].mInUse || (message = FreeReassemblyEntry(mReassemblyEntries[i])) == NULL)
+        {
+            continue;
+        }
 
         LogIp6Message(kMessageDrop, *message, NULL, OT_ERROR_NO_FRAME_RECEIVED);
 
@@ -2031,21 +2244,26 @@ void MeshForwarder::HandleReassemblyTimer(void *aContext)
 
 void MeshForwarder::HandleReassemblyTimer()
 {
-    Message *next = NULL;
-    uint8_t timeout;
+    bool inUse = false;
 
-    for (Message *message = mReassemblyList.GetHead(); message; message = next)
+    for (int i = 0; i < kNumReassemblyEntries; i++)
     {
-        next = message->GetNext();
-        timeout = message->GetTimeout();
+        ReassemblyEntry &entry = mReassemblyEntries[i];
+        Message *message;
 
-        if (timeout > 0)
+        if (!entry.mInUse)
         {
-            message->SetTimeout(timeout - 1);
+            continue;
         }
-        else
+
+        if (entry.mTimeout > 0)
+        {
+            entry.mTimeout--;
+            inUse = true;
+        }
+        else if ((message = FreeReassemblyEntry(entry)) != NULL)
         {
-            mReassemblyList.Dequeue(*message);
+            mNetif.GetMac().GetCounters().mRxReassemblyTimeout++;
 
             LogIp6Message(kMessageDrop, *message, NULL, OT_ERROR_REASSEMBLY_TIMEOUT);
 
@@ -2053,7 +2271,7 @@ void MeshForwarder::HandleReassemblyTimer()
         }
     }
 
-    if (mReassemblyList.GetHead() != NULL)
+    if (inUse)
     {
         mReassemblyTimer.Start(kStateUpdatePeriod);
     }
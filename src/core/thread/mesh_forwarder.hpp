@@ -47,11 +47,23 @@
 #include "thread/src_match_controller.hpp"
 #include "thread/topology.hpp"
 
+#if OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_HEADERLESS_ENTRIES > OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_ENTRIES
+#error "OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_HEADERLESS_ENTRIES must not exceed OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_ENTRIES"
+#endif
+
 namespace ot {
 
 enum
 {
-    kReassemblyTimeout = OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT,
+    kReassemblyTimeout    = OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_TIMEOUT,
+    kNumReassemblyEntries = OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_ENTRIES,
+    kMaxHeaderlessReassemblyEntries = OPENTHREAD_CONFIG_6LOWPAN_REASSEMBLY_HEADERLESS_ENTRIES,
+    kNumReassemblyBuckets = 8,  ///< Number of lookup buckets for reassembly entries, keyed by datagram tag.
+#if OPENTHREAD_FTD
+    kNumIndirectMessageRefs = OPENTHREAD_CONFIG_NUM_INDIRECT_MESSAGE_REFS,
+#else
+    kNumIndirectMessageRefs = 1,  ///< An MTD has no children.
+#endif
 };
 
 class MleRouter;
@@ -66,6 +78,37 @@ struct ThreadMessageInfo;
  * @{
  */
 
+/**
+ * This class represents a datagram that is being reassembled from 6LoWPAN fragments.
+ *
+ * Fragments may be received in any order and more than once, the entry tracks which 8-octet units of the datagram
+ * have been received. Once the datagram is delivered the entry is kept until it times out, so that fragments that
+ * are received again are recognized as duplicates.
+ *
+ */
+class ReassemblyEntry
+{
+public:
+    enum
+    {
+        kUnitSize = 8,   ///< Fragment offsets are expressed in units of 8 octets.
+        kMaxUnits = (Ip6::Ip6::kMaxDatagramLength + kUnitSize - 1) / kUnitSize,
+    };
+
+    Message         *mMessage;          ///< The reassembly buffer, or NULL once the datagram has been delivered.
+    ReassemblyEntry *mNext;             ///< The next entry in the same lookup bucket.
+    Mac::Address     mMacSource;        ///< The MAC (or mesh) source address of the fragments.
+    uint16_t         mDatagramTag;      ///< The datagram tag.
+    uint16_t         mDatagramLength;   ///< The datagram size.
+    uint16_t         mNextOffset;       ///< The datagram offset following the last received fragment.
+    uint8_t          mTimeout;          ///< The remaining reassembly time in seconds.
+    uint8_t          mNumUnits;         ///< The number of units received.
+    bool             mInUse;            ///< TRUE if the entry is in use.
+    bool             mLinkSecurity;     ///< TRUE if the fragments were received with link security.
+    bool             mHeaderReceived;   ///< TRUE if the first fragment has been received.
+    uint8_t          mReceived[BitVectorBytes(kMaxUnits)];  ///< The bit vector of received units.
+};
+
 /**
  * This class implements mesh forwarding within Thread.
  *
@@ -276,6 +319,13 @@ private:
     otError HandleDatagram(Message &aMessage, const ThreadMessageInfo &aMessageInfo,
                            const Mac::Address &aMacSource);
     void ClearReassemblyList(void);
+    ReassemblyEntry *FindReassemblyEntry(const Mac::Address &aMacSource, uint16_t aDatagramTag,
+                                         uint16_t aDatagramLength, bool aLinkSecurity);
+    ReassemblyEntry *GetFreeReassemblyEntry(bool aHeaderReceived);
+    void AddReassemblyEntry(ReassemblyEntry &aEntry, Message &aMessage, const Mac::Address &aMacSource,
+                            bool aHeaderReceived);
+    Message *FreeReassemblyEntry(ReassemblyEntry &aEntry);
+    bool MarkFragmentReceived(ReassemblyEntry &aEntry, uint16_t aOffset, uint16_t aEnd);
 
     static void HandleReceivedFrame(void *aContext, Mac::Frame &aFrame);
     void HandleReceivedFrame(Mac::Frame &aFrame);
@@ -306,7 +356,11 @@ private:
     Timer mReassemblyTimer;
 
     PriorityQueue mSendQueue;
+    IndirectMessageRef mIndirectMessageRefs[kNumIndirectMessageRefs];
+    IndirectMessageRefPool mIndirectMessageRefPool;
     MessageQueue mReassemblyList;
+    ReassemblyEntry mReassemblyEntries[kNumReassemblyEntries];
+    ReassemblyEntry *mReassemblyBuckets[kNumReassemblyBuckets];
     MessageQueue mResolvingQueue;
     uint16_t mFragTag;
     uint16_t mMessageNextOffset;
@@ -301,6 +301,7 @@ otError Mle::Restore(void)
     memcpy(&mMeshLocal64.GetAddress().mFields.m8[OT_IP6_PREFIX_SIZE],
            networkInfo.mMlIid,
            OT_IP6_ADDRESS_SIZE - OT_IP6_PREFIX_SIZE);
+    mNetif.SetStateChangedFlags(OT_IP6_ML_ADDR_CHANGED);
 
     if (networkInfo.mRloc16 == Mac::kShortAddrInvalid)
     {
@@ -693,6 +694,8 @@ const uint8_t *Mle::GetMeshLocalPrefix(void) const
 
 otError Mle::SetMeshLocalPrefix(const uint8_t *aMeshLocalPrefix)
 {
+    bool subscribed;
+
     if (memcmp(mMeshLocal64.GetAddress().mFields.m8, aMeshLocalPrefix, 8) == 0)
     {
         ExitNow();
@@ -702,6 +705,10 @@ otError Mle::SetMeshLocalPrefix(const uint8_t *aMeshLocalPrefix)
     mNetif.RemoveUnicastAddress(mMeshLocal64);
     mNetif.RemoveUnicastAddress(mMeshLocal16);
 
+    // The all Thread nodes addresses are unsubscribed while their prefix changes so they are re-hashed.
+    subscribed = (mNetif.UnsubscribeMulticast(mLinkLocalAllThreadNodes) == OT_ERROR_NONE);
+    mNetif.UnsubscribeMulticast(mRealmLocalAllThreadNodes);
+
     memcpy(mMeshLocal64.GetAddress().mFields.m8, aMeshLocalPrefix, 8);
     memcpy(mMeshLocal16.GetAddress().mFields.m8, mMeshLocal64.GetAddress().mFields.m8, 8);
 
@@ -711,6 +718,12 @@ otError Mle::SetMeshLocalPrefix(const uint8_t *aMeshLocalPrefix)
     mRealmLocalAllThreadNodes.GetAddress().mFields.m8[3] = 64;
     memcpy(mRealmLocalAllThreadNodes.GetAddress().mFields.m8 + 4, mMeshLocal64.GetAddress().mFields.m8, 8);
 
+    if (subscribed)
+    {
+        mNetif.SubscribeMulticast(mLinkLocalAllThreadNodes);
+        mNetif.SubscribeMulticast(mRealmLocalAllThreadNodes);
+    }
+
     // Add the address back into the table.
     mNetif.AddUnicastAddress(mMeshLocal64);
 
@@ -1897,9 +1910,6 @@ otError Mle::SendMessage(Message &aMessage, const Ip6::Address &aDestination)
     uint8_t nonce[13];
     uint8_t tag[4];
     uint8_t tagLength;
-    Crypto::AesCcm aesCcm;
-    uint8_t buf[64];
-    uint16_t length;
     Ip6::MessageInfo messageInfo;
 
     aMessage.Read(0, sizeof(header), &header);
@@ -1918,26 +1928,19 @@ otError Mle::SendMessage(Message &aMessage, const Ip6::Address &aDestination)
                       Mac::Frame::kSecEncMic32,
                       nonce);
 
-        aesCcm.SetKey(mNetif.GetKeyManager().GetCurrentMleKey(), 16);
-        aesCcm.Init(16 + 16 + header.GetHeaderLength(), aMessage.GetLength() - (header.GetLength() - 1),
-                    sizeof(tag), nonce, sizeof(nonce));
-
-        aesCcm.Header(&mLinkLocal64.GetAddress(), sizeof(mLinkLocal64.GetAddress()));
-        aesCcm.Header(&aDestination, sizeof(aDestination));
-        aesCcm.Header(header.GetBytes() + 1, header.GetHeaderLength());
+        mAesCcm.SetKey(mNetif.GetKeyManager().GetCurrentMleKey(), 16);
+        mAesCcm.Init(16 + 16 + header.GetHeaderLength(), aMessage.GetLength() - (header.GetLength() - 1),
+                     sizeof(tag), nonce, sizeof(nonce));
 
-        aMessage.SetOffset(header.GetLength() - 1);
+        mAesCcm.Header(&mLinkLocal64.GetAddress(), sizeof(mLinkLocal64.GetAddress()));
+        mAesCcm.Header(&aDestination, sizeof(aDestination));
+        mAesCcm.Header(header.GetBytes() + 1, header.GetHeaderLength());
 
-        while (aMessage.GetOffset() < aMessage.GetLength())
-        {
-            length = aMessage.Read(aMessage.GetOffset(), sizeof(buf), buf);
-            aesCcm.Payload(buf, buf, length, true);
-            aMessage.Write(aMessage.GetOffset(), length, buf);
-            aMessage.MoveOffset(length);
-        }
+        mAesCcm.Payload(aMessage, header.GetLength() - 1, aMessage.GetLength() - (header.GetLength() - 1), true);
+        aMessage.SetOffset(aMessage.GetLength());
 
         tagLength = sizeof(tag);
-        aesCcm.Finalize(tag, &tagLength);
+        mAesCcm.Finalize(tag, &tagLength);
         SuccessOrExit(error = aMessage.Append(tag, tagLength));
 
         mNetif.GetKeyManager().IncrementMleFrameCounter();
@@ -2002,10 +2005,6 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
     uint16_t messageTagLength;
     uint8_t nonce[13];
     Mac::ExtAddress macAddr;
-    Crypto::AesCcm aesCcm;
-    uint16_t mleOffset;
-    uint8_t buf[64];
-    uint16_t length;
     uint8_t tag[4];
     uint8_t tagLength;
     uint8_t command;
@@ -2061,25 +2060,16 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
     macAddr.Set(aMessageInfo.GetPeerAddr());
     GenerateNonce(macAddr, frameCounter, Mac::Frame::kSecEncMic32, nonce);
 
-    aesCcm.SetKey(mleKey, 16);
-    aesCcm.Init(sizeof(aMessageInfo.GetPeerAddr()) + sizeof(aMessageInfo.GetSockAddr()) + header.GetHeaderLength(),
-                aMessage.GetLength() - aMessage.GetOffset(), sizeof(messageTag), nonce, sizeof(nonce));
-    aesCcm.Header(&aMessageInfo.GetPeerAddr(), sizeof(aMessageInfo.GetPeerAddr()));
-    aesCcm.Header(&aMessageInfo.GetSockAddr(), sizeof(aMessageInfo.GetSockAddr()));
-    aesCcm.Header(header.GetBytes() + 1, header.GetHeaderLength());
-
-    mleOffset = aMessage.GetOffset();
-
-    while (aMessage.GetOffset() < aMessage.GetLength())
-    {
-        length = aMessage.Read(aMessage.GetOffset(), sizeof(buf), buf);
-        aesCcm.Payload(buf, buf, length, false);
-        aMessage.Write(aMessage.GetOffset(), length, buf);
-        aMessage.MoveOffset(length);
-    }
+    mAesCcm.SetKey(mleKey, 16);
+    mAesCcm.Init(sizeof(aMessageInfo.GetPeerAddr()) + sizeof(aMessageInfo.GetSockAddr()) + header.GetHeaderLength(),
+                 aMessage.GetLength() - aMessage.GetOffset(), sizeof(messageTag), nonce, sizeof(nonce));
+    mAesCcm.Header(&aMessageInfo.GetPeerAddr(), sizeof(aMessageInfo.GetPeerAddr()));
+    mAesCcm.Header(&aMessageInfo.GetSockAddr(), sizeof(aMessageInfo.GetSockAddr()));
+    mAesCcm.Header(header.GetBytes() + 1, header.GetHeaderLength());
+    mAesCcm.Payload(aMessage, aMessage.GetOffset(), aMessage.GetLength() - aMessage.GetOffset(), false);
 
     tagLength = sizeof(tag);
-    aesCcm.Finalize(tag, &tagLength);
+    mAesCcm.Finalize(tag, &tagLength);
     VerifyOrExit(messageTagLength == tagLength && memcmp(messageTag, tag, tagLength) == 0);
 
     if (keySequence > mNetif.GetKeyManager().GetCurrentKeySequence())
@@ -2087,8 +2077,6 @@ void Mle::HandleUdpReceive(Message &aMessage, const Ip6::MessageInfo &aMessageIn
         mNetif.GetKeyManager().SetCurrentKeySequence(keySequence);
     }
 
-    aMessage.SetOffset(mleOffset);
-
     aMessage.Read(aMessage.GetOffset(), sizeof(command), &command);
     aMessage.MoveOffset(sizeof(command));
 
@@ -38,6 +38,7 @@
 
 #include "common/encoding.hpp"
 #include "common/timer.hpp"
+#include "crypto/aes_ccm.hpp"
 #include "mac/mac.hpp"
 #include "meshcop/joiner_router.hpp"
 #include "net/udp6.hpp"
@@ -1411,6 +1412,7 @@ private:
     Router mParentCandidate;
 
     Ip6::UdpSocket mSocket;
+    Crypto::AesCcm mAesCcm;
     uint32_t mTimeout;
 
     Tasklet mSendChildUpdateRequest;
@@ -81,7 +81,8 @@ MleRouter::MleRouter(ThreadNetif &aThreadNetif):
     mIsRouterRestoringChildren(false),
     mPreviousPartitionId(0),
     mRouterSelectionJitter(kRouterSelectionJitter),
-    mRouterSelectionJitterTimeout(0)
+    mRouterSelectionJitterTimeout(0),
+    mNeighborIndexValid(false)
 {
     mDeviceMode |= ModeTlv::kModeFFD | ModeTlv::kModeFullNetworkData;
 
@@ -182,6 +183,7 @@ uint8_t MleRouter::AllocateRouterId(uint8_t aRouterId)
     router->SetAllocated(true);
     router->SetLastHeard(Timer::GetNow());
     router->ClearExtAddress();
+    InvalidateNeighborIndex();
 
     // bump sequence number
     mRouterIdSequence++;
@@ -298,6 +300,7 @@ otError MleRouter::BecomeLeader(void)
     SetRouterId(routerId);
 
     router->SetExtAddress(*mNetif.GetMac().GetExtAddress());
+    InvalidateNeighborIndex();
     mAdvertiseTimer.Stop();
     mNetif.GetAddressResolver().Clear();
 
@@ -712,6 +715,7 @@ otError MleRouter::HandleLinkRequest(const Message &aMessage, const Ip6::Message
                     static_cast<const ThreadMessageInfo *>(aMessageInfo.GetLinkInfo());
 
                 neighbor->SetExtAddress(macAddr);
+                InvalidateNeighborIndex();
                 neighbor->GetLinkInfo().Clear();
                 neighbor->GetLinkInfo().AddRss(mNetif.GetMac().GetNoiseFloor(), threadMessageInfo->mRss);
                 neighbor->ResetLinkFailures();
@@ -1007,6 +1011,7 @@ otError MleRouter::HandleLinkAccept(const Message &aMessage, const Ip6::MessageI
 
     // finish link synchronization
     router->SetExtAddress(macAddr);
+    InvalidateNeighborIndex();
     router->SetRloc16(sourceAddress.GetRloc16());
     router->SetLinkFrameCounter(linkFrameCounter.GetFrameCounter());
     router->SetMleFrameCounter(mleFrameCounter.GetFrameCounter());
@@ -1441,6 +1446,7 @@ otError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::Messa
         else if ((mDeviceMode & ModeTlv::kModeFFD) && (router->GetState() != Neighbor::kStateValid))
         {
             router->SetExtAddress(macAddr);
+            InvalidateNeighborIndex();
             router->GetLinkInfo().Clear();
             router->GetLinkInfo().AddRss(mNetif.GetMac().GetNoiseFloor(), threadMessageInfo->mRss);
             router->ResetLinkFailures();
@@ -1488,6 +1494,7 @@ otError MleRouter::HandleAdvertisement(const Message &aMessage, const Ip6::Messa
         if (router->GetState() != Neighbor::kStateValid)
         {
             router->SetExtAddress(macAddr);
+            InvalidateNeighborIndex();
             router->GetLinkInfo().Clear();
             router->GetLinkInfo().AddRss(mNetif.GetMac().GetNoiseFloor(), threadMessageInfo->mRss);
             router->ResetLinkFailures();
@@ -1707,10 +1714,12 @@ otError MleRouter::HandleParentRequest(const Message &aMessage, const Ip6::Messa
     {
         VerifyOrExit((child = NewChild()) != NULL);
 
+        mNetif.GetMeshForwarder().ClearChildIndirectMessages(*child);
         memset(child, 0, sizeof(*child));
 
         // MAC Address
         child->SetExtAddress(macAddr);
+        InvalidateNeighborIndex();
         child->GetLinkInfo().Clear();
         child->GetLinkInfo().AddRss(mNetif.GetMac().GetNoiseFloor(), threadMessageInfo->mRss);
         child->ResetLinkFailures();
@@ -2764,6 +2773,7 @@ otError MleRouter::SendChildIdResponse(Child *aChild)
 
         // allocate Child ID
         aChild->SetRloc16(mNetif.GetMac().GetShortAddress() | mNextChildId);
+        InvalidateNeighborIndex();
     }
 
     SuccessOrExit(error = AppendAddress16(*message, aChild->GetRloc16()));
@@ -2831,12 +2841,10 @@ otError MleRouter::SendChildUpdateRequest(Child *aChild)
 
     if (!aChild->IsRxOnWhenIdle())
     {
-        uint8_t childIndex = mNetif.GetMle().GetChildIndex(*aChild);
-
         // No need to send "Child Update Request" to the sleepy child if there is one already queued for it.
-        for (message = mNetif.GetMeshForwarder().GetSendQueue().GetHead(); message; message = message->GetNext())
+        for (const IndirectMessageRef *ref = aChild->GetIndirectMessageQueue().GetHead(); ref; ref = ref->GetNext())
         {
-            if (message->GetChildMask(childIndex) && message->GetSubType() == Message::kSubTypeMleChildUpdateRequest)
+            if (ref->GetMessage().GetSubType() == Message::kSubTypeMleChildUpdateRequest)
             {
                 ExitNow();
             }
@@ -3010,29 +3018,12 @@ exit:
 
 Child *MleRouter::GetChild(uint16_t aAddress)
 {
-    for (int i = 0; i < mMaxChildrenAllowed; i++)
-    {
-        if (mChildren[i].IsStateValidOrRestoring() && mChildren[i].GetRloc16() == aAddress)
-        {
-            return &mChildren[i];
-        }
-    }
-
-    return NULL;
+    return LookupChild(aAddress);
 }
 
 Child *MleRouter::GetChild(const Mac::ExtAddress &aAddress)
 {
-    for (int i = 0; i < mMaxChildrenAllowed; i++)
-    {
-        if (mChildren[i].IsStateValidOrRestoring() &&
-            memcmp(&mChildren[i].GetExtAddress(), &aAddress, sizeof(aAddress)) == 0)
-        {
-            return &mChildren[i];
-        }
-    }
-
-    return NULL;
+    return LookupChild(aAddress);
 }
 
 Child *MleRouter::GetChild(const Mac::Address &aAddress)
@@ -3176,24 +3167,19 @@ Neighbor *MleRouter::GetNeighbor(uint16_t aAddress)
 
     case OT_DEVICE_ROLE_ROUTER:
     case OT_DEVICE_ROLE_LEADER:
-        for (int i = 0; i < mMaxChildrenAllowed; i++)
+        if ((rval = LookupChild(aAddress)) != NULL)
         {
-            if (mChildren[i].IsStateValidOrRestoring() && mChildren[i].GetRloc16() == aAddress)
-            {
-                ExitNow(rval = &mChildren[i]);
-            }
+            ExitNow();
         }
 
-        for (int i = 0; i <= kMaxRouterId; i++)
+        // Router RLOC16s map directly onto the router table.
+        if (GetChildId(aAddress) == 0 && GetRouterId(aAddress) <= kMaxRouterId && GetRouterId(aAddress) != mRouterId)
         {
-            if (i == mRouterId)
-            {
-                continue;
-            }
+            Router &router = mRouters[GetRouterId(aAddress)];
 
-            if (mRouters[i].GetState() == Neighbor::kStateValid && mRouters[i].GetRloc16() == aAddress)
+            if (router.GetState() == Neighbor::kStateValid && router.GetRloc16() == aAddress)
             {
-                ExitNow(rval = &mRouters[i]);
+                ExitNow(rval = &router);
             }
         }
 
@@ -3220,27 +3206,9 @@ Neighbor *MleRouter::GetNeighbor(const Mac::ExtAddress &aAddress)
 
     case OT_DEVICE_ROLE_ROUTER:
     case OT_DEVICE_ROLE_LEADER:
-        for (int i = 0; i < mMaxChildrenAllowed; i++)
+        if ((rval = LookupChild(aAddress)) != NULL || (rval = LookupRouter(aAddress)) != NULL)
         {
-            if (mChildren[i].IsStateValidOrRestoring() &&
-                memcmp(&mChildren[i].GetExtAddress(), &aAddress, sizeof(aAddress)) == 0)
-            {
-                ExitNow(rval = &mChildren[i]);
-            }
-        }
-
-        for (int i = 0; i <= kMaxRouterId; i++)
-        {
-            if (i == mRouterId)
-            {
-                continue;
-            }
-
-            if (mRouters[i].GetState() == Neighbor::kStateValid &&
-                memcmp(&mRouters[i].GetExtAddress(), &aAddress, sizeof(aAddress)) == 0)
-            {
-                ExitNow(rval = &mRouters[i]);
-            }
+            ExitNow();
         }
 
         if (mParentRequestState != kParentIdle)
@@ -3276,6 +3244,155 @@ Neighbor *MleRouter::GetNeighbor(const Mac::Address &aAddress)
     return rval;
 }
 
+uint8_t MleRouter::HashExtAddress(const Mac::ExtAddress &aAddress)
+{
+    uint8_t hash = 0;
+
+    for (unsigned i = 0; i < sizeof(aAddress.m8); i++)
+    {
+        hash = static_cast<uint8_t>((hash << 3) + (hash >> 5)) ^ aAddress.m8[i];
+    }
+
+    return hash;
+}
+
+bool MleRouter::IsExtAddressSet(const Mac::ExtAddress &aAddress)
+{
+    bool rval = false;
+
+    for (unsigned i = 0; i < sizeof(aAddress.m8); i++)
+    {
+        if (aAddress.m8[i] != 0)
+        {
+            ExitNow(rval = true);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+void MleRouter::AddToNeighborIndex(uint8_t *aIndex, uint16_t aIndexSize, uint16_t aHash, uint8_t aEntry)
+{
+    uint16_t i = aHash % aIndexSize;
+
+    while (aIndex[i] != kNeighborIndexEmpty)
+    {
+        i = (i + 1) % aIndexSize;
+    }
+
+    aIndex[i] = aEntry;
+}
+
+void MleRouter::UpdateNeighborIndex(void)
+{
+    VerifyOrExit(!mNeighborIndexValid);
+
+    memset(mChildRloc16Index, kNeighborIndexEmpty, sizeof(mChildRloc16Index));
+    memset(mChildExtAddressIndex, kNeighborIndexEmpty, sizeof(mChildExtAddressIndex));
+    memset(mRouterExtAddressIndex, kNeighborIndexEmpty, sizeof(mRouterExtAddressIndex));
+
+    // Every slot holding an address is indexed regardless of its state, state is checked on lookup.
+    for (uint8_t i = 0; i < kMaxChildren; i++)
+    {
+        if (mChildren[i].GetRloc16() != 0)
+        {
+            AddToNeighborIndex(mChildRloc16Index, kChildIndexSize, GetChildId(mChildren[i].GetRloc16()), i);
+        }
+
+        if (IsExtAddressSet(mChildren[i].GetExtAddress()))
+        {
+            AddToNeighborIndex(mChildExtAddressIndex, kChildIndexSize, HashExtAddress(mChildren[i].GetExtAddress()),
+                               i);
+        }
+    }
+
+    for (uint8_t i = 0; i <= kMaxRouterId; i++)
+    {
+        if (IsExtAddressSet(mRouters[i].GetExtAddress()))
+        {
+            AddToNeighborIndex(mRouterExtAddressIndex, kRouterIndexSize, HashExtAddress(mRouters[i].GetExtAddress()),
+                               i);
+        }
+    }
+
+    mNeighborIndexValid = true;
+
+exit:
+    return;
+}
+
+Child *MleRouter::LookupChild(uint16_t aRloc16)
+{
+    Child *rval = NULL;
+
+    VerifyOrExit(aRloc16 != 0 && aRloc16 != Mac::kShortAddrBroadcast && aRloc16 != Mac::kShortAddrInvalid);
+
+    UpdateNeighborIndex();
+
+    for (uint16_t i = GetChildId(aRloc16) % kChildIndexSize;
+         mChildRloc16Index[i] != kNeighborIndexEmpty;
+         i = (i + 1) % kChildIndexSize)
+    {
+        Child &child = mChildren[mChildRloc16Index[i]];
+
+        if (mChildRloc16Index[i] < mMaxChildrenAllowed && child.IsStateValidOrRestoring() &&
+            child.GetRloc16() == aRloc16)
+        {
+            ExitNow(rval = &child);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+Child *MleRouter::LookupChild(const Mac::ExtAddress &aAddress)
+{
+    Child *rval = NULL;
+
+    UpdateNeighborIndex();
+
+    for (uint16_t i = HashExtAddress(aAddress) % kChildIndexSize;
+         mChildExtAddressIndex[i] != kNeighborIndexEmpty;
+         i = (i + 1) % kChildIndexSize)
+    {
+        Child &child = mChildren[mChildExtAddressIndex[i]];
+
+        if (mChildExtAddressIndex[i] < mMaxChildrenAllowed && child.IsStateValidOrRestoring() &&
+            memcmp(&child.GetExtAddress(), &aAddress, sizeof(aAddress)) == 0)
+        {
+            ExitNow(rval = &child);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+Router *MleRouter::LookupRouter(const Mac::ExtAddress &aAddress)
+{
+    Router *rval = NULL;
+
+    UpdateNeighborIndex();
+
+    for (uint16_t i = HashExtAddress(aAddress) % kRouterIndexSize;
+         mRouterExtAddressIndex[i] != kNeighborIndexEmpty;
+         i = (i + 1) % kRouterIndexSize)
+    {
+        Router &router = mRouters[mRouterExtAddressIndex[i]];
+
+        if (mRouterExtAddressIndex[i] != mRouterId && router.GetState() == Neighbor::kStateValid &&
+            memcmp(&router.GetExtAddress(), &aAddress, sizeof(aAddress)) == 0)
+        {
+            ExitNow(rval = &router);
+        }
+    }
+
+exit:
+    return rval;
+}
+
 Neighbor *MleRouter::GetNeighbor(const Ip6::Address &aAddress)
 {
     Mac::Address macaddr;
@@ -3528,10 +3645,12 @@ otError MleRouter::RestoreChildren(void)
         VerifyOrExit(length >= sizeof(childInfo), error = OT_ERROR_PARSE);
 
         VerifyOrExit((child = NewChild()) != NULL, error = OT_ERROR_NO_BUFS);
+        mNetif.GetMeshForwarder().ClearChildIndirectMessages(*child);
         memset(child, 0, sizeof(*child));
 
         child->SetExtAddress(*static_cast<Mac::ExtAddress *>(&childInfo.mExtAddress));
         child->SetRloc16(childInfo.mRloc16);
+        InvalidateNeighborIndex();
         child->SetTimeout(childInfo.mTimeout);
         child->SetDeviceMode(childInfo.mMode);
         child->SetState(Neighbor::kStateRestored);
@@ -3595,6 +3714,9 @@ otError MleRouter::RefreshStoredChildren(void)
 {
     otError error = OT_ERROR_NONE;
 
+    // Replace the stored children as one change set where the platform supports it.
+    bool changeSet = (otPlatSettingsBeginChange(mNetif.GetInstance()) == OT_ERROR_NONE);
+
     SuccessOrExit(error = otPlatSettingsDelete(mNetif.GetInstance(), Settings::kKeyChildInfo, -1));
 
     for (uint8_t i = 0; i < kMaxChildren; i++)
@@ -3606,6 +3728,19 @@ otError MleRouter::RefreshStoredChildren(void)
     }
 
 exit:
+
+    if (changeSet)
+    {
+        if (error == OT_ERROR_NONE)
+        {
+            error = otPlatSettingsCommitChange(mNetif.GetInstance());
+        }
+        else
+        {
+            IgnoreReturnValue(otPlatSettingsAbandonChange(mNetif.GetInstance()));
+        }
+    }
+
     return error;
 }
 
@@ -3987,6 +4122,7 @@ void MleRouter::HandleAddressSolicitResponse(Coap::Header *aHeader, Message *aMe
     // Keep link to the parent in order to response to Parent Requests before new link is established.
     mRouters[GetRouterId(mParent.GetRloc16())] = mParent;
     mRouters[GetRouterId(mParent.GetRloc16())].SetAllocated(true);
+    InvalidateNeighborIndex();
 
     // send link request
     SendLinkRequest(NULL);
@@ -4113,6 +4249,7 @@ void MleRouter::HandleAddressSolicit(Coap::Header &aHeader, Message &aMessage, c
     if (router != NULL)
     {
         router->SetExtAddress(*macAddr64Tlv.GetMacAddr());
+        InvalidateNeighborIndex();
     }
     else
     {
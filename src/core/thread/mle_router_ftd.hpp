@@ -49,6 +49,10 @@
 #include "thread/thread_tlvs.hpp"
 #include "thread/topology.hpp"
 
+#if OPENTHREAD_CONFIG_MAX_CHILDREN > 255
+#error "OPENTHREAD_CONFIG_MAX_CHILDREN must not exceed 255, the neighbor index stores 8-bit child table indices"
+#endif
+
 namespace ot {
 namespace Mle {
 
@@ -671,6 +675,9 @@ private:
         kDiscoveryMaxJitter = 250u,  ///< Maximum jitter time used to delay Discovery Responses in milliseconds.
         kStateUpdatePeriod = 1000u,  ///< State update period in milliseconds.
         kUnsolicitedDataResponseJitter = 500u,  ///< Maximum delay before unsolicited Data Response in milliseconds.
+        kChildIndexSize = 2 * kMaxChildren,     ///< Child index size, kept at most half full.
+        kRouterIndexSize = 2 * (kMaxRouterId + 1),  ///< Router index size, kept at most half full.
+        kNeighborIndexEmpty = 0xff,             ///< Marks an unused neighbor index entry, never a table index.
     };
 
     otError AppendConnectivity(Message &aMessage);
@@ -742,6 +749,15 @@ private:
     Child *FindChild(uint16_t aChildId);
     Child *FindChild(const Mac::ExtAddress &aMacAddr);
 
+    static uint8_t HashExtAddress(const Mac::ExtAddress &aAddress);
+    static bool IsExtAddressSet(const Mac::ExtAddress &aAddress);
+    static void AddToNeighborIndex(uint8_t *aIndex, uint16_t aIndexSize, uint16_t aHash, uint8_t aEntry);
+    void InvalidateNeighborIndex(void) { mNeighborIndexValid = false; }
+    void UpdateNeighborIndex(void);
+    Child *LookupChild(uint16_t aRloc16);
+    Child *LookupChild(const Mac::ExtAddress &aAddress);
+    Router *LookupRouter(const Mac::ExtAddress &aAddress);
+
     void SetChildStateToValid(Child *aChild);
     bool HasChildren(void);
     void RemoveChildren(void);
@@ -789,6 +805,12 @@ private:
     uint8_t mRouterSelectionJitter;         ///< The variable to save the assigned jitter value.
     uint8_t mRouterSelectionJitterTimeout;  ///< The Timeout prior to request/release Router ID.
 
+    // Open-addressed indices of child and router slots, rebuilt lazily after a neighbor address changes.
+    uint8_t mChildRloc16Index[kChildIndexSize];
+    uint8_t mChildExtAddressIndex[kChildIndexSize];
+    uint8_t mRouterExtAddressIndex[kRouterIndexSize];
+    bool mNeighborIndexValid;
+
 #if OPENTHREAD_CONFIG_ENABLE_STEERING_DATA_SET_OOB
     MeshCoP::SteeringDataTlv mSteeringData;
 #endif // OPENTHREAD_CONFIG_ENABLE_STEERING_DATA_SET_OOB
@@ -73,23 +73,21 @@ void LeaderBase::Reset(void)
     mVersion = static_cast<uint8_t>(otPlatRandomGet());
     mStableVersion = static_cast<uint8_t>(otPlatRandomGet());
     mLength = 0;
+    InvalidateContexts();
     mNetif.SetStateChangedFlags(OT_THREAD_NETDATA_UPDATED);
 }
 
-otError LeaderBase::GetContext(const Ip6::Address &aAddress, Lowpan::Context &aContext)
+void LeaderBase::UpdateContexts(void)
 {
     PrefixTlv *prefix;
     ContextTlv *contextTlv;
+    ContextEntry *entry;
+    uint8_t index;
 
-    aContext.mPrefixLength = 0;
+    VerifyOrExit(!mContextsValid);
 
-    if (PrefixMatch(mNetif.GetMle().GetMeshLocalPrefix(), aAddress.mFields.m8, 64) >= 0)
-    {
-        aContext.mPrefix = mNetif.GetMle().GetMeshLocalPrefix();
-        aContext.mPrefixLength = 64;
-        aContext.mContextId = 0;
-        aContext.mCompressFlag = true;
-    }
+    memset(mContextIndex, kInvalidContextIndex, sizeof(mContextIndex));
+    mNumContexts = 0;
 
     for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
          cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
@@ -101,79 +99,137 @@ otError LeaderBase::GetContext(const Ip6::Address &aAddress, Lowpan::Context &aC
         }
 
         prefix = static_cast<PrefixTlv *>(cur);
-
-        if (PrefixMatch(prefix->GetPrefix(), aAddress.mFields.m8, prefix->GetPrefixLength()) < 0)
-        {
-            continue;
-        }
-
         contextTlv = FindContext(*prefix);
 
-        if (contextTlv == NULL)
+        // A Context ID identifies a single prefix, the first one in the Network Data is used.
+        if (contextTlv == NULL || mContextIndex[contextTlv->GetContextId()] != kInvalidContextIndex ||
+            prefix->GetPrefixLength() > sizeof(entry->mPrefix) * CHAR_BIT)
         {
             continue;
         }
 
-        if (prefix->GetPrefixLength() > aContext.mPrefixLength)
+        // Keep the entries sorted by decreasing prefix length, and prefixes of equal length in Network Data order,
+        // so that the first matching entry is the longest match.
+        for (index = mNumContexts; index > 0 && mContexts[index - 1].mPrefixLength < prefix->GetPrefixLength();
+             index--)
         {
-            aContext.mPrefix = prefix->GetPrefix();
-            aContext.mPrefixLength = prefix->GetPrefixLength();
-            aContext.mContextId = contextTlv->GetContextId();
-            aContext.mCompressFlag = contextTlv->IsCompress();
+            mContexts[index] = mContexts[index - 1];
+            mContextIndex[mContexts[index].mContextId] = index;
         }
+
+        entry = &mContexts[index];
+        memset(entry->mPrefix, 0, sizeof(entry->mPrefix));
+        memcpy(entry->mPrefix, prefix->GetPrefix(), BitVectorBytes(prefix->GetPrefixLength()));
+        entry->mPrefixLength = prefix->GetPrefixLength();
+        entry->mContextId = contextTlv->GetContextId();
+        entry->mCompressFlag = contextTlv->IsCompress();
+        mContextIndex[entry->mContextId] = index;
+        mNumContexts++;
     }
 
-    return (aContext.mPrefixLength > 0) ? OT_ERROR_NONE : OT_ERROR_NOT_FOUND;
+    mContextsValid = true;
+
+exit:
+    return;
 }
 
-otError LeaderBase::GetContext(uint8_t aContextId, Lowpan::Context &aContext)
+bool LeaderBase::IsContextMatch(const ContextEntry &aEntry, const Ip6::Address &aAddress)
 {
-    otError error = OT_ERROR_NOT_FOUND;
-    PrefixTlv *prefix;
-    ContextTlv *contextTlv;
+    uint8_t bytes = aEntry.mPrefixLength / CHAR_BIT;
+    uint8_t bits = aEntry.mPrefixLength % CHAR_BIT;
+    bool rval = false;
 
-    if (aContextId == 0)
+    // The prefixes of a Thread network usually differ only in their last bytes (the subnet ID), so those are
+    // compared first.
+    if (bits != 0 && ((aEntry.mPrefix[bytes] ^ aAddress.mFields.m8[bytes]) >> (CHAR_BIT - bits)) != 0)
     {
-        aContext.mPrefix = mNetif.GetMle().GetMeshLocalPrefix();
-        aContext.mPrefixLength = 64;
-        aContext.mContextId = 0;
-        aContext.mCompressFlag = true;
-        ExitNow(error = OT_ERROR_NONE);
+        ExitNow();
     }
 
-    for (NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(mTlvs);
-         cur < reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
-         cur = cur->GetNext())
+    if (bytes > 0 && aEntry.mPrefix[bytes - 1] != aAddress.mFields.m8[bytes - 1])
     {
-        if (cur->GetType() != NetworkDataTlv::kTypePrefix)
-        {
-            continue;
-        }
+        ExitNow();
+    }
 
-        prefix = static_cast<PrefixTlv *>(cur);
-        contextTlv = FindContext(*prefix);
+    rval = (memcmp(aEntry.mPrefix, aAddress.mFields.m8, bytes) == 0);
+
+exit:
+    return rval;
+}
 
-        if (contextTlv == NULL)
+void LeaderBase::GetContext(const ContextEntry &aEntry, Lowpan::Context &aContext)
+{
+    aContext.mPrefix = aEntry.mPrefix;
+    aContext.mPrefixLength = aEntry.mPrefixLength;
+    aContext.mContextId = aEntry.mContextId;
+    aContext.mCompressFlag = aEntry.mCompressFlag;
+}
+
+void LeaderBase::GetMeshLocalContext(Lowpan::Context &aContext)
+{
+    aContext.mPrefix = mNetif.GetMle().GetMeshLocalPrefix();
+    aContext.mPrefixLength = 64;
+    aContext.mContextId = 0;
+    aContext.mCompressFlag = true;
+}
+
+otError LeaderBase::GetContext(const Ip6::Address &aAddress, Lowpan::Context &aContext)
+{
+    otError error = OT_ERROR_NOT_FOUND;
+    bool meshLocal = (memcmp(mNetif.GetMle().GetMeshLocalPrefix(), aAddress.mFields.m8, 8) == 0);
+
+    UpdateContexts();
+
+    aContext.mPrefixLength = 0;
+
+    for (uint8_t i = 0; i < mNumContexts; i++)
+    {
+        const ContextEntry &entry = mContexts[i];
+
+        // The mesh local prefix takes precedence over prefixes that are not longer.
+        if (meshLocal && entry.mPrefixLength <= 64)
         {
-            continue;
+            break;
         }
 
-        if (contextTlv->GetContextId() != aContextId)
+        if (IsContextMatch(entry, aAddress))
         {
-            continue;
+            GetContext(entry, aContext);
+            ExitNow(error = OT_ERROR_NONE);
         }
+    }
 
-        aContext.mPrefix = prefix->GetPrefix();
-        aContext.mPrefixLength = prefix->GetPrefixLength();
-        aContext.mContextId = contextTlv->GetContextId();
-        aContext.mCompressFlag = contextTlv->IsCompress();
-        ExitNow(error = OT_ERROR_NONE);
+    if (meshLocal)
+    {
+        GetMeshLocalContext(aContext);
+        error = OT_ERROR_NONE;
     }
 
 exit:
     return error;
 }
 
+otError LeaderBase::GetContext(uint8_t aContextId, Lowpan::Context &aContext)
+{
+    otError error = OT_ERROR_NONE;
+
+    if (aContextId == 0)
+    {
+        GetMeshLocalContext(aContext);
+        ExitNow();
+    }
+
+    UpdateContexts();
+
+    VerifyOrExit(aContextId < kNumContexts && mContextIndex[aContextId] != kInvalidContextIndex,
+                 error = OT_ERROR_NOT_FOUND);
+
+    GetContext(mContexts[mContextIndex[aContextId]], aContext);
+
+exit:
+    return error;
+}
+
 #if OPENTHREAD_ENABLE_DHCP6_SERVER || OPENTHREAD_ENABLE_DHCP6_CLIENT
 otError LeaderBase::GetRlocByContextId(uint8_t aContextId, uint16_t &aRloc16)
 {
@@ -415,6 +471,7 @@ void LeaderBase::SetNetworkData(uint8_t aVersion, uint8_t aStableVersion, bool a
     mStableVersion = aStableVersion;
     memcpy(mTlvs, aData, aDataLength);
     mLength = aDataLength;
+    InvalidateContexts();
 
     if (aStable)
     {
@@ -434,6 +491,7 @@ otError LeaderBase::SetCommissioningData(const uint8_t *aValue, uint8_t aValueLe
 
     VerifyOrExit(sizeof(NetworkDataTlv) + aValueLength < remaining, error = OT_ERROR_NO_BUFS);
 
+    InvalidateContexts();
     RemoveCommissioningData();
 
     if (aValueLength > 0)
@@ -224,15 +224,52 @@ public:
 #endif  // OPENTHREAD_ENABLE_DHCP6_SERVER || OPENTHREAD_ENABLE_DHCP6_CLIENT
 
 protected:
+    /**
+     * This method discards the 6LoWPAN contexts compiled from the Network Data.
+     *
+     * It must be called whenever the Network Data TLVs are modified, the contexts are compiled again on the next
+     * lookup.
+     *
+     */
+    void InvalidateContexts(void) { mContextsValid = false; }
+
     uint8_t         mStableVersion;
     uint8_t         mVersion;
 
 private:
+    enum
+    {
+        kNumContexts         = 16,    ///< The number of 6LoWPAN Context IDs.
+        kInvalidContextIndex = 0xff,
+    };
+
+    /**
+     * This structure represents a 6LoWPAN context compiled from the Network Data.
+     *
+     */
+    struct ContextEntry
+    {
+        uint8_t mPrefix[sizeof(otIp6Address)];
+        uint8_t mPrefixLength;
+        uint8_t mContextId;
+        bool    mCompressFlag;
+    };
+
     otError RemoveCommissioningData(void);
 
     otError ExternalRouteLookup(uint8_t aDomainId, const Ip6::Address &destination,
                                 uint8_t *aPrefixMatch, uint16_t *aRloc16);
     otError DefaultRouteLookup(PrefixTlv &aPrefix, uint16_t *aRloc16);
+
+    void UpdateContexts(void);
+    static bool IsContextMatch(const ContextEntry &aEntry, const Ip6::Address &aAddress);
+    static void GetContext(const ContextEntry &aEntry, Lowpan::Context &aContext);
+    void GetMeshLocalContext(Lowpan::Context &aContext);
+
+    ContextEntry mContexts[kNumContexts];      ///< The contexts, sorted by decreasing prefix length.
+    uint8_t      mContextIndex[kNumContexts];  ///< The index into @var mContexts of each Context ID.
+    uint8_t      mNumContexts;
+    bool         mContextsValid;
 };
 
 /**
@@ -601,6 +601,8 @@ otError Leader::AddNetworkData(uint8_t *aTlvs, uint8_t aTlvsLength)
     NetworkDataTlv *cur = reinterpret_cast<NetworkDataTlv *>(aTlvs);
     NetworkDataTlv *end = reinterpret_cast<NetworkDataTlv *>(aTlvs + aTlvsLength);
 
+    InvalidateContexts();
+
     while (cur < end)
     {
         switch (cur->GetType())
@@ -800,6 +802,8 @@ otError Leader::RemoveRloc(uint16_t aRloc16)
     NetworkDataTlv *end;
     PrefixTlv *prefix;
 
+    InvalidateContexts();
+
     while (1)
     {
         end = reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
@@ -964,6 +968,8 @@ otError Leader::RemoveContext(uint8_t aContextId)
     NetworkDataTlv *end;
     PrefixTlv *prefix;
 
+    InvalidateContexts();
+
     while (1)
     {
         end = reinterpret_cast<NetworkDataTlv *>(mTlvs + mLength);
@@ -87,6 +87,7 @@ ThreadNetif::ThreadNetif(Ip6::Ip6 &aIp6):
 #if OPENTHREAD_FTD || OPENTHREAD_ENABLE_MTD_NETWORK_DIAGNOSTIC
     mNetworkDiagnostic(*this),
 #endif
+    mIsUp(false),
 #if OPENTHREAD_ENABLE_COMMISSIONER && OPENTHREAD_FTD
     mCommissioner(*this),
 #endif  // OPENTHREAD_ENABLE_COMMISSIONER && OPENTHREAD_FTD
@@ -613,6 +613,22 @@ public:
      */
     void ResetIndirectMessageCount(void) { mQueuedMessageCount = 0; }
 
+    /**
+     * This method returns the queue of messages pending indirect transmission to the child.
+     *
+     * @returns A reference to the child's indirect message queue.
+     *
+     */
+    IndirectMessageQueue &GetIndirectMessageQueue(void) { return mIndirectMessageQueue; }
+
+    /**
+     * This method returns the queue of messages pending indirect transmission to the child.
+     *
+     * @returns A reference to the child's indirect message queue.
+     *
+     */
+    const IndirectMessageQueue &GetIndirectMessageQueue(void) const { return mIndirectMessageQueue; }
+
     /**
      * This method clears the requested TLV list.
      *
@@ -682,6 +698,7 @@ private:
         uint8_t mAttachChallenge[Mle::ChallengeTlv::kMaxSize]; ///< The challenge value
     };
 
+    IndirectMessageQueue mIndirectMessageQueue;        ///< Messages pending indirect transmission to the child.
     uint32_t     mIndirectFrameCounter;                ///< Frame counter for current indirect message (used fore retx).
     Message     *mIndirectMessage;                     ///< Current indirect message.
     uint16_t     mIndirectFragmentOffset;              ///< 6LoWPAN fragment offset for the indirect message.
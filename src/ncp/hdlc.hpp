@@ -72,6 +72,18 @@ public:
          */
         otError WriteByte(uint8_t aByte);
 
+        /**
+         * This method writes a sequence of bytes to the buffer and updates the iterator (if space is available).
+         *
+         * @param[in]  aBuf     A pointer to the bytes to write.
+         * @param[in]  aLength  The number of bytes to write.
+         *
+         * @retval OT_ERROR_NONE     Successfully wrote the bytes and updated the iterator.
+         * @retval OT_ERROR_NO_BUFS  Insufficient buffer space, nothing was written.
+         *
+         */
+        otError WriteBytes(const uint8_t *aBuf, uint16_t aLength);
+
         /**
          * This method checks if there is buffer space available to write @p aWriteLength bytes.
          *
@@ -83,6 +95,14 @@ public:
          */
         bool CanWrite(uint16_t aWriteLength) const;
 
+        /**
+         * This method returns the number of bytes which can still be written to the buffer.
+         *
+         * @returns The remaining buffer space in bytes.
+         *
+         */
+        uint16_t GetRemainingLength(void) const { return mRemainingLength; }
+
     protected:
 
         BufferWriteIterator(void);   ///< Protected constructor to ensure no direct instantiation.
@@ -128,6 +148,9 @@ public:
      * This method returns success only if there is space in buffer to encode the entire frame. If there is no space
      * to encode the entire frame, the write iterator remains the same.
      *
+     * Runs of bytes which need no escaping are copied as a whole, and the FCS is updated over the entire buffer.
+     * Encoding a buffer of `N` bytes never takes more than `2 * N` bytes of buffer space.
+     *
      * @param[in]    aInBuf         A pointer to the input buffer.
      * @param[in]    aInLength      The number of bytes in @p aInBuf to encode.
      * @param[inout] aIterator      A reference to a write buffer iterator. On successful exit, the iterator is updated.
@@ -196,6 +219,8 @@ public:
     /**
      * This method streams bytes into the decoder.
      *
+     * The input may be split at any byte boundary.  Runs of bytes between flags and escapes are copied as a whole.
+     *
      * @param[in]  aInBuf     A pointer to the input buffer.
      * @param[in]  aInLength  The number of bytes in @p aInBuf.
      *
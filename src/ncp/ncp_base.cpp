@@ -76,6 +76,9 @@ namespace ot {
 #define NCP_INVALID_SCAN_CHANNEL              (-1)
 #define NCP_PLAT_RESET_REASON                 (1U<<31)
 #define NCP_ON_MESH_NETS_CHANGED_BIT_FLAG     (1U<<30)
+#define NCP_JOIN_FAILURE_BIT_FLAG             (1U<<29)
+#define NCP_STACK_UP_CHANGED_BIT_FLAG         (1U<<28)
+#define NCP_REQUIRE_JOIN_EXISTING_BIT_FLAG    (1U<<27)
 
 enum
 {
@@ -93,6 +96,9 @@ enum
 // MARK: Command/Property Jump Tables
 // ----------------------------------------------------------------------------
 
+// Note: The tables must be kept sorted by command/property key (numeric value), as the handlers are looked up with a
+// binary search. This is verified (`AreHandlerTablesSorted()`) when the `NcpBase` instance is constructed.
+
 const NcpBase::CommandHandlerEntry NcpBase::mCommandHandlerTable[] =
 {
     { SPINEL_CMD_NOOP, &NcpBase::CommandHandler_NOOP },
@@ -110,10 +116,10 @@ const NcpBase::GetPropertyHandlerEntry NcpBase::mGetPropertyHandlerTable[] =
 {
     { SPINEL_PROP_LAST_STATUS, &NcpBase::GetPropertyHandler_LAST_STATUS },
     { SPINEL_PROP_PROTOCOL_VERSION, &NcpBase::GetPropertyHandler_PROTOCOL_VERSION },
+    { SPINEL_PROP_NCP_VERSION, &NcpBase::GetPropertyHandler_NCP_VERSION },
     { SPINEL_PROP_INTERFACE_TYPE, &NcpBase::GetPropertyHandler_INTERFACE_TYPE },
     { SPINEL_PROP_VENDOR_ID, &NcpBase::GetPropertyHandler_VENDOR_ID },
     { SPINEL_PROP_CAPS, &NcpBase::GetPropertyHandler_CAPS },
-    { SPINEL_PROP_NCP_VERSION, &NcpBase::GetPropertyHandler_NCP_VERSION },
     { SPINEL_PROP_INTERFACE_COUNT, &NcpBase::GetPropertyHandler_INTERFACE_COUNT },
     { SPINEL_PROP_POWER_STATE, &NcpBase::GetPropertyHandler_POWER_STATE },
     { SPINEL_PROP_HWADDR, &NcpBase::GetPropertyHandler_HWADDR },
@@ -121,22 +127,21 @@ const NcpBase::GetPropertyHandlerEntry NcpBase::mGetPropertyHandlerTable[] =
     { SPINEL_PROP_HOST_POWER_STATE, &NcpBase::GetPropertyHandler_HOST_POWER_STATE },
 
     { SPINEL_PROP_PHY_ENABLED, &NcpBase::GetPropertyHandler_PHY_ENABLED },
-    { SPINEL_PROP_PHY_FREQ, &NcpBase::GetPropertyHandler_PHY_FREQ },
-    { SPINEL_PROP_PHY_CHAN_SUPPORTED, &NcpBase::GetPropertyHandler_PHY_CHAN_SUPPORTED },
     { SPINEL_PROP_PHY_CHAN, &NcpBase::GetPropertyHandler_PHY_CHAN },
-    { SPINEL_PROP_PHY_RSSI, &NcpBase::GetPropertyHandler_PHY_RSSI },
+    { SPINEL_PROP_PHY_CHAN_SUPPORTED, &NcpBase::GetPropertyHandler_PHY_CHAN_SUPPORTED },
+    { SPINEL_PROP_PHY_FREQ, &NcpBase::GetPropertyHandler_PHY_FREQ },
     { SPINEL_PROP_PHY_TX_POWER, &NcpBase::GetPropertyHandler_PHY_TX_POWER },
+    { SPINEL_PROP_PHY_RSSI, &NcpBase::GetPropertyHandler_PHY_RSSI },
     { SPINEL_PROP_PHY_RX_SENSITIVITY, &NcpBase::GetPropertyHandler_PHY_RX_SENSITIVITY },
 
     { SPINEL_PROP_MAC_SCAN_STATE, &NcpBase::GetPropertyHandler_MAC_SCAN_STATE },
     { SPINEL_PROP_MAC_SCAN_MASK, &NcpBase::GetPropertyHandler_MAC_SCAN_MASK },
     { SPINEL_PROP_MAC_SCAN_PERIOD, &NcpBase::GetPropertyHandler_MAC_SCAN_PERIOD },
-    { SPINEL_PROP_MAC_15_4_PANID, &NcpBase::GetPropertyHandler_MAC_15_4_PANID },
     { SPINEL_PROP_MAC_15_4_LADDR, &NcpBase::GetPropertyHandler_MAC_15_4_LADDR },
     { SPINEL_PROP_MAC_15_4_SADDR, &NcpBase::GetPropertyHandler_MAC_15_4_SADDR },
+    { SPINEL_PROP_MAC_15_4_PANID, &NcpBase::GetPropertyHandler_MAC_15_4_PANID },
     { SPINEL_PROP_MAC_RAW_STREAM_ENABLED, &NcpBase::GetPropertyHandler_MAC_RAW_STREAM_ENABLED },
     { SPINEL_PROP_MAC_PROMISCUOUS_MODE, &NcpBase::GetPropertyHandler_MAC_PROMISCUOUS_MODE },
-    { SPINEL_PROP_MAC_EXTENDED_ADDR, &NcpBase::GetPropertyHandler_MAC_EXTENDED_ADDR },
 
     { SPINEL_PROP_NET_SAVED, &NcpBase::GetPropertyHandler_NET_SAVED },
     { SPINEL_PROP_NET_IF_UP, &NcpBase::GetPropertyHandler_NET_IF_UP },
@@ -147,75 +152,41 @@ const NcpBase::GetPropertyHandlerEntry NcpBase::mGetPropertyHandlerTable[] =
     { SPINEL_PROP_NET_MASTER_KEY, &NcpBase::GetPropertyHandler_NET_MASTER_KEY },
     { SPINEL_PROP_NET_KEY_SEQUENCE_COUNTER, &NcpBase::GetPropertyHandler_NET_KEY_SEQUENCE_COUNTER },
     { SPINEL_PROP_NET_PARTITION_ID, &NcpBase::GetPropertyHandler_NET_PARTITION_ID },
+    { SPINEL_PROP_NET_REQUIRE_JOIN_EXISTING, &NcpBase::GetPropertyHandler_NET_REQUIRE_JOIN_EXISTING },
     { SPINEL_PROP_NET_KEY_SWITCH_GUARDTIME, &NcpBase::GetPropertyHandler_NET_KEY_SWITCH_GUARDTIME},
+#if OPENTHREAD_FTD
+    { SPINEL_PROP_NET_PSKC, &NcpBase::GetPropertyHandler_NET_PSKC },
+#endif
 
     { SPINEL_PROP_THREAD_LEADER_ADDR, &NcpBase::GetPropertyHandler_THREAD_LEADER_ADDR },
     { SPINEL_PROP_THREAD_PARENT, &NcpBase::GetPropertyHandler_THREAD_PARENT },
-    { SPINEL_PROP_THREAD_NEIGHBOR_TABLE, &NcpBase::GetPropertyHandler_THREAD_NEIGHBOR_TABLE },
+#if OPENTHREAD_FTD
+    { SPINEL_PROP_THREAD_CHILD_TABLE, &NcpBase::GetPropertyHandler_THREAD_CHILD_TABLE },
+#endif
     { SPINEL_PROP_THREAD_LEADER_RID, &NcpBase::GetPropertyHandler_THREAD_LEADER_RID },
     { SPINEL_PROP_THREAD_LEADER_WEIGHT, &NcpBase::GetPropertyHandler_THREAD_LEADER_WEIGHT },
+#if OPENTHREAD_FTD
+    { SPINEL_PROP_THREAD_LOCAL_LEADER_WEIGHT, &NcpBase::GetPropertyHandler_THREAD_LOCAL_LEADER_WEIGHT },
+#endif
     { SPINEL_PROP_THREAD_NETWORK_DATA, &NcpBase::GetPropertyHandler_THREAD_NETWORK_DATA },
     { SPINEL_PROP_THREAD_NETWORK_DATA_VERSION, &NcpBase::GetPropertyHandler_THREAD_NETWORK_DATA_VERSION },
     { SPINEL_PROP_THREAD_STABLE_NETWORK_DATA, &NcpBase::GetPropertyHandler_THREAD_STABLE_NETWORK_DATA },
     { SPINEL_PROP_THREAD_STABLE_NETWORK_DATA_VERSION, &NcpBase::GetPropertyHandler_THREAD_STABLE_NETWORK_DATA_VERSION },
-    { SPINEL_PROP_THREAD_LEADER_NETWORK_DATA, &NcpBase::GetPropertyHandler_THREAD_LEADER_NETWORK_DATA },
-    { SPINEL_PROP_THREAD_STABLE_LEADER_NETWORK_DATA, &NcpBase::GetPropertyHandler_THREAD_STABLE_LEADER_NETWORK_DATA },
+    { SPINEL_PROP_THREAD_ON_MESH_NETS, &NcpBase::GetPropertyHandler_THREAD_ON_MESH_NETS },
     { SPINEL_PROP_THREAD_OFF_MESH_ROUTES, &NcpBase::GetPropertyHandler_THREAD_OFF_MESH_ROUTES },
     { SPINEL_PROP_THREAD_ASSISTING_PORTS, &NcpBase::GetPropertyHandler_THREAD_ASSISTING_PORTS },
     { SPINEL_PROP_THREAD_ALLOW_LOCAL_NET_DATA_CHANGE, &NcpBase::GetPropertyHandler_THREAD_ALLOW_LOCAL_NET_DATA_CHANGE },
-
-#if OPENTHREAD_ENABLE_COMMISSIONER && OPENTHREAD_FTD
-    { SPINEL_PROP_THREAD_COMMISSIONER_ENABLED, &NcpBase::GetPropertyHandler_THREAD_COMMISSIONER_ENABLED },
-#endif
-
-    { SPINEL_PROP_MAC_WHITELIST, &NcpBase::GetPropertyHandler_MAC_WHITELIST },
-    { SPINEL_PROP_MAC_WHITELIST_ENABLED, &NcpBase::GetPropertyHandler_MAC_WHITELIST_ENABLED },
     { SPINEL_PROP_THREAD_MODE, &NcpBase::GetPropertyHandler_THREAD_MODE },
-    { SPINEL_PROP_THREAD_CHILD_TIMEOUT, &NcpBase::GetPropertyHandler_THREAD_CHILD_TIMEOUT },
-    { SPINEL_PROP_THREAD_RLOC16, &NcpBase::GetPropertyHandler_THREAD_RLOC16 },
-    { SPINEL_PROP_THREAD_ON_MESH_NETS, &NcpBase::GetPropertyHandler_THREAD_ON_MESH_NETS },
-    { SPINEL_PROP_NET_REQUIRE_JOIN_EXISTING, &NcpBase::GetPropertyHandler_NET_REQUIRE_JOIN_EXISTING },
 
-    { SPINEL_PROP_IPV6_ML_PREFIX, &NcpBase::GetPropertyHandler_IPV6_ML_PREFIX },
-    { SPINEL_PROP_IPV6_ML_ADDR, &NcpBase::GetPropertyHandler_IPV6_ML_ADDR },
     { SPINEL_PROP_IPV6_LL_ADDR, &NcpBase::GetPropertyHandler_IPV6_LL_ADDR },
+    { SPINEL_PROP_IPV6_ML_ADDR, &NcpBase::GetPropertyHandler_IPV6_ML_ADDR },
+    { SPINEL_PROP_IPV6_ML_PREFIX, &NcpBase::GetPropertyHandler_IPV6_ML_PREFIX },
     { SPINEL_PROP_IPV6_ADDRESS_TABLE, &NcpBase::GetPropertyHandler_IPV6_ADDRESS_TABLE },
     { SPINEL_PROP_IPV6_ROUTE_TABLE, &NcpBase::GetPropertyHandler_IPV6_ROUTE_TABLE },
     { SPINEL_PROP_IPV6_ICMP_PING_OFFLOAD, &NcpBase::GetPropertyHandler_IPV6_ICMP_PING_OFFLOAD },
-    { SPINEL_PROP_THREAD_RLOC16_DEBUG_PASSTHRU, &NcpBase::GetPropertyHandler_THREAD_RLOC16_DEBUG_PASSTHRU },
-    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_JOINER_FLAG, &NcpBase::GetPropertyHandler_THREAD_DISCOVERY_SCAN_JOINER_FLAG },
-    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_ENABLE_FILTERING,
-        &NcpBase::GetPropertyHandler_THREAD_DISCOVERY_SCAN_ENABLE_FILTERING },
-    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_PANID, &NcpBase::GetPropertyHandler_THREAD_DISCOVERY_SCAN_PANID },
 
     { SPINEL_PROP_STREAM_NET, &NcpBase::GetPropertyHandler_STREAM_NET },
 
-#if OPENTHREAD_FTD
-    { SPINEL_PROP_THREAD_CHILD_TABLE, &NcpBase::GetPropertyHandler_THREAD_CHILD_TABLE },
-    { SPINEL_PROP_THREAD_LOCAL_LEADER_WEIGHT, &NcpBase::GetPropertyHandler_THREAD_LOCAL_LEADER_WEIGHT },
-    { SPINEL_PROP_THREAD_ROUTER_ROLE_ENABLED, &NcpBase::GetPropertyHandler_THREAD_ROUTER_ROLE_ENABLED },
-    { SPINEL_PROP_NET_PSKC, &NcpBase::GetPropertyHandler_NET_PSKC },
-    { SPINEL_PROP_THREAD_CHILD_COUNT_MAX, &NcpBase::GetPropertyHandler_THREAD_CHILD_COUNT_MAX },
-    { SPINEL_PROP_THREAD_ROUTER_UPGRADE_THRESHOLD, &NcpBase::GetPropertyHandler_THREAD_ROUTER_UPGRADE_THRESHOLD },
-    { SPINEL_PROP_THREAD_ROUTER_DOWNGRADE_THRESHOLD, &NcpBase::GetPropertyHandler_THREAD_ROUTER_DOWNGRADE_THRESHOLD },
-    { SPINEL_PROP_THREAD_CONTEXT_REUSE_DELAY, &NcpBase::GetPropertyHandler_THREAD_CONTEXT_REUSE_DELAY },
-    { SPINEL_PROP_THREAD_NETWORK_ID_TIMEOUT, &NcpBase::GetPropertyHandler_THREAD_NETWORK_ID_TIMEOUT },
-    { SPINEL_PROP_THREAD_ROUTER_SELECTION_JITTER, &NcpBase::GetPropertyHandler_THREAD_ROUTER_SELECTION_JITTER },
-#endif
-
-#if OPENTHREAD_ENABLE_JAM_DETECTION
-    { SPINEL_PROP_JAM_DETECT_ENABLE, &NcpBase::GetPropertyHandler_JAM_DETECT_ENABLE },
-    { SPINEL_PROP_JAM_DETECTED, &NcpBase::GetPropertyHandler_JAM_DETECTED },
-    { SPINEL_PROP_JAM_DETECT_RSSI_THRESHOLD, &NcpBase::GetPropertyHandler_JAM_DETECT_RSSI_THRESHOLD },
-    { SPINEL_PROP_JAM_DETECT_WINDOW, &NcpBase::GetPropertyHandler_JAM_DETECT_WINDOW },
-    { SPINEL_PROP_JAM_DETECT_BUSY, &NcpBase::GetPropertyHandler_JAM_DETECT_BUSY },
-    { SPINEL_PROP_JAM_DETECT_HISTORY_BITMAP, &NcpBase::GetPropertyHandler_JAM_DETECT_HISTORY_BITMAP },
-#endif
-
-#if OPENTHREAD_ENABLE_BORDER_AGENT_PROXY && OPENTHREAD_FTD
-    { SPINEL_PROP_THREAD_BA_PROXY_ENABLED, &NcpBase::GetPropertyHandler_BA_PROXY_ENABLED },
-#endif
-
     { SPINEL_PROP_CNTR_TX_PKT_TOTAL, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_TX_PKT_ACK_REQ, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_TX_PKT_ACKED, &NcpBase::GetPropertyHandler_MAC_CNTR },
@@ -226,9 +197,9 @@ const NcpBase::GetPropertyHandlerEntry NcpBase::mGetPropertyHandlerTable[] =
     { SPINEL_PROP_CNTR_TX_PKT_BEACON_REQ, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_TX_PKT_OTHER, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_TX_PKT_RETRY, &NcpBase::GetPropertyHandler_MAC_CNTR },
+    { SPINEL_PROP_CNTR_TX_ERR_CCA, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_TX_PKT_UNICAST, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_TX_PKT_BROADCAST, &NcpBase::GetPropertyHandler_MAC_CNTR },
-    { SPINEL_PROP_CNTR_TX_ERR_CCA, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_TX_ERR_ABORT, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_RX_PKT_TOTAL, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_RX_PKT_DATA, &NcpBase::GetPropertyHandler_MAC_CNTR },
@@ -238,8 +209,6 @@ const NcpBase::GetPropertyHandlerEntry NcpBase::mGetPropertyHandlerTable[] =
     { SPINEL_PROP_CNTR_RX_PKT_OTHER, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_RX_PKT_FILT_WL, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_RX_PKT_FILT_DA, &NcpBase::GetPropertyHandler_MAC_CNTR },
-    { SPINEL_PROP_CNTR_RX_PKT_UNICAST, &NcpBase::GetPropertyHandler_MAC_CNTR },
-    { SPINEL_PROP_CNTR_RX_PKT_BROADCAST, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_RX_ERR_EMPTY, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_RX_ERR_UKWN_NBR, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_RX_ERR_NVLD_SADDR, &NcpBase::GetPropertyHandler_MAC_CNTR },
@@ -247,7 +216,8 @@ const NcpBase::GetPropertyHandlerEntry NcpBase::mGetPropertyHandlerTable[] =
     { SPINEL_PROP_CNTR_RX_ERR_BAD_FCS, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_RX_ERR_OTHER, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_RX_PKT_DUP, &NcpBase::GetPropertyHandler_MAC_CNTR },
-
+    { SPINEL_PROP_CNTR_RX_PKT_UNICAST, &NcpBase::GetPropertyHandler_MAC_CNTR },
+    { SPINEL_PROP_CNTR_RX_PKT_BROADCAST, &NcpBase::GetPropertyHandler_MAC_CNTR },
     { SPINEL_PROP_CNTR_TX_IP_SEC_TOTAL, &NcpBase::GetPropertyHandler_NCP_CNTR },
     { SPINEL_PROP_CNTR_TX_IP_INSEC_TOTAL, &NcpBase::GetPropertyHandler_NCP_CNTR },
     { SPINEL_PROP_CNTR_TX_IP_DROPPED, &NcpBase::GetPropertyHandler_NCP_CNTR },
@@ -257,14 +227,58 @@ const NcpBase::GetPropertyHandlerEntry NcpBase::mGetPropertyHandlerTable[] =
     { SPINEL_PROP_CNTR_TX_SPINEL_TOTAL, &NcpBase::GetPropertyHandler_NCP_CNTR },
     { SPINEL_PROP_CNTR_RX_SPINEL_TOTAL, &NcpBase::GetPropertyHandler_NCP_CNTR },
     { SPINEL_PROP_CNTR_RX_SPINEL_ERR, &NcpBase::GetPropertyHandler_NCP_CNTR },
-
     { SPINEL_PROP_MSG_BUFFER_COUNTERS, &NcpBase::GetPropertyHandler_MSG_BUFFER_COUNTERS },
-    { SPINEL_PROP_DEBUG_TEST_ASSERT, &NcpBase::GetPropertyHandler_DEBUG_TEST_ASSERT },
-    { SPINEL_PROP_DEBUG_NCP_LOG_LEVEL, &NcpBase::GetPropertyHandler_DEBUG_NCP_LOG_LEVEL },
+    { SPINEL_PROP_UNSOL_UPDATE_BATCHING, &NcpBase::GetPropertyHandler_UNSOL_UPDATE_BATCHING },
+
+#if OPENTHREAD_ENABLE_JAM_DETECTION
+    { SPINEL_PROP_JAM_DETECT_ENABLE, &NcpBase::GetPropertyHandler_JAM_DETECT_ENABLE },
+    { SPINEL_PROP_JAM_DETECTED, &NcpBase::GetPropertyHandler_JAM_DETECTED },
+    { SPINEL_PROP_JAM_DETECT_RSSI_THRESHOLD, &NcpBase::GetPropertyHandler_JAM_DETECT_RSSI_THRESHOLD },
+    { SPINEL_PROP_JAM_DETECT_WINDOW, &NcpBase::GetPropertyHandler_JAM_DETECT_WINDOW },
+    { SPINEL_PROP_JAM_DETECT_BUSY, &NcpBase::GetPropertyHandler_JAM_DETECT_BUSY },
+    { SPINEL_PROP_JAM_DETECT_HISTORY_BITMAP, &NcpBase::GetPropertyHandler_JAM_DETECT_HISTORY_BITMAP },
+#endif
+
+    { SPINEL_PROP_MAC_WHITELIST, &NcpBase::GetPropertyHandler_MAC_WHITELIST },
+    { SPINEL_PROP_MAC_WHITELIST_ENABLED, &NcpBase::GetPropertyHandler_MAC_WHITELIST_ENABLED },
+    { SPINEL_PROP_MAC_EXTENDED_ADDR, &NcpBase::GetPropertyHandler_MAC_EXTENDED_ADDR },
+
+    { SPINEL_PROP_THREAD_CHILD_TIMEOUT, &NcpBase::GetPropertyHandler_THREAD_CHILD_TIMEOUT },
+    { SPINEL_PROP_THREAD_RLOC16, &NcpBase::GetPropertyHandler_THREAD_RLOC16 },
+#if OPENTHREAD_FTD
+    { SPINEL_PROP_THREAD_ROUTER_UPGRADE_THRESHOLD, &NcpBase::GetPropertyHandler_THREAD_ROUTER_UPGRADE_THRESHOLD },
+    { SPINEL_PROP_THREAD_CONTEXT_REUSE_DELAY, &NcpBase::GetPropertyHandler_THREAD_CONTEXT_REUSE_DELAY },
+    { SPINEL_PROP_THREAD_NETWORK_ID_TIMEOUT, &NcpBase::GetPropertyHandler_THREAD_NETWORK_ID_TIMEOUT },
+#endif
+    { SPINEL_PROP_THREAD_RLOC16_DEBUG_PASSTHRU, &NcpBase::GetPropertyHandler_THREAD_RLOC16_DEBUG_PASSTHRU },
+#if OPENTHREAD_FTD
+    { SPINEL_PROP_THREAD_ROUTER_ROLE_ENABLED, &NcpBase::GetPropertyHandler_THREAD_ROUTER_ROLE_ENABLED },
+    { SPINEL_PROP_THREAD_ROUTER_DOWNGRADE_THRESHOLD, &NcpBase::GetPropertyHandler_THREAD_ROUTER_DOWNGRADE_THRESHOLD },
+    { SPINEL_PROP_THREAD_ROUTER_SELECTION_JITTER, &NcpBase::GetPropertyHandler_THREAD_ROUTER_SELECTION_JITTER },
+#endif
+    { SPINEL_PROP_THREAD_NEIGHBOR_TABLE, &NcpBase::GetPropertyHandler_THREAD_NEIGHBOR_TABLE },
+#if OPENTHREAD_FTD
+    { SPINEL_PROP_THREAD_CHILD_COUNT_MAX, &NcpBase::GetPropertyHandler_THREAD_CHILD_COUNT_MAX },
+#endif
+    { SPINEL_PROP_THREAD_LEADER_NETWORK_DATA, &NcpBase::GetPropertyHandler_THREAD_LEADER_NETWORK_DATA },
+    { SPINEL_PROP_THREAD_STABLE_LEADER_NETWORK_DATA, &NcpBase::GetPropertyHandler_THREAD_STABLE_LEADER_NETWORK_DATA },
+#if OPENTHREAD_ENABLE_COMMISSIONER && OPENTHREAD_FTD
+    { SPINEL_PROP_THREAD_COMMISSIONER_ENABLED, &NcpBase::GetPropertyHandler_THREAD_COMMISSIONER_ENABLED },
+#endif
+#if OPENTHREAD_ENABLE_BORDER_AGENT_PROXY && OPENTHREAD_FTD
+    { SPINEL_PROP_THREAD_BA_PROXY_ENABLED, &NcpBase::GetPropertyHandler_BA_PROXY_ENABLED },
+#endif
+    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_JOINER_FLAG, &NcpBase::GetPropertyHandler_THREAD_DISCOVERY_SCAN_JOINER_FLAG },
+    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_ENABLE_FILTERING,
+        &NcpBase::GetPropertyHandler_THREAD_DISCOVERY_SCAN_ENABLE_FILTERING },
+    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_PANID, &NcpBase::GetPropertyHandler_THREAD_DISCOVERY_SCAN_PANID },
 
 #if OPENTHREAD_ENABLE_LEGACY
     { SPINEL_PROP_NEST_LEGACY_ULA_PREFIX, &NcpBase::GetPropertyHandler_NEST_LEGACY_ULA_PREFIX },
 #endif
+
+    { SPINEL_PROP_DEBUG_TEST_ASSERT, &NcpBase::GetPropertyHandler_DEBUG_TEST_ASSERT },
+    { SPINEL_PROP_DEBUG_NCP_LOG_LEVEL, &NcpBase::GetPropertyHandler_DEBUG_NCP_LOG_LEVEL },
 };
 
 const NcpBase::SetPropertyHandlerEntry NcpBase::mSetPropertyHandlerTable[] =
@@ -274,19 +288,20 @@ const NcpBase::SetPropertyHandlerEntry NcpBase::mSetPropertyHandlerTable[] =
 
 #if OPENTHREAD_ENABLE_RAW_LINK_API
     { SPINEL_PROP_PHY_ENABLED, &NcpBase::SetPropertyHandler_PHY_ENABLED },
-    { SPINEL_PROP_MAC_15_4_SADDR, &NcpBase::SetPropertyHandler_MAC_15_4_SADDR },
-    { SPINEL_PROP_STREAM_RAW, &NcpBase::SetPropertyHandler_STREAM_RAW },
-#endif // OPENTHREAD_ENABLE_RAW_LINK_API
-    { SPINEL_PROP_PHY_TX_POWER, &NcpBase::SetPropertyHandler_PHY_TX_POWER },
+#endif
     { SPINEL_PROP_PHY_CHAN, &NcpBase::SetPropertyHandler_PHY_CHAN },
-    { SPINEL_PROP_MAC_PROMISCUOUS_MODE, &NcpBase::SetPropertyHandler_MAC_PROMISCUOUS_MODE },
+    { SPINEL_PROP_PHY_TX_POWER, &NcpBase::SetPropertyHandler_PHY_TX_POWER },
 
-    { SPINEL_PROP_MAC_SCAN_MASK, &NcpBase::SetPropertyHandler_MAC_SCAN_MASK },
     { SPINEL_PROP_MAC_SCAN_STATE, &NcpBase::SetPropertyHandler_MAC_SCAN_STATE },
+    { SPINEL_PROP_MAC_SCAN_MASK, &NcpBase::SetPropertyHandler_MAC_SCAN_MASK },
     { SPINEL_PROP_MAC_SCAN_PERIOD, &NcpBase::SetPropertyHandler_MAC_SCAN_PERIOD },
-    { SPINEL_PROP_MAC_15_4_PANID, &NcpBase::SetPropertyHandler_MAC_15_4_PANID },
     { SPINEL_PROP_MAC_15_4_LADDR, &NcpBase::SetPropertyHandler_MAC_15_4_LADDR },
+#if OPENTHREAD_ENABLE_RAW_LINK_API
+    { SPINEL_PROP_MAC_15_4_SADDR, &NcpBase::SetPropertyHandler_MAC_15_4_SADDR },
+#endif
+    { SPINEL_PROP_MAC_15_4_PANID, &NcpBase::SetPropertyHandler_MAC_15_4_PANID },
     { SPINEL_PROP_MAC_RAW_STREAM_ENABLED, &NcpBase::SetPropertyHandler_MAC_RAW_STREAM_ENABLED },
+    { SPINEL_PROP_MAC_PROMISCUOUS_MODE, &NcpBase::SetPropertyHandler_MAC_PROMISCUOUS_MODE },
 
     { SPINEL_PROP_NET_IF_UP, &NcpBase::SetPropertyHandler_NET_IF_UP },
     { SPINEL_PROP_NET_STACK_UP, &NcpBase::SetPropertyHandler_NET_STACK_UP },
@@ -295,16 +310,37 @@ const NcpBase::SetPropertyHandlerEntry NcpBase::mSetPropertyHandlerTable[] =
     { SPINEL_PROP_NET_XPANID, &NcpBase::SetPropertyHandler_NET_XPANID },
     { SPINEL_PROP_NET_MASTER_KEY, &NcpBase::SetPropertyHandler_NET_MASTER_KEY },
     { SPINEL_PROP_NET_KEY_SEQUENCE_COUNTER, &NcpBase::SetPropertyHandler_NET_KEY_SEQUENCE_COUNTER },
+    { SPINEL_PROP_NET_REQUIRE_JOIN_EXISTING, &NcpBase::SetPropertyHandler_NET_REQUIRE_JOIN_EXISTING },
     { SPINEL_PROP_NET_KEY_SWITCH_GUARDTIME, &NcpBase::SetPropertyHandler_NET_KEY_SWITCH_GUARDTIME},
+#if OPENTHREAD_FTD
+    { SPINEL_PROP_NET_PSKC, &NcpBase::SetPropertyHandler_NET_PSKC },
+#endif
 
+#if OPENTHREAD_FTD
+    { SPINEL_PROP_THREAD_LOCAL_LEADER_WEIGHT, &NcpBase::SetPropertyHandler_THREAD_LOCAL_LEADER_WEIGHT },
+#endif
     { SPINEL_PROP_THREAD_ASSISTING_PORTS, &NcpBase::SetPropertyHandler_THREAD_ASSISTING_PORTS },
-
-    { SPINEL_PROP_STREAM_NET_INSECURE, &NcpBase::SetPropertyHandler_STREAM_NET_INSECURE },
-    { SPINEL_PROP_STREAM_NET, &NcpBase::SetPropertyHandler_STREAM_NET },
+#if OPENTHREAD_FTD
+    { SPINEL_PROP_THREAD_ALLOW_LOCAL_NET_DATA_CHANGE, &NcpBase::SetPropertyHandler_THREAD_ALLOW_LOCAL_NET_DATA_CHANGE },
+#endif
+    { SPINEL_PROP_THREAD_MODE, &NcpBase::SetPropertyHandler_THREAD_MODE },
 
     { SPINEL_PROP_IPV6_ML_PREFIX, &NcpBase::SetPropertyHandler_IPV6_ML_PREFIX },
     { SPINEL_PROP_IPV6_ICMP_PING_OFFLOAD, &NcpBase::SetPropertyHandler_IPV6_ICMP_PING_OFFLOAD },
-    { SPINEL_PROP_THREAD_RLOC16_DEBUG_PASSTHRU, &NcpBase::SetPropertyHandler_THREAD_RLOC16_DEBUG_PASSTHRU },
+
+#if OPENTHREAD_ENABLE_RAW_LINK_API
+    { SPINEL_PROP_STREAM_RAW, &NcpBase::SetPropertyHandler_STREAM_RAW },
+#endif
+    { SPINEL_PROP_STREAM_NET, &NcpBase::SetPropertyHandler_STREAM_NET },
+    { SPINEL_PROP_STREAM_NET_INSECURE, &NcpBase::SetPropertyHandler_STREAM_NET_INSECURE },
+    { SPINEL_PROP_UNSOL_UPDATE_BATCHING, &NcpBase::SetPropertyHandler_UNSOL_UPDATE_BATCHING },
+
+#if OPENTHREAD_ENABLE_JAM_DETECTION
+    { SPINEL_PROP_JAM_DETECT_ENABLE, &NcpBase::SetPropertyHandler_JAM_DETECT_ENABLE },
+    { SPINEL_PROP_JAM_DETECT_RSSI_THRESHOLD, &NcpBase::SetPropertyHandler_JAM_DETECT_RSSI_THRESHOLD },
+    { SPINEL_PROP_JAM_DETECT_WINDOW, &NcpBase::SetPropertyHandler_JAM_DETECT_WINDOW },
+    { SPINEL_PROP_JAM_DETECT_BUSY, &NcpBase::SetPropertyHandler_JAM_DETECT_BUSY },
+#endif
 
     { SPINEL_PROP_MAC_WHITELIST, &NcpBase::SetPropertyHandler_MAC_WHITELIST },
     { SPINEL_PROP_MAC_WHITELIST_ENABLED, &NcpBase::SetPropertyHandler_MAC_WHITELIST_ENABLED },
@@ -313,89 +349,81 @@ const NcpBase::SetPropertyHandlerEntry NcpBase::mSetPropertyHandlerTable[] =
     { SPINEL_PROP_MAC_SRC_MATCH_SHORT_ADDRESSES, &NcpBase::SetPropertyHandler_MAC_SRC_MATCH_SHORT_ADDRESSES },
     { SPINEL_PROP_MAC_SRC_MATCH_EXTENDED_ADDRESSES, &NcpBase::SetPropertyHandler_MAC_SRC_MATCH_EXTENDED_ADDRESSES },
 #endif
-    { SPINEL_PROP_THREAD_MODE, &NcpBase::SetPropertyHandler_THREAD_MODE },
-    { SPINEL_PROP_NET_REQUIRE_JOIN_EXISTING, &NcpBase::SetPropertyHandler_NET_REQUIRE_JOIN_EXISTING },
-    { SPINEL_PROP_DEBUG_NCP_LOG_LEVEL, &NcpBase::SetPropertyHandler_DEBUG_NCP_LOG_LEVEL },
-
-    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_JOINER_FLAG, &NcpBase::SetPropertyHandler_THREAD_DISCOVERY_SCAN_JOINER_FLAG },
-    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_ENABLE_FILTERING,
-        &NcpBase::SetPropertyHandler_THREAD_DISCOVERY_SCAN_ENABLE_FILTERING },
-    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_PANID, &NcpBase::SetPropertyHandler_THREAD_DISCOVERY_SCAN_PANID },
 
 #if OPENTHREAD_FTD
-    { SPINEL_PROP_NET_PSKC, &NcpBase::SetPropertyHandler_NET_PSKC },
     { SPINEL_PROP_THREAD_CHILD_TIMEOUT, &NcpBase::SetPropertyHandler_THREAD_CHILD_TIMEOUT },
+    { SPINEL_PROP_THREAD_ROUTER_UPGRADE_THRESHOLD, &NcpBase::SetPropertyHandler_THREAD_ROUTER_UPGRADE_THRESHOLD },
+    { SPINEL_PROP_THREAD_CONTEXT_REUSE_DELAY, &NcpBase::SetPropertyHandler_THREAD_CONTEXT_REUSE_DELAY },
     { SPINEL_PROP_THREAD_NETWORK_ID_TIMEOUT, &NcpBase::SetPropertyHandler_THREAD_NETWORK_ID_TIMEOUT },
-    { SPINEL_PROP_THREAD_LOCAL_LEADER_WEIGHT, &NcpBase::SetPropertyHandler_THREAD_LOCAL_LEADER_WEIGHT },
-    { SPINEL_PROP_THREAD_ALLOW_LOCAL_NET_DATA_CHANGE, &NcpBase::SetPropertyHandler_THREAD_ALLOW_LOCAL_NET_DATA_CHANGE },
+#endif
+    { SPINEL_PROP_THREAD_RLOC16_DEBUG_PASSTHRU, &NcpBase::SetPropertyHandler_THREAD_RLOC16_DEBUG_PASSTHRU },
+#if OPENTHREAD_FTD
     { SPINEL_PROP_THREAD_ROUTER_ROLE_ENABLED, &NcpBase::SetPropertyHandler_THREAD_ROUTER_ROLE_ENABLED },
-    { SPINEL_PROP_THREAD_CHILD_COUNT_MAX, &NcpBase::SetPropertyHandler_THREAD_CHILD_COUNT_MAX },
-    { SPINEL_PROP_THREAD_ROUTER_UPGRADE_THRESHOLD, &NcpBase::SetPropertyHandler_THREAD_ROUTER_UPGRADE_THRESHOLD },
     { SPINEL_PROP_THREAD_ROUTER_DOWNGRADE_THRESHOLD, &NcpBase::SetPropertyHandler_THREAD_ROUTER_DOWNGRADE_THRESHOLD },
-    { SPINEL_PROP_THREAD_CONTEXT_REUSE_DELAY, &NcpBase::SetPropertyHandler_THREAD_CONTEXT_REUSE_DELAY },
     { SPINEL_PROP_THREAD_ROUTER_SELECTION_JITTER, &NcpBase::SetPropertyHandler_THREAD_ROUTER_SELECTION_JITTER },
     { SPINEL_PROP_THREAD_PREFERRED_ROUTER_ID, &NcpBase::SetPropertyHandler_THREAD_PREFERRED_ROUTER_ID },
-#if OPENTHREAD_CONFIG_ENABLE_STEERING_DATA_SET_OOB
-    { SPINEL_PROP_THREAD_STEERING_DATA, &NcpBase::SetPropertyHandler_THREAD_THREAD_STEERING_DATA },
-#endif // #if OPENTHREAD_CONFIG_ENABLE_STEERING_DATA_SET_OOB
-#endif // #if OPENTHREAD_FTD
-
-#if OPENTHREAD_ENABLE_JAM_DETECTION
-    { SPINEL_PROP_JAM_DETECT_ENABLE, &NcpBase::SetPropertyHandler_JAM_DETECT_ENABLE },
-    { SPINEL_PROP_JAM_DETECT_RSSI_THRESHOLD, &NcpBase::SetPropertyHandler_JAM_DETECT_RSSI_THRESHOLD },
-    { SPINEL_PROP_JAM_DETECT_WINDOW, &NcpBase::SetPropertyHandler_JAM_DETECT_WINDOW },
-    { SPINEL_PROP_JAM_DETECT_BUSY, &NcpBase::SetPropertyHandler_JAM_DETECT_BUSY },
+    { SPINEL_PROP_THREAD_CHILD_COUNT_MAX, &NcpBase::SetPropertyHandler_THREAD_CHILD_COUNT_MAX },
+#endif
+#if OPENTHREAD_ENABLE_COMMISSIONER && OPENTHREAD_FTD
+    { SPINEL_PROP_THREAD_COMMISSIONER_ENABLED, &NcpBase::SetPropertyHandler_THREAD_COMMISSIONER_ENABLED },
 #endif
-
 #if OPENTHREAD_ENABLE_BORDER_AGENT_PROXY && OPENTHREAD_FTD
     { SPINEL_PROP_THREAD_BA_PROXY_ENABLED, &NcpBase::SetPropertyHandler_BA_PROXY_ENABLED },
     { SPINEL_PROP_THREAD_BA_PROXY_STREAM, &NcpBase::SetPropertyHandler_THREAD_BA_PROXY_STREAM },
-#endif // OPENTHREAD_ENABLE_BORDER_AGENT_PROXY && OPENTHREAD_FTD
+#endif
+    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_JOINER_FLAG, &NcpBase::SetPropertyHandler_THREAD_DISCOVERY_SCAN_JOINER_FLAG },
+    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_ENABLE_FILTERING,
+        &NcpBase::SetPropertyHandler_THREAD_DISCOVERY_SCAN_ENABLE_FILTERING },
+    { SPINEL_PROP_THREAD_DISCOVERY_SCAN_PANID, &NcpBase::SetPropertyHandler_THREAD_DISCOVERY_SCAN_PANID },
+#if OPENTHREAD_FTD && OPENTHREAD_CONFIG_ENABLE_STEERING_DATA_SET_OOB
+    { SPINEL_PROP_THREAD_STEERING_DATA, &NcpBase::SetPropertyHandler_THREAD_THREAD_STEERING_DATA },
+#endif
 
 #if OPENTHREAD_ENABLE_DIAG
     { SPINEL_PROP_NEST_STREAM_MFG, &NcpBase::SetPropertyHandler_NEST_STREAM_MFG },
 #endif
-
 #if OPENTHREAD_ENABLE_LEGACY
     { SPINEL_PROP_NEST_LEGACY_ULA_PREFIX, &NcpBase::SetPropertyHandler_NEST_LEGACY_ULA_PREFIX },
 #endif
 
-#if OPENTHREAD_ENABLE_COMMISSIONER && OPENTHREAD_FTD
-    { SPINEL_PROP_THREAD_COMMISSIONER_ENABLED, &NcpBase::SetPropertyHandler_THREAD_COMMISSIONER_ENABLED },
-#endif
+    { SPINEL_PROP_DEBUG_NCP_LOG_LEVEL, &NcpBase::SetPropertyHandler_DEBUG_NCP_LOG_LEVEL },
 };
 
 const NcpBase::InsertPropertyHandlerEntry NcpBase::mInsertPropertyHandlerTable[] =
 {
+    { SPINEL_PROP_THREAD_ON_MESH_NETS, &NcpBase::InsertPropertyHandler_THREAD_ON_MESH_NETS },
+    { SPINEL_PROP_THREAD_OFF_MESH_ROUTES, &NcpBase::InsertPropertyHandler_THREAD_OFF_MESH_ROUTES },
+    { SPINEL_PROP_THREAD_ASSISTING_PORTS, &NcpBase::InsertPropertyHandler_THREAD_ASSISTING_PORTS },
+
+    { SPINEL_PROP_IPV6_ADDRESS_TABLE, &NcpBase::InsertPropertyHandler_IPV6_ADDRESS_TABLE },
+
+    { SPINEL_PROP_CNTR_RESET, &NcpBase::SetPropertyHandler_CNTR_RESET },
+
+    { SPINEL_PROP_MAC_WHITELIST, &NcpBase::InsertPropertyHandler_MAC_WHITELIST },
 #if OPENTHREAD_ENABLE_RAW_LINK_API
     { SPINEL_PROP_MAC_SRC_MATCH_SHORT_ADDRESSES, &NcpBase::InsertPropertyHandler_MAC_SRC_MATCH_SHORT_ADDRESSES },
     { SPINEL_PROP_MAC_SRC_MATCH_EXTENDED_ADDRESSES, &NcpBase::InsertPropertyHandler_MAC_SRC_MATCH_EXTENDED_ADDRESSES },
 #endif
-    { SPINEL_PROP_IPV6_ADDRESS_TABLE, &NcpBase::InsertPropertyHandler_IPV6_ADDRESS_TABLE },
-    { SPINEL_PROP_THREAD_OFF_MESH_ROUTES, &NcpBase::InsertPropertyHandler_THREAD_OFF_MESH_ROUTES },
-    { SPINEL_PROP_THREAD_ON_MESH_NETS, &NcpBase::InsertPropertyHandler_THREAD_ON_MESH_NETS },
-    { SPINEL_PROP_THREAD_ASSISTING_PORTS, &NcpBase::InsertPropertyHandler_THREAD_ASSISTING_PORTS },
 
 #if OPENTHREAD_ENABLE_COMMISSIONER && OPENTHREAD_FTD
     { SPINEL_PROP_THREAD_JOINERS, &NcpBase::NcpBase::InsertPropertyHandler_THREAD_JOINERS },
 #endif
-
-    { SPINEL_PROP_CNTR_RESET, &NcpBase::SetPropertyHandler_CNTR_RESET },
-
-    { SPINEL_PROP_MAC_WHITELIST, &NcpBase::InsertPropertyHandler_MAC_WHITELIST },
 };
 
 const NcpBase::RemovePropertyHandlerEntry NcpBase::mRemovePropertyHandlerTable[] =
 {
+    { SPINEL_PROP_THREAD_ON_MESH_NETS, &NcpBase::RemovePropertyHandler_THREAD_ON_MESH_NETS },
+    { SPINEL_PROP_THREAD_OFF_MESH_ROUTES, &NcpBase::RemovePropertyHandler_THREAD_OFF_MESH_ROUTES },
+    { SPINEL_PROP_THREAD_ASSISTING_PORTS, &NcpBase::RemovePropertyHandler_THREAD_ASSISTING_PORTS },
+
+    { SPINEL_PROP_IPV6_ADDRESS_TABLE, &NcpBase::RemovePropertyHandler_IPV6_ADDRESS_TABLE },
+
+    { SPINEL_PROP_MAC_WHITELIST, &NcpBase::RemovePropertyHandler_MAC_WHITELIST },
 #if OPENTHREAD_ENABLE_RAW_LINK_API
     { SPINEL_PROP_MAC_SRC_MATCH_SHORT_ADDRESSES, &NcpBase::RemovePropertyHandler_MAC_SRC_MATCH_SHORT_ADDRESSES },
     { SPINEL_PROP_MAC_SRC_MATCH_EXTENDED_ADDRESSES, &NcpBase::RemovePropertyHandler_MAC_SRC_MATCH_EXTENDED_ADDRESSES },
 #endif
-    { SPINEL_PROP_IPV6_ADDRESS_TABLE, &NcpBase::RemovePropertyHandler_IPV6_ADDRESS_TABLE },
-    { SPINEL_PROP_THREAD_OFF_MESH_ROUTES, &NcpBase::RemovePropertyHandler_THREAD_OFF_MESH_ROUTES },
-    { SPINEL_PROP_THREAD_ON_MESH_NETS, &NcpBase::RemovePropertyHandler_THREAD_ON_MESH_NETS },
-    { SPINEL_PROP_THREAD_ASSISTING_PORTS, &NcpBase::RemovePropertyHandler_THREAD_ASSISTING_PORTS },
-    { SPINEL_PROP_MAC_WHITELIST, &NcpBase::RemovePropertyHandler_MAC_WHITELIST },
+
 #if OPENTHREAD_FTD
     { SPINEL_PROP_THREAD_ACTIVE_ROUTER_IDS, &NcpBase::RemovePropertyHandler_THREAD_ACTIVE_ROUTER_IDS },
 #endif
@@ -576,6 +604,13 @@ NcpBase::NcpBase(otInstance *aInstance):
     mDiscoveryScanPanId(0xffff),
     mUpdateChangedPropsTask(aInstance->mIp6.mTaskletScheduler, &NcpBase::UpdateChangedProps, this),
     mChangedFlags(NCP_PLAT_RESET_REASON),
+    mUnsolUpdateBatchingEnabled(false),
+    mUnsolUpdateBatchFailed(false),
+    mBatchState(kBatchStateIdle),
+    mBatchItemCount(0),
+    mBatchItemPosition(0),
+    mBatchItemLength(0),
+    mUnsolUpdateTimer(aInstance->mIp6.mTimerScheduler, &NcpBase::HandleUnsolUpdateTimer, this),
     mShouldSignalEndOfScan(false),
     mHostPowerState(SPINEL_HOST_POWER_STATE_ONLINE),
     mHostPowerStateInProgress(false),
@@ -609,6 +644,7 @@ NcpBase::NcpBase(otInstance *aInstance):
     mDroppedInboundIpFrameCounter(0)
 {
     assert(mInstance != NULL);
+    assert(AreHandlerTablesSorted());
 
     sNcpInstance = this;
 
@@ -640,22 +676,152 @@ NcpBase *NcpBase::GetNcpInstance(void)
 
 otError NcpBase::OutboundFrameBegin(void)
 {
-    return mTxFrameBuffer.InFrameBegin();
+    otError errorCode;
+
+    if (mBatchState == kBatchStateIdle)
+    {
+        errorCode = mTxFrameBuffer.InFrameBegin();
+    }
+    else
+    {
+        errorCode = BatchedItemBegin();
+    }
+
+    return errorCode;
 }
 
 otError NcpBase::OutboundFrameFeedData(const uint8_t *aDataBuffer, uint16_t aDataBufferLength)
 {
-    return mTxFrameBuffer.InFrameFeedData(aDataBuffer, aDataBufferLength);
+    otError errorCode;
+
+    if (mBatchState == kBatchStateIdle)
+    {
+        errorCode = mTxFrameBuffer.InFrameFeedData(aDataBuffer, aDataBufferLength);
+    }
+    else
+    {
+        errorCode = BatchedItemFeedData(aDataBuffer, aDataBufferLength);
+    }
+
+    return errorCode;
 }
 
 otError NcpBase::OutboundFrameFeedMessage(otMessage *aMessage)
 {
-    return mTxFrameBuffer.InFrameFeedMessage(aMessage);
+    otError errorCode;
+
+    if (mBatchState == kBatchStateIdle)
+    {
+        errorCode = mTxFrameBuffer.InFrameFeedMessage(aMessage);
+    }
+    else
+    {
+        errorCode = BatchedItemFeedMessage(aMessage);
+    }
+
+    return errorCode;
 }
 
 otError NcpBase::OutboundFrameEnd(void)
 {
-    return mTxFrameBuffer.InFrameEnd();
+    otError errorCode;
+
+    if (mBatchState == kBatchStateIdle)
+    {
+        errorCode = mTxFrameBuffer.InFrameEnd();
+    }
+    else
+    {
+        errorCode = BatchedItemEnd();
+    }
+
+    return errorCode;
+}
+
+// Batched frame items, see `BatchState` in ncp_base.hpp.
+
+otError NcpBase::BatchedItemBegin(void)
+{
+    otError errorCode = OT_ERROR_NONE;
+    uint8_t lengthPlaceholder[sizeof(uint16_t)] = { 0, 0 };
+
+    VerifyOrExit(mBatchState == kBatchStateItemPending, errorCode = OT_ERROR_INVALID_STATE);
+
+    SuccessOrExit(errorCode = mTxFrameBuffer.InFrameGetPosition(mBatchItemPosition));
+    SuccessOrExit(errorCode = mTxFrameBuffer.InFrameFeedData(lengthPlaceholder, sizeof(lengthPlaceholder)));
+
+    mBatchItemLength = 0;
+    mBatchState = kBatchStateItemHeader;
+
+exit:
+    return errorCode;
+}
+
+otError NcpBase::BatchedItemFeedData(const uint8_t *aDataBuffer, uint16_t aDataBufferLength)
+{
+    otError errorCode = OT_ERROR_NONE;
+    uint8_t header;
+    unsigned int command;
+    spinel_ssize_t parsedLength;
+
+    if (mBatchState == kBatchStateItemHeader)
+    {
+        parsedLength = spinel_datatype_unpack(
+                           aDataBuffer,
+                           aDataBufferLength,
+                           SPINEL_DATATYPE_COMMAND_S,
+                           &header,
+                           &command
+                       );
+
+        VerifyOrExit(parsedLength > 0, errorCode = OT_ERROR_FAILED);
+        VerifyOrExit(command == SPINEL_CMD_PROP_VALUE_IS, errorCode = OT_ERROR_FAILED);
+
+        aDataBuffer += parsedLength;
+        aDataBufferLength -= static_cast<uint16_t>(parsedLength);
+        mBatchState = kBatchStateItemValue;
+    }
+
+    VerifyOrExit(mBatchState == kBatchStateItemValue, errorCode = OT_ERROR_INVALID_STATE);
+
+    SuccessOrExit(errorCode = mTxFrameBuffer.InFrameFeedData(aDataBuffer, aDataBufferLength));
+    mBatchItemLength += aDataBufferLength;
+
+exit:
+    return errorCode;
+}
+
+otError NcpBase::BatchedItemFeedMessage(otMessage *aMessage)
+{
+    otError errorCode = OT_ERROR_NONE;
+    uint16_t length = otMessageGetLength(aMessage);
+
+    VerifyOrExit(mBatchState == kBatchStateItemValue, errorCode = OT_ERROR_INVALID_STATE);
+
+    SuccessOrExit(errorCode = mTxFrameBuffer.InFrameFeedMessage(aMessage));
+    mBatchItemLength += length;
+
+exit:
+    return errorCode;
+}
+
+otError NcpBase::BatchedItemEnd(void)
+{
+    otError errorCode = OT_ERROR_NONE;
+    uint8_t length[sizeof(uint16_t)];
+
+    VerifyOrExit(mBatchState == kBatchStateItemValue, errorCode = OT_ERROR_INVALID_STATE);
+
+    // The pair length is little-endian, as for `SPINEL_DATATYPE_DATA_WLEN_S`.
+    length[0] = static_cast<uint8_t>(mBatchItemLength & 0xff);
+    length[1] = static_cast<uint8_t>(mBatchItemLength >> 8);
+    SuccessOrExit(errorCode = mTxFrameBuffer.InFrameOverwrite(mBatchItemPosition, length, sizeof(length)));
+
+    mBatchItemCount++;
+    mBatchState = kBatchStateItemPending;
+
+exit:
+    return errorCode;
 }
 
 NcpFrameBuffer::FrameTag NcpBase::GetLastOutboundFrameTag(void)
@@ -731,18 +897,21 @@ void NcpBase::HandleDatagramFromStack(otMessage *aMessage)
     otError errorCode = OT_ERROR_NONE;
     bool isSecure = otMessageIsLinkSecurityEnabled(aMessage);
     uint16_t length = otMessageGetLength(aMessage);
+    uint8_t buf[sizeof(uint16_t)];
+    SpinelEncoder encoder(buf, sizeof(buf));
 
     SuccessOrExit(errorCode = OutboundFrameBegin());
 
     SuccessOrExit(
-        errorCode = OutboundFrameFeedPacked(
-                        SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_UINT16_S,
+        errorCode = OutboundFrameFeedCommandProp(
                         SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
                         SPINEL_CMD_PROP_VALUE_IS,
-                        isSecure ? SPINEL_PROP_STREAM_NET : SPINEL_PROP_STREAM_NET_INSECURE,
-                        length
+                        isSecure ? SPINEL_PROP_STREAM_NET : SPINEL_PROP_STREAM_NET_INSECURE
                     ));
 
+    SuccessOrExit(errorCode = encoder.WriteUint16(length));
+    SuccessOrExit(errorCode = OutboundFrameFeedEncoded(encoder));
+
     SuccessOrExit(errorCode = OutboundFrameFeedMessage(aMessage));
 
     // Set the `aMessage` pointer to NULL to indicate that it does
@@ -1099,7 +1268,23 @@ void NcpBase::HandleNetifStateChanged(uint32_t flags, void *context)
 
     obj->mChangedFlags |= flags;
 
-    obj->mUpdateChangedPropsTask.Post();
+    if (obj->mUnsolUpdateBatchingEnabled && (OPENTHREAD_CONFIG_NCP_UNSOL_UPDATE_COALESCING_WINDOW > 0))
+    {
+        // Wait for the coalescing window so that closely following changes are sent in the same batched frame.
+        if (!obj->mUnsolUpdateTimer.IsRunning())
+        {
+            obj->mUnsolUpdateTimer.Start(OPENTHREAD_CONFIG_NCP_UNSOL_UPDATE_COALESCING_WINDOW);
+        }
+    }
+    else
+    {
+        obj->mUpdateChangedPropsTask.Post();
+    }
+}
+
+void NcpBase::HandleUnsolUpdateTimer(void *aContext)
+{
+    static_cast<NcpBase *>(aContext)->UpdateChangedProps();
 }
 
 void NcpBase::UpdateChangedProps(void *context)
@@ -1110,143 +1295,250 @@ void NcpBase::UpdateChangedProps(void *context)
 
 void NcpBase::UpdateChangedProps(void)
 {
+    uint32_t changedFlags;
+    bool wasTxBufferEmpty = mTxFrameBuffer.IsEmpty();
+
+    // Update the NCP state before writing any frame, so that `SendChangedProps()` only reports the pending changes
+    // and a discarded batched frame can be sent again as is.
+    UpdateRequireJoinExistingNetwork();
+
+    changedFlags = mChangedFlags;
+
+    if (mUnsolUpdateBatchingEnabled && !mUnsolUpdateBatchFailed)
+    {
+        // Changes within the coalescing window are sent once the timer fires.
+        VerifyOrExit(!mUnsolUpdateTimer.IsRunning());
+
+        if (SendChangedPropsBatched() != OT_ERROR_NONE)
+        {
+            // The batched frame was discarded, so all the changes it covered are still pending. If it did not fit
+            // even in an empty buffer, fall back to one frame per property until all the pending changes are sent.
+            // Otherwise, try again once a frame is removed from the buffer.
+
+            mChangedFlags |= changedFlags;
+            VerifyOrExit(wasTxBufferEmpty);
+            mUnsolUpdateBatchFailed = true;
+        }
+    }
+
+    if (!mUnsolUpdateBatchingEnabled || mUnsolUpdateBatchFailed)
+    {
+        SendChangedProps();
+    }
+
+    if (mChangedFlags == 0)
+    {
+        mUnsolUpdateBatchFailed = false;
+    }
+
+exit:
+    return;
+}
+
+void NcpBase::UpdateRequireJoinExistingNetwork(void)
+{
+    VerifyOrExit(((mChangedFlags & OT_NET_ROLE) != 0) && mRequireJoinExistingNetwork);
+
+    switch (otThreadGetDeviceRole(mInstance))
+    {
+    case OT_DEVICE_ROLE_DETACHED:
+    case OT_DEVICE_ROLE_DISABLED:
+        break;
+
+    default:
+        mRequireJoinExistingNetwork = false;
+        break;
+    }
+
+    if ((otThreadGetDeviceRole(mInstance) == OT_DEVICE_ROLE_LEADER)
+      && otThreadIsSingleton(mInstance)
+#if OPENTHREAD_ENABLE_LEGACY
+        && !mLegacyNodeDidJoin
+#endif
+       )
+    {
+        mChangedFlags &= ~static_cast<uint32_t>(OT_NET_PARTITION_ID);
+        otThreadSetEnabled(mInstance, false);
+
+        mChangedFlags |= (NCP_JOIN_FAILURE_BIT_FLAG | NCP_STACK_UP_CHANGED_BIT_FLAG);
+    }
+
+    mChangedFlags |= NCP_REQUIRE_JOIN_EXISTING_BIT_FLAG;
+
+exit:
+    return;
+}
+
+otError NcpBase::SendChangedPropsBatched(void)
+{
+    otError errorCode;
+
+    SuccessOrExit(errorCode = OutboundFrameBegin());
+    SuccessOrExit(
+        errorCode = OutboundFrameFeedPacked(
+                        SPINEL_DATATYPE_COMMAND_S,
+                        SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                        SPINEL_CMD_PROP_VALUES_ARE
+                    ));
+
+    mBatchState = kBatchStateItemPending;
+    mBatchItemCount = 0;
+
+    errorCode = SendChangedProps();
+
+    mBatchState = kBatchStateIdle;
+    SuccessOrExit(errorCode);
+
+    if (mBatchItemCount > 0)
+    {
+        errorCode = OutboundFrameSend();
+    }
+    else
+    {
+        // Nothing was reported (e.g., only RLOC changes), discard the empty frame.
+        mTxFrameBuffer.InFrameBegin();
+    }
+
+exit:
+
+    if (errorCode != OT_ERROR_NONE)
+    {
+        // Discard the partially written batched frame.
+        mBatchState = kBatchStateIdle;
+        mTxFrameBuffer.InFrameBegin();
+    }
+
+    return errorCode;
+}
+
+otError NcpBase::SendChangedProps(void)
+{
+    otError errorCode = OT_ERROR_NONE;
+
     while (mChangedFlags != 0)
     {
         if ((mChangedFlags & NCP_PLAT_RESET_REASON) != 0)
         {
             SuccessOrExit(
-                SendLastStatus(
-                    SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                    ResetReasonToSpinelStatus(otPlatGetResetReason(mInstance))
-                ));
+                errorCode = SendLastStatus(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                ResetReasonToSpinelStatus(otPlatGetResetReason(mInstance))
+                            ));
 
             mChangedFlags &= ~static_cast<uint32_t>(NCP_PLAT_RESET_REASON);
         }
         else if ((mChangedFlags & OT_IP6_LL_ADDR_CHANGED) != 0)
         {
             SuccessOrExit(
-                HandleCommandPropertyGet(
-                    SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                    SPINEL_PROP_IPV6_LL_ADDR
-                ));
+                errorCode = HandleCommandPropertyGet(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_PROP_IPV6_LL_ADDR
+                            ));
 
             mChangedFlags &= ~static_cast<uint32_t>(OT_IP6_LL_ADDR_CHANGED);
         }
         else if ((mChangedFlags & OT_IP6_ML_ADDR_CHANGED) != 0)
         {
             SuccessOrExit(
-                HandleCommandPropertyGet(
-                    SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                    SPINEL_PROP_IPV6_ML_ADDR
-                ));
+                errorCode = HandleCommandPropertyGet(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_PROP_IPV6_ML_ADDR
+                            ));
 
             mChangedFlags &= ~static_cast<uint32_t>(OT_IP6_ML_ADDR_CHANGED);
         }
-        else if ((mChangedFlags & OT_NET_ROLE) != 0)
+        else if ((mChangedFlags & NCP_JOIN_FAILURE_BIT_FLAG) != 0)
         {
-            if (mRequireJoinExistingNetwork)
-            {
-                switch (otThreadGetDeviceRole(mInstance))
-                {
-                case OT_DEVICE_ROLE_DETACHED:
-                case OT_DEVICE_ROLE_DISABLED:
-                    break;
+            // TODO: It would be nice to be able to indicate
+            //   something more specific than SPINEL_STATUS_JOIN_FAILURE
+            //   here, but it isn't clear how that would work
+            //   with the current OpenThread API.
 
-                default:
-                    mRequireJoinExistingNetwork = false;
-                    break;
-                }
-
-                if ((otThreadGetDeviceRole(mInstance) == OT_DEVICE_ROLE_LEADER)
-                  && otThreadIsSingleton(mInstance)
-#if OPENTHREAD_ENABLE_LEGACY
-                    && !mLegacyNodeDidJoin
-#endif
-                   )
-                {
-                    mChangedFlags &= ~static_cast<uint32_t>(OT_NET_PARTITION_ID);
-                    otThreadSetEnabled(mInstance, false);
-
-                    // TODO: It would be nice to be able to indicate
-                    //   something more specific than SPINEL_STATUS_JOIN_FAILURE
-                    //   here, but it isn't clear how that would work
-                    //   with the current OpenThread API.
-
-                    SuccessOrExit(
-                        SendLastStatus(
-                            SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                            SPINEL_STATUS_JOIN_FAILURE
-                        ));
-
-                    SuccessOrExit(
-                        HandleCommandPropertyGet(
-                            SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                            SPINEL_PROP_NET_STACK_UP
-                        ));
-                }
+            SuccessOrExit(
+                errorCode = SendLastStatus(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_STATUS_JOIN_FAILURE
+                            ));
 
-                SuccessOrExit(
-                    HandleCommandPropertyGet(
-                        SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                        SPINEL_PROP_NET_REQUIRE_JOIN_EXISTING
-                    ));
-            }
+            mChangedFlags &= ~static_cast<uint32_t>(NCP_JOIN_FAILURE_BIT_FLAG);
+        }
+        else if ((mChangedFlags & NCP_STACK_UP_CHANGED_BIT_FLAG) != 0)
+        {
+            SuccessOrExit(
+                errorCode = HandleCommandPropertyGet(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_PROP_NET_STACK_UP
+                            ));
 
+            mChangedFlags &= ~static_cast<uint32_t>(NCP_STACK_UP_CHANGED_BIT_FLAG);
+        }
+        else if ((mChangedFlags & NCP_REQUIRE_JOIN_EXISTING_BIT_FLAG) != 0)
+        {
             SuccessOrExit(
-                HandleCommandPropertyGet(
-                    SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                    SPINEL_PROP_NET_ROLE
-                ));
+                errorCode = HandleCommandPropertyGet(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_PROP_NET_REQUIRE_JOIN_EXISTING
+                            ));
+
+            mChangedFlags &= ~static_cast<uint32_t>(NCP_REQUIRE_JOIN_EXISTING_BIT_FLAG);
+        }
+        else if ((mChangedFlags & OT_NET_ROLE) != 0)
+        {
+            SuccessOrExit(
+                errorCode = HandleCommandPropertyGet(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_PROP_NET_ROLE
+                            ));
 
             mChangedFlags &= ~static_cast<uint32_t>(OT_NET_ROLE);
         }
         else if ((mChangedFlags & OT_NET_PARTITION_ID) != 0)
         {
             SuccessOrExit(
-                HandleCommandPropertyGet(
-                    SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                    SPINEL_PROP_NET_PARTITION_ID
-                ));
+                errorCode = HandleCommandPropertyGet(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_PROP_NET_PARTITION_ID
+                            ));
 
             mChangedFlags &= ~static_cast<uint32_t>(OT_NET_PARTITION_ID);
         }
         else if ((mChangedFlags & OT_NET_KEY_SEQUENCE_COUNTER) != 0)
         {
             SuccessOrExit(
-                HandleCommandPropertyGet(
-                    SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                    SPINEL_PROP_NET_KEY_SEQUENCE_COUNTER
-                ));
+                errorCode = HandleCommandPropertyGet(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_PROP_NET_KEY_SEQUENCE_COUNTER
+                            ));
 
             mChangedFlags &= ~static_cast<uint32_t>(OT_NET_KEY_SEQUENCE_COUNTER);
         }
         else if ((mChangedFlags & (OT_IP6_ADDRESS_ADDED | OT_IP6_ADDRESS_REMOVED)) != 0)
         {
             SuccessOrExit(
-                HandleCommandPropertyGet(
-                    SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                    SPINEL_PROP_IPV6_ADDRESS_TABLE
-                ));
+                errorCode = HandleCommandPropertyGet(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_PROP_IPV6_ADDRESS_TABLE
+                            ));
 
             mChangedFlags &= ~static_cast<uint32_t>(OT_IP6_ADDRESS_ADDED | OT_IP6_ADDRESS_REMOVED);
         }
         else if ((mChangedFlags & (OT_THREAD_CHILD_ADDED | OT_THREAD_CHILD_REMOVED)) != 0)
         {
             SuccessOrExit(
-                HandleCommandPropertyGet(
-                    SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                    SPINEL_PROP_THREAD_CHILD_TABLE
-                ));
+                errorCode = HandleCommandPropertyGet(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_PROP_THREAD_CHILD_TABLE
+                            ));
 
             mChangedFlags &= ~static_cast<uint32_t>(OT_THREAD_CHILD_ADDED | OT_THREAD_CHILD_REMOVED);
         }
         else if ((mChangedFlags & OT_THREAD_NETDATA_UPDATED) != 0)
         {
             SuccessOrExit(
-                HandleCommandPropertyGet(
-                    SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                    SPINEL_PROP_THREAD_LEADER_NETWORK_DATA
-                ));
+                errorCode = HandleCommandPropertyGet(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_PROP_THREAD_LEADER_NETWORK_DATA
+                            ));
 
             mChangedFlags &= ~static_cast<uint32_t>(OT_THREAD_NETDATA_UPDATED);
 
@@ -1259,10 +1551,10 @@ void NcpBase::UpdateChangedProps(void)
         else if ((mChangedFlags & NCP_ON_MESH_NETS_CHANGED_BIT_FLAG) != 0)
         {
             SuccessOrExit(
-                HandleCommandPropertyGet(
-                    SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
-                    SPINEL_PROP_THREAD_ON_MESH_NETS
-                ));
+                errorCode = HandleCommandPropertyGet(
+                                SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0,
+                                SPINEL_PROP_THREAD_ON_MESH_NETS
+                            ));
 
             mChangedFlags &= ~static_cast<uint32_t>(NCP_ON_MESH_NETS_CHANGED_BIT_FLAG);
         }
@@ -1273,7 +1565,7 @@ void NcpBase::UpdateChangedProps(void)
     }
 
 exit:
-    return;
+    return errorCode;
 }
 
 // ----------------------------------------------------------------------------
@@ -1286,7 +1578,11 @@ otError NcpBase::OutboundFrameSend(void)
 
     SuccessOrExit(errorCode = OutboundFrameEnd());
 
-    mTxSpinelFrameCounter++;
+    // Within a batched frame, this only ends one property/value pair.
+    if (mBatchState == kBatchStateIdle)
+    {
+        mTxSpinelFrameCounter++;
+    }
 
 exit:
     return errorCode;
@@ -1479,9 +1775,130 @@ void NcpBase::IncrementFrameErrorCounter(void)
 // MARK: Inbound Command Handlers
 // ----------------------------------------------------------------------------
 
-otError NcpBase::HandleCommand(uint8_t header, unsigned int command, const uint8_t *arg_ptr, uint16_t arg_len)
+const NcpBase::CommandHandlerEntry *NcpBase::FindCommandHandler(unsigned int aCommand)
+{
+    const CommandHandlerEntry *entry = NULL;
+    uint16_t low = 0;
+    uint16_t high = sizeof(mCommandHandlerTable) / sizeof(mCommandHandlerTable[0]);
+
+    while (low < high)
+    {
+        uint16_t mid = (low + high) / 2;
+
+        if (aCommand < mCommandHandlerTable[mid].mCommand)
+        {
+            high = mid;
+        }
+        else if (aCommand > mCommandHandlerTable[mid].mCommand)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            entry = &mCommandHandlerTable[mid];
+            break;
+        }
+    }
+
+    return entry;
+}
+
+const NcpBase::GetPropertyHandlerEntry *NcpBase::FindGetPropertyHandler(spinel_prop_key_t aKey)
+{
+    const GetPropertyHandlerEntry *entry = NULL;
+    uint16_t low = 0;
+    uint16_t high = sizeof(mGetPropertyHandlerTable) / sizeof(mGetPropertyHandlerTable[0]);
+
+    while (low < high)
+    {
+        uint16_t mid = (low + high) / 2;
+
+        if (aKey < mGetPropertyHandlerTable[mid].mPropKey)
+        {
+            high = mid;
+        }
+        else if (aKey > mGetPropertyHandlerTable[mid].mPropKey)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            entry = &mGetPropertyHandlerTable[mid];
+            break;
+        }
+    }
+
+    return entry;
+}
+
+const NcpBase::SetPropertyHandlerEntry *NcpBase::FindSetPropertyHandler(const SetPropertyHandlerEntry *aTable,
+                                                                        uint16_t aTableLength, spinel_prop_key_t aKey)
+{
+    const SetPropertyHandlerEntry *entry = NULL;
+    uint16_t low = 0;
+    uint16_t high = aTableLength;
+
+    while (low < high)
+    {
+        uint16_t mid = (low + high) / 2;
+
+        if (aKey < aTable[mid].mPropKey)
+        {
+            high = mid;
+        }
+        else if (aKey > aTable[mid].mPropKey)
+        {
+            low = mid + 1;
+        }
+        else
+        {
+            entry = &aTable[mid];
+            break;
+        }
+    }
+
+    return entry;
+}
+
+bool NcpBase::AreHandlerTablesSorted(void)
 {
+    bool isSorted = true;
     unsigned i;
+
+    for (i = 1; i < sizeof(mCommandHandlerTable) / sizeof(mCommandHandlerTable[0]); i++)
+    {
+        VerifyOrExit(mCommandHandlerTable[i - 1].mCommand < mCommandHandlerTable[i].mCommand, isSorted = false);
+    }
+
+    for (i = 1; i < sizeof(mGetPropertyHandlerTable) / sizeof(mGetPropertyHandlerTable[0]); i++)
+    {
+        VerifyOrExit(mGetPropertyHandlerTable[i - 1].mPropKey < mGetPropertyHandlerTable[i].mPropKey, isSorted = false);
+    }
+
+    for (i = 1; i < sizeof(mSetPropertyHandlerTable) / sizeof(mSetPropertyHandlerTable[0]); i++)
+    {
+        VerifyOrExit(mSetPropertyHandlerTable[i - 1].mPropKey < mSetPropertyHandlerTable[i].mPropKey, isSorted = false);
+    }
+
+    for (i = 1; i < sizeof(mInsertPropertyHandlerTable) / sizeof(mInsertPropertyHandlerTable[0]); i++)
+    {
+        VerifyOrExit(mInsertPropertyHandlerTable[i - 1].mPropKey < mInsertPropertyHandlerTable[i].mPropKey,
+                     isSorted = false);
+    }
+
+    for (i = 1; i < sizeof(mRemovePropertyHandlerTable) / sizeof(mRemovePropertyHandlerTable[0]); i++)
+    {
+        VerifyOrExit(mRemovePropertyHandlerTable[i - 1].mPropKey < mRemovePropertyHandlerTable[i].mPropKey,
+                     isSorted = false);
+    }
+
+exit:
+    return isSorted;
+}
+
+otError NcpBase::HandleCommand(uint8_t header, unsigned int command, const uint8_t *arg_ptr, uint16_t arg_len)
+{
+    const CommandHandlerEntry *entry;
     otError errorCode = OT_ERROR_NONE;
 
     // Skip if this isn't a spinel frame
@@ -1493,17 +1910,11 @@ otError NcpBase::HandleCommand(uint8_t header, unsigned int command, const uint8
         errorCode = SendLastStatus(header, SPINEL_STATUS_INVALID_INTERFACE)
     );
 
-    for (i = 0; i < sizeof(mCommandHandlerTable) / sizeof(mCommandHandlerTable[0]); i++)
-    {
-        if (mCommandHandlerTable[i].mCommand == command)
-        {
-            break;
-        }
-    }
+    entry = FindCommandHandler(command);
 
-    if (i < sizeof(mCommandHandlerTable) / sizeof(mCommandHandlerTable[0]))
+    if (entry != NULL)
     {
-        errorCode = (this->*mCommandHandlerTable[i].mHandler)(header, command, arg_ptr, arg_len);
+        errorCode = (this->*entry->mHandler)(header, command, arg_ptr, arg_len);
     }
     else
     {
@@ -1516,20 +1927,12 @@ exit:
 
 otError NcpBase::HandleCommandPropertyGet(uint8_t header, spinel_prop_key_t key)
 {
-    unsigned i;
+    const GetPropertyHandlerEntry *entry = FindGetPropertyHandler(key);
     otError errorCode = OT_ERROR_NONE;
 
-    for (i = 0; i < sizeof(mGetPropertyHandlerTable) / sizeof(mGetPropertyHandlerTable[0]); i++)
-    {
-        if (mGetPropertyHandlerTable[i].mPropKey == key)
-        {
-            break;
-        }
-    }
-
-    if (i < sizeof(mGetPropertyHandlerTable) / sizeof(mGetPropertyHandlerTable[0]))
+    if (entry != NULL)
     {
-        errorCode = (this->*mGetPropertyHandlerTable[i].mHandler)(header, key);
+        errorCode = (this->*entry->mHandler)(header, key);
     }
     else
     {
@@ -1542,20 +1945,13 @@ otError NcpBase::HandleCommandPropertyGet(uint8_t header, spinel_prop_key_t key)
 otError NcpBase::HandleCommandPropertySet(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
                                           uint16_t value_len)
 {
-    unsigned i;
+    const SetPropertyHandlerEntry *entry = FindSetPropertyHandler(
+        mSetPropertyHandlerTable, sizeof(mSetPropertyHandlerTable) / sizeof(mSetPropertyHandlerTable[0]), key);
     otError errorCode = OT_ERROR_NONE;
 
-    for (i = 0; i < sizeof(mSetPropertyHandlerTable) / sizeof(mSetPropertyHandlerTable[0]); i++)
-    {
-        if (mSetPropertyHandlerTable[i].mPropKey == key)
-        {
-            break;
-        }
-    }
-
-    if (i < sizeof(mSetPropertyHandlerTable) / sizeof(mSetPropertyHandlerTable[0]))
+    if (entry != NULL)
     {
-        errorCode = (this->*mSetPropertyHandlerTable[i].mHandler)(header, key, value_ptr, value_len);
+        errorCode = (this->*entry->mHandler)(header, key, value_ptr, value_len);
     }
     else
     {
@@ -1568,20 +1964,13 @@ otError NcpBase::HandleCommandPropertySet(uint8_t header, spinel_prop_key_t key,
 otError NcpBase::HandleCommandPropertyInsert(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
                                              uint16_t value_len)
 {
-    unsigned i;
+    const InsertPropertyHandlerEntry *entry = FindSetPropertyHandler(
+        mInsertPropertyHandlerTable, sizeof(mInsertPropertyHandlerTable) / sizeof(mInsertPropertyHandlerTable[0]), key);
     otError errorCode = OT_ERROR_NONE;
 
-    for (i = 0; i < sizeof(mInsertPropertyHandlerTable) / sizeof(mInsertPropertyHandlerTable[0]); i++)
-    {
-        if (mInsertPropertyHandlerTable[i].mPropKey == key)
-        {
-            break;
-        }
-    }
-
-    if (i < sizeof(mInsertPropertyHandlerTable) / sizeof(mInsertPropertyHandlerTable[0]))
+    if (entry != NULL)
     {
-        errorCode = (this->*mInsertPropertyHandlerTable[i].mHandler)(header, key, value_ptr, value_len);
+        errorCode = (this->*entry->mHandler)(header, key, value_ptr, value_len);
     }
     else
     {
@@ -1594,20 +1983,13 @@ otError NcpBase::HandleCommandPropertyInsert(uint8_t header, spinel_prop_key_t k
 otError NcpBase::HandleCommandPropertyRemove(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
                                              uint16_t value_len)
 {
-    unsigned i;
+    const RemovePropertyHandlerEntry *entry = FindSetPropertyHandler(
+        mRemovePropertyHandlerTable, sizeof(mRemovePropertyHandlerTable) / sizeof(mRemovePropertyHandlerTable[0]), key);
     otError errorCode = OT_ERROR_NONE;
 
-    for (i = 0; i < sizeof(mRemovePropertyHandlerTable) / sizeof(mRemovePropertyHandlerTable[0]); i++)
-    {
-        if (mRemovePropertyHandlerTable[i].mPropKey == key)
-        {
-            break;
-        }
-    }
-
-    if (i < sizeof(mRemovePropertyHandlerTable) / sizeof(mRemovePropertyHandlerTable[0]))
+    if (entry != NULL)
     {
-        errorCode = (this->*mRemovePropertyHandlerTable[i].mHandler)(header, key, value_ptr, value_len);
+        errorCode = (this->*entry->mHandler)(header, key, value_ptr, value_len);
     }
     else
     {
@@ -1647,7 +2029,7 @@ otError NcpBase::SendPropertyUpdate(uint8_t header, uint8_t command, spinel_prop
 
     va_start(args, pack_format);
     SuccessOrExit(errorCode = OutboundFrameBegin());
-    SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_COMMAND_PROP_S, header, command, key));
+    SuccessOrExit(errorCode = OutboundFrameFeedCommandProp(header, command, key));
     SuccessOrExit(errorCode = OutboundFrameFeedVPacked(pack_format, args));
     SuccessOrExit(errorCode = OutboundFrameSend());
 
@@ -1662,7 +2044,7 @@ otError NcpBase::SendPropertyUpdate(uint8_t header, uint8_t command, spinel_prop
     otError errorCode = OT_ERROR_NONE;
 
     SuccessOrExit(errorCode = OutboundFrameBegin());
-    SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_COMMAND_PROP_S, header, command, key));
+    SuccessOrExit(errorCode = OutboundFrameFeedCommandProp(header, command, key));
     SuccessOrExit(errorCode = OutboundFrameFeedData(value_ptr, value_len));
     SuccessOrExit(errorCode = OutboundFrameSend());
 
@@ -1675,7 +2057,7 @@ otError NcpBase::SendPropertyUpdate(uint8_t header, uint8_t command, spinel_prop
     otError errorCode = OT_ERROR_NONE;
 
     SuccessOrExit(errorCode = OutboundFrameBegin());
-    SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_COMMAND_PROP_S, header, command, key));
+    SuccessOrExit(errorCode = OutboundFrameFeedCommandProp(header, command, key));
     SuccessOrExit(errorCode = OutboundFrameFeedMessage(aMessage));
 
     // Set the `aMessage` pointer to NULL to indicate that it does
@@ -1725,6 +2107,27 @@ otError NcpBase::OutboundFrameFeedPacked(const char *pack_format, ...)
     return errorCode;
 }
 
+otError NcpBase::OutboundFrameFeedCommandProp(uint8_t header, uint8_t command, spinel_prop_key_t key)
+{
+    // Spinel header, packed command and packed property key.
+    uint8_t buf[1 + 3 + 3];
+    SpinelEncoder encoder(buf, sizeof(buf));
+    otError errorCode;
+
+    SuccessOrExit(errorCode = encoder.WriteUint8(header));
+    SuccessOrExit(errorCode = encoder.WriteUintPacked(command));
+    SuccessOrExit(errorCode = encoder.WriteUintPacked(key));
+    errorCode = OutboundFrameFeedEncoded(encoder);
+
+exit:
+    return errorCode;
+}
+
+otError NcpBase::OutboundFrameFeedEncoded(const SpinelEncoder &aEncoder)
+{
+    return OutboundFrameFeedData(aEncoder.GetBuffer(), aEncoder.GetLength());
+}
+
 // ----------------------------------------------------------------------------
 // MARK: Individual Command Handlers
 // ----------------------------------------------------------------------------
@@ -1757,6 +2160,10 @@ otError NcpBase::CommandHandler_RESET(uint8_t header, unsigned int command, cons
     // platform doesn't support resetting.
     // In such a case we fake it.
 
+    // The host needs to enable batching again after a reset.
+    mUnsolUpdateBatchingEnabled = false;
+    mUnsolUpdateTimer.Stop();
+
     otThreadSetEnabled(mInstance, false);
     otIp6SetEnabled(mInstance, false);
 
@@ -2013,6 +2420,8 @@ otError NcpBase::GetPropertyHandler_CAPS(uint8_t header, spinel_prop_key_t key)
     SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_UINT_PACKED_S, SPINEL_CAP_OOB_STEERING_DATA));
 #endif
 
+    SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_UINT_PACKED_S, SPINEL_CAP_UNSOL_UPDATE_BATCHING));
+
     // TODO: Somehow get the following capability from the radio.
     SuccessOrExit(
         errorCode = OutboundFrameFeedPacked(
@@ -2111,6 +2520,17 @@ otError NcpBase::GetPropertyHandler_HOST_POWER_STATE(uint8_t header, spinel_prop
            );
 }
 
+otError NcpBase::GetPropertyHandler_UNSOL_UPDATE_BATCHING(uint8_t header, spinel_prop_key_t key)
+{
+    return SendPropertyUpdate(
+               header,
+               SPINEL_CMD_PROP_VALUE_IS,
+               key,
+               SPINEL_DATATYPE_BOOL_S,
+               mUnsolUpdateBatchingEnabled
+           );
+}
+
 otError NcpBase::GetPropertyHandler_PHY_ENABLED(uint8_t header, spinel_prop_key_t key)
 {
     return SendPropertyUpdate(
@@ -2745,17 +3165,13 @@ otError NcpBase::GetPropertyHandler_THREAD_CHILD_TABLE(uint8_t header, spinel_pr
     otChildInfo childInfo;
     uint8_t maxChildren;
     uint8_t modeFlags;
+    uint8_t buf[kChildTableEntrySize];
+    SpinelEncoder encoder(buf, sizeof(buf));
 
     mDisableStreamWrite = true;
 
     SuccessOrExit(errorCode = OutboundFrameBegin());
-    SuccessOrExit(
-        errorCode = OutboundFrameFeedPacked(
-                        SPINEL_DATATYPE_COMMAND_PROP_S,
-                        header,
-                        SPINEL_CMD_PROP_VALUE_IS,
-                        key
-                    ));
+    SuccessOrExit(errorCode = OutboundFrameFeedCommandProp(header, SPINEL_CMD_PROP_VALUE_IS, key));
 
     maxChildren = otThreadGetMaxAllowedChildren(mInstance);
 
@@ -2790,29 +3206,21 @@ otError NcpBase::GetPropertyHandler_THREAD_CHILD_TABLE(uint8_t header, spinel_pr
             modeFlags |= kThreadMode_FullNetworkData;
         }
 
-        SuccessOrExit(
-            errorCode = OutboundFrameFeedPacked(
-                            SPINEL_DATATYPE_STRUCT_S(
-                                SPINEL_DATATYPE_EUI64_S         // EUI64 Address
-                                SPINEL_DATATYPE_UINT16_S        // Rloc16
-                                SPINEL_DATATYPE_UINT32_S        // Timeout
-                                SPINEL_DATATYPE_UINT32_S        // Age
-                                SPINEL_DATATYPE_UINT8_S         // Network Data Version
-                                SPINEL_DATATYPE_UINT8_S         // Link Quality In
-                                SPINEL_DATATYPE_INT8_S          // Average RSS
-                                SPINEL_DATATYPE_UINT8_S         // Mode (flags)
-                                SPINEL_DATATYPE_INT8_S          // Most recent RSS
-                            ),
-                            childInfo.mExtAddress.m8,
-                            childInfo.mRloc16,
-                            childInfo.mTimeout,
-                            childInfo.mAge,
-                            childInfo.mNetworkDataVersion,
-                            childInfo.mLinkQualityIn,
-                            childInfo.mAverageRssi,
-                            modeFlags,
-                            childInfo.mLastRssi
-                        ));
+        encoder.Reset();
+
+        SuccessOrExit(errorCode = encoder.OpenStruct());
+        SuccessOrExit(errorCode = encoder.WriteEui64(childInfo.mExtAddress.m8));      // EUI64 Address
+        SuccessOrExit(errorCode = encoder.WriteUint16(childInfo.mRloc16));            // Rloc16
+        SuccessOrExit(errorCode = encoder.WriteUint32(childInfo.mTimeout));           // Timeout
+        SuccessOrExit(errorCode = encoder.WriteUint32(childInfo.mAge));               // Age
+        SuccessOrExit(errorCode = encoder.WriteUint8(childInfo.mNetworkDataVersion)); // Network Data Version
+        SuccessOrExit(errorCode = encoder.WriteUint8(childInfo.mLinkQualityIn));      // Link Quality In
+        SuccessOrExit(errorCode = encoder.WriteInt8(childInfo.mAverageRssi));         // Average RSS
+        SuccessOrExit(errorCode = encoder.WriteUint8(modeFlags));                     // Mode (flags)
+        SuccessOrExit(errorCode = encoder.WriteInt8(childInfo.mLastRssi));            // Most recent RSS
+        SuccessOrExit(errorCode = encoder.CloseStruct());
+
+        SuccessOrExit(errorCode = OutboundFrameFeedEncoded(encoder));
     }
 
     SuccessOrExit(errorCode = OutboundFrameSend());
@@ -2829,12 +3237,13 @@ otError NcpBase::GetPropertyHandler_THREAD_NEIGHBOR_TABLE(uint8_t header, spinel
     otNeighborInfoIterator iter = OT_NEIGHBOR_INFO_ITERATOR_INIT;
     otNeighborInfo neighInfo;
     uint8_t modeFlags;
+    uint8_t buf[kNeighborTableEntrySize];
+    SpinelEncoder encoder(buf, sizeof(buf));
 
     mDisableStreamWrite = true;
 
     SuccessOrExit(errorCode = OutboundFrameBegin());
-    SuccessOrExit(errorCode = OutboundFrameFeedPacked(SPINEL_DATATYPE_COMMAND_PROP_S, header, SPINEL_CMD_PROP_VALUE_IS,
-                                                      key));
+    SuccessOrExit(errorCode = OutboundFrameFeedCommandProp(header, SPINEL_CMD_PROP_VALUE_IS, key));
 
     while (otThreadGetNextNeighborInfo(mInstance, &iter, &neighInfo) == OT_ERROR_NONE)
     {
@@ -2860,31 +3269,22 @@ otError NcpBase::GetPropertyHandler_THREAD_NEIGHBOR_TABLE(uint8_t header, spinel
             modeFlags |= kThreadMode_FullNetworkData;
         }
 
-        SuccessOrExit(
-            errorCode = OutboundFrameFeedPacked(
-                            SPINEL_DATATYPE_STRUCT_S(
-                                SPINEL_DATATYPE_EUI64_S         // EUI64 Address
-                                SPINEL_DATATYPE_UINT16_S        // Rloc16
-                                SPINEL_DATATYPE_UINT32_S        // Age
-                                SPINEL_DATATYPE_UINT8_S         // Link Quality In
-                                SPINEL_DATATYPE_INT8_S          // Average RSS
-                                SPINEL_DATATYPE_UINT8_S         // Mode (flags)
-                                SPINEL_DATATYPE_BOOL_S          // Is Child
-                                SPINEL_DATATYPE_UINT32_S        // Link Frame Counter
-                                SPINEL_DATATYPE_UINT32_S        // MLE Frame Counter
-                                SPINEL_DATATYPE_INT8_S          // Most recent RSS
-                            ),
-                            neighInfo.mExtAddress.m8,
-                            neighInfo.mRloc16,
-                            neighInfo.mAge,
-                            neighInfo.mLinkQualityIn,
-                            neighInfo.mAverageRssi,
-                            modeFlags,
-                            neighInfo.mIsChild,
-                            neighInfo.mLinkFrameCounter,
-                            neighInfo.mMleFrameCounter,
-                            neighInfo.mLastRssi
-                        ));
+        encoder.Reset();
+
+        SuccessOrExit(errorCode = encoder.OpenStruct());
+        SuccessOrExit(errorCode = encoder.WriteEui64(neighInfo.mExtAddress.m8));      // EUI64 Address
+        SuccessOrExit(errorCode = encoder.WriteUint16(neighInfo.mRloc16));            // Rloc16
+        SuccessOrExit(errorCode = encoder.WriteUint32(neighInfo.mAge));               // Age
+        SuccessOrExit(errorCode = encoder.WriteUint8(neighInfo.mLinkQualityIn));      // Link Quality In
+        SuccessOrExit(errorCode = encoder.WriteInt8(neighInfo.mAverageRssi));         // Average RSS
+        SuccessOrExit(errorCode = encoder.WriteUint8(modeFlags));                     // Mode (flags)
+        SuccessOrExit(errorCode = encoder.WriteBool(neighInfo.mIsChild));             // Is Child
+        SuccessOrExit(errorCode = encoder.WriteUint32(neighInfo.mLinkFrameCounter));  // Link Frame Counter
+        SuccessOrExit(errorCode = encoder.WriteUint32(neighInfo.mMleFrameCounter));   // MLE Frame Counter
+        SuccessOrExit(errorCode = encoder.WriteInt8(neighInfo.mLastRssi));            // Most recent RSS
+        SuccessOrExit(errorCode = encoder.CloseStruct());
+
+        SuccessOrExit(errorCode = OutboundFrameFeedEncoded(encoder));
     }
 
     SuccessOrExit(errorCode = OutboundFrameSend());
@@ -3369,6 +3769,8 @@ otError NcpBase::GetPropertyHandler_MAC_CNTR(uint8_t header, spinel_prop_key_t k
     uint32_t value;
     const otMacCounters *macCounters;
     otError errorCode = OT_ERROR_NONE;
+    uint8_t buf[sizeof(uint32_t)];
+    SpinelEncoder encoder(buf, sizeof(buf));
 
     macCounters = otLinkGetCounters(mInstance);
 
@@ -3502,19 +3904,14 @@ otError NcpBase::GetPropertyHandler_MAC_CNTR(uint8_t header, spinel_prop_key_t k
 
     default:
         errorCode = SendLastStatus(header, SPINEL_STATUS_INTERNAL_ERROR);
-        goto bail;
+        ExitNow();
         break;
     }
 
-    errorCode = SendPropertyUpdate(
-                    header,
-                    SPINEL_CMD_PROP_VALUE_IS,
-                    key,
-                    SPINEL_DATATYPE_UINT32_S,
-                    value
-                );
+    SuccessOrExit(errorCode = encoder.WriteUint32(value));
+    errorCode = SendPropertyUpdate(header, SPINEL_CMD_PROP_VALUE_IS, key, encoder.GetBuffer(), encoder.GetLength());
 
-bail:
+exit:
     return errorCode;
 }
 
@@ -3522,6 +3919,8 @@ otError NcpBase::GetPropertyHandler_NCP_CNTR(uint8_t header, spinel_prop_key_t k
 {
     uint32_t value;
     otError errorCode = OT_ERROR_NONE;
+    uint8_t buf[sizeof(uint32_t)];
+    SpinelEncoder encoder(buf, sizeof(buf));
 
     switch (key)
     {
@@ -3567,19 +3966,14 @@ otError NcpBase::GetPropertyHandler_NCP_CNTR(uint8_t header, spinel_prop_key_t k
 
     default:
         errorCode = SendLastStatus(header, SPINEL_STATUS_INTERNAL_ERROR);
-        goto bail;
+        ExitNow();
         break;
     }
 
-    errorCode = SendPropertyUpdate(
-                    header,
-                    SPINEL_CMD_PROP_VALUE_IS,
-                    key,
-                    SPINEL_DATATYPE_UINT32_S,
-                    value
-                );
+    SuccessOrExit(errorCode = encoder.WriteUint32(value));
+    errorCode = SendPropertyUpdate(header, SPINEL_CMD_PROP_VALUE_IS, key, encoder.GetBuffer(), encoder.GetLength());
 
-bail:
+exit:
     return errorCode;
 }
 
@@ -3587,55 +3981,31 @@ otError NcpBase::GetPropertyHandler_MSG_BUFFER_COUNTERS(uint8_t header, spinel_p
 {
     otError errorCode = OT_ERROR_NONE;
     otBufferInfo bufferInfo;
+    uint8_t buf[16 * sizeof(uint16_t)];
+    SpinelEncoder encoder(buf, sizeof(buf));
 
     otMessageGetBufferInfo(mInstance, &bufferInfo);
 
     SuccessOrExit(errorCode = OutboundFrameBegin());
-    SuccessOrExit(
-        errorCode = OutboundFrameFeedPacked(
-                        SPINEL_DATATYPE_COMMAND_PROP_S,
-                        header,
-                        SPINEL_CMD_PROP_VALUE_IS,
-                        key
-                    ));
-
-    SuccessOrExit(
-        errorCode = OutboundFrameFeedPacked(
-                        (
-                            SPINEL_DATATYPE_UINT16_S    // Total buffers
-                            SPINEL_DATATYPE_UINT16_S    // Free buffers
-                            SPINEL_DATATYPE_UINT16_S    // Lowpan send messages
-                            SPINEL_DATATYPE_UINT16_S    // Lowpan send buffers
-                            SPINEL_DATATYPE_UINT16_S    // Lowpan reassembly messages
-                            SPINEL_DATATYPE_UINT16_S    // Lowpan reassembly buffers
-                            SPINEL_DATATYPE_UINT16_S    // Ip6 messages
-                            SPINEL_DATATYPE_UINT16_S    // Ip6 buffers
-                            SPINEL_DATATYPE_UINT16_S    // Mpl messages
-                            SPINEL_DATATYPE_UINT16_S    // Mpl buffers
-                            SPINEL_DATATYPE_UINT16_S    // Mle messages
-                            SPINEL_DATATYPE_UINT16_S    // Mle buffers
-                            SPINEL_DATATYPE_UINT16_S    // Arp messages
-                            SPINEL_DATATYPE_UINT16_S    // Arp buffers
-                            SPINEL_DATATYPE_UINT16_S    // Coap messages
-                            SPINEL_DATATYPE_UINT16_S    // Coap buffers
-                        ),
-                        bufferInfo.mTotalBuffers,
-                        bufferInfo.mFreeBuffers,
-                        bufferInfo.m6loSendMessages,
-                        bufferInfo.m6loSendBuffers,
-                        bufferInfo.m6loReassemblyMessages,
-                        bufferInfo.m6loReassemblyBuffers,
-                        bufferInfo.mIp6Messages,
-                        bufferInfo.mIp6Buffers,
-                        bufferInfo.mMplMessages,
-                        bufferInfo.mMplBuffers,
-                        bufferInfo.mMleMessages,
-                        bufferInfo.mMleBuffers,
-                        bufferInfo.mArpMessages,
-                        bufferInfo.mArpBuffers,
-                        bufferInfo.mCoapMessages,
-                        bufferInfo.mCoapBuffers
-                    ));
+    SuccessOrExit(errorCode = OutboundFrameFeedCommandProp(header, SPINEL_CMD_PROP_VALUE_IS, key));
+
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mTotalBuffers));           // Total buffers
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mFreeBuffers));            // Free buffers
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.m6loSendMessages));        // Lowpan send messages
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.m6loSendBuffers));         // Lowpan send buffers
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.m6loReassemblyMessages));  // Lowpan reassembly messages
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.m6loReassemblyBuffers));   // Lowpan reassembly buffers
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mIp6Messages));            // Ip6 messages
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mIp6Buffers));             // Ip6 buffers
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mMplMessages));            // Mpl messages
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mMplBuffers));             // Mpl buffers
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mMleMessages));            // Mle messages
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mMleBuffers));             // Mle buffers
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mArpMessages));            // Arp messages
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mArpBuffers));             // Arp buffers
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mCoapMessages));           // Coap messages
+    SuccessOrExit(errorCode = encoder.WriteUint16(bufferInfo.mCoapBuffers));            // Coap buffers
+    SuccessOrExit(errorCode = OutboundFrameFeedEncoded(encoder));
 
     SuccessOrExit(errorCode = OutboundFrameSend());
 
@@ -4040,6 +4410,41 @@ otError NcpBase::SetPropertyHandler_HOST_POWER_STATE(uint8_t header, spinel_prop
     return errorCode;
 }
 
+otError NcpBase::SetPropertyHandler_UNSOL_UPDATE_BATCHING(uint8_t header, spinel_prop_key_t key,
+                                                         const uint8_t *value_ptr, uint16_t value_len)
+{
+    bool isEnabled(false);
+    spinel_ssize_t parsedLength;
+    otError errorCode = OT_ERROR_NONE;
+
+    parsedLength = spinel_datatype_unpack(
+                       value_ptr,
+                       value_len,
+                       SPINEL_DATATYPE_BOOL_S,
+                       &isEnabled
+                   );
+
+    if (parsedLength > 0)
+    {
+        mUnsolUpdateBatchingEnabled = isEnabled;
+
+        if (!mUnsolUpdateBatchingEnabled && mUnsolUpdateTimer.IsRunning())
+        {
+            // Send the changes that were waiting for the coalescing window right away.
+            mUnsolUpdateTimer.Stop();
+            mUpdateChangedPropsTask.Post();
+        }
+
+        errorCode = HandleCommandPropertyGet(header, key);
+    }
+    else
+    {
+        errorCode = SendLastStatus(header, SPINEL_STATUS_PARSE_ERROR);
+    }
+
+    return errorCode;
+}
+
 #if OPENTHREAD_ENABLE_RAW_LINK_API
 
 otError NcpBase::SetPropertyHandler_PHY_ENABLED(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
@@ -5052,12 +5457,12 @@ otError NcpBase::SetPropertyHandler_THREAD_LOCAL_LEADER_WEIGHT(uint8_t header, s
 otError NcpBase::SetPropertyHandler_STREAM_NET_INSECURE(uint8_t header, spinel_prop_key_t key,
                                                         const uint8_t *value_ptr, uint16_t value_len)
 {
-    spinel_ssize_t parsedLength;
     otError errorCode = OT_ERROR_NONE;
+    SpinelDecoder decoder(value_ptr, value_len);
     const uint8_t *frame_ptr(NULL);
-    unsigned int frame_len(0);
+    uint16_t frame_len(0);
     const uint8_t *meta_ptr(NULL);
-    unsigned int meta_len(0);
+    uint16_t meta_len(0);
 
     // STREAM_NET_INSECURE packets are not secured at layer 2.
     otMessage *message = otIp6NewMessage(mInstance, false);
@@ -5068,26 +5473,18 @@ otError NcpBase::SetPropertyHandler_STREAM_NET_INSECURE(uint8_t header, spinel_p
     }
     else
     {
-        parsedLength = spinel_datatype_unpack(
-                           value_ptr,
-                           value_len,
-                           (
-                               SPINEL_DATATYPE_DATA_WLEN_S   // Frame data
-                               SPINEL_DATATYPE_DATA_S        // Meta data
-                           ),
-                           &frame_ptr,
-                           &frame_len,
-                           &meta_ptr,
-                           &meta_len
-                       );
+        errorCode = decoder.ReadDataWithLen(frame_ptr, frame_len);   // Frame data
 
-        // We ignore metadata for now.
-        // May later include TX power, allow retransmits, etc...
-        (void)meta_ptr;
-        (void)meta_len;
-        (void)parsedLength;
+        if (errorCode == OT_ERROR_NONE)
+        {
+            // We ignore metadata for now.
+            // May later include TX power, allow retransmits, etc...
+            decoder.ReadData(meta_ptr, meta_len);                   // Meta data
+            (void)meta_ptr;
+            (void)meta_len;
 
-        errorCode = otMessageAppend(message, frame_ptr, static_cast<uint16_t>(frame_len));
+            errorCode = otMessageAppend(message, frame_ptr, frame_len);
+        }
     }
 
     if (errorCode == OT_ERROR_NONE)
@@ -5201,12 +5598,12 @@ otError NcpBase::SetPropertyHandler_THREAD_BA_PROXY_STREAM(uint8_t header, spine
 otError NcpBase::SetPropertyHandler_STREAM_NET(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
                                                uint16_t value_len)
 {
-    spinel_ssize_t parsedLength;
     otError errorCode = OT_ERROR_NONE;
+    SpinelDecoder decoder(value_ptr, value_len);
     const uint8_t *frame_ptr(NULL);
-    unsigned int frame_len(0);
+    uint16_t frame_len(0);
     const uint8_t *meta_ptr(NULL);
-    unsigned int meta_len(0);
+    uint16_t meta_len(0);
 
     // STREAM_NET requires layer 2 security.
     otMessage *message = otIp6NewMessage(mInstance, true);
@@ -5217,26 +5614,18 @@ otError NcpBase::SetPropertyHandler_STREAM_NET(uint8_t header, spinel_prop_key_t
     }
     else
     {
-        parsedLength = spinel_datatype_unpack(
-                           value_ptr,
-                           value_len,
-                           (
-                               SPINEL_DATATYPE_DATA_WLEN_S  // Frame data
-                               SPINEL_DATATYPE_DATA_S       // Meta data
-                           ),
-                           &frame_ptr,
-                           &frame_len,
-                           &meta_ptr,
-                           &meta_len
-                       );
+        errorCode = decoder.ReadDataWithLen(frame_ptr, frame_len);   // Frame data
 
-        // We ignore metadata for now.
-        // May later include TX power, allow retransmits, etc...
-        (void)meta_ptr;
-        (void)meta_len;
-        (void)parsedLength;
+        if (errorCode == OT_ERROR_NONE)
+        {
+            // We ignore metadata for now.
+            // May later include TX power, allow retransmits, etc...
+            decoder.ReadData(meta_ptr, meta_len);                   // Meta data
+            (void)meta_ptr;
+            (void)meta_len;
 
-        errorCode = otMessageAppend(message, frame_ptr, static_cast<uint16_t>(frame_len));
+            errorCode = otMessageAppend(message, frame_ptr, frame_len);
+        }
     }
 
     if (errorCode == OT_ERROR_NONE)
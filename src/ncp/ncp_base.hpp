@@ -47,7 +47,9 @@
 #include "openthread-core-config.h"
 #include "spinel.h"
 #include "common/tasklet.hpp"
+#include "common/timer.hpp"
 #include "ncp/ncp_buffer.hpp"
+#include "ncp/spinel_encoder.hpp"
 
 namespace ot {
 
@@ -210,6 +212,25 @@ private:
 
     void UpdateChangedProps(void);
 
+    otError SendChangedProps(void);
+
+    otError SendChangedPropsBatched(void);
+
+    void UpdateRequireJoinExistingNetwork(void);
+
+    otError BatchedItemBegin(void);
+
+    otError BatchedItemFeedData(const uint8_t *aDataBuffer, uint16_t aDataBufferLength);
+
+    otError BatchedItemFeedMessage(otMessage *aMessage);
+
+    otError BatchedItemEnd(void);
+
+    /**
+     * Trampoline for HandleUnsolUpdateTimer().
+     */
+    static void HandleUnsolUpdateTimer(void *aContext);
+
     /**
      * Trampoline for SendDoneTask().
      */
@@ -249,6 +270,10 @@ private:
 
     otError OutboundFrameFeedPacked(const char *pack_format, ...);
 
+    otError OutboundFrameFeedCommandProp(uint8_t header, uint8_t command, spinel_prop_key_t key);
+
+    otError OutboundFrameFeedEncoded(const SpinelEncoder &aEncoder);
+
     otError OutboundFrameFeedVPacked(const char *pack_format, va_list args);
 
 private:
@@ -305,24 +330,22 @@ private:
         SetPropertyHandlerType mHandler;
     };
 
-    struct InsertPropertyHandlerEntry
-    {
-        spinel_prop_key_t mPropKey;
-        SetPropertyHandlerType mHandler;
-    };
-
-    struct RemovePropertyHandlerEntry
-    {
-        spinel_prop_key_t mPropKey;
-        SetPropertyHandlerType mHandler;
-    };
+    typedef SetPropertyHandlerEntry InsertPropertyHandlerEntry;
+    typedef SetPropertyHandlerEntry RemovePropertyHandlerEntry;
 
+    // The handler tables are sorted by command/property key and searched with a binary search.
     static const CommandHandlerEntry mCommandHandlerTable[];
     static const GetPropertyHandlerEntry mGetPropertyHandlerTable[];
     static const SetPropertyHandlerEntry mSetPropertyHandlerTable[];
     static const InsertPropertyHandlerEntry mInsertPropertyHandlerTable[];
     static const RemovePropertyHandlerEntry mRemovePropertyHandlerTable[];
 
+    static const CommandHandlerEntry *FindCommandHandler(unsigned int aCommand);
+    static const GetPropertyHandlerEntry *FindGetPropertyHandler(spinel_prop_key_t aKey);
+    static const SetPropertyHandlerEntry *FindSetPropertyHandler(const SetPropertyHandlerEntry *aTable,
+                                                                 uint16_t aTableLength, spinel_prop_key_t aKey);
+    static bool AreHandlerTablesSorted(void);
+
     otError CommandHandler_NOOP(uint8_t header, unsigned int command, const uint8_t *arg_ptr, uint16_t arg_len);
     otError CommandHandler_RESET(uint8_t header, unsigned int command, const uint8_t *arg_ptr, uint16_t arg_len);
     otError CommandHandler_PROP_VALUE_GET(uint8_t header, unsigned int command, const uint8_t *arg_ptr,
@@ -352,6 +375,7 @@ private:
     otError GetPropertyHandler_HWADDR(uint8_t header, spinel_prop_key_t key);
     otError GetPropertyHandler_LOCK(uint8_t header, spinel_prop_key_t key);
     otError GetPropertyHandler_HOST_POWER_STATE(uint8_t header, spinel_prop_key_t key);
+    otError GetPropertyHandler_UNSOL_UPDATE_BATCHING(uint8_t header, spinel_prop_key_t key);
     otError GetPropertyHandler_PHY_ENABLED(uint8_t header, spinel_prop_key_t key);
     otError GetPropertyHandler_PHY_FREQ(uint8_t header, spinel_prop_key_t key);
     otError GetPropertyHandler_PHY_CHAN_SUPPORTED(uint8_t header, spinel_prop_key_t key);
@@ -454,6 +478,8 @@ private:
                                            uint16_t value_len);
     otError SetPropertyHandler_HOST_POWER_STATE(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
                                                 uint16_t value_len);
+    otError SetPropertyHandler_UNSOL_UPDATE_BATCHING(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
+                                                     uint16_t value_len);
     otError SetPropertyHandler_PHY_TX_POWER(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
                                             uint16_t value_len);
     otError SetPropertyHandler_PHY_CHAN(uint8_t header, spinel_prop_key_t key, const uint8_t *value_ptr,
@@ -666,6 +692,8 @@ private:
     enum
     {
         kTxBufferSize = OPENTHREAD_CONFIG_NCP_TX_BUFFER_SIZE,  // Tx Buffer size (used by mTxFrameBuffer).
+        kChildTableEntrySize = 2 + 8 + 2 + 4 + 4 + 1 + 1 + 1 + 1 + 1,          // Encoded child table entry.
+        kNeighborTableEntrySize = 2 + 8 + 2 + 4 + 1 + 1 + 1 + 1 + 4 + 4 + 1,   // Encoded neighbor table entry.
     };
 
     spinel_status_t mLastStatus;
@@ -677,6 +705,26 @@ private:
     uint16_t mDiscoveryScanPanId;
     Tasklet mUpdateChangedPropsTask;
     uint32_t mChangedFlags;
+
+    // While a batched unsolicited update frame is being built (see `SendChangedPropsBatched()`), the frames written by
+    // the property get handlers become the property/value pairs of a single `SPINEL_CMD_PROP_VALUES_ARE` frame:
+    // beginning a frame reserves the pair length, the spinel header and command are stripped, and ending the frame
+    // fills in the pair length.
+    enum BatchState
+    {
+        kBatchStateIdle,         // Not building a batched frame.
+        kBatchStateItemPending,  // Building a batched frame, no property value is being written.
+        kBatchStateItemHeader,   // Writing a property value, its spinel header and command are yet to be stripped.
+        kBatchStateItemValue,    // Writing a property value.
+    };
+
+    bool mUnsolUpdateBatchingEnabled;
+    bool mUnsolUpdateBatchFailed;
+    BatchState mBatchState;
+    uint8_t mBatchItemCount;
+    uint16_t mBatchItemPosition;
+    uint16_t mBatchItemLength;
+    Timer mUnsolUpdateTimer;
     bool mShouldSignalEndOfScan;
     spinel_host_power_state_t mHostPowerState;
     bool mHostPowerStateInProgress;
@@ -39,6 +39,7 @@
 #include "ncp_buffer.hpp"
 #include "utils/wrap_string.h"
 #include "common/code_utils.hpp"
+#include "common/message.hpp"
 
 namespace ot {
 
@@ -77,7 +78,7 @@ void NcpFrameBuffer::Clear(void)
 
     mReadMessage = NULL;
     mReadMessageOffset = 0;
-    mReadMessageTail = mMessageBuffer;
+    mReadMessageTail = NULL;
 
     // Free all messages in the queues.
 
@@ -326,6 +327,39 @@ otError NcpFrameBuffer::InFrameEnd(void)
     return OT_ERROR_NONE;
 }
 
+otError NcpFrameBuffer::InFrameGetPosition(uint16_t &aPosition)
+{
+    otError error = OT_ERROR_NONE;
+
+    // Begin a new segment (if not already in one) so that the position accounts for the segment header.
+    SuccessOrExit(error = InFrameBeginSegment());
+
+    aPosition = GetDistance(mWriteFrameStart, mWriteSegmentTail);
+
+exit:
+    return error;
+}
+
+otError NcpFrameBuffer::InFrameOverwrite(uint16_t aPosition, const uint8_t *aDataBuffer, uint16_t aDataBufferLength)
+{
+    otError error = OT_ERROR_NONE;
+    uint8_t *bufPtr;
+
+    VerifyOrExit(static_cast<uint32_t>(aPosition) + aDataBufferLength <=
+                 GetDistance(mWriteFrameStart, mWriteSegmentTail), error = OT_ERROR_INVALID_ARGS);
+
+    bufPtr = Advance(mWriteFrameStart, aPosition);
+
+    while (aDataBufferLength--)
+    {
+        *bufPtr = *aDataBuffer++;
+        bufPtr = Next(bufPtr);
+    }
+
+exit:
+    return error;
+}
+
 NcpFrameBuffer::FrameTag NcpFrameBuffer::InFrameGetLastTag(void) const
 {
     return mWriteFrameTag;
@@ -418,8 +452,8 @@ otError NcpFrameBuffer::OutFramePrepareMessage(void)
     // Reset the offset for reading the message.
     mReadMessageOffset = 0;
 
-    // Fill the content from current message into the message buffer.
-    SuccessOrExit(error = OutFrameFillMessageBuffer());
+    // Set up the read pointer to the first chunk of the message.
+    SuccessOrExit(error = OutFramePrepareMessageSpan());
 
     // If all successful, set the state to `InMessage`.
     mReadState = kReadStateInMessage;
@@ -428,29 +462,32 @@ exit:
     return error;
 }
 
-// This method fills content from current message into the message buffer. It returns OT_ERROR_NOT_FOUND if no more
-// content in the current message.
-otError NcpFrameBuffer::OutFrameFillMessageBuffer(void)
+// This method sets up the read pointer to the next contiguous chunk of the current message (directly in the message
+// buffers, without copying). It returns OT_ERROR_NOT_FOUND if no more content in the current message.
+otError NcpFrameBuffer::OutFramePrepareMessageSpan(void)
 {
     otError error = OT_ERROR_NONE;
-    int readLength;
+    const uint8_t *data;
+    uint16_t length;
 
     VerifyOrExit(mReadMessage != NULL, error = OT_ERROR_NOT_FOUND);
 
-    VerifyOrExit(mReadMessageOffset < otMessageGetLength(mReadMessage), error = OT_ERROR_NOT_FOUND);
+    {
+        Message::Cursor cursor(*static_cast<Message *>(mReadMessage), mReadMessageOffset);
 
-    // Read portion of current message from the offset into message buffer.
-    readLength = otMessageRead(mReadMessage, mReadMessageOffset, mMessageBuffer, sizeof(mMessageBuffer));
+        data = cursor.GetData(length);
+    }
 
-    VerifyOrExit(readLength > 0, error = OT_ERROR_NOT_FOUND);
+    VerifyOrExit(data != NULL, error = OT_ERROR_NOT_FOUND);
 
-    // Update the message offset, set up the message tail, and set read pointer to start of message buffer.
+    // Update the message offset, set up the message tail, and set read pointer to start of the chunk. The frame
+    // buffer owns the message, its content is only ever read through the read pointer.
 
-    mReadMessageOffset += readLength;
+    mReadMessageOffset += length;
 
-    mReadMessageTail = mMessageBuffer + readLength;
+    mReadPointer = const_cast<uint8_t *>(data);
 
-    mReadPointer = mMessageBuffer;
+    mReadMessageTail = mReadPointer + length;
 
 exit:
     return error;
@@ -476,33 +513,54 @@ bool NcpFrameBuffer::OutFrameHasEnded(void)
     return (mReadState == kReadStateDone);
 }
 
-uint8_t NcpFrameBuffer::OutFrameReadByte(void)
+const uint8_t *NcpFrameBuffer::OutFrameGetSpan(uint16_t &aLength) const
 {
-    otError error;
-    uint8_t retval = kReadByteAfterFrameHasEnded;
+    const uint8_t *span = NULL;
+
+    aLength = 0;
 
     switch (mReadState)
     {
     case kReadStateDone:
+        break;
+
+    case kReadStateInSegment:
 
-        retval = kReadByteAfterFrameHasEnded;
+        // The span ends at the segment tail or, if the segment wraps around, at the end of the buffer.
+        aLength = static_cast<uint16_t>(((mReadSegmentTail > mReadPointer) ? mReadSegmentTail : mBufferEnd) -
+                                        mReadPointer);
+        span = mReadPointer;
 
         break;
 
+    case kReadStateInMessage:
+
+        aLength = static_cast<uint16_t>(mReadMessageTail - mReadPointer);
+        span = mReadPointer;
+
+        break;
+    }
+
+    return span;
+}
+
+// This method moves the read pointer forward by the given number of bytes which must be within the current span.
+void NcpFrameBuffer::OutFrameMoveForward(uint16_t aLength)
+{
+    switch (mReadState)
+    {
+    case kReadStateDone:
+        break;
+
     case kReadStateInSegment:
 
-        // Read a byte from current read pointer and move the read pointer forward.
-        retval = *mReadPointer;
-        mReadPointer = Next(mReadPointer);
+        mReadPointer = Advance(mReadPointer, aLength);
 
         // Check if at end of current segment.
         if (mReadPointer == mReadSegmentTail)
         {
-            // Prepare any message associated with this segment.
-            error = OutFramePrepareMessage();
-
-            // If there is no message, move to next segment (if any).
-            if (error != OT_ERROR_NONE)
+            // Prepare any message associated with this segment. If there is no message, move to next segment (if any).
+            if (OutFramePrepareMessage() != OT_ERROR_NONE)
             {
                 OutFramePrepareSegment();
             }
@@ -512,18 +570,13 @@ uint8_t NcpFrameBuffer::OutFrameReadByte(void)
 
     case kReadStateInMessage:
 
-        // Read a byte from current read pointer and move the read pointer forward.
-        retval = *mReadPointer;
-        mReadPointer++;
+        mReadPointer += aLength;
 
-        // Check if at the end of content in message buffer.
+        // Check if at the end of current message chunk.
         if (mReadPointer == mReadMessageTail)
         {
-            // Fill more bytes from current message into message buffer.
-            error = OutFrameFillMessageBuffer();
-
-            // If no more bytes in the message, move to next segment (if any).
-            if (error != OT_ERROR_NONE)
+            // Move to the next chunk of the message. If no more bytes in the message, move to next segment (if any).
+            if (OutFramePrepareMessageSpan() != OT_ERROR_NONE)
             {
                 OutFramePrepareSegment();
             }
@@ -531,6 +584,37 @@ uint8_t NcpFrameBuffer::OutFrameReadByte(void)
 
         break;
     }
+}
+
+uint16_t NcpFrameBuffer::OutFrameSkip(uint16_t aLength)
+{
+    uint16_t skipped = 0;
+    uint16_t spanLength;
+
+    while (skipped < aLength && OutFrameGetSpan(spanLength) != NULL)
+    {
+        if (spanLength > aLength - skipped)
+        {
+            spanLength = aLength - skipped;
+        }
+
+        OutFrameMoveForward(spanLength);
+        skipped += spanLength;
+    }
+
+    return skipped;
+}
+
+uint8_t NcpFrameBuffer::OutFrameReadByte(void)
+{
+    uint8_t retval = kReadByteAfterFrameHasEnded;
+
+    if (mReadState != kReadStateDone)
+    {
+        // Read a byte from current read pointer and move the read pointer forward.
+        retval = *mReadPointer;
+        OutFrameMoveForward(1);
+    }
 
     return retval;
 }
@@ -538,10 +622,19 @@ uint8_t NcpFrameBuffer::OutFrameReadByte(void)
 uint16_t NcpFrameBuffer::OutFrameRead(uint16_t aReadLength, uint8_t *aDataBuffer)
 {
     uint16_t bytesRead = 0;
+    uint16_t spanLength;
+    const uint8_t *span;
 
-    for (bytesRead = 0; (bytesRead < aReadLength) && !OutFrameHasEnded(); bytesRead++)
+    while (bytesRead < aReadLength && (span = OutFrameGetSpan(spanLength)) != NULL)
     {
-        *aDataBuffer++ = OutFrameReadByte();
+        if (spanLength > aReadLength - bytesRead)
+        {
+            spanLength = aReadLength - bytesRead;
+        }
+
+        memcpy(aDataBuffer + bytesRead, span, spanLength);
+        OutFrameMoveForward(spanLength);
+        bytesRead += spanLength;
     }
 
     return bytesRead;
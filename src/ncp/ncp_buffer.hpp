@@ -153,6 +153,39 @@ public:
      */
     otError InFrameEnd(void);
 
+    /**
+     * This method gets the current write position within the input frame being written.
+     *
+     * The position is the offset (from the start of the frame) at which the next byte added by `InFrameFeedData()`
+     * will be written. It can later be passed to `InFrameOverwrite()`, e.g., to fill in a length field once the
+     * content following it is known.
+     *
+     * If no buffer space is available, this method will discard and clear the frame before returning an error status.
+     *
+     * @param[out] aPosition        A reference to output the current write position.
+     *
+     * @retval OT_ERROR_NONE      Successfully retrieved the write position.
+     * @retval OT_ERROR_NO_BUFS   Insufficient buffer space available.
+     *
+     */
+    otError InFrameGetPosition(uint16_t &aPosition);
+
+    /**
+     * This method overwrites data previously added to the current input frame being written.
+     *
+     * The range being overwritten must have been added by a single `InFrameFeedData()` call, starting at a position
+     * retrieved using `InFrameGetPosition()`.
+     *
+     * @param[in]  aPosition          The write position (from `InFrameGetPosition()`) to overwrite at.
+     * @param[in]  aDataBuffer        A pointer to data buffer.
+     * @param[in]  aDataBufferLength  The length of the data buffer.
+     *
+     * @retval OT_ERROR_NONE          Successfully overwrote the data.
+     * @retval OT_ERROR_INVALID_ARGS  The given range is not within the data written so far to the current frame.
+     *
+     */
+    otError InFrameOverwrite(uint16_t aPosition, const uint8_t *aDataBuffer, uint16_t aDataBufferLength);
+
     /**
      * This method returns the tag assigned to last successfully written/added frame to NcpBuffer (i.e., last input
      * frame for which `InFrameEnd()` was called and returned success status). The tag is a unique value (within
@@ -228,6 +261,37 @@ public:
      */
     uint16_t OutFrameRead(uint16_t aReadLength, uint8_t *aDataBuffer);
 
+    /**
+     * This method returns the next contiguous span of bytes from the current output frame without copying them.
+     *
+     * The NCP buffer maintains a read offset for the current output frame being read. This method returns a pointer
+     * to the bytes at the read offset. The span ends at the end of the current data segment, at the point where the
+     * segment wraps around the end of the buffer, or at the end of the current buffer of an appended message,
+     * whichever comes first. The read offset is not changed, `OutFrameSkip()` moves it forward past the bytes used.
+     *
+     * The returned pointer remains valid until the read offset is moved, the frame is removed or the buffer is
+     * cleared.
+     *
+     * @param[out] aLength            The number of bytes available at the returned pointer (zero if frame has ended).
+     *
+     * @returns    A pointer to the next bytes of the current output frame, or NULL if frame has ended.
+     *
+     */
+    const uint8_t *OutFrameGetSpan(uint16_t &aLength) const;
+
+    /**
+     * This method moves the read offset of the current output frame forward.
+     *
+     * If there are less bytes remaining in current frame, the read offset is moved to the end of the frame. This
+     * method returns the actual number of bytes skipped.
+     *
+     * @param[in]  aLength            Number of bytes to skip.
+     *
+     * @returns    The number of bytes skipped.
+     *
+     */
+    uint16_t OutFrameSkip(uint16_t aLength);
+
     /**
      * This method removes the current/front output frame from the buffer.
      *
@@ -345,7 +409,6 @@ private:
     enum
     {
         kReadByteAfterFrameHasEnded        = 0,          // Value returned by ReadByte() when frame has ended.
-        kMessageReadBufferSize             = 16,         // Size of message buffer array.
         kUnknownFrameLength                = 0xffff,     // Value used when frame length is unknown.
         kSegmentHeaderSize                 = 2,          // Length of the segment header.
         kSegmentHeaderLengthMask           = 0x3fff,     // Bit mask to get the length from the segment header
@@ -379,7 +442,8 @@ private:
     otError         OutFramePrepareSegment(void);
     void            OutFrameMoveToNextSegment(void);
     otError         OutFramePrepareMessage(void);
-    otError         OutFrameFillMessageBuffer(void);
+    otError         OutFramePrepareMessageSpan(void);
+    void            OutFrameMoveForward(uint16_t aLength);
 
     uint8_t * const  mBuffer;                    // Pointer to the buffer used to store the data.
     uint8_t * const  mBufferEnd;                 // Points to after the end of buffer.
@@ -404,13 +468,12 @@ private:
     uint8_t *        mReadFrameStart;            // Pointer to start of current frame being read.
     uint8_t *        mReadSegmentHead;           // Pointer to start of current segment in the frame being read.
     uint8_t *        mReadSegmentTail;           // Pointer to end of current segment in the frame being read.
-    uint8_t *        mReadPointer;               // Pointer to next byte to read (either in segment or in msg buffer).
+    uint8_t *        mReadPointer;               // Pointer to next byte to read (either in segment or in message).
 
     otMessage *      mReadMessage;               // Current Message in the frame being read.
     uint16_t         mReadMessageOffset;         // Offset within current message being read.
 
-    uint8_t          mMessageBuffer[kMessageReadBufferSize];   // Buffer to hold part of current message being read.
-    uint8_t *        mReadMessageTail;           // Pointer to end of current part in mMessageBuffer.
+    uint8_t *        mReadMessageTail;           // Pointer to end of current chunk of the message being read.
 };
 
 }  // namespace ot
@@ -160,6 +160,26 @@ void NcpUart::EncodeAndSendToUart(void)
 
             while (!mTxFrameBuffer.OutFrameHasEnded())
             {
+                // Encode the frame directly from the frame buffer, a span at a time, as long as the span fits even
+                // if every byte needs escaping. Once the uart buffer is almost full, bytes are encoded one at a time
+                // (so that a byte can be retried after send done).
+                len = mUartBuffer.GetRemainingLength() / 2;
+
+                if (len > 0)
+                {
+                    uint16_t spanLength;
+                    const uint8_t *span = mTxFrameBuffer.OutFrameGetSpan(spanLength);
+
+                    if (len > spanLength)
+                    {
+                        len = spanLength;
+                    }
+
+                    SuccessOrExit(mFrameEncoder.Encode(span, len, mUartBuffer));
+                    mTxFrameBuffer.OutFrameSkip(len);
+                    continue;
+                }
+
                 mByte = mTxFrameBuffer.OutFrameReadByte();
 
             case kEncodingFrame:
@@ -1304,6 +1304,10 @@ spinel_prop_key_to_cstr(spinel_prop_key_t prop_key)
         ret = "PROP_GPIO_STATE_CLEAR";
         break;
 
+    case SPINEL_PROP_UNSOL_UPDATE_BATCHING:
+        ret = "PROP_UNSOL_UPDATE_BATCHING";
+        break;
+
     case SPINEL_PROP_CNTR_RESET:
         ret = "PROP_CNTR_RESET";
         break;
@@ -1799,6 +1803,10 @@ const char *spinel_capability_to_cstr(unsigned int capability)
         ret = "CAP_OOB_STEERING_DATA";
         break;
 
+    case SPINEL_CAP_UNSOL_UPDATE_BATCHING:
+        ret = "CAP_UNSOL_UPDATE_BATCHING";
+        break;
+
     case SPINEL_CAP_THREAD_COMMISSIONER:
         ret = "CAP_THREAD_COMMISSIONER";
         break;
@@ -374,6 +374,7 @@ enum
     SPINEL_CAP_MAC_WHITELIST            = (SPINEL_CAP_OPENTHREAD__BEGIN + 0),
     SPINEL_CAP_MAC_RAW                  = (SPINEL_CAP_OPENTHREAD__BEGIN + 1),
     SPINEL_CAP_OOB_STEERING_DATA        = (SPINEL_CAP_OPENTHREAD__BEGIN + 2),
+    SPINEL_CAP_UNSOL_UPDATE_BATCHING    = (SPINEL_CAP_OPENTHREAD__BEGIN + 3),
     SPINEL_CAP_OPENTHREAD__END          = 640,
 
     SPINEL_CAP_THREAD__BEGIN            = 1024,
@@ -531,6 +532,17 @@ typedef enum
     /// Raw samples from TRNG entropy source representing 32 bits of entropy.
     SPINEL_PROP_TRNG_RAW_32             = SPINEL_PROP_BASE_EXT__BEGIN + 7,
 
+    /// Unsolicited update batching enable
+    /** Format: `b`
+     *
+     * Required capability: SPINEL_CAP_UNSOL_UPDATE_BATCHING.
+     *
+     * When enabled, the NCP packs all pending unsolicited property updates
+     * into a single `CMD_PROP_VALUES_ARE` frame instead of sending one
+     * `CMD_PROP_VALUE_IS` frame per property. Disabled after reset.
+     */
+    SPINEL_PROP_UNSOL_UPDATE_BATCHING   = SPINEL_PROP_BASE_EXT__BEGIN + 10,
+
     SPINEL_PROP_BASE_EXT__END           = 0x1100,
 
     SPINEL_PROP_PHY__BEGIN              = 0x20,
@@ -0,0 +1,218 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+ *    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ *    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * @file
+ *   This file implements the typed spinel encoder and decoder.
+ */
+
+#include "spinel_encoder.hpp"
+
+namespace ot {
+
+otError SpinelEncoder::WriteUintPacked(unsigned int aUint)
+{
+    otError error = OT_ERROR_NONE;
+    uint8_t size = 1;
+
+    VerifyOrExit(aUint < SPINEL_MAX_UINT_PACKED, error = OT_ERROR_INVALID_ARGS);
+
+    for (unsigned int value = aUint >> 7; value != 0; value >>= 7)
+    {
+        size++;
+    }
+
+    VerifyOrExit(size <= mEnd - mCursor, error = OT_ERROR_NO_BUFS);
+
+    for (; size > 1; size--)
+    {
+        *mCursor++ = static_cast<uint8_t>((aUint & 0x7f) | 0x80);
+        aUint >>= 7;
+    }
+
+    *mCursor++ = static_cast<uint8_t>(aUint);
+
+exit:
+    return error;
+}
+
+otError SpinelEncoder::WriteUtf8(const char *aUtf8)
+{
+    if (aUtf8 == NULL)
+    {
+        aUtf8 = "";
+    }
+
+    return WriteData(aUtf8, static_cast<uint16_t>(strlen(aUtf8) + 1));
+}
+
+otError SpinelEncoder::WriteDataWithLen(const void *aData, uint16_t aDataLength)
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(sizeof(uint16_t) + aDataLength <= static_cast<size_t>(mEnd - mCursor), error = OT_ERROR_NO_BUFS);
+
+    SuccessOrExit(error = WriteUint16(aDataLength));
+    SuccessOrExit(error = WriteData(aData, aDataLength));
+
+exit:
+    return error;
+}
+
+otError SpinelEncoder::OpenStruct(void)
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(mNumOpenStructs < kMaxNestedStructs, error = OT_ERROR_NO_BUFS);
+    VerifyOrExit(mCursor + sizeof(uint16_t) <= mEnd, error = OT_ERROR_NO_BUFS);
+
+    mCursor += sizeof(uint16_t);
+    mStructStart[mNumOpenStructs++] = mCursor;
+
+exit:
+    return error;
+}
+
+otError SpinelEncoder::CloseStruct(void)
+{
+    otError error = OT_ERROR_NONE;
+    uint8_t *start;
+    uint16_t length;
+
+    VerifyOrExit(mNumOpenStructs > 0, error = OT_ERROR_INVALID_STATE);
+
+    start = mStructStart[--mNumOpenStructs];
+    length = static_cast<uint16_t>(mCursor - start);
+    start[-2] = static_cast<uint8_t>(length >> 0);
+    start[-1] = static_cast<uint8_t>(length >> 8);
+
+exit:
+    return error;
+}
+
+otError SpinelDecoder::ReadUintPacked(unsigned int &aUint)
+{
+    otError error = OT_ERROR_NONE;
+    const uint8_t *cursor = mCursor;
+    uint32_t value = 0;
+    uint8_t shift = 0;
+    uint8_t byte;
+
+    do
+    {
+        // A packed value below `SPINEL_MAX_UINT_PACKED` needs at most three bytes, allow padded encodings up to the
+        // width of a 32-bit value.
+        VerifyOrExit(cursor < mEnd && shift < 32, error = OT_ERROR_PARSE);
+
+        byte = *cursor++;
+        value |= static_cast<uint32_t>(byte & 0x7f) << shift;
+        shift += 7;
+    }
+    while (byte & 0x80);
+
+    VerifyOrExit(value < SPINEL_MAX_UINT_PACKED, error = OT_ERROR_PARSE);
+
+    aUint = value;
+    mCursor = cursor;
+
+exit:
+    return error;
+}
+
+otError SpinelDecoder::ReadUtf8(const char *&aUtf8)
+{
+    otError error = OT_ERROR_NONE;
+    const uint8_t *terminator = static_cast<const uint8_t *>(memchr(mCursor, 0, GetRemainingLength()));
+
+    VerifyOrExit(terminator != NULL, error = OT_ERROR_PARSE);
+
+    aUtf8 = reinterpret_cast<const char *>(mCursor);
+    mCursor = terminator + 1;
+
+exit:
+    return error;
+}
+
+otError SpinelDecoder::ReadDataWithLen(const uint8_t *&aData, uint16_t &aDataLength)
+{
+    otError error = OT_ERROR_NONE;
+    const uint8_t *start = mCursor;
+    uint16_t length;
+
+    SuccessOrExit(error = ReadUint16(length));
+
+    if (length >= SPINEL_FRAME_MAX_SIZE || length > mEnd - mCursor)
+    {
+        mCursor = start;
+        ExitNow(error = OT_ERROR_PARSE);
+    }
+
+    aData = mCursor;
+    aDataLength = length;
+    mCursor += length;
+
+exit:
+    return error;
+}
+
+otError SpinelDecoder::OpenStruct(void)
+{
+    otError error = OT_ERROR_NONE;
+    const uint8_t *start = mCursor;
+    uint16_t length;
+
+    VerifyOrExit(mNumOpenStructs < kMaxNestedStructs, error = OT_ERROR_PARSE);
+    SuccessOrExit(error = ReadUint16(length));
+
+    if (length >= SPINEL_FRAME_MAX_SIZE || length > mEnd - mCursor)
+    {
+        mCursor = start;
+        ExitNow(error = OT_ERROR_PARSE);
+    }
+
+    mStructEnd[mNumOpenStructs++] = mEnd;
+    mEnd = mCursor + length;
+
+exit:
+    return error;
+}
+
+otError SpinelDecoder::CloseStruct(void)
+{
+    otError error = OT_ERROR_NONE;
+
+    VerifyOrExit(mNumOpenStructs > 0, error = OT_ERROR_INVALID_STATE);
+
+    mCursor = mEnd;
+    mEnd = mStructEnd[--mNumOpenStructs];
+
+exit:
+    return error;
+}
+
+}  // namespace ot
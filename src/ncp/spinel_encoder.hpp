@@ -0,0 +1,636 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+ *    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ *    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+/**
+ * @file
+ *   This file contains definitions of the typed spinel encoder and decoder.
+ *
+ *   `SpinelEncoder` and `SpinelDecoder` produce and consume exactly the same byte layout as
+ *   `spinel_datatype_pack()` and `spinel_datatype_unpack()`, but each field is written or read by a dedicated
+ *   inline method instead of by interpreting a format string through a `va_list`.
+ */
+
+#ifndef SPINEL_ENCODER_HPP_
+#define SPINEL_ENCODER_HPP_
+
+#include <string.h>
+
+#include <openthread/types.h>
+
+#include "spinel.h"
+#include "common/code_utils.hpp"
+
+namespace ot {
+
+/**
+ * This class implements a typed spinel encoder writing into a caller-provided buffer.
+ *
+ * Each `Write` method corresponds to one spinel data type character (given in brackets) and emits the same bytes
+ * `spinel_datatype_pack()` would emit for it. A method returns `OT_ERROR_NO_BUFS` (and writes nothing) if the value
+ * does not fit in the remaining buffer space.
+ *
+ * Since the encoder knows the position of every item, a struct (`t(...)`) is written in a single pass: `OpenStruct()`
+ * reserves the 16-bit length which `CloseStruct()` fills in.
+ *
+ */
+class SpinelEncoder
+{
+public:
+    enum
+    {
+        kMaxNestedStructs = 4,  ///< Maximum number of nested structs.
+    };
+
+    /**
+     * This constructor initializes the encoder.
+     *
+     * @param[in]  aBuffer      A pointer to the output buffer.
+     * @param[in]  aBufferSize  The size of @p aBuffer in bytes.
+     *
+     */
+    SpinelEncoder(uint8_t *aBuffer, uint16_t aBufferSize):
+        mBuffer(aBuffer),
+        mCursor(aBuffer),
+        mEnd(aBuffer + aBufferSize),
+        mNumOpenStructs(0) {
+    }
+
+    /**
+     * This method returns a pointer to the start of the output buffer.
+     *
+     * @returns A pointer to the output buffer.
+     *
+     */
+    const uint8_t *GetBuffer(void) const { return mBuffer; }
+
+    /**
+     * This method returns the number of bytes written so far.
+     *
+     * @returns The encoded length in bytes.
+     *
+     */
+    uint16_t GetLength(void) const { return static_cast<uint16_t>(mCursor - mBuffer); }
+
+    /**
+     * This method discards everything written so far (including any open struct).
+     *
+     */
+    void Reset(void) { mCursor = mBuffer; mNumOpenStructs = 0; }
+
+    /**
+     * This method writes a boolean [b].
+     *
+     * @param[in]  aBool  The value to write.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteBool(bool aBool) { return WriteUint8(aBool ? 1 : 0); }
+
+    /**
+     * This method writes a `uint8_t` [C].
+     *
+     * @param[in]  aUint8  The value to write.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteUint8(uint8_t aUint8) {
+        otError error = OT_ERROR_NONE;
+
+        VerifyOrExit(mCursor + sizeof(uint8_t) <= mEnd, error = OT_ERROR_NO_BUFS);
+        *mCursor++ = aUint8;
+
+exit:
+        return error;
+    }
+
+    /**
+     * This method writes an `int8_t` [c].
+     *
+     * @param[in]  aInt8  The value to write.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteInt8(int8_t aInt8) { return WriteUint8(static_cast<uint8_t>(aInt8)); }
+
+    /**
+     * This method writes a `uint16_t` in little-endian order [S].
+     *
+     * @param[in]  aUint16  The value to write.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteUint16(uint16_t aUint16) {
+        otError error = OT_ERROR_NONE;
+
+        VerifyOrExit(mCursor + sizeof(uint16_t) <= mEnd, error = OT_ERROR_NO_BUFS);
+        mCursor[0] = static_cast<uint8_t>(aUint16 >> 0);
+        mCursor[1] = static_cast<uint8_t>(aUint16 >> 8);
+        mCursor += sizeof(uint16_t);
+
+exit:
+        return error;
+    }
+
+    /**
+     * This method writes an `int16_t` in little-endian order [s].
+     *
+     * @param[in]  aInt16  The value to write.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteInt16(int16_t aInt16) { return WriteUint16(static_cast<uint16_t>(aInt16)); }
+
+    /**
+     * This method writes a `uint32_t` in little-endian order [L].
+     *
+     * @param[in]  aUint32  The value to write.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteUint32(uint32_t aUint32) {
+        otError error = OT_ERROR_NONE;
+
+        VerifyOrExit(mCursor + sizeof(uint32_t) <= mEnd, error = OT_ERROR_NO_BUFS);
+        mCursor[0] = static_cast<uint8_t>(aUint32 >> 0);
+        mCursor[1] = static_cast<uint8_t>(aUint32 >> 8);
+        mCursor[2] = static_cast<uint8_t>(aUint32 >> 16);
+        mCursor[3] = static_cast<uint8_t>(aUint32 >> 24);
+        mCursor += sizeof(uint32_t);
+
+exit:
+        return error;
+    }
+
+    /**
+     * This method writes an `int32_t` in little-endian order [l].
+     *
+     * @param[in]  aInt32  The value to write.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteInt32(int32_t aInt32) { return WriteUint32(static_cast<uint32_t>(aInt32)); }
+
+    /**
+     * This method writes a packed unsigned integer [i].
+     *
+     * @param[in]  aUint  The value to write, must be less than `SPINEL_MAX_UINT_PACKED`.
+     *
+     * @retval OT_ERROR_NONE          Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS       Insufficient buffer space.
+     * @retval OT_ERROR_INVALID_ARGS  @p aUint is out of range.
+     *
+     */
+    otError WriteUintPacked(unsigned int aUint);
+
+    /**
+     * This method writes an IPv6 address [6].
+     *
+     * @param[in]  aIp6Addr  A pointer to the 16-byte address.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteIp6Address(const void *aIp6Addr) { return WriteData(aIp6Addr, sizeof(spinel_ipv6addr_t)); }
+
+    /**
+     * This method writes an EUI-64 [E].
+     *
+     * @param[in]  aEui64  A pointer to the 8-byte EUI-64.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteEui64(const void *aEui64) { return WriteData(aEui64, sizeof(spinel_eui64_t)); }
+
+    /**
+     * This method writes an EUI-48 [e].
+     *
+     * @param[in]  aEui48  A pointer to the 6-byte EUI-48.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteEui48(const void *aEui48) { return WriteData(aEui48, sizeof(spinel_eui48_t)); }
+
+    /**
+     * This method writes a UTF-8 string including its null terminator [U]. A NULL string is written as "".
+     *
+     * @param[in]  aUtf8  A pointer to a null-terminated string, or NULL.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteUtf8(const char *aUtf8);
+
+    /**
+     * This method writes raw data without a length prefix.
+     *
+     * This is the encoding of `D` when it is the last item of a frame or struct.
+     *
+     * @param[in]  aData        A pointer to the data.
+     * @param[in]  aDataLength  The number of bytes to write.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteData(const void *aData, uint16_t aDataLength) {
+        otError error = OT_ERROR_NONE;
+
+        VerifyOrExit(aDataLength <= mEnd - mCursor, error = OT_ERROR_NO_BUFS);
+        memcpy(mCursor, aData, aDataLength);
+        mCursor += aDataLength;
+
+exit:
+        return error;
+    }
+
+    /**
+     * This method writes data preceded by its 16-bit length [d].
+     *
+     * This is also the encoding of `D` when it is not the last item of a frame or struct.
+     *
+     * @param[in]  aData        A pointer to the data.
+     * @param[in]  aDataLength  The number of bytes to write.
+     *
+     * @retval OT_ERROR_NONE     Successfully wrote the value.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space.
+     *
+     */
+    otError WriteDataWithLen(const void *aData, uint16_t aDataLength);
+
+    /**
+     * This method starts a struct [t(...)] by reserving its 16-bit length.
+     *
+     * Every `OpenStruct()` must be matched by a `CloseStruct()`.
+     *
+     * @retval OT_ERROR_NONE     Successfully opened the struct.
+     * @retval OT_ERROR_NO_BUFS  Insufficient buffer space, or too many nested structs.
+     *
+     */
+    otError OpenStruct(void);
+
+    /**
+     * This method closes the innermost open struct and fills in its length.
+     *
+     * @retval OT_ERROR_NONE           Successfully closed the struct.
+     * @retval OT_ERROR_INVALID_STATE  There is no open struct.
+     *
+     */
+    otError CloseStruct(void);
+
+private:
+    uint8_t *mBuffer;
+    uint8_t *mCursor;
+    uint8_t *mEnd;
+    uint8_t *mStructStart[kMaxNestedStructs];
+    uint8_t mNumOpenStructs;
+};
+
+/**
+ * This class implements a typed spinel decoder reading from a caller-provided buffer.
+ *
+ * Each `Read` method consumes one item of the corresponding spinel data type. On failure a method returns
+ * `OT_ERROR_PARSE` and leaves the read position unchanged. Pointer outputs (addresses, strings, data) refer into the
+ * input buffer.
+ *
+ */
+class SpinelDecoder
+{
+public:
+    enum
+    {
+        kMaxNestedStructs = 4,  ///< Maximum number of nested structs.
+    };
+
+    /**
+     * This constructor initializes the decoder.
+     *
+     * @param[in]  aBuffer  A pointer to the input buffer.
+     * @param[in]  aLength  The number of bytes in @p aBuffer.
+     *
+     */
+    SpinelDecoder(const uint8_t *aBuffer, uint16_t aLength):
+        mBuffer(aBuffer),
+        mCursor(aBuffer),
+        mEnd(aBuffer + aLength),
+        mNumOpenStructs(0) {
+    }
+
+    /**
+     * This method returns the number of bytes read so far.
+     *
+     * @returns The number of bytes consumed from the start of the buffer.
+     *
+     */
+    uint16_t GetReadLength(void) const { return static_cast<uint16_t>(mCursor - mBuffer); }
+
+    /**
+     * This method returns the number of unread bytes in the innermost open struct (or in the buffer).
+     *
+     * @returns The remaining length in bytes.
+     *
+     */
+    uint16_t GetRemainingLength(void) const { return static_cast<uint16_t>(mEnd - mCursor); }
+
+    /**
+     * This method indicates whether all bytes of the innermost open struct (or of the buffer) have been read.
+     *
+     * @retval TRUE   No bytes remain.
+     * @retval FALSE  There are unread bytes.
+     *
+     */
+    bool IsAllRead(void) const { return mCursor == mEnd; }
+
+    /**
+     * This method reads a boolean [b].
+     *
+     * @param[out]  aBool  A reference to output the value.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  Not enough bytes remaining.
+     *
+     */
+    otError ReadBool(bool &aBool) {
+        otError error = OT_ERROR_NONE;
+
+        VerifyOrExit(mCursor + sizeof(uint8_t) <= mEnd, error = OT_ERROR_PARSE);
+        aBool = (*mCursor++ != 0);
+
+exit:
+        return error;
+    }
+
+    /**
+     * This method reads a `uint8_t` [C].
+     *
+     * @param[out]  aUint8  A reference to output the value.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  Not enough bytes remaining.
+     *
+     */
+    otError ReadUint8(uint8_t &aUint8) {
+        otError error = OT_ERROR_NONE;
+
+        VerifyOrExit(mCursor + sizeof(uint8_t) <= mEnd, error = OT_ERROR_PARSE);
+        aUint8 = *mCursor++;
+
+exit:
+        return error;
+    }
+
+    /**
+     * This method reads an `int8_t` [c].
+     *
+     * @param[out]  aInt8  A reference to output the value.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  Not enough bytes remaining.
+     *
+     */
+    otError ReadInt8(int8_t &aInt8) { return ReadUint8(reinterpret_cast<uint8_t &>(aInt8)); }
+
+    /**
+     * This method reads a little-endian `uint16_t` [S].
+     *
+     * @param[out]  aUint16  A reference to output the value.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  Not enough bytes remaining.
+     *
+     */
+    otError ReadUint16(uint16_t &aUint16) {
+        otError error = OT_ERROR_NONE;
+
+        VerifyOrExit(mCursor + sizeof(uint16_t) <= mEnd, error = OT_ERROR_PARSE);
+        aUint16 = static_cast<uint16_t>(mCursor[0] | (mCursor[1] << 8));
+        mCursor += sizeof(uint16_t);
+
+exit:
+        return error;
+    }
+
+    /**
+     * This method reads a little-endian `int16_t` [s].
+     *
+     * @param[out]  aInt16  A reference to output the value.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  Not enough bytes remaining.
+     *
+     */
+    otError ReadInt16(int16_t &aInt16) { return ReadUint16(reinterpret_cast<uint16_t &>(aInt16)); }
+
+    /**
+     * This method reads a little-endian `uint32_t` [L].
+     *
+     * @param[out]  aUint32  A reference to output the value.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  Not enough bytes remaining.
+     *
+     */
+    otError ReadUint32(uint32_t &aUint32) {
+        otError error = OT_ERROR_NONE;
+
+        VerifyOrExit(mCursor + sizeof(uint32_t) <= mEnd, error = OT_ERROR_PARSE);
+        aUint32 = static_cast<uint32_t>(mCursor[0]) |
+                  (static_cast<uint32_t>(mCursor[1]) << 8) |
+                  (static_cast<uint32_t>(mCursor[2]) << 16) |
+                  (static_cast<uint32_t>(mCursor[3]) << 24);
+        mCursor += sizeof(uint32_t);
+
+exit:
+        return error;
+    }
+
+    /**
+     * This method reads a little-endian `int32_t` [l].
+     *
+     * @param[out]  aInt32  A reference to output the value.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  Not enough bytes remaining.
+     *
+     */
+    otError ReadInt32(int32_t &aInt32) { return ReadUint32(reinterpret_cast<uint32_t &>(aInt32)); }
+
+    /**
+     * This method reads a packed unsigned integer [i].
+     *
+     * @param[out]  aUint  A reference to output the value.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  The encoding is truncated, malformed or out of range.
+     *
+     */
+    otError ReadUintPacked(unsigned int &aUint);
+
+    /**
+     * This method reads an IPv6 address [6].
+     *
+     * @param[out]  aIp6Addr  A reference to output a pointer to the address within the input buffer.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  Not enough bytes remaining.
+     *
+     */
+    otError ReadIp6Address(const spinel_ipv6addr_t *&aIp6Addr) {
+        return ReadItem(reinterpret_cast<const uint8_t *&>(aIp6Addr), sizeof(spinel_ipv6addr_t));
+    }
+
+    /**
+     * This method reads an EUI-64 [E].
+     *
+     * @param[out]  aEui64  A reference to output a pointer to the EUI-64 within the input buffer.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  Not enough bytes remaining.
+     *
+     */
+    otError ReadEui64(const spinel_eui64_t *&aEui64) {
+        return ReadItem(reinterpret_cast<const uint8_t *&>(aEui64), sizeof(spinel_eui64_t));
+    }
+
+    /**
+     * This method reads an EUI-48 [e].
+     *
+     * @param[out]  aEui48  A reference to output a pointer to the EUI-48 within the input buffer.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  Not enough bytes remaining.
+     *
+     */
+    otError ReadEui48(const spinel_eui48_t *&aEui48) {
+        return ReadItem(reinterpret_cast<const uint8_t *&>(aEui48), sizeof(spinel_eui48_t));
+    }
+
+    /**
+     * This method reads a null-terminated UTF-8 string [U].
+     *
+     * @param[out]  aUtf8  A reference to output a pointer to the string within the input buffer.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  No null terminator before the end of the remaining bytes.
+     *
+     */
+    otError ReadUtf8(const char *&aUtf8);
+
+    /**
+     * This method reads all remaining bytes of the innermost open struct (or of the buffer).
+     *
+     * This is the decoding of `D` when it is the last item of a frame or struct.
+     *
+     * @param[out]  aData        A reference to output a pointer to the data within the input buffer.
+     * @param[out]  aDataLength  A reference to output the data length.
+     *
+     * @retval OT_ERROR_NONE  Successfully read the value.
+     *
+     */
+    otError ReadData(const uint8_t *&aData, uint16_t &aDataLength) {
+        aData = mCursor;
+        aDataLength = GetRemainingLength();
+        mCursor = mEnd;
+        return OT_ERROR_NONE;
+    }
+
+    /**
+     * This method reads data preceded by its 16-bit length [d].
+     *
+     * This is also the decoding of `D` when it is not the last item of a frame or struct.
+     *
+     * @param[out]  aData        A reference to output a pointer to the data within the input buffer.
+     * @param[out]  aDataLength  A reference to output the data length.
+     *
+     * @retval OT_ERROR_NONE   Successfully read the value.
+     * @retval OT_ERROR_PARSE  The length is truncated or exceeds the remaining bytes.
+     *
+     */
+    otError ReadDataWithLen(const uint8_t *&aData, uint16_t &aDataLength);
+
+    /**
+     * This method enters a struct [t(...)] by reading its 16-bit length.
+     *
+     * Until the matching `CloseStruct()`, reads are limited to the struct contents.
+     *
+     * @retval OT_ERROR_NONE   Successfully opened the struct.
+     * @retval OT_ERROR_PARSE  The length is truncated or exceeds the remaining bytes, or too many nested structs.
+     *
+     */
+    otError OpenStruct(void);
+
+    /**
+     * This method leaves the innermost open struct, skipping any of its unread bytes.
+     *
+     * @retval OT_ERROR_NONE           Successfully closed the struct.
+     * @retval OT_ERROR_INVALID_STATE  There is no open struct.
+     *
+     */
+    otError CloseStruct(void);
+
+private:
+    otError ReadItem(const uint8_t *&aItem, uint16_t aLength) {
+        otError error = OT_ERROR_NONE;
+
+        VerifyOrExit(aLength <= mEnd - mCursor, error = OT_ERROR_PARSE);
+        aItem = mCursor;
+        mCursor += aLength;
+
+exit:
+        return error;
+    }
+
+    const uint8_t *mBuffer;
+    const uint8_t *mCursor;
+    const uint8_t *mEnd;
+    const uint8_t *mStructEnd[kMaxNestedStructs];
+    uint8_t mNumOpenStructs;
+};
+
+}  // namespace ot
+
+#endif  // SPINEL_ENCODER_HPP_
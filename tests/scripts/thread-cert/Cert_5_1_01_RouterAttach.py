@@ -27,13 +27,13 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import config
 import mle
 import network_layer
 import node
+import simulator
 
 LEADER = 1
 ROUTER = 2
@@ -43,9 +43,11 @@ SNIFFER = 3
 class Cert_5_1_01_RouterAttach(unittest.TestCase):
 
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1, 3):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[LEADER].set_panid(0xface)
         self.nodes[LEADER].set_mode('rsdn')
@@ -69,14 +71,16 @@ class Cert_5_1_01_RouterAttach(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
         self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
-        time.sleep(4)
+        self.simulator.go(4)
 
         self.nodes[ROUTER].start()
-        time.sleep(7)
+        self.simulator.go(7)
         self.assertEqual(self.nodes[ROUTER].get_state(), 'router')
 
         leader_messages = self.sniffer.get_messages_sent_by(LEADER)
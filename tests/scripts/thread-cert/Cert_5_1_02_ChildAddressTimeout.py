@@ -27,12 +27,12 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import config
 import mle
 import node
+import simulator
 
 LEADER = 1
 ROUTER = 2
@@ -44,9 +44,11 @@ SNIFFER = 5
 class Cert_5_1_02_ChildAddressTimeout(unittest.TestCase):
 
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1, 5):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[LEADER].set_panid(0xface)
         self.nodes[LEADER].set_mode('rsdn')
@@ -84,35 +86,37 @@ class Cert_5_1_02_ChildAddressTimeout(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
         self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
-        time.sleep(4)
+        self.simulator.go(4)
 
         self.nodes[ROUTER].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER].get_state(), 'router')
 
         self.nodes[ED].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ED].get_state(), 'child')
 
         self.nodes[SED].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[SED].get_state(), 'child')
 
         ed_addrs = self.nodes[ED].get_addrs()
         sed_addrs = self.nodes[SED].get_addrs()
 
         self.nodes[ED].stop()
-        time.sleep(5)
+        self.simulator.go(5)
         for addr in ed_addrs:
             if addr[0:4] != 'fe80':
                 self.assertFalse(self.nodes[LEADER].ping(addr))
 
         self.nodes[SED].stop()
-        time.sleep(5)
+        self.simulator.go(5)
         for addr in sed_addrs:
             if addr[0:4] != 'fe80':
                 self.assertFalse(self.nodes[LEADER].ping(addr))
@@ -27,13 +27,13 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import config
 import mle
 import network_layer
 import node
+import simulator
 
 LEADER = 1
 ROUTER1 = 2
@@ -44,9 +44,11 @@ SNIFFER = 4
 class Cert_5_1_03_RouterAddressReallocation(unittest.TestCase):
 
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1, 4):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[LEADER].set_panid(0xface)
         self.nodes[LEADER].set_mode('rsdn')
@@ -79,25 +81,27 @@ class Cert_5_1_03_RouterAddressReallocation(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
         self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
-        time.sleep(4)
+        self.simulator.go(4)
 
         self.nodes[ROUTER1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
 
         self.nodes[ROUTER2].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER2].get_state(), 'router')
 
         rloc16 = self.nodes[ROUTER1].get_addr16()
 
         self.nodes[ROUTER2].set_network_id_timeout(110)
         self.nodes[LEADER].stop()
-        time.sleep(140)
+        self.simulator.go(140)
 
         self.assertEqual(self.nodes[ROUTER2].get_state(), 'leader')
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
@@ -27,13 +27,13 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import config
 import mle
 import network_layer
 import node
+import simulator
 
 LEADER = 1
 ROUTER1 = 2
@@ -43,9 +43,11 @@ SNIFFER = 3
 class Cert_5_1_05_RouterAddressTimeout(unittest.TestCase):
 
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1, 3):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[LEADER].set_panid(0xface)
         self.nodes[LEADER].set_mode('rsdn')
@@ -69,31 +71,33 @@ class Cert_5_1_05_RouterAddressTimeout(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
         self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
-        time.sleep(4)
+        self.simulator.go(4)
 
         self.nodes[ROUTER1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
 
         rloc16 = self.nodes[ROUTER1].get_addr16()
 
         self.nodes[ROUTER1].stop()
-        time.sleep(200)
+        self.simulator.go(200)
         self.nodes[ROUTER1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
         self.assertNotEqual(self.nodes[ROUTER1].get_addr16(), rloc16)
 
         rloc16 = self.nodes[ROUTER1].get_addr16()
 
         self.nodes[ROUTER1].stop()
-        time.sleep(300)
+        self.simulator.go(300)
         self.nodes[ROUTER1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
         self.assertEqual(self.nodes[ROUTER1].get_addr16(), rloc16)
 
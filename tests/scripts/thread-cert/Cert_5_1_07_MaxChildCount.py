@@ -27,10 +27,10 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import node
+import simulator
 
 LEADER = 1
 ROUTER = 2
@@ -38,9 +38,11 @@ SED1 = 7
 
 class Cert_5_1_07_MaxChildCount(unittest.TestCase):
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1, 13):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[LEADER].set_panid(0xface)
         self.nodes[LEADER].set_mode('rsdn')
@@ -70,19 +72,21 @@ class Cert_5_1_07_MaxChildCount(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
         self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
-        time.sleep(4)
+        self.simulator.go(4)
 
         self.nodes[ROUTER].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER].get_state(), 'router')
 
         for i in range(3, 13):
             self.nodes[i].start()
-            time.sleep(7)
+            self.simulator.go(7)
             self.assertEqual(self.nodes[i].get_state(), 'child')
 
         ipaddrs = self.nodes[SED1].get_addrs()
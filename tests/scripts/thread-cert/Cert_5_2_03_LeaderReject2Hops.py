@@ -27,10 +27,10 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import node
+import simulator
 
 LEADER = 1
 ROUTER = 2
@@ -38,9 +38,11 @@ DUT = 33
 
 class Cert_5_2_3_LeaderReject2Hops(unittest.TestCase):
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
 
-        self.nodes[LEADER] = node.Node(LEADER)
+        self.nodes[LEADER] = node.Node(LEADER, self.simulator)
         self.nodes[LEADER].set_panid(0xface)
         self.nodes[LEADER].set_mode('rsdn')
         self.nodes[LEADER].enable_whitelist()
@@ -48,7 +50,7 @@ class Cert_5_2_3_LeaderReject2Hops(unittest.TestCase):
         self.nodes[LEADER].set_router_downgrade_threshold(33)
 
         for i in range(2,33):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
             self.nodes[i].set_panid(0xface)
             self.nodes[i].set_mode('rsdn')
             self.nodes[i].add_whitelist(self.nodes[LEADER].get_addr64())
@@ -58,7 +60,7 @@ class Cert_5_2_3_LeaderReject2Hops(unittest.TestCase):
             self.nodes[i].set_router_downgrade_threshold(33)
             self.nodes[i].set_router_selection_jitter(1)
 
-        self.nodes[DUT] = node.Node(DUT)
+        self.nodes[DUT] = node.Node(DUT, self.simulator)
         self.nodes[DUT].set_panid(0xface)
         self.nodes[DUT].set_mode('rsdn')
         self.nodes[DUT].add_whitelist(self.nodes[ROUTER].get_addr64())
@@ -73,6 +75,8 @@ class Cert_5_2_3_LeaderReject2Hops(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
@@ -80,11 +84,11 @@ class Cert_5_2_3_LeaderReject2Hops(unittest.TestCase):
 
         for i in range(2, 33):
             self.nodes[i].start()
-            time.sleep(5)
+            self.simulator.go(5)
             self.assertEqual(self.nodes[i].get_state(), 'router')
 
         self.nodes[DUT].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[DUT].get_state(), 'child')
 
 if __name__ == '__main__':
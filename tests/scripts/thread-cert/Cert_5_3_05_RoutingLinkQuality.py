@@ -27,10 +27,10 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import node
+import simulator
 
 LEADER = 1
 ROUTER1 = 2
@@ -39,9 +39,11 @@ ROUTER3 = 4
 
 class Cert_5_3_5_RoutingLinkQuality(unittest.TestCase):
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1,5):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[LEADER].set_panid(0xface)
         self.nodes[LEADER].set_mode('rsdn')
@@ -75,24 +77,26 @@ class Cert_5_3_5_RoutingLinkQuality(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
         self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
 
         self.nodes[ROUTER1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
 
         self.nodes[ROUTER2].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER2].get_state(), 'router')
 
         self.nodes[ROUTER3].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER3].get_state(), 'router')
 
-        time.sleep(10)
+        self.simulator.go(10)
 
         addrs = self.nodes[ROUTER3].get_addrs()
         for addr in addrs:
@@ -102,7 +106,7 @@ class Cert_5_3_5_RoutingLinkQuality(unittest.TestCase):
         self.nodes[LEADER].add_whitelist(self.nodes[ROUTER1].get_addr64(), rssi=-95)
         self.nodes[ROUTER1].add_whitelist(self.nodes[LEADER].get_addr64(), rssi=-95)
 
-        time.sleep(70)
+        self.simulator.go(70)
 
         addrs = self.nodes[ROUTER3].get_addrs()
         for addr in addrs:
@@ -112,7 +116,7 @@ class Cert_5_3_5_RoutingLinkQuality(unittest.TestCase):
         self.nodes[LEADER].add_whitelist(self.nodes[ROUTER1].get_addr64(), rssi=-85)
         self.nodes[ROUTER1].add_whitelist(self.nodes[LEADER].get_addr64(), rssi=-85)
 
-        time.sleep(70)
+        self.simulator.go(70)
 
         addrs = self.nodes[ROUTER3].get_addrs()
         for addr in addrs:
@@ -122,7 +126,7 @@ class Cert_5_3_5_RoutingLinkQuality(unittest.TestCase):
         self.nodes[LEADER].add_whitelist(self.nodes[ROUTER1].get_addr64(), rssi=-100)
         self.nodes[ROUTER1].add_whitelist(self.nodes[LEADER].get_addr64(), rssi=-100)
 
-        time.sleep(70)
+        self.simulator.go(70)
 
         addrs = self.nodes[ROUTER3].get_addrs()
         for addr in addrs:
@@ -27,10 +27,10 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import node
+import simulator
 
 LEADER = 1
 ROUTER1 = 2
@@ -40,9 +40,11 @@ SED1 = 5
 
 class Cert_5_3_09_AddressQuery(unittest.TestCase):
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1,6):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[LEADER].set_panid(0xface)
         self.nodes[LEADER].set_mode('rsdn')
@@ -82,6 +84,8 @@ class Cert_5_3_09_AddressQuery(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
@@ -92,23 +96,23 @@ class Cert_5_3_09_AddressQuery(unittest.TestCase):
         self.nodes[LEADER].register_netdata()
 
         self.nodes[ROUTER1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
 
         self.nodes[ROUTER2].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER2].get_state(), 'router')
 
         self.nodes[ROUTER3].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER3].get_state(), 'router')
 
         self.nodes[SED1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[SED1].get_state(), 'child')
 
         # wait for sed got replied
-        time.sleep(10)
+        self.simulator.go(10)
 
         addrs = self.nodes[ROUTER3].get_addrs()
         self.assertTrue(any('2001:2:0:1' in addr[0:10] for addr in addrs))
@@ -130,7 +134,7 @@ class Cert_5_3_09_AddressQuery(unittest.TestCase):
                 self.assertTrue(self.nodes[SED1].ping(addr))
 
         self.nodes[ROUTER3].stop()
-        time.sleep(300)
+        self.simulator.go(300)
 
         addrs = self.nodes[ROUTER3].get_addrs()
         for addr in addrs:
@@ -138,7 +142,7 @@ class Cert_5_3_09_AddressQuery(unittest.TestCase):
                 self.assertFalse(self.nodes[SED1].ping(addr))
 
         self.nodes[SED1].stop()
-        time.sleep(10)
+        self.simulator.go(10)
 
         addrs = self.nodes[SED1].get_addrs()
         for addr in addrs:
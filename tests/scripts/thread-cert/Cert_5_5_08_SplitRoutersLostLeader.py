@@ -27,10 +27,10 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import node
+import simulator
 
 LEADER1 = 1
 ROUTER1 = 2
@@ -40,9 +40,11 @@ ED1 = 5
 
 class Cert_5_5_8_SplitRoutersLostLeader(unittest.TestCase):
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1,6):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[LEADER1].set_panid(0xface)
         self.nodes[LEADER1].set_mode('rsdn')
@@ -82,25 +84,27 @@ class Cert_5_5_8_SplitRoutersLostLeader(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER1].start()
         self.nodes[LEADER1].set_state('leader')
         self.assertEqual(self.nodes[LEADER1].get_state(), 'leader')
 
         self.nodes[ROUTER3].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER3].get_state(), 'router')
 
         self.nodes[ROUTER2].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER2].get_state(), 'router')
 
         self.nodes[ROUTER1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
 
         self.nodes[ED1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ED1].get_state(), 'child')
 
         addrs = self.nodes[ED1].get_addrs()
@@ -109,10 +113,10 @@ class Cert_5_5_8_SplitRoutersLostLeader(unittest.TestCase):
                 self.assertTrue(self.nodes[LEADER1].ping(addr))
 
         self.nodes[ROUTER3].stop()
-        time.sleep(140)
+        self.simulator.go(140)
 
         self.nodes[ROUTER3].start()        
-        time.sleep(60)
+        self.simulator.go(60)
 
         addrs = self.nodes[ED1].get_addrs()
         for addr in addrs:
@@ -27,10 +27,10 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import node
+import simulator
 
 CHANNEL_INIT = 19
 PANID_INIT = 0xface
@@ -45,9 +45,11 @@ ROUTER2 = 4
 
 class Cert_9_2_09_PendingPartition(unittest.TestCase):
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1,5):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[COMMISSIONER].set_active_dataset(10, channel=CHANNEL_INIT, panid=PANID_INIT)
         self.nodes[COMMISSIONER].set_mode('rsdn')
@@ -82,23 +84,25 @@ class Cert_9_2_09_PendingPartition(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
         self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
 
         self.nodes[COMMISSIONER].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[COMMISSIONER].get_state(), 'router')
         self.nodes[COMMISSIONER].commissioner_start()
-        time.sleep(3)
+        self.simulator.go(3)
 
         self.nodes[ROUTER1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
 
         self.nodes[ROUTER2].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER2].get_state(), 'router')
 
         self.nodes[COMMISSIONER].send_mgmt_pending_set(pending_timestamp=30,
@@ -106,11 +110,11 @@ class Cert_9_2_09_PendingPartition(unittest.TestCase):
                                                        delay_timer=500000,
                                                        channel=20,
                                                        panid=0xafce)
-        time.sleep(5)
+        self.simulator.go(5)
 
         self.nodes[LEADER].remove_whitelist(self.nodes[ROUTER1].get_addr64())
         self.nodes[ROUTER1].remove_whitelist(self.nodes[LEADER].get_addr64())
-        time.sleep(140)
+        self.simulator.go(140)
 
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
         self.assertEqual(self.nodes[ROUTER2].get_state(), 'leader')
@@ -120,11 +124,11 @@ class Cert_9_2_09_PendingPartition(unittest.TestCase):
                                                   delay_timer=200000,
                                                   channel=CHANNEL_FINAL,
                                                   panid=PANID_FINAL)
-        time.sleep(5)
+        self.simulator.go(5)
 
         self.nodes[LEADER].add_whitelist(self.nodes[ROUTER1].get_addr64())
         self.nodes[ROUTER1].add_whitelist(self.nodes[LEADER].get_addr64())
-        time.sleep(200)
+        self.simulator.go(200)
 
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
         self.assertEqual(self.nodes[ROUTER2].get_state(), 'router')
@@ -27,10 +27,10 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import node
+import simulator
 
 CHANNEL_INIT = 19
 PANID_INIT = 0xface
@@ -46,9 +46,11 @@ SED1 = 5
 
 class Cert_9_2_10_PendingPartition(unittest.TestCase):
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1,6):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[COMMISSIONER].set_active_dataset(15, channel=CHANNEL_INIT, panid=PANID_INIT)
         self.nodes[COMMISSIONER].set_mode('rsdn')
@@ -88,27 +90,29 @@ class Cert_9_2_10_PendingPartition(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
         self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
 
         self.nodes[COMMISSIONER].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[COMMISSIONER].get_state(), 'router')
         self.nodes[COMMISSIONER].commissioner_start()
-        time.sleep(3)
+        self.simulator.go(3)
 
         self.nodes[ROUTER1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
 
         self.nodes[ED1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ED1].get_state(), 'child')
 
         self.nodes[SED1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[SED1].get_state(), 'child')
 
         self.nodes[COMMISSIONER].send_mgmt_pending_set(pending_timestamp=30,
@@ -116,7 +120,7 @@ class Cert_9_2_10_PendingPartition(unittest.TestCase):
                                                        delay_timer=150000,
                                                        channel=CHANNEL_FINAL,
                                                        panid=PANID_FINAL)
-        time.sleep(5)
+        self.simulator.go(5)
 
         print(self.nodes[COMMISSIONER].get_channel())
         print(self.nodes[LEADER].get_channel())
@@ -126,7 +130,7 @@ class Cert_9_2_10_PendingPartition(unittest.TestCase):
 
         self.nodes[LEADER].remove_whitelist(self.nodes[ROUTER1].get_addr64())
         self.nodes[ROUTER1].remove_whitelist(self.nodes[LEADER].get_addr64())
-        time.sleep(160)
+        self.simulator.go(160)
 
         print(self.nodes[COMMISSIONER].get_channel())
         print(self.nodes[LEADER].get_channel())
@@ -148,7 +152,7 @@ class Cert_9_2_10_PendingPartition(unittest.TestCase):
 
         self.nodes[LEADER].add_whitelist(self.nodes[ROUTER1].get_addr64())
         self.nodes[ROUTER1].add_whitelist(self.nodes[LEADER].get_addr64())
-        time.sleep(60)
+        self.simulator.go(60)
 
         self.assertEqual(self.nodes[COMMISSIONER].get_state(), 'router')
         self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
@@ -27,10 +27,10 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import node
+import simulator
 
 KEY1 = '000102030405060708090a0b0c0d0e0f'
 KEY2 = '0f0e0d0c0b0a09080706050403020100'
@@ -46,9 +46,11 @@ SED1 = 5
 
 class Cert_9_2_11_MasterKey(unittest.TestCase):
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1,6):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[COMMISSIONER].set_active_dataset(10, channel=CHANNEL_INIT, panid=PANID_INIT, master_key=KEY1)
         self.nodes[COMMISSIONER].set_mode('rsdn')
@@ -87,34 +89,36 @@ class Cert_9_2_11_MasterKey(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
         self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
 
         self.nodes[COMMISSIONER].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[COMMISSIONER].get_state(), 'router')
         self.nodes[COMMISSIONER].commissioner_start()
-        time.sleep(3)
+        self.simulator.go(3)
 
         self.nodes[ROUTER1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
 
         self.nodes[ED1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ED1].get_state(), 'child')
 
         self.nodes[SED1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[SED1].get_state(), 'child')
 
         self.nodes[COMMISSIONER].send_mgmt_pending_set(pending_timestamp=10,
                                                        active_timestamp=70,
                                                        delay_timer=10000,
                                                        master_key=KEY2)
-        time.sleep(310)
+        self.simulator.go(310)
 
         print(self.nodes[COMMISSIONER].get_masterkey())
         print(self.nodes[LEADER].get_masterkey())
@@ -137,7 +141,7 @@ class Cert_9_2_11_MasterKey(unittest.TestCase):
                                                        active_timestamp=30,
                                                        delay_timer=10000,
                                                        master_key=KEY1)
-        time.sleep(310)
+        self.simulator.go(310)
 
         print(self.nodes[COMMISSIONER].get_masterkey())
         print(self.nodes[LEADER].get_masterkey())
@@ -27,10 +27,10 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import node
+import simulator
 
 CHANNEL_INIT = 19
 PANID_INIT = 0xface
@@ -45,9 +45,11 @@ ROUTER2 = 4
 
 class Cert_9_2_16_ActivePendingPartition(unittest.TestCase):
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1,5):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[COMMISSIONER].set_active_dataset(1, channel=CHANNEL_INIT, panid=PANID_INIT)
         self.nodes[COMMISSIONER].set_mode('rsdn')
@@ -81,29 +83,31 @@ class Cert_9_2_16_ActivePendingPartition(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER].start()
         self.nodes[LEADER].set_state('leader')
         self.assertEqual(self.nodes[LEADER].get_state(), 'leader')
 
         self.nodes[COMMISSIONER].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[COMMISSIONER].get_state(), 'router')
         self.nodes[COMMISSIONER].commissioner_start()
-        time.sleep(3)
+        self.simulator.go(3)
 
         self.nodes[ROUTER1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER1].get_state(), 'router')
 
         self.nodes[COMMISSIONER].send_mgmt_pending_set(pending_timestamp=10,
                                                        active_timestamp=10,
                                                        delay_timer=600000,
                                                        mesh_local='fd00:0db9::')
-        time.sleep(5)
+        self.simulator.go(5)
 
         self.nodes[ROUTER2].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER2].get_state(), 'router')
 
         self.nodes[ROUTER2].stop()
@@ -113,14 +117,14 @@ class Cert_9_2_16_ActivePendingPartition(unittest.TestCase):
                                                        delay_timer=200000,
                                                        mesh_local='fd00:0db7::',
                                                        panid=PANID_FINAL)
-        time.sleep(5)
+        self.simulator.go(5)
 
         self.nodes[COMMISSIONER].send_mgmt_active_set(active_timestamp=15,
                                                       network_name='threadCert')
-        time.sleep(100)
+        self.simulator.go(100)
 
         self.nodes[ROUTER2].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ROUTER2].get_state(), 'router')
 
         self.assertEqual(self.nodes[COMMISSIONER].get_network_name(), NETWORK_NAME_FINAL)
@@ -128,7 +132,7 @@ class Cert_9_2_16_ActivePendingPartition(unittest.TestCase):
         self.assertEqual(self.nodes[ROUTER1].get_network_name(), NETWORK_NAME_FINAL)
         self.assertEqual(self.nodes[ROUTER2].get_network_name(), NETWORK_NAME_FINAL)
 
-        time.sleep(100)
+        self.simulator.go(100)
 
         self.assertEqual(self.nodes[COMMISSIONER].get_panid(), PANID_FINAL)
         self.assertEqual(self.nodes[LEADER].get_panid(), PANID_FINAL)
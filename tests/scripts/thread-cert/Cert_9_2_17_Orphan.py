@@ -27,10 +27,10 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import node
+import simulator
 
 CHANNEL1 = 11
 CHANNEL2 = 18
@@ -43,9 +43,11 @@ ED1 = 3
 
 class Cert_9_2_17_Orphan(unittest.TestCase):
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
         for i in range(1,4):
-            self.nodes[i] = node.Node(i)
+            self.nodes[i] = node.Node(i, self.simulator)
 
         self.nodes[LEADER1].set_active_dataset(10, channel=CHANNEL1, panid=PANID_INIT, channel_mask=CHANNEL_MASK)
         self.nodes[LEADER1].set_mode('rsdn')
@@ -69,6 +71,8 @@ class Cert_9_2_17_Orphan(unittest.TestCase):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         self.nodes[LEADER1].start()
         self.nodes[LEADER1].set_state('leader')
@@ -79,13 +83,13 @@ class Cert_9_2_17_Orphan(unittest.TestCase):
         self.assertEqual(self.nodes[LEADER2].get_state(), 'leader')
 
         self.nodes[ED1].start()
-        time.sleep(5)
+        self.simulator.go(5)
         self.assertEqual(self.nodes[ED1].get_state(), 'child')
 
         self.nodes[LEADER1].stop()
         self.nodes[LEADER2].add_whitelist(self.nodes[ED1].get_addr64())
         self.nodes[ED1].add_whitelist(self.nodes[LEADER2].get_addr64())
-        time.sleep(20)
+        self.simulator.go(20)
 
         self.assertEqual(self.nodes[ED1].get_state(), 'child')
         self.assertEqual(self.nodes[ED1].get_channel(), CHANNEL2)
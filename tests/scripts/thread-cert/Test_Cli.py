@@ -27,23 +27,27 @@
 #  POSSIBILITY OF SUCH DAMAGE.
 #
 
-import time
 import unittest
 
 import node
+import simulator
 
 LEADER = 1
 
 class Cert_Cli(unittest.TestCase):
     def setUp(self):
+        self.simulator = simulator.create_default_simulator()
+
         self.nodes = {}
-        self.nodes[LEADER] = node.Node(LEADER)
+        self.nodes[LEADER] = node.Node(LEADER, self.simulator)
 
     def tearDown(self):
         for node in list(self.nodes.values()):
             node.stop()
         del self.nodes
 
+        self.simulator.stop()
+
     def test(self):
         commands = self.nodes[LEADER].get_commands()
 
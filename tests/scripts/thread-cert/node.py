@@ -37,9 +37,9 @@ else:
 import unittest
 
 class Node:
-    def __init__(self, nodeid):
+    def __init__(self, nodeid, simulator=None):
         if sys.platform != 'win32':
-            self.interface = node_cli.otCli(nodeid)
+            self.interface = node_cli.otCli(nodeid, simulator)
         else:
             self.interface = node_api.otApi(nodeid)
 
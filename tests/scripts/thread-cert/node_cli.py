@@ -33,10 +33,14 @@ import time
 import pexpect
 
 class otCli:
-    def __init__(self, nodeid):
+    def __init__(self, nodeid, simulator=None):
         self.nodeid = nodeid
         self.verbose = int(float(os.getenv('VERBOSE', 0)))
         self.node_type = os.getenv('NODE_TYPE', 'sim')
+        self.simulator = simulator
+
+        if self.is_virtual_time and self.node_type != 'sim':
+            raise RuntimeError('Virtual time only supports NODE_TYPE=sim')
 
         if self.node_type == 'soc':
             self.__init_soc(nodeid)
@@ -62,8 +66,12 @@ class otCli:
 
         self.pexpect = pexpect.spawn(cmd, timeout=4)
 
-        # Add delay to ensure that the process is ready to receive commands.
-        time.sleep(0.2)
+        if self.is_virtual_time:
+            # Commands are queued by the simulator, which waits for the node to settle.
+            self.simulator.add_node(self.nodeid)
+        else:
+            # Add delay to ensure that the process is ready to receive commands.
+            time.sleep(0.2)
 
 
     def __init_ncp_sim(self, nodeid):
@@ -88,22 +96,55 @@ class otCli:
         self.pexpect = fdpexpect.fdspawn(os.open(serialPort, os.O_RDWR|os.O_NONBLOCK|os.O_NOCTTY))
 
     def __del__(self):
-        if self.pexpect.isalive():
+        if self.is_virtual_time:
+            # The node never goes back to sleep after 'exit', so take it out of the simulation instead.
+            self.simulator.remove_node(self.nodeid)
+            self.pexpect.terminate(force=True)
+            self.pexpect.close(force=True)
+        elif self.pexpect.isalive():
             self.send_command('exit')
             self.pexpect.expect(pexpect.EOF)
             self.pexpect.terminate()
             self.pexpect.close(force=True)
 
+    @property
+    def is_virtual_time(self):
+        return hasattr(self.simulator, 'write_uart')
+
+    def _expect(self, pattern, timeout=-1, *args, **kwargs):
+        """ Wait for the pattern in the node's output, in virtual time the simulation runs while waiting. """
+        if not self.is_virtual_time:
+            return self.pexpect.expect(pattern, timeout, *args, **kwargs)
+
+        if timeout == -1:
+            timeout = self.pexpect.timeout
+
+        # The node writes its output before going back to sleep, so a short wall-clock timeout suffices.
+        while True:
+            try:
+                return self.pexpect.expect(pattern, 0.01, *args, **kwargs)
+            except pexpect.TIMEOUT:
+                if timeout <= 0:
+                    raise
+
+                timeout -= 0.1
+                self.simulator.go(0.1)
+
     def send_command(self, cmd):
         print ("%d: %s" % (self.nodeid, cmd))
-        self.pexpect.sendline(cmd)
+
+        if self.is_virtual_time:
+            self.simulator.write_uart(self.nodeid, (cmd + '\n').encode('utf-8'))
+            self.simulator.go(0)
+        else:
+            self.pexpect.sendline(cmd)
 
     def get_commands(self):
         self.send_command('?')
-        self.pexpect.expect('Commands:')
+        self._expect('Commands:')
         commands = []
         while True:
-            i = self.pexpect.expect(['Done', '(\S+)'])
+            i = self._expect(['Done', '(\S+)'])
             if i != 0:
                 commands.append(self.pexpect.match.groups()[0])
             else:
@@ -113,143 +154,143 @@ class otCli:
     def set_mode(self, mode):
         cmd = 'mode ' + mode
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def debug(self, level):
         self.send_command('debug '+str(level))
 
     def interface_up(self):
         self.send_command('ifconfig up')
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def interface_down(self):
         self.send_command('ifconfig down')
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def thread_start(self):
         self.send_command('thread start')
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def thread_stop(self):
         self.send_command('thread stop')
-        self.pexpect.expect('Done')
+        self._expect('Done')
             
     def commissioner_start(self):
         cmd = 'commissioner start'
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def commissioner_add_joiner(self, addr, psk):
         cmd = 'commissioner joiner add ' + addr + ' ' + psk
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def joiner_start(self, pskd='', provisioning_url=''):
         cmd = 'joiner start ' + pskd + ' ' + provisioning_url
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def clear_whitelist(self):
         self.send_command('whitelist clear')
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def enable_whitelist(self):
         self.send_command('whitelist enable')
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def disable_whitelist(self):
         self.send_command('whitelist disable')
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def add_whitelist(self, addr, rssi=None):
         cmd = 'whitelist add ' + addr
         if rssi != None:
             cmd += ' ' + str(rssi)
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def remove_whitelist(self, addr):
         cmd = 'whitelist remove ' + addr
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def get_addr16(self):
         self.send_command('rloc16')
-        i = self.pexpect.expect('([0-9a-fA-F]{4})')
+        i = self._expect('([0-9a-fA-F]{4})')
         if i == 0:
             addr16 = int(self.pexpect.match.groups()[0], 16)
-        self.pexpect.expect('Done')
+        self._expect('Done')
         return addr16
 
     def get_addr64(self):
         self.send_command('extaddr')
-        i = self.pexpect.expect('([0-9a-fA-F]{16})')
+        i = self._expect('([0-9a-fA-F]{16})')
         if i == 0:
             addr64 = self.pexpect.match.groups()[0].decode("utf-8")
-        self.pexpect.expect('Done')
+        self._expect('Done')
         return addr64
 
     def get_hashmacaddr(self):
         self.send_command('hashmacaddr')
-        i = self.pexpect.expect('([0-9a-fA-F]{16})')
+        i = self._expect('([0-9a-fA-F]{16})')
         if i == 0:
             addr = self.pexpect.match.groups()[0].decode("utf-8")
-        self.pexpect.expect('Done')
+        self._expect('Done')
         return addr
 
     def get_channel(self):
         self.send_command('channel')
-        i = self.pexpect.expect('(\d+)\r\n')
+        i = self._expect('(\d+)\r\n')
         if i == 0:
             channel = int(self.pexpect.match.groups()[0])
-        self.pexpect.expect('Done')
+        self._expect('Done')
         return channel
 
     def set_channel(self, channel):
         cmd = 'channel %d' % channel
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def get_masterkey(self):
         self.send_command('masterkey')
-        i = self.pexpect.expect('([0-9a-fA-F]{32})')
+        i = self._expect('([0-9a-fA-F]{32})')
         if i == 0:
             masterkey = self.pexpect.match.groups()[0].decode("utf-8")
-        self.pexpect.expect('Done')
+        self._expect('Done')
         return masterkey
 
     def set_masterkey(self, masterkey):
         cmd = 'masterkey ' + masterkey
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def get_key_sequence_counter(self):
         self.send_command('keysequence counter')
-        i = self.pexpect.expect('(\d+)\r\n')
+        i = self._expect('(\d+)\r\n')
         if i == 0:
             key_sequence_counter = int(self.pexpect.match.groups()[0])
-        self.pexpect.expect('Done')
+        self._expect('Done')
         return key_sequence_counter
 
     def set_key_sequence_counter(self, key_sequence_counter):
         cmd = 'keysequence counter %d' % key_sequence_counter
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def set_key_switch_guardtime(self, key_switch_guardtime):
         cmd = 'keysequence guardtime %d' % key_switch_guardtime
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def set_network_id_timeout(self, network_id_timeout):
         cmd = 'networkidtimeout %d' % network_id_timeout
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def get_network_name(self):
         self.send_command('networkname')
         while True:
-            i = self.pexpect.expect(['Done', '(\S+)'])
+            i = self._expect(['Done', '(\S+)'])
             if i != 0:
                 network_name = self.pexpect.match.groups()[0].decode('utf-8')
             else:
@@ -259,103 +300,103 @@ class otCli:
     def set_network_name(self, network_name):
         cmd = 'networkname ' + network_name
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def get_panid(self):
         self.send_command('panid')
-        i = self.pexpect.expect('([0-9a-fA-F]{4})')
+        i = self._expect('([0-9a-fA-F]{4})')
         if i == 0:
             panid = int(self.pexpect.match.groups()[0], 16)
-        self.pexpect.expect('Done')
+        self._expect('Done')
         return panid
 
     def set_panid(self, panid):
         cmd = 'panid %d' % panid
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def get_partition_id(self):
         self.send_command('leaderpartitionid')
-        i = self.pexpect.expect('(\d+)\r\n')
+        i = self._expect('(\d+)\r\n')
         if i == 0:
             weight = self.pexpect.match.groups()[0]
-        self.pexpect.expect('Done')
+        self._expect('Done')
         return weight
 
     def set_partition_id(self, partition_id):
         cmd = 'leaderpartitionid %d' % partition_id
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def set_router_upgrade_threshold(self, threshold):
         cmd = 'routerupgradethreshold %d' % threshold
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def set_router_downgrade_threshold(self, threshold):
         cmd = 'routerdowngradethreshold %d' % threshold
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def release_router_id(self, router_id):
         cmd = 'releaserouterid %d' % router_id
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def get_state(self):
         states = ['detached', 'child', 'router', 'leader']
         self.send_command('state')
-        match = self.pexpect.expect(states)
-        self.pexpect.expect('Done')
+        match = self._expect(states)
+        self._expect('Done')
         return states[match]
 
     def set_state(self, state):
         cmd = 'state ' + state
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def get_timeout(self):
         self.send_command('childtimeout')
-        i = self.pexpect.expect('(\d+)\r\n')
+        i = self._expect('(\d+)\r\n')
         if i == 0:
             timeout = self.pexpect.match.groups()[0]
-        self.pexpect.expect('Done')
+        self._expect('Done')
         return timeout
 
     def set_timeout(self, timeout):
         cmd = 'childtimeout %d' % timeout
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def set_max_children(self, number):
         cmd = 'childmax %d' % number
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def get_weight(self):
         self.send_command('leaderweight')
-        i = self.pexpect.expect('(\d+)\r\n')
+        i = self._expect('(\d+)\r\n')
         if i == 0:
             weight = self.pexpect.match.groups()[0]
-        self.pexpect.expect('Done')
+        self._expect('Done')
         return weight
 
     def set_weight(self, weight):
         cmd = 'leaderweight %d' % weight
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def add_ipaddr(self, ipaddr):
         cmd = 'ipaddr add ' + ipaddr
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def get_addrs(self):
         addrs = []
         self.send_command('ipaddr')
 
         while True:
-            i = self.pexpect.expect(['(\S+:\S+)\r\n', 'Done'])
+            i = self._expect(['(\S+:\S+)\r\n', 'Done'])
             if i == 0:
                 addrs.append(self.pexpect.match.groups()[0].decode("utf-8"))
             elif i == 1:
@@ -365,57 +406,57 @@ class otCli:
 
     def get_context_reuse_delay(self):
         self.send_command('contextreusedelay')
-        i = self.pexpect.expect('(\d+)\r\n')
+        i = self._expect('(\d+)\r\n')
         if i == 0:
             timeout = self.pexpect.match.groups()[0]
-        self.pexpect.expect('Done')
+        self._expect('Done')
         return timeout
 
     def set_context_reuse_delay(self, delay):
         cmd = 'contextreusedelay %d' % delay
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def add_prefix(self, prefix, flags, prf = 'med'):
         cmd = 'prefix add ' + prefix + ' ' + flags + ' ' + prf
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def remove_prefix(self, prefix):
         cmd = 'prefix remove ' + prefix
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def add_route(self, prefix, prf = 'med'):
         cmd = 'route add ' + prefix + ' ' + prf
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def remove_route(self, prefix):
         cmd = 'route remove ' + prefix
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def register_netdata(self):
         self.send_command('netdataregister')
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def energy_scan(self, mask, count, period, scan_duration, ipaddr):
         cmd = 'commissioner energy ' + str(mask) + ' ' + str(count) + ' ' + str(period) + ' ' + str(scan_duration) + ' ' + ipaddr
         self.send_command(cmd)
-        self.pexpect.expect('Energy:', timeout=8)
+        self._expect('Energy:', timeout=8)
 
     def panid_query(self, panid, mask, ipaddr):
         cmd = 'commissioner panid ' + str(panid) + ' ' + str(mask) + ' ' + ipaddr
         self.send_command(cmd)
-        self.pexpect.expect('Conflict:', timeout=8)
+        self._expect('Conflict:', timeout=8)
 
     def scan(self):
         self.send_command('scan')
 
         results = []
         while True:
-            i = self.pexpect.expect(['\|\s(\S+)\s+\|\s(\S+)\s+\|\s([0-9a-fA-F]{4})\s\|\s([0-9a-fA-F]{16})\s\|\s(\d+)\r\n',
+            i = self._expect(['\|\s(\S+)\s+\|\s(\S+)\s+\|\s([0-9a-fA-F]{4})\s\|\s([0-9a-fA-F]{16})\s\|\s(\d+)\r\n',
                                         'Done'])
             if i == 0:
                 results.append(self.pexpect.match.groups())
@@ -435,10 +476,10 @@ class otCli:
         try:
             responders = {}
             while len(responders) < num_responses:
-                i = self.pexpect.expect(['from (\S+):'])
+                i = self._expect(['from (\S+):'])
                 if i == 0:
                     responders[self.pexpect.match.groups()[0]] = 1
-            self.pexpect.expect('\n')
+            self._expect('\n')
         except pexpect.TIMEOUT:
             result = False
 
@@ -447,68 +488,68 @@ class otCli:
     def set_router_selection_jitter(self, jitter):
         cmd = 'routerselectionjitter %d' % jitter
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def set_active_dataset(self, timestamp, panid=None, channel=None, channel_mask=None, master_key=None):
         self.send_command('dataset clear')
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
         cmd = 'dataset activetimestamp %d' % timestamp
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
         if panid != None:
             cmd = 'dataset panid %d' % panid
             self.send_command(cmd)
-            self.pexpect.expect('Done')
+            self._expect('Done')
 
         if channel != None:
             cmd = 'dataset channel %d' % channel
             self.send_command(cmd)
-            self.pexpect.expect('Done')
+            self._expect('Done')
 
         if channel_mask != None:
             cmd = 'dataset channelmask %d' % channel_mask
             self.send_command(cmd)
-            self.pexpect.expect('Done')
+            self._expect('Done')
 
         if master_key != None:
             cmd = 'dataset masterkey ' + master_key
             self.send_command(cmd)
-            self.pexpect.expect('Done')
+            self._expect('Done')
 
         self.send_command('dataset commit active')
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def set_pending_dataset(self, pendingtimestamp, activetimestamp, panid=None, channel=None):
         self.send_command('dataset clear')
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
         cmd = 'dataset pendingtimestamp %d' % pendingtimestamp
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
         cmd = 'dataset activetimestamp %d' % activetimestamp
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
         if panid != None:
             cmd = 'dataset panid %d' % panid
             self.send_command(cmd)
-            self.pexpect.expect('Done')
+            self._expect('Done')
 
         if channel != None:
             cmd = 'dataset channel %d' % channel
             self.send_command(cmd)
-            self.pexpect.expect('Done')
+            self._expect('Done')
 
         self.send_command('dataset commit pending')
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def announce_begin(self, mask, count, period, ipaddr):
         cmd = 'commissioner announce ' + str(mask) + ' ' + str(count) + ' ' + str(period) + ' ' + ipaddr
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def send_mgmt_active_set(self, active_timestamp=None, channel=None, channel_mask=None, extended_panid=None,
                              panid=None, master_key=None, mesh_local=None, network_name=None, binary=None):
@@ -542,7 +583,7 @@ class otCli:
             cmd += 'binary ' + binary + ' '
 
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
 
     def send_mgmt_pending_set(self, pending_timestamp=None, active_timestamp=None, delay_timer=None, channel=None,
                               panid=None, master_key=None, mesh_local=None, network_name=None):
@@ -573,4 +614,4 @@ class otCli:
             cmd += 'networkname ' + network_name + ' '
 
         self.send_command(cmd)
-        self.pexpect.expect('Done')
+        self._expect('Done')
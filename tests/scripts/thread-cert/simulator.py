@@ -0,0 +1,195 @@
+#!/usr/bin/env python
+#
+#  Copyright (c) 2017, The OpenThread Authors.
+#  All rights reserved.
+#
+#  Redistribution and use in source and binary forms, with or without
+#  modification, are permitted provided that the following conditions are met:
+#  1. Redistributions of source code must retain the above copyright
+#     notice, this list of conditions and the following disclaimer.
+#  2. Redistributions in binary form must reproduce the above copyright
+#     notice, this list of conditions and the following disclaimer in the
+#     documentation and/or other materials provided with the distribution.
+#  3. Neither the name of the copyright holder nor the
+#     names of its contributors may be used to endorse or promote products
+#     derived from this software without specific prior written permission.
+#
+#  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+#  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+#  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+#  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+#  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+#  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+#  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+#  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+#  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+#  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+#  POSSIBILITY OF SUCH DAMAGE.
+
+import heapq
+import os
+import select
+import socket
+import struct
+import time
+
+
+class RealTime:
+
+    """ Simulator running the nodes against the wall clock. """
+
+    def go(self, duration):
+        time.sleep(duration)
+
+    def stop(self):
+        pass
+
+
+class VirtualTime:
+
+    """ Discrete-event coordinator for nodes built with --with-posix-event-loop=virtual-time.
+
+    A node runs only between an event delivered by the coordinator and the sleep event it sends back once idle, and
+    the coordinator delivers the next event only once every node sleeps. Events are delivered in (time, sequence)
+    order, so a run only depends on the nodes' RANDOM_SEED and runs as fast as the nodes can process their events.
+    """
+
+    OT_SIM_EVENT_ALARM_FIRED = 0
+    OT_SIM_EVENT_RADIO_RECEIVED = 1
+    OT_SIM_EVENT_UART_WRITE = 2
+
+    EVENT_HEADER = struct.Struct('=QBH')
+    EVENT_DATA_MAX_SIZE = 128
+
+    NO_ALARM = 0xffffffffffffffff
+
+    BASE_PORT = 9000
+
+    WELLKNOWN_NODE_ID = 34
+
+    PORT_OFFSET = int(os.getenv('PORT_OFFSET', "0"))
+
+    # IEEE 802.15.4 O-QPSK at 250 kbps: 32 us per octet, plus 6 octets of preamble, SFD and PHR.
+    US_PER_OCTET = 32
+    PHY_HEADER_SIZE = 6
+
+    # Wall-clock seconds a node may take to go back to sleep.
+    NODE_TIMEOUT = 10
+
+    def __init__(self):
+        self._base_port = self.BASE_PORT + (self.PORT_OFFSET * self.WELLKNOWN_NODE_ID)
+        self._socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+        self._socket.bind(('127.0.0.1', self._base_port))
+
+        self._now = 0
+        self._sequence = 0
+        self._events = []
+        self._nodes = {}
+
+    def now(self):
+        """ Current virtual time in seconds. """
+        return self._now / 1000000.0
+
+    def add_node(self, nodeid):
+        """ Register a node that was just started, it runs until its first sleep event. """
+        self._nodes[nodeid] = {'time': self._now, 'awake': True, 'alarm': None, 'tx_end': self._now}
+
+    def remove_node(self, nodeid):
+        self._nodes.pop(nodeid, None)
+
+    def write_uart(self, nodeid, data):
+        """ Queue UART input for a node, it is delivered by the next call to go(). """
+        data = bytearray(data)
+
+        for i in range(0, len(data), self.EVENT_DATA_MAX_SIZE):
+            self._push(self._now, nodeid, self.OT_SIM_EVENT_UART_WRITE, data[i:i + self.EVENT_DATA_MAX_SIZE])
+
+    def go(self, duration):
+        """ Advance virtual time by duration seconds, processing all events due until then. """
+        end = self._now + int(duration * 1000000)
+
+        while True:
+            self._wait_for_sleep()
+
+            if not self._events or self._events[0][0] > end:
+                break
+
+            timestamp, sequence, nodeid, event, data = heapq.heappop(self._events)
+            node = self._nodes.get(nodeid)
+
+            # Each sleep event supersedes the node's previous alarm.
+            if node is None or (event == self.OT_SIM_EVENT_ALARM_FIRED and node['alarm'] != sequence):
+                continue
+
+            self._now = timestamp
+            self._deliver(nodeid, node, event, data)
+
+        self._now = end
+
+    def stop(self):
+        self._socket.close()
+        self._socket = None
+
+    def _push(self, timestamp, nodeid, event, data):
+        heapq.heappush(self._events, (timestamp, self._sequence, nodeid, event, data))
+        self._sequence += 1
+        return self._sequence - 1
+
+    def _deliver(self, nodeid, node, event, data):
+        delay = self._now - node['time']
+
+        node['time'] = self._now
+        node['awake'] = True
+        node['alarm'] = None
+
+        self._socket.sendto(self.EVENT_HEADER.pack(delay, event, len(data)) + bytes(data),
+                            ('127.0.0.1', self._base_port + nodeid))
+
+    def _wait_for_sleep(self):
+        while any(node['awake'] for node in self._nodes.values()):
+            readable, _, _ = select.select([self._socket], [], [], self.NODE_TIMEOUT)
+
+            if not readable:
+                awake = sorted(nodeid for nodeid, node in self._nodes.items() if node['awake'])
+                raise RuntimeError('Nodes %s did not go back to sleep' % awake)
+
+            data, (_, port) = self._socket.recvfrom(self.EVENT_HEADER.size + self.EVENT_DATA_MAX_SIZE)
+            self._receive(port - self._base_port, data)
+
+    def _receive(self, nodeid, data):
+        node = self._nodes.get(nodeid)
+
+        # Ignore late events from removed nodes.
+        if node is None:
+            return
+
+        delay, event, length = self.EVENT_HEADER.unpack_from(data)
+        data = data[self.EVENT_HEADER.size:self.EVENT_HEADER.size + length]
+
+        if event == self.OT_SIM_EVENT_ALARM_FIRED:
+            node['awake'] = False
+
+            if delay != self.NO_ALARM:
+                node['alarm'] = self._push(self._now + delay, nodeid, event, b'')
+
+        elif event == self.OT_SIM_EVENT_RADIO_RECEIVED:
+            # A node transmits one frame at a time, so frames sent back to back (e.g. 6LoWPAN fragments) are
+            # received in order even when a shorter frame follows a longer one.
+            timestamp = max(self._now, node['tx_end']) + (self.PHY_HEADER_SIZE + length - 1) * self.US_PER_OCTET
+            node['tx_end'] = timestamp
+
+            for dst in sorted(self._nodes):
+                if dst != nodeid:
+                    self._push(timestamp, dst, event, data)
+
+            # Feed the sniffer (SnifferVirtualTimeTransport) with the sender's node ID.
+            self._socket.sendto(struct.pack('>I', nodeid) + data,
+                                ('127.0.0.1', self._base_port + self.WELLKNOWN_NODE_ID))
+
+
+def create_default_simulator():
+    """ Virtual time when VIRTUAL_TIME=1, for nodes built with --with-posix-event-loop=virtual-time. """
+    if int(os.getenv('VIRTUAL_TIME', "0")):
+        return VirtualTime()
+
+    return RealTime()
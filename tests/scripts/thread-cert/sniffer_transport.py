@@ -30,6 +30,7 @@
 import ctypes
 import os
 import socket
+import struct
 import sys
 
 class SnifferTransport(object):
@@ -148,6 +149,88 @@ class SnifferSocketTransport(SnifferTransport):
         return bytearray(data), nodeid
 
 
+class SnifferVirtualTimeTransport(SnifferSocketTransport):
+    """ Socket based implementation of sniffer transport fed by the virtual-time coordinator (VIRTUAL_TIME=1). """
+
+    NODE_ID_HEADER = struct.Struct('>I')
+
+    def __init__(self, nodeid):
+        # The coordinator forwards every frame to the well-known node ID.
+        SnifferSocketTransport.__init__(self, self.WELLKNOWN_NODE_ID)
+
+    def recv(self, bufsize):
+        data, _ = self._socket.recvfrom(bufsize + self.NODE_ID_HEADER.size)
+        nodeid, = self.NODE_ID_HEADER.unpack_from(data)
+
+        return bytearray(data[self.NODE_ID_HEADER.size:]), nodeid
+
+
+class SnifferMulticastTransport(SnifferTransport):
+    """ Socket based implementation of sniffer transport for the multicast radio medium (RADIO_MEDIUM=multicast). """
+
+    BASE_PORT = 9000
+
+    WELLKNOWN_NODE_ID = 34
+
+    PORT_OFFSET = int(os.getenv('PORT_OFFSET', "0"))
+
+    GROUP = '224.0.0.116'
+
+    NODE_ID_HEADER = struct.Struct('>I')
+
+    def __init__(self, nodeid):
+        self._nodeid = nodeid
+        self._socket = None
+        self._address = (self.GROUP, self.BASE_PORT + (self.PORT_OFFSET * self.WELLKNOWN_NODE_ID))
+
+    def __del__(self):
+        if not self.is_opened:
+            return
+
+        self.close()
+
+    def open(self):
+        if self.is_opened:
+            raise RuntimeError("Transport is already opened.")
+
+        self._socket = socket.socket(socket.AF_INET, socket.SOCK_DGRAM)
+
+        if not self.is_opened:
+            raise RuntimeError("Transport opening failed.")
+
+        loopback = socket.inet_aton('127.0.0.1')
+
+        self._socket.setsockopt(socket.SOL_SOCKET, socket.SO_REUSEADDR, 1)
+        self._socket.bind(self._address)
+        self._socket.setsockopt(socket.IPPROTO_IP, socket.IP_ADD_MEMBERSHIP,
+                                socket.inet_aton(self.GROUP) + loopback)
+        self._socket.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_IF, loopback)
+        self._socket.setsockopt(socket.IPPROTO_IP, socket.IP_MULTICAST_TTL, 0)
+
+    def close(self):
+        if not self.is_opened:
+            raise RuntimeError("Transport is closed.")
+
+        self._socket.close()
+        self._socket = None
+
+    @property
+    def is_opened(self):
+        return bool(self._socket is not None)
+
+    def send(self, data, nodeid):
+        # The medium is shared, so every node receives the frame regardless of nodeid.
+        return self._socket.sendto(self.NODE_ID_HEADER.pack(self._nodeid) + data, self._address)
+
+    def recv(self, bufsize):
+        while True:
+            data, _ = self._socket.recvfrom(bufsize + self.NODE_ID_HEADER.size)
+            nodeid, = self.NODE_ID_HEADER.unpack_from(data)
+
+            if nodeid != self._nodeid:
+                return bytearray(data[self.NODE_ID_HEADER.size:]), nodeid
+
+
 class MacFrame(ctypes.Structure):
     _fields_ = [("buffer", ctypes.c_ubyte * 128),
                 ("length", ctypes.c_ubyte),
@@ -212,6 +295,12 @@ class SnifferTransportFactory(object):
 
     def create_transport(self, nodeid):
         if sys.platform != "win32":
+            if int(os.getenv('VIRTUAL_TIME', "0")):
+                return SnifferVirtualTimeTransport(nodeid)
+
+            if os.getenv('RADIO_MEDIUM') == 'multicast':
+                return SnifferMulticastTransport(nodeid)
+
             return SnifferSocketTransport(nodeid)
 
         else:
@@ -0,0 +1,333 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_platform.h"
+
+#include "utils/wrap_string.h"
+
+#include <openthread/openthread.h>
+#include <openthread/thread_ftd.h>
+
+#include "openthread-instance.h"
+#include "common/encoding.hpp"
+#include "thread/address_resolver.hpp"
+#include "thread/thread_netif.hpp"
+
+#include "test_util.h"
+
+using ot::Encoding::BigEndian::HostSwap16;
+
+namespace ot {
+
+enum
+{
+    kLargeCacheEntries = 300,
+};
+
+static const otMasterKey kMasterKey =
+{
+    {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+    }
+};
+
+static Ip6::Address MakeEid(uint16_t aIndex)
+{
+    Ip6::Address address;
+
+    memset(&address, 0, sizeof(address));
+    address.mFields.m16[0] = HostSwap16(0xfd00);
+    address.mFields.m16[3] = HostSwap16(0x1234);
+    address.mFields.m16[6] = HostSwap16(static_cast<uint16_t>(aIndex * 7));
+    address.mFields.m16[7] = HostSwap16(aIndex);
+
+    return address;
+}
+
+static void FillCache(EidCache &aCache, uint16_t aFirst, uint16_t aCount)
+{
+    bool evicted;
+
+    for (uint16_t i = aFirst; i < aFirst + aCount; i++)
+    {
+        EidCache::Entry &entry = aCache.Add(MakeEid(i), evicted);
+
+        VerifyOrQuit(!evicted, "EidCache::Add() evicted an entry from a cache with free entries\n");
+        entry.mRloc16 = i;
+    }
+}
+
+static void TestEidCache(uint16_t aNumBuckets)
+{
+    EidCache::Entry entries[kLargeCacheEntries];
+    uint16_t buckets[kLargeCacheEntries];
+    EidCache cache(entries, kLargeCacheEntries, buckets, aNumBuckets);
+    EidCache::Entry *entry;
+    bool evicted;
+
+    VerifyOrQuit(cache.GetCount() == 0 && cache.GetLeastRecentlyUsed() == NULL, "EidCache is not empty\n");
+
+    FillCache(cache, 0, kLargeCacheEntries);
+    VerifyOrQuit(cache.GetCount() == kLargeCacheEntries, "EidCache::GetCount() failed\n");
+
+    for (uint16_t i = 0; i < kLargeCacheEntries; i++)
+    {
+        entry = cache.Find(MakeEid(i));
+        VerifyOrQuit(entry != NULL && entry->mRloc16 == i, "EidCache::Find() failed\n");
+    }
+
+    VerifyOrQuit(cache.Find(MakeEid(kLargeCacheEntries)) == NULL, "EidCache::Find() found a missing EID\n");
+
+    // Entries are evicted in least-recently-used order, a use moves an entry to the head of the list.
+    VerifyOrQuit(cache.GetLeastRecentlyUsed()->mRloc16 == 0, "EidCache::GetLeastRecentlyUsed() failed\n");
+    cache.MarkAsUsed(*cache.Find(MakeEid(0)));
+    VerifyOrQuit(cache.GetLeastRecentlyUsed()->mRloc16 == 1, "EidCache::MarkAsUsed() failed\n");
+
+    entry = &cache.Add(MakeEid(kLargeCacheEntries), evicted);
+    entry->mRloc16 = kLargeCacheEntries;
+    VerifyOrQuit(evicted, "EidCache::Add() did not evict from a full cache\n");
+    VerifyOrQuit(cache.GetCount() == kLargeCacheEntries, "EidCache::GetCount() failed after eviction\n");
+    VerifyOrQuit(cache.Find(MakeEid(1)) == NULL, "EidCache::Add() did not evict the least recently used entry\n");
+    VerifyOrQuit(cache.Find(MakeEid(0)) != NULL, "EidCache::Add() evicted a recently used entry\n");
+    VerifyOrQuit(cache.Find(MakeEid(kLargeCacheEntries)) == entry, "EidCache::Find() failed for new entry\n");
+
+    // A removed entry is reused before anything else is evicted.
+    cache.Remove(*cache.Find(MakeEid(100)));
+    VerifyOrQuit(cache.Find(MakeEid(100)) == NULL, "EidCache::Remove() failed\n");
+    VerifyOrQuit(cache.GetCount() == kLargeCacheEntries - 1, "EidCache::GetCount() failed after removal\n");
+
+    cache.Add(MakeEid(kLargeCacheEntries + 1), evicted);
+    VerifyOrQuit(!evicted && cache.Find(MakeEid(2)) != NULL, "EidCache::Add() did not reuse a removed entry\n");
+
+    for (uint16_t i = 2; i < kLargeCacheEntries; i++)
+    {
+        VerifyOrQuit((cache.Find(MakeEid(i)) == NULL) == (i == 100), "EidCache lost an entry\n");
+    }
+
+    // Drain the cache in least-recently-used order.
+    for (uint16_t i = 0; i < kLargeCacheEntries; i++)
+    {
+        entry = cache.GetLeastRecentlyUsed();
+        VerifyOrQuit(entry != NULL, "EidCache::GetLeastRecentlyUsed() failed\n");
+        cache.Remove(*entry);
+    }
+
+    VerifyOrQuit(cache.GetCount() == 0 && cache.GetLeastRecentlyUsed() == NULL, "EidCache is not empty\n");
+
+    FillCache(cache, 1000, 10);
+    cache.Clear();
+    VerifyOrQuit(cache.GetCount() == 0 && cache.Find(MakeEid(1000)) == NULL, "EidCache::Clear() failed\n");
+
+    for (uint16_t i = 0; i < kLargeCacheEntries; i++)
+    {
+        VerifyOrQuit(cache.GetEntry(i) == NULL, "EidCache::GetEntry() returned a free entry\n");
+    }
+
+    FillCache(cache, 0, kLargeCacheEntries);
+}
+
+void TestEidCache(void)
+{
+    TestEidCache(1);
+    TestEidCache(7);
+    TestEidCache(kLargeCacheEntries);
+}
+
+void TestAddressResolverQuery(void)
+{
+    otInstance *instance = new otInstance;
+    AddressResolver &resolver = instance->mThreadNetif.GetAddressResolver();
+    const otEidCacheCounters *counters = otThreadGetEidCacheCounters(instance);
+    otEidCacheIterator iterator = OT_EID_CACHE_ITERATOR_INIT;
+    otEidCacheEntry entry;
+    Ip6::Address eid = MakeEid(1);
+    Mac::ShortAddress rloc16;
+
+    SuccessOrQuit(otThreadSetMasterKey(instance, &kMasterKey), "otThreadSetMasterKey failed\n");
+    SuccessOrQuit(otLinkSetPanId(instance, 0x1234), "otLinkSetPanId failed\n");
+    SuccessOrQuit(otIp6SetEnabled(instance, true), "otIp6SetEnabled failed\n");
+    SuccessOrQuit(otThreadSetEnabled(instance, true), "otThreadSetEnabled failed\n");
+    SuccessOrQuit(otThreadBecomeLeader(instance), "otThreadBecomeLeader failed\n");
+
+    VerifyOrQuit(otThreadGetNextEidCacheEntry(instance, &iterator, &entry) == OT_ERROR_NOT_FOUND,
+                 "otThreadGetNextEidCacheEntry() found an entry in an empty cache\n");
+
+    VerifyOrQuit(resolver.Resolve(eid, rloc16) == OT_ERROR_ADDRESS_QUERY, "Resolve() did not start a query\n");
+    VerifyOrQuit(resolver.Resolve(eid, rloc16) == OT_ERROR_ADDRESS_QUERY, "Resolve() did not wait for a query\n");
+
+    VerifyOrQuit(counters->mHits == 0 && counters->mMisses == 2 && counters->mEvictions == 0 &&
+                 counters->mQueries == 1, "Unexpected EID cache counters\n");
+
+    iterator = OT_EID_CACHE_ITERATOR_INIT;
+    SuccessOrQuit(otThreadGetNextEidCacheEntry(instance, &iterator, &entry), "otThreadGetNextEidCacheEntry failed\n");
+    VerifyOrQuit(memcmp(&entry.mTarget, &eid, sizeof(eid)) == 0 && !entry.mValid,
+                 "otThreadGetNextEidCacheEntry() returned an unexpected entry\n");
+    VerifyOrQuit(otThreadGetNextEidCacheEntry(instance, &iterator, &entry) == OT_ERROR_NOT_FOUND,
+                 "otThreadGetNextEidCacheEntry() did not stop\n");
+    VerifyOrQuit(otThreadGetNextEidCacheEntry(instance, NULL, &entry) == OT_ERROR_INVALID_ARGS,
+                 "otThreadGetNextEidCacheEntry() accepted a NULL iterator\n");
+
+    resolver.Clear();
+    iterator = OT_EID_CACHE_ITERATOR_INIT;
+    VerifyOrQuit(otThreadGetNextEidCacheEntry(instance, &iterator, &entry) == OT_ERROR_NOT_FOUND,
+                 "AddressResolver::Clear() failed\n");
+
+    SuccessOrQuit(otThreadSetEnabled(instance, false), "otThreadSetEnabled failed\n");
+    SuccessOrQuit(otIp6SetEnabled(instance, false), "otIp6SetEnabled failed\n");
+
+    delete instance;
+}
+
+/**
+ * This class is the flat array with linear search and age shifting used before the EID cache was hashed, it serves as
+ * the reference.
+ *
+ */
+class ReferenceCache
+{
+public:
+    explicit ReferenceCache(uint16_t aNumEntries):
+        mNumEntries(aNumEntries)
+    {
+        for (uint16_t i = 0; i < mNumEntries; i++)
+        {
+            mEntries[i].mTarget = MakeEid(i);
+            mEntries[i].mRloc16 = i;
+            mEntries[i].mAge = i;
+        }
+    }
+
+    bool Resolve(const Ip6::Address &aEid, uint16_t &aRloc16)
+    {
+        for (uint16_t i = 0; i < mNumEntries; i++)
+        {
+            if (memcmp(&mEntries[i].mTarget, &aEid, sizeof(aEid)) == 0)
+            {
+                for (uint16_t j = 0; j < mNumEntries; j++)
+                {
+                    if (mEntries[j].mAge < mEntries[i].mAge)
+                    {
+                        mEntries[j].mAge++;
+                    }
+                }
+
+                mEntries[i].mAge = 0;
+                aRloc16 = mEntries[i].mRloc16;
+                return true;
+            }
+        }
+
+        return false;
+    }
+
+private:
+    struct Entry
+    {
+        Ip6::Address mTarget;
+        uint16_t     mRloc16;
+        uint16_t     mAge;
+    };
+
+    Entry    mEntries[kLargeCacheEntries];
+    uint16_t mNumEntries;
+};
+
+void TestEidCacheBenchmark(void)
+{
+    enum
+    {
+        kNumLookups = 200000,
+    };
+
+    static const uint16_t kSizes[] = { 10, 64, 256, kLargeCacheEntries };
+    static EidCache::Entry entries[kLargeCacheEntries];
+    static uint16_t buckets[kLargeCacheEntries];
+    static Ip6::Address eids[kLargeCacheEntries];
+
+    for (size_t n = 0; n < sizeof(kSizes) / sizeof(kSizes[0]); n++)
+    {
+        uint16_t size = kSizes[n];
+        ReferenceCache *reference = new ReferenceCache(size);
+        EidCache cache(entries, size, buckets, size);
+        uint32_t sum = 0;
+        uint64_t start;
+        uint64_t elapsed[2];
+
+        FillCache(cache, 0, size);
+
+        for (uint16_t i = 0; i < size; i++)
+        {
+            eids[i] = MakeEid(i);
+        }
+
+        start = testPlatGetMicroseconds();
+
+        for (uint32_t i = 0; i < kNumLookups; i++)
+        {
+            uint16_t rloc16 = 0;
+
+            VerifyOrQuit(reference->Resolve(eids[(i * 7919) % size], rloc16), "ReferenceCache lookup failed\n");
+            sum += rloc16;
+        }
+
+        elapsed[0] = testPlatGetMicroseconds() - start;
+        start = testPlatGetMicroseconds();
+
+        for (uint32_t i = 0; i < kNumLookups; i++)
+        {
+            EidCache::Entry *entry = cache.Find(eids[(i * 7919) % size]);
+
+            VerifyOrQuit(entry != NULL, "EidCache lookup failed\n");
+            cache.MarkAsUsed(*entry);
+            sum -= entry->mRloc16;
+        }
+
+        elapsed[1] = testPlatGetMicroseconds() - start;
+
+        VerifyOrQuit(sum == 0, "EidCache disagrees with linear search\n");
+
+        printf("EidCacheBenchmark: %3u entries, linear search %8.1f ns/hit, hashed %8.1f ns/hit\n", size,
+               1000.0 * elapsed[0] / kNumLookups, 1000.0 * elapsed[1] / kNumLookups);
+
+        delete reference;
+    }
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestEidCache();
+    ot::TestAddressResolverQuery();
+    ot::TestEidCacheBenchmark();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
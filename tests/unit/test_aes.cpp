@@ -30,10 +30,13 @@
 
 #include <openthread/openthread.h>
 
+#include "openthread-instance.h"
 #include "common/debug.hpp"
+#include "common/message.hpp"
 #include "crypto/aes_ccm.hpp"
 #include "crypto/mbedtls.hpp"
 
+#include "test_platform.h"
 #include "test_util.h"
 
 #ifndef OPENTHREAD_MULTIPLE_INSTANCE
@@ -234,12 +237,352 @@ void TestMacCommandFrame()
                  "TestMacCommandFrame decrypt failed\n");
 }
 
+/**
+ * Verifies Packet Vector #1 from RFC 3610, which spans more than one block of payload.
+ */
+void TestAesCcmRfc3610()
+{
+    const uint8_t key[] =
+    {
+        0xc0, 0xc1, 0xc2, 0xc3, 0xc4, 0xc5, 0xc6, 0xc7,
+        0xc8, 0xc9, 0xca, 0xcb, 0xcc, 0xcd, 0xce, 0xcf,
+    };
+
+    const uint8_t nonce[] =
+    {
+        0x00, 0x00, 0x00, 0x03, 0x02, 0x01, 0x00, 0xa0,
+        0xa1, 0xa2, 0xa3, 0xa4, 0xa5,
+    };
+
+    const uint8_t decrypted[] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x08, 0x09, 0x0a, 0x0b, 0x0c, 0x0d, 0x0e, 0x0f,
+        0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17,
+        0x18, 0x19, 0x1a, 0x1b, 0x1c, 0x1d, 0x1e,
+    };
+
+    const uint8_t encrypted[] =
+    {
+        0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07,
+        0x58, 0x8c, 0x97, 0x9a, 0x61, 0xc6, 0x63, 0xd2,
+        0xf0, 0x66, 0xd0, 0xc2, 0xc0, 0xf9, 0x89, 0x80,
+        0x6d, 0x5f, 0x6b, 0x61, 0xda, 0xc3, 0x84, 0x17,
+        0xe8, 0xd1, 0x2c, 0xfd, 0xf9, 0x26, 0xe0,
+    };
+
+    ot::Crypto::AesCcm aesCcm;
+    uint32_t headerLength = 8;
+    uint32_t payloadLength = sizeof(decrypted) - headerLength;
+    uint8_t tagLength = 8;
+    uint8_t test[sizeof(encrypted)];
+
+    memcpy(test, decrypted, sizeof(decrypted));
+
+    SuccessOrQuit(aesCcm.SetKey(key, sizeof(key)), "AesCcm::SetKey failed\n");
+    aesCcm.Init(headerLength, payloadLength, tagLength, nonce, sizeof(nonce));
+    aesCcm.Header(test, headerLength);
+    aesCcm.Payload(test + headerLength, test + headerLength, payloadLength, true);
+    aesCcm.Finalize(test + headerLength + payloadLength, &tagLength);
+
+    VerifyOrQuit(memcmp(test, encrypted, sizeof(encrypted)) == 0,
+                 "TestAesCcmRfc3610 encrypt failed\n");
+
+    aesCcm.Init(headerLength, payloadLength, tagLength, nonce, sizeof(nonce));
+    aesCcm.Header(test, headerLength);
+    aesCcm.Payload(test + headerLength, test + headerLength, payloadLength, false);
+    aesCcm.Finalize(test + headerLength + payloadLength, &tagLength);
+
+    VerifyOrQuit(memcmp(test, decrypted, sizeof(decrypted)) == 0,
+                 "TestAesCcmRfc3610 decrypt failed\n");
+}
+
+/**
+ * Verifies that whole-block processing matches byte-at-a-time processing for any split of the payload.
+ */
+void TestAesCcmPayloadChunks()
+{
+    const uint8_t headerLengths[] = { 0, 5, 16, 29 };
+    const uint8_t tagLengths[] = { 4, 8, 16 };
+    ot::Crypto::AesCcm aesCcm;
+    uint8_t key[16];
+    uint8_t nonce[13];
+    uint8_t header[32];
+    uint8_t plainText[160];
+    uint8_t expected[sizeof(plainText)];
+    uint8_t result[sizeof(plainText)];
+    uint8_t expectedTag[16];
+    uint8_t tag[16];
+    uint8_t tagLength;
+
+    for (unsigned i = 0; i < sizeof(key); i++)
+    {
+        key[i] = static_cast<uint8_t>(random());
+    }
+
+    for (unsigned i = 0; i < sizeof(nonce); i++)
+    {
+        nonce[i] = static_cast<uint8_t>(random());
+    }
+
+    for (unsigned i = 0; i < sizeof(header); i++)
+    {
+        header[i] = static_cast<uint8_t>(random());
+    }
+
+    for (unsigned i = 0; i < sizeof(plainText); i++)
+    {
+        plainText[i] = static_cast<uint8_t>(random());
+    }
+
+    SuccessOrQuit(aesCcm.SetKey(key, sizeof(key)), "AesCcm::SetKey failed\n");
+
+    for (unsigned h = 0; h < sizeof(headerLengths); h++)
+    {
+        for (unsigned t = 0; t < sizeof(tagLengths); t++)
+        {
+            for (uint32_t length = 0; length <= sizeof(plainText); length++)
+            {
+                // reference: one byte at a time
+                memcpy(expected, plainText, length);
+                aesCcm.Init(headerLengths[h], length, tagLengths[t], nonce, sizeof(nonce));
+                aesCcm.Header(header, headerLengths[h]);
+
+                for (uint32_t i = 0; i < length; i++)
+                {
+                    aesCcm.Payload(expected + i, expected + i, 1, true);
+                }
+
+                tagLength = tagLengths[t];
+                aesCcm.Finalize(expectedTag, &tagLength);
+
+                for (uint32_t chunk = 3; chunk <= length + 16; chunk += 13)
+                {
+                    memcpy(result, plainText, length);
+                    aesCcm.Init(headerLengths[h], length, tagLengths[t], nonce, sizeof(nonce));
+                    aesCcm.Header(header, headerLengths[h]);
+
+                    for (uint32_t i = 0; i < length; i += chunk)
+                    {
+                        uint32_t remaining = length - i;
+                        aesCcm.Payload(result + i, result + i, remaining < chunk ? remaining : chunk, true);
+                    }
+
+                    tagLength = tagLengths[t];
+                    aesCcm.Finalize(tag, &tagLength);
+
+                    VerifyOrQuit(memcmp(result, expected, length) == 0, "AesCcm::Payload encrypt mismatch\n");
+                    VerifyOrQuit(memcmp(tag, expectedTag, tagLength) == 0, "AesCcm::Finalize tag mismatch\n");
+
+                    aesCcm.Init(headerLengths[h], length, tagLengths[t], nonce, sizeof(nonce));
+                    aesCcm.Header(header, headerLengths[h]);
+                    aesCcm.Payload(result, result, length, false);
+                    tagLength = tagLengths[t];
+                    aesCcm.Finalize(tag, &tagLength);
+
+                    VerifyOrQuit(memcmp(result, plainText, length) == 0, "AesCcm::Payload decrypt mismatch\n");
+                    VerifyOrQuit(memcmp(tag, expectedTag, tagLength) == 0, "AesCcm::Finalize tag mismatch\n");
+                }
+            }
+        }
+    }
+}
+
+/**
+ * Verifies in-place processing of a message payload that spans several message buffers.
+ */
+void TestAesCcmMessage()
+{
+    otInstance instance;
+    ot::MessagePool messagePool(&instance);
+    ot::Message *message;
+    ot::Crypto::AesCcm aesCcm;
+    uint8_t key[16];
+    uint8_t nonce[13];
+    uint8_t plainText[600];
+    uint8_t expected[sizeof(plainText)];
+    uint8_t result[sizeof(plainText)];
+    uint8_t expectedTag[4];
+    uint8_t tag[4];
+    uint8_t tagLength;
+
+    for (unsigned i = 0; i < sizeof(key); i++)
+    {
+        key[i] = static_cast<uint8_t>(random());
+    }
+
+    for (unsigned i = 0; i < sizeof(nonce); i++)
+    {
+        nonce[i] = static_cast<uint8_t>(random());
+    }
+
+    for (unsigned i = 0; i < sizeof(plainText); i++)
+    {
+        plainText[i] = static_cast<uint8_t>(random());
+    }
+
+    SuccessOrQuit(aesCcm.SetKey(key, sizeof(key)), "AesCcm::SetKey failed\n");
+
+    VerifyOrQuit((message = messagePool.New(ot::Message::kTypeIp6, 0)) != NULL, "Message::New failed\n");
+    SuccessOrQuit(message->SetLength(sizeof(plainText)), "Message::SetLength failed\n");
+
+    for (uint16_t offset = 0; offset < sizeof(plainText); offset += 37)
+    {
+        uint16_t length = static_cast<uint16_t>(sizeof(plainText) - offset);
+
+        memcpy(expected, plainText, sizeof(plainText));
+        aesCcm.Init(offset, length, sizeof(tag), nonce, sizeof(nonce));
+        aesCcm.Header(expected, offset);
+        aesCcm.Payload(expected + offset, expected + offset, length, true);
+        tagLength = sizeof(expectedTag);
+        aesCcm.Finalize(expectedTag, &tagLength);
+
+        message->Write(0, sizeof(plainText), plainText);
+        aesCcm.Init(offset, length, sizeof(tag), nonce, sizeof(nonce));
+        aesCcm.Header(plainText, offset);
+        aesCcm.Payload(*message, offset, length, true);
+        tagLength = sizeof(tag);
+        aesCcm.Finalize(tag, &tagLength);
+
+        VerifyOrQuit(message->Read(0, sizeof(result), result) == sizeof(result), "Message::Read failed\n");
+        VerifyOrQuit(memcmp(result, expected, sizeof(result)) == 0, "AesCcm::Payload message encrypt mismatch\n");
+        VerifyOrQuit(memcmp(tag, expectedTag, sizeof(tag)) == 0, "AesCcm::Finalize tag mismatch\n");
+
+        aesCcm.Init(offset, length, sizeof(tag), nonce, sizeof(nonce));
+        aesCcm.Header(plainText, offset);
+        aesCcm.Payload(*message, offset, length, false);
+        tagLength = sizeof(tag);
+        aesCcm.Finalize(tag, &tagLength);
+
+        VerifyOrQuit(message->Read(0, sizeof(result), result) == sizeof(result), "Message::Read failed\n");
+        VerifyOrQuit(memcmp(result, plainText, sizeof(result)) == 0, "AesCcm::Payload message decrypt mismatch\n");
+        VerifyOrQuit(memcmp(tag, expectedTag, sizeof(tag)) == 0, "AesCcm::Finalize tag mismatch\n");
+    }
+
+    SuccessOrQuit(message->Free(), "Message::Free failed\n");
+}
+
+/**
+ * Verifies that the key schedule is rebuilt whenever a different key is set.
+ */
+void TestAesCcmKeyChange()
+{
+    uint8_t keys[2][16];
+    uint8_t nonce[13] = { 0 };
+    uint8_t frame[2][40];
+    uint8_t expected[2][40];
+    uint8_t tooLong[ot::Crypto::AesCcm::kMaxKeyLength + 1] = { 0 };
+    uint8_t tagLength;
+    ot::Crypto::AesCcm aesCcm;
+
+    for (unsigned k = 0; k < 2; k++)
+    {
+        ot::Crypto::AesCcm fresh;
+
+        for (unsigned i = 0; i < sizeof(keys[k]); i++)
+        {
+            keys[k][i] = static_cast<uint8_t>(random());
+        }
+
+        memset(expected[k], k, sizeof(expected[k]));
+        SuccessOrQuit(fresh.SetKey(keys[k], sizeof(keys[k])), "AesCcm::SetKey failed\n");
+        fresh.Init(0, 32, 8, nonce, sizeof(nonce));
+        fresh.Payload(expected[k], expected[k], 32, true);
+        tagLength = 8;
+        fresh.Finalize(expected[k] + 32, &tagLength);
+    }
+
+    for (unsigned round = 0; round < 4; round++)
+    {
+        unsigned k = (round >> 1) & 1;
+
+        memset(frame[k], k, sizeof(frame[k]));
+        SuccessOrQuit(aesCcm.SetKey(keys[k], sizeof(keys[k])), "AesCcm::SetKey failed\n");
+        aesCcm.Init(0, 32, 8, nonce, sizeof(nonce));
+        aesCcm.Payload(frame[k], frame[k], 32, true);
+        tagLength = 8;
+        aesCcm.Finalize(frame[k] + 32, &tagLength);
+
+        VerifyOrQuit(memcmp(frame[k], expected[k], sizeof(frame[k])) == 0, "AesCcm::SetKey used a stale key\n");
+    }
+
+    VerifyOrQuit(aesCcm.SetKey(tooLong, sizeof(tooLong)) == OT_ERROR_INVALID_ARGS,
+                 "AesCcm::SetKey accepted an oversized key\n");
+}
+
+/**
+ * Measures the per-frame cost of securing a full-size 802.15.4 frame.
+ */
+void TestAesCcmFrameBenchmark()
+{
+    enum
+    {
+        kNumFrames     = 20000,
+        kHeaderLength  = 23,
+        kPayloadLength = 100,
+        kTagLength     = 4,
+    };
+
+    uint8_t key[16];
+    uint8_t nonce[13];
+    uint8_t frame[kHeaderLength + kPayloadLength + kTagLength];
+    uint8_t tagLength;
+    ot::Crypto::AesCcm aesCcm;
+    uint64_t start;
+    uint64_t fresh;
+    uint64_t cached;
+
+    memset(key, 0x5a, sizeof(key));
+    memset(nonce, 0xa5, sizeof(nonce));
+    memset(frame, 0x3c, sizeof(frame));
+
+    start = testPlatGetMicroseconds();
+
+    for (uint32_t i = 0; i < kNumFrames; i++)
+    {
+        ot::Crypto::AesCcm perFrame;
+
+        nonce[0] = static_cast<uint8_t>(i);
+        perFrame.SetKey(key, sizeof(key));
+        perFrame.Init(kHeaderLength, kPayloadLength, kTagLength, nonce, sizeof(nonce));
+        perFrame.Header(frame, kHeaderLength);
+        perFrame.Payload(frame + kHeaderLength, frame + kHeaderLength, kPayloadLength, true);
+        tagLength = kTagLength;
+        perFrame.Finalize(frame + kHeaderLength + kPayloadLength, &tagLength);
+    }
+
+    fresh = testPlatGetMicroseconds() - start;
+    start = testPlatGetMicroseconds();
+
+    for (uint32_t i = 0; i < kNumFrames; i++)
+    {
+        nonce[0] = static_cast<uint8_t>(i);
+        aesCcm.SetKey(key, sizeof(key));
+        aesCcm.Init(kHeaderLength, kPayloadLength, kTagLength, nonce, sizeof(nonce));
+        aesCcm.Header(frame, kHeaderLength);
+        aesCcm.Payload(frame + kHeaderLength, frame + kHeaderLength, kPayloadLength, true);
+        tagLength = kTagLength;
+        aesCcm.Finalize(frame + kHeaderLength + kPayloadLength, &tagLength);
+    }
+
+    cached = testPlatGetMicroseconds() - start;
+
+    printf("AesCcmFrameBenchmark: %d frames of %d bytes per run\n", kNumFrames, static_cast<int>(sizeof(frame)));
+    printf("AesCcmFrameBenchmark: new engine per frame  %8.2f us/frame\n", static_cast<double>(fresh) / kNumFrames);
+    printf("AesCcmFrameBenchmark: reused engine         %8.2f us/frame\n", static_cast<double>(cached) / kNumFrames);
+}
+
 #ifdef ENABLE_TEST_MAIN
 int main(void)
 {
     TestMacBeaconFrame();
     TestMacDataFrame();
     TestMacCommandFrame();
+    TestAesCcmRfc3610();
+    TestAesCcmPayloadChunks();
+    TestAesCcmMessage();
+    TestAesCcmKeyChange();
+    TestAesCcmFrameBenchmark();
     printf("All tests passed\n");
     return 0;
 }
@@ -0,0 +1,183 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_platform.h"
+
+#include "utils/wrap_string.h"
+
+#include <openthread/openthread.h>
+
+#include "openthread-instance.h"
+#include "common/debug.hpp"
+#include "common/message.hpp"
+#include "net/ip6.hpp"
+
+#include "test_util.h"
+
+namespace ot {
+
+/**
+ * This function is the byte-at-a-time reference implementation of the Internet checksum.
+ */
+static uint16_t ReferenceChecksum(uint16_t aChecksum, const uint8_t *aBuf, uint16_t aLength)
+{
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        aChecksum = Ip6::Ip6::UpdateChecksum(aChecksum, (i & 1) ? aBuf[i] : static_cast<uint16_t>(aBuf[i] << 8));
+    }
+
+    return aChecksum;
+}
+
+void TestChecksumEquivalence(void)
+{
+    uint8_t buffer[1300];
+    uint8_t pattern = 0;
+
+    for (unsigned i = 0; i < 2000; i++)
+    {
+        uint16_t offset = static_cast<uint16_t>(random() % 8);
+        uint16_t length = static_cast<uint16_t>(random() % (sizeof(buffer) - offset));
+        uint16_t initial = static_cast<uint16_t>(random());
+
+        // Mix random data with runs of 0x00 and 0xff, which exercise the carry folding.
+        switch (i % 3)
+        {
+        case 0:
+            for (unsigned j = 0; j < sizeof(buffer); j++)
+            {
+                buffer[j] = static_cast<uint8_t>(random());
+            }
+
+            break;
+
+        default:
+            memset(buffer, pattern, sizeof(buffer));
+            pattern = ~pattern;
+            break;
+        }
+
+        if (i % 5 == 0)
+        {
+            initial = (i % 10 == 0) ? 0 : 0xffff;
+        }
+
+        VerifyOrQuit(Ip6::Ip6::UpdateChecksum(initial, buffer + offset, length) ==
+                     ReferenceChecksum(initial, buffer + offset, length),
+                     "Ip6::UpdateChecksum() differs from the reference\n");
+    }
+}
+
+void TestMessageChecksum(void)
+{
+    otInstance instance;
+    MessagePool messagePool(&instance);
+    Message *message;
+    uint8_t buffer[1280];
+
+    for (unsigned i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = static_cast<uint8_t>(random());
+    }
+
+    for (uint16_t reserved = 0; reserved < 4; reserved++)
+    {
+        VerifyOrQuit((message = messagePool.New(Message::kTypeIp6, reserved)) != NULL, "Message::New failed\n");
+        SuccessOrQuit(message->SetLength(sizeof(buffer)), "Message::SetLength failed\n");
+        VerifyOrQuit(message->Write(0, sizeof(buffer), buffer) == sizeof(buffer), "Message::Write failed\n");
+
+        // Cover every buffer boundary with ranges starting on even and odd offsets.
+        for (unsigned i = 0; i < 500; i++)
+        {
+            uint16_t offset = static_cast<uint16_t>(random() % sizeof(buffer));
+            uint16_t length = static_cast<uint16_t>(random() % (sizeof(buffer) - offset + 1));
+
+            VerifyOrQuit(message->UpdateChecksum(0, offset, length) == ReferenceChecksum(0, buffer + offset, length),
+                         "Message::UpdateChecksum() differs from the reference\n");
+        }
+
+        SuccessOrQuit(message->Free(), "Message::Free failed\n");
+    }
+}
+
+void TestChecksumBenchmark(void)
+{
+    const uint16_t kLengths[] = { 8, 64, 127, 1280 };
+    const uint32_t kNumBytes = 64 * 1024 * 1024;
+    uint8_t buffer[1280];
+
+    for (unsigned i = 0; i < sizeof(buffer); i++)
+    {
+        buffer[i] = static_cast<uint8_t>(random());
+    }
+
+    for (size_t n = 0; n < sizeof(kLengths) / sizeof(kLengths[0]); n++)
+    {
+        uint32_t iterations = kNumBytes / kLengths[n];
+        uint16_t checksum = 0;
+        uint64_t startTime;
+        uint64_t referenceDuration;
+        uint64_t duration;
+
+        startTime = testPlatGetMicroseconds();
+
+        for (uint32_t i = 0; i < iterations / 16; i++)
+        {
+            checksum = ReferenceChecksum(checksum, buffer, kLengths[n]);
+        }
+
+        referenceDuration = (testPlatGetMicroseconds() - startTime) * 16;
+        startTime = testPlatGetMicroseconds();
+
+        for (uint32_t i = 0; i < iterations; i++)
+        {
+            checksum = Ip6::Ip6::UpdateChecksum(checksum, buffer, kLengths[n]);
+        }
+
+        duration = testPlatGetMicroseconds() - startTime;
+
+        printf("ChecksumBenchmark: %4u bytes, byte loop %7.1f MB/s, word loop %7.1f MB/s (checksum %04x)\n",
+               kLengths[n],
+               static_cast<double>(kNumBytes) / (referenceDuration + 1),
+               static_cast<double>(kNumBytes) / (duration + 1),
+               checksum);
+    }
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestChecksumEquivalence();
+    ot::TestMessageChecksum();
+    ot::TestChecksumBenchmark();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,532 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include <openthread/platform/random.h>
+
+#include "common/code_utils.hpp"
+#include "ncp/hdlc.hpp"
+
+#include "test_platform.h"
+#include "test_util.h"
+
+namespace ot {
+
+// This module implements unit-test for the HDLC-lite encoder and decoder.
+
+enum
+{
+    kMaxFrameLength   = 1300,
+    kMaxEncodedLength = 2 * (kMaxFrameLength + 2) + 2,
+    kNumFrames        = 200,
+    kStreamSize       = kNumFrames * kMaxEncodedLength,
+    kMaxEvents        = 2 * kNumFrames,
+    kFlagSequence     = 0x7e,
+    kEscapeSequence   = 0x7d,
+};
+
+class TestBuffer : public Hdlc::Encoder::BufferWriteIterator
+{
+public:
+    TestBuffer(uint8_t *aBuffer, uint16_t aLength)
+    {
+        mBuffer = aBuffer;
+        mWritePointer = aBuffer;
+        mRemainingLength = aLength;
+    }
+
+    uint16_t GetLength(void) const { return static_cast<uint16_t>(mWritePointer - mBuffer); }
+
+private:
+    uint8_t *mBuffer;
+};
+
+static uint16_t sReferenceFcsTable[256];
+
+/**
+ * This function builds the byte-wise FCS table from the bit-wise CRC-16/X.25 definition.
+ *
+ */
+static void InitReferenceFcs(void)
+{
+    for (uint16_t i = 0; i < 256; i++)
+    {
+        uint16_t fcs = i;
+
+        for (uint8_t j = 0; j < 8; j++)
+        {
+            fcs = (fcs & 1) ? ((fcs >> 1) ^ 0x8408) : (fcs >> 1);
+        }
+
+        sReferenceFcsTable[i] = fcs;
+    }
+}
+
+static uint16_t ReferenceFcs(uint16_t aFcs, uint8_t aByte)
+{
+    return (aFcs >> 8) ^ sReferenceFcsTable[(aFcs ^ aByte) & 0xff];
+}
+
+static bool ReferenceNeedsEscape(uint8_t aByte)
+{
+    return aByte == 0x11 || aByte == 0x13 || aByte == 0x7d || aByte == 0x7e || aByte == 0xf8;
+}
+
+static void ReferenceEncodeByte(uint8_t aByte, uint8_t *aOutBuf, uint16_t &aOutLength)
+{
+    if (ReferenceNeedsEscape(aByte))
+    {
+        aOutBuf[aOutLength++] = kEscapeSequence;
+        aOutBuf[aOutLength++] = aByte ^ 0x20;
+    }
+    else
+    {
+        aOutBuf[aOutLength++] = aByte;
+    }
+}
+
+/**
+ * This function encodes a frame one byte at a time, as the encoder did before it processed whole buffers.
+ *
+ */
+static uint16_t ReferenceEncode(const uint8_t *aFrame, uint16_t aLength, uint8_t *aOutBuf)
+{
+    uint16_t outLength = 0;
+    uint16_t fcs = 0xffff;
+
+    aOutBuf[outLength++] = kFlagSequence;
+
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        ReferenceEncodeByte(aFrame[i], aOutBuf, outLength);
+        fcs = ReferenceFcs(fcs, aFrame[i]);
+    }
+
+    fcs ^= 0xffff;
+    ReferenceEncodeByte(fcs & 0xff, aOutBuf, outLength);
+    ReferenceEncodeByte(fcs >> 8, aOutBuf, outLength);
+    aOutBuf[outLength++] = kFlagSequence;
+
+    return outLength;
+}
+
+/**
+ * This structure records the frames and errors reported by a decoder.
+ *
+ */
+struct DecoderEvents
+{
+    void Add(otError aError, const uint8_t *aFrame, uint16_t aLength)
+    {
+        VerifyOrQuit(mNumEvents < kMaxEvents, "Too many decoder events\n");
+        mError[mNumEvents] = aError;
+        mLength[mNumEvents] = aLength;
+        mChecksum[mNumEvents] = 0;
+
+        for (uint16_t i = 0; i < aLength; i++)
+        {
+            mChecksum[mNumEvents] = ReferenceFcs(mChecksum[mNumEvents], aFrame[i]);
+        }
+
+        mNumEvents++;
+    }
+
+    bool operator==(const DecoderEvents &aOther) const
+    {
+        return mNumEvents == aOther.mNumEvents &&
+               memcmp(mError, aOther.mError, mNumEvents * sizeof(mError[0])) == 0 &&
+               memcmp(mLength, aOther.mLength, mNumEvents * sizeof(mLength[0])) == 0 &&
+               memcmp(mChecksum, aOther.mChecksum, mNumEvents * sizeof(mChecksum[0])) == 0;
+    }
+
+    uint16_t mNumEvents;
+    otError  mError[kMaxEvents];
+    uint16_t mLength[kMaxEvents];
+    uint16_t mChecksum[kMaxEvents];
+};
+
+static void HandleFrame(void *aContext, uint8_t *aFrame, uint16_t aFrameLength)
+{
+    static_cast<DecoderEvents *>(aContext)->Add(OT_ERROR_NONE, aFrame, aFrameLength);
+}
+
+static void HandleError(void *aContext, otError aError, uint8_t *aFrame, uint16_t aFrameLength)
+{
+    static_cast<DecoderEvents *>(aContext)->Add(aError, aFrame, aFrameLength);
+}
+
+static void CountFrame(void *aContext, uint8_t *aFrame, uint16_t aFrameLength)
+{
+    ++*static_cast<uint32_t *>(aContext);
+
+    (void)aFrame;
+    (void)aFrameLength;
+}
+
+static void CountError(void *aContext, otError aError, uint8_t *aFrame, uint16_t aFrameLength)
+{
+    // Errors are counted as a large value so that they are noticed.
+    *static_cast<uint32_t *>(aContext) += 1000;
+
+    (void)aError;
+    (void)aFrame;
+    (void)aFrameLength;
+}
+
+/**
+ * This function decodes a stream one byte at a time, as the decoder did before it processed whole runs.
+ *
+ */
+static void ReferenceDecode(const uint8_t *aStream, uint32_t aLength, uint16_t aOutLength,
+                            Hdlc::Decoder::FrameHandler aFrameHandler, Hdlc::Decoder::ErrorHandler aErrorHandler,
+                            void *aContext)
+{
+    uint8_t outBuf[kMaxFrameLength + 2];
+    uint16_t outOffset = 0;
+    uint16_t fcs = 0;
+    enum { kNoSync, kSync, kEscaped } state = kNoSync;
+
+    for (uint32_t i = 0; i < aLength; i++)
+    {
+        uint8_t byte = aStream[i];
+
+        if (state == kNoSync)
+        {
+            if (byte == kFlagSequence)
+            {
+                state = kSync;
+                outOffset = 0;
+                fcs = 0xffff;
+            }
+        }
+        else if (state == kSync && byte == kFlagSequence)
+        {
+            if (outOffset > sizeof(uint16_t))
+            {
+                if (fcs == 0xf0b8)
+                {
+                    aFrameHandler(aContext, outBuf, outOffset - sizeof(uint16_t));
+                }
+                else
+                {
+                    aErrorHandler(aContext, OT_ERROR_PARSE, outBuf, outOffset);
+                }
+            }
+
+            outOffset = 0;
+            fcs = 0xffff;
+        }
+        else if (state == kSync && byte == kEscapeSequence)
+        {
+            state = kEscaped;
+        }
+        else if (outOffset < aOutLength)
+        {
+            byte ^= (state == kEscaped) ? 0x20 : 0;
+            fcs = ReferenceFcs(fcs, byte);
+            outBuf[outOffset++] = byte;
+            state = kSync;
+        }
+        else
+        {
+            aErrorHandler(aContext, OT_ERROR_NO_BUFS, outBuf, outOffset);
+            state = kNoSync;
+        }
+    }
+}
+
+/**
+ * This function generates a random frame, @p aEscapePercent of the bytes are values which need escaping.
+ *
+ */
+static uint16_t GenerateFrame(uint8_t *aFrame, uint16_t aMaxLength, uint32_t aEscapePercent)
+{
+    static const uint8_t kEscapedBytes[] = { 0x11, 0x13, 0x7d, 0x7e, 0xf8 };
+    uint16_t length = static_cast<uint16_t>(otPlatRandomGet() % (aMaxLength + 1));
+
+    for (uint16_t i = 0; i < length; i++)
+    {
+        if (otPlatRandomGet() % 100 < aEscapePercent)
+        {
+            aFrame[i] = kEscapedBytes[otPlatRandomGet() % sizeof(kEscapedBytes)];
+        }
+        else
+        {
+            do
+            {
+                aFrame[i] = static_cast<uint8_t>(otPlatRandomGet());
+            }
+            while (ReferenceNeedsEscape(aFrame[i]));
+        }
+    }
+
+    return length;
+}
+
+static uint8_t sStream[kStreamSize];
+
+void TestHdlcEncoder(void)
+{
+    static const uint32_t kEscapePercents[] = { 0, 2, 50, 100 };
+    uint8_t frame[kMaxFrameLength];
+    uint8_t expected[kMaxEncodedLength];
+    uint8_t encoded[kMaxEncodedLength];
+    Hdlc::Encoder encoder;
+
+    InitReferenceFcs();
+
+    for (uint32_t n = 0; n < kNumFrames; n++)
+    {
+        uint16_t length = GenerateFrame(frame, kMaxFrameLength, kEscapePercents[n % 4]);
+        uint16_t expectedLength = ReferenceEncode(frame, length, expected);
+
+        // Whole frame, split in two, and one byte at a time.
+        for (int mode = 0; mode < 3; mode++)
+        {
+            TestBuffer buffer(encoded, sizeof(encoded));
+            uint16_t split = (length > 0) ? static_cast<uint16_t>(otPlatRandomGet() % length) : 0;
+
+            SuccessOrQuit(encoder.Init(buffer), "Encoder::Init() failed\n");
+
+            switch (mode)
+            {
+            case 0:
+                SuccessOrQuit(encoder.Encode(frame, length, buffer), "Encoder::Encode() failed\n");
+                break;
+
+            case 1:
+                SuccessOrQuit(encoder.Encode(frame, split, buffer), "Encoder::Encode() failed\n");
+                SuccessOrQuit(encoder.Encode(frame + split, length - split, buffer), "Encoder::Encode() failed\n");
+                break;
+
+            case 2:
+                for (uint16_t i = 0; i < length; i++)
+                {
+                    SuccessOrQuit(encoder.Encode(frame[i], buffer), "Encoder::Encode() failed\n");
+                }
+
+                break;
+            }
+
+            SuccessOrQuit(encoder.Finalize(buffer), "Encoder::Finalize() failed\n");
+
+            VerifyOrQuit(buffer.GetLength() == expectedLength && memcmp(encoded, expected, expectedLength) == 0,
+                         "Encoded frame differs from the reference encoding\n");
+        }
+
+        // Running out of space leaves the iterator and the FCS unchanged, so encoding can resume.
+        if (length > 0)
+        {
+            TestBuffer full(encoded, sizeof(encoded));
+            uint16_t space = static_cast<uint16_t>(otPlatRandomGet() % length);
+
+            SuccessOrQuit(encoder.Init(full), "Encoder::Init() failed\n");
+
+            {
+                TestBuffer small(encoded + 1, space);
+
+                if (encoder.Encode(frame, length, small) == OT_ERROR_NONE)
+                {
+                    VerifyOrQuit(space >= length, "Encoder::Encode() wrote past the end of the buffer\n");
+                }
+                else
+                {
+                    VerifyOrQuit(small.GetLength() == 0 && small.GetRemainingLength() == space,
+                                 "Encoder::Encode() changed the iterator on failure\n");
+
+                    SuccessOrQuit(encoder.Encode(frame, length, full), "Encoder::Encode() failed\n");
+                    SuccessOrQuit(encoder.Finalize(full), "Encoder::Finalize() failed\n");
+
+                    VerifyOrQuit(full.GetLength() == expectedLength && memcmp(encoded, expected, expectedLength) == 0,
+                                 "Encoder::Encode() changed the FCS on failure\n");
+                }
+            }
+        }
+    }
+
+    printf("TestHdlcEncoder passed\n");
+}
+
+void TestHdlcDecoder(void)
+{
+    static const uint16_t kOutLengths[] = { kMaxFrameLength + 2, 200 };
+    static DecoderEvents expectedEvents;
+    static DecoderEvents events;
+    uint8_t frame[kMaxFrameLength];
+    uint8_t outBuf[kMaxFrameLength + 2];
+    uint32_t streamLength = 0;
+
+    InitReferenceFcs();
+
+    // A stream of back-to-back frames with some noise and corrupted bytes.
+    for (uint32_t n = 0; n < kNumFrames; n++)
+    {
+        uint16_t length = GenerateFrame(frame, kMaxFrameLength, (n % 3) * 5);
+        uint16_t encodedLength = ReferenceEncode(frame, length, sStream + streamLength);
+
+        if (n % 7 == 3)
+        {
+            sStream[streamLength + 1 + otPlatRandomGet() % (encodedLength - 1)] ^= static_cast<uint8_t>(1 << (n % 8));
+        }
+
+        if (n % 11 == 5)
+        {
+            // Drop the closing flag, the next frame's opening flag also closes this one.
+            encodedLength--;
+        }
+
+        streamLength += encodedLength;
+    }
+
+    for (size_t i = 0; i < sizeof(kOutLengths) / sizeof(kOutLengths[0]); i++)
+    {
+        Hdlc::Decoder decoder(outBuf, kOutLengths[i], HandleFrame, HandleError, &events);
+        uint32_t offset = 0;
+
+        memset(&expectedEvents, 0, sizeof(expectedEvents));
+        memset(&events, 0, sizeof(events));
+
+        ReferenceDecode(sStream, streamLength, kOutLengths[i], HandleFrame, HandleError, &expectedEvents);
+
+        // Feed the stream in random chunks, splitting escape sequences and frames at arbitrary points.
+        while (offset < streamLength)
+        {
+            uint32_t length = 1 + otPlatRandomGet() % 300;
+
+            if (length > streamLength - offset)
+            {
+                length = streamLength - offset;
+            }
+
+            decoder.Decode(sStream + offset, static_cast<uint16_t>(length));
+            offset += length;
+        }
+
+        VerifyOrQuit(events.mNumEvents > kNumFrames / 2, "Decoder reported too few frames\n");
+        VerifyOrQuit(events == expectedEvents, "Decoder differs from the reference decoding\n");
+    }
+
+    printf("TestHdlcDecoder passed\n");
+}
+
+void TestHdlcBenchmark(void)
+{
+    enum
+    {
+        kFrameLength    = 1280,
+        kNumIterations  = 2000,
+    };
+
+    static const uint32_t kEscapePercents[] = { 0, 2, 20 };
+    uint8_t frame[kFrameLength];
+    uint8_t encoded[kMaxEncodedLength];
+    uint8_t outBuf[kMaxFrameLength + 2];
+    uint32_t numFrames = 0;
+    Hdlc::Encoder encoder;
+    Hdlc::Decoder decoder(outBuf, sizeof(outBuf), CountFrame, CountError, &numFrames);
+
+    InitReferenceFcs();
+
+    for (size_t n = 0; n < sizeof(kEscapePercents) / sizeof(kEscapePercents[0]); n++)
+    {
+        uint16_t length = 0;
+        uint16_t encodedLength = 0;
+        uint64_t start;
+        uint64_t elapsed[4];
+
+        while (length != kFrameLength)
+        {
+            length = GenerateFrame(frame, kFrameLength, kEscapePercents[n]);
+        }
+
+        start = testPlatGetMicroseconds();
+
+        for (int i = 0; i < kNumIterations; i++)
+        {
+            encodedLength = ReferenceEncode(frame, length, encoded);
+        }
+
+        elapsed[0] = testPlatGetMicroseconds() - start;
+        start = testPlatGetMicroseconds();
+
+        for (int i = 0; i < kNumIterations; i++)
+        {
+            TestBuffer buffer(encoded, sizeof(encoded));
+
+            encoder.Init(buffer);
+            encoder.Encode(frame, length, buffer);
+            encoder.Finalize(buffer);
+            VerifyOrQuit(buffer.GetLength() == encodedLength, "Encoder::Encode() failed\n");
+        }
+
+        elapsed[1] = testPlatGetMicroseconds() - start;
+        start = testPlatGetMicroseconds();
+
+        numFrames = 0;
+
+        for (int i = 0; i < kNumIterations; i++)
+        {
+            ReferenceDecode(encoded, encodedLength, sizeof(outBuf), CountFrame, CountError, &numFrames);
+        }
+
+        VerifyOrQuit(numFrames == kNumIterations, "Reference decoding failed\n");
+
+        elapsed[2] = testPlatGetMicroseconds() - start;
+        start = testPlatGetMicroseconds();
+
+        numFrames = 0;
+
+        for (int i = 0; i < kNumIterations; i++)
+        {
+            decoder.Decode(encoded, encodedLength);
+        }
+
+        VerifyOrQuit(numFrames == kNumIterations, "Decoder::Decode() failed\n");
+
+        elapsed[3] = testPlatGetMicroseconds() - start;
+
+        printf("HdlcBenchmark: %2u%% escaped, encode per-byte %7.1f MB/s, bulk %7.1f MB/s\n", kEscapePercents[n],
+               static_cast<double>(length) * kNumIterations / elapsed[0],
+               static_cast<double>(length) * kNumIterations / elapsed[1]);
+        printf("HdlcBenchmark: %2u%% escaped, decode per-byte %7.1f MB/s, bulk %7.1f MB/s\n", kEscapePercents[n],
+               static_cast<double>(length) * kNumIterations / elapsed[2],
+               static_cast<double>(length) * kNumIterations / elapsed[3]);
+    }
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestHdlcEncoder();
+    ot::TestHdlcDecoder();
+    ot::TestHdlcBenchmark();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,296 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_platform.h"
+
+#include "utils/wrap_string.h"
+
+#include <openthread/openthread.h>
+
+#include "openthread-instance.h"
+#include "net/ip6.hpp"
+#include "net/netif.hpp"
+
+#include "test_util.h"
+
+namespace ot {
+
+enum
+{
+    kNumAddresses    = 7,
+    kNumDestinations = 8,
+};
+
+static const char *sAddresses[kNumAddresses] =
+{
+    "fd00:1::1:2:3:4",       // SLAAC
+    "2001:db8:1::5:6:7:8",   // SLAAC
+    "2001:db8:3::9:a:b:c",   // SLAAC, deprecated
+    "fd00:2::1234",          // DHCPv6
+    "2001:db8:2::5678",      // DHCPv6
+    "fdde:ad00:beef:0:0:ff:fe00:400",  // RLOC
+    "fdde:ad00:beef:0:0:ff:fe00:fc00", // Leader ALOC
+};
+
+static const char *sDestinations[kNumDestinations] =
+{
+    "2001:db8:1::99",
+    "2001:db8:3::1",
+    "fd00:2::77",
+    "fd00:3::1",
+    "fdde:ad00:beef:0:0:ff:fe00:800",
+    "fe80::1234",
+    "ff03::1",
+    "2001:db8:1::5:6:7:8",
+};
+
+static void AddAddresses(otInstance *aInstance, Ip6::NetifUnicastAddress *aAddresses)
+{
+    Ip6::Netif &netif = aInstance->mThreadNetif;
+    const uint8_t prefix[8] = {0xfd, 0xde, 0xad, 0x00, 0xbe, 0xef, 0x00, 0x00};
+
+    SuccessOrQuit(otThreadSetMeshLocalPrefix(aInstance, prefix), "otThreadSetMeshLocalPrefix failed\n");
+    SuccessOrQuit(otIp6SetEnabled(aInstance, true), "otIp6SetEnabled failed\n");
+
+    for (int i = 0; i < kNumAddresses; i++)
+    {
+        Ip6::NetifUnicastAddress &address = aAddresses[i];
+
+        memset(&address, 0, sizeof(address));
+        SuccessOrQuit(otIp6AddressFromString(sAddresses[i], &address.mAddress), "otIp6AddressFromString failed\n");
+        address.mPrefixLength = 64;
+        address.mPreferred = (i != 2);
+        address.mValid = true;
+
+        if (address.GetAddress().IsRoutingLocator() || address.GetAddress().IsAnycastRoutingLocator())
+        {
+            address.mScopeOverride = Ip6::Address::kRealmLocalScope;
+            address.mScopeOverrideValid = true;
+            address.mRloc = address.GetAddress().IsRoutingLocator();
+        }
+
+        SuccessOrQuit(netif.AddUnicastAddress(address), "AddUnicastAddress failed\n");
+    }
+}
+
+static void RemoveAddresses(otInstance *aInstance, Ip6::NetifUnicastAddress *aAddresses)
+{
+    for (int i = 0; i < kNumAddresses; i++)
+    {
+        SuccessOrQuit(aInstance->mThreadNetif.RemoveUnicastAddress(aAddresses[i]), "RemoveUnicastAddress failed\n");
+    }
+}
+
+static void InitMessageInfo(Ip6::MessageInfo &aMessageInfo, int aDestination)
+{
+    memset(&aMessageInfo, 0, sizeof(aMessageInfo));
+    SuccessOrQuit(otIp6AddressFromString(sDestinations[aDestination], &aMessageInfo.GetPeerAddr()),
+                  "otIp6AddressFromString failed\n");
+
+    if (aMessageInfo.GetPeerAddr().IsLinkLocal() || aMessageInfo.GetPeerAddr().IsMulticast())
+    {
+        aMessageInfo.SetInterfaceId(OT_NETIF_INTERFACE_ID_THREAD);
+    }
+}
+
+static const Ip6::NetifUnicastAddress *SelectUncached(Ip6::Ip6 &aIp6, int aDestination, int8_t &aInterfaceId)
+{
+    Ip6::MessageInfo messageInfo;
+    const Ip6::NetifUnicastAddress *rval;
+
+    InitMessageInfo(messageInfo, aDestination);
+    aIp6.InvalidateSourceAddressCache();
+    rval = aIp6.SelectSourceAddress(messageInfo);
+    aInterfaceId = messageInfo.GetInterfaceId();
+
+    return rval;
+}
+
+static void VerifySelection(Ip6::Ip6 &aIp6, int aDestination)
+{
+    Ip6::MessageInfo messageInfo;
+    const Ip6::NetifUnicastAddress *cached;
+    const Ip6::NetifUnicastAddress *expected;
+    int8_t interfaceId;
+
+    InitMessageInfo(messageInfo, aDestination);
+    cached = aIp6.SelectSourceAddress(messageInfo);
+    expected = SelectUncached(aIp6, aDestination, interfaceId);
+
+    VerifyOrQuit(cached == expected, "SelectSourceAddress returned a stale source address\n");
+    VerifyOrQuit(messageInfo.GetInterfaceId() == interfaceId, "SelectSourceAddress returned a wrong interface\n");
+}
+
+void TestIp6SourceAddressCache(void)
+{
+    otInstance *instance;
+    Ip6::Ip6 *ip6;
+    Ip6::NetifUnicastAddress addresses[kNumAddresses];
+    const Ip6::NetifUnicastAddress *expected[kNumDestinations];
+    int8_t interfaceIds[kNumDestinations];
+    Ip6::MessageInfo messageInfo;
+    otNetifAddress external;
+    const uint8_t prefix[8] = {0x20, 0x01, 0x0d, 0xb8, 0x00, 0x01, 0x00, 0x00};
+
+    testPlatResetToDefaults();
+    instance = new otInstance;
+    ip6 = &instance->mThreadNetif.GetIp6();
+    AddAddresses(instance, addresses);
+
+    for (int i = 0; i < kNumDestinations; i++)
+    {
+        expected[i] = SelectUncached(*ip6, i, interfaceIds[i]);
+        VerifyOrQuit(expected[i] != NULL, "SelectSourceAddress failed\n");
+    }
+
+    VerifyOrQuit(expected[0] == &addresses[1], "wrong source address for a global destination\n");
+    VerifyOrQuit(expected[7] == &addresses[1], "wrong source address for an assigned destination\n");
+    VerifyOrQuit(expected[5]->GetAddress().IsLinkLocal(), "wrong source address for a link-local destination\n");
+
+    // Repeated lookups in an order that cycles through more destinations than cache entries.
+    for (int round = 0; round < 4; round++)
+    {
+        for (int i = 0; i < kNumDestinations; i++)
+        {
+            int destination = (i * (round + 1)) % kNumDestinations;
+
+            InitMessageInfo(messageInfo, destination);
+            VerifyOrQuit(ip6->SelectSourceAddress(messageInfo) == expected[destination],
+                         "SelectSourceAddress returned a different source address\n");
+            VerifyOrQuit(messageInfo.GetInterfaceId() == interfaceIds[destination],
+                         "SelectSourceAddress returned a different interface\n");
+        }
+    }
+
+    // Adding and removing addresses invalidates the cache.
+    memset(&external, 0, sizeof(external));
+    SuccessOrQuit(otIp6AddressFromString(sDestinations[0], &external.mAddress), "otIp6AddressFromString failed\n");
+    external.mPrefixLength = 64;
+    external.mPreferred = true;
+    external.mValid = true;
+
+    VerifySelection(*ip6, 0);
+    SuccessOrQuit(otIp6AddUnicastAddress(instance, &external), "otIp6AddUnicastAddress failed\n");
+    VerifySelection(*ip6, 0);
+    InitMessageInfo(messageInfo, 0);
+    VerifyOrQuit(ip6->SelectSourceAddress(messageInfo)->GetAddress() == messageInfo.GetPeerAddr(),
+                 "added address not selected\n");
+
+    SuccessOrQuit(otIp6RemoveUnicastAddress(instance, &external.mAddress), "otIp6RemoveUnicastAddress failed\n");
+    VerifySelection(*ip6, 0);
+
+    // So does changing the mesh local prefix.
+    VerifySelection(*ip6, 4);
+    SuccessOrQuit(otThreadSetMeshLocalPrefix(instance, prefix), "otThreadSetMeshLocalPrefix failed\n");
+    VerifySelection(*ip6, 4);
+    VerifySelection(*ip6, 0);
+
+    RemoveAddresses(instance, addresses);
+    delete instance;
+    testPlatResetToDefaults();
+}
+
+void TestIp6SourceAddressBenchmark(void)
+{
+    enum
+    {
+        kNumPeers = 4,
+        kNumSends = 100000,
+    };
+
+    static const int kPeers[kNumPeers] = {0, 2, 4, 5};
+
+    otInstance *instance;
+    Ip6::Ip6 *ip6;
+    Ip6::NetifUnicastAddress addresses[kNumAddresses];
+    Ip6::MessageInfo messageInfos[kNumPeers];
+    uint32_t numAddresses = 0;
+    uint64_t start;
+    uint64_t cached;
+    uint64_t uncached;
+
+    testPlatResetToDefaults();
+    instance = new otInstance;
+    ip6 = &instance->mThreadNetif.GetIp6();
+    AddAddresses(instance, addresses);
+
+    for (const Ip6::NetifUnicastAddress *addr = instance->mThreadNetif.GetUnicastAddresses(); addr;
+         addr = addr->GetNext())
+    {
+        numAddresses++;
+    }
+
+    for (int i = 0; i < kNumPeers; i++)
+    {
+        InitMessageInfo(messageInfos[i], kPeers[i]);
+    }
+
+    // Sustained sends to a handful of peers, as every send with an unspecified source selects one.
+    start = testPlatGetMicroseconds();
+
+    for (int i = 0; i < kNumSends; i++)
+    {
+        Ip6::MessageInfo messageInfo = messageInfos[i % kNumPeers];
+
+        VerifyOrQuit(ip6->SelectSourceAddress(messageInfo) != NULL, "SelectSourceAddress failed\n");
+    }
+
+    cached = testPlatGetMicroseconds() - start;
+    start = testPlatGetMicroseconds();
+
+    for (int i = 0; i < kNumSends; i++)
+    {
+        Ip6::MessageInfo messageInfo = messageInfos[i % kNumPeers];
+
+        ip6->InvalidateSourceAddressCache();
+        VerifyOrQuit(ip6->SelectSourceAddress(messageInfo) != NULL, "SelectSourceAddress failed\n");
+    }
+
+    uncached = testPlatGetMicroseconds() - start;
+
+    printf("SourceAddressBenchmark: %lu addresses, %d peers, %d sends\n", static_cast<unsigned long>(numAddresses),
+           kNumPeers, kNumSends);
+    printf("SourceAddressBenchmark: cached %8.1f ns/send, full evaluation %8.1f ns/send\n",
+           1000.0 * cached / kNumSends, 1000.0 * uncached / kNumSends);
+
+    RemoveAddresses(instance, addresses);
+    delete instance;
+    testPlatResetToDefaults();
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestIp6SourceAddressCache();
+    ot::TestIp6SourceAddressBenchmark();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
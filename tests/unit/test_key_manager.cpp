@@ -0,0 +1,282 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_platform.h"
+
+#include "utils/wrap_string.h"
+
+#include <openthread/openthread.h>
+
+#include "openthread-instance.h"
+#include "crypto/aes_ccm.hpp"
+#include "crypto/hmac_sha256.hpp"
+#include "mac/mac.hpp"
+#include "thread/key_manager.hpp"
+#include "thread/thread_netif.hpp"
+
+#include "test_util.h"
+
+namespace ot {
+
+static const otMasterKey kMasterKey1 =
+{
+    {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+    }
+};
+
+static const otMasterKey kMasterKey2 =
+{
+    {
+        0xff, 0xee, 0xdd, 0xcc, 0xbb, 0xaa, 0x99, 0x88,
+        0x77, 0x66, 0x55, 0x44, 0x33, 0x22, 0x11, 0x00,
+    }
+};
+
+// Thread key derivation: HMAC-SHA256(master key, key sequence || "Thread"), MLE key first, MAC key second.
+static void ComputeExpectedKey(const otMasterKey &aMasterKey, uint32_t aKeySequence,
+                               uint8_t aKey[Crypto::HmacSha256::kHashSize])
+{
+    static const uint8_t kThread[] = {'T', 'h', 'r', 'e', 'a', 'd'};
+    Crypto::HmacSha256 hmac;
+    uint8_t keySequence[4];
+
+    keySequence[0] = static_cast<uint8_t>(aKeySequence >> 24);
+    keySequence[1] = static_cast<uint8_t>(aKeySequence >> 16);
+    keySequence[2] = static_cast<uint8_t>(aKeySequence >> 8);
+    keySequence[3] = static_cast<uint8_t>(aKeySequence);
+
+    hmac.Start(aMasterKey.m8, sizeof(aMasterKey.m8));
+    hmac.Update(keySequence, sizeof(keySequence));
+    hmac.Update(kThread, sizeof(kThread));
+    hmac.Finish(aKey);
+}
+
+static void VerifyKeys(KeyManager &aKeyManager, const otMasterKey &aMasterKey, uint32_t aKeySequence)
+{
+    uint8_t expected[Crypto::HmacSha256::kHashSize];
+
+    ComputeExpectedKey(aMasterKey, aKeySequence, expected);
+
+    VerifyOrQuit(memcmp(aKeyManager.GetTemporaryMleKey(aKeySequence), expected, 16) == 0,
+                 "KeyManager::GetTemporaryMleKey() returned a wrong key\n");
+    VerifyOrQuit(memcmp(aKeyManager.GetTemporaryMacKey(aKeySequence), expected + 16, 16) == 0,
+                 "KeyManager::GetTemporaryMacKey() returned a wrong key\n");
+}
+
+static void VerifyCurrentKeys(KeyManager &aKeyManager, const otMasterKey &aMasterKey)
+{
+    uint8_t expected[Crypto::HmacSha256::kHashSize];
+
+    ComputeExpectedKey(aMasterKey, aKeyManager.GetCurrentKeySequence(), expected);
+
+    VerifyOrQuit(memcmp(aKeyManager.GetCurrentMleKey(), expected, 16) == 0,
+                 "KeyManager::GetCurrentMleKey() returned a wrong key\n");
+    VerifyOrQuit(memcmp(aKeyManager.GetCurrentMacKey(), expected + 16, 16) == 0,
+                 "KeyManager::GetCurrentMacKey() returned a wrong key\n");
+}
+
+void TestKeyManagerKeyCache(void)
+{
+    otInstance *instance = new otInstance;
+    KeyManager &keyManager = instance->mThreadNetif.GetKeyManager();
+    uint8_t expected[Crypto::HmacSha256::kHashSize];
+    const uint8_t *nextKey;
+
+    SuccessOrQuit(keyManager.SetMasterKey(kMasterKey1), "KeyManager::SetMasterKey failed\n");
+    VerifyCurrentKeys(keyManager, kMasterKey1);
+
+    keyManager.SetCurrentKeySequence(100);
+    VerifyCurrentKeys(keyManager, kMasterKey1);
+    VerifyKeys(keyManager, kMasterKey1, 99);
+    VerifyKeys(keyManager, kMasterKey1, 100);
+    VerifyKeys(keyManager, kMasterKey1, 101);
+
+    // Keys outside current-1..current+1 must not disturb the cached ones.
+    nextKey = keyManager.GetTemporaryMacKey(101);
+    VerifyKeys(keyManager, kMasterKey1, 5);
+    VerifyKeys(keyManager, kMasterKey1, 104);
+    ComputeExpectedKey(kMasterKey1, 101, expected);
+    VerifyOrQuit(memcmp(nextKey, expected + 16, 16) == 0, "Cached key was overwritten\n");
+    VerifyCurrentKeys(keyManager, kMasterKey1);
+
+    // Rotation keeps the previous key.
+    keyManager.SetCurrentKeySequence(101);
+    VerifyCurrentKeys(keyManager, kMasterKey1);
+    VerifyKeys(keyManager, kMasterKey1, 100);
+    VerifyKeys(keyManager, kMasterKey1, 102);
+
+    // Key sequence wrap-around.
+    keyManager.SetCurrentKeySequence(0);
+    VerifyCurrentKeys(keyManager, kMasterKey1);
+    VerifyKeys(keyManager, kMasterKey1, 0xffffffff);
+    VerifyKeys(keyManager, kMasterKey1, 1);
+    VerifyCurrentKeys(keyManager, kMasterKey1);
+
+    // A master key change invalidates the cache.
+    keyManager.SetCurrentKeySequence(1);
+    SuccessOrQuit(keyManager.SetMasterKey(kMasterKey2), "KeyManager::SetMasterKey failed\n");
+    VerifyOrQuit(keyManager.GetCurrentKeySequence() == 0, "Key sequence was not reset\n");
+    VerifyCurrentKeys(keyManager, kMasterKey2);
+    VerifyKeys(keyManager, kMasterKey2, 1);
+    VerifyKeys(keyManager, kMasterKey2, 0xffffffff);
+
+    delete instance;
+}
+
+// Feeds the MAC receive path with secured frames from a neighbor whose frames alternate between the previous,
+// current and next key sequence, as happens while a network rotates its key.
+void TestKeyManagerRotationBenchmark(void)
+{
+    enum
+    {
+        kKeySequence = 1000,
+        kNumFrames   = 3,
+        kPayloadSize = 64,
+        kIterations  = 2000,
+    };
+
+    otInstance *instance = new otInstance;
+    ThreadNetif &netif = instance->mThreadNetif;
+    Mac::Mac &mac = netif.GetMac();
+    Router *parent;
+    Mac::ExtAddress parentAddress;
+    Mac::Frame frame;
+    uint8_t psdu[kNumFrames][OT_RADIO_FRAME_MAX_SIZE];
+    uint8_t length[kNumFrames];
+    uint8_t rxPsdu[OT_RADIO_FRAME_MAX_SIZE];
+    uint64_t start;
+    uint64_t elapsed[2];
+
+    SuccessOrQuit(otThreadSetMasterKey(instance, &kMasterKey1), "otThreadSetMasterKey failed\n");
+    SuccessOrQuit(otLinkSetPanId(instance, 0x1234), "otLinkSetPanId failed\n");
+    SuccessOrQuit(otIp6SetEnabled(instance, true), "otIp6SetEnabled failed\n");
+    SuccessOrQuit(otThreadSetEnabled(instance, true), "otThreadSetEnabled failed\n");
+    netif.GetKeyManager().SetCurrentKeySequence(kKeySequence);
+
+    // A neighbor being restored has its frames authenticated without key sequence and frame counter checks, so
+    // the same frames can be replayed.
+    for (uint8_t i = 0; i < sizeof(parentAddress.m8); i++)
+    {
+        parentAddress.m8[i] = 0x10 + i;
+    }
+
+    parent = netif.GetMle().GetParent();
+    parent->SetExtAddress(parentAddress);
+    parent->SetState(Neighbor::kStateRestored);
+
+    for (int i = 0; i < kNumFrames; i++)
+    {
+        uint32_t keySequence = kKeySequence - 1 + static_cast<uint32_t>(i);
+        uint8_t key[Crypto::HmacSha256::kHashSize];
+        uint8_t nonce[13];
+        uint8_t tagLength;
+        Crypto::AesCcm aesCcm;
+
+        memset(&frame, 0, sizeof(frame));
+        frame.mPsdu = psdu[i];
+        frame.InitMacHeader(Mac::Frame::kFcfFrameData | Mac::Frame::kFcfPanidCompression |
+                            Mac::Frame::kFcfDstAddrExt | Mac::Frame::kFcfSrcAddrExt | Mac::Frame::kFcfSecurityEnabled |
+                            Mac::Frame::kFcfFrameVersion2006,
+                            Mac::Frame::kKeyIdMode1 | Mac::Frame::kSecEncMic32);
+        frame.SetDstPanId(mac.GetPanId());
+        frame.SetDstAddr(*mac.GetExtAddress());
+        frame.SetSrcAddr(parentAddress);
+        frame.SetFrameCounter(static_cast<uint32_t>(i));
+        frame.SetKeyId((keySequence & 0x7f) + 1);
+        frame.SetPayloadLength(kPayloadSize);
+        memset(frame.GetPayload(), i, kPayloadSize);
+
+        memcpy(nonce, parentAddress.m8, sizeof(parentAddress.m8));
+        nonce[8] = 0;
+        nonce[9] = 0;
+        nonce[10] = 0;
+        nonce[11] = static_cast<uint8_t>(i);
+        nonce[12] = Mac::Frame::kSecEncMic32;
+
+        ComputeExpectedKey(kMasterKey1, keySequence, key);
+        tagLength = frame.GetFooterLength() - Mac::Frame::kFcsSize;
+        aesCcm.SetKey(key + 16, 16);
+        aesCcm.Init(frame.GetHeaderLength(), frame.GetPayloadLength(), tagLength, nonce, sizeof(nonce));
+        aesCcm.Header(frame.GetHeader(), frame.GetHeaderLength());
+        aesCcm.Payload(frame.GetPayload(), frame.GetPayload(), frame.GetPayloadLength(), true);
+        aesCcm.Finalize(frame.GetFooter(), &tagLength);
+
+        length[i] = frame.GetPsduLength();
+    }
+
+    for (int mixed = 0; mixed < 2; mixed++)
+    {
+        start = testPlatGetMicroseconds();
+
+        for (int n = 0; n < kIterations; n++)
+        {
+            // Either only current-key frames, or previous/current/next in turn.
+            int i = mixed ? (n % kNumFrames) : 1;
+
+            memset(&frame, 0, sizeof(frame));
+            memcpy(rxPsdu, psdu[i], length[i]);
+            frame.mPsdu = rxPsdu;
+            frame.SetPsduLength(length[i]);
+            frame.mChannel = mac.GetChannel();
+
+            otPlatRadioReceiveDone(instance, &frame, OT_ERROR_NONE);
+
+            VerifyOrQuit(frame.GetSecurityValid(), "Frame failed MAC security processing\n");
+            VerifyOrQuit(rxPsdu[frame.GetHeaderLength()] == i, "Frame payload was not decrypted\n");
+        }
+
+        elapsed[mixed] = testPlatGetMicroseconds() - start;
+    }
+
+    VerifyOrQuit(netif.GetKeyManager().GetCurrentKeySequence() == kKeySequence, "Key sequence changed\n");
+
+    printf("KeyManagerRotationBenchmark: %d frames of %d bytes per run\n", kIterations, kPayloadSize);
+    printf("KeyManagerRotationBenchmark: current key only     %8.2f us/frame\n",
+           static_cast<double>(elapsed[0]) / kIterations);
+    printf("KeyManagerRotationBenchmark: mixed key sequences  %8.2f us/frame\n",
+           static_cast<double>(elapsed[1]) / kIterations);
+
+    SuccessOrQuit(otThreadSetEnabled(instance, false), "otThreadSetEnabled failed\n");
+    SuccessOrQuit(otIp6SetEnabled(instance, false), "otIp6SetEnabled failed\n");
+
+    delete instance;
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestKeyManagerKeyCache();
+    ot::TestKeyManagerRotationBenchmark();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
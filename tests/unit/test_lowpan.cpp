@@ -27,6 +27,7 @@
  */
 
 #include "test_lowpan.hpp"
+#include "test_platform.h"
 #include "test_util.hpp"
 
 using namespace ot;
@@ -1853,6 +1854,358 @@ static void TestErrorReservedNhc6(void)
     Test(testVector, false, true);
 }
 
+/***************************************************************************************************
+ * @section Context table tests.
+ **************************************************************************************************/
+
+enum
+{
+    kNoContext = 0xff,
+};
+
+struct TestContextPrefix
+{
+    const char *mPrefix;
+    uint8_t     mPrefixLength;
+    uint8_t     mContextId;
+    bool        mCompress;
+};
+
+static const TestContextPrefix sTestContextPrefixes[] =
+{
+    {"2001:db8::",                 32, 1,          true},
+    {"2001:db8:1::",               48, 2,          true},
+    {"2001:db8:1:2::",             64, 3,          true},
+    {"2001:db8:1:2:8000::",        65, 4,          false},
+    {"2001:db8:2::",               48, 5,          true},
+    {"2001:db8:2:3::",             64, 6,          true},
+    {"fd00:cafe:face::",           48, 7,          true},  // Covers the mesh local prefix.
+    {"fd00:cafe:face:1234:ab00::", 72, 8,          true},  // Longer than the mesh local prefix.
+    {"2001:db8:1:2::",             64, 9,          true},  // Same prefix as context 3.
+    {"2001:db8:4::",               48, kNoContext, true},
+    {"2001:db8:5::",               56, 10,         false},
+    {"2001:db8:6:7::",             64, 11,         true},
+    {"fd11:22::",                  32, 12,         true},
+};
+
+static const char *sTestContextAddresses[] =
+{
+    "2001:db8:1:2::1",
+    "2001:db8:1:2:8000::1",
+    "2001:db8:1:2:7fff::1",
+    "2001:db8:1:3::1",
+    "2001:db8:2:3::1",
+    "2001:db8:2:4::1",
+    "2001:db8:4::1",
+    "2001:db8:5::1",
+    "2001:db8:5:100::1",
+    "2001:db8:6:7::1",
+    "2001:db9::1",
+    "fd00:cafe:face:1234::1",
+    "fd00:cafe:face:1234:ab00::1",
+    "fd00:cafe:face:1234:ac00::1",
+    "fd00:cafe:face:5::1",
+    "fd11:22:33::1",
+    "fe80::1",
+    "ff03::1",
+};
+
+static uint8_t BuildContextNetworkData(const TestContextPrefix *aPrefixes, uint8_t aNumPrefixes, uint8_t *aData)
+{
+    uint8_t length = 0;
+
+    for (uint8_t i = 0; i < aNumPrefixes; i++)
+    {
+        Ip6::Address prefix;
+        uint8_t prefixBytes = BitVectorBytes(aPrefixes[i].mPrefixLength);
+        bool hasContext = (aPrefixes[i].mContextId != kNoContext);
+
+        SuccessOrQuit(prefix.FromString(aPrefixes[i].mPrefix), "6lo: Address::FromString failed");
+
+        aData[length++] = 0x03;  // Prefix TLV
+        aData[length++] = static_cast<uint8_t>(2 + prefixBytes + (hasContext ? 4 : 0));
+        aData[length++] = 0x00;
+        aData[length++] = aPrefixes[i].mPrefixLength;
+        memcpy(aData + length, prefix.mFields.m8, prefixBytes);
+        length += prefixBytes;
+
+        if (hasContext)
+        {
+            aData[length++] = 0x07;  // 6LoWPAN Context ID TLV
+            aData[length++] = 0x02;
+            aData[length++] = static_cast<uint8_t>((aPrefixes[i].mCompress ? 0x10 : 0x00) | aPrefixes[i].mContextId);
+            aData[length++] = aPrefixes[i].mPrefixLength;
+        }
+    }
+
+    return length;
+}
+
+static bool MatchesPrefix(const uint8_t *aPrefix, const Ip6::Address &aAddress, uint8_t aPrefixLength)
+{
+    uint8_t bytes = aPrefixLength / 8;
+    uint8_t mask = static_cast<uint8_t>(0xff << (8 - (aPrefixLength % 8)));
+
+    return memcmp(aPrefix, aAddress.mFields.m8, bytes) == 0 &&
+           ((aPrefixLength % 8) == 0 || ((aPrefix[bytes] ^ aAddress.mFields.m8[bytes]) & mask) == 0);
+}
+
+/**
+ * This function verifies the context of @p aAddress against a walk over all prefixes.
+ *
+ */
+static void VerifyAddressContext(const TestContextPrefix *aPrefixes, uint8_t aNumPrefixes, const char *aAddress)
+{
+    NetworkData::Leader &leader = sMockThreadNetif.GetNetworkDataLeader();
+    Ip6::Address address;
+    Ip6::Address prefix;
+    Lowpan::Context context;
+    const uint8_t *expectedPrefix = NULL;
+    uint8_t expectedLength = 0;
+    uint8_t expectedId = 0;
+    bool expectedCompress = false;
+    otError error;
+
+    SuccessOrQuit(address.FromString(aAddress), "6lo: Address::FromString failed");
+
+    if (MatchesPrefix(sMockThreadNetif.GetMle().GetMeshLocalPrefix(), address, 64))
+    {
+        expectedPrefix = sMockThreadNetif.GetMle().GetMeshLocalPrefix();
+        expectedLength = 64;
+        expectedId = 0;
+        expectedCompress = true;
+    }
+
+    for (uint8_t i = 0; i < aNumPrefixes; i++)
+    {
+        SuccessOrQuit(prefix.FromString(aPrefixes[i].mPrefix), "6lo: Address::FromString failed");
+
+        if (aPrefixes[i].mContextId != kNoContext && aPrefixes[i].mPrefixLength > expectedLength &&
+            MatchesPrefix(prefix.mFields.m8, address, aPrefixes[i].mPrefixLength))
+        {
+            expectedPrefix = NULL;
+            expectedLength = aPrefixes[i].mPrefixLength;
+            expectedId = aPrefixes[i].mContextId;
+            expectedCompress = aPrefixes[i].mCompress;
+        }
+    }
+
+    error = leader.GetContext(address, context);
+
+    if (expectedLength == 0)
+    {
+        VerifyOrQuit(error == OT_ERROR_NOT_FOUND, "6lo: GetContext found a context for an address without one");
+    }
+    else
+    {
+        VerifyOrQuit(error == OT_ERROR_NONE, "6lo: GetContext failed");
+        VerifyOrQuit(context.mContextId == expectedId && context.mPrefixLength == expectedLength &&
+                     context.mCompressFlag == expectedCompress, "6lo: GetContext returned a wrong context");
+        VerifyOrQuit(MatchesPrefix(context.mPrefix, address, context.mPrefixLength),
+                     "6lo: GetContext returned a wrong prefix");
+        VerifyOrQuit(expectedPrefix == NULL || memcmp(context.mPrefix, expectedPrefix, 8) == 0,
+                     "6lo: GetContext returned a wrong mesh local prefix");
+    }
+}
+
+static void VerifyContextIds(const TestContextPrefix *aPrefixes, uint8_t aNumPrefixes)
+{
+    NetworkData::Leader &leader = sMockThreadNetif.GetNetworkDataLeader();
+    Lowpan::Context context;
+
+    SuccessOrQuit(leader.GetContext(0, context), "6lo: GetContext failed for context 0");
+    VerifyOrQuit(context.mPrefixLength == 64 &&
+                 memcmp(context.mPrefix, sMockThreadNetif.GetMle().GetMeshLocalPrefix(), 8) == 0,
+                 "6lo: GetContext returned a wrong context 0");
+
+    for (uint8_t id = 1; id < 16; id++)
+    {
+        const TestContextPrefix *expected = NULL;
+        Ip6::Address prefix;
+
+        for (uint8_t i = 0; i < aNumPrefixes && expected == NULL; i++)
+        {
+            if (aPrefixes[i].mContextId == id)
+            {
+                expected = &aPrefixes[i];
+            }
+        }
+
+        if (expected == NULL)
+        {
+            VerifyOrQuit(leader.GetContext(id, context) == OT_ERROR_NOT_FOUND,
+                         "6lo: GetContext found an unused context ID");
+            continue;
+        }
+
+        SuccessOrQuit(leader.GetContext(id, context), "6lo: GetContext failed");
+        SuccessOrQuit(prefix.FromString(expected->mPrefix), "6lo: Address::FromString failed");
+        VerifyOrQuit(context.mContextId == id && context.mPrefixLength == expected->mPrefixLength &&
+                     context.mCompressFlag == expected->mCompress, "6lo: GetContext returned a wrong context");
+        VerifyOrQuit(MatchesPrefix(context.mPrefix, prefix, context.mPrefixLength),
+                     "6lo: GetContext returned a wrong prefix");
+    }
+}
+
+void TestLowpanContexts(void)
+{
+    const uint8_t numPrefixes = sizeof(sTestContextPrefixes) / sizeof(sTestContextPrefixes[0]);
+    uint8_t networkData[255];
+    uint8_t length;
+
+    Init();
+
+    // Each Network Data update must replace the previous contexts. The version is left unchanged (as after 256
+    // updates), the contexts must follow the Network Data itself.
+    for (uint8_t round = 0; round < 3; round++)
+    {
+        uint8_t count = numPrefixes - 5 * round;
+
+        length = BuildContextNetworkData(sTestContextPrefixes, count, networkData);
+        sMockThreadNetif.GetNetworkDataLeader().SetNetworkData(1, 1, false, networkData, length);
+
+        for (size_t i = 0; i < sizeof(sTestContextAddresses) / sizeof(sTestContextAddresses[0]); i++)
+        {
+            VerifyAddressContext(sTestContextPrefixes, count, sTestContextAddresses[i]);
+        }
+
+        VerifyContextIds(sTestContextPrefixes, count);
+    }
+
+    Init();
+}
+
+void TestLowpanContextsUpdatedByLeader(void)
+{
+    // fd00:0:0:1::/64, with Context ID 1 and a Border Router entry for RLOC16 0x0400.
+    static const uint8_t kNetworkData[] =
+    {
+        0x03, 0x14, 0x00, 0x40, 0xfd, 0x00, 0x00, 0x00, 0x00, 0x00, 0x00, 0x01,  // Prefix TLV
+        0x05, 0x04, 0x04, 0x00, 0x00, 0x00,                                      // Border Router TLV
+        0x07, 0x02, 0x11, 0x40,                                                  // 6LoWPAN Context ID TLV
+    };
+    static const uint8_t kCommissioningData[] = { 0x0b, 0x02, 0x00, 0x01 };
+
+    NetworkData::Leader &leader = sMockThreadNetif.GetNetworkDataLeader();
+    Lowpan::Context context;
+
+    Init();
+
+    leader.SetNetworkData(0, 0, false, kNetworkData, sizeof(kNetworkData));
+    SuccessOrQuit(leader.GetContext(1, context), "6lo: GetContext failed");
+    VerifyOrQuit(context.mCompressFlag, "6lo: context is not used for compression");
+
+    // Bring the version back to 0 with changes that do not affect the contexts, then remove the Border Router: its
+    // context is no longer used for compression.
+    for (int i = 0; i < 255; i++)
+    {
+        SuccessOrQuit(leader.SetCommissioningData(kCommissioningData, sizeof(kCommissioningData)),
+                      "6lo: SetCommissioningData failed");
+    }
+
+    leader.RemoveBorderRouter(0x0400);
+    VerifyOrQuit(leader.GetVersion() == 0, "6lo: unexpected Network Data version");
+
+    SuccessOrQuit(leader.GetContext(1, context), "6lo: GetContext failed");
+    VerifyOrQuit(!context.mCompressFlag, "6lo: stale context after the Network Data was modified");
+
+    Init();
+}
+
+void TestLowpanBenchmark(void)
+{
+    enum
+    {
+        kNumPrefixes = 15,
+        kNumPackets  = 20000,
+    };
+
+    TestContextPrefix prefixes[kNumPrefixes];
+    char prefixStrings[kNumPrefixes][32];
+    uint8_t networkData[255];
+    uint8_t length;
+    TestIphcVector testVector("LOWPAN_IPHC benchmark");
+    Message *message;
+    Message *result;
+    uint8_t iphc[128];
+    int compressed = 0;
+    uint64_t start;
+    uint64_t elapsed;
+
+    Init();
+
+    // On-mesh prefixes with one context each, as a Leader with many Border Routers would distribute.
+    for (uint8_t i = 0; i < kNumPrefixes; i++)
+    {
+        snprintf(prefixStrings[i], sizeof(prefixStrings[i]), "2001:db8:0:%x::", i + 1);
+        prefixes[i].mPrefix = prefixStrings[i];
+        prefixes[i].mPrefixLength = 64;
+        prefixes[i].mContextId = i + 1;
+        prefixes[i].mCompress = true;
+    }
+
+    length = BuildContextNetworkData(prefixes, kNumPrefixes, networkData);
+    sMockThreadNetif.GetNetworkDataLeader().SetNetworkData(1, 1, false, networkData, length);
+
+    testVector.SetMacSource(sTestMacSourceDefaultShort);
+    testVector.SetMacDestination(sTestMacDestinationDefaultShort);
+    testVector.SetIpHeader(0x60000000, sizeof(sTestPayloadDefault) + 8, Ip6::kProtoUdp, 64,
+                           "2001:db8:0:e::1234", "2001:db8:0:f::5678");
+    testVector.SetUDPHeader(61616, 61631, sizeof(sTestPayloadDefault) + 8, 0xface);
+    testVector.SetPayload(sTestPayloadDefault, sizeof(sTestPayloadDefault));
+
+    VerifyOrQuit((message = sIp6.mMessagePool.New(Message::kTypeIp6, 0)) != NULL, "6lo: Ip6::NewMessage failed");
+    VerifyOrQuit((result = sIp6.mMessagePool.New(Message::kTypeIp6, 0)) != NULL, "6lo: Ip6::NewMessage failed");
+    testVector.GetUncompressedStream(*message);
+
+    start = testPlatGetMicroseconds();
+
+    for (int i = 0; i < kNumPackets; i++)
+    {
+        message->SetOffset(0);
+        compressed = sMockLowpan.Compress(*message, testVector.mMacSource, testVector.mMacDestination, iphc);
+        VerifyOrQuit(compressed > 0, "6lo: Lowpan::Compress failed");
+        memcpy(iphc + compressed, sTestPayloadDefault, sizeof(sTestPayloadDefault));
+
+        SuccessOrQuit(result->SetLength(0), "6lo: Message::SetLength failed");
+        result->SetOffset(0);
+        VerifyOrQuit(sMockLowpan.Decompress(*result, testVector.mMacSource, testVector.mMacDestination, iphc,
+                                            static_cast<uint16_t>(compressed + sizeof(sTestPayloadDefault)), 0) ==
+                     compressed, "6lo: Lowpan::Decompress failed");
+    }
+
+    elapsed = testPlatGetMicroseconds() - start;
+
+    VerifyOrQuit(iphc[1] & 0x80, "6lo: Lowpan::Compress did not use the context extension");
+
+    printf("LowpanBenchmark: %d prefixes, %d packets, %d byte header\n", kNumPrefixes, kNumPackets, compressed);
+    printf("LowpanBenchmark: compress + decompress %8.1f ns/packet\n", 1000.0 * elapsed / kNumPackets);
+
+    // The context resolution alone: by address when compressing, by Context ID when decompressing.
+    start = testPlatGetMicroseconds();
+
+    for (int i = 0; i < kNumPackets; i++)
+    {
+        NetworkData::Leader &leader = sMockThreadNetif.GetNetworkDataLeader();
+        Lowpan::Context srcContext;
+        Lowpan::Context dstContext;
+
+        SuccessOrQuit(leader.GetContext(testVector.mIpHeader.GetSource(), srcContext), "6lo: GetContext failed");
+        SuccessOrQuit(leader.GetContext(testVector.mIpHeader.GetDestination(), dstContext), "6lo: GetContext failed");
+        SuccessOrQuit(leader.GetContext(srcContext.mContextId, srcContext), "6lo: GetContext failed");
+        SuccessOrQuit(leader.GetContext(dstContext.mContextId, dstContext), "6lo: GetContext failed");
+    }
+
+    elapsed = testPlatGetMicroseconds() - start;
+
+    printf("LowpanBenchmark: context resolution    %8.1f ns/packet\n", 1000.0 * elapsed / kNumPackets);
+
+    message->Free();
+    result->Free();
+
+    Init();
+}
+
 /***************************************************************************************************
  * @section Main test.
  **************************************************************************************************/
@@ -1946,6 +2299,9 @@ void TestLowpanIphc(void)
 int main(void)
 {
     TestLowpanIphc();
+    TestLowpanContexts();
+    TestLowpanContextsUpdatedByLeader();
+    TestLowpanBenchmark();
 
     printf("All tests passed\n");
     return 0;
@@ -26,9 +26,11 @@
  *  POSSIBILITY OF SUCH DAMAGE.
  */
 
+#include "test_platform.h"
 #include "utils/wrap_string.h"
 
 #include <openthread/openthread.h>
+#include <openthread/platform/random.h>
 
 #include "common/debug.hpp"
 #include "mac/mac_frame.hpp"
@@ -85,12 +87,408 @@ void TestMacHeader(void)
     }
 }
 
+/**
+ * This structure holds the header fields of a frame, as decoded by walking the PSDU from the start.
+ *
+ */
+struct ReferenceHeader
+{
+    uint16_t mFcf;
+    int      mDstPanId;
+    int      mDstAddr;
+    uint8_t  mDstAddrLength;
+    int      mSrcPanId;
+    int      mSrcAddr;
+    uint8_t  mSrcAddrLength;
+    int      mSecurity;
+    uint8_t  mHeaderLength;
+    uint8_t  mFooterLength;
+};
+
+static void DecodeReference(const uint8_t *aPsdu, ReferenceHeader &aHeader)
+{
+    static const uint8_t kAddrLength[] = { 0, 0, sizeof(Mac::ShortAddress), sizeof(Mac::ExtAddress) };
+    static const uint8_t kMicLength[] = { 0, 4, 8, 16 };
+    static const uint8_t kKeyIdLength[] = { 0, 1, 5, 9 };
+    uint8_t offset = Mac::Frame::kFcfSize + Mac::Frame::kDsnSize;
+    bool panidCompression;
+
+    aHeader.mFcf = static_cast<uint16_t>((aPsdu[1] << 8) | aPsdu[0]);
+    aHeader.mDstAddrLength = kAddrLength[(aHeader.mFcf >> 10) & 3];
+    aHeader.mSrcAddrLength = kAddrLength[(aHeader.mFcf >> 14) & 3];
+    aHeader.mDstPanId = aHeader.mDstAddr = aHeader.mSrcPanId = aHeader.mSrcAddr = aHeader.mSecurity = -1;
+    aHeader.mFooterLength = Mac::Frame::kFcsSize;
+    panidCompression = (aHeader.mFcf & Mac::Frame::kFcfPanidCompression) != 0;
+
+    if (aHeader.mDstAddrLength != 0)
+    {
+        aHeader.mDstPanId = offset;
+        aHeader.mDstAddr = offset + sizeof(Mac::PanId);
+        offset += sizeof(Mac::PanId) + aHeader.mDstAddrLength;
+    }
+
+    if (aHeader.mSrcAddrLength != 0)
+    {
+        aHeader.mSrcPanId = panidCompression ? aHeader.mDstPanId : offset;
+
+        if (!panidCompression)
+        {
+            offset += sizeof(Mac::PanId);
+        }
+
+        aHeader.mSrcAddr = offset;
+        offset += aHeader.mSrcAddrLength;
+    }
+
+    if (aHeader.mFcf & Mac::Frame::kFcfSecurityEnabled)
+    {
+        aHeader.mSecurity = offset;
+        aHeader.mFooterLength += kMicLength[aPsdu[offset] & 3];
+        offset += Mac::Frame::kSecurityControlSize + Mac::Frame::kFrameCounterSize + kKeyIdLength[(aPsdu[offset] >> 3) & 3];
+    }
+
+    if ((aHeader.mFcf & Mac::Frame::kFcfFrameTypeMask) == Mac::Frame::kFcfFrameMacCmd)
+    {
+        offset += Mac::Frame::kCommandIdSize;
+    }
+
+    aHeader.mHeaderLength = offset;
+}
+
+static uint16_t ReadUint16(const uint8_t *aBuf)
+{
+    return static_cast<uint16_t>((aBuf[1] << 8) | aBuf[0]);
+}
+
+static void VerifyFrame(Mac::Frame &aFrame)
+{
+    static const uint8_t kKeySourceLength[] = { 0, 0, 4, 8 };
+    const uint8_t *psdu = aFrame.GetPsdu();
+    ReferenceHeader ref;
+    Mac::PanId panid;
+    Mac::Address address;
+    uint8_t value;
+    uint32_t frameCounter;
+
+    DecodeReference(psdu, ref);
+
+    VerifyOrQuit(aFrame.GetHeaderLength() == ref.mHeaderLength, "MacFrame header length mismatch\n");
+    VerifyOrQuit(aFrame.GetFooterLength() == ref.mFooterLength, "MacFrame footer length mismatch\n");
+    VerifyOrQuit(aFrame.GetPayload() == psdu + ref.mHeaderLength, "MacFrame payload mismatch\n");
+    VerifyOrQuit(aFrame.GetFooter() == psdu + aFrame.GetPsduLength() - ref.mFooterLength, "MacFrame footer mismatch\n");
+    VerifyOrQuit(aFrame.GetPayloadLength() == aFrame.GetPsduLength() - ref.mHeaderLength - ref.mFooterLength,
+                 "MacFrame payload length mismatch\n");
+
+    if (ref.mDstPanId >= 0)
+    {
+        SuccessOrQuit(aFrame.GetDstPanId(panid), "MacFrame GetDstPanId failed\n");
+        VerifyOrQuit(panid == ReadUint16(psdu + ref.mDstPanId), "MacFrame dst PAN ID mismatch\n");
+    }
+    else
+    {
+        VerifyOrQuit(aFrame.GetDstPanId(panid) == OT_ERROR_PARSE, "MacFrame GetDstPanId succeeded\n");
+    }
+
+    if (ref.mSrcPanId >= 0)
+    {
+        SuccessOrQuit(aFrame.GetSrcPanId(panid), "MacFrame GetSrcPanId failed\n");
+        VerifyOrQuit(panid == ReadUint16(psdu + ref.mSrcPanId), "MacFrame src PAN ID mismatch\n");
+    }
+
+    SuccessOrQuit(aFrame.GetDstAddr(address), "MacFrame GetDstAddr failed\n");
+    VerifyOrQuit(address.mLength == ref.mDstAddrLength, "MacFrame dst address length mismatch\n");
+
+    if (ref.mDstAddrLength == sizeof(Mac::ShortAddress))
+    {
+        VerifyOrQuit(address.mShortAddress == ReadUint16(psdu + ref.mDstAddr), "MacFrame dst address mismatch\n");
+    }
+    else if (ref.mDstAddrLength == sizeof(Mac::ExtAddress))
+    {
+        VerifyOrQuit(address.mExtAddress.m8[0] == psdu[ref.mDstAddr + 7], "MacFrame dst address mismatch\n");
+        VerifyOrQuit(address.mExtAddress.m8[7] == psdu[ref.mDstAddr], "MacFrame dst address mismatch\n");
+    }
+
+    SuccessOrQuit(aFrame.GetSrcAddr(address), "MacFrame GetSrcAddr failed\n");
+    VerifyOrQuit(address.mLength == ref.mSrcAddrLength, "MacFrame src address length mismatch\n");
+
+    if (ref.mSrcAddrLength == sizeof(Mac::ShortAddress))
+    {
+        VerifyOrQuit(address.mShortAddress == ReadUint16(psdu + ref.mSrcAddr), "MacFrame src address mismatch\n");
+    }
+    else if (ref.mSrcAddrLength == sizeof(Mac::ExtAddress))
+    {
+        VerifyOrQuit(address.mExtAddress.m8[0] == psdu[ref.mSrcAddr + 7], "MacFrame src address mismatch\n");
+        VerifyOrQuit(address.mExtAddress.m8[7] == psdu[ref.mSrcAddr], "MacFrame src address mismatch\n");
+    }
+
+    if (ref.mSecurity >= 0)
+    {
+        uint8_t keyIdMode = psdu[ref.mSecurity] & Mac::Frame::kKeyIdModeMask;
+
+        SuccessOrQuit(aFrame.GetSecurityLevel(value), "MacFrame GetSecurityLevel failed\n");
+        VerifyOrQuit(value == (psdu[ref.mSecurity] & Mac::Frame::kSecLevelMask), "MacFrame security level mismatch\n");
+        SuccessOrQuit(aFrame.GetKeyIdMode(value), "MacFrame GetKeyIdMode failed\n");
+        VerifyOrQuit(value == keyIdMode, "MacFrame key id mode mismatch\n");
+        SuccessOrQuit(aFrame.GetFrameCounter(frameCounter), "MacFrame GetFrameCounter failed\n");
+        VerifyOrQuit(frameCounter == (static_cast<uint32_t>(ReadUint16(psdu + ref.mSecurity + 3)) << 16 |
+                                      ReadUint16(psdu + ref.mSecurity + 1)), "MacFrame frame counter mismatch\n");
+        VerifyOrQuit(aFrame.GetKeySource() == psdu + ref.mSecurity + 5, "MacFrame key source mismatch\n");
+
+        if (keyIdMode != Mac::Frame::kKeyIdMode0)
+        {
+            SuccessOrQuit(aFrame.GetKeyId(value), "MacFrame GetKeyId failed\n");
+            VerifyOrQuit(value == psdu[ref.mSecurity + 5 + kKeySourceLength[keyIdMode >> 3]], "MacFrame key id mismatch\n");
+        }
+    }
+    else
+    {
+        VerifyOrQuit(aFrame.GetSecurityLevel(value) == OT_ERROR_PARSE, "MacFrame GetSecurityLevel succeeded\n");
+    }
+
+    if ((ref.mFcf & Mac::Frame::kFcfFrameTypeMask) == Mac::Frame::kFcfFrameMacCmd)
+    {
+        SuccessOrQuit(aFrame.GetCommandId(value), "MacFrame GetCommandId failed\n");
+        VerifyOrQuit(value == psdu[ref.mHeaderLength - 1], "MacFrame command id mismatch\n");
+    }
+}
+
+void TestMacFrameParse(void)
+{
+    static const uint16_t kAddrModes[] = { 0, 2, 3 };
+    static const uint8_t kSecControls[] =
+    {
+        Mac::Frame::kSecEncMic32 | Mac::Frame::kKeyIdMode0,
+        Mac::Frame::kSecEncMic32 | Mac::Frame::kKeyIdMode1,
+        Mac::Frame::kSecMic64 | Mac::Frame::kKeyIdMode2,
+        Mac::Frame::kSecEncMic128 | Mac::Frame::kKeyIdMode3,
+        Mac::Frame::kSecEnc | Mac::Frame::kKeyIdMode1,
+    };
+    uint8_t psdu[Mac::Frame::kMTU];
+    Mac::Frame frame;
+    unsigned count = 0;
+
+    memset(&frame, 0, sizeof(frame));
+    frame.mPsdu = psdu;
+
+    for (unsigned dst = 0; dst < sizeof(kAddrModes) / sizeof(kAddrModes[0]); dst++)
+    {
+        for (unsigned src = 0; src < sizeof(kAddrModes) / sizeof(kAddrModes[0]); src++)
+        {
+            for (unsigned sec = 0; sec <= sizeof(kSecControls); sec++)
+            {
+                for (unsigned flags = 0; flags < 4; flags++)
+                {
+                    uint16_t fcf = static_cast<uint16_t>((kAddrModes[dst] << 10) | (kAddrModes[src] << 14) |
+                                                         Mac::Frame::kFcfFrameVersion2006);
+                    ReferenceHeader ref;
+
+                    fcf |= (flags & 1) ? Mac::Frame::kFcfFrameMacCmd : Mac::Frame::kFcfFrameData;
+
+                    if ((flags & 2) && dst != 0 && src != 0)
+                    {
+                        fcf |= Mac::Frame::kFcfPanidCompression;
+                    }
+
+                    for (unsigned i = 0; i < sizeof(psdu); i++)
+                    {
+                        psdu[i] = static_cast<uint8_t>(otPlatRandomGet());
+                    }
+
+                    psdu[0] = fcf & 0xff;
+                    psdu[1] = fcf >> 8;
+
+                    if (sec < sizeof(kSecControls))
+                    {
+                        psdu[0] |= Mac::Frame::kFcfSecurityEnabled;
+                        DecodeReference(psdu, ref);
+                        psdu[ref.mSecurity] = kSecControls[sec];
+                    }
+
+                    DecodeReference(psdu, ref);
+
+                    // A received frame is only parsed by ValidatePsdu().
+                    frame.SetPsduLength(ref.mHeaderLength + ref.mFooterLength - 1);
+                    VerifyOrQuit(frame.ValidatePsdu() == OT_ERROR_PARSE, "MacFrame ValidatePsdu accepted short frame\n");
+
+                    frame.SetPsduLength(ref.mHeaderLength + ref.mFooterLength + (count % 16));
+                    SuccessOrQuit(frame.ValidatePsdu(), "MacFrame ValidatePsdu failed\n");
+                    VerifyFrame(frame);
+
+                    // A transmitted frame is built by InitMacHeader() and the setters.
+                    frame.InitMacHeader(static_cast<uint16_t>(ReadUint16(psdu)),
+                                        (ref.mSecurity >= 0) ? psdu[ref.mSecurity] : 0);
+                    VerifyOrQuit(frame.GetPsduLength() == ref.mHeaderLength + ref.mFooterLength,
+                                 "MacFrame InitMacHeader length mismatch\n");
+
+                    if (ref.mDstAddrLength != 0)
+                    {
+                        SuccessOrQuit(frame.SetDstPanId(0xface), "MacFrame SetDstPanId failed\n");
+                    }
+
+                    if (ref.mDstAddrLength == sizeof(Mac::ShortAddress))
+                    {
+                        SuccessOrQuit(frame.SetDstAddr(static_cast<Mac::ShortAddress>(0x1234)), "SetDstAddr failed\n");
+                    }
+
+                    if (ref.mSrcAddrLength == sizeof(Mac::ShortAddress))
+                    {
+                        SuccessOrQuit(frame.SetSrcAddr(static_cast<Mac::ShortAddress>(0x5678)), "SetSrcAddr failed\n");
+                    }
+
+                    if (ref.mSecurity >= 0)
+                    {
+                        SuccessOrQuit(frame.SetFrameCounter(count), "MacFrame SetFrameCounter failed\n");
+                    }
+
+                    if (flags & 1)
+                    {
+                        SuccessOrQuit(frame.SetCommandId(Mac::Frame::kMacCmdDataRequest), "SetCommandId failed\n");
+                    }
+
+                    SuccessOrQuit(frame.SetPayloadLength(count % 16), "MacFrame SetPayloadLength failed\n");
+                    VerifyOrQuit(frame.GetPayloadLength() == count % 16, "MacFrame payload length mismatch\n");
+                    VerifyFrame(frame);
+
+                    count++;
+                }
+            }
+        }
+    }
+
+    printf("TestMacFrameParse: verified %u frames\n", count);
+}
+
+void TestMacFrameBenchmark(void)
+{
+    enum
+    {
+        kIterations = 200000,
+    };
+
+    // A typical mix of received Thread frames: secured data between neighbors, MLE to/from
+    // extended addresses, data polls, beacon requests and beacons.
+    static const struct
+    {
+        uint16_t mFcf;
+        uint8_t  mSecControl;
+        uint8_t  mPayloadLength;
+    } kFrameMix[] =
+    {
+        {
+            Mac::Frame::kFcfFrameData | Mac::Frame::kFcfPanidCompression | Mac::Frame::kFcfDstAddrShort |
+            Mac::Frame::kFcfSrcAddrShort | Mac::Frame::kFcfSecurityEnabled | Mac::Frame::kFcfAckRequest,
+            Mac::Frame::kKeyIdMode1 | Mac::Frame::kSecEncMic32, 80
+        },
+        {
+            Mac::Frame::kFcfFrameData | Mac::Frame::kFcfPanidCompression | Mac::Frame::kFcfDstAddrShort |
+            Mac::Frame::kFcfSrcAddrShort | Mac::Frame::kFcfSecurityEnabled,
+            Mac::Frame::kKeyIdMode1 | Mac::Frame::kSecEncMic32, 40
+        },
+        {
+            Mac::Frame::kFcfFrameData | Mac::Frame::kFcfPanidCompression | Mac::Frame::kFcfDstAddrExt |
+            Mac::Frame::kFcfSrcAddrExt | Mac::Frame::kFcfAckRequest,
+            0, 60
+        },
+        {
+            Mac::Frame::kFcfFrameData | Mac::Frame::kFcfPanidCompression | Mac::Frame::kFcfDstAddrShort |
+            Mac::Frame::kFcfSrcAddrExt,
+            0, 70
+        },
+        {
+            Mac::Frame::kFcfFrameMacCmd | Mac::Frame::kFcfPanidCompression | Mac::Frame::kFcfDstAddrShort |
+            Mac::Frame::kFcfSrcAddrExt | Mac::Frame::kFcfSecurityEnabled | Mac::Frame::kFcfAckRequest,
+            Mac::Frame::kKeyIdMode1 | Mac::Frame::kSecEncMic32, 0
+        },
+        {
+            Mac::Frame::kFcfFrameMacCmd | Mac::Frame::kFcfDstAddrShort | Mac::Frame::kFcfSrcAddrNone,
+            0, 0
+        },
+        {
+            Mac::Frame::kFcfFrameBeacon | Mac::Frame::kFcfDstAddrNone | Mac::Frame::kFcfSrcAddrExt,
+            0, 40
+        },
+    };
+    enum
+    {
+        kNumFrames = sizeof(kFrameMix) / sizeof(kFrameMix[0]),
+    };
+
+    uint8_t psdu[kNumFrames][Mac::Frame::kMTU];
+    uint8_t length[kNumFrames];
+    uint8_t rxPsdu[Mac::Frame::kMTU];
+    Mac::Frame frame;
+    uint32_t checksum = 0;
+    uint64_t start;
+    uint64_t elapsed;
+
+    memset(&frame, 0, sizeof(frame));
+    memset(psdu, 0, sizeof(psdu));
+
+    for (int i = 0; i < kNumFrames; i++)
+    {
+        frame.mPsdu = psdu[i];
+        frame.InitMacHeader(kFrameMix[i].mFcf | Mac::Frame::kFcfFrameVersion2006, kFrameMix[i].mSecControl);
+        frame.SetPayloadLength(kFrameMix[i].mPayloadLength);
+        length[i] = frame.GetPsduLength();
+    }
+
+    frame.mPsdu = rxPsdu;
+    start = testPlatGetMicroseconds();
+
+    for (int n = 0; n < kIterations; n++)
+    {
+        int i = n % kNumFrames;
+        Mac::Address srcaddr;
+        Mac::Address dstaddr;
+        Mac::PanId panid = 0;
+        uint8_t value = 0;
+        uint32_t frameCounter = 0;
+
+        // Mirrors the accessors used by Mac::ReceiveDoneTask(), Mac::ProcessReceiveSecurity() and
+        // MeshForwarder::HandleReceivedFrame() for each received frame.
+        memcpy(rxPsdu, psdu[i], length[i]);
+        frame.SetPsduLength(length[i]);
+        SuccessOrQuit(frame.ValidatePsdu(), "MacFrame ValidatePsdu failed\n");
+
+        frame.GetSrcAddr(srcaddr);
+        frame.GetDstAddr(dstaddr);
+        frame.GetDstPanId(panid);
+        frame.GetSrcPanId(panid);
+
+        if (frame.GetSecurityEnabled())
+        {
+            frame.GetSecurityLevel(value);
+            frame.GetKeyIdMode(value);
+            frame.GetFrameCounter(frameCounter);
+            frame.GetKeyId(value);
+            checksum += frame.GetHeaderLength() + frame.GetPayloadLength() + frame.GetFooterLength();
+            checksum += *frame.GetKeySource();
+        }
+
+        if (frame.GetType() == Mac::Frame::kFcfFrameMacCmd)
+        {
+            frame.GetCommandId(value);
+        }
+
+        checksum += static_cast<uint32_t>(frame.GetPayload() - rxPsdu) + frame.GetPayloadLength();
+        checksum += srcaddr.mLength + dstaddr.mLength + panid + value + frameCounter;
+    }
+
+    elapsed = testPlatGetMicroseconds() - start;
+
+    printf("MacFrameBenchmark: %d frames from a mix of %d (checksum %lu)\n", kIterations, kNumFrames,
+           static_cast<unsigned long>(checksum));
+    printf("MacFrameBenchmark: validate + accessors  %8.3f us/frame\n", static_cast<double>(elapsed) / kIterations);
+}
+
 }  // namespace ot
 
 #ifdef ENABLE_TEST_MAIN
 int main(void)
 {
     ot::TestMacHeader();
+    ot::TestMacFrameParse();
+    ot::TestMacFrameBenchmark();
     printf("All tests passed\n");
     return 0;
 }
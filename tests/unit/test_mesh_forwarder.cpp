@@ -0,0 +1,470 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_platform.h"
+
+#include "utils/wrap_string.h"
+
+#include <openthread/openthread.h>
+
+#include "openthread-instance.h"
+#include "common/encoding.hpp"
+#include "mac/mac_frame.hpp"
+#include "net/ip6.hpp"
+#include "net/udp6.hpp"
+#include "thread/lowpan.hpp"
+#include "thread/mesh_forwarder.hpp"
+#include "thread/thread_netif.hpp"
+
+#include "test_util.h"
+
+using ot::Encoding::BigEndian::HostSwap16;
+
+namespace ot {
+
+enum
+{
+    kUdpPort        = 12345,
+    kHeaderLength   = sizeof(Ip6::Header) + sizeof(Ip6::UdpHeader),
+    kPayloadLength  = 260,
+    kDatagramLength = kHeaderLength + kPayloadLength,
+};
+
+struct FragmentRange
+{
+    uint16_t mOffset;
+    uint16_t mEnd;
+};
+
+// The fragments of the test datagram, offsets refer to the uncompressed datagram.
+static const FragmentRange sFragments[] =
+{
+    { 0, 96 }, { 96, 160 }, { 160, 224 }, { 224, 288 }, { 288, kDatagramLength },
+};
+
+enum
+{
+    kNumFragments = sizeof(sFragments) / sizeof(sFragments[0]),
+};
+
+static uint32_t sNow;
+static Mac::ExtAddress sPeerExtAddress;
+static uint8_t sCompressedHeader[64];
+static int sCompressedHeaderLength;
+static uint8_t sPayload[kPayloadLength];
+static uint32_t sReceived;
+static uint32_t sReceivedInvalid;
+
+static uint32_t testMeshForwarderAlarmGetNow(void)
+{
+    return sNow;
+}
+
+static void AdvanceTime(otInstance *aInstance, uint32_t aDuration)
+{
+    uint32_t end = sNow + aDuration;
+
+    while (sNow != end)
+    {
+        sNow++;
+        otPlatAlarmFired(aInstance);
+    }
+}
+
+static void HandleUdpReceive(void *, otMessage *aMessage, const otMessageInfo *)
+{
+    Message &message = *static_cast<Message *>(aMessage);
+    uint8_t payload[kPayloadLength];
+
+    sReceived++;
+
+    if (message.GetLength() - message.GetOffset() != kPayloadLength ||
+        message.Read(message.GetOffset(), sizeof(payload), payload) != sizeof(payload) ||
+        memcmp(payload, sPayload, sizeof(payload)) != 0)
+    {
+        sReceivedInvalid++;
+    }
+}
+
+/**
+ * This function brings up the interface, opens the receiving socket and compresses the test datagram.
+ *
+ */
+static otInstance *InitInstance(Ip6::UdpSocket *&aSocket)
+{
+    otInstance *instance;
+    Ip6::Header ip6Header;
+    Ip6::UdpHeader udpHeader;
+    Ip6::Address source;
+    Ip6::Address destination;
+    Ip6::SockAddr sockAddr;
+    Mac::Address macSource;
+    Mac::Address macDest;
+    Message *message;
+
+    testPlatResetToDefaults();
+    g_testPlatAlarmGetNow = testMeshForwarderAlarmGetNow;
+    sNow = 0;
+    sReceived = 0;
+    sReceivedInvalid = 0;
+
+    instance = new otInstance;
+    SuccessOrQuit(otIp6SetEnabled(instance, true), "otIp6SetEnabled failed\n");
+    SuccessOrQuit(otIp6AddUnsecurePort(instance, kUdpPort), "otIp6AddUnsecurePort failed\n");
+
+    aSocket = new Ip6::UdpSocket(instance->mIp6.mUdp);
+    SuccessOrQuit(aSocket->Open(HandleUdpReceive, NULL), "UdpSocket::Open failed\n");
+    sockAddr.mPort = kUdpPort;
+    SuccessOrQuit(aSocket->Bind(sockAddr), "UdpSocket::Bind failed\n");
+
+    for (uint8_t i = 0; i < sizeof(sPeerExtAddress.m8); i++)
+    {
+        sPeerExtAddress.m8[i] = 0x10 + i;
+    }
+
+    for (uint16_t i = 0; i < kPayloadLength; i++)
+    {
+        sPayload[i] = static_cast<uint8_t>(i * 7 + 3);
+    }
+
+    macSource.mLength = sizeof(macSource.mExtAddress);
+    macSource.mExtAddress = sPeerExtAddress;
+    macDest.mLength = sizeof(macDest.mExtAddress);
+    macDest.mExtAddress = *instance->mThreadNetif.GetMac().GetExtAddress();
+
+    memset(&source, 0, sizeof(source));
+    source.mFields.m16[0] = HostSwap16(0xfe80);
+    source.SetIid(macSource.mExtAddress);
+    memset(&destination, 0, sizeof(destination));
+    destination.mFields.m16[0] = HostSwap16(0xfe80);
+    destination.SetIid(macDest.mExtAddress);
+
+    ip6Header.Init();
+    ip6Header.SetPayloadLength(sizeof(udpHeader) + kPayloadLength);
+    ip6Header.SetNextHeader(Ip6::kProtoUdp);
+    ip6Header.SetHopLimit(64);
+    ip6Header.SetSource(source);
+    ip6Header.SetDestination(destination);
+
+    udpHeader.SetSourcePort(kUdpPort);
+    udpHeader.SetDestinationPort(kUdpPort);
+    udpHeader.SetLength(sizeof(udpHeader) + kPayloadLength);
+    udpHeader.SetChecksum(0);
+
+    VerifyOrQuit((message = instance->mIp6.mMessagePool.New(Message::kTypeIp6, 0)) != NULL,
+                 "Message::New failed\n");
+    SuccessOrQuit(message->Append(&ip6Header, sizeof(ip6Header)), "Message::Append failed\n");
+    SuccessOrQuit(message->Append(&udpHeader, sizeof(udpHeader)), "Message::Append failed\n");
+    SuccessOrQuit(message->Append(sPayload, sizeof(sPayload)), "Message::Append failed\n");
+    message->SetOffset(sizeof(ip6Header));
+    instance->mIp6.mUdp.UpdateChecksum(*message, Ip6::Ip6::ComputePseudoheaderChecksum(source, destination,
+                                                                                       sizeof(udpHeader) + kPayloadLength,
+                                                                                       Ip6::kProtoUdp));
+    message->SetOffset(0);
+
+    sCompressedHeaderLength = instance->mThreadNetif.GetLowpan().Compress(*message, macSource, macDest,
+                                                                          sCompressedHeader);
+    VerifyOrQuit(sCompressedHeaderLength > 0 && message->GetOffset() == kHeaderLength, "Lowpan::Compress failed\n");
+    message->Free();
+
+    return instance;
+}
+
+static void FinalizeInstance(otInstance *aInstance, Ip6::UdpSocket *aSocket)
+{
+    SuccessOrQuit(aSocket->Close(), "UdpSocket::Close failed\n");
+    delete aSocket;
+    delete aInstance;
+    testPlatResetToDefaults();
+}
+
+/**
+ * This function receives an unsecured fragment of the test datagram, covering [aOffset, aEnd).
+ *
+ */
+static void ReceiveFragment(otInstance *aInstance, uint16_t aTag, uint16_t aOffset, uint16_t aEnd)
+{
+    Mac::Mac &mac = aInstance->mThreadNetif.GetMac();
+    uint8_t psdu[OT_RADIO_FRAME_MAX_SIZE];
+    otRadioFrame radioFrame;
+    Mac::Frame &frame = *static_cast<Mac::Frame *>(&radioFrame);
+    Lowpan::FragmentHeader *fragmentHeader;
+    uint8_t *payload;
+    uint8_t length;
+
+    memset(&radioFrame, 0, sizeof(radioFrame));
+    radioFrame.mPsdu = psdu;
+
+    frame.InitMacHeader(Mac::Frame::kFcfFrameData | Mac::Frame::kFcfPanidCompression |
+                        Mac::Frame::kFcfFrameVersion2006 | Mac::Frame::kFcfDstAddrExt | Mac::Frame::kFcfSrcAddrExt,
+                        Mac::Frame::kSecNone);
+    frame.SetDstPanId(mac.GetPanId());
+    frame.SetDstAddr(*mac.GetExtAddress());
+    frame.SetSrcAddr(sPeerExtAddress);
+
+    payload = frame.GetPayload();
+    fragmentHeader = reinterpret_cast<Lowpan::FragmentHeader *>(payload);
+    fragmentHeader->Init();
+    fragmentHeader->SetDatagramSize(kDatagramLength);
+    fragmentHeader->SetDatagramTag(aTag);
+    fragmentHeader->SetDatagramOffset(aOffset);
+    length = fragmentHeader->GetHeaderLength();
+
+    if (aOffset == 0)
+    {
+        memcpy(payload + length, sCompressedHeader, static_cast<size_t>(sCompressedHeaderLength));
+        length += static_cast<uint8_t>(sCompressedHeaderLength);
+        aOffset = kHeaderLength;
+    }
+
+    memcpy(payload + length, sPayload + aOffset - kHeaderLength, aEnd - aOffset);
+    length += static_cast<uint8_t>(aEnd - aOffset);
+    VerifyOrQuit(length <= frame.GetMaxPayloadLength(), "fragment does not fit in a frame\n");
+    SuccessOrQuit(frame.SetPayloadLength(length), "Frame::SetPayloadLength failed\n");
+
+    otPlatRadioReceiveDone(aInstance, &radioFrame, OT_ERROR_NONE);
+}
+
+static void ReceiveFragment(otInstance *aInstance, uint16_t aTag, uint8_t aIndex)
+{
+    ReceiveFragment(aInstance, aTag, sFragments[aIndex].mOffset, sFragments[aIndex].mEnd);
+}
+
+static uint16_t GetReassemblyCount(otInstance *aInstance)
+{
+    uint16_t messages;
+    uint16_t buffers;
+
+    aInstance->mThreadNetif.GetMeshForwarder().GetReassemblyQueue().GetInfo(messages, buffers);
+
+    return messages;
+}
+
+void TestFragmentOrder(void)
+{
+    static const uint8_t kOrders[][kNumFragments] =
+    {
+        { 0, 1, 2, 3, 4 },  // In order.
+        { 4, 3, 2, 1, 0 },  // Reversed.
+        { 2, 4, 0, 3, 1 },  // Shuffled.
+        { 3, 1, 4, 2, 0 },  // Every FRAGN before the FRAG1.
+    };
+
+    Ip6::UdpSocket *socket;
+    otInstance *instance = InitInstance(socket);
+    const otMacCounters &counters = instance->mThreadNetif.GetMac().GetCounters();
+
+    for (uint8_t i = 0; i < sizeof(kOrders) / sizeof(kOrders[0]); i++)
+    {
+        uint32_t completed = counters.mRxReassemblyCompleted;
+        uint32_t outOfOrder = counters.mRxFragmentOutOfOrder;
+
+        for (uint8_t j = 0; j < kNumFragments; j++)
+        {
+            VerifyOrQuit(sReceived == i, "datagram delivered before all fragments were received\n");
+            ReceiveFragment(instance, 100 + i, kOrders[i][j]);
+        }
+
+        VerifyOrQuit(sReceived == i + 1u && sReceivedInvalid == 0, "reassembled datagram was not delivered\n");
+        VerifyOrQuit(counters.mRxReassemblyCompleted == completed + 1, "RxReassemblyCompleted not counted\n");
+        VerifyOrQuit((counters.mRxFragmentOutOfOrder == outOfOrder) == (i == 0), "RxFragmentOutOfOrder mismatch\n");
+        VerifyOrQuit(GetReassemblyCount(instance) == 0, "reassembly buffer was not released\n");
+    }
+
+    VerifyOrQuit(counters.mRxFragmentDuplicated == 0, "fragments counted as duplicates\n");
+
+    FinalizeInstance(instance, socket);
+}
+
+void TestFragmentDuplicates(void)
+{
+    Ip6::UdpSocket *socket;
+    otInstance *instance = InitInstance(socket);
+    const otMacCounters &counters = instance->mThreadNetif.GetMac().GetCounters();
+    uint32_t duplicated = counters.mRxFragmentDuplicated;
+
+    ReceiveFragment(instance, 200, 0);
+    ReceiveFragment(instance, 200, 1);
+    ReceiveFragment(instance, 200, 1);
+    VerifyOrQuit(counters.mRxFragmentDuplicated == duplicated + 1, "duplicate FRAGN not counted\n");
+
+    ReceiveFragment(instance, 200, 0);
+    VerifyOrQuit(counters.mRxFragmentDuplicated == duplicated + 2, "duplicate FRAG1 not counted\n");
+
+    // A fragment that overlaps received data but adds new units is accepted, a fully covered one is a duplicate.
+    ReceiveFragment(instance, 200, 128, 192);
+    VerifyOrQuit(counters.mRxFragmentDuplicated == duplicated + 2, "overlapping fragment counted as duplicate\n");
+    ReceiveFragment(instance, 200, 104, 128);
+    VerifyOrQuit(counters.mRxFragmentDuplicated == duplicated + 3, "covered fragment not counted as duplicate\n");
+
+    ReceiveFragment(instance, 200, 2);
+    ReceiveFragment(instance, 200, 3);
+    VerifyOrQuit(sReceived == 0, "datagram delivered before all fragments were received\n");
+    ReceiveFragment(instance, 200, 4);
+    VerifyOrQuit(sReceived == 1 && sReceivedInvalid == 0, "reassembled datagram was not delivered\n");
+
+    // Late retransmissions after the datagram was delivered are duplicates.
+    ReceiveFragment(instance, 200, 2);
+    ReceiveFragment(instance, 200, 0);
+    VerifyOrQuit(counters.mRxFragmentDuplicated == duplicated + 5, "late retransmission not counted\n");
+    VerifyOrQuit(sReceived == 1 && GetReassemblyCount(instance) == 0, "late retransmission was reassembled\n");
+
+    FinalizeInstance(instance, socket);
+}
+
+void TestFragmentUnaligned(void)
+{
+    Ip6::UdpSocket *socket;
+    otInstance *instance = InitInstance(socket);
+    const otMacCounters &counters = instance->mThreadNetif.GetMac().GetCounters();
+
+    // [96, 156) would complete the datagram together with the others, but does not end on an 8-octet boundary.
+    ReceiveFragment(instance, 300, 0);
+    ReceiveFragment(instance, 300, 96, 156);
+    ReceiveFragment(instance, 300, 2);
+    ReceiveFragment(instance, 300, 3);
+    ReceiveFragment(instance, 300, 4);
+    VerifyOrQuit(sReceived == 0 && counters.mRxReassemblyCompleted == 0, "unaligned fragment was accepted\n");
+
+    ReceiveFragment(instance, 300, 1);
+    VerifyOrQuit(sReceived == 1 && sReceivedInvalid == 0, "reassembled datagram was not delivered\n");
+
+    FinalizeInstance(instance, socket);
+}
+
+void TestReassemblyEviction(void)
+{
+    Ip6::UdpSocket *socket;
+    otInstance *instance = InitInstance(socket);
+    const otMacCounters &counters = instance->mThreadNetif.GetMac().GetCounters();
+    uint32_t completed;
+
+    // Fill the table with datagrams whose first fragment was received, tag 400 is the closest to timing out.
+    ReceiveFragment(instance, 400, 0);
+    AdvanceTime(instance, 1000);
+
+    for (uint16_t i = 1; i < kNumReassemblyEntries; i++)
+    {
+        ReceiveFragment(instance, 400 + i, 0);
+    }
+
+    VerifyOrQuit(GetReassemblyCount(instance) == kNumReassemblyEntries, "reassembly table not full\n");
+
+    // A burst of later fragments with unknown tags does not displace any of them, even though they time out first.
+    AdvanceTime(instance, 1000);
+
+    for (uint16_t i = 0; i < 4 * kNumReassemblyEntries; i++)
+    {
+        ReceiveFragment(instance, 1000 + i, static_cast<uint8_t>(1 + i % (kNumFragments - 1)));
+    }
+
+    VerifyOrQuit(GetReassemblyCount(instance) == kNumReassemblyEntries, "later fragments displaced a datagram\n");
+
+    // A new first fragment gives up on the datagram closest to timing out.
+    ReceiveFragment(instance, 500, 0);
+    VerifyOrQuit(GetReassemblyCount(instance) == kNumReassemblyEntries, "reassembly table overflowed\n");
+
+    completed = counters.mRxReassemblyCompleted;
+
+    for (uint16_t i = 1; i < kNumReassemblyEntries; i++)
+    {
+        for (uint8_t j = 1; j < kNumFragments; j++)
+        {
+            ReceiveFragment(instance, 400 + i, j);
+        }
+    }
+
+    for (uint8_t j = 1; j < kNumFragments; j++)
+    {
+        ReceiveFragment(instance, 500, j);
+    }
+
+    VerifyOrQuit(counters.mRxReassemblyCompleted == completed + kNumReassemblyEntries &&
+                 sReceived == kNumReassemblyEntries && sReceivedInvalid == 0, "reassembly after eviction failed\n");
+
+    // The evicted datagram cannot complete without its first fragment.
+    for (uint8_t j = 1; j < kNumFragments; j++)
+    {
+        ReceiveFragment(instance, 400, j);
+    }
+
+    VerifyOrQuit(sReceived == kNumReassemblyEntries, "evicted datagram was delivered\n");
+
+    // Only a limited number of datagrams without a first fragment hold a buffer.
+    for (uint16_t i = 0; i < 4 * kNumReassemblyEntries; i++)
+    {
+        ReceiveFragment(instance, 2000 + i, static_cast<uint8_t>(1 + i % (kNumFragments - 1)));
+    }
+
+    VerifyOrQuit(GetReassemblyCount(instance) == kMaxHeaderlessReassemblyEntries,
+                 "too many datagrams without a first fragment\n");
+
+    FinalizeInstance(instance, socket);
+}
+
+void TestReassemblyTimeout(void)
+{
+    Ip6::UdpSocket *socket;
+    otInstance *instance = InitInstance(socket);
+    const otMacCounters &counters = instance->mThreadNetif.GetMac().GetCounters();
+
+    ReceiveFragment(instance, 600, 0);
+    ReceiveFragment(instance, 600, 1);
+    ReceiveFragment(instance, 601, 3);
+
+    AdvanceTime(instance, (kReassemblyTimeout - 1) * 1000);
+    VerifyOrQuit(GetReassemblyCount(instance) == 2 && counters.mRxReassemblyTimeout == 0,
+                 "reassembly timed out early\n");
+
+    AdvanceTime(instance, 2000);
+    VerifyOrQuit(GetReassemblyCount(instance) == 0 && counters.mRxReassemblyTimeout == 2,
+                 "reassembly did not time out\n");
+
+    // The remaining fragments start over and cannot complete the datagram.
+    ReceiveFragment(instance, 600, 2);
+    ReceiveFragment(instance, 600, 3);
+    ReceiveFragment(instance, 600, 4);
+    VerifyOrQuit(sReceived == 0 && GetReassemblyCount(instance) == 1, "timed out datagram was delivered\n");
+
+    FinalizeInstance(instance, socket);
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestFragmentOrder();
+    ot::TestFragmentDuplicates();
+    ot::TestFragmentUnaligned();
+    ot::TestReassemblyEviction();
+    ot::TestReassemblyTimeout();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
@@ -33,7 +33,9 @@
 #include "openthread-instance.h"
 #include "common/debug.hpp"
 #include "common/message.hpp"
+#include "common/tlvs.hpp"
 
+#include "test_platform.h"
 #include "test_util.h"
 
 void TestMessage(void)
@@ -65,10 +67,196 @@ void TestMessage(void)
                   "Message::Free failed\n");
 }
 
+void TestMessageCursor(void)
+{
+    otInstance instance;
+    ot::MessagePool messagePool(&instance);
+    ot::Message *message;
+    ot::Message *messageCopy;
+    uint8_t writeBuffer[1024];
+    uint8_t readBuffer[1024];
+    uint16_t length;
+    uint16_t offset;
+    const uint8_t *data;
+
+    for (unsigned i = 0; i < sizeof(writeBuffer); i++)
+    {
+        writeBuffer[i] = static_cast<uint8_t>(random());
+    }
+
+    // Reserve header space so that the data does not start at the beginning of the first buffer.
+    VerifyOrQuit((message = messagePool.New(ot::Message::kTypeIp6, 37)) != NULL, "Message::New failed\n");
+    SuccessOrQuit(message->Append(writeBuffer, sizeof(writeBuffer)), "Message::Append failed\n");
+    VerifyOrQuit(message->GetBufferCount() > 2, "Message does not span multiple buffers\n");
+
+    // Spans returned by the cursor cover the message exactly once.
+    {
+        ot::Message::Cursor cursor(*message, 0);
+
+        offset = 0;
+
+        while ((data = cursor.GetData(length)) != NULL)
+        {
+            VerifyOrQuit(length > 0, "Cursor::GetData returned an empty span\n");
+            VerifyOrQuit(memcmp(data, writeBuffer + offset, length) == 0, "Cursor::GetData span mismatch\n");
+            VerifyOrQuit(cursor.Skip(length) == length, "Cursor::Skip failed\n");
+            offset += length;
+        }
+
+        VerifyOrQuit(offset == sizeof(writeBuffer), "Cursor spans do not cover the message\n");
+        VerifyOrQuit(cursor.GetRemainingLength() == 0, "Cursor::GetRemainingLength failed\n");
+        VerifyOrQuit(cursor.Skip(1) == 0, "Cursor::Skip past the end failed\n");
+    }
+
+    // Sequential reads of varying size, peeks and seeks in both directions.
+    for (uint16_t step = 1; step < 300; step += 37)
+    {
+        ot::Message::Cursor cursor(*message, 0);
+
+        for (offset = 0; offset < sizeof(writeBuffer); offset += step)
+        {
+            uint16_t expected = (sizeof(writeBuffer) - offset < step) ? sizeof(writeBuffer) - offset : step;
+
+            VerifyOrQuit(cursor.GetOffset() == offset, "Cursor::GetOffset failed\n");
+            VerifyOrQuit(cursor.Peek(readBuffer, step) == expected, "Cursor::Peek failed\n");
+            VerifyOrQuit(cursor.GetOffset() == offset, "Cursor::Peek moved the cursor\n");
+            VerifyOrQuit(memcmp(readBuffer, writeBuffer + offset, expected) == 0, "Cursor::Peek mismatch\n");
+            memset(readBuffer, 0, sizeof(readBuffer));
+            VerifyOrQuit(cursor.Read(readBuffer, step) == expected, "Cursor::Read failed\n");
+            VerifyOrQuit(memcmp(readBuffer, writeBuffer + offset, expected) == 0, "Cursor::Read mismatch\n");
+        }
+
+        offset = (step * 13) % sizeof(writeBuffer);
+        cursor.Seek(offset);
+        VerifyOrQuit(cursor.GetOffset() == offset, "Cursor::Seek backward failed\n");
+        VerifyOrQuit(cursor.Read(readBuffer, 1) == 1 && readBuffer[0] == writeBuffer[offset],
+                     "Cursor::Read after Seek failed\n");
+    }
+
+    // Message::Write and Message::CopyTo across buffer boundaries and at odd offsets.
+    VerifyOrQuit((messageCopy = messagePool.New(ot::Message::kTypeIp6, 0)) != NULL, "Message::New failed\n");
+    SuccessOrQuit(messageCopy->SetLength(sizeof(writeBuffer)), "Message::SetLength failed\n");
+    VerifyOrQuit(messageCopy->Write(0, sizeof(writeBuffer), writeBuffer) == sizeof(writeBuffer),
+                 "Message::Write failed\n");
+    VerifyOrQuit(message->CopyTo(101, 333, 500, *messageCopy) == 500, "Message::CopyTo failed\n");
+    memmove(writeBuffer + 333, writeBuffer + 101, 500);
+    VerifyOrQuit(messageCopy->Read(0, sizeof(readBuffer), readBuffer) == sizeof(readBuffer),
+                 "Message::Read failed\n");
+    VerifyOrQuit(memcmp(writeBuffer, readBuffer, sizeof(writeBuffer)) == 0, "Message::CopyTo mismatch\n");
+
+    // Copying within the same message towards its start, as done when removing a header.
+    VerifyOrQuit(messageCopy->CopyTo(8, 0, 900, *messageCopy) == 900, "Message::CopyTo failed\n");
+    memmove(writeBuffer, writeBuffer + 8, 900);
+    VerifyOrQuit(messageCopy->Read(0, sizeof(readBuffer), readBuffer) == sizeof(readBuffer),
+                 "Message::Read failed\n");
+    VerifyOrQuit(memcmp(writeBuffer, readBuffer, sizeof(writeBuffer)) == 0, "Message::CopyTo in place mismatch\n");
+
+    SuccessOrQuit(messageCopy->Free(), "Message::Free failed\n");
+    SuccessOrQuit(message->Free(), "Message::Free failed\n");
+}
+
+/**
+ * This function returns the offset of a TLV by reading every TLV header with `Message::Read()`, as done before
+ * `Message::Cursor` was available. It is used as the baseline for the benchmark.
+ *
+ */
+static uint16_t FindTlvWithRead(const ot::Message &aMessage, uint8_t aType)
+{
+    uint16_t offset = aMessage.GetOffset();
+    ot::Tlv tlv;
+
+    while (offset < aMessage.GetLength())
+    {
+        aMessage.Read(offset, sizeof(tlv), &tlv);
+
+        if (tlv.GetType() == aType)
+        {
+            break;
+        }
+
+        offset += sizeof(tlv) + tlv.GetLength();
+    }
+
+    return offset;
+}
+
+void TestMessageCursorBenchmark(void)
+{
+    const uint16_t kMessageLengths[] = { 128, 512, 1280 };
+    const uint32_t kNumIterations = 20000;
+    otInstance instance;
+    ot::MessagePool messagePool(&instance);
+
+    for (size_t n = 0; n < sizeof(kMessageLengths) / sizeof(kMessageLengths[0]); n++)
+    {
+        ot::Message *message;
+        uint8_t tlvBuffer[sizeof(ot::Tlv) + 6];
+        ot::Tlv &tlv = *reinterpret_cast<ot::Tlv *>(tlvBuffer);
+        uint16_t numTlvs = 0;
+        uint16_t expected;
+        uint16_t offset = 0;
+        uint32_t checksum = 0;
+        uint64_t startTime;
+        uint64_t readDuration;
+        uint64_t cursorDuration;
+
+        VerifyOrQuit((message = messagePool.New(ot::Message::kTypeIp6, 0)) != NULL, "Message::New failed\n");
+
+        // Fill the message with small TLVs, as found in MLE and network data messages, ending with type 255.
+        memset(tlvBuffer, 0x5a, sizeof(tlvBuffer));
+
+        while (message->GetLength() + sizeof(tlvBuffer) < kMessageLengths[n])
+        {
+            tlv.SetType(static_cast<uint8_t>(numTlvs % 200));
+            tlv.SetLength(static_cast<uint8_t>(numTlvs % 7));
+            SuccessOrQuit(message->Append(tlvBuffer, sizeof(tlv) + tlv.GetLength()), "Message::Append failed\n");
+            numTlvs++;
+        }
+
+        expected = message->GetLength();
+        tlv.SetType(255);
+        tlv.SetLength(0);
+        SuccessOrQuit(message->Append(tlvBuffer, sizeof(tlv)), "Message::Append failed\n");
+
+        VerifyOrQuit(FindTlvWithRead(*message, 255) == expected, "FindTlvWithRead failed\n");
+        SuccessOrQuit(ot::Tlv::GetOffset(*message, 255, offset), "Tlv::GetOffset failed\n");
+        VerifyOrQuit(offset == expected, "Tlv::GetOffset returned the wrong offset\n");
+
+        startTime = testPlatGetMicroseconds();
+
+        for (uint32_t i = 0; i < kNumIterations; i++)
+        {
+            checksum += FindTlvWithRead(*message, 255);
+        }
+
+        readDuration = testPlatGetMicroseconds() - startTime;
+        startTime = testPlatGetMicroseconds();
+
+        for (uint32_t i = 0; i < kNumIterations; i++)
+        {
+            ot::Tlv::GetOffset(*message, 255, offset);
+            checksum += offset;
+        }
+
+        cursorDuration = testPlatGetMicroseconds() - startTime;
+
+        printf("MessageCursorBenchmark: %4u bytes, %2u buffers, %3u TLVs, Read() %7.1f ns, Cursor %7.1f ns (%lu)\n",
+               static_cast<unsigned int>(message->GetLength()), static_cast<unsigned int>(message->GetBufferCount()),
+               static_cast<unsigned int>(numTlvs + 1),
+               static_cast<double>(readDuration) * 1000 / kNumIterations,
+               static_cast<double>(cursorDuration) * 1000 / kNumIterations,
+               static_cast<unsigned long>(checksum));
+
+        SuccessOrQuit(message->Free(), "Message::Free failed\n");
+    }
+}
+
 #ifdef ENABLE_TEST_MAIN
 int main(void)
 {
     TestMessage();
+    TestMessageCursor();
+    TestMessageCursorBenchmark();
     printf("All tests passed\n");
     return 0;
 }
@@ -35,6 +35,7 @@
 #include "common/debug.hpp"
 #include "common/message.hpp"
 
+#include "test_platform.h"
 #include "test_util.h"
 
 #define kNumTestMessages      5
@@ -276,11 +277,208 @@ void TestMessageQueueOtApis(void)
 #endif
 }
 
+void TestIndirectMessageQueue(void)
+{
+    enum
+    {
+        kNumChildren = 3,
+        kNumRefs     = 4,
+    };
+
+    otInstance instance;
+    ot::MessagePool messagePool(&instance);
+    ot::IndirectMessageRef refs[kNumRefs];
+    ot::IndirectMessageRefPool refPool(refs, kNumRefs);
+    ot::IndirectMessageQueue queues[kNumChildren];
+    ot::Message *multicast;
+    ot::Message *unicast;
+    ot::Message *urgent;
+
+    memset(queues, 0, sizeof(queues));
+
+    VerifyOrQuit(refPool.GetFreeCount() == kNumRefs, "IndirectMessageRefPool free count is wrong.\n");
+
+    VerifyOrQuit((multicast = messagePool.New(ot::Message::kTypeIp6, 0)) != NULL, "Message::New failed\n");
+    VerifyOrQuit((unicast = messagePool.New(ot::Message::kTypeIp6, 0)) != NULL, "Message::New failed\n");
+    VerifyOrQuit((urgent = messagePool.New(ot::Message::kTypeIp6, 0)) != NULL, "Message::New failed\n");
+    SuccessOrQuit(urgent->SetPriority(ot::Message::kPriorityHigh), "Message::SetPriority failed\n");
+
+    VerifyOrQuit(!multicast->IsChildPending(), "New message is pending for a child.\n");
+
+    // A single message shared by all children.
+    for (int i = 0; i < kNumChildren; i++)
+    {
+        VerifyOrQuit(queues[i].GetHead() == NULL, "IndirectMessageQueue is not empty.\n");
+        SuccessOrQuit(queues[i].Enqueue(*multicast, refPool), "IndirectMessageQueue::Enqueue() failed.\n");
+        VerifyOrQuit(queues[i].GetHeadMessage() == multicast, "IndirectMessageQueue::GetHeadMessage() failed.\n");
+        VerifyOrQuit(multicast->IsChildPending(), "Message is not pending for a child.\n");
+    }
+
+    // Pool exhaustion.
+    SuccessOrQuit(queues[0].Enqueue(*unicast, refPool), "IndirectMessageQueue::Enqueue() failed.\n");
+    VerifyOrQuit(refPool.GetFreeCount() == 0, "IndirectMessageRefPool free count is wrong.\n");
+    VerifyOrQuit(queues[1].Enqueue(*unicast, refPool) == OT_ERROR_NO_BUFS,
+                 "IndirectMessageQueue::Enqueue() did not fail with an empty pool.\n");
+    VerifyOrQuit(!queues[1].Contains(*unicast), "IndirectMessageQueue::Contains() failed.\n");
+    VerifyOrQuit(queues[0].Contains(*unicast), "IndirectMessageQueue::Contains() failed.\n");
+
+    // The reference count drops to zero only when the last child is done with the message.
+    for (int i = 0; i < kNumChildren; i++)
+    {
+        VerifyOrQuit(multicast->IsChildPending(), "Message is not pending for a child.\n");
+        SuccessOrQuit(queues[i].Dequeue(*multicast, refPool), "IndirectMessageQueue::Dequeue() failed.\n");
+        VerifyOrQuit(queues[i].Dequeue(*multicast, refPool) == OT_ERROR_NOT_FOUND,
+                     "IndirectMessageQueue::Dequeue() succeeded for a message not in the queue.\n");
+    }
+
+    VerifyOrQuit(!multicast->IsChildPending(), "Message is still pending for a child.\n");
+    VerifyOrQuit(queues[0].GetHeadMessage() == unicast, "IndirectMessageQueue::GetHeadMessage() failed.\n");
+    VerifyOrQuit(queues[1].GetHead() == NULL, "IndirectMessageQueue is not empty.\n");
+
+    // Higher priority messages are placed ahead of lower priority ones, FIFO within a priority level.
+    SuccessOrQuit(queues[0].Enqueue(*multicast, refPool), "IndirectMessageQueue::Enqueue() failed.\n");
+    SuccessOrQuit(queues[0].Enqueue(*urgent, refPool), "IndirectMessageQueue::Enqueue() failed.\n");
+    VerifyOrQuit(queues[0].GetHeadMessage() == urgent, "IndirectMessageQueue priority order is wrong.\n");
+    VerifyOrQuit(&queues[0].GetHead()->GetNext()->GetMessage() == unicast,
+                 "IndirectMessageQueue priority order is wrong.\n");
+    VerifyOrQuit(&queues[0].GetHead()->GetNext()->GetNext()->GetMessage() == multicast,
+                 "IndirectMessageQueue priority order is wrong.\n");
+    VerifyOrQuit(queues[0].GetHead()->GetNext()->GetNext()->GetNext() == NULL,
+                 "IndirectMessageQueue priority order is wrong.\n");
+
+    // Removing the tail keeps appending working.
+    SuccessOrQuit(queues[0].Dequeue(*multicast, refPool), "IndirectMessageQueue::Dequeue() failed.\n");
+    SuccessOrQuit(queues[0].Enqueue(*multicast, refPool), "IndirectMessageQueue::Enqueue() failed.\n");
+    VerifyOrQuit(&queues[0].GetHead()->GetNext()->GetNext()->GetMessage() == multicast,
+                 "IndirectMessageQueue tail is wrong.\n");
+
+    SuccessOrQuit(queues[0].Dequeue(*unicast, refPool), "IndirectMessageQueue::Dequeue() failed.\n");
+    SuccessOrQuit(queues[0].Dequeue(*urgent, refPool), "IndirectMessageQueue::Dequeue() failed.\n");
+    SuccessOrQuit(queues[0].Dequeue(*multicast, refPool), "IndirectMessageQueue::Dequeue() failed.\n");
+    VerifyOrQuit(queues[0].GetHead() == NULL, "IndirectMessageQueue is not empty.\n");
+    VerifyOrQuit(refPool.GetFreeCount() == kNumRefs, "IndirectMessageRefPool leaked a reference.\n");
+    VerifyOrQuit(!unicast->IsChildPending() && !urgent->IsChildPending(), "Message is still pending.\n");
+
+    multicast->Free();
+    unicast->Free();
+    urgent->Free();
+}
+
+// Compares finding the next message for a polling child by scanning a shared send queue for the child's bit (as
+// done before the per-child queues) against taking the head of the child's own queue.
+void TestIndirectMessageQueueBenchmark(void)
+{
+    enum
+    {
+        kNumChildren  = 128,
+        kNumUnicast   = 24,
+        kNumMulticast = 4,
+        kNumMessages  = kNumUnicast + kNumMulticast,
+        kNumRefs      = kNumUnicast + kNumMulticast * kNumChildren,
+        kNumRounds    = 200,
+    };
+
+    otInstance instance;
+    ot::MessagePool messagePool(&instance);
+    ot::PriorityQueue sendQueue;
+    static ot::IndirectMessageRef refs[kNumRefs];
+    ot::IndirectMessageRefPool refPool(refs, kNumRefs);
+    static ot::IndirectMessageQueue queues[kNumChildren];
+    static uint8_t childMasks[kNumMessages][kNumChildren / 8];
+    ot::Message *msg[kNumMessages];
+    uint32_t checksum[2] = {0, 0};
+    uint64_t start;
+    uint64_t elapsed[2];
+
+    memset(queues, 0, sizeof(queues));
+    memset(childMasks, 0, sizeof(childMasks));
+
+    // Unicasts to a few children first, multicasts to all sleepy children at the tail of the send queue.
+    for (int i = 0; i < kNumMessages; i++)
+    {
+        VerifyOrQuit((msg[i] = messagePool.New(ot::Message::kTypeIp6, 0)) != NULL, "Message::New failed\n");
+        msg[i]->SetDatagramTag(static_cast<uint16_t>(i));
+        SuccessOrQuit(sendQueue.Enqueue(*msg[i]), "PriorityQueue::Enqueue() failed.\n");
+
+        for (int child = 0; child < kNumChildren; child++)
+        {
+            if (i >= kNumUnicast || child == (i * 37) % kNumChildren)
+            {
+                childMasks[i][child / 8] |= 0x80 >> (child % 8);
+                SuccessOrQuit(queues[child].Enqueue(*msg[i], refPool), "IndirectMessageQueue::Enqueue() failed.\n");
+            }
+        }
+    }
+
+    start = testPlatGetMicroseconds();
+
+    for (int round = 0; round < kNumRounds; round++)
+    {
+        for (int child = 0; child < kNumChildren; child++)
+        {
+            ot::Message *message;
+
+            for (message = sendQueue.GetHead(); message != NULL; message = message->GetNext())
+            {
+                if (childMasks[message->GetDatagramTag()][child / 8] & (0x80 >> (child % 8)))
+                {
+                    break;
+                }
+            }
+
+            checksum[0] += message->GetDatagramTag();
+        }
+    }
+
+    elapsed[0] = testPlatGetMicroseconds() - start;
+    start = testPlatGetMicroseconds();
+
+    for (int round = 0; round < kNumRounds; round++)
+    {
+        for (int child = 0; child < kNumChildren; child++)
+        {
+            checksum[1] += queues[child].GetHeadMessage()->GetDatagramTag();
+        }
+    }
+
+    elapsed[1] = testPlatGetMicroseconds() - start;
+
+    VerifyOrQuit(checksum[0] == checksum[1], "Per-child queues disagree with the send queue scan.\n");
+
+    printf("IndirectMessageQueueBenchmark: %d children, %d queued messages, %d polls\n", kNumChildren, kNumMessages,
+           kNumChildren * kNumRounds);
+    printf("IndirectMessageQueueBenchmark: send queue scan  %8.1f ns/poll\n",
+           static_cast<double>(elapsed[0]) * 1000.0 / (kNumChildren * kNumRounds));
+    printf("IndirectMessageQueueBenchmark: per-child queue  %8.1f ns/poll\n",
+           static_cast<double>(elapsed[1]) * 1000.0 / (kNumChildren * kNumRounds));
+
+    for (int child = 0; child < kNumChildren; child++)
+    {
+        ot::Message *message;
+
+        while ((message = queues[child].GetHeadMessage()) != NULL)
+        {
+            SuccessOrQuit(queues[child].Dequeue(*message, refPool), "IndirectMessageQueue::Dequeue() failed.\n");
+        }
+    }
+
+    VerifyOrQuit(refPool.GetFreeCount() == kNumRefs, "IndirectMessageRefPool leaked a reference.\n");
+
+    for (int i = 0; i < kNumMessages; i++)
+    {
+        VerifyOrQuit(!msg[i]->IsChildPending(), "Message is still pending for a child.\n");
+        SuccessOrQuit(sendQueue.Dequeue(*msg[i]), "PriorityQueue::Dequeue() failed.\n");
+        msg[i]->Free();
+    }
+}
+
 #ifdef ENABLE_TEST_MAIN
 int main(void)
 {
     TestMessageQueue();
     TestMessageQueueOtApis();
+    TestIndirectMessageQueue();
+    TestIndirectMessageQueueBenchmark();
     printf("All tests passed\n");
     return 0;
 }
@@ -0,0 +1,359 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_platform.h"
+
+#include "utils/wrap_string.h"
+
+#include <openthread/openthread.h>
+#include <openthread/thread_ftd.h>
+
+#include "openthread-instance.h"
+#include "mac/mac.hpp"
+#include "thread/mle_router.hpp"
+#include "thread/thread_netif.hpp"
+
+#include "test_util.h"
+
+namespace ot {
+
+enum
+{
+    kNumMaxChildrenAllowed = Mle::kMaxChildren - 1,
+};
+
+static const otMasterKey kMasterKey =
+{
+    {
+        0x00, 0x11, 0x22, 0x33, 0x44, 0x55, 0x66, 0x77,
+        0x88, 0x99, 0xaa, 0xbb, 0xcc, 0xdd, 0xee, 0xff,
+    }
+};
+
+static Mac::ExtAddress MakeExtAddress(uint8_t aType, uint8_t aIndex)
+{
+    Mac::ExtAddress address;
+
+    for (uint8_t i = 0; i < sizeof(address.m8); i++)
+    {
+        address.m8[i] = static_cast<uint8_t>(aType + aIndex * 37 + i * 11);
+    }
+
+    address.m8[0] = aType;
+    address.m8[7] = aIndex;
+
+    return address;
+}
+
+/**
+ * This function is the linear search used before neighbor lookups were indexed, it serves as the reference.
+ *
+ */
+static Neighbor *ReferenceGetNeighbor(Mle::MleRouter &aMle, const Mac::Address &aAddress)
+{
+    uint8_t numChildren;
+    uint8_t numRouters;
+    Child *children = aMle.GetChildren(&numChildren);
+    Router *routers = aMle.GetRouters(&numRouters);
+    uint8_t routerId = Mle::Mle::GetRouterId(aMle.GetRloc16());
+    Neighbor *rval = NULL;
+
+    if (aAddress.mLength == sizeof(aAddress.mShortAddress) &&
+        (aAddress.mShortAddress == Mac::kShortAddrBroadcast || aAddress.mShortAddress == Mac::kShortAddrInvalid))
+    {
+        ExitNow();
+    }
+
+    for (uint8_t i = 0; i < numChildren; i++)
+    {
+        if (children[i].IsStateValidOrRestoring() &&
+            ((aAddress.mLength == sizeof(aAddress.mShortAddress) && children[i].GetRloc16() == aAddress.mShortAddress) ||
+             (aAddress.mLength == sizeof(aAddress.mExtAddress) &&
+              memcmp(&children[i].GetExtAddress(), &aAddress.mExtAddress, sizeof(aAddress.mExtAddress)) == 0)))
+        {
+            ExitNow(rval = &children[i]);
+        }
+    }
+
+    for (uint8_t i = 0; i < numRouters; i++)
+    {
+        if (i != routerId && routers[i].GetState() == Neighbor::kStateValid &&
+            ((aAddress.mLength == sizeof(aAddress.mShortAddress) && routers[i].GetRloc16() == aAddress.mShortAddress) ||
+             (aAddress.mLength == sizeof(aAddress.mExtAddress) &&
+              memcmp(&routers[i].GetExtAddress(), &aAddress.mExtAddress, sizeof(aAddress.mExtAddress)) == 0)))
+        {
+            ExitNow(rval = &routers[i]);
+        }
+    }
+
+exit:
+    return rval;
+}
+
+/**
+ * This function brings up a leader with a full child table and a router table with every router ID in use.
+ *
+ */
+static otInstance *SetUpLeader(void)
+{
+    otInstance *instance = new otInstance;
+    Mle::MleRouter &mle = instance->mThreadNetif.GetMle();
+    uint8_t numChildren;
+    uint8_t numRouters;
+    Child *children;
+    Router *routers;
+    uint8_t routerId;
+
+    SuccessOrQuit(otThreadSetMasterKey(instance, &kMasterKey), "otThreadSetMasterKey failed\n");
+    SuccessOrQuit(otLinkSetPanId(instance, 0x1234), "otLinkSetPanId failed\n");
+    SuccessOrQuit(mle.SetMaxAllowedChildren(kNumMaxChildrenAllowed), "SetMaxAllowedChildren failed\n");
+    SuccessOrQuit(otIp6SetEnabled(instance, true), "otIp6SetEnabled failed\n");
+    SuccessOrQuit(otThreadSetEnabled(instance, true), "otThreadSetEnabled failed\n");
+
+    // Neighbor addresses are assigned before becoming leader, which rebuilds the neighbor index.
+    children = mle.GetChildren(&numChildren);
+
+    for (uint8_t i = 0; i < numChildren; i++)
+    {
+        children[i].SetExtAddress(MakeExtAddress(0x20, i));
+        children[i].SetRloc16(static_cast<uint16_t>(0x0400 | (i + 1)));
+    }
+
+    routers = mle.GetRouters(&numRouters);
+
+    for (uint8_t i = 0; i < numRouters; i++)
+    {
+        routers[i].SetExtAddress(MakeExtAddress(0x30, i));
+        routers[i].SetRloc16(Mle::Mle::GetRloc16(i));
+    }
+
+    SuccessOrQuit(otThreadBecomeLeader(instance), "otThreadBecomeLeader failed\n");
+    VerifyOrQuit(otThreadGetDeviceRole(instance) == OT_DEVICE_ROLE_LEADER, "Device did not become leader\n");
+
+    // Lookups check neighbor state, so states can change without rebuilding the index.
+    routerId = Mle::Mle::GetRouterId(mle.GetRloc16());
+
+    for (uint8_t i = 0; i < numChildren; i++)
+    {
+        children[i].SetState((i % 4) == 3 ? Neighbor::kStateChildIdRequest :
+                             (i % 4) == 2 ? Neighbor::kStateRestored : Neighbor::kStateValid);
+    }
+
+    for (uint8_t i = 0; i < numRouters; i++)
+    {
+        if (i != routerId)
+        {
+            routers[i].SetState((i % 8) == 7 ? Neighbor::kStateLinkRequest : Neighbor::kStateValid);
+        }
+    }
+
+    return instance;
+}
+
+static void TearDownLeader(otInstance *aInstance)
+{
+    SuccessOrQuit(otThreadSetEnabled(aInstance, false), "otThreadSetEnabled failed\n");
+    SuccessOrQuit(otIp6SetEnabled(aInstance, false), "otIp6SetEnabled failed\n");
+
+    delete aInstance;
+}
+
+void TestMleRouterNeighborLookup(void)
+{
+    otInstance *instance = SetUpLeader();
+    Mle::MleRouter &mle = instance->mThreadNetif.GetMle();
+    Mac::Address address;
+    Neighbor *expected;
+    Neighbor *neighbor;
+    uint16_t numFound = 0;
+    uint16_t numExpected;
+
+    for (uint16_t type = 0x20; type <= 0x40; type += 0x10)
+    {
+        for (uint16_t i = 0; i <= Mle::kMaxRouterId; i++)
+        {
+            address.mLength = sizeof(address.mExtAddress);
+            address.mExtAddress = MakeExtAddress(static_cast<uint8_t>(type), static_cast<uint8_t>(i));
+
+            expected = ReferenceGetNeighbor(mle, address);
+            neighbor = mle.GetNeighbor(address.mExtAddress);
+            VerifyOrQuit(neighbor == expected, "GetNeighbor(ExtAddress) mismatch\n");
+            VerifyOrQuit(mle.GetNeighbor(address) == expected, "GetNeighbor(Mac::Address) mismatch\n");
+
+            if (type == 0x20)
+            {
+                VerifyOrQuit(mle.GetChild(address.mExtAddress) == expected, "GetChild(ExtAddress) mismatch\n");
+            }
+
+            numFound += (neighbor != NULL);
+        }
+    }
+
+    for (uint32_t rloc16 = 0; rloc16 <= 0xffff; rloc16++)
+    {
+        address.mLength = sizeof(address.mShortAddress);
+        address.mShortAddress = static_cast<uint16_t>(rloc16);
+
+        expected = ReferenceGetNeighbor(mle, address);
+        neighbor = mle.GetNeighbor(address.mShortAddress);
+        VerifyOrQuit(neighbor == expected, "GetNeighbor(ShortAddress) mismatch\n");
+
+        numFound += (neighbor != NULL);
+    }
+
+    // Children beyond the allowed maximum, children still attaching, routers without a link and this device
+    // itself are not neighbors.
+    numExpected = 0;
+
+    for (uint8_t i = 0; i < kNumMaxChildrenAllowed; i++)
+    {
+        numExpected += ((i % 4) != 3);
+    }
+
+    for (uint8_t i = 0; i <= Mle::kMaxRouterId; i++)
+    {
+        numExpected += ((i % 8) != 7 && i != Mle::Mle::GetRouterId(mle.GetRloc16()));
+    }
+
+    VerifyOrQuit(numFound == 2 * numExpected, "Unexpected number of neighbors\n");
+
+    TearDownLeader(instance);
+}
+
+void TestMleRouterNeighborLookupBenchmark(void)
+{
+    enum
+    {
+        kNumNeighbors  = Mle::kMaxChildren + Mle::kMaxRouterId + 1,
+        kNumIterations = 200,
+        kNumFrames     = 20000,
+    };
+
+    otInstance *instance = SetUpLeader();
+    ThreadNetif &netif = instance->mThreadNetif;
+    Mle::MleRouter &mle = netif.GetMle();
+    Mac::Mac &mac = netif.GetMac();
+    Mac::Address addresses[2 * kNumNeighbors];
+    Mac::Frame frame;
+    uint8_t psdu[OT_RADIO_FRAME_MAX_SIZE];
+    uint8_t rxPsdu[OT_RADIO_FRAME_MAX_SIZE];
+    uint8_t length;
+    uint8_t numChildren;
+    Child *children = mle.GetChildren(&numChildren);
+    uint64_t start;
+    uint64_t elapsed[3];
+    uint32_t found = 0;
+
+    // Look up every child and router slot, by RLOC16 and by Extended Address, including slots that do not match.
+    for (uint16_t i = 0; i < kNumNeighbors; i++)
+    {
+        bool isChild = i < Mle::kMaxChildren;
+        uint8_t index = static_cast<uint8_t>(isChild ? i : i - Mle::kMaxChildren);
+
+        addresses[2 * i].mLength = sizeof(addresses[2 * i].mShortAddress);
+        addresses[2 * i].mShortAddress = isChild ? static_cast<uint16_t>(0x0400 | (index + 1)) : Mle::Mle::GetRloc16(index);
+        addresses[2 * i + 1].mLength = sizeof(addresses[2 * i + 1].mExtAddress);
+        addresses[2 * i + 1].mExtAddress = MakeExtAddress(isChild ? 0x20 : 0x30, index);
+    }
+
+    start = testPlatGetMicroseconds();
+
+    for (int n = 0; n < kNumIterations; n++)
+    {
+        for (uint16_t i = 0; i < 2 * kNumNeighbors; i++)
+        {
+            found += (ReferenceGetNeighbor(mle, addresses[i]) != NULL);
+        }
+    }
+
+    elapsed[0] = testPlatGetMicroseconds() - start;
+    start = testPlatGetMicroseconds();
+
+    for (int n = 0; n < kNumIterations; n++)
+    {
+        for (uint16_t i = 0; i < 2 * kNumNeighbors; i++)
+        {
+            found -= (mle.GetNeighbor(addresses[i]) != NULL);
+        }
+    }
+
+    elapsed[1] = testPlatGetMicroseconds() - start;
+
+    VerifyOrQuit(found == 0, "Indexed lookup disagrees with linear search\n");
+
+    // Unsecured data frames from the last allowed child go through the MAC and mesh forwarder receive path.
+    memset(&frame, 0, sizeof(frame));
+    frame.mPsdu = psdu;
+    frame.InitMacHeader(Mac::Frame::kFcfFrameData | Mac::Frame::kFcfPanidCompression |
+                        Mac::Frame::kFcfDstAddrShort | Mac::Frame::kFcfSrcAddrExt,
+                        Mac::Frame::kSecNone);
+    frame.SetDstPanId(mac.GetPanId());
+    frame.SetDstAddr(mac.GetShortAddress());
+    frame.SetSrcAddr(children[kNumMaxChildrenAllowed - 1].GetExtAddress());
+    frame.SetPayloadLength(32);
+    memset(frame.GetPayload(), 0, 32);
+    length = frame.GetPsduLength();
+
+    start = testPlatGetMicroseconds();
+
+    for (int n = 0; n < kNumFrames; n++)
+    {
+        memset(&frame, 0, sizeof(frame));
+        memcpy(rxPsdu, psdu, length);
+        frame.mPsdu = rxPsdu;
+        frame.SetPsduLength(length);
+        frame.mChannel = mac.GetChannel();
+
+        otPlatRadioReceiveDone(instance, &frame, OT_ERROR_NONE);
+    }
+
+    elapsed[2] = testPlatGetMicroseconds() - start;
+
+    printf("MleRouterNeighborLookupBenchmark: %d children, %d router slots\n", Mle::kMaxChildren,
+           Mle::kMaxRouterId + 1);
+    printf("MleRouterNeighborLookupBenchmark: linear search      %8.1f ns/lookup\n",
+           1000.0 * elapsed[0] / (kNumIterations * 2 * kNumNeighbors));
+    printf("MleRouterNeighborLookupBenchmark: GetNeighbor        %8.1f ns/lookup\n",
+           1000.0 * elapsed[1] / (kNumIterations * 2 * kNumNeighbors));
+    printf("MleRouterNeighborLookupBenchmark: receive path       %8.1f ns/frame\n",
+           1000.0 * elapsed[2] / kNumFrames);
+
+    TearDownLeader(instance);
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestMleRouterNeighborLookup();
+    ot::TestMleRouterNeighborLookupBenchmark();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,308 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_platform.h"
+
+#include "utils/wrap_string.h"
+
+#include <openthread/openthread.h>
+
+#include "openthread-instance.h"
+#include "common/encoding.hpp"
+#include "net/ip6.hpp"
+#include "net/ip6_mpl.hpp"
+
+#include "test_util.h"
+
+using ot::Encoding::BigEndian::HostSwap16;
+
+namespace ot {
+
+static uint32_t sNow;
+
+static uint32_t testMplAlarmGetNow(void)
+{
+    return sNow;
+}
+
+static void AdvanceTime(otInstance *aInstance, uint32_t aDuration)
+{
+    uint32_t end = sNow + aDuration;
+
+    // Fire the timers in order, one millisecond at a time.
+    while (sNow != end)
+    {
+        sNow++;
+        otPlatAlarmFired(aInstance);
+    }
+}
+
+static Message *NewMplMessage(otInstance *aInstance, uint16_t aSeedId, uint8_t aSequence)
+{
+    Ip6::Ip6 &ip6 = aInstance->mThreadNetif.GetIp6();
+    Message *message = ip6.mMessagePool.New(Message::kTypeIp6, 0);
+    Ip6::Header header;
+    Ip6::OptionMpl option;
+
+    VerifyOrQuit(message != NULL, "MessagePool::New failed\n");
+
+    header.Init();
+    header.SetHopLimit(64);
+    header.SetNextHeader(Ip6::kProtoHopOpts);
+    header.GetDestination().mFields.m16[0] = HostSwap16(0xff03);
+    header.GetDestination().mFields.m16[7] = HostSwap16(0xfc);
+
+    option.Init();
+    option.SetSeedIdLength(Ip6::OptionMpl::kSeedIdLength2);
+    option.SetSeedId(aSeedId);
+    option.SetSequence(aSequence);
+
+    SuccessOrQuit(message->Append(&header, sizeof(header)), "Message::Append failed\n");
+    SuccessOrQuit(message->Append(&option, sizeof(option)), "Message::Append failed\n");
+    message->SetOffset(sizeof(header));
+
+    return message;
+}
+
+static void SetMplSequence(Message &aMessage, uint16_t aSeedId, uint8_t aSequence)
+{
+    Ip6::OptionMpl option;
+
+    aMessage.Read(aMessage.GetOffset(), sizeof(option), &option);
+    option.SetSeedId(aSeedId);
+    option.SetSequence(aSequence);
+    aMessage.Write(aMessage.GetOffset(), sizeof(option), &option);
+}
+
+static otError ProcessMpl(otInstance *aInstance, uint16_t aSeedId, uint8_t aSequence)
+{
+    Ip6::Address source;
+    Message *message = NewMplMessage(aInstance, aSeedId, aSequence);
+    otError error;
+
+    memset(&source, 0, sizeof(source));
+    error = aInstance->mThreadNetif.GetIp6().mMpl.ProcessOption(*message, source, false);
+    message->Free();
+
+    return error;
+}
+
+static uint16_t GetBufferedMessageCount(otInstance *aInstance)
+{
+    uint16_t messages;
+    uint16_t buffers;
+
+    aInstance->mThreadNetif.GetIp6().mMpl.GetBufferedMessageSet().GetInfo(messages, buffers);
+
+    return messages;
+}
+
+static uint16_t GetSendQueueCount(otInstance *aInstance)
+{
+    uint16_t messages;
+    uint16_t buffers;
+
+    aInstance->mThreadNetif.GetIp6().GetSendQueue().GetInfo(messages, buffers);
+
+    return messages;
+}
+
+void TestMplSeedSet(void)
+{
+    otInstance *instance;
+
+    testPlatResetToDefaults();
+    g_testPlatAlarmGetNow = testMplAlarmGetNow;
+    sNow = 0;
+    instance = new otInstance;
+
+    // New seed and duplicate.
+    SuccessOrQuit(ProcessMpl(instance, 0x0400, 10), "MPL dropped first message\n");
+    VerifyOrQuit(ProcessMpl(instance, 0x0400, 10) == OT_ERROR_DROP, "MPL accepted duplicate\n");
+
+    // Reordered messages are accepted once.
+    SuccessOrQuit(ProcessMpl(instance, 0x0400, 12), "MPL dropped new message\n");
+    SuccessOrQuit(ProcessMpl(instance, 0x0400, 11), "MPL dropped reordered message\n");
+    VerifyOrQuit(ProcessMpl(instance, 0x0400, 11) == OT_ERROR_DROP, "MPL accepted reordered duplicate\n");
+
+    // Seeds are independent of each other.
+    SuccessOrQuit(ProcessMpl(instance, 0x0401, 11), "MPL dropped message from another seed\n");
+    SuccessOrQuit(ProcessMpl(instance, 0x0800, 200), "MPL dropped message from another seed\n");
+
+    // Slide the window so that sequence 12 is the oldest one still tracked.
+    SuccessOrQuit(ProcessMpl(instance, 0x0400, 43), "MPL dropped new message\n");
+    VerifyOrQuit(ProcessMpl(instance, 0x0400, 12) == OT_ERROR_DROP, "MPL accepted duplicate at window edge\n");
+    SuccessOrQuit(ProcessMpl(instance, 0x0400, 13), "MPL dropped reordered message within window\n");
+    VerifyOrQuit(ProcessMpl(instance, 0x0400, 11) == OT_ERROR_DROP, "MPL accepted message older than window\n");
+
+    // A jump beyond the window clears it, and sequence numbers wrap around.
+    SuccessOrQuit(ProcessMpl(instance, 0x0400, 120), "MPL dropped new message\n");
+    SuccessOrQuit(ProcessMpl(instance, 0x0400, 100), "MPL dropped reordered message within window\n");
+    SuccessOrQuit(ProcessMpl(instance, 0x0800, 5), "MPL dropped message after wrap around\n");
+    VerifyOrQuit(ProcessMpl(instance, 0x0800, 200) == OT_ERROR_DROP, "MPL accepted duplicate after wrap around\n");
+
+    // Fill the Seed Set, then let the entries expire.
+    for (uint16_t seed = 0; seed < OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRIES - 3; seed++)
+    {
+        SuccessOrQuit(ProcessMpl(instance, static_cast<uint16_t>(0x1000 + seed), 0), "MPL dropped new seed\n");
+    }
+
+    VerifyOrQuit(ProcessMpl(instance, 0x2000, 0) == OT_ERROR_DROP, "MPL Seed Set overflowed\n");
+    VerifyOrQuit(ProcessMpl(instance, 0x1000, 0) == OT_ERROR_DROP, "MPL accepted duplicate in full Seed Set\n");
+
+    AdvanceTime(instance, (OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRY_LIFETIME + 1) * 1000);
+
+    SuccessOrQuit(ProcessMpl(instance, 0x2000, 0), "MPL Seed Set entries did not expire\n");
+    SuccessOrQuit(ProcessMpl(instance, 0x0400, 120), "MPL Seed Set entry did not expire\n");
+
+    delete instance;
+    testPlatResetToDefaults();
+}
+
+void TestMplBufferedSet(void)
+{
+    otInstance *instance;
+    Ip6::Mpl *mpl;
+
+    testPlatResetToDefaults();
+    g_testPlatAlarmGetNow = testMplAlarmGetNow;
+    sNow = 0;
+    instance = new otInstance;
+    mpl = &instance->mThreadNetif.GetIp6().mMpl;
+    mpl->SetTimerExpirations(2);
+
+    SuccessOrQuit(ProcessMpl(instance, 0x0400, 5), "MPL dropped message\n");
+    SuccessOrQuit(ProcessMpl(instance, 0x0800, 1), "MPL dropped message\n");
+    VerifyOrQuit(GetBufferedMessageCount(instance) == 2, "MPL did not buffer messages\n");
+
+    // A newer message stops the retransmissions of older ones from the same seed.
+    SuccessOrQuit(ProcessMpl(instance, 0x0400, 7), "MPL dropped message\n");
+    VerifyOrQuit(GetBufferedMessageCount(instance) == 2, "MPL did not drop the older buffered message\n");
+
+    // A late message is still forwarded.
+    SuccessOrQuit(ProcessMpl(instance, 0x0400, 6), "MPL dropped reordered message\n");
+    VerifyOrQuit(GetBufferedMessageCount(instance) == 3, "MPL did not buffer the reordered message\n");
+
+    // Each message is sent once per timer expiration, then leaves the Buffered Message Set.
+    AdvanceTime(instance, (OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRY_LIFETIME + 1) * 1000);
+    VerifyOrQuit(GetBufferedMessageCount(instance) == 0, "MPL did not release buffered messages\n");
+    VerifyOrQuit(GetSendQueueCount(instance) == 6, "MPL did not send the expected number of messages\n");
+
+    // The Buffered Message Set is bounded.
+    for (uint16_t seed = 0; seed < OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_ENTRIES; seed++)
+    {
+        SuccessOrQuit(ProcessMpl(instance, static_cast<uint16_t>(0x1000 + seed), 0), "MPL dropped message\n");
+    }
+
+    VerifyOrQuit(GetBufferedMessageCount(instance) == OPENTHREAD_CONFIG_MPL_BUFFERED_MESSAGE_ENTRIES,
+                 "MPL did not buffer messages\n");
+
+    delete instance;
+    testPlatResetToDefaults();
+}
+
+void TestMplBenchmark(void)
+{
+    enum
+    {
+        kNumSeeds    = OPENTHREAD_CONFIG_MPL_SEED_SET_ENTRIES,
+        kBurstLength = 8,
+        kNumBursts   = 2000,
+    };
+
+    otInstance *instance;
+    Ip6::Mpl *mpl;
+    Ip6::Address source;
+    Message *message;
+    uint32_t accepted = 0;
+    uint32_t received = 0;
+    uint64_t start;
+    uint64_t elapsed;
+
+    testPlatResetToDefaults();
+    g_testPlatAlarmGetNow = testMplAlarmGetNow;
+    sNow = 0;
+    instance = new otInstance;
+    mpl = &instance->mThreadNetif.GetIp6().mMpl;
+    message = NewMplMessage(instance, 0, 0);
+    memset(&source, 0, sizeof(source));
+
+    start = testPlatGetMicroseconds();
+
+    // Every seed sends bursts of messages, each one is heard from two neighbors and
+    // adjacent messages of a burst arrive swapped.
+    for (int burst = 0; burst < kNumBursts; burst++)
+    {
+        uint16_t seedId = static_cast<uint16_t>((burst % kNumSeeds) << 10);
+        uint8_t base = static_cast<uint8_t>((burst / kNumSeeds) * kBurstLength);
+
+        for (int i = 0; i < kBurstLength; i++)
+        {
+            uint8_t sequence = static_cast<uint8_t>(base + (i ^ 1));
+
+            for (int copy = 0; copy < 2; copy++)
+            {
+                SetMplSequence(*message, seedId, sequence);
+
+                if (mpl->ProcessOption(*message, source, false) == OT_ERROR_NONE)
+                {
+                    accepted++;
+                }
+
+                received++;
+            }
+        }
+
+        sNow += 10;
+    }
+
+    elapsed = testPlatGetMicroseconds() - start;
+
+    VerifyOrQuit(accepted == kNumBursts * kBurstLength, "MPL did not accept each message exactly once\n");
+
+    printf("MplBenchmark: %d seeds, %lu messages received, %lu accepted\n", kNumSeeds,
+           static_cast<unsigned long>(received), static_cast<unsigned long>(accepted));
+    printf("MplBenchmark: seed set  %8.1f ns/message\n", 1000.0 * elapsed / received);
+
+    message->Free();
+    delete instance;
+    testPlatResetToDefaults();
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestMplSeedSet();
+    ot::TestMplBufferedSet();
+    ot::TestMplBenchmark();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
@@ -0,0 +1,799 @@
+/*
+ *  Copyright (c) 2016, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <openthread/diag.h>
+#include <openthread/openthread.h>
+#include <openthread/thread_ftd.h>
+
+#include "openthread-instance.h"
+#include "common/code_utils.hpp"
+#include "common/new.hpp"
+#include "ncp/hdlc.hpp"
+#include "ncp/ncp_base.hpp"
+#include "ncp/spinel.h"
+
+#include "test_platform.h"
+#include "test_util.h"
+
+#if OPENTHREAD_ENABLE_DIAG
+// The diagnostics module is not linked into this test (manufacturing commands are not exercised).
+extern "C" char *otDiagProcessCmdLine(char *aString)
+{
+    (void)aString;
+    return NULL;
+}
+#endif
+
+namespace ot {
+
+// This module implements unit-test for the spinel command/property dispatch of `NcpBase`.
+
+enum
+{
+    kFrameSize          = 1300,
+    kNumReplayRounds    = 20000,
+    kUnsupportedPropKey = 0x3c00,  // Start of vendor property range (no vendor properties are implemented).
+    kUnsupportedCommand = 0x3c00,  // Start of vendor command range.
+    kMaxUnsolicitedKeys = 64,
+    kNumEventRounds     = 200,
+    kEventSettleTime    = 50,      // Simulated time (in ms) given to each event for the stack and NCP to settle.
+};
+
+// Counts the bytes an HDLC-lite framed NCP (e.g., `NcpUart`) would send on the host link.
+class HdlcLengthCounter : public Hdlc::Encoder::BufferWriteIterator
+{
+public:
+    uint16_t Count(const uint8_t *aFrame, uint16_t aLength)
+    {
+        Hdlc::Encoder encoder;
+
+        mWritePointer = mBuffer;
+        mRemainingLength = sizeof(mBuffer);
+
+        SuccessOrQuit(encoder.Init(*this), "Encoder::Init() failed");
+        SuccessOrQuit(encoder.Encode(aFrame, aLength, *this), "Encoder::Encode() failed");
+        SuccessOrQuit(encoder.Finalize(*this), "Encoder::Finalize() failed");
+
+        return static_cast<uint16_t>(mWritePointer - mBuffer);
+    }
+
+private:
+    uint8_t mBuffer[2 * kFrameSize + 8];
+};
+
+class TestNcp : public NcpBase
+{
+public:
+    TestNcp(otInstance *aInstance)
+        : NcpBase(aInstance)
+        , mResponseLength(0)
+        , mNumResponses(0)
+        , mTid(0)
+    {
+        ClearUnsolicited();
+    }
+
+    void ClearUnsolicited(void)
+    {
+        mNumUnsolicited = 0;
+        mNumUnsolicitedBatched = 0;
+        mUnsolicitedBytes = 0;
+        mUnsolicitedLinkBytes = 0;
+        mNumUnsolicitedKeys = 0;
+        mLastReportedRole = 0xff;
+        mLastReportedStatus = SPINEL_STATUS_OK;
+    }
+
+    bool DidReportProperty(spinel_prop_key_t aKey) const
+    {
+        bool found = false;
+
+        for (uint16_t i = 0; i < mNumUnsolicitedKeys; i++)
+        {
+            if (mUnsolicitedKeys[i] == aKey)
+            {
+                found = true;
+                break;
+            }
+        }
+
+        return found;
+    }
+
+    uint32_t mNumUnsolicited;         // Number of unsolicited frames.
+    uint32_t mNumUnsolicitedBatched;  // Number of unsolicited `SPINEL_CMD_PROP_VALUES_ARE` frames.
+    uint32_t mUnsolicitedBytes;       // Spinel bytes in unsolicited frames.
+    uint32_t mUnsolicitedLinkBytes;   // HDLC-lite framed bytes in unsolicited frames.
+    spinel_prop_key_t mUnsolicitedKeys[kMaxUnsolicitedKeys];
+    uint16_t mNumUnsolicitedKeys;
+    uint8_t mLastReportedRole;
+    unsigned int mLastReportedStatus;
+
+    // Sends a spinel request (command followed by a property key and value) to the NCP, then reads the response.
+    void Request(unsigned int aCommand, spinel_prop_key_t aKey, const uint8_t *aValue, uint16_t aValueLength)
+    {
+        uint8_t frame[kFrameSize];
+        spinel_ssize_t length;
+
+        mTid = SPINEL_GET_NEXT_TID(mTid);
+
+        length = spinel_datatype_pack(frame, sizeof(frame), SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_DATA_S,
+                                      SPINEL_HEADER_FLAG | mTid, aCommand, aKey, aValue, aValueLength);
+        VerifyOrQuit(length > 0, "spinel_datatype_pack() failed");
+
+        HandleReceive(frame, static_cast<uint16_t>(length));
+        ReadResponses();
+    }
+
+    void RequestCommand(unsigned int aCommand)
+    {
+        uint8_t frame[kFrameSize];
+        spinel_ssize_t length;
+
+        mTid = SPINEL_GET_NEXT_TID(mTid);
+
+        length = spinel_datatype_pack(frame, sizeof(frame), SPINEL_DATATYPE_COMMAND_S, SPINEL_HEADER_FLAG | mTid,
+                                      aCommand);
+        VerifyOrQuit(length > 0, "spinel_datatype_pack() failed");
+
+        HandleReceive(frame, static_cast<uint16_t>(length));
+        ReadResponses();
+    }
+
+    // Reads and removes all frames sent by the NCP, keeping the response to the last request (unsolicited frames
+    // such as property change notifications use `tid` zero).
+    void ReadResponses(void)
+    {
+        uint8_t frame[kFrameSize];
+        uint16_t length;
+
+        mNumResponses = 0;
+
+        while (!mTxFrameBuffer.IsEmpty())
+        {
+            SuccessOrQuit(mTxFrameBuffer.OutFrameBegin(), "OutFrameBegin() failed");
+            length = mTxFrameBuffer.OutFrameRead(sizeof(frame), frame);
+            SuccessOrQuit(mTxFrameBuffer.OutFrameRemove(), "OutFrameRemove() failed");
+
+            if (length > 0 && SPINEL_HEADER_GET_TID(frame[0]) == mTid)
+            {
+                memcpy(mResponse, frame, length);
+                mResponseLength = length;
+                mNumResponses++;
+            }
+            else if (length > 0 && SPINEL_HEADER_GET_TID(frame[0]) == 0)
+            {
+                ParseUnsolicited(frame, length);
+            }
+        }
+    }
+
+    // Parses an unsolicited frame, either a single `SPINEL_CMD_PROP_VALUE_IS` or a batched
+    // `SPINEL_CMD_PROP_VALUES_ARE` (a list of length-prefixed property/value pairs).
+    void ParseUnsolicited(const uint8_t *aFrame, uint16_t aLength)
+    {
+        uint8_t header;
+        unsigned int command;
+        spinel_ssize_t parsedLength;
+        const uint8_t *pair;
+        unsigned int pairLength;
+
+        mNumUnsolicited++;
+        mUnsolicitedBytes += aLength;
+        mUnsolicitedLinkBytes += mHdlcLengthCounter.Count(aFrame, aLength);
+
+        parsedLength = spinel_datatype_unpack(aFrame, aLength, SPINEL_DATATYPE_COMMAND_S, &header, &command);
+        VerifyOrQuit(parsedLength > 0, "Could not parse unsolicited frame");
+        aFrame += parsedLength;
+        aLength -= static_cast<uint16_t>(parsedLength);
+
+        if (command == SPINEL_CMD_PROP_VALUES_ARE)
+        {
+            mNumUnsolicitedBatched++;
+
+            VerifyOrQuit(aLength > 0, "Batched frame is empty");
+
+            while (aLength > 0)
+            {
+                parsedLength = spinel_datatype_unpack(aFrame, aLength, SPINEL_DATATYPE_DATA_WLEN_S, &pair, &pairLength);
+                VerifyOrQuit(parsedLength > 0, "Could not parse property/value pair");
+                aFrame += parsedLength;
+                aLength -= static_cast<uint16_t>(parsedLength);
+
+                ParsePropertyValue(pair, static_cast<uint16_t>(pairLength));
+            }
+        }
+        else
+        {
+            VerifyOrQuit(command == SPINEL_CMD_PROP_VALUE_IS, "Unexpected unsolicited command");
+            ParsePropertyValue(aFrame, aLength);
+        }
+    }
+
+    void ParsePropertyValue(const uint8_t *aData, uint16_t aLength)
+    {
+        unsigned int key;
+        spinel_ssize_t parsedLength;
+
+        parsedLength = spinel_datatype_unpack(aData, aLength, SPINEL_DATATYPE_UINT_PACKED_S, &key);
+        VerifyOrQuit(parsedLength > 0, "Could not parse property key");
+
+        if (key == SPINEL_PROP_NET_ROLE)
+        {
+            VerifyOrQuit(aLength == parsedLength + 1, "NET_ROLE value length is incorrect");
+            mLastReportedRole = aData[parsedLength];
+        }
+        else if (key == SPINEL_PROP_LAST_STATUS)
+        {
+            VerifyOrQuit(spinel_datatype_unpack(aData + parsedLength, aLength - static_cast<uint16_t>(parsedLength),
+                                                SPINEL_DATATYPE_UINT_PACKED_S, &mLastReportedStatus) > 0,
+                         "Could not parse LAST_STATUS value");
+        }
+
+        if (mNumUnsolicitedKeys < kMaxUnsolicitedKeys)
+        {
+            mUnsolicitedKeys[mNumUnsolicitedKeys++] = static_cast<spinel_prop_key_t>(key);
+        }
+    }
+
+    // Fills the NCP tx buffer with `SPINEL_PROP_PHY_CHAN` frames, then removes enough of them to leave about
+    // `aFreeLength` bytes free. The filler frames use a `tid` which is neither zero nor the one of the next request,
+    // so `ReadResponses()` skips them.
+    void FillTxBuffer(uint16_t aFreeLength)
+    {
+        const spinel_tid_t fillerTid = SPINEL_GET_NEXT_TID(SPINEL_GET_NEXT_TID(mTid));
+        const uint8_t fillerFrame[] =
+        {
+            static_cast<uint8_t>(SPINEL_HEADER_FLAG | SPINEL_HEADER_IID_0 | fillerTid),
+            SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_PHY_CHAN, 11,
+        };
+        enum
+        {
+            kFillerFrameSize = sizeof(fillerFrame) + 2,  // Including the segment header.
+        };
+
+        VerifyOrQuit(mTxFrameBuffer.IsEmpty(), "NCP tx buffer is not empty");
+
+        while (true)
+        {
+            SuccessOrQuit(mTxFrameBuffer.InFrameBegin(), "InFrameBegin() failed");
+            VerifyOrExit(mTxFrameBuffer.InFrameFeedData(fillerFrame, sizeof(fillerFrame)) == OT_ERROR_NONE);
+            VerifyOrExit(mTxFrameBuffer.InFrameEnd() == OT_ERROR_NONE);
+        }
+
+exit:
+
+        for (uint16_t freeLength = 0; freeLength < aFreeLength; freeLength += kFillerFrameSize)
+        {
+            SuccessOrQuit(mTxFrameBuffer.OutFrameBegin(), "OutFrameBegin() failed");
+            SuccessOrQuit(mTxFrameBuffer.OutFrameRemove(), "OutFrameRemove() failed");
+        }
+    }
+
+    // Verifies that the response is for the current `tid` with the given command and property key, and returns the
+    // property value.
+    const uint8_t *VerifyResponse(unsigned int aCommand, spinel_prop_key_t aKey, uint16_t &aValueLength)
+    {
+        uint8_t header;
+        unsigned int command;
+        unsigned int key;
+        const uint8_t *value;
+        unsigned int valueLength;
+
+        VerifyOrQuit(mNumResponses == 1, "NCP did not respond");
+        VerifyOrQuit(spinel_datatype_unpack(mResponse, mResponseLength,
+                                            SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_DATA_S,
+                                            &header, &command, &key, &value, &valueLength) > 0,
+                     "Could not parse the response");
+        VerifyOrQuit(SPINEL_HEADER_GET_TID(header) == mTid, "Response tid does not match");
+        VerifyOrQuit(command == aCommand, "Response command does not match");
+        VerifyOrQuit(key == aKey, "Response property does not match");
+
+        aValueLength = static_cast<uint16_t>(valueLength);
+        return value;
+    }
+
+    void VerifyLastStatus(spinel_status_t aStatus)
+    {
+        uint16_t valueLength;
+        const uint8_t *value = VerifyResponse(SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_LAST_STATUS, valueLength);
+        unsigned int status;
+
+        VerifyOrQuit(spinel_datatype_unpack(value, valueLength, SPINEL_DATATYPE_UINT_PACKED_S, &status) > 0,
+                     "Could not parse the status");
+        VerifyOrQuit(status == static_cast<unsigned int>(aStatus), "Status does not match");
+    }
+
+private:
+    HdlcLengthCounter mHdlcLengthCounter;
+    uint8_t mResponse[kFrameSize];
+    uint16_t mResponseLength;
+    uint16_t mNumResponses;
+    spinel_tid_t mTid;
+};
+
+// Properties polled by a host (e.g., state and counters), used for replaying host requests.
+static const spinel_prop_key_t sPolledProperties[] =
+{
+    SPINEL_PROP_PROTOCOL_VERSION,
+    SPINEL_PROP_NCP_VERSION,
+    SPINEL_PROP_INTERFACE_TYPE,
+    SPINEL_PROP_CAPS,
+    SPINEL_PROP_HWADDR,
+    SPINEL_PROP_NET_IF_UP,
+    SPINEL_PROP_NET_STACK_UP,
+    SPINEL_PROP_NET_ROLE,
+    SPINEL_PROP_NET_NETWORK_NAME,
+    SPINEL_PROP_NET_PARTITION_ID,
+    SPINEL_PROP_PHY_CHAN,
+    SPINEL_PROP_MAC_15_4_PANID,
+    SPINEL_PROP_MAC_EXTENDED_ADDR,
+    SPINEL_PROP_THREAD_RLOC16,
+    SPINEL_PROP_THREAD_LEADER_RID,
+    SPINEL_PROP_THREAD_NETWORK_DATA_VERSION,
+    SPINEL_PROP_THREAD_CHILD_TIMEOUT,
+    SPINEL_PROP_IPV6_ML_ADDR,
+    SPINEL_PROP_IPV6_ADDRESS_TABLE,
+    SPINEL_PROP_CNTR_TX_PKT_TOTAL,
+    SPINEL_PROP_CNTR_RX_PKT_TOTAL,
+    SPINEL_PROP_CNTR_TX_ERR_CCA,
+    SPINEL_PROP_CNTR_RX_ERR_SECURITY,
+    SPINEL_PROP_CNTR_TX_IP_SEC_TOTAL,
+    SPINEL_PROP_CNTR_RX_SPINEL_ERR,
+    SPINEL_PROP_MSG_BUFFER_COUNTERS,
+    SPINEL_PROP_THREAD_DISCOVERY_SCAN_PANID,
+    SPINEL_PROP_DEBUG_NCP_LOG_LEVEL,
+};
+
+static otInstance *sInstance;
+static otDEFINE_ALIGNED_VAR(sNcpRaw, sizeof(TestNcp), uint64_t);
+static uint32_t sNow;
+static otRadioFrame sRadioTxFrame;
+static uint8_t sRadioTxPsdu[OT_RADIO_FRAME_MAX_SIZE];
+static bool sRadioTxPending;
+
+static uint32_t TestNcpAlarmGetNow(void)
+{
+    return sNow;
+}
+
+static otError TestNcpRadioTransmit(otInstance *)
+{
+    sRadioTxPending = true;
+    return OT_ERROR_NONE;
+}
+
+static otRadioFrame *TestNcpRadioGetTransmitBuffer(otInstance *)
+{
+    return &sRadioTxFrame;
+}
+
+TestNcp &InitTestNcp(void)
+{
+    if (sInstance == NULL)
+    {
+        g_testPlatAlarmGetNow = TestNcpAlarmGetNow;
+        sRadioTxFrame.mPsdu = sRadioTxPsdu;
+        g_testPlatRadioTransmit = TestNcpRadioTransmit;
+        g_testPlatRadioGetTransmitBuffer = TestNcpRadioGetTransmitBuffer;
+        sInstance = new otInstance;
+        new(&sNcpRaw) TestNcp(sInstance);
+    }
+
+    return *reinterpret_cast<TestNcp *>(&sNcpRaw);
+}
+
+// Runs the tasklets and timers for the given (simulated) time, reading all the frames sent by the NCP (unless
+// `aReadResponses` is false, e.g., to keep its tx buffer full). Radio transmissions complete right away (there are
+// no other nodes).
+static void RunFor(TestNcp &aNcp, uint32_t aDuration, bool aReadResponses = true)
+{
+    uint32_t end = sNow + aDuration;
+
+    while (true)
+    {
+        otTaskletsProcess(sInstance);
+
+        if (sRadioTxPending)
+        {
+            sRadioTxPending = false;
+            otPlatRadioTxDone(sInstance, &sRadioTxFrame, NULL, OT_ERROR_NONE);
+        }
+
+        if (g_testPlatAlarmSet && static_cast<int32_t>(sNow - g_testPlatAlarmNext) >= 0)
+        {
+            g_testPlatAlarmSet = false;
+            otPlatAlarmFired(sInstance);
+            otTaskletsProcess(sInstance);
+        }
+
+        if (aReadResponses)
+        {
+            aNcp.ReadResponses();
+        }
+
+        if (sNow == end)
+        {
+            break;
+        }
+
+        sNow++;
+    }
+}
+
+static void SetUnsolUpdateBatching(TestNcp &aNcp, bool aEnabled)
+{
+    uint8_t value = aEnabled ? 1 : 0;
+    uint16_t valueLength;
+    const uint8_t *response;
+
+    aNcp.Request(SPINEL_CMD_PROP_VALUE_SET, SPINEL_PROP_UNSOL_UPDATE_BATCHING, &value, sizeof(value));
+    response = aNcp.VerifyResponse(SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_UNSOL_UPDATE_BATCHING, valueLength);
+    VerifyOrQuit(valueLength == 1 && response[0] == value, "SET UNSOL_UPDATE_BATCHING failed");
+}
+
+void TestNcpDispatch(void)
+{
+    TestNcp &ncp = InitTestNcp();
+    const uint8_t *value;
+    uint16_t valueLength;
+    uint8_t channel;
+    uint8_t extAddr[OT_EXT_ADDRESS_SIZE];
+
+    // `NcpBase` constructor asserts that the handler tables are sorted, so reaching here means they are.
+
+    ncp.RequestCommand(SPINEL_CMD_NOOP);
+    ncp.VerifyLastStatus(SPINEL_STATUS_OK);
+
+    ncp.RequestCommand(kUnsupportedCommand);
+    ncp.VerifyLastStatus(SPINEL_STATUS_INVALID_COMMAND);
+
+    for (unsigned i = 0; i < sizeof(sPolledProperties) / sizeof(sPolledProperties[0]); i++)
+    {
+        ncp.Request(SPINEL_CMD_PROP_VALUE_GET, sPolledProperties[i], NULL, 0);
+        ncp.VerifyResponse(SPINEL_CMD_PROP_VALUE_IS, sPolledProperties[i], valueLength);
+    }
+
+    // First and last entries of the tables.
+
+    ncp.Request(SPINEL_CMD_PROP_VALUE_GET, SPINEL_PROP_LAST_STATUS, NULL, 0);
+    ncp.VerifyResponse(SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_LAST_STATUS, valueLength);
+
+    channel = 15;
+    ncp.Request(SPINEL_CMD_PROP_VALUE_SET, SPINEL_PROP_PHY_CHAN, &channel, sizeof(channel));
+    value = ncp.VerifyResponse(SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_PHY_CHAN, valueLength);
+    VerifyOrQuit(valueLength == 1 && value[0] == channel, "SET PHY_CHAN failed");
+
+    ncp.Request(SPINEL_CMD_PROP_VALUE_SET, SPINEL_PROP_POWER_STATE, NULL, 0);
+    VerifyOrQuit(ncp.VerifyResponse(SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_LAST_STATUS, valueLength) != NULL,
+                 "SET POWER_STATE failed");
+
+    memset(extAddr, 0x5a, sizeof(extAddr));
+    ncp.Request(SPINEL_CMD_PROP_VALUE_INSERT, SPINEL_PROP_MAC_WHITELIST, extAddr, sizeof(extAddr));
+    ncp.VerifyResponse(SPINEL_CMD_PROP_VALUE_INSERTED, SPINEL_PROP_MAC_WHITELIST, valueLength);
+
+    ncp.Request(SPINEL_CMD_PROP_VALUE_REMOVE, SPINEL_PROP_MAC_WHITELIST, extAddr, sizeof(extAddr));
+    ncp.VerifyResponse(SPINEL_CMD_PROP_VALUE_REMOVED, SPINEL_PROP_MAC_WHITELIST, valueLength);
+
+    // Properties which are not in the tables.
+
+    ncp.Request(SPINEL_CMD_PROP_VALUE_GET, static_cast<spinel_prop_key_t>(kUnsupportedPropKey), NULL, 0);
+    ncp.VerifyLastStatus(SPINEL_STATUS_PROP_NOT_FOUND);
+
+    ncp.Request(SPINEL_CMD_PROP_VALUE_SET, SPINEL_PROP_PROTOCOL_VERSION, NULL, 0);
+    ncp.VerifyLastStatus(SPINEL_STATUS_PROP_NOT_FOUND);
+
+    ncp.Request(SPINEL_CMD_PROP_VALUE_INSERT, SPINEL_PROP_PHY_CHAN, &channel, sizeof(channel));
+    ncp.VerifyLastStatus(SPINEL_STATUS_PROP_NOT_FOUND);
+
+    ncp.Request(SPINEL_CMD_PROP_VALUE_REMOVE, SPINEL_PROP_LAST_STATUS, NULL, 0);
+    ncp.VerifyLastStatus(SPINEL_STATUS_PROP_NOT_FOUND);
+
+    printf("TestNcpDispatch passed\n");
+}
+
+// This replays host requests polling the NCP state and counters, and measures the per-command latency (request
+// parsing, dispatch, handler and response framing).
+void TestNcpDispatchBenchmark(void)
+{
+    TestNcp &ncp = InitTestNcp();
+    const unsigned numProperties = sizeof(sPolledProperties) / sizeof(sPolledProperties[0]);
+    uint64_t start;
+    uint64_t elapsed;
+
+    start = testPlatGetMicroseconds();
+
+    for (unsigned round = 0; round < kNumReplayRounds; round++)
+    {
+        for (unsigned i = 0; i < numProperties; i++)
+        {
+            ncp.Request(SPINEL_CMD_PROP_VALUE_GET, sPolledProperties[i], NULL, 0);
+        }
+    }
+
+    elapsed = testPlatGetMicroseconds() - start;
+
+    printf("NcpDispatchBenchmark: %u GET requests, %.1f ns per command\n", kNumReplayRounds * numProperties,
+           elapsed * 1000.0 / (kNumReplayRounds * numProperties));
+
+    start = testPlatGetMicroseconds();
+
+    for (unsigned round = 0; round < kNumReplayRounds; round++)
+    {
+        for (unsigned i = 0; i < numProperties; i++)
+        {
+            ncp.Request(SPINEL_CMD_PROP_VALUE_GET, static_cast<spinel_prop_key_t>(kUnsupportedPropKey + i), NULL, 0);
+        }
+    }
+
+    elapsed = testPlatGetMicroseconds() - start;
+
+    printf("NcpDispatchBenchmark: %u GET requests for unsupported properties, %.1f ns per command\n",
+           kNumReplayRounds * numProperties, elapsed * 1000.0 / (kNumReplayRounds * numProperties));
+}
+
+void TestNcpUnsolUpdateBatching(void)
+{
+    TestNcp &ncp = InitTestNcp();
+    const uint8_t *value;
+    uint16_t valueLength;
+    bool hasCapability = false;
+    unsigned int capability;
+    spinel_ssize_t parsedLength;
+    otNetifAddress address;
+
+    RunFor(ncp, kEventSettleTime);
+
+    // The capability is advertised, and batching is disabled until the host enables it.
+
+    ncp.Request(SPINEL_CMD_PROP_VALUE_GET, SPINEL_PROP_CAPS, NULL, 0);
+    value = ncp.VerifyResponse(SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_CAPS, valueLength);
+
+    while (valueLength > 0)
+    {
+        parsedLength = spinel_datatype_unpack(value, valueLength, SPINEL_DATATYPE_UINT_PACKED_S, &capability);
+        VerifyOrQuit(parsedLength > 0, "Could not parse CAPS");
+        hasCapability |= (capability == SPINEL_CAP_UNSOL_UPDATE_BATCHING);
+        value += parsedLength;
+        valueLength -= static_cast<uint16_t>(parsedLength);
+    }
+
+    VerifyOrQuit(hasCapability, "CAP_UNSOL_UPDATE_BATCHING is not advertised");
+
+    ncp.Request(SPINEL_CMD_PROP_VALUE_GET, SPINEL_PROP_UNSOL_UPDATE_BATCHING, NULL, 0);
+    value = ncp.VerifyResponse(SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_UNSOL_UPDATE_BATCHING, valueLength);
+    VerifyOrQuit(valueLength == 1 && value[0] == 0, "Batching is enabled by default");
+
+    // Without batching, each changed property is sent in its own frame.
+
+    SuccessOrQuit(otLinkSetPanId(sInstance, 0xface), "otLinkSetPanId() failed");
+
+    ncp.ClearUnsolicited();
+    SuccessOrQuit(otIp6SetEnabled(sInstance, true), "otIp6SetEnabled() failed");
+    SuccessOrQuit(otThreadSetEnabled(sInstance, true), "otThreadSetEnabled() failed");
+    SuccessOrQuit(otThreadBecomeLeader(sInstance), "otThreadBecomeLeader() failed");
+    RunFor(ncp, kEventSettleTime);
+
+    VerifyOrQuit(ncp.mNumUnsolicited > 1, "Expected one frame per changed property");
+    VerifyOrQuit(ncp.mNumUnsolicited == ncp.mNumUnsolicitedKeys, "Expected one frame per changed property");
+    VerifyOrQuit(ncp.mNumUnsolicitedBatched == 0, "Batched frame sent before the host enabled batching");
+    VerifyOrQuit(ncp.DidReportProperty(SPINEL_PROP_NET_ROLE), "NET_ROLE change was not reported");
+    VerifyOrQuit(ncp.mLastReportedRole == SPINEL_NET_ROLE_LEADER, "Reported NET_ROLE is incorrect");
+
+    SuccessOrQuit(otThreadSetEnabled(sInstance, false), "otThreadSetEnabled() failed");
+    RunFor(ncp, kEventSettleTime);
+
+    // With batching, changes within the coalescing window are sent together in one frame.
+
+    SetUnsolUpdateBatching(ncp, true);
+
+    ncp.ClearUnsolicited();
+    SuccessOrQuit(otThreadSetEnabled(sInstance, true), "otThreadSetEnabled() failed");
+    SuccessOrQuit(otThreadBecomeLeader(sInstance), "otThreadBecomeLeader() failed");
+    RunFor(ncp, OPENTHREAD_CONFIG_NCP_UNSOL_UPDATE_COALESCING_WINDOW - 1);
+    VerifyOrQuit(ncp.mNumUnsolicited == 0, "Changes were sent before the end of the coalescing window");
+
+    RunFor(ncp, 1);
+    VerifyOrQuit(ncp.mNumUnsolicited == 1, "Changes were not sent in a single frame");
+    VerifyOrQuit(ncp.mNumUnsolicitedBatched == 1, "Changes were not sent in a batched frame");
+    VerifyOrQuit(ncp.mNumUnsolicitedKeys > 1, "Batched frame contains a single property");
+    VerifyOrQuit(ncp.DidReportProperty(SPINEL_PROP_NET_ROLE), "NET_ROLE change was not reported");
+    VerifyOrQuit(ncp.DidReportProperty(SPINEL_PROP_NET_PARTITION_ID), "NET_PARTITION_ID change was not reported");
+    VerifyOrQuit(ncp.mLastReportedRole == SPINEL_NET_ROLE_LEADER, "Reported NET_ROLE is incorrect");
+
+    RunFor(ncp, kEventSettleTime);
+
+    memset(&address, 0, sizeof(address));
+    address.mAddress.mFields.m8[0] = 0xfd;
+    address.mAddress.mFields.m8[15] = 0x01;
+    address.mPrefixLength = 64;
+    address.mPreferred = true;
+    address.mValid = true;
+
+    ncp.ClearUnsolicited();
+    SuccessOrQuit(otIp6AddUnicastAddress(sInstance, &address), "otIp6AddUnicastAddress() failed");
+    RunFor(ncp, kEventSettleTime);
+    VerifyOrQuit(ncp.mNumUnsolicited == 1 && ncp.mNumUnsolicitedBatched == 1, "Change was not sent batched");
+    VerifyOrQuit(ncp.DidReportProperty(SPINEL_PROP_IPV6_ADDRESS_TABLE), "Address table change was not reported");
+
+    // Disabling batching goes back to one frame per property.
+
+    SetUnsolUpdateBatching(ncp, false);
+
+    ncp.ClearUnsolicited();
+    SuccessOrQuit(otIp6RemoveUnicastAddress(sInstance, &address.mAddress), "otIp6RemoveUnicastAddress() failed");
+    RunFor(ncp, kEventSettleTime);
+    VerifyOrQuit(ncp.mNumUnsolicited == 1 && ncp.mNumUnsolicitedBatched == 0, "Change was not sent unbatched");
+    VerifyOrQuit(ncp.DidReportProperty(SPINEL_PROP_IPV6_ADDRESS_TABLE), "Address table change was not reported");
+
+    // A reset disables batching.
+
+    SetUnsolUpdateBatching(ncp, true);
+
+    ncp.RequestCommand(SPINEL_CMD_RESET);
+    RunFor(ncp, kEventSettleTime);
+
+    ncp.Request(SPINEL_CMD_PROP_VALUE_GET, SPINEL_PROP_UNSOL_UPDATE_BATCHING, NULL, 0);
+    value = ncp.VerifyResponse(SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_UNSOL_UPDATE_BATCHING, valueLength);
+    VerifyOrQuit(valueLength == 1 && value[0] == 0, "Batching is still enabled after reset");
+
+    printf("TestNcpUnsolUpdateBatching passed\n");
+}
+
+// This verifies that the changes reported when a device required to join an existing network forms its own
+// partition instead (the NCP disables the stack and reports `SPINEL_STATUS_JOIN_FAILURE`) are all delivered when
+// they do not fit in the tx buffer.
+void TestNcpUnsolUpdateBatchingJoinFailure(void)
+{
+    TestNcp &ncp = InitTestNcp();
+    const uint8_t *value;
+    uint16_t valueLength;
+    uint8_t requireJoinExisting = 1;
+
+    SetUnsolUpdateBatching(ncp, true);
+
+    SuccessOrQuit(otIp6SetEnabled(sInstance, true), "otIp6SetEnabled() failed");
+    SuccessOrQuit(otThreadSetEnabled(sInstance, true), "otThreadSetEnabled() failed");
+    RunFor(ncp, kEventSettleTime);
+
+    ncp.Request(SPINEL_CMD_PROP_VALUE_SET, SPINEL_PROP_NET_REQUIRE_JOIN_EXISTING, &requireJoinExisting,
+                sizeof(requireJoinExisting));
+    value = ncp.VerifyResponse(SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_NET_REQUIRE_JOIN_EXISTING, valueLength);
+    VerifyOrQuit(valueLength == 1 && value[0] == 1, "SET NET_REQUIRE_JOIN_EXISTING failed");
+
+    // Leave room for the join failure status, but not for all the changes of becoming leader (e.g., address table).
+
+    ncp.FillTxBuffer(48);
+
+    ncp.ClearUnsolicited();
+    SuccessOrQuit(otThreadBecomeLeader(sInstance), "otThreadBecomeLeader() failed");
+    RunFor(ncp, OPENTHREAD_CONFIG_NCP_UNSOL_UPDATE_COALESCING_WINDOW + 1, false);
+    VerifyOrQuit(otThreadGetDeviceRole(sInstance) == OT_DEVICE_ROLE_DISABLED, "Stack was not disabled");
+
+    RunFor(ncp, kEventSettleTime);
+    VerifyOrQuit(ncp.mLastReportedStatus == SPINEL_STATUS_JOIN_FAILURE, "JOIN_FAILURE was not reported");
+    VerifyOrQuit(ncp.DidReportProperty(SPINEL_PROP_NET_STACK_UP), "NET_STACK_UP change was not reported");
+    VerifyOrQuit(ncp.DidReportProperty(SPINEL_PROP_NET_REQUIRE_JOIN_EXISTING),
+                 "NET_REQUIRE_JOIN_EXISTING change was not reported");
+    VerifyOrQuit(ncp.DidReportProperty(SPINEL_PROP_NET_ROLE), "NET_ROLE change was not reported");
+
+    SuccessOrQuit(otIp6SetEnabled(sInstance, false), "otIp6SetEnabled() failed");
+    RunFor(ncp, kEventSettleTime);
+    SetUnsolUpdateBatching(ncp, false);
+
+    printf("TestNcpUnsolUpdateBatchingJoinFailure passed\n");
+}
+
+// This replays a scripted sequence of network events (attach, becoming leader, address and network data changes,
+// detach) and reports the unsolicited frames and host link bytes they generate, without and with batching.
+void TestNcpUnsolUpdateBatchingBenchmark(void)
+{
+    TestNcp &ncp = InitTestNcp();
+    otNetifAddress address;
+    otBorderRouterConfig prefixConfig;
+    unsigned numEvents;
+
+    memset(&address, 0, sizeof(address));
+    address.mAddress.mFields.m8[0] = 0xfd;
+    address.mAddress.mFields.m8[15] = 0x02;
+    address.mPrefixLength = 64;
+    address.mPreferred = true;
+    address.mValid = true;
+
+    memset(&prefixConfig, 0, sizeof(prefixConfig));
+    prefixConfig.mPrefix.mPrefix.mFields.m8[0] = 0xfd;
+    prefixConfig.mPrefix.mPrefix.mFields.m8[1] = 0x0e;
+    prefixConfig.mPrefix.mLength = 64;
+    prefixConfig.mOnMesh = true;
+    prefixConfig.mStable = true;
+
+    for (int batching = 0; batching < 2; batching++)
+    {
+        SetUnsolUpdateBatching(ncp, batching != 0);
+        otThreadSetEnabled(sInstance, false);
+        otIp6SetEnabled(sInstance, false);
+        RunFor(ncp, kEventSettleTime);
+
+        ncp.ClearUnsolicited();
+        numEvents = 0;
+
+        for (unsigned round = 0; round < kNumEventRounds; round++)
+        {
+            otIp6SetEnabled(sInstance, true);
+            otThreadSetEnabled(sInstance, true);
+            RunFor(ncp, kEventSettleTime);
+
+            otThreadBecomeLeader(sInstance);
+            RunFor(ncp, kEventSettleTime);
+
+            otIp6AddUnicastAddress(sInstance, &address);
+            RunFor(ncp, kEventSettleTime);
+
+            otNetDataAddPrefixInfo(sInstance, &prefixConfig);
+            otNetDataRegister(sInstance);
+            RunFor(ncp, kEventSettleTime);
+
+            otNetDataRemovePrefixInfo(sInstance, &prefixConfig.mPrefix);
+            otNetDataRegister(sInstance);
+            RunFor(ncp, kEventSettleTime);
+
+            otIp6RemoveUnicastAddress(sInstance, &address.mAddress);
+            RunFor(ncp, kEventSettleTime);
+
+            otThreadSetEnabled(sInstance, false);
+            otIp6SetEnabled(sInstance, false);
+            RunFor(ncp, kEventSettleTime);
+
+            numEvents += 7;
+        }
+
+        printf("UnsolUpdateBatchingBenchmark: %s, %u events, %.2f frames per event, %.1f spinel bytes and "
+               "%.1f link bytes per event\n", batching ? "batched" : "unbatched", numEvents,
+               static_cast<double>(ncp.mNumUnsolicited) / numEvents,
+               static_cast<double>(ncp.mUnsolicitedBytes) / numEvents,
+               static_cast<double>(ncp.mUnsolicitedLinkBytes) / numEvents);
+    }
+
+    SetUnsolUpdateBatching(ncp, false);
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestNcpDispatch();
+    ot::TestNcpDispatchBenchmark();
+    ot::TestNcpUnsolUpdateBatching();
+    ot::TestNcpUnsolUpdateBatchingJoinFailure();
+    ot::TestNcpUnsolUpdateBatchingBenchmark();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
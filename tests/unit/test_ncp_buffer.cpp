@@ -35,6 +35,7 @@
 #include "common/message.hpp"
 #include "ncp/ncp_buffer.hpp"
 
+#include "test_platform.h"
 #include "test_util.h"
 
 namespace ot {
@@ -182,6 +183,43 @@ void ReadAndVerifyContent(NcpFrameBuffer &aNcpBuffer, const uint8_t *aContentBuf
     }
 }
 
+// Reads bytes from the ncp buffer through spans (consuming at most `aMaxChunk` bytes of each span at a time), and
+// verifies that it matches with the given content buffer. Returns the number of spans that ended at the end of the
+// circular buffer `aBufferEnd` (i.e., at a wrap-around).
+uint16_t ReadAndVerifySpans(NcpFrameBuffer &aNcpBuffer, const uint8_t *aContentBuffer, uint16_t aBufferLength,
+                            uint16_t aMaxChunk, const uint8_t *aBufferEnd)
+{
+    uint16_t numWraps = 0;
+
+    while (aBufferLength > 0)
+    {
+        uint16_t spanLength;
+        const uint8_t *span = aNcpBuffer.OutFrameGetSpan(spanLength);
+
+        VerifyOrQuit(span != NULL && spanLength > 0, "Out frame ended before end of expected content.");
+
+        numWraps += (span + spanLength == aBufferEnd);
+
+        if (spanLength > aMaxChunk)
+        {
+            spanLength = aMaxChunk;
+        }
+
+        if (spanLength > aBufferLength)
+        {
+            spanLength = aBufferLength;
+        }
+
+        VerifyOrQuit(memcmp(span, aContentBuffer, spanLength) == 0, "Out frame span does not match expected content");
+        VerifyOrQuit(aNcpBuffer.OutFrameSkip(spanLength) == spanLength, "OutFrameSkip() failed");
+
+        aContentBuffer += spanLength;
+        aBufferLength -= spanLength;
+    }
+
+    return numWraps;
+}
+
 void WriteTestFrame1(NcpFrameBuffer &aNcpBuffer)
 {
     Message *message;
@@ -509,6 +547,83 @@ void TestNcpFrameBuffer(void)
 
     VerifyOrQuit(readOffset == sizeof(sMottoText), "Read len does not match expected length.");
     printf("\n -- PASS\n");
+
+    printf("\n- - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - - -");
+    printf("\nTest 7: OutFrameGetSpan() and OutFrameSkip() with wrap-around and messages\n");
+
+    {
+        enum
+        {
+            kSmallBufferSize = 150,
+            kMessageLength   = 600,
+        };
+
+        uint8_t smallBuffer[kSmallBufferSize];
+        NcpFrameBuffer smallNcpBuffer(smallBuffer, sizeof(smallBuffer));
+        uint8_t content[kMessageLength];
+        uint16_t numWraps = 0;
+        uint16_t spanLength;
+        const uint8_t *span;
+
+        for (i = 0; i < sizeof(content); i++)
+        {
+            content[i] = static_cast<uint8_t>(i * 7 + (i >> 8));
+        }
+
+        smallNcpBuffer.Clear();
+        VerifyOrQuit(smallNcpBuffer.OutFrameGetSpan(spanLength) == NULL && spanLength == 0,
+                     "OutFrameGetSpan() returned a span for an empty buffer.");
+
+        for (i = 0; i < 50; i++)
+        {
+            uint16_t dataLength = static_cast<uint16_t>(20 + (i * 13) % 50);
+
+            message = sMessagePool.New(Message::kTypeIp6, 0);
+            VerifyOrQuit(message != NULL, "Null Message");
+            SuccessOrQuit(message->SetLength(kMessageLength), "Could not set the length of message.");
+            message->Write(0, kMessageLength, content);
+
+            SuccessOrQuit(smallNcpBuffer.InFrameBegin(), "InFrameBegin() failed.");
+            SuccessOrQuit(smallNcpBuffer.InFrameFeedData(content, dataLength), "InFrameFeedData() failed.");
+            SuccessOrQuit(smallNcpBuffer.InFrameFeedMessage(message), "InFrameFeedMessage() failed.");
+            SuccessOrQuit(smallNcpBuffer.InFrameFeedData(content + dataLength, dataLength), "InFrameFeedData() failed.");
+            SuccessOrQuit(smallNcpBuffer.InFrameEnd(), "InFrameEnd() failed.");
+
+            SuccessOrQuit(smallNcpBuffer.OutFrameBegin(), "OutFrameBegin() failed.");
+            VerifyOrQuit(smallNcpBuffer.OutFrameGetLength() == kMessageLength + 2 * dataLength,
+                         "GetLength() is incorrect.");
+
+            numWraps += ReadAndVerifySpans(smallNcpBuffer, content, dataLength, 1 + i % 9, smallBuffer + kSmallBufferSize);
+
+            // Message content is returned directly from the message buffers (not copied into the frame buffer).
+            span = smallNcpBuffer.OutFrameGetSpan(spanLength);
+            VerifyOrQuit(span != NULL && spanLength > 0, "OutFrameGetSpan() failed for message.");
+            VerifyOrQuit(span < smallBuffer || span >= smallBuffer + kSmallBufferSize,
+                         "Message span is not from the message buffer.");
+            ReadAndVerifySpans(smallNcpBuffer, content, kMessageLength, 100 + i, NULL);
+            numWraps += ReadAndVerifySpans(smallNcpBuffer, content + dataLength, dataLength, 1000,
+                                           smallBuffer + kSmallBufferSize);
+
+            VerifyOrQuit(smallNcpBuffer.OutFrameHasEnded(), "Frame longer than expected.");
+            VerifyOrQuit(smallNcpBuffer.OutFrameGetSpan(spanLength) == NULL && spanLength == 0,
+                         "OutFrameGetSpan() returned a span after end of frame.");
+            VerifyOrQuit(smallNcpBuffer.OutFrameSkip(10) == 0, "OutFrameSkip() skipped past end of frame.");
+
+            // Restart the frame and skip past its end.
+            SuccessOrQuit(smallNcpBuffer.OutFrameBegin(), "OutFrameBegin() failed.");
+            VerifyOrQuit(smallNcpBuffer.OutFrameSkip(dataLength + 1) == dataLength + 1, "OutFrameSkip() failed.");
+            VerifyOrQuit(smallNcpBuffer.OutFrameReadByte() == content[1], "ReadByte() after OutFrameSkip() failed.");
+            VerifyOrQuit(smallNcpBuffer.OutFrameSkip(0xffff) == kMessageLength + dataLength - 2,
+                         "OutFrameSkip() did not stop at end of frame.");
+
+            SuccessOrQuit(smallNcpBuffer.OutFrameRemove(), "Remove() failed.");
+            VerifyOrQuit(smallNcpBuffer.IsEmpty(), "IsEmpty() is incorrect.");
+        }
+
+        VerifyOrQuit(numWraps > 0, "No span ended at the end of the buffer.");
+    }
+
+    printf(" -- PASS\n");
 }
 
 /**
@@ -587,8 +702,29 @@ otError ReadRandomFrame(uint32_t aLength, NcpFrameBuffer &aNcpBuffer)
     SuccessOrQuit(aNcpBuffer.OutFrameBegin(), "OutFrameBegin failed");
     VerifyOrQuit(aNcpBuffer.OutFrameGetLength() == aLength, "OutFrameGetLength() does not match");
 
-    // Read and verify that the content is same as sFrameBuffer values...
-    ReadAndVerifyContent(aNcpBuffer, sFrameBuffer, static_cast<uint16_t>(aLength));
+    // Read and verify that the content is same as sFrameBuffer values, alternating byte, span and bulk reads...
+    switch (GetRandom(3))
+    {
+    case 0:
+        ReadAndVerifyContent(aNcpBuffer, sFrameBuffer, static_cast<uint16_t>(aLength));
+        break;
+
+    case 1:
+        ReadAndVerifySpans(aNcpBuffer, sFrameBuffer, static_cast<uint16_t>(aLength),
+                           static_cast<uint16_t>(GetRandom(kMaxFrameLen) + 1), NULL);
+        break;
+
+    default:
+    {
+        uint8_t readBuffer[kMaxFrameLen];
+
+        VerifyOrQuit(aNcpBuffer.OutFrameRead(sizeof(readBuffer), readBuffer) == aLength, "OutFrameRead() failed");
+        VerifyOrQuit(memcmp(readBuffer, sFrameBuffer, aLength) == 0, "OutFrameRead() content does not match");
+        break;
+    }
+    }
+
+    VerifyOrQuit(aNcpBuffer.OutFrameHasEnded(), "Frame longer than expected.");
     sExpectedRemovedTag = aNcpBuffer.OutFrameGetTag();
 
     SuccessOrQuit(aNcpBuffer.OutFrameRemove(), "OutFrameRemove failed");
@@ -684,6 +820,96 @@ void TestFuzzNcpFrameBuffer(void)
     printf("\n -- PASS\n");
 }
 
+// This measures the host-bound read throughput of frames made of a data segment and a message.
+void TestNcpFrameBufferBenchmark(void)
+{
+    enum
+    {
+        kFrameDataLength = 100,
+        kMessageLength   = 1180,
+        kNumFrames       = 5000,
+    };
+
+    uint8_t buffer[kTestBufferSize];
+    NcpFrameBuffer ncpBuffer(buffer, sizeof(buffer));
+    uint8_t content[kMessageLength];
+    uint8_t readBuffer[kFrameDataLength + kMessageLength];
+    uint64_t elapsed[3] = { 0, 0, 0 };
+    uint32_t checksum[3] = { 0, 0, 0 };
+
+    for (uint16_t i = 0; i < sizeof(content); i++)
+    {
+        content[i] = static_cast<uint8_t>(i);
+    }
+
+    ncpBuffer.SetFrameAddedCallback(NULL, NULL);
+    ncpBuffer.SetFrameRemovedCallback(NULL, NULL);
+
+    for (uint32_t n = 0; n < kNumFrames; n++)
+    {
+        for (int method = 0; method < 3; method++)
+        {
+            Message *message = sMessagePool.New(Message::kTypeIp6, 0);
+            uint64_t start;
+
+            VerifyOrQuit(message != NULL, "Null Message");
+            SuccessOrQuit(message->SetLength(kMessageLength), "Could not set the length of message.");
+            message->Write(0, kMessageLength, content);
+
+            SuccessOrQuit(ncpBuffer.InFrameBegin(), "InFrameBegin() failed.");
+            SuccessOrQuit(ncpBuffer.InFrameFeedData(content, kFrameDataLength), "InFrameFeedData() failed.");
+            SuccessOrQuit(ncpBuffer.InFrameFeedMessage(message), "InFrameFeedMessage() failed.");
+            SuccessOrQuit(ncpBuffer.InFrameEnd(), "InFrameEnd() failed.");
+
+            start = testPlatGetMicroseconds();
+            SuccessOrQuit(ncpBuffer.OutFrameBegin(), "OutFrameBegin() failed.");
+
+            switch (method)
+            {
+            case 0:
+                while (!ncpBuffer.OutFrameHasEnded())
+                {
+                    checksum[method] += ncpBuffer.OutFrameReadByte();
+                }
+
+                break;
+
+            case 1:
+                ncpBuffer.OutFrameRead(sizeof(readBuffer), readBuffer);
+                checksum[method] += readBuffer[sizeof(readBuffer) - 1];
+                break;
+
+            case 2:
+            {
+                uint16_t spanLength;
+                const uint8_t *span;
+
+                while ((span = ncpBuffer.OutFrameGetSpan(spanLength)) != NULL)
+                {
+                    checksum[method] += span[spanLength - 1];
+                    ncpBuffer.OutFrameSkip(spanLength);
+                }
+
+                break;
+            }
+            }
+
+            elapsed[method] += testPlatGetMicroseconds() - start;
+
+            SuccessOrQuit(ncpBuffer.OutFrameRemove(), "Remove() failed.");
+        }
+    }
+
+    VerifyOrQuit(checksum[0] != 0 && checksum[1] != 0 && checksum[2] != 0, "Nothing was read.");
+
+    printf("NcpFrameBufferBenchmark: OutFrameReadByte()       %8.1f MB/s\n",
+           static_cast<double>(sizeof(readBuffer)) * kNumFrames / elapsed[0]);
+    printf("NcpFrameBufferBenchmark: OutFrameRead()           %8.1f MB/s\n",
+           static_cast<double>(sizeof(readBuffer)) * kNumFrames / elapsed[1]);
+    printf("NcpFrameBufferBenchmark: OutFrameGetSpan()        %8.1f MB/s\n",
+           static_cast<double>(sizeof(readBuffer)) * kNumFrames / elapsed[2]);
+}
+
 }  // namespace ot
 
 #ifdef ENABLE_TEST_MAIN
@@ -691,6 +917,7 @@ int main(void)
 {
     ot::TestNcpFrameBuffer();
     ot::TestFuzzNcpFrameBuffer();
+    ot::TestNcpFrameBufferBenchmark();
     printf("\nAll tests passed.\n");
     return 0;
 }
@@ -0,0 +1,221 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_platform.h"
+
+#include "utils/wrap_string.h"
+
+#include <openthread/openthread.h>
+
+#include "openthread-instance.h"
+#include "common/encoding.hpp"
+#include "net/ip6.hpp"
+#include "net/netif.hpp"
+
+#include "test_util.h"
+
+using ot::Encoding::BigEndian::HostSwap16;
+
+namespace ot {
+
+enum
+{
+    kNumGroups = 64,
+};
+
+static void InitGroup(Ip6::Address &aAddress, uint16_t aGroupId)
+{
+    // Admin-local groups that only differ in their low-order group ID bits.
+    memset(&aAddress, 0, sizeof(aAddress));
+    aAddress.mFields.m16[0] = HostSwap16(0xff04);
+    aAddress.mFields.m16[6] = HostSwap16(0x0001);
+    aAddress.mFields.m16[7] = HostSwap16(aGroupId);
+}
+
+void TestNetifMulticastSubscription(void)
+{
+    otInstance *instance;
+    Ip6::Netif *netif;
+    Ip6::NetifMulticastAddress groups[kNumGroups];
+    Ip6::Address address;
+    uint32_t subscriptions;
+    otNetifMulticastCounters counters;
+    uint8_t prefix[8] = {0xfd, 0x00, 0x12, 0x34, 0x56, 0x78, 0x00, 0x00};
+
+    testPlatResetToDefaults();
+    instance = new otInstance;
+    netif = &instance->mThreadNetif;
+    subscriptions = netif->GetMulticastCounters().mSubscriptions;
+
+    for (int i = 0; i < kNumGroups; i++)
+    {
+        InitGroup(groups[i].GetAddress(), static_cast<uint16_t>(i));
+        SuccessOrQuit(netif->SubscribeMulticast(groups[i]), "SubscribeMulticast failed\n");
+    }
+
+    VerifyOrQuit(netif->SubscribeMulticast(groups[0]) == OT_ERROR_ALREADY,
+                 "SubscribeMulticast accepted a subscribed address\n");
+    VerifyOrQuit(netif->GetMulticastCounters().mSubscriptions == subscriptions + kNumGroups,
+                 "subscription count is wrong\n");
+
+    for (int i = 0; i < 2 * kNumGroups; i++)
+    {
+        InitGroup(address, static_cast<uint16_t>(i));
+        VerifyOrQuit(netif->IsMulticastSubscribed(address) == (i < kNumGroups),
+                     "IsMulticastSubscribed failed\n");
+    }
+
+    // Unsubscribe every other group.
+    for (int i = 0; i < kNumGroups; i += 2)
+    {
+        SuccessOrQuit(netif->UnsubscribeMulticast(groups[i]), "UnsubscribeMulticast failed\n");
+    }
+
+    VerifyOrQuit(netif->UnsubscribeMulticast(groups[0]) == OT_ERROR_NOT_FOUND,
+                 "UnsubscribeMulticast removed an unsubscribed address\n");
+    VerifyOrQuit(netif->GetMulticastCounters().mSubscriptions == subscriptions + kNumGroups / 2,
+                 "subscription count is wrong\n");
+
+    for (int i = 0; i < kNumGroups; i++)
+    {
+        VerifyOrQuit(netif->IsMulticastSubscribed(groups[i].GetAddress()) == ((i % 2) != 0),
+                     "IsMulticastSubscribed failed after unsubscribe\n");
+    }
+
+    // The list of subscribed addresses is kept in sync with the hash buckets.
+    for (const Ip6::NetifMulticastAddress *cur = netif->GetMulticastAddresses(); cur; cur = cur->GetNext())
+    {
+        VerifyOrQuit(netif->IsMulticastSubscribed(cur->GetAddress()), "subscribed address not found\n");
+    }
+
+    // Externally subscribed addresses.
+    InitGroup(address, kNumGroups);
+    counters = netif->GetMulticastCounters();
+    SuccessOrQuit(otIp6SubscribeMulticastAddress(instance, &address), "otIp6SubscribeMulticastAddress failed\n");
+    VerifyOrQuit(otIp6SubscribeMulticastAddress(instance, &address) == OT_ERROR_ALREADY,
+                 "otIp6SubscribeMulticastAddress accepted a subscribed address\n");
+    VerifyOrQuit(netif->GetMulticastCounters().mLookups == counters.mLookups &&
+                 netif->GetMulticastCounters().mComparisons == counters.mComparisons,
+                 "otIp6SubscribeMulticastAddress changed the lookup counters\n");
+    VerifyOrQuit(netif->IsMulticastSubscribed(address), "external address not found\n");
+    VerifyOrQuit(otIp6UnsubscribeMulticastAddress(instance, &groups[1].GetAddress()) == OT_ERROR_INVALID_ARGS,
+                 "otIp6UnsubscribeMulticastAddress removed an internal address\n");
+    SuccessOrQuit(otIp6UnsubscribeMulticastAddress(instance, &address), "otIp6UnsubscribeMulticastAddress failed\n");
+    VerifyOrQuit(!netif->IsMulticastSubscribed(address), "external address found after unsubscribe\n");
+
+    // The all Thread nodes addresses follow the mesh local prefix.
+    SuccessOrQuit(otThreadSetMeshLocalPrefix(instance, prefix), "otThreadSetMeshLocalPrefix failed\n");
+    VerifyOrQuit(netif->IsMulticastSubscribed(*instance->mThreadNetif.GetMle().GetLinkLocalAllThreadNodesAddress()),
+                 "link-local all Thread nodes address not found\n");
+    VerifyOrQuit(netif->IsMulticastSubscribed(*instance->mThreadNetif.GetMle().GetRealmLocalAllThreadNodesAddress()),
+                 "realm-local all Thread nodes address not found\n");
+
+    for (int i = 1; i < kNumGroups; i += 2)
+    {
+        SuccessOrQuit(netif->UnsubscribeMulticast(groups[i]), "UnsubscribeMulticast failed\n");
+    }
+
+    VerifyOrQuit(netif->GetMulticastCounters().mSubscriptions == subscriptions, "subscription count is wrong\n");
+
+    delete instance;
+    testPlatResetToDefaults();
+}
+
+void TestNetifMulticastBenchmark(void)
+{
+    enum
+    {
+        kNumLookups = 2 * kNumGroups * 1000,
+    };
+
+    otInstance *instance;
+    Ip6::Netif *netif;
+    Ip6::NetifMulticastAddress groups[kNumGroups];
+    Ip6::Address destinations[2 * kNumGroups];
+    otNetifMulticastCounters counters;
+    uint32_t received = 0;
+    uint64_t start;
+    uint64_t elapsed;
+
+    testPlatResetToDefaults();
+    instance = new otInstance;
+    netif = &instance->mThreadNetif;
+
+    for (int i = 0; i < kNumGroups; i++)
+    {
+        InitGroup(groups[i].GetAddress(), static_cast<uint16_t>(i));
+        SuccessOrQuit(netif->SubscribeMulticast(groups[i]), "SubscribeMulticast failed\n");
+    }
+
+    // Half of the received datagrams are sent to groups the interface is not subscribed to.
+    for (int i = 0; i < 2 * kNumGroups; i++)
+    {
+        InitGroup(destinations[i], static_cast<uint16_t>(i));
+    }
+
+    counters = netif->GetMulticastCounters();
+    start = testPlatGetMicroseconds();
+
+    for (int i = 0; i < kNumLookups; i++)
+    {
+        if (netif->IsMulticastSubscribed(destinations[i % (2 * kNumGroups)]))
+        {
+            received++;
+        }
+    }
+
+    elapsed = testPlatGetMicroseconds() - start;
+
+    VerifyOrQuit(received == kNumLookups / 2, "wrong number of datagrams received\n");
+
+    printf("MulticastBenchmark: %d subscriptions, %d lookups, %lu received\n", kNumGroups, kNumLookups,
+           static_cast<unsigned long>(received));
+    printf("MulticastBenchmark: lookup %8.1f ns/datagram, %5.2f comparisons/datagram\n",
+           1000.0 * elapsed / kNumLookups,
+           static_cast<double>(netif->GetMulticastCounters().mComparisons - counters.mComparisons) / kNumLookups);
+
+    for (int i = 0; i < kNumGroups; i++)
+    {
+        SuccessOrQuit(netif->UnsubscribeMulticast(groups[i]), "UnsubscribeMulticast failed\n");
+    }
+
+    delete instance;
+    testPlatResetToDefaults();
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestNetifMulticastSubscription();
+    ot::TestNetifMulticastBenchmark();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
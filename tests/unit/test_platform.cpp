@@ -77,6 +77,13 @@ void testPlatResetToDefaults(void)
     g_testPlatRadioGetTransmitBuffer = NULL;
 }
 
+uint64_t testPlatGetMicroseconds(void)
+{
+    struct timeval tv;
+    gettimeofday(&tv, NULL);
+    return (static_cast<uint64_t>(tv.tv_sec) * 1000000) + static_cast<uint64_t>(tv.tv_usec);
+}
+
 bool sDiagMode = false;
 
 extern "C" {
@@ -91,4 +91,7 @@ extern testPlatRadioGetTransmitBuffer   g_testPlatRadioGetTransmitBuffer;
 // Resets platform functions to defaults
 void testPlatResetToDefaults(void);
 
+// Returns a free running microsecond clock, used to time benchmarks
+uint64_t testPlatGetMicroseconds(void);
+
 #endif // TEST_PLATFORM_H
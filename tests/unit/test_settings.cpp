@@ -0,0 +1,522 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "utils/wrap_string.h"
+
+#include <sys/time.h>
+
+#include <openthread/platform/settings.h>
+
+#include "platform-posix.h"
+#include "utils/flash.h"
+
+#include "test_util.h"
+
+extern "C" void otTaskletsSignalPending(otInstance *)
+{
+}
+
+extern "C" bool otTaskletsArePending(otInstance *)
+{
+    return false;
+}
+
+extern "C" void otPlatUartSendDone(void)
+{
+}
+
+extern "C" void otPlatUartReceived(const uint8_t *aBuf, uint16_t aBufLength)
+{
+    (void)aBuf;
+    (void)aBufLength;
+}
+
+extern "C" void otPlatAlarmFired(otInstance *)
+{
+}
+
+extern "C" void otPlatRadioTxDone(otInstance *, otRadioFrame *aFrame, otRadioFrame *aAckFrame,  otError aError)
+{
+    (void)aFrame;
+    (void)aAckFrame;
+    (void)aError;
+}
+
+extern "C" void otPlatRadioReceiveDone(otInstance *, otRadioFrame *aFrame, otError aError)
+{
+    (void)aFrame;
+    (void)aError;
+}
+
+#if OPENTHREAD_ENABLE_DIAG
+extern "C" void otPlatDiagAlarmFired(otInstance *)
+{
+}
+
+extern "C" void otPlatDiagRadioTransmitDone(otInstance *, otRadioFrame *aFrame, bool aFramePending, otError aError)
+{
+    (void)aFrame;
+    (void)aFramePending;
+    (void)aError;
+}
+
+extern "C" void otPlatDiagRadioReceiveDone(otInstance *, otRadioFrame *aFrame, otError aError)
+{
+    (void)aFrame;
+    (void)aError;
+}
+#endif
+
+enum
+{
+    kFlashPageSize = 0x800,
+};
+
+static uint64_t GetMicroseconds(void)
+{
+    struct timeval tv;
+
+    gettimeofday(&tv, NULL);
+    return (static_cast<uint64_t>(tv.tv_sec) * 1000000) + static_cast<uint64_t>(tv.tv_usec);
+}
+
+static uint32_t GetEraseCount(void)
+{
+    uint32_t count = 0;
+
+    for (uint32_t address = 0; address < utilsFlashGetSize(); address += kFlashPageSize)
+    {
+        count += platformFlashGetEraseCount(address);
+    }
+
+    return count;
+}
+
+/**
+ * Verify the emulated flash only clears bits on writes, whatever the alignment, and sets them on page erases.
+ */
+void TestFlash(void)
+{
+    const uint32_t kAddress = 2 * kFlashPageSize;
+    uint8_t data[16];
+    uint8_t read[sizeof(data) + 2];
+
+    SuccessOrQuit(utilsFlashInit(), "TestFlash: init failed\n");
+    VerifyOrQuit(utilsFlashGetSize() == 0x40000, "TestFlash: wrong size\n");
+
+    VerifyOrQuit(utilsFlashRead(kAddress, read, sizeof(read)) == sizeof(read), "TestFlash: read failed\n");
+
+    for (size_t i = 0; i < sizeof(read); i++)
+    {
+        VerifyOrQuit(read[i] == 0xff, "TestFlash: new flash is not erased\n");
+    }
+
+    // Write at an unaligned address, so that leading and trailing octets surround whole words.
+    memset(data, 0xf0, sizeof(data));
+    VerifyOrQuit(utilsFlashWrite(kAddress + 1, data, sizeof(data)) == sizeof(data), "TestFlash: write failed\n");
+
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        data[i] = static_cast<uint8_t>(0x3c + i);
+    }
+
+    VerifyOrQuit(utilsFlashWrite(kAddress + 1, data, sizeof(data)) == sizeof(data), "TestFlash: write failed\n");
+    VerifyOrQuit(utilsFlashRead(kAddress, read, sizeof(read)) == sizeof(read), "TestFlash: read failed\n");
+    VerifyOrQuit(read[0] == 0xff && read[sizeof(read) - 1] == 0xff, "TestFlash: write out of bounds\n");
+
+    for (size_t i = 0; i < sizeof(data); i++)
+    {
+        VerifyOrQuit(read[i + 1] == (data[i] & 0xf0), "TestFlash: write set bits\n");
+    }
+
+    VerifyOrQuit(platformFlashGetWriteCount() == 2 * sizeof(data), "TestFlash: wrong write count\n");
+    VerifyOrQuit(platformFlashGetEraseCount(kAddress) == 0, "TestFlash: wrong erase count\n");
+
+    SuccessOrQuit(utilsFlashErasePage(kAddress + kFlashPageSize - 1), "TestFlash: erase failed\n");
+    VerifyOrQuit(platformFlashGetEraseCount(kAddress) == 1, "TestFlash: wrong erase count\n");
+    VerifyOrQuit(platformFlashGetEraseCount(kAddress + kFlashPageSize) == 0, "TestFlash: erased the wrong page\n");
+    VerifyOrQuit(utilsFlashRead(kAddress, read, sizeof(read)) == sizeof(read), "TestFlash: read failed\n");
+
+    for (size_t i = 0; i < sizeof(read); i++)
+    {
+        VerifyOrQuit(read[i] == 0xff, "TestFlash: page is not erased\n");
+    }
+
+    VerifyOrQuit(utilsFlashErasePage(0x40000) == OT_ERROR_INVALID_ARGS, "TestFlash: erased out of bounds\n");
+}
+
+/**
+ * Verify settings survive being rewritten more often than the settings area can hold.
+ */
+void TestSettings(void)
+{
+    const uint16_t kKey = 3;
+    uint8_t value[32];
+    uint16_t length;
+
+    otPlatSettingsInit(NULL);
+
+    length = sizeof(value);
+    VerifyOrQuit(otPlatSettingsGet(NULL, kKey, 0, value, &length) == OT_ERROR_NOT_FOUND,
+                 "TestSettings: found a missing setting\n");
+
+    for (uint16_t i = 0; i < 500; i++)
+    {
+        memset(value, static_cast<uint8_t>(i), sizeof(value));
+        SuccessOrQuit(otPlatSettingsSet(NULL, kKey, value, sizeof(value)), "TestSettings: set failed\n");
+    }
+
+    SuccessOrQuit(otPlatSettingsAdd(NULL, kKey, value, 5), "TestSettings: add failed\n");
+
+    length = sizeof(value);
+    SuccessOrQuit(otPlatSettingsGet(NULL, kKey, 0, value, &length), "TestSettings: get failed\n");
+    VerifyOrQuit(length == sizeof(value) && value[0] == (499 & 0xff) && value[sizeof(value) - 1] == (499 & 0xff),
+                 "TestSettings: get returned a stale value\n");
+
+    length = sizeof(value);
+    SuccessOrQuit(otPlatSettingsGet(NULL, kKey, 1, value, &length), "TestSettings: get failed\n");
+    VerifyOrQuit(length == 5, "TestSettings: get returned the wrong index\n");
+
+    SuccessOrQuit(otPlatSettingsDelete(NULL, kKey, 0), "TestSettings: delete failed\n");
+
+    length = sizeof(value);
+    SuccessOrQuit(otPlatSettingsGet(NULL, kKey, 0, value, &length), "TestSettings: get failed\n");
+    VerifyOrQuit(length == 5, "TestSettings: delete removed the wrong index\n");
+
+    SuccessOrQuit(otPlatSettingsDelete(NULL, kKey, -1), "TestSettings: delete failed\n");
+    VerifyOrQuit(otPlatSettingsGet(NULL, kKey, 0, NULL, NULL) == OT_ERROR_NOT_FOUND,
+                 "TestSettings: found a deleted setting\n");
+}
+
+/**
+ * Verify changes made within a change set are visible right away, and are kept on commit or dropped on abandon.
+ */
+void TestSettingsChangeSet(void)
+{
+    const uint16_t kKey = 7;
+    uint8_t value[4] = { 1, 2, 3, 4 };
+    uint16_t length;
+
+    otPlatSettingsWipe(NULL);
+
+    VerifyOrQuit(otPlatSettingsCommitChange(NULL) == OT_ERROR_INVALID_STATE,
+                 "TestSettingsChangeSet: committed without a change set\n");
+
+    SuccessOrQuit(otPlatSettingsSet(NULL, kKey, value, 1), "TestSettingsChangeSet: set failed\n");
+
+    SuccessOrQuit(otPlatSettingsBeginChange(NULL), "TestSettingsChangeSet: begin failed\n");
+    VerifyOrQuit(otPlatSettingsBeginChange(NULL) == OT_ERROR_ALREADY, "TestSettingsChangeSet: nested change set\n");
+    SuccessOrQuit(otPlatSettingsDelete(NULL, kKey, -1), "TestSettingsChangeSet: delete failed\n");
+    SuccessOrQuit(otPlatSettingsAdd(NULL, kKey, value, 2), "TestSettingsChangeSet: add failed\n");
+    SuccessOrQuit(otPlatSettingsAdd(NULL, kKey, value, 3), "TestSettingsChangeSet: add failed\n");
+
+    length = sizeof(value);
+    SuccessOrQuit(otPlatSettingsGet(NULL, kKey, 1, value, &length), "TestSettingsChangeSet: get failed\n");
+    VerifyOrQuit(length == 3, "TestSettingsChangeSet: change is not visible\n");
+
+    SuccessOrQuit(otPlatSettingsAbandonChange(NULL), "TestSettingsChangeSet: abandon failed\n");
+
+    length = sizeof(value);
+    SuccessOrQuit(otPlatSettingsGet(NULL, kKey, 0, value, &length), "TestSettingsChangeSet: get failed\n");
+    VerifyOrQuit(length == 1, "TestSettingsChangeSet: abandoned change is visible\n");
+    VerifyOrQuit(otPlatSettingsGet(NULL, kKey, 1, NULL, NULL) == OT_ERROR_NOT_FOUND,
+                 "TestSettingsChangeSet: abandoned change is visible\n");
+
+    SuccessOrQuit(otPlatSettingsBeginChange(NULL), "TestSettingsChangeSet: begin failed\n");
+    SuccessOrQuit(otPlatSettingsSet(NULL, kKey, value, 4), "TestSettingsChangeSet: set failed\n");
+    SuccessOrQuit(otPlatSettingsCommitChange(NULL), "TestSettingsChangeSet: commit failed\n");
+
+    length = sizeof(value);
+    SuccessOrQuit(otPlatSettingsGet(NULL, kKey, 0, value, &length), "TestSettingsChangeSet: get failed\n");
+    VerifyOrQuit(length == 4, "TestSettingsChangeSet: committed change is missing\n");
+    VerifyOrQuit(otPlatSettingsGet(NULL, kKey, 1, NULL, NULL) == OT_ERROR_NOT_FOUND,
+                 "TestSettingsChangeSet: replaced setting is visible\n");
+}
+
+/**
+ * Verify the number of records is only limited by flash, and records can still be replaced when there are many.
+ */
+void TestSettingsManyRecords(void)
+{
+    const uint16_t kNumRecords = 150;
+    uint8_t value[8] = { 0 };
+    uint16_t length;
+
+    otPlatSettingsWipe(NULL);
+
+    for (uint16_t key = 0; key < kNumRecords; key++)
+    {
+        SuccessOrQuit(otPlatSettingsAdd(NULL, key, reinterpret_cast<uint8_t *>(&key), sizeof(key)),
+                      "TestSettingsManyRecords: add failed\n");
+    }
+
+    // Replacing a record compacts the settings area a few times.
+    for (uint16_t i = 0; i < 200; i++)
+    {
+        value[0] = static_cast<uint8_t>(i);
+        SuccessOrQuit(otPlatSettingsSet(NULL, 0, value, sizeof(value)), "TestSettingsManyRecords: set failed\n");
+    }
+
+    length = sizeof(value);
+    SuccessOrQuit(otPlatSettingsGet(NULL, 0, 0, value, &length), "TestSettingsManyRecords: get failed\n");
+    VerifyOrQuit(length == sizeof(value) && value[0] == 199, "TestSettingsManyRecords: set value is wrong\n");
+    VerifyOrQuit(otPlatSettingsGet(NULL, 0, 1, NULL, NULL) == OT_ERROR_NOT_FOUND,
+                 "TestSettingsManyRecords: replaced record is visible\n");
+
+    for (uint16_t key = 1; key < kNumRecords; key++)
+    {
+        uint16_t stored = 0;
+
+        length = sizeof(stored);
+        SuccessOrQuit(otPlatSettingsGet(NULL, key, 0, reinterpret_cast<uint8_t *>(&stored), &length),
+                      "TestSettingsManyRecords: record was lost\n");
+        VerifyOrQuit(length == sizeof(stored) && stored == key, "TestSettingsManyRecords: record is wrong\n");
+    }
+}
+
+enum
+{
+    kModelKeys = 4,
+    kModelValuesPerKey = 4,
+    kModelMaxValueLength = 40,
+};
+
+struct SettingsModel
+{
+    uint8_t mCount[kModelKeys];
+    uint8_t mLength[kModelKeys][kModelValuesPerKey];
+    uint8_t mValue[kModelKeys][kModelValuesPerKey][kModelMaxValueLength];
+};
+
+static void VerifySettingsModel(const SettingsModel &aModel)
+{
+    for (uint16_t key = 0; key < kModelKeys; key++)
+    {
+        for (int index = 0; index <= kModelValuesPerKey; index++)
+        {
+            uint8_t value[kModelMaxValueLength];
+            uint16_t length = sizeof(value);
+            otError error = otPlatSettingsGet(NULL, key, index, value, &length);
+
+            if (index < aModel.mCount[key])
+            {
+                SuccessOrQuit(error, "TestSettingsRandom: get failed\n");
+                VerifyOrQuit(length == aModel.mLength[key][index] &&
+                             memcmp(value, aModel.mValue[key][index], length) == 0,
+                             "TestSettingsRandom: get returned the wrong value\n");
+            }
+            else
+            {
+                VerifyOrQuit(error == OT_ERROR_NOT_FOUND, "TestSettingsRandom: found a missing setting\n");
+            }
+        }
+    }
+}
+
+/**
+ * Compare the settings against a model over random operations, which compact the settings area many times.
+ */
+void TestSettingsRandom(void)
+{
+    SettingsModel model;
+    SettingsModel committed;
+    bool inChange = false;
+
+    otPlatSettingsWipe(NULL);
+    memset(&model, 0, sizeof(model));
+    srand(0);
+
+    for (uint32_t i = 0; i < 20000; i++)
+    {
+        uint16_t key = static_cast<uint16_t>(rand() % kModelKeys);
+        uint8_t count = model.mCount[key];
+        uint8_t value[kModelMaxValueLength];
+        uint8_t length = static_cast<uint8_t>(rand() % (kModelMaxValueLength + 1));
+        int index;
+
+        for (uint8_t j = 0; j < length; j++)
+        {
+            value[j] = static_cast<uint8_t>(rand());
+        }
+
+        switch (rand() % 8)
+        {
+        case 0:
+        case 1:
+            SuccessOrQuit(otPlatSettingsSet(NULL, key, value, length), "TestSettingsRandom: set failed\n");
+            model.mCount[key] = 1;
+            model.mLength[key][0] = length;
+            memcpy(model.mValue[key][0], value, length);
+            break;
+
+        case 2:
+        case 3:
+            if (count < kModelValuesPerKey)
+            {
+                SuccessOrQuit(otPlatSettingsAdd(NULL, key, value, length), "TestSettingsRandom: add failed\n");
+                model.mLength[key][count] = length;
+                memcpy(model.mValue[key][count], value, length);
+                model.mCount[key]++;
+            }
+
+            break;
+
+        case 4:
+        case 5:
+            index = (count > 0) ? rand() % count : 0;
+            VerifyOrQuit(otPlatSettingsDelete(NULL, key, index) == (count > 0 ? OT_ERROR_NONE : OT_ERROR_NOT_FOUND),
+                         "TestSettingsRandom: delete failed\n");
+
+            if (count > 0)
+            {
+                memmove(model.mLength[key] + index, model.mLength[key] + index + 1, count - index - 1);
+                memmove(model.mValue[key] + index, model.mValue[key] + index + 1,
+                        (count - index - 1) * sizeof(model.mValue[key][0]));
+                model.mCount[key]--;
+            }
+
+            break;
+
+        case 6:
+            VerifyOrQuit(otPlatSettingsDelete(NULL, key, -1) == (count > 0 ? OT_ERROR_NONE : OT_ERROR_NOT_FOUND),
+                         "TestSettingsRandom: delete failed\n");
+            model.mCount[key] = 0;
+            break;
+
+        case 7:
+            if (!inChange)
+            {
+                SuccessOrQuit(otPlatSettingsBeginChange(NULL), "TestSettingsRandom: begin failed\n");
+                committed = model;
+                inChange = true;
+            }
+            else if (rand() % 2)
+            {
+                SuccessOrQuit(otPlatSettingsCommitChange(NULL), "TestSettingsRandom: commit failed\n");
+                inChange = false;
+            }
+            else
+            {
+                SuccessOrQuit(otPlatSettingsAbandonChange(NULL), "TestSettingsRandom: abandon failed\n");
+                model = committed;
+                inChange = false;
+            }
+
+            break;
+        }
+
+        VerifySettingsModel(model);
+    }
+
+    if (inChange)
+    {
+        SuccessOrQuit(otPlatSettingsCommitChange(NULL), "TestSettingsRandom: commit failed\n");
+    }
+
+    VerifyOrQuit(GetEraseCount() > 10, "TestSettingsRandom: settings were not compacted\n");
+}
+
+/**
+ * Measure settings throughput for the pattern MLE uses: one network info record updated in place and a set of child
+ * records that are replaced as children come and go.
+ */
+void TestSettingsBenchmark(void)
+{
+    const uint16_t kNetworkInfoKey = 3;
+    const uint16_t kChildInfoKey = 5;
+    const uint16_t kNumChildren = 10;
+    const uint32_t kNumOperations = 10000;
+    uint8_t networkInfo[40];
+    uint8_t childInfo[17];
+    uint16_t length;
+    uint64_t startTime;
+    uint64_t writeDuration;
+    uint64_t readDuration;
+    uint32_t eraseCount;
+
+    otPlatSettingsWipe(NULL);
+
+    memset(networkInfo, 0x5a, sizeof(networkInfo));
+    memset(childInfo, 0xa5, sizeof(childInfo));
+
+    for (uint16_t i = 0; i < kNumChildren; i++)
+    {
+        SuccessOrQuit(otPlatSettingsAdd(NULL, kChildInfoKey, childInfo, sizeof(childInfo)),
+                      "TestSettingsBenchmark: add failed\n");
+    }
+
+    eraseCount = GetEraseCount();
+    startTime = GetMicroseconds();
+
+    for (uint32_t i = 0; i < kNumOperations; i++)
+    {
+        if (i % 2)
+        {
+            SuccessOrQuit(otPlatSettingsSet(NULL, kNetworkInfoKey, networkInfo, sizeof(networkInfo)),
+                          "TestSettingsBenchmark: set failed\n");
+        }
+        else
+        {
+            SuccessOrQuit(otPlatSettingsDelete(NULL, kChildInfoKey, 0), "TestSettingsBenchmark: delete failed\n");
+            SuccessOrQuit(otPlatSettingsAdd(NULL, kChildInfoKey, childInfo, sizeof(childInfo)),
+                          "TestSettingsBenchmark: add failed\n");
+        }
+    }
+
+    writeDuration = GetMicroseconds() - startTime;
+    eraseCount = GetEraseCount() - eraseCount;
+
+    startTime = GetMicroseconds();
+
+    for (uint32_t i = 0; i < kNumOperations; i++)
+    {
+        length = sizeof(childInfo);
+        SuccessOrQuit(otPlatSettingsGet(NULL, kChildInfoKey, static_cast<int>(i % kNumChildren), childInfo, &length),
+                      "TestSettingsBenchmark: get failed\n");
+    }
+
+    readDuration = GetMicroseconds() - startTime;
+
+    printf("SettingsBenchmark: write %7.2f us, read %6.2f us, %u page erases, %u octets written\n",
+           static_cast<double>(writeDuration) / kNumOperations, static_cast<double>(readDuration) / kNumOperations,
+           static_cast<unsigned int>(eraseCount), static_cast<unsigned int>(platformFlashGetWriteCount()));
+}
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    TestFlash();
+    TestSettings();
+    TestSettingsChangeSet();
+    TestSettingsManyRecords();
+    TestSettingsRandom();
+    TestSettingsBenchmark();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
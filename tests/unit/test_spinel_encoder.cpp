@@ -0,0 +1,780 @@
+/*
+ *    Copyright (c) 2017, The OpenThread Authors.
+ *    All rights reserved.
+ *
+ *    Redistribution and use in source and binary forms, with or without
+ *    modification, are permitted provided that the following conditions are met:
+ *    1. Redistributions of source code must retain the above copyright
+ *       notice, this list of conditions and the following disclaimer.
+ *    2. Redistributions in binary form must reproduce the above copyright
+ *       notice, this list of conditions and the following disclaimer in the
+ *       documentation and/or other materials provided with the distribution.
+ *    3. Neither the name of the copyright holder nor the
+ *       names of its contributors may be used to endorse or promote products
+ *       derived from this software without specific prior written permission.
+ *
+ *    THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+ *    ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+ *    WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+ *    DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR ANY
+ *    DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+ *    (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+ *    LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+ *    ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+ *    (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+ *    SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+ */
+
+
+#include <string.h>
+
+#include <openthread/openthread.h>
+
+#include "common/code_utils.hpp"
+#include "ncp/spinel.h"
+#include "ncp/spinel_encoder.hpp"
+
+#include "test_platform.h"
+#include "test_util.h"
+
+namespace ot {
+
+// This module cross-checks `SpinelEncoder`/`SpinelDecoder` against `spinel_datatype_pack()`/`unpack()`.
+
+enum
+{
+    kBufferSize = 256,
+    kMaxDataLength = 40,
+    kNumCrossCheckIterations = 20000,
+    kNumMutationsPerIteration = 8,
+    kNumBenchmarkRounds = 20000,
+    kNumBenchmarkChildren = 32,
+    kNumBenchmarkCounters = 30,
+};
+
+// The spinel formats exercised by the cross-check.
+enum Format
+{
+    kFormatCommandProp,    // Spinel command header and a `uint16_t` value (e.g. STREAM_NET).
+    kFormatChildEntry,     // Child table entry.
+    kFormatNeighborEntry,  // Neighbor table entry.
+    kFormatAllTypes,       // Every scalar type, `D` as the last item.
+    kFormatNestedStructs,  // Nested structs, `D` as the last item of a struct.
+    kFormatDataNotLast,    // `D` followed by another item.
+    kNumFormats,
+};
+
+#define CHILD_ENTRY_FORMAT \
+    SPINEL_DATATYPE_STRUCT_S(SPINEL_DATATYPE_EUI64_S SPINEL_DATATYPE_UINT16_S SPINEL_DATATYPE_UINT32_S \
+                             SPINEL_DATATYPE_UINT32_S SPINEL_DATATYPE_UINT8_S SPINEL_DATATYPE_UINT8_S  \
+                             SPINEL_DATATYPE_INT8_S SPINEL_DATATYPE_UINT8_S SPINEL_DATATYPE_INT8_S)
+
+#define NEIGHBOR_ENTRY_FORMAT \
+    SPINEL_DATATYPE_STRUCT_S(SPINEL_DATATYPE_EUI64_S SPINEL_DATATYPE_UINT16_S SPINEL_DATATYPE_UINT32_S \
+                             SPINEL_DATATYPE_UINT8_S SPINEL_DATATYPE_INT8_S SPINEL_DATATYPE_UINT8_S    \
+                             SPINEL_DATATYPE_BOOL_S SPINEL_DATATYPE_UINT32_S SPINEL_DATATYPE_UINT32_S \
+                             SPINEL_DATATYPE_INT8_S)
+
+#define ALL_TYPES_FORMAT "bcCsSlLi6EeUdD"
+
+#define NESTED_STRUCTS_FORMAT "t(iD)t(Ct(SU)L)D"
+
+#define DATA_NOT_LAST_FORMAT "DS"
+
+struct Values
+{
+    bool mBool;
+    int8_t mInt8;
+    int8_t mRssi;
+    uint8_t mUint8[3];
+    int16_t mInt16;
+    uint16_t mUint16;
+    int32_t mInt32;
+    uint32_t mUint32[3];
+    unsigned int mUintPacked[2];
+    spinel_ipv6addr_t mIp6Addr;
+    spinel_eui64_t mEui64;
+    spinel_eui48_t mEui48;
+    char mUtf8[16];
+    uint8_t mData[2][kMaxDataLength];
+    uint16_t mDataLength[2];
+};
+
+// Values as returned by the decoders, pointer items refer into the decoded buffer.
+struct DecodedValues
+{
+    bool mBool;
+    int8_t mInt8;
+    int8_t mRssi;
+    uint8_t mUint8[3];
+    int16_t mInt16;
+    uint16_t mUint16;
+    int32_t mInt32;
+    uint32_t mUint32[3];
+    unsigned int mUintPacked[2];
+    const spinel_ipv6addr_t *mIp6Addr;
+    const spinel_eui64_t *mEui64;
+    const spinel_eui48_t *mEui48;
+    const char *mUtf8;
+    const uint8_t *mData[2];
+    uint16_t mDataLength[2];
+};
+
+static uint32_t RandomUint32(void)
+{
+    return (static_cast<uint32_t>(rand()) << 16) ^ static_cast<uint32_t>(rand());
+}
+
+static void RandomBytes(uint8_t *aBuffer, uint16_t aLength)
+{
+    for (uint16_t i = 0; i < aLength; i++)
+    {
+        aBuffer[i] = static_cast<uint8_t>(rand());
+    }
+}
+
+static unsigned int RandomUintPacked(void)
+{
+    // Cover every encoded size (one to three bytes).
+    static const unsigned int kMaxValues[] = { 1u << 7, 1u << 14, SPINEL_MAX_UINT_PACKED };
+
+    return RandomUint32() % kMaxValues[rand() % 3];
+}
+
+static void GenerateValues(Values &aValues)
+{
+    uint16_t utf8Length = static_cast<uint16_t>(rand() % sizeof(aValues.mUtf8));
+
+    aValues.mBool = (rand() % 2) != 0;
+    aValues.mInt8 = static_cast<int8_t>(rand());
+    aValues.mRssi = static_cast<int8_t>(rand());
+    RandomBytes(aValues.mUint8, sizeof(aValues.mUint8));
+    aValues.mInt16 = static_cast<int16_t>(rand());
+    aValues.mUint16 = static_cast<uint16_t>(rand());
+    aValues.mInt32 = static_cast<int32_t>(RandomUint32());
+
+    for (unsigned i = 0; i < sizeof(aValues.mUint32) / sizeof(aValues.mUint32[0]); i++)
+    {
+        aValues.mUint32[i] = RandomUint32();
+    }
+
+    aValues.mUintPacked[0] = RandomUintPacked();
+    aValues.mUintPacked[1] = RandomUintPacked();
+    RandomBytes(aValues.mIp6Addr.bytes, sizeof(aValues.mIp6Addr));
+    RandomBytes(aValues.mEui64.bytes, sizeof(aValues.mEui64));
+    RandomBytes(aValues.mEui48.bytes, sizeof(aValues.mEui48));
+
+    for (uint16_t i = 0; i < utf8Length; i++)
+    {
+        aValues.mUtf8[i] = static_cast<char>('a' + rand() % 26);
+    }
+
+    aValues.mUtf8[utf8Length] = 0;
+
+    for (unsigned i = 0; i < 2; i++)
+    {
+        aValues.mDataLength[i] = static_cast<uint16_t>(rand() % (kMaxDataLength + 1));
+        RandomBytes(aValues.mData[i], aValues.mDataLength[i]);
+    }
+}
+
+static spinel_ssize_t PackWithC(Format aFormat, const Values &aValues, uint8_t *aBuffer, uint16_t aBufferSize)
+{
+    spinel_ssize_t length = -1;
+
+    switch (aFormat)
+    {
+    case kFormatCommandProp:
+        length = spinel_datatype_pack(aBuffer, aBufferSize, SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_UINT16_S,
+                                      aValues.mUint8[0], aValues.mUintPacked[0], aValues.mUintPacked[1],
+                                      aValues.mUint16);
+        break;
+
+    case kFormatChildEntry:
+        length = spinel_datatype_pack(aBuffer, aBufferSize, CHILD_ENTRY_FORMAT, aValues.mEui64.bytes,
+                                      aValues.mUint16, aValues.mUint32[0], aValues.mUint32[1], aValues.mUint8[0],
+                                      aValues.mUint8[1], aValues.mInt8, aValues.mUint8[2], aValues.mRssi);
+        break;
+
+    case kFormatNeighborEntry:
+        length = spinel_datatype_pack(aBuffer, aBufferSize, NEIGHBOR_ENTRY_FORMAT, aValues.mEui64.bytes,
+                                      aValues.mUint16, aValues.mUint32[0], aValues.mUint8[0], aValues.mInt8,
+                                      aValues.mUint8[1], aValues.mBool, aValues.mUint32[1], aValues.mUint32[2],
+                                      aValues.mRssi);
+        break;
+
+    case kFormatAllTypes:
+        length = spinel_datatype_pack(aBuffer, aBufferSize, ALL_TYPES_FORMAT, aValues.mBool, aValues.mInt8,
+                                      aValues.mUint8[0], aValues.mInt16, aValues.mUint16, aValues.mInt32,
+                                      aValues.mUint32[0], aValues.mUintPacked[0], &aValues.mIp6Addr,
+                                      &aValues.mEui64, &aValues.mEui48, aValues.mUtf8, aValues.mData[0],
+                                      static_cast<unsigned int>(aValues.mDataLength[0]), aValues.mData[1],
+                                      static_cast<unsigned int>(aValues.mDataLength[1]));
+        break;
+
+    case kFormatNestedStructs:
+        length = spinel_datatype_pack(aBuffer, aBufferSize, NESTED_STRUCTS_FORMAT, aValues.mUintPacked[0],
+                                      aValues.mData[0], static_cast<unsigned int>(aValues.mDataLength[0]),
+                                      aValues.mUint8[0], aValues.mUint16, aValues.mUtf8, aValues.mUint32[0],
+                                      aValues.mData[1], static_cast<unsigned int>(aValues.mDataLength[1]));
+        break;
+
+    case kFormatDataNotLast:
+        length = spinel_datatype_pack(aBuffer, aBufferSize, DATA_NOT_LAST_FORMAT, aValues.mData[0],
+                                      static_cast<unsigned int>(aValues.mDataLength[0]), aValues.mUint16);
+        break;
+
+    default:
+        break;
+    }
+
+    return length;
+}
+
+static otError PackWithEncoder(Format aFormat, const Values &aValues, SpinelEncoder &aEncoder)
+{
+    otError error = OT_ERROR_NONE;
+
+    switch (aFormat)
+    {
+    case kFormatCommandProp:
+        SuccessOrExit(error = aEncoder.WriteUint8(aValues.mUint8[0]));
+        SuccessOrExit(error = aEncoder.WriteUintPacked(aValues.mUintPacked[0]));
+        SuccessOrExit(error = aEncoder.WriteUintPacked(aValues.mUintPacked[1]));
+        SuccessOrExit(error = aEncoder.WriteUint16(aValues.mUint16));
+        break;
+
+    case kFormatChildEntry:
+        SuccessOrExit(error = aEncoder.OpenStruct());
+        SuccessOrExit(error = aEncoder.WriteEui64(aValues.mEui64.bytes));
+        SuccessOrExit(error = aEncoder.WriteUint16(aValues.mUint16));
+        SuccessOrExit(error = aEncoder.WriteUint32(aValues.mUint32[0]));
+        SuccessOrExit(error = aEncoder.WriteUint32(aValues.mUint32[1]));
+        SuccessOrExit(error = aEncoder.WriteUint8(aValues.mUint8[0]));
+        SuccessOrExit(error = aEncoder.WriteUint8(aValues.mUint8[1]));
+        SuccessOrExit(error = aEncoder.WriteInt8(aValues.mInt8));
+        SuccessOrExit(error = aEncoder.WriteUint8(aValues.mUint8[2]));
+        SuccessOrExit(error = aEncoder.WriteInt8(aValues.mRssi));
+        SuccessOrExit(error = aEncoder.CloseStruct());
+        break;
+
+    case kFormatNeighborEntry:
+        SuccessOrExit(error = aEncoder.OpenStruct());
+        SuccessOrExit(error = aEncoder.WriteEui64(aValues.mEui64.bytes));
+        SuccessOrExit(error = aEncoder.WriteUint16(aValues.mUint16));
+        SuccessOrExit(error = aEncoder.WriteUint32(aValues.mUint32[0]));
+        SuccessOrExit(error = aEncoder.WriteUint8(aValues.mUint8[0]));
+        SuccessOrExit(error = aEncoder.WriteInt8(aValues.mInt8));
+        SuccessOrExit(error = aEncoder.WriteUint8(aValues.mUint8[1]));
+        SuccessOrExit(error = aEncoder.WriteBool(aValues.mBool));
+        SuccessOrExit(error = aEncoder.WriteUint32(aValues.mUint32[1]));
+        SuccessOrExit(error = aEncoder.WriteUint32(aValues.mUint32[2]));
+        SuccessOrExit(error = aEncoder.WriteInt8(aValues.mRssi));
+        SuccessOrExit(error = aEncoder.CloseStruct());
+        break;
+
+    case kFormatAllTypes:
+        SuccessOrExit(error = aEncoder.WriteBool(aValues.mBool));
+        SuccessOrExit(error = aEncoder.WriteInt8(aValues.mInt8));
+        SuccessOrExit(error = aEncoder.WriteUint8(aValues.mUint8[0]));
+        SuccessOrExit(error = aEncoder.WriteInt16(aValues.mInt16));
+        SuccessOrExit(error = aEncoder.WriteUint16(aValues.mUint16));
+        SuccessOrExit(error = aEncoder.WriteInt32(aValues.mInt32));
+        SuccessOrExit(error = aEncoder.WriteUint32(aValues.mUint32[0]));
+        SuccessOrExit(error = aEncoder.WriteUintPacked(aValues.mUintPacked[0]));
+        SuccessOrExit(error = aEncoder.WriteIp6Address(&aValues.mIp6Addr));
+        SuccessOrExit(error = aEncoder.WriteEui64(&aValues.mEui64));
+        SuccessOrExit(error = aEncoder.WriteEui48(&aValues.mEui48));
+        SuccessOrExit(error = aEncoder.WriteUtf8(aValues.mUtf8));
+        SuccessOrExit(error = aEncoder.WriteDataWithLen(aValues.mData[0], aValues.mDataLength[0]));
+        SuccessOrExit(error = aEncoder.WriteData(aValues.mData[1], aValues.mDataLength[1]));
+        break;
+
+    case kFormatNestedStructs:
+        SuccessOrExit(error = aEncoder.OpenStruct());
+        SuccessOrExit(error = aEncoder.WriteUintPacked(aValues.mUintPacked[0]));
+        SuccessOrExit(error = aEncoder.WriteData(aValues.mData[0], aValues.mDataLength[0]));
+        SuccessOrExit(error = aEncoder.CloseStruct());
+        SuccessOrExit(error = aEncoder.OpenStruct());
+        SuccessOrExit(error = aEncoder.WriteUint8(aValues.mUint8[0]));
+        SuccessOrExit(error = aEncoder.OpenStruct());
+        SuccessOrExit(error = aEncoder.WriteUint16(aValues.mUint16));
+        SuccessOrExit(error = aEncoder.WriteUtf8(aValues.mUtf8));
+        SuccessOrExit(error = aEncoder.CloseStruct());
+        SuccessOrExit(error = aEncoder.WriteUint32(aValues.mUint32[0]));
+        SuccessOrExit(error = aEncoder.CloseStruct());
+        SuccessOrExit(error = aEncoder.WriteData(aValues.mData[1], aValues.mDataLength[1]));
+        break;
+
+    case kFormatDataNotLast:
+        SuccessOrExit(error = aEncoder.WriteDataWithLen(aValues.mData[0], aValues.mDataLength[0]));
+        SuccessOrExit(error = aEncoder.WriteUint16(aValues.mUint16));
+        break;
+
+    default:
+        error = OT_ERROR_INVALID_ARGS;
+        break;
+    }
+
+exit:
+    return error;
+}
+
+static spinel_ssize_t UnpackWithC(Format aFormat, const uint8_t *aBuffer, uint16_t aLength, DecodedValues &aValues)
+{
+    spinel_ssize_t length = -1;
+    unsigned int dataLength[2] = { 0, 0 };
+    uint8_t int8;
+    uint8_t rssi;
+    uint16_t int16;
+    uint32_t int32;
+
+    switch (aFormat)
+    {
+    case kFormatCommandProp:
+        length = spinel_datatype_unpack(aBuffer, aLength, SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_UINT16_S,
+                                        &aValues.mUint8[0], &aValues.mUintPacked[0], &aValues.mUintPacked[1],
+                                        &aValues.mUint16);
+        break;
+
+    case kFormatChildEntry:
+        length = spinel_datatype_unpack(aBuffer, aLength, CHILD_ENTRY_FORMAT, &aValues.mEui64, &aValues.mUint16,
+                                        &aValues.mUint32[0], &aValues.mUint32[1], &aValues.mUint8[0],
+                                        &aValues.mUint8[1], &int8, &aValues.mUint8[2], &rssi);
+        aValues.mInt8 = static_cast<int8_t>(int8);
+        aValues.mRssi = static_cast<int8_t>(rssi);
+        break;
+
+    case kFormatNeighborEntry:
+        length = spinel_datatype_unpack(aBuffer, aLength, NEIGHBOR_ENTRY_FORMAT, &aValues.mEui64, &aValues.mUint16,
+                                        &aValues.mUint32[0], &aValues.mUint8[0], &int8, &aValues.mUint8[1],
+                                        &aValues.mBool, &aValues.mUint32[1], &aValues.mUint32[2], &rssi);
+        aValues.mInt8 = static_cast<int8_t>(int8);
+        aValues.mRssi = static_cast<int8_t>(rssi);
+        break;
+
+    case kFormatAllTypes:
+        length = spinel_datatype_unpack(aBuffer, aLength, ALL_TYPES_FORMAT, &aValues.mBool, &int8,
+                                        &aValues.mUint8[0], &int16, &aValues.mUint16, &int32, &aValues.mUint32[0],
+                                        &aValues.mUintPacked[0], &aValues.mIp6Addr, &aValues.mEui64,
+                                        &aValues.mEui48, &aValues.mUtf8, &aValues.mData[0], &dataLength[0],
+                                        &aValues.mData[1], &dataLength[1]);
+        aValues.mInt8 = static_cast<int8_t>(int8);
+        aValues.mInt16 = static_cast<int16_t>(int16);
+        aValues.mInt32 = static_cast<int32_t>(int32);
+        break;
+
+    case kFormatNestedStructs:
+        length = spinel_datatype_unpack(aBuffer, aLength, NESTED_STRUCTS_FORMAT, &aValues.mUintPacked[0],
+                                        &aValues.mData[0], &dataLength[0], &aValues.mUint8[0], &aValues.mUint16,
+                                        &aValues.mUtf8, &aValues.mUint32[0], &aValues.mData[1], &dataLength[1]);
+        break;
+
+    case kFormatDataNotLast:
+        length = spinel_datatype_unpack(aBuffer, aLength, DATA_NOT_LAST_FORMAT, &aValues.mData[0], &dataLength[0],
+                                        &aValues.mUint16);
+        break;
+
+    default:
+        break;
+    }
+
+    aValues.mDataLength[0] = static_cast<uint16_t>(dataLength[0]);
+    aValues.mDataLength[1] = static_cast<uint16_t>(dataLength[1]);
+
+    return length;
+}
+
+static otError UnpackWithDecoder(Format aFormat, SpinelDecoder &aDecoder, DecodedValues &aValues)
+{
+    otError error = OT_ERROR_NONE;
+
+    switch (aFormat)
+    {
+    case kFormatCommandProp:
+        SuccessOrExit(error = aDecoder.ReadUint8(aValues.mUint8[0]));
+        SuccessOrExit(error = aDecoder.ReadUintPacked(aValues.mUintPacked[0]));
+        SuccessOrExit(error = aDecoder.ReadUintPacked(aValues.mUintPacked[1]));
+        SuccessOrExit(error = aDecoder.ReadUint16(aValues.mUint16));
+        break;
+
+    case kFormatChildEntry:
+        SuccessOrExit(error = aDecoder.OpenStruct());
+        SuccessOrExit(error = aDecoder.ReadEui64(aValues.mEui64));
+        SuccessOrExit(error = aDecoder.ReadUint16(aValues.mUint16));
+        SuccessOrExit(error = aDecoder.ReadUint32(aValues.mUint32[0]));
+        SuccessOrExit(error = aDecoder.ReadUint32(aValues.mUint32[1]));
+        SuccessOrExit(error = aDecoder.ReadUint8(aValues.mUint8[0]));
+        SuccessOrExit(error = aDecoder.ReadUint8(aValues.mUint8[1]));
+        SuccessOrExit(error = aDecoder.ReadInt8(aValues.mInt8));
+        SuccessOrExit(error = aDecoder.ReadUint8(aValues.mUint8[2]));
+        SuccessOrExit(error = aDecoder.ReadInt8(aValues.mRssi));
+        SuccessOrExit(error = aDecoder.CloseStruct());
+        break;
+
+    case kFormatNeighborEntry:
+        SuccessOrExit(error = aDecoder.OpenStruct());
+        SuccessOrExit(error = aDecoder.ReadEui64(aValues.mEui64));
+        SuccessOrExit(error = aDecoder.ReadUint16(aValues.mUint16));
+        SuccessOrExit(error = aDecoder.ReadUint32(aValues.mUint32[0]));
+        SuccessOrExit(error = aDecoder.ReadUint8(aValues.mUint8[0]));
+        SuccessOrExit(error = aDecoder.ReadInt8(aValues.mInt8));
+        SuccessOrExit(error = aDecoder.ReadUint8(aValues.mUint8[1]));
+        SuccessOrExit(error = aDecoder.ReadBool(aValues.mBool));
+        SuccessOrExit(error = aDecoder.ReadUint32(aValues.mUint32[1]));
+        SuccessOrExit(error = aDecoder.ReadUint32(aValues.mUint32[2]));
+        SuccessOrExit(error = aDecoder.ReadInt8(aValues.mRssi));
+        SuccessOrExit(error = aDecoder.CloseStruct());
+        break;
+
+    case kFormatAllTypes:
+        SuccessOrExit(error = aDecoder.ReadBool(aValues.mBool));
+        SuccessOrExit(error = aDecoder.ReadInt8(aValues.mInt8));
+        SuccessOrExit(error = aDecoder.ReadUint8(aValues.mUint8[0]));
+        SuccessOrExit(error = aDecoder.ReadInt16(aValues.mInt16));
+        SuccessOrExit(error = aDecoder.ReadUint16(aValues.mUint16));
+        SuccessOrExit(error = aDecoder.ReadInt32(aValues.mInt32));
+        SuccessOrExit(error = aDecoder.ReadUint32(aValues.mUint32[0]));
+        SuccessOrExit(error = aDecoder.ReadUintPacked(aValues.mUintPacked[0]));
+        SuccessOrExit(error = aDecoder.ReadIp6Address(aValues.mIp6Addr));
+        SuccessOrExit(error = aDecoder.ReadEui64(aValues.mEui64));
+        SuccessOrExit(error = aDecoder.ReadEui48(aValues.mEui48));
+        SuccessOrExit(error = aDecoder.ReadUtf8(aValues.mUtf8));
+        SuccessOrExit(error = aDecoder.ReadDataWithLen(aValues.mData[0], aValues.mDataLength[0]));
+        SuccessOrExit(error = aDecoder.ReadData(aValues.mData[1], aValues.mDataLength[1]));
+        break;
+
+    case kFormatNestedStructs:
+        SuccessOrExit(error = aDecoder.OpenStruct());
+        SuccessOrExit(error = aDecoder.ReadUintPacked(aValues.mUintPacked[0]));
+        SuccessOrExit(error = aDecoder.ReadData(aValues.mData[0], aValues.mDataLength[0]));
+        SuccessOrExit(error = aDecoder.CloseStruct());
+        SuccessOrExit(error = aDecoder.OpenStruct());
+        SuccessOrExit(error = aDecoder.ReadUint8(aValues.mUint8[0]));
+        SuccessOrExit(error = aDecoder.OpenStruct());
+        SuccessOrExit(error = aDecoder.ReadUint16(aValues.mUint16));
+        SuccessOrExit(error = aDecoder.ReadUtf8(aValues.mUtf8));
+        SuccessOrExit(error = aDecoder.CloseStruct());
+        SuccessOrExit(error = aDecoder.ReadUint32(aValues.mUint32[0]));
+        SuccessOrExit(error = aDecoder.CloseStruct());
+        SuccessOrExit(error = aDecoder.ReadData(aValues.mData[1], aValues.mDataLength[1]));
+        break;
+
+    case kFormatDataNotLast:
+        SuccessOrExit(error = aDecoder.ReadDataWithLen(aValues.mData[0], aValues.mDataLength[0]));
+        SuccessOrExit(error = aDecoder.ReadUint16(aValues.mUint16));
+        break;
+
+    default:
+        error = OT_ERROR_INVALID_ARGS;
+        break;
+    }
+
+exit:
+    return error;
+}
+
+// Compares the decoded values which are part of `aFormat` (other fields are left unset by the decoders).
+static bool AreDecodedValuesEqual(Format aFormat, const DecodedValues &aFirst, const DecodedValues &aSecond)
+{
+    bool equal = false;
+
+    switch (aFormat)
+    {
+    case kFormatCommandProp:
+        equal = (aFirst.mUint8[0] == aSecond.mUint8[0]) && (aFirst.mUintPacked[0] == aSecond.mUintPacked[0]) &&
+                (aFirst.mUintPacked[1] == aSecond.mUintPacked[1]) && (aFirst.mUint16 == aSecond.mUint16);
+        break;
+
+    case kFormatChildEntry:
+        equal = (aFirst.mEui64 == aSecond.mEui64) && (aFirst.mUint16 == aSecond.mUint16) &&
+                (aFirst.mUint32[0] == aSecond.mUint32[0]) && (aFirst.mUint32[1] == aSecond.mUint32[1]) &&
+                (memcmp(aFirst.mUint8, aSecond.mUint8, sizeof(aFirst.mUint8)) == 0) &&
+                (aFirst.mInt8 == aSecond.mInt8) && (aFirst.mRssi == aSecond.mRssi);
+        break;
+
+    case kFormatNeighborEntry:
+        equal = (aFirst.mEui64 == aSecond.mEui64) && (aFirst.mUint16 == aSecond.mUint16) &&
+                (memcmp(aFirst.mUint32, aSecond.mUint32, sizeof(aFirst.mUint32)) == 0) &&
+                (aFirst.mUint8[0] == aSecond.mUint8[0]) && (aFirst.mUint8[1] == aSecond.mUint8[1]) &&
+                (aFirst.mInt8 == aSecond.mInt8) && (aFirst.mBool == aSecond.mBool) && (aFirst.mRssi == aSecond.mRssi);
+        break;
+
+    case kFormatAllTypes:
+        equal = (aFirst.mBool == aSecond.mBool) && (aFirst.mInt8 == aSecond.mInt8) &&
+                (aFirst.mUint8[0] == aSecond.mUint8[0]) && (aFirst.mInt16 == aSecond.mInt16) &&
+                (aFirst.mUint16 == aSecond.mUint16) && (aFirst.mInt32 == aSecond.mInt32) &&
+                (aFirst.mUint32[0] == aSecond.mUint32[0]) && (aFirst.mUintPacked[0] == aSecond.mUintPacked[0]) &&
+                (aFirst.mIp6Addr == aSecond.mIp6Addr) && (aFirst.mEui64 == aSecond.mEui64) &&
+                (aFirst.mEui48 == aSecond.mEui48) && (aFirst.mUtf8 == aSecond.mUtf8) &&
+                (aFirst.mData[0] == aSecond.mData[0]) && (aFirst.mDataLength[0] == aSecond.mDataLength[0]) &&
+                (aFirst.mData[1] == aSecond.mData[1]) && (aFirst.mDataLength[1] == aSecond.mDataLength[1]);
+        break;
+
+    case kFormatNestedStructs:
+        equal = (aFirst.mUintPacked[0] == aSecond.mUintPacked[0]) && (aFirst.mData[0] == aSecond.mData[0]) &&
+                (aFirst.mDataLength[0] == aSecond.mDataLength[0]) && (aFirst.mUint8[0] == aSecond.mUint8[0]) &&
+                (aFirst.mUint16 == aSecond.mUint16) && (aFirst.mUtf8 == aSecond.mUtf8) &&
+                (aFirst.mUint32[0] == aSecond.mUint32[0]) && (aFirst.mData[1] == aSecond.mData[1]) &&
+                (aFirst.mDataLength[1] == aSecond.mDataLength[1]);
+        break;
+
+    case kFormatDataNotLast:
+        equal = (aFirst.mData[0] == aSecond.mData[0]) && (aFirst.mDataLength[0] == aSecond.mDataLength[0]) &&
+                (aFirst.mUint16 == aSecond.mUint16);
+        break;
+
+    default:
+        break;
+    }
+
+    return equal;
+}
+
+// Decodes `aBuffer` with both decoders. Whenever `SpinelDecoder` accepts the input, `spinel_datatype_unpack()` must
+// consume the same number of bytes and return the same values.
+static bool CrossCheckDecode(Format aFormat, const uint8_t *aBuffer, uint16_t aLength)
+{
+    SpinelDecoder decoder(aBuffer, aLength);
+    DecodedValues cppValues;
+    DecodedValues cValues;
+    spinel_ssize_t cLength;
+    bool accepted = false;
+
+    memset(&cppValues, 0, sizeof(cppValues));
+    memset(&cValues, 0, sizeof(cValues));
+
+    VerifyOrExit(UnpackWithDecoder(aFormat, decoder, cppValues) == OT_ERROR_NONE);
+
+    cLength = UnpackWithC(aFormat, aBuffer, aLength, cValues);
+
+    VerifyOrQuit(cLength == decoder.GetReadLength(), "SpinelDecoder and spinel_datatype_unpack() read lengths differ");
+    VerifyOrQuit(AreDecodedValuesEqual(aFormat, cppValues, cValues),
+                 "SpinelDecoder and spinel_datatype_unpack() values differ");
+
+    accepted = true;
+
+exit:
+    return accepted;
+}
+
+void TestSpinelEncoderCrossCheck(void)
+{
+    uint8_t cBuffer[kBufferSize];
+    uint8_t cppBuffer[kBufferSize];
+    uint8_t mutated[kBufferSize];
+    Values values;
+    unsigned numMutationsAccepted = 0;
+
+    srand(0x5e1e);
+
+    for (unsigned iteration = 0; iteration < kNumCrossCheckIterations; iteration++)
+    {
+        Format format = static_cast<Format>(iteration % kNumFormats);
+        SpinelEncoder encoder(cppBuffer, sizeof(cppBuffer));
+        spinel_ssize_t cLength;
+        uint16_t length;
+
+        GenerateValues(values);
+
+        memset(cBuffer, 0xa5, sizeof(cBuffer));
+        cLength = PackWithC(format, values, cBuffer, sizeof(cBuffer));
+        VerifyOrQuit(cLength > 0 && cLength <= static_cast<spinel_ssize_t>(sizeof(cBuffer)),
+                     "spinel_datatype_pack() failed");
+
+        // Encoding is byte-identical.
+
+        SuccessOrQuit(PackWithEncoder(format, values, encoder), "SpinelEncoder failed");
+        length = encoder.GetLength();
+        VerifyOrQuit(length == cLength, "SpinelEncoder and spinel_datatype_pack() lengths differ");
+        VerifyOrQuit(memcmp(cBuffer, cppBuffer, length) == 0, "SpinelEncoder and spinel_datatype_pack() bytes differ");
+
+        // A buffer one byte short is rejected.
+
+        {
+            SpinelEncoder shortEncoder(cppBuffer, length - 1);
+
+            VerifyOrQuit(PackWithEncoder(format, values, shortEncoder) == OT_ERROR_NO_BUFS,
+                         "SpinelEncoder accepted a buffer too small");
+        }
+
+        // The encoding round-trips through both decoders.
+
+        VerifyOrQuit(CrossCheckDecode(format, cBuffer, length), "SpinelDecoder rejected a valid encoding");
+
+        // Truncated and mutated encodings decode identically, or are rejected by `SpinelDecoder`.
+
+        for (unsigned mutation = 0; mutation < kNumMutationsPerIteration; mutation++)
+        {
+            uint16_t mutatedLength = length;
+
+            memcpy(mutated, cBuffer, length);
+
+            if (rand() % 2)
+            {
+                mutatedLength = static_cast<uint16_t>(rand() % length);
+            }
+
+            for (int flips = rand() % 3; flips > 0 && mutatedLength > 0; flips--)
+            {
+                mutated[rand() % mutatedLength] ^= static_cast<uint8_t>(1 << (rand() % 8));
+            }
+
+            if (CrossCheckDecode(format, mutated, mutatedLength))
+            {
+                numMutationsAccepted++;
+            }
+        }
+    }
+
+    // Out of range packed integers are rejected.
+
+    {
+        uint8_t buffer[8];
+        SpinelEncoder encoder(buffer, sizeof(buffer));
+        SpinelDecoder decoder(buffer, sizeof(buffer));
+        unsigned int value;
+
+        VerifyOrQuit(encoder.WriteUintPacked(SPINEL_MAX_UINT_PACKED) == OT_ERROR_INVALID_ARGS,
+                     "SpinelEncoder accepted an out of range packed integer");
+
+        spinel_packed_uint_encode(buffer, sizeof(buffer), SPINEL_MAX_UINT_PACKED);
+        VerifyOrQuit(decoder.ReadUintPacked(value) == OT_ERROR_PARSE,
+                     "SpinelDecoder accepted an out of range packed integer");
+        VerifyOrQuit(decoder.GetReadLength() == 0, "SpinelDecoder consumed a rejected packed integer");
+    }
+
+    // A string without null terminator is rejected.
+
+    {
+        const uint8_t string[] = { 'a', 'b', 'c' };
+        SpinelDecoder decoder(string, sizeof(string));
+        const char *utf8;
+
+        VerifyOrQuit(decoder.ReadUtf8(utf8) == OT_ERROR_PARSE, "SpinelDecoder accepted an unterminated string");
+    }
+
+    printf("TestSpinelEncoderCrossCheck: %u encodings, %u of %u mutated encodings accepted\n",
+           kNumCrossCheckIterations, numMutationsAccepted, kNumCrossCheckIterations * kNumMutationsPerIteration);
+}
+
+void TestSpinelEncoderBenchmark(void)
+{
+    uint8_t buffer[kNumBenchmarkChildren * 32];
+    Values children[kNumBenchmarkChildren];
+    uint32_t counters[kNumBenchmarkCounters];
+    uint32_t checksum = 0;
+    uint64_t start;
+    uint64_t elapsedC;
+    uint64_t elapsedCpp;
+
+    for (unsigned i = 0; i < kNumBenchmarkChildren; i++)
+    {
+        GenerateValues(children[i]);
+    }
+
+    for (unsigned i = 0; i < kNumBenchmarkCounters; i++)
+    {
+        counters[i] = RandomUint32();
+    }
+
+    // Child table: one struct per child, as in `GetPropertyHandler_THREAD_CHILD_TABLE()`.
+
+    start = testPlatGetMicroseconds();
+
+    for (unsigned round = 0; round < kNumBenchmarkRounds; round++)
+    {
+        uint16_t length = 0;
+
+        for (unsigned i = 0; i < kNumBenchmarkChildren; i++)
+        {
+            length += static_cast<uint16_t>(PackWithC(kFormatChildEntry, children[i], buffer + length,
+                                                      static_cast<uint16_t>(sizeof(buffer) - length)));
+        }
+
+        checksum += buffer[round % length];
+    }
+
+    elapsedC = testPlatGetMicroseconds() - start;
+    start = testPlatGetMicroseconds();
+
+    for (unsigned round = 0; round < kNumBenchmarkRounds; round++)
+    {
+        SpinelEncoder encoder(buffer, sizeof(buffer));
+
+        for (unsigned i = 0; i < kNumBenchmarkChildren; i++)
+        {
+            const Values &child = children[i];
+
+            encoder.OpenStruct();
+            encoder.WriteEui64(child.mEui64.bytes);
+            encoder.WriteUint16(child.mUint16);
+            encoder.WriteUint32(child.mUint32[0]);
+            encoder.WriteUint32(child.mUint32[1]);
+            encoder.WriteUint8(child.mUint8[0]);
+            encoder.WriteUint8(child.mUint8[1]);
+            encoder.WriteInt8(child.mInt8);
+            encoder.WriteUint8(child.mUint8[2]);
+            encoder.WriteInt8(child.mRssi);
+            encoder.CloseStruct();
+        }
+
+        checksum += buffer[round % encoder.GetLength()];
+    }
+
+    elapsedCpp = testPlatGetMicroseconds() - start;
+
+    printf("SpinelEncoderBenchmark: child table (%u entries): spinel_datatype_pack %.1f ns, SpinelEncoder %.1f ns\n",
+           kNumBenchmarkChildren, elapsedC * 1000.0 / kNumBenchmarkRounds, elapsedCpp * 1000.0 / kNumBenchmarkRounds);
+
+    // Counter set: one `VALUE_IS` frame (header, command, key and `uint32_t` value) per counter, as in
+    // `GetPropertyHandler_MAC_CNTR()`.
+
+    start = testPlatGetMicroseconds();
+
+    for (unsigned round = 0; round < kNumBenchmarkRounds; round++)
+    {
+        for (unsigned i = 0; i < kNumBenchmarkCounters; i++)
+        {
+            spinel_datatype_pack(buffer, sizeof(buffer), SPINEL_DATATYPE_COMMAND_PROP_S SPINEL_DATATYPE_UINT32_S,
+                                 SPINEL_HEADER_FLAG, SPINEL_CMD_PROP_VALUE_IS, SPINEL_PROP_CNTR__BEGIN + i,
+                                 counters[i]);
+            checksum += buffer[4];
+        }
+    }
+
+    elapsedC = testPlatGetMicroseconds() - start;
+    start = testPlatGetMicroseconds();
+
+    for (unsigned round = 0; round < kNumBenchmarkRounds; round++)
+    {
+        for (unsigned i = 0; i < kNumBenchmarkCounters; i++)
+        {
+            SpinelEncoder encoder(buffer, sizeof(buffer));
+
+            encoder.WriteUint8(SPINEL_HEADER_FLAG);
+            encoder.WriteUintPacked(SPINEL_CMD_PROP_VALUE_IS);
+            encoder.WriteUintPacked(SPINEL_PROP_CNTR__BEGIN + i);
+            encoder.WriteUint32(counters[i]);
+            checksum += buffer[4];
+        }
+    }
+
+    elapsedCpp = testPlatGetMicroseconds() - start;
+
+    printf("SpinelEncoderBenchmark: counter set (%u counters): spinel_datatype_pack %.1f ns, SpinelEncoder %.1f ns "
+           "(checksum %u)\n", kNumBenchmarkCounters, elapsedC * 1000.0 / kNumBenchmarkRounds,
+           elapsedCpp * 1000.0 / kNumBenchmarkRounds, checksum);
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestSpinelEncoderCrossCheck();
+    ot::TestSpinelEncoderBenchmark();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
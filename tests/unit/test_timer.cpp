@@ -28,8 +28,11 @@
 
 #include "test_platform.h"
 
+#include <stdlib.h>
+
 #include "openthread-instance.h"
 #include "common/debug.hpp"
+#include "common/new.hpp"
 #include "common/timer.hpp"
 
 enum
@@ -317,15 +320,16 @@ int TestTenTimers(void)
         1
     };
 
+    // All timers expired at a trigger are fired in one batch, followed by a single alarm update.
     const uint32_t kTimerStartCountAfterTrigger[kNumTriggers] =
     {
         3,
         4,
         5,
+        6,
         7,
-        9,
-        11,
-        11
+        8,
+        8
     };
 
     otInstance aInstance;
@@ -376,12 +380,9 @@ int TestTenTimers(void)
 
         do
         {
-            // By design, each call to otPlatAlarmFired() can result in 0 or 1 calls to a timer handler.
-            // For some combinations of sNow and Timers queued, it is necessary to call otPlatAlarmFired()
-            // multiple times in order to handle all the expired timers.  It can be determined that another
-            // timer is ready to be triggered by examining the aDt arg passed into otPlatAlarmStartAt().  If
-            // that value is 0, then otPlatAlarmFired should be fired immediately. This loop calls otPlatAlarmFired()
-            // the requisite number of times based on the aDt argument.
+            // Each call to otPlatAlarmFired() fires all the timers that have expired by sNow.  A timer started
+            // from within a handler is fired on a later call, in which case the aDt arg passed into
+            // otPlatAlarmStartAt() is 0 and otPlatAlarmFired() should be fired again immediately.
             otPlatAlarmFired(&aInstance);
         }
         while (sPlatDt == 0);
@@ -409,10 +410,221 @@ int TestTenTimers(void)
     return 0;
 }
 
+struct TestTimerContext
+{
+    ot::Timer *mTimer;
+    uint32_t   mFireCount;
+    bool       mRestart;
+};
+
+static uint32_t GetRandomInterval(void)
+{
+    // Mix short and long intervals so that timers are spread over all levels of the timing wheel.
+    static const uint32_t kMaxIntervals[] = { 4, 100, 5000, 300000, 20000000 };
+
+    return static_cast<uint32_t>(rand()) % kMaxIntervals[static_cast<uint32_t>(rand()) % 5];
+}
+
+void TestRandomTimerHandler(void *aContext)
+{
+    TestTimerContext *context = static_cast<TestTimerContext *>(aContext);
+
+    VerifyOrQuit(!context->mTimer->IsRunning(), "TestRandomTimers: Timer running in handler Failed.\n");
+    VerifyOrQuit(sNow - context->mTimer->Gett0() >= context->mTimer->Getdt(), "TestRandomTimers: Timer fired early.\n");
+
+    context->mFireCount++;
+
+    if (context->mRestart)
+    {
+        context->mTimer->Start(GetRandomInterval());
+    }
+}
+
+/**
+ * Test the TimerScheduler against random start, stop and fire sequences, crossing the 32-bit wrap.
+ */
+int TestRandomTimers(void)
+{
+    const uint32_t kNumTimers = 64;
+    const uint32_t kNumSteps = 20000;
+    otInstance aInstance;
+    uint8_t timerBuffer[kNumTimers * sizeof(ot::Timer)];
+    ot::Timer *timers = reinterpret_cast<ot::Timer *>(timerBuffer);
+    TestTimerContext contexts[kNumTimers];
+    uint32_t fireCount = 0;
+
+    InitTestTimer();
+    InitCounters();
+    srand(0);
+
+    sNow = 0 - 1000000;
+
+    for (uint32_t i = 0; i < kNumTimers; i++)
+    {
+        new(&timers[i]) ot::Timer(aInstance.mIp6.mTimerScheduler, TestRandomTimerHandler, &contexts[i]);
+        contexts[i].mTimer = &timers[i];
+        contexts[i].mFireCount = 0;
+        contexts[i].mRestart = (i % 2) == 0;
+        timers[i].Start(GetRandomInterval());
+    }
+
+    for (uint32_t step = 0; step < kNumSteps; step++)
+    {
+        ot::Timer &timer = timers[static_cast<uint32_t>(rand()) % kNumTimers];
+
+        switch (rand() % 4)
+        {
+        case 0:
+            timer.Stop();
+            break;
+
+        case 1:
+            timer.StartAt(sNow - (static_cast<uint32_t>(rand()) % 50), GetRandomInterval());
+            break;
+
+        default:
+            if (!timer.IsRunning())
+            {
+                timer.Start(GetRandomInterval());
+            }
+
+            break;
+        }
+
+        // Move the time forward to the alarm, sometimes late and sometimes early.
+        if (sTimerOn)
+        {
+            sNow = sPlatT0 + sPlatDt + (static_cast<uint32_t>(rand()) % 3);
+
+            if (sPlatDt > 2 && (rand() % 4) == 0)
+            {
+                sNow -= 4;
+            }
+
+            do
+            {
+                otPlatAlarmFired(&aInstance);
+            }
+            while (sTimerOn && sPlatDt == 0);
+        }
+
+        for (uint32_t i = 0; i < kNumTimers; i++)
+        {
+            VerifyOrQuit(!timers[i].IsRunning() || sNow - timers[i].Gett0() < timers[i].Getdt(),
+                         "TestRandomTimers: Expired timer was not fired.\n");
+        }
+    }
+
+    for (uint32_t i = 0; i < kNumTimers; i++)
+    {
+        timers[i].Stop();
+        fireCount += contexts[i].mFireCount;
+    }
+
+    VerifyOrQuit(fireCount > 0, "TestRandomTimers: No timer fired.\n");
+    VerifyOrQuit(sTimerOn == false, "TestRandomTimers: Platform Timer State Failed.\n");
+
+    return 0;
+}
+
+uint32_t sBenchmarkFireCount;
+
+void TestBenchmarkTimerHandler(void *aContext)
+{
+    sBenchmarkFireCount++;
+    static_cast<ot::Timer *>(aContext)->Start(1 + (static_cast<uint32_t>(rand()) % 1000));
+}
+
+/**
+ * Measure the cost of starting, stopping and firing timers with 10 to 1000 timers running.
+ */
+void TestTimerBenchmark(void)
+{
+    const uint16_t kNumTimers[] = { 10, 100, 1000 };
+    const uint32_t kMaxTimers = 1000;
+    const uint32_t kNumOperations = 100000;
+    otInstance *instance = new otInstance;
+    ot::Timer *timers = static_cast<ot::Timer *>(malloc(kMaxTimers * sizeof(ot::Timer)));
+
+    InitTestTimer();
+    srand(0);
+
+    for (size_t n = 0; n < sizeof(kNumTimers) / sizeof(kNumTimers[0]); n++)
+    {
+        uint32_t numTimers = kNumTimers[n];
+        uint64_t startTime;
+        uint64_t startDuration;
+        uint64_t stopDuration;
+        uint64_t fireDuration;
+
+        sNow = 0;
+
+        for (uint32_t i = 0; i < numTimers; i++)
+        {
+            new(&timers[i]) ot::Timer(instance->mIp6.mTimerScheduler, TestBenchmarkTimerHandler, &timers[i]);
+            timers[i].Start(1 + (static_cast<uint32_t>(rand()) % 60000));
+        }
+
+        // Restart running timers, as done by MLE, MPL, CoAP and trickle timers.
+        startTime = testPlatGetMicroseconds();
+
+        for (uint32_t i = 0; i < kNumOperations; i++)
+        {
+            timers[i % numTimers].Start(1 + (i * 7919) % 60000);
+        }
+
+        startDuration = testPlatGetMicroseconds() - startTime;
+
+        // Stop and start again, so that the number of running timers stays constant.
+        startTime = testPlatGetMicroseconds();
+
+        for (uint32_t i = 0; i < kNumOperations; i++)
+        {
+            timers[i % numTimers].Stop();
+            timers[i % numTimers].Start(1 + (i * 7919) % 60000);
+        }
+
+        stopDuration = testPlatGetMicroseconds() - startTime;
+
+        // Advance the time from one alarm to the next, each handler restarts its timer.
+        for (uint32_t i = 0; i < numTimers; i++)
+        {
+            timers[i].Start(1 + (static_cast<uint32_t>(rand()) % 1000));
+        }
+
+        sBenchmarkFireCount = 0;
+        startTime = testPlatGetMicroseconds();
+
+        while (sBenchmarkFireCount < kNumOperations)
+        {
+            sNow = sPlatT0 + sPlatDt;
+            otPlatAlarmFired(instance);
+        }
+
+        fireDuration = testPlatGetMicroseconds() - startTime;
+
+        for (uint32_t i = 0; i < numTimers; i++)
+        {
+            timers[i].Stop();
+        }
+
+        printf("TimerBenchmark: %4u timers, start %6.1f ns, stop+start %6.1f ns, fire %6.1f ns\n",
+               static_cast<unsigned int>(numTimers),
+               static_cast<double>(startDuration) * 1000 / kNumOperations,
+               static_cast<double>(stopDuration) * 1000 / kNumOperations,
+               static_cast<double>(fireDuration) * 1000 / sBenchmarkFireCount);
+    }
+
+    free(timers);
+    delete instance;
+}
+
 void RunTimerTests(void)
 {
     TestOneTimer();
     TestTenTimers();
+    TestRandomTimers();
+    TestTimerBenchmark();
 }
 
 #ifdef ENABLE_TEST_MAIN
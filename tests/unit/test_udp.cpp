@@ -0,0 +1,359 @@
+/*
+ *  Copyright (c) 2017, The OpenThread Authors.
+ *  All rights reserved.
+ *
+ *  Redistribution and use in source and binary forms, with or without
+ *  modification, are permitted provided that the following conditions are met:
+ *  1. Redistributions of source code must retain the above copyright
+ *     notice, this list of conditions and the following disclaimer.
+ *  2. Redistributions in binary form must reproduce the above copyright
+ *     notice, this list of conditions and the following disclaimer in the
+ *     documentation and/or other materials provided with the distribution.
+ *  3. Neither the name of the copyright holder nor the
+ *     names of its contributors may be used to endorse or promote products
+ *     derived from this software without specific prior written permission.
+ *
+ *  THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+ *  AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+ *  IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+ *  ARE DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE
+ *  LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR
+ *  CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF
+ *  SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; OR BUSINESS
+ *  INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, WHETHER IN
+ *  CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR OTHERWISE)
+ *  ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF ADVISED OF THE
+ *  POSSIBILITY OF SUCH DAMAGE.
+ */
+
+#include "test_platform.h"
+
+#include "utils/wrap_string.h"
+
+#include <openthread/openthread.h>
+
+#include "openthread-instance.h"
+#include "common/debug.hpp"
+#include "common/message.hpp"
+#include "net/ip6.hpp"
+#include "net/udp6.hpp"
+
+#include "test_util.h"
+
+namespace ot {
+
+static uint32_t sReceiveCount[8];
+static uintptr_t sReceiveOrder[8];
+static uint8_t sReceiveOrderLength;
+
+static void HandleUdpReceive(void *aContext, otMessage *, const otMessageInfo *)
+{
+    sReceiveCount[reinterpret_cast<uintptr_t>(aContext)]++;
+
+    if (sReceiveOrderLength < sizeof(sReceiveOrder) / sizeof(sReceiveOrder[0]))
+    {
+        sReceiveOrder[sReceiveOrderLength++] = reinterpret_cast<uintptr_t>(aContext);
+    }
+}
+
+struct ReceiveAction
+{
+    Ip6::UdpSocket *mSocket;   // The socket the handler connects or closes.
+    bool            mConnect;  // Connect `mSocket` to the sender, otherwise close it.
+    uint32_t        mCount;
+};
+
+static void HandleUdpReceiveAction(void *aContext, otMessage *, const otMessageInfo *aMessageInfo)
+{
+    ReceiveAction &action = *static_cast<ReceiveAction *>(aContext);
+    const Ip6::MessageInfo &messageInfo = *static_cast<const Ip6::MessageInfo *>(aMessageInfo);
+    Ip6::SockAddr peer;
+
+    action.mCount++;
+
+    if (action.mConnect)
+    {
+        peer.GetAddress() = messageInfo.GetPeerAddr();
+        peer.mPort = messageInfo.mPeerPort;
+        SuccessOrQuit(action.mSocket->Connect(peer), "UdpSocket::Connect failed\n");
+    }
+    else
+    {
+        SuccessOrQuit(action.mSocket->Close(), "UdpSocket::Close failed\n");
+    }
+}
+
+static void ResetReceiveCounts(void)
+{
+    memset(sReceiveCount, 0, sizeof(sReceiveCount));
+    sReceiveOrderLength = 0;
+}
+
+static void DeliverDatagram(otInstance &aInstance, const char *aSource, uint16_t aSourcePort,
+                            const char *aDestination, uint16_t aDestinationPort)
+{
+    Ip6::Udp &udp = aInstance.mIp6.mUdp;
+    Ip6::MessageInfo messageInfo;
+    Ip6::Address sockAddr;
+    Ip6::UdpHeader udpHeader;
+    uint8_t payload[16];
+    Message *message;
+
+    memset(payload, 0x5a, sizeof(payload));
+
+    SuccessOrQuit(messageInfo.GetPeerAddr().FromString(aSource), "Address::FromString failed\n");
+    SuccessOrQuit(sockAddr.FromString(aDestination), "Address::FromString failed\n");
+    messageInfo.SetSockAddr(sockAddr);
+    messageInfo.mInterfaceId = 1;
+
+    udpHeader.SetSourcePort(aSourcePort);
+    udpHeader.SetDestinationPort(aDestinationPort);
+    udpHeader.SetLength(sizeof(udpHeader) + sizeof(payload));
+    udpHeader.SetChecksum(0);
+
+    VerifyOrQuit((message = aInstance.mIp6.mMessagePool.New(Message::kTypeIp6, 0)) != NULL, "Message::New failed\n");
+    SuccessOrQuit(message->Append(&udpHeader, sizeof(udpHeader)), "Message::Append failed\n");
+    SuccessOrQuit(message->Append(payload, sizeof(payload)), "Message::Append failed\n");
+    udp.UpdateChecksum(*message, Ip6::Ip6::ComputePseudoheaderChecksum(messageInfo.GetPeerAddr(),
+                                                                       messageInfo.GetSockAddr(),
+                                                                       message->GetLength(), Ip6::kProtoUdp));
+
+    SuccessOrQuit(udp.HandleMessage(*message, messageInfo), "Udp::HandleMessage failed\n");
+    message->Free();
+}
+
+static void Bind(Ip6::UdpSocket &aSocket, const char *aAddress, uint16_t aPort)
+{
+    Ip6::SockAddr sockAddr;
+
+    if (aAddress != NULL)
+    {
+        SuccessOrQuit(sockAddr.GetAddress().FromString(aAddress), "Address::FromString failed\n");
+    }
+
+    sockAddr.mPort = aPort;
+    SuccessOrQuit(aSocket.Bind(sockAddr), "UdpSocket::Bind failed\n");
+}
+
+void TestUdpSocketDemux(void)
+{
+    otInstance *instance = new otInstance;
+    Ip6::Udp &udp = instance->mIp6.mUdp;
+    Ip6::UdpSocket socket0(udp);
+    Ip6::UdpSocket socket1(udp);
+    Ip6::UdpSocket socket2(udp);
+    Ip6::UdpSocket socket3(udp);
+    Ip6::UdpSocket socket4(udp);
+    Ip6::SockAddr peer;
+    uint32_t lookups;
+    uint32_t misses;
+
+    SuccessOrQuit(socket0.Open(HandleUdpReceive, reinterpret_cast<void *>(0)), "UdpSocket::Open failed\n");
+    SuccessOrQuit(socket1.Open(HandleUdpReceive, reinterpret_cast<void *>(1)), "UdpSocket::Open failed\n");
+    SuccessOrQuit(socket2.Open(HandleUdpReceive, reinterpret_cast<void *>(2)), "UdpSocket::Open failed\n");
+    SuccessOrQuit(socket3.Open(HandleUdpReceive, reinterpret_cast<void *>(3)), "UdpSocket::Open failed\n");
+    SuccessOrQuit(socket4.Open(HandleUdpReceive, reinterpret_cast<void *>(4)), "UdpSocket::Open failed\n");
+
+    // Ports 1000 and 1008 share a hash bucket with the default bucket count.
+    Bind(socket0, NULL, 1000);
+    Bind(socket1, "fd00::1", 1000);
+    Bind(socket2, NULL, 1008);
+    Bind(socket3, NULL, 5683);
+    Bind(socket4, NULL, 5684);
+
+    SuccessOrQuit(peer.GetAddress().FromString("fd00::2"), "Address::FromString failed\n");
+    peer.mPort = 2000;
+    SuccessOrQuit(socket4.Connect(peer), "UdpSocket::Connect failed\n");
+
+    lookups = udp.GetCounters().mLookups;
+    misses = udp.GetCounters().mMisses;
+
+    // Unspecified and matching bound addresses both receive.
+    ResetReceiveCounts();
+    DeliverDatagram(*instance, "fd00::2", 3000, "fd00::1", 1000);
+    VerifyOrQuit(sReceiveCount[0] == 1 && sReceiveCount[1] == 1 && sReceiveCount[2] == 0,
+                 "UDP demux to port 1000 failed\n");
+
+    // A socket bound to another address does not receive.
+    ResetReceiveCounts();
+    DeliverDatagram(*instance, "fd00::2", 3000, "fd00::3", 1000);
+    VerifyOrQuit(sReceiveCount[0] == 1 && sReceiveCount[1] == 0, "UDP demux of bound address failed\n");
+
+    // Multicast destinations are delivered regardless of the bound address.
+    ResetReceiveCounts();
+    DeliverDatagram(*instance, "fd00::2", 3000, "ff03::1", 1000);
+    VerifyOrQuit(sReceiveCount[0] == 1 && sReceiveCount[1] == 1, "UDP demux of multicast failed\n");
+
+    ResetReceiveCounts();
+    DeliverDatagram(*instance, "fd00::2", 3000, "fd00::1", 1008);
+    VerifyOrQuit(sReceiveCount[0] == 0 && sReceiveCount[2] == 1, "UDP demux to port 1008 failed\n");
+
+    // Connected sockets only receive from their peer.
+    ResetReceiveCounts();
+    DeliverDatagram(*instance, "fd00::2", 2000, "fd00::1", 5684);
+    DeliverDatagram(*instance, "fd00::2", 2001, "fd00::1", 5684);
+    DeliverDatagram(*instance, "fd00::5", 2000, "fd00::1", 5684);
+    VerifyOrQuit(sReceiveCount[4] == 1 && sReceiveCount[3] == 0, "UDP demux of connected socket failed\n");
+
+    DeliverDatagram(*instance, "fd00::2", 3000, "fd00::1", 7777);
+
+    VerifyOrQuit(udp.GetCounters().mLookups == lookups + 8, "UDP lookup counter failed\n");
+    VerifyOrQuit(udp.GetCounters().mMisses == misses + 3, "UDP miss counter failed\n");
+
+    // Rebinding moves the socket to its new port.
+    Bind(socket2, NULL, 1001);
+    ResetReceiveCounts();
+    DeliverDatagram(*instance, "fd00::2", 3000, "fd00::1", 1008);
+    DeliverDatagram(*instance, "fd00::2", 3000, "fd00::1", 1001);
+    VerifyOrQuit(sReceiveCount[2] == 1, "UDP demux after rebind failed\n");
+
+    // Closed sockets do not receive.
+    SuccessOrQuit(socket0.Close(), "UdpSocket::Close failed\n");
+    SuccessOrQuit(socket4.Close(), "UdpSocket::Close failed\n");
+    ResetReceiveCounts();
+    DeliverDatagram(*instance, "fd00::2", 3000, "fd00::1", 1000);
+    DeliverDatagram(*instance, "fd00::2", 2000, "fd00::1", 5684);
+    VerifyOrQuit(sReceiveCount[0] == 0 && sReceiveCount[1] == 1 && sReceiveCount[4] == 0,
+                 "UDP demux after close failed\n");
+
+    SuccessOrQuit(socket1.Close(), "UdpSocket::Close failed\n");
+    SuccessOrQuit(socket2.Close(), "UdpSocket::Close failed\n");
+    SuccessOrQuit(socket3.Close(), "UdpSocket::Close failed\n");
+
+    delete instance;
+}
+
+void TestUdpEphemeralPort(void)
+{
+    otInstance *instance = new otInstance;
+    Ip6::Udp &udp = instance->mIp6.mUdp;
+    Ip6::UdpSocket socket0(udp);
+    Ip6::UdpSocket socket1(udp);
+    uint16_t port;
+
+    // Occupy the next ephemeral port and verify that it is skipped.
+    port = udp.GetEphemeralPort();
+    SuccessOrQuit(socket0.Open(HandleUdpReceive, NULL), "UdpSocket::Open failed\n");
+    Bind(socket0, NULL, port + 1);
+
+    SuccessOrQuit(socket1.Open(HandleUdpReceive, NULL), "UdpSocket::Open failed\n");
+    Bind(socket1, NULL, 0);
+    VerifyOrQuit(socket1.GetSockName().mPort == port + 2, "Ephemeral port collision was not skipped\n");
+
+    SuccessOrQuit(socket0.Close(), "UdpSocket::Close failed\n");
+    SuccessOrQuit(socket1.Close(), "UdpSocket::Close failed\n");
+
+    delete instance;
+}
+
+void TestUdpReceiveHandlerChangesSockets(void)
+{
+    otInstance *instance = new otInstance;
+    Ip6::Udp &udp = instance->mIp6.mUdp;
+    Ip6::UdpSocket socket0(udp);
+    Ip6::UdpSocket socket1(udp);
+    Ip6::UdpSocket socket2(udp);
+    Ip6::UdpSocket socket3(udp);
+    Ip6::UdpSocket socket4(udp);
+    ReceiveAction connect = { &socket0, true, 0 };
+    ReceiveAction close = { &socket3, false, 0 };
+    ReceiveAction closeSelf = { &socket4, false, 0 };
+    uint32_t misses;
+
+    // socket0 connects itself to the first sender, as CoapSecure does, which moves it from its port bucket to the
+    // connected list. It is ahead of socket1 in the bucket.
+    SuccessOrQuit(socket1.Open(HandleUdpReceive, reinterpret_cast<void *>(1)), "UdpSocket::Open failed\n");
+    Bind(socket1, NULL, 5684);
+    SuccessOrQuit(socket0.Open(HandleUdpReceiveAction, &connect), "UdpSocket::Open failed\n");
+    Bind(socket0, NULL, 5684);
+
+    ResetReceiveCounts();
+    DeliverDatagram(*instance, "fd00::2", 2000, "fd00::1", 5684);
+    VerifyOrQuit(connect.mCount == 1 && sReceiveCount[1] == 1, "UDP demux with connecting handler failed\n");
+
+    DeliverDatagram(*instance, "fd00::5", 2000, "fd00::1", 5684);
+    VerifyOrQuit(connect.mCount == 1 && sReceiveCount[1] == 2, "UDP demux after connecting handler failed\n");
+
+    DeliverDatagram(*instance, "fd00::2", 2000, "fd00::1", 5684);
+    VerifyOrQuit(connect.mCount == 2 && sReceiveCount[1] == 3, "UDP demux to connected socket failed\n");
+
+    // socket2 closes socket3 and socket4 closes itself, the list is socket2, socket4, socket3.
+    SuccessOrQuit(socket3.Open(HandleUdpReceive, reinterpret_cast<void *>(3)), "UdpSocket::Open failed\n");
+    Bind(socket3, NULL, 6000);
+    SuccessOrQuit(socket4.Open(HandleUdpReceiveAction, &closeSelf), "UdpSocket::Open failed\n");
+    Bind(socket4, NULL, 6000);
+    SuccessOrQuit(socket2.Open(HandleUdpReceiveAction, &close), "UdpSocket::Open failed\n");
+    Bind(socket2, NULL, 6000);
+
+    ResetReceiveCounts();
+    DeliverDatagram(*instance, "fd00::2", 2000, "fd00::1", 6000);
+    VerifyOrQuit(close.mCount == 1 && closeSelf.mCount == 1 && sReceiveCount[3] == 0,
+                 "UDP demux with closing handlers failed\n");
+
+    DeliverDatagram(*instance, "fd00::2", 2000, "fd00::1", 6000);
+    VerifyOrQuit(close.mCount == 2 && closeSelf.mCount == 1 && sReceiveCount[3] == 0,
+                 "UDP demux after closing handlers failed\n");
+
+    // Re-opening a bound socket removes it from its old bucket.
+    SuccessOrQuit(socket1.Open(HandleUdpReceive, reinterpret_cast<void *>(1)), "UdpSocket::Open failed\n");
+    Bind(socket1, NULL, 7000);
+
+    misses = udp.GetCounters().mMisses;
+    ResetReceiveCounts();
+    DeliverDatagram(*instance, "fd00::5", 2000, "fd00::1", 5684);
+    DeliverDatagram(*instance, "fd00::5", 2000, "fd00::1", 7000);
+    VerifyOrQuit(sReceiveCount[1] == 1 && udp.GetCounters().mMisses == misses + 1, "UDP demux after re-open failed\n");
+
+    SuccessOrQuit(socket0.Close(), "UdpSocket::Close failed\n");
+    SuccessOrQuit(socket1.Close(), "UdpSocket::Close failed\n");
+    SuccessOrQuit(socket2.Close(), "UdpSocket::Close failed\n");
+
+    delete instance;
+}
+
+void TestUdpDeliveryOrder(void)
+{
+    otInstance *instance = new otInstance;
+    Ip6::Udp &udp = instance->mIp6.mUdp;
+    Ip6::UdpSocket socket0(udp);
+    Ip6::UdpSocket socket1(udp);
+    Ip6::UdpSocket socket2(udp);
+    Ip6::SockAddr peer;
+
+    // socket2 is connected, socket1 was bound after socket0.
+    SuccessOrQuit(socket2.Open(HandleUdpReceive, reinterpret_cast<void *>(2)), "UdpSocket::Open failed\n");
+    Bind(socket2, NULL, 8000);
+    SuccessOrQuit(peer.GetAddress().FromString("fd00::2"), "Address::FromString failed\n");
+    peer.mPort = 2000;
+    SuccessOrQuit(socket2.Connect(peer), "UdpSocket::Connect failed\n");
+    SuccessOrQuit(socket0.Open(HandleUdpReceive, reinterpret_cast<void *>(0)), "UdpSocket::Open failed\n");
+    Bind(socket0, NULL, 8000);
+    SuccessOrQuit(socket1.Open(HandleUdpReceive, reinterpret_cast<void *>(1)), "UdpSocket::Open failed\n");
+    Bind(socket1, NULL, 8000);
+
+    // Unconnected sockets come first, most recently bound first, then connected sockets.
+    ResetReceiveCounts();
+    DeliverDatagram(*instance, "fd00::2", 2000, "fd00::1", 8000);
+    VerifyOrQuit(sReceiveOrderLength == 3 && sReceiveOrder[0] == 1 && sReceiveOrder[1] == 0 && sReceiveOrder[2] == 2,
+                 "UDP delivery order failed\n");
+
+    SuccessOrQuit(socket0.Close(), "UdpSocket::Close failed\n");
+    SuccessOrQuit(socket1.Close(), "UdpSocket::Close failed\n");
+    SuccessOrQuit(socket2.Close(), "UdpSocket::Close failed\n");
+
+    delete instance;
+}
+
+}  // namespace ot
+
+#ifdef ENABLE_TEST_MAIN
+int main(void)
+{
+    ot::TestUdpSocketDemux();
+    ot::TestUdpEphemeralPort();
+    ot::TestUdpReceiveHandlerChangesSockets();
+    ot::TestUdpDeliveryOrder();
+    printf("All tests passed\n");
+    return 0;
+}
+#endif
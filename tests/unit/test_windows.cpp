@@ -35,14 +35,45 @@ using namespace Microsoft::VisualStudio::CppUnitTestFramework;
 
 #pragma region Test Declarations
 
+// test_address_resolver.cpp
+namespace ot
+{
+    void TestEidCache();
+    void TestAddressResolverQuery();
+}
+
 // test_aes.cpp
 void TestMacBeaconFrame();
 void TestMacDataFrame();
 void TestMacCommandFrame();
+void TestAesCcmRfc3610();
+void TestAesCcmPayloadChunks();
+void TestAesCcmMessage();
+void TestAesCcmKeyChange();
+
+// test_checksum.cpp
+namespace ot
+{
+    void TestChecksumEquivalence();
+    void TestMessageChecksum();
+}
+
+// test_hdlc.cpp
+namespace ot
+{
+    void TestHdlcEncoder();
+    void TestHdlcDecoder();
+}
 
 // test_hmac_sha256.cpp
 void TestHmacSha256();
 
+// test_key_manager.cpp
+namespace ot
+{
+    void TestKeyManagerKeyCache();
+}
+
 // test_link_quality.cpp
 namespace ot
 {
@@ -64,19 +95,41 @@ namespace ot
 
 // test_message.cpp
 void TestMessage();
+void TestMessageCursor();
 
 // test_message_queue.cpp
 void TestMessageQueue();
+void TestIndirectMessageQueue();
+
+// test_mle_router.cpp
+namespace ot
+{
+    void TestMleRouterNeighborLookup();
+}
 
 // test_priority_queue.cpp
 void TestPriorityQueue();
 
+// test_ncp_base.cpp
+namespace ot
+{
+    void TestNcpDispatch(void);
+    void TestNcpUnsolUpdateBatching(void);
+    void TestNcpUnsolUpdateBatchingJoinFailure(void);
+}
+
 // test_ncp_buffer.cpp
 namespace ot
 {
     void TestNcpFrameBuffer(void);
 }
 
+// test_spinel_encoder.cpp
+namespace ot
+{
+    void TestSpinelEncoderCrossCheck(void);
+}
+
 // test_timer.cpp
 int TestOneTimer();
 int TestTenTimers();
@@ -89,6 +142,14 @@ void test_packed_enum();
 void test_addr_sizes();
 void test_addr_bitfield();
 
+// test_udp.cpp
+namespace ot {
+    void TestUdpSocketDemux();
+    void TestUdpEphemeralPort();
+    void TestUdpReceiveHandlerChangesSockets();
+    void TestUdpDeliveryOrder();
+}
+
 // test_fuzz.cpp
 void TestFuzz(uint32_t aSeconds);
 
@@ -130,14 +191,33 @@ namespace ot
             testPlatResetToDefaults();
         }
 
+        // test_address_resolver.cpp
+        TEST_METHOD(TestEidCache) { ot::TestEidCache(); }
+        TEST_METHOD(TestAddressResolverQuery) { ot::TestAddressResolverQuery(); }
+
         // test_aes.cpp
         TEST_METHOD(TestMacBeaconFrame) { ::TestMacBeaconFrame(); }
         TEST_METHOD(TestMacDataFrame) { ::TestMacDataFrame(); }
         TEST_METHOD(TestMacCommandFrame) { ::TestMacCommandFrame(); }
+        TEST_METHOD(TestAesCcmRfc3610) { ::TestAesCcmRfc3610(); }
+        TEST_METHOD(TestAesCcmPayloadChunks) { ::TestAesCcmPayloadChunks(); }
+        TEST_METHOD(TestAesCcmMessage) { ::TestAesCcmMessage(); }
+        TEST_METHOD(TestAesCcmKeyChange) { ::TestAesCcmKeyChange(); }
+
+        // test_checksum.cpp
+        TEST_METHOD(TestChecksumEquivalence) { ot::TestChecksumEquivalence(); }
+        TEST_METHOD(TestMessageChecksum) { ot::TestMessageChecksum(); }
+
+        // test_hdlc.cpp
+        TEST_METHOD(TestHdlcEncoder) { ot::TestHdlcEncoder(); }
+        TEST_METHOD(TestHdlcDecoder) { ot::TestHdlcDecoder(); }
 
         // test_hmac_sha256.cpp
         TEST_METHOD(TestHmacSha256) { ::TestHmacSha256(); }
 
+        // test_key_manager.cpp
+        TEST_METHOD(TestKeyManagerKeyCache) { ot::TestKeyManagerKeyCache(); }
+
         // test_link_quality.cpp
         TEST_METHOD(TestRssAveraging) { ot::TestRssAveraging(); }
         TEST_METHOD(TestLinkQualityCalculations) { ot::TestLinkQualityCalculations(); }
@@ -150,9 +230,14 @@ namespace ot
 
         // test_message.cpp
         TEST_METHOD(TestMessage) { ::TestMessage(); }
+        TEST_METHOD(TestMessageCursor) { ::TestMessageCursor(); }
 
         // test_message_queue.cpp
         TEST_METHOD(TestMessageQueue) { ::TestMessageQueue(); }
+        TEST_METHOD(TestIndirectMessageQueue) { ::TestIndirectMessageQueue(); }
+
+        // test_mle_router.cpp
+        TEST_METHOD(TestMleRouterNeighborLookup) { ot::TestMleRouterNeighborLookup(); }
 
         // test_message_queue.cpp
         TEST_METHOD(TestPriorityQueue) { ::TestPriorityQueue(); }
@@ -161,9 +246,17 @@ namespace ot
         TEST_METHOD(TestOneTimer) { ::TestOneTimer(); }
         TEST_METHOD(TestTenTimers) { ::TestTenTimers(); }
 
+        // test_ncp_base.cpp
+        TEST_METHOD(TestNcpDispatch) { ot::TestNcpDispatch(); }
+        TEST_METHOD(TestNcpUnsolUpdateBatching) { ot::TestNcpUnsolUpdateBatching(); }
+        TEST_METHOD(TestNcpUnsolUpdateBatchingJoinFailure) { ot::TestNcpUnsolUpdateBatchingJoinFailure(); }
+
         // test_ncp_buffer.cpp
         TEST_METHOD(TestNcpFrameBuffer) { ot::TestNcpFrameBuffer(); }
 
+        // test_spinel_encoder.cpp
+        TEST_METHOD(TestSpinelEncoderCrossCheck) { ot::TestSpinelEncoderCrossCheck(); }
+
         // test_toolchain.cpp
         TEST_METHOD(test_packed1) { ::test_packed1(); }
         TEST_METHOD(test_packed2) { ::test_packed2(); }
@@ -172,6 +265,12 @@ namespace ot
         TEST_METHOD(test_addr_sizes) { ::test_addr_sizes(); }
         TEST_METHOD(test_addr_bitfield) { ::test_addr_bitfield(); }
 
+        // test_udp.cpp
+        TEST_METHOD(TestUdpSocketDemux) { ot::TestUdpSocketDemux(); }
+        TEST_METHOD(TestUdpEphemeralPort) { ot::TestUdpEphemeralPort(); }
+        TEST_METHOD(TestUdpReceiveHandlerChangesSockets) { ot::TestUdpReceiveHandlerChangesSockets(); }
+        TEST_METHOD(TestUdpDeliveryOrder) { ot::TestUdpDeliveryOrder(); }
+
         // test_settings.cpp
         TEST_METHOD(RunTestFuzz) { ::TestFuzz(30); }
     };
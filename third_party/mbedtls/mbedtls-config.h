@@ -1428,7 +1428,7 @@ __inline int windows_kernel_snprintf(char * s, size_t n, const char * format, ..
  *
  * This modules adds support for the AES-NI instructions on x86-64
  */
-//#define MBEDTLS_AESNI_C
+#define MBEDTLS_AESNI_C
 
 /**
  * \def MBEDTLS_AES_C